@@ -59,6 +59,30 @@ class BleService {
   /// @param batteryLevel 배터리 잔량 (0-100%)
   Function(double angle, double velocity, int batteryLevel)? onStatusReceived;
 
+  /// @brief 텔레메트리 샘플 수신 콜백 (100Hz 제어 데이터, 알림당 여러 샘플)
+  /// @param samples 복원된 샘플 목록 (각도, 각속도, PID 항, 모터 명령, 엔코더 카운트)
+  /// @param lostSamples 이번 패킷 직전까지 유실된 샘플 수
+  Function(List<Map<String, num>> samples, int lostSamples)? onTelemetryReceived;
+
+  /// @brief 설정 값 수신 콜백 (CONFIG_SET 적용 결과 또는 CONFIG_GET 응답)
+  /// @param values 파라미터 ID → 로봇에 적용된 값
+  Function(Map<int, double> values)? onConfigReceived;
+
+  /// @brief 다음에 기대하는 텔레메트리 샘플 번호 (유실 감지용)
+  int? _nextTelemetryIndex;
+
+  /// @brief 이동 명령 재전송 주기 (로봇의 명령 워치독 timeout보다 짧아야 함)
+  static const Duration _keepaliveInterval = Duration(milliseconds: 100);
+
+  /// @brief 이동 중 마지막 명령을 주기적으로 다시 보내는 타이머
+  Timer? _keepaliveTimer;
+
+  /// @brief 마지막으로 보낸 이동 명령 (방향, 회전, 속도, 밸런싱)
+  int _lastDirection = 0;
+  int _lastTurn = 0;
+  int _lastSpeed = 0;
+  bool _lastBalance = true;
+
   /// @brief BLE 연결 상태 확인
   /// @return 연결되어 있으면 true, 아니면 false
   bool get isConnected => _isConnected;
@@ -108,6 +132,15 @@ class BleService {
       await targetDevice.connect();
       _device = targetDevice;
 
+      // Request a large MTU and a short connection interval (Android only; iOS negotiates itself)
+      try {
+        await targetDevice.requestMtu(247);
+        await targetDevice.requestConnectionPriority(
+            connectionPriorityRequest: ConnectionPriority.high);
+      } catch (e) {
+        // Keep the defaults; the robot accepts whatever the link settles on
+      }
+
       // Discover services
       List<BluetoothService> services = await targetDevice.discoverServices();
 
@@ -152,6 +185,10 @@ class BleService {
       }
 
       _isConnected = true;
+
+      // The robot decays motion to zero when commands stop arriving, so keep
+      // refreshing the last command while the user is moving
+      _keepaliveTimer = Timer.periodic(_keepaliveInterval, (_) => _resendMotion());
       return true;
 
     } catch (e) {
@@ -162,8 +199,15 @@ class BleService {
 
   Future<void> disconnect() async {
     try {
+      _keepaliveTimer?.cancel();
+      _keepaliveTimer = null;
+      _lastDirection = 0;
+      _lastTurn = 0;
+      _lastSpeed = 0;
+
       await _statusSubscription?.cancel();
       _statusSubscription = null;
+      _nextTelemetryIndex = null;
 
       if (_device != null && _device!.isConnected) {
         await _device!.disconnect();
@@ -189,6 +233,11 @@ class BleService {
       return false;
     }
 
+    _lastDirection = direction;
+    _lastTurn = turn;
+    _lastSpeed = speed;
+    _lastBalance = balance;
+
     try {
       // Build protocol message
       Uint8List message = ProtocolUtils.buildMoveCommand(
@@ -213,27 +262,32 @@ class BleService {
     }
 
     try {
-      // Send pitch PID configuration
-      Uint8List pitchConfig = ProtocolUtils.buildConfigMessage(
-        configId: 0x01, // Pitch PID config ID
-        kp: settings.pitchKp,
-        ki: settings.pitchKi,
-        kd: settings.pitchKd,
-      );
-
-      await _commandCharacteristic!.write(pitchConfig, withoutResponse: true);
-      await Future.delayed(const Duration(milliseconds: 50));
-
-      // Send velocity PID configuration
-      Uint8List velocityConfig = ProtocolUtils.buildConfigMessage(
-        configId: 0x02, // Velocity PID config ID
-        kp: settings.velocityKp,
-        ki: settings.velocityKi,
-        kd: settings.velocityKd,
-      );
+      // One message, so the robot switches both loops' gains in the same control cycle
+      Uint8List config = ProtocolUtils.buildConfigSet({
+        ProtocolUtils.paramBalanceKp: settings.pitchKp,
+        ProtocolUtils.paramBalanceKi: settings.pitchKi,
+        ProtocolUtils.paramBalanceKd: settings.pitchKd,
+        ProtocolUtils.paramVelocityKp: settings.velocityKp,
+        ProtocolUtils.paramVelocityKi: settings.velocityKi,
+        ProtocolUtils.paramVelocityKd: settings.velocityKd,
+      });
+
+      await _commandCharacteristic!.write(config, withoutResponse: true);
+      return true;
+    } catch (e) {
+      return false;
+    }
+  }
 
-      await _commandCharacteristic!.write(velocityConfig, withoutResponse: true);
+  /// @brief 로봇에 적용된 파라미터 값 요청 (응답은 onConfigReceived로 전달)
+  /// @param ids 조회할 파라미터 ID 목록 (비어 있으면 전체)
+  Future<bool> requestConfig([List<int> ids = const []]) async {
+    if (!_isConnected || _commandCharacteristic == null) {
+      return false;
+    }
 
+    try {
+      await _commandCharacteristic!.write(ProtocolUtils.buildConfigGet(ids), withoutResponse: true);
       return true;
     } catch (e) {
       return false;
@@ -248,8 +302,33 @@ class BleService {
     return await sendMoveCommand(standup: true);
   }
 
+  /// @brief 이동 중이면 마지막 이동 명령을 다시 전송 (기립 요청은 반복하지 않음)
+  void _resendMotion() {
+    if (_lastDirection == 0 && _lastSpeed == 0 && _lastTurn == 0) {
+      return;
+    }
+    sendMoveCommand(
+      direction: _lastDirection,
+      turn: _lastTurn,
+      speed: _lastSpeed,
+      balance: _lastBalance,
+    );
+  }
+
   void _handleStatusData(List<int> data) {
     try {
+      Map<String, dynamic>? telemetry = ProtocolUtils.parseTelemetry(Uint8List.fromList(data));
+      if (telemetry != null) {
+        _handleTelemetry(telemetry);
+        return;
+      }
+
+      Map<int, double>? config = ProtocolUtils.parseConfigResponse(Uint8List.fromList(data));
+      if (config != null) {
+        onConfigReceived?.call(config);
+        return;
+      }
+
       Map<String, dynamic>? status = ProtocolUtils.parseStatusResponse(Uint8List.fromList(data));
 
       if (status != null && onStatusReceived != null) {
@@ -264,6 +343,14 @@ class BleService {
     }
   }
 
+  void _handleTelemetry(Map<String, dynamic> packet) {
+    List<Map<String, num>> samples = packet['samples'];
+    int firstIndex = packet['first_index'];
+    int lost = _nextTelemetryIndex == null ? 0 : (firstIndex - _nextTelemetryIndex!) & 0xFFFFFFFF;
+    _nextTelemetryIndex = (firstIndex + samples.length) & 0xFFFFFFFF;
+    onTelemetryReceived?.call(samples, lost);
+  }
+
   void dispose() {
     disconnect();
   }
@@ -11,6 +11,8 @@ class ProtocolUtils {
   static const int msgTypeStatusResp = 0x03;
   static const int msgTypeConfigSet = 0x04;
   static const int msgTypeConfigGet = 0x05;
+  static const int msgTypeTelemetry = 0x06;
+  static const int msgTypeConfigResp = 0x07;
   static const int msgTypeError = 0xFF;
 
   // Command flags
@@ -18,6 +20,14 @@ class ProtocolUtils {
   static const int cmdFlagStandup = 0x02;
   static const int cmdFlagEmergency = 0x04;
 
+  // Runtime parameter ids (see firmware param_registry.h)
+  static const int paramBalanceKp = 0x01;
+  static const int paramBalanceKi = 0x02;
+  static const int paramBalanceKd = 0x03;
+  static const int paramVelocityKp = 0x04;
+  static const int paramVelocityKi = 0x05;
+  static const int paramVelocityKd = 0x06;
+
   static int _sequenceNumber = 0;
 
   static Uint8List buildMoveCommand({
@@ -48,22 +58,43 @@ class ProtocolUtils {
     return _buildMessage(msgTypeMoveCmd, payload.buffer.asUint8List());
   }
 
-  static Uint8List buildConfigMessage({
-    required int configId,
-    required double kp,
-    required double ki,
-    required double kd,
-  }) {
-    // Create payload for PID configuration (13 bytes: 1 + 4*3)
-    ByteData payload = ByteData(13);
-    payload.setUint8(0, configId);
-    payload.setFloat32(1, kp, Endian.little);
-    payload.setFloat32(5, ki, Endian.little);
-    payload.setFloat32(9, kd, Endian.little);
+  /// Builds a CONFIG_SET with one (id, float32) entry per parameter.
+  /// The robot applies all entries of one message together or none of them.
+  static Uint8List buildConfigSet(Map<int, double> values) {
+    ByteData payload = ByteData(values.length * 5);
+    int offset = 0;
+    values.forEach((id, value) {
+      payload.setUint8(offset, id);
+      payload.setFloat32(offset + 1, value, Endian.little);
+      offset += 5;
+    });
 
     return _buildMessage(msgTypeConfigSet, payload.buffer.asUint8List());
   }
 
+  /// Builds a CONFIG_GET for the given ids (empty: every parameter).
+  static Uint8List buildConfigGet([List<int> ids = const []]) {
+    return _buildMessage(msgTypeConfigGet, Uint8List.fromList(ids));
+  }
+
+  /// Decodes a CONFIG_RESP into id → value, or null for other messages.
+  static Map<int, double>? parseConfigResponse(Uint8List data) {
+    if (data.length < 8 || data[0] != startMarker || data[2] != msgTypeConfigResp) {
+      return null;
+    }
+    int payloadLen = (data[5] << 8) | data[4];
+    if (payloadLen % 5 != 0 || data.length < 8 + payloadLen) {
+      return null;
+    }
+
+    ByteData payload = ByteData.sublistView(data, 8, 8 + payloadLen);
+    Map<int, double> values = {};
+    for (int offset = 0; offset < payloadLen; offset += 5) {
+      values[payload.getUint8(offset)] = payload.getFloat32(offset + 1, Endian.little);
+    }
+    return values;
+  }
+
   static Uint8List buildStatusRequest() {
     return _buildMessage(msgTypeStatusReq, Uint8List(0));
   }
@@ -109,6 +140,62 @@ class ProtocolUtils {
     }
   }
 
+  // Telemetry field order and fixed-point scales (see firmware telemetry.h)
+  static const List<String> telemetryFields = [
+    'timestamp_us', 'angle', 'angle_rate', 'pid_p', 'pid_i', 'pid_d',
+    'motor_left', 'motor_right', 'encoder_left', 'encoder_right',
+    'x_cm', 'y_cm', 'heading',
+  ];
+  static const List<double> _telemetryScales = [1, 100, 10, 100, 100, 100, 1, 1, 1, 1, 10, 10, 100];
+
+  /// Decodes a telemetry notification: a keyframe followed by zigzag varint
+  /// deltas. Returns null for other message types or corrupt frames.
+  /// 'seq' and 'first_index' let the caller count lost packets and samples.
+  static Map<String, dynamic>? parseTelemetry(Uint8List data) {
+    if (data.length < 15 || data[0] != startMarker || data[2] != msgTypeTelemetry) {
+      return null;
+    }
+    int payloadLen = (data[5] << 8) | data[4];
+    if (payloadLen < 7 || data.length < 8 + payloadLen) {
+      return null;
+    }
+    int checksum = _crc16Update(0xFFFF, data.sublist(0, 6));
+    checksum = _crc16Update(checksum, data.sublist(8, 8 + payloadLen));
+    if (checksum != ((data[7] << 8) | data[6])) {
+      return null;
+    }
+
+    ByteData payload = ByteData.sublistView(data, 8, 8 + payloadLen);
+    int seq = payload.getUint16(0, Endian.little);
+    int firstIndex = payload.getUint32(2, Endian.little);
+    int count = payload.getUint8(6);
+
+    int pos = 7;
+    List<int> q = List<int>.filled(telemetryFields.length, 0);
+    List<Map<String, num>> samples = [];
+    for (int s = 0; s < count; s++) {
+      Map<String, num> sample = {'index': (firstIndex + s) & 0xFFFFFFFF};
+      for (int i = 0; i < telemetryFields.length; i++) {
+        int value = 0;
+        int shift = 0;
+        while (true) {
+          if (pos >= payloadLen || shift > 28) return null;
+          int b = payload.getUint8(pos++);
+          value |= (b & 0x7F) << shift;
+          shift += 7;
+          if ((b & 0x80) == 0) break;
+        }
+        int delta = (i == 0) ? value : ((value >> 1) ^ -(value & 1));
+        q[i] = (q[i] + delta) & 0xFFFFFFFF;
+        int signed = (i == 0) ? q[i] : q[i].toSigned(32);
+        sample[telemetryFields[i]] = _telemetryScales[i] == 1 ? signed : signed / _telemetryScales[i];
+      }
+      samples.add(sample);
+    }
+
+    return {'seq': seq, 'first_index': firstIndex, 'samples': samples};
+  }
+
   static Uint8List _buildMessage(int msgType, Uint8List payload) {
     int payloadLen = payload.length;
 
@@ -127,19 +214,25 @@ class ProtocolUtils {
       message.setUint8(8 + i, payload[i]);
     }
 
-    // Calculate and set checksum (simple sum of all bytes except checksum field)
-    int checksum = 0;
-    for (int i = 0; i < 6; i++) {
-      checksum += message.getUint8(i);
-    }
-    for (int i = 0; i < payloadLen; i++) {
-      checksum += payload[i];
-    }
-    message.setUint16(6, checksum & 0xFFFF, Endian.little);
+    // Calculate and set checksum (CRC16 of all bytes except the checksum field)
+    int checksum = _crc16Update(0xFFFF, message.buffer.asUint8List(0, 6));
+    checksum = _crc16Update(checksum, payload);
+    message.setUint16(6, checksum, Endian.little);
 
     return message.buffer.asUint8List();
   }
 
+  // CRC16 (poly 0xA001, reflected), same as the firmware's crc16_update
+  static int _crc16Update(int crc, List<int> data) {
+    for (final b in data) {
+      crc ^= b & 0xFF;
+      for (int j = 0; j < 8; j++) {
+        crc = (crc & 1) != 0 ? (crc >> 1) ^ 0xA001 : crc >> 1;
+      }
+    }
+    return crc & 0xFFFF;
+  }
+
   static String getRobotStateName(int state) {
     switch (state) {
       case 0: return "INIT";
@@ -0,0 +1,238 @@
+/**
+ * @file balance_sim.c
+ * @brief 호스트 폐루프 밸런싱 시뮬레이터 실행 파일
+ *
+ * 무작위 초기 기울기/자이로 바이어스/노이즈 시드로 여러 번 시뮬레이션하여
+ * 넘어짐 비율, 정착 시간, 오버슈트를 보고합니다.
+ * --max-fall-rate / --max-settle / --max-drift 기준을 넘으면 종료 코드 1을 반환하므로
+ * CI에서 게인이나 제어 주기 변경을 검증하는 데 사용할 수 있습니다.
+ *
+ * 사용 예:
+ *   ./balance_sim --runs 200 --kp 40 --loop-hz 1000 --max-fall-rate 0
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "sim_loop.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @struct sim_options_t
+ * @brief 몬테카를로 실행 옵션
+ */
+typedef struct {
+    uint32_t runs;              ///< 실행 횟수
+    uint32_t seed;              ///< 시나리오 난수 시드
+    double min_tilt_deg;        ///< 초기 기울기 최솟값 (degree, 부호는 무작위)
+    double max_tilt_deg;        ///< 초기 기울기 최댓값 (degree)
+    double max_gyro_bias_dps;   ///< 피치 자이로 바이어스 최대 크기 (deg/s)
+    double max_fall_rate;       ///< 허용 넘어짐 비율 (0~1)
+    double max_settle_s;        ///< 허용 정착 시간 p95 (s, 음수면 검사 안 함)
+    double max_drift_cm;        ///< 허용 최종 |위치| (cm, 넘어지지 않은 모든 실행, 음수면 검사 안 함)
+    int verbose;                ///< 실행별 결과 출력
+} sim_options_t;
+
+static void print_usage(const char* prog) {
+    printf("Usage: %s [options]\n"
+           "  --runs N            number of randomized runs (default 100)\n"
+           "  --seed N            scenario seed (default 1)\n"
+           "  --duration S        seconds per run (default 10)\n"
+           "  --loop-hz N         control loop rate (default CONFIG_CONTROL_LOOP_HZ)\n"
+           "  --imu-hz N          IMU output rate (default 1000)\n"
+           "  --divider N         velocity loop divider (default CONFIG_VELOCITY_LOOP_DIVIDER)\n"
+           "  --filter N          attitude filter index (0 Kalman, 1 Mahony, 2 Madgwick, 3 Compl., 4 Kalman Q16)\n"
+           "  --kp/--ki/--kd X    angle loop gains\n"
+           "  --vkp/--vki/--vkd X velocity loop gains\n"
+           "  --qangle/--qbias/--rmeasure X  Kalman noise parameters\n"
+           "  --tilt MIN MAX      initial tilt range in degrees (default 2 10)\n"
+           "  --bias X            max pitch gyro bias in deg/s (default 2)\n"
+           "  --slope DEG         ground slope (default 0)\n"
+           "  --speed CMS         target velocity (default 0)\n"
+           "  --push DPS          pitch-rate kick at t=duration/2 (default none)\n"
+           "  --max-fall-rate X   fail if fall rate exceeds X (default 1)\n"
+           "  --max-settle S      fail if p95 settle time exceeds S\n"
+           "  --max-drift CM      fail if any upright run ends farther than CM from its start\n"
+           "  --verbose           print every run\n", prog);
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(double* sorted, uint32_t n, double pct) {
+    if (n == 0) return -1.0;
+    uint32_t idx = (uint32_t)(pct / 100.0 * (n - 1) + 0.5);
+    return sorted[idx];
+}
+
+/**
+ * @brief 명령행 인자 파싱
+ * @return int 0 성공, 1 도움말 출력, -1 오류
+ */
+static int parse_args(int argc, char** argv, sim_config_t* cfg, sim_options_t* opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(a, "--help") == 0 || strcmp(a, "-h") == 0) return 1;
+        if (strcmp(a, "--verbose") == 0) { opt->verbose = 1; continue; }
+        if (v == NULL) {
+            fprintf(stderr, "missing value for %s\n", a);
+            return -1;
+        }
+        i++;
+        if (strcmp(a, "--runs") == 0) opt->runs = (uint32_t)strtoul(v, NULL, 10);
+        else if (strcmp(a, "--seed") == 0) opt->seed = (uint32_t)strtoul(v, NULL, 10);
+        else if (strcmp(a, "--duration") == 0) cfg->duration_s = atof(v);
+        else if (strcmp(a, "--loop-hz") == 0) cfg->loop_hz = (uint32_t)strtoul(v, NULL, 10);
+        else if (strcmp(a, "--imu-hz") == 0) cfg->imu_rate_hz = (uint32_t)strtoul(v, NULL, 10);
+        else if (strcmp(a, "--divider") == 0) cfg->velocity_divider = (uint32_t)strtoul(v, NULL, 10);
+        else if (strcmp(a, "--filter") == 0) cfg->filter = (attitude_filter_type_t)atoi(v);
+        else if (strcmp(a, "--kp") == 0) cfg->balance_kp = (float)atof(v);
+        else if (strcmp(a, "--ki") == 0) cfg->balance_ki = (float)atof(v);
+        else if (strcmp(a, "--kd") == 0) cfg->balance_kd = (float)atof(v);
+        else if (strcmp(a, "--vkp") == 0) cfg->velocity_kp = (float)atof(v);
+        else if (strcmp(a, "--vki") == 0) cfg->velocity_ki = (float)atof(v);
+        else if (strcmp(a, "--vkd") == 0) cfg->velocity_kd = (float)atof(v);
+        else if (strcmp(a, "--qangle") == 0) cfg->kalman_q_angle = (float)atof(v);
+        else if (strcmp(a, "--qbias") == 0) cfg->kalman_q_bias = (float)atof(v);
+        else if (strcmp(a, "--rmeasure") == 0) cfg->kalman_r_measure = (float)atof(v);
+        else if (strcmp(a, "--tilt") == 0 && i + 1 < argc) {
+            opt->min_tilt_deg = atof(v);
+            opt->max_tilt_deg = atof(argv[++i]);
+        }
+        else if (strcmp(a, "--bias") == 0) opt->max_gyro_bias_dps = atof(v);
+        else if (strcmp(a, "--slope") == 0) cfg->plant.slope_deg = atof(v);
+        else if (strcmp(a, "--speed") == 0) cfg->target_velocity_cms = (float)atof(v);
+        else if (strcmp(a, "--push") == 0) cfg->push_rate_dps = atof(v);
+        else if (strcmp(a, "--max-fall-rate") == 0) opt->max_fall_rate = atof(v);
+        else if (strcmp(a, "--max-settle") == 0) opt->max_settle_s = atof(v);
+        else if (strcmp(a, "--max-drift") == 0) opt->max_drift_cm = atof(v);
+        else {
+            fprintf(stderr, "unknown option %s\n", a);
+            return -1;
+        }
+    }
+    if (cfg->push_rate_dps != 0.0) {
+        cfg->push_time_s = cfg->duration_s / 2.0;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    sim_config_t cfg;
+    sim_config_default(&cfg);
+    sim_options_t opt = {
+        .runs = 100, .seed = 1, .min_tilt_deg = 2.0, .max_tilt_deg = 10.0,
+        .max_gyro_bias_dps = 2.0, .max_fall_rate = 1.0, .max_settle_s = -1.0, .max_drift_cm = -1.0, .verbose = 0,
+    };
+    int rc = parse_args(argc, argv, &cfg, &opt);
+    if (rc != 0) {
+        print_usage(argv[0]);
+        return (rc > 0) ? 0 : 2;
+    }
+    if (opt.runs == 0) opt.runs = 1;
+
+    double* settle = (double*)malloc(sizeof(double) * opt.runs);
+    if (settle == NULL) return 2;
+    uint32_t settled = 0, falls = 0, unsettled = 0;
+    double overshoot_sum = 0.0, overshoot_max = 0.0, drift_abs_sum = 0.0, speed_err_sum = 0.0;
+    double drift_max = 0.0;
+    double sim_seconds = 0.0;
+    uint32_t rng = opt.seed ? opt.seed : 1u;
+
+    printf("BalanceBot closed-loop simulation\n");
+    printf("  loop %u Hz, velocity loop %.1f Hz, IMU %u Hz, filter %s\n",
+           cfg.loop_hz, (double)cfg.loop_hz / (cfg.velocity_divider ? cfg.velocity_divider : 1),
+           cfg.imu_rate_hz, attitude_estimator_type_name(cfg.filter));
+    printf("  angle Kp %.2f Ki %.2f Kd %.2f | velocity Kp %.2f Ki %.2f Kd %.2f\n",
+           cfg.balance_kp, cfg.balance_ki, cfg.balance_kd, cfg.velocity_kp, cfg.velocity_ki, cfg.velocity_kd);
+    printf("  %u runs x %.1f s, tilt %.1f..%.1f deg, gyro bias <= %.1f deg/s, slope %.1f deg, speed %.1f cm/s\n",
+           opt.runs, cfg.duration_s, opt.min_tilt_deg, opt.max_tilt_deg, opt.max_gyro_bias_dps,
+           cfg.plant.slope_deg, cfg.target_velocity_cms);
+
+    clock_t start = clock();
+    for (uint32_t run = 0; run < opt.runs; run++) {
+        sim_config_t c = cfg;
+        double tilt = sim_uniform(&rng, opt.min_tilt_deg, opt.max_tilt_deg);
+        c.initial_pitch_deg = (sim_uniform(&rng, 0.0, 1.0) < 0.5) ? -tilt : tilt;
+        c.plant.gyro_bias_dps[0] = sim_uniform(&rng, -opt.max_gyro_bias_dps, opt.max_gyro_bias_dps);
+        c.plant.gyro_bias_dps[1] = sim_uniform(&rng, -opt.max_gyro_bias_dps, opt.max_gyro_bias_dps);
+        c.plant.gyro_bias_dps[2] = sim_uniform(&rng, -opt.max_gyro_bias_dps, opt.max_gyro_bias_dps);
+        c.seed = rng;
+
+        sim_result_t r;
+        if (!sim_run(&c, &r)) {
+            fprintf(stderr, "invalid rates: IMU rate must be a multiple of the loop rate\n");
+            free(settle);
+            return 2;
+        }
+        sim_seconds += (double)r.cycles / c.loop_hz;
+
+        // Runaway on a slope still settles in pitch, so drift is checked on every upright run
+        double drift_abs = (r.drift_cm < 0.0) ? -r.drift_cm : r.drift_cm;
+        if (!r.fell && drift_abs > drift_max) drift_max = drift_abs;
+
+        if (r.fell) {
+            falls++;
+        } else if (r.settle_time_s < 0.0) {
+            unsettled++;
+        } else {
+            settle[settled++] = r.settle_time_s;
+            overshoot_sum += r.overshoot_deg;
+            if (r.overshoot_deg > overshoot_max) overshoot_max = r.overshoot_deg;
+            drift_abs_sum += drift_abs;
+            double speed_err = r.final_velocity_cms - c.target_velocity_cms;
+            speed_err_sum += (speed_err < 0.0) ? -speed_err : speed_err;
+        }
+        if (opt.verbose) {
+            printf("  run %3u tilt %+6.2f bias %+5.2f | %s settle %6.3f s overshoot %5.2f deg "
+                   "max %5.1f deg drift %+7.1f cm v %+6.1f cm/s\n",
+                   run, c.initial_pitch_deg, c.plant.gyro_bias_dps[1],
+                   r.fell ? "FELL  " : "ok    ", r.settle_time_s, r.overshoot_deg,
+                   r.max_abs_pitch_deg, r.drift_cm, r.final_velocity_cms);
+        }
+    }
+    double wall = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    qsort(settle, settled, sizeof(double), compare_double);
+    double fall_rate = (double)falls / opt.runs;
+    double p95 = percentile(settle, settled, 95.0);
+
+    printf("\n");
+    printf("  fall rate     %5.1f %% (%u/%u)\n", fall_rate * 100.0, falls, opt.runs);
+    printf("  not settled   %u (band +/-%.1f deg)\n", unsettled, cfg.settle_band_deg);
+    if (settled > 0) {
+        printf("  settle time   p50 %.3f s  p95 %.3f s  max %.3f s\n",
+               percentile(settle, settled, 50.0), p95, settle[settled - 1]);
+        printf("  overshoot     mean %.2f deg  max %.2f deg\n", overshoot_sum / settled, overshoot_max);
+        printf("  drift         mean |x| %.1f cm, mean |v - target| %.2f cm/s\n",
+               drift_abs_sum / settled, speed_err_sum / settled);
+    }
+    if (falls < opt.runs) {
+        printf("  max drift     %.1f cm (upright runs)\n", drift_max);
+    }
+    printf("  simulated %.0f s in %.2f s (%.0fx real time)\n",
+           sim_seconds, wall, (wall > 0.0) ? sim_seconds / wall : 0.0);
+
+    int fail = 0;
+    if (fall_rate > opt.max_fall_rate) {
+        printf("FAIL: fall rate %.3f > %.3f\n", fall_rate, opt.max_fall_rate);
+        fail = 1;
+    }
+    if (opt.max_settle_s >= 0.0 && (settled == 0 || p95 > opt.max_settle_s || unsettled > 0)) {
+        printf("FAIL: p95 settle time %.3f s > %.3f s or runs did not settle\n", p95, opt.max_settle_s);
+        fail = 1;
+    }
+    if (opt.max_drift_cm >= 0.0 && drift_max > opt.max_drift_cm) {
+        printf("FAIL: max drift %.1f cm > %.1f cm\n", drift_max, opt.max_drift_cm);
+        fail = 1;
+    }
+    free(settle);
+    return fail;
+}
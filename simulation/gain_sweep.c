@@ -0,0 +1,446 @@
+/**
+ * @file gain_sweep.c
+ * @brief 밸런스 PID / 칼만 파라미터 병렬 몬테카를로 스윕 도구
+ *
+ * 각도 루프 게인(Kp/Ki/Kd)과 칼만 노이즈 파라미터(Q_angle/Q_bias/R_measure)를
+ * 격자 또는 무작위로 조합해, 조합마다 같은 에피소드 집합(초기 기울기, 자이로
+ * 바이어스, 노이즈 시드)으로 폐루프 시뮬레이션을 돌리고 안정성 지표 순으로 정렬합니다.
+ * 에피소드는 work_pool로 모든 코어에 분산하며, 결과는 스레드 수와 무관하게 동일합니다.
+ *
+ * 사용 예:
+ *   ./gain_sweep --kp 10 40 7 --kd 0.2 1.2 6 --episodes 20 --csv sweep.csv
+ *   ./gain_sweep --random 2000 --kp 5 50 --kd 0.1 2 --qangle 1e-4 1e-2 --json sweep.json
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "sim_loop.h"
+#include "work_pool.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SWEEP_MAX_CANDIDATES    10000000u   ///< 격자 조합 수 상한
+
+/**
+ * @enum sweep_param_t
+ * @brief 스윕 대상 파라미터
+ */
+typedef enum {
+    SWEEP_KP = 0,
+    SWEEP_KI,
+    SWEEP_KD,
+    SWEEP_Q_ANGLE,
+    SWEEP_Q_BIAS,
+    SWEEP_R_MEASURE,
+    SWEEP_PARAM_COUNT
+} sweep_param_t;
+
+/**
+ * @struct sweep_axis_t
+ * @brief 파라미터 하나의 탐색 범위
+ */
+typedef struct {
+    const char* option;     ///< 명령행 옵션 이름
+    const char* column;     ///< CSV/JSON 열 이름
+    double min;             ///< 하한
+    double max;             ///< 상한
+    uint32_t steps;         ///< 격자 점 수 (1이면 min 고정)
+    bool log_scale;         ///< 로그 간격 (노이즈 분산처럼 자릿수 단위로 찾는 값)
+} sweep_axis_t;
+
+/**
+ * @struct sweep_scenario_t
+ * @brief 에피소드 하나의 무작위 조건 (모든 후보가 공유)
+ */
+typedef struct {
+    double initial_pitch_deg;   ///< 초기 피치 (degree)
+    double gyro_bias_dps[3];    ///< 자이로 바이어스 (deg/s)
+    uint32_t seed;              ///< 센서 노이즈 시드
+} sweep_scenario_t;
+
+/**
+ * @struct sweep_candidate_t
+ * @brief 후보 파라미터 조합과 집계 지표
+ */
+typedef struct {
+    float param[SWEEP_PARAM_COUNT];     ///< 파라미터 값
+    double fall_rate;                   ///< 넘어짐 비율
+    double unsettled_rate;              ///< 넘어지지 않았지만 정착하지 못한 비율
+    double settle_mean_s;               ///< 평균 정착 시간 (s, 정착한 에피소드)
+    double settle_p95_s;                ///< p95 정착 시간 (s, 정착한 에피소드)
+    double overshoot_mean_deg;          ///< 평균 오버슈트 (degree)
+    double max_pitch_deg;               ///< 전체 에피소드 최대 |피치| (degree)
+    double rms_motor;                   ///< 평균 모터 명령 RMS
+    double drift_mean_cm;               ///< 평균 |최종 위치| (cm)
+    double score;                       ///< 순위 점수 (작을수록 좋음)
+} sweep_candidate_t;
+
+/**
+ * @struct sweep_job_t
+ * @brief 워커가 공유하는 스윕 컨텍스트
+ */
+typedef struct {
+    const sim_config_t* base;           ///< 공통 시뮬레이션 설정
+    const sweep_scenario_t* scenarios;  ///< 에피소드 조건
+    uint32_t episodes;                  ///< 후보당 에피소드 수
+    const sweep_candidate_t* candidates; ///< 후보 배열
+    sim_result_t* results;              ///< [후보 * episodes + 에피소드] 결과
+} sweep_job_t;
+
+static void print_usage(const char* prog) {
+    printf("Usage: %s [options]\n"
+           "Parameter ranges (grid: MIN MAX STEPS, random: MIN MAX; unset = config.h value):\n"
+           "  --kp/--ki/--kd MIN MAX [STEPS]              angle loop gains (linear)\n"
+           "  --qangle/--qbias/--rmeasure MIN MAX [STEPS] Kalman noise (log spaced, < 2.0)\n"
+           "Search:\n"
+           "  --random N          sample N candidates uniformly instead of the full grid\n"
+           "  --episodes N        randomized episodes per candidate (default 20)\n"
+           "  --threads N         worker threads (default: all cores)\n"
+           "  --seed N            scenario / sampling seed (default 1)\n"
+           "Scenario:\n"
+           "  --duration S        seconds per episode (default 5)\n"
+           "  --loop-hz N         control loop rate (default CONFIG_CONTROL_LOOP_HZ)\n"
+           "  --filter N          attitude filter index (default CONFIG_ATTITUDE_FILTER)\n"
+           "  --tilt MIN MAX      initial tilt range in degrees (default 2 10)\n"
+           "  --bias X            max pitch gyro bias in deg/s (default 2)\n"
+           "  --slope DEG         ground slope (default 0)\n"
+           "  --push DPS          pitch-rate kick at t=duration/2 (default none)\n"
+           "Output:\n"
+           "  --csv FILE          ranked CSV ('-' for stdout)\n"
+           "  --json FILE         ranked JSON ('-' for stdout)\n"
+           "  --top N             rows printed to the console (default 10)\n", prog);
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_candidate(const void* a, const void* b) {
+    const sweep_candidate_t* x = (const sweep_candidate_t*)a;
+    const sweep_candidate_t* y = (const sweep_candidate_t*)b;
+    return (x->score > y->score) - (x->score < y->score);
+}
+
+static double axis_value(const sweep_axis_t* ax, double t) {
+    if (ax->log_scale && ax->min > 0.0 && ax->max > 0.0) {
+        return exp(log(ax->min) + (log(ax->max) - log(ax->min)) * t);
+    }
+    return ax->min + (ax->max - ax->min) * t;
+}
+
+/**
+ * @brief 워커 작업: 후보 하나의 에피소드 하나 실행
+ */
+static void run_episode(uint32_t item, uint32_t worker, void* ctx) {
+    (void)worker;
+    sweep_job_t* job = (sweep_job_t*)ctx;
+    const sweep_candidate_t* cand = &job->candidates[item / job->episodes];
+    const sweep_scenario_t* sc = &job->scenarios[item % job->episodes];
+
+    sim_config_t c = *job->base;
+    c.balance_kp = cand->param[SWEEP_KP];
+    c.balance_ki = cand->param[SWEEP_KI];
+    c.balance_kd = cand->param[SWEEP_KD];
+    c.kalman_q_angle = cand->param[SWEEP_Q_ANGLE];
+    c.kalman_q_bias = cand->param[SWEEP_Q_BIAS];
+    c.kalman_r_measure = cand->param[SWEEP_R_MEASURE];
+    c.initial_pitch_deg = sc->initial_pitch_deg;
+    memcpy(c.plant.gyro_bias_dps, sc->gyro_bias_dps, sizeof(sc->gyro_bias_dps));
+    c.seed = sc->seed;
+
+    sim_run(&c, &job->results[item]);
+}
+
+/**
+ * @brief 에피소드 결과를 후보 지표로 집계하고 점수 계산
+ *
+ * 점수는 넘어짐을 가장 크게, 그다음 미정착을 벌점으로 주고,
+ * 나머지는 p95 정착 시간(s) + 오버슈트/모터 사용량 소량 가중치입니다.
+ */
+static void aggregate(sweep_candidate_t* cand, const sim_result_t* r, uint32_t episodes,
+                      double duration_s, double* settle_buf) {
+    uint32_t falls = 0, unsettled = 0, settled = 0;
+    double settle_sum = 0.0, overshoot_sum = 0.0, motor_sum = 0.0, drift_sum = 0.0;
+    cand->max_pitch_deg = 0.0;
+
+    for (uint32_t e = 0; e < episodes; e++) {
+        if (r[e].max_abs_pitch_deg > cand->max_pitch_deg) cand->max_pitch_deg = r[e].max_abs_pitch_deg;
+        motor_sum += r[e].rms_motor_cmd;
+        if (r[e].fell) {
+            falls++;
+            continue;
+        }
+        drift_sum += fabs(r[e].drift_cm);
+        if (r[e].settle_time_s < 0.0) {
+            unsettled++;
+            continue;
+        }
+        settle_buf[settled++] = r[e].settle_time_s;
+        settle_sum += r[e].settle_time_s;
+        overshoot_sum += r[e].overshoot_deg;
+    }
+
+    cand->fall_rate = (double)falls / episodes;
+    cand->unsettled_rate = (double)unsettled / episodes;
+    cand->rms_motor = motor_sum / episodes;
+    cand->drift_mean_cm = (falls < episodes) ? drift_sum / (episodes - falls) : 0.0;
+    if (settled > 0) {
+        qsort(settle_buf, settled, sizeof(double), compare_double);
+        cand->settle_mean_s = settle_sum / settled;
+        cand->settle_p95_s = settle_buf[(uint32_t)(0.95 * (settled - 1) + 0.5)];
+        cand->overshoot_mean_deg = overshoot_sum / settled;
+    } else {
+        cand->settle_mean_s = -1.0;
+        cand->settle_p95_s = -1.0;
+        cand->overshoot_mean_deg = 0.0;
+    }
+
+    double settle_term = (settled > 0) ? cand->settle_p95_s : duration_s;
+    cand->score = 1000.0 * cand->fall_rate + 100.0 * cand->unsettled_rate + settle_term
+                + 0.05 * cand->overshoot_mean_deg + 0.002 * cand->rms_motor;
+}
+
+static FILE* open_output(const char* path) {
+    if (strcmp(path, "-") == 0) return stdout;
+    return fopen(path, "w");
+}
+
+static void close_output(FILE* f) {
+    if (f != stdout) fclose(f);
+}
+
+static void write_csv(FILE* f, const sweep_axis_t* axes, const sweep_candidate_t* c, uint32_t n) {
+    fprintf(f, "rank");
+    for (int p = 0; p < SWEEP_PARAM_COUNT; p++) fprintf(f, ",%s", axes[p].column);
+    fprintf(f, ",score,fall_rate,unsettled_rate,settle_mean_s,settle_p95_s,overshoot_mean_deg,"
+               "max_pitch_deg,rms_motor,drift_mean_cm\n");
+    for (uint32_t i = 0; i < n; i++) {
+        fprintf(f, "%u", i + 1);
+        for (int p = 0; p < SWEEP_PARAM_COUNT; p++) fprintf(f, ",%.6g", c[i].param[p]);
+        fprintf(f, ",%.4f,%.4f,%.4f,%.4f,%.4f,%.3f,%.2f,%.2f,%.2f\n",
+                c[i].score, c[i].fall_rate, c[i].unsettled_rate, c[i].settle_mean_s, c[i].settle_p95_s,
+                c[i].overshoot_mean_deg, c[i].max_pitch_deg, c[i].rms_motor, c[i].drift_mean_cm);
+    }
+}
+
+static void write_json(FILE* f, const sweep_axis_t* axes, const sweep_candidate_t* c, uint32_t n,
+                       uint32_t episodes, double duration_s) {
+    fprintf(f, "{\n  \"episodes\": %u,\n  \"duration_s\": %.3f,\n  \"candidates\": [\n", episodes, duration_s);
+    for (uint32_t i = 0; i < n; i++) {
+        fprintf(f, "    {\"rank\": %u", i + 1);
+        for (int p = 0; p < SWEEP_PARAM_COUNT; p++) fprintf(f, ", \"%s\": %.6g", axes[p].column, c[i].param[p]);
+        fprintf(f, ", \"score\": %.4f, \"fall_rate\": %.4f, \"unsettled_rate\": %.4f, "
+                   "\"settle_mean_s\": %.4f, \"settle_p95_s\": %.4f, \"overshoot_mean_deg\": %.3f, "
+                   "\"max_pitch_deg\": %.2f, \"rms_motor\": %.2f, \"drift_mean_cm\": %.2f}%s\n",
+                c[i].score, c[i].fall_rate, c[i].unsettled_rate, c[i].settle_mean_s, c[i].settle_p95_s,
+                c[i].overshoot_mean_deg, c[i].max_pitch_deg, c[i].rms_motor, c[i].drift_mean_cm,
+                (i + 1 < n) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+    sim_config_t cfg;
+    sim_config_default(&cfg);
+    cfg.duration_s = 5.0;
+
+    sweep_axis_t axes[SWEEP_PARAM_COUNT] = {
+        [SWEEP_KP]        = {"--kp", "kp", cfg.balance_kp, cfg.balance_kp, 1, false},
+        [SWEEP_KI]        = {"--ki", "ki", cfg.balance_ki, cfg.balance_ki, 1, false},
+        [SWEEP_KD]        = {"--kd", "kd", cfg.balance_kd, cfg.balance_kd, 1, false},
+        [SWEEP_Q_ANGLE]   = {"--qangle", "q_angle", cfg.kalman_q_angle, cfg.kalman_q_angle, 1, true},
+        [SWEEP_Q_BIAS]    = {"--qbias", "q_bias", cfg.kalman_q_bias, cfg.kalman_q_bias, 1, true},
+        [SWEEP_R_MEASURE] = {"--rmeasure", "r_measure", cfg.kalman_r_measure, cfg.kalman_r_measure, 1, true},
+    };
+    uint32_t random_count = 0, episodes = 20, threads = 0, seed = 1, top = 10;
+    double min_tilt = 2.0, max_tilt = 10.0, max_bias = 2.0;
+    const char* csv_path = NULL;
+    const char* json_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (strcmp(a, "--help") == 0 || strcmp(a, "-h") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        }
+        bool is_axis = false;
+        for (int p = 0; p < SWEEP_PARAM_COUNT; p++) {
+            if (strcmp(a, axes[p].option) != 0) continue;
+            if (i + 2 >= argc) {
+                fprintf(stderr, "%s needs MIN MAX [STEPS]\n", a);
+                return 2;
+            }
+            axes[p].min = atof(argv[++i]);
+            axes[p].max = atof(argv[++i]);
+            axes[p].steps = 5;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                axes[p].steps = (uint32_t)strtoul(argv[++i], NULL, 10);
+                if (axes[p].steps == 0) axes[p].steps = 1;
+            }
+            is_axis = true;
+        }
+        if (is_axis) continue;
+        if (i + 1 >= argc) {
+            fprintf(stderr, "missing value for %s\n", a);
+            return 2;
+        }
+        const char* v = argv[++i];
+        if (strcmp(a, "--random") == 0) random_count = (uint32_t)strtoul(v, NULL, 10);
+        else if (strcmp(a, "--episodes") == 0) episodes = (uint32_t)strtoul(v, NULL, 10);
+        else if (strcmp(a, "--threads") == 0) threads = (uint32_t)strtoul(v, NULL, 10);
+        else if (strcmp(a, "--seed") == 0) seed = (uint32_t)strtoul(v, NULL, 10);
+        else if (strcmp(a, "--duration") == 0) cfg.duration_s = atof(v);
+        else if (strcmp(a, "--loop-hz") == 0) cfg.loop_hz = (uint32_t)strtoul(v, NULL, 10);
+        else if (strcmp(a, "--filter") == 0) cfg.filter = (attitude_filter_type_t)atoi(v);
+        else if (strcmp(a, "--tilt") == 0 && i + 1 < argc) {
+            min_tilt = atof(v);
+            max_tilt = atof(argv[++i]);
+        }
+        else if (strcmp(a, "--bias") == 0) max_bias = atof(v);
+        else if (strcmp(a, "--slope") == 0) cfg.plant.slope_deg = atof(v);
+        else if (strcmp(a, "--push") == 0) cfg.push_rate_dps = atof(v);
+        else if (strcmp(a, "--csv") == 0) csv_path = v;
+        else if (strcmp(a, "--json") == 0) json_path = v;
+        else if (strcmp(a, "--top") == 0) top = (uint32_t)strtoul(v, NULL, 10);
+        else {
+            fprintf(stderr, "unknown option %s\n", a);
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (episodes == 0) episodes = 1;
+    if (cfg.push_rate_dps != 0.0) cfg.push_time_s = cfg.duration_s / 2.0;
+    if (cfg.loop_hz == 0 || cfg.imu_rate_hz % cfg.loop_hz != 0) {
+        fprintf(stderr, "invalid rates: IMU rate must be a multiple of the loop rate\n");
+        return 2;
+    }
+    for (int p = SWEEP_Q_ANGLE; p <= SWEEP_R_MEASURE; p++) {
+        if (axes[p].min <= 0.0 || axes[p].max >= 2.0) {
+            fprintf(stderr, "%s range must be within (0, 2)\n", axes[p].option);
+            return 2;
+        }
+    }
+
+    uint32_t rng = seed ? seed : 1u;
+    uint64_t grid = 1;
+    for (int p = 0; p < SWEEP_PARAM_COUNT; p++) {
+        grid *= (random_count > 0) ? 1u : axes[p].steps;
+        if (grid > SWEEP_MAX_CANDIDATES) {
+            fprintf(stderr, "grid has more than %u candidates, use --random\n", SWEEP_MAX_CANDIDATES);
+            return 2;
+        }
+    }
+    uint32_t count = (random_count > 0) ? random_count : (uint32_t)grid;
+    if ((uint64_t)count * episodes > UINT32_MAX) {
+        fprintf(stderr, "too many episodes\n");
+        return 2;
+    }
+
+    sweep_candidate_t* cands = (sweep_candidate_t*)calloc(count, sizeof(sweep_candidate_t));
+    sweep_scenario_t* scenarios = (sweep_scenario_t*)calloc(episodes, sizeof(sweep_scenario_t));
+    sim_result_t* results = (sim_result_t*)calloc((size_t)count * episodes, sizeof(sim_result_t));
+    double* settle_buf = (double*)calloc(episodes, sizeof(double));
+    if (cands == NULL || scenarios == NULL || results == NULL || settle_buf == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 2;
+    }
+
+    // Common random numbers: every candidate faces the same episodes
+    for (uint32_t e = 0; e < episodes; e++) {
+        double tilt = sim_uniform(&rng, min_tilt, max_tilt);
+        scenarios[e].initial_pitch_deg = (sim_uniform(&rng, 0.0, 1.0) < 0.5) ? -tilt : tilt;
+        for (int k = 0; k < 3; k++) {
+            scenarios[e].gyro_bias_dps[k] = sim_uniform(&rng, -max_bias, max_bias);
+        }
+        scenarios[e].seed = rng;
+    }
+
+    // Candidate set: full grid, or uniform (log-uniform for Kalman noise) random samples
+    for (uint32_t c = 0; c < count; c++) {
+        uint32_t index = c;
+        for (int p = 0; p < SWEEP_PARAM_COUNT; p++) {
+            double t;
+            if (random_count > 0) {
+                t = (axes[p].steps > 1) ? sim_uniform(&rng, 0.0, 1.0) : 0.0;
+            } else {
+                uint32_t k = index % axes[p].steps;
+                index /= axes[p].steps;
+                t = (axes[p].steps > 1) ? (double)k / (axes[p].steps - 1) : 0.0;
+            }
+            cands[c].param[p] = (float)axis_value(&axes[p], t);
+        }
+    }
+
+    if (threads == 0) threads = work_pool_cpu_count();
+    printf("BalanceBot gain sweep: %u candidates x %u episodes x %.1f s, %u threads, filter %s\n",
+           count, episodes, cfg.duration_s, threads, attitude_estimator_type_name(cfg.filter));
+
+    sweep_job_t job = {
+        .base = &cfg, .scenarios = scenarios, .episodes = episodes,
+        .candidates = cands, .results = results,
+    };
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (work_pool_run(count * episodes, threads, run_episode, &job) != 0) {
+        fprintf(stderr, "failed to start worker pool\n");
+        return 2;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double wall = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+
+    double sim_seconds = 0.0;
+    for (uint32_t c = 0; c < count; c++) {
+        const sim_result_t* r = &results[(size_t)c * episodes];
+        for (uint32_t e = 0; e < episodes; e++) {
+            sim_seconds += (double)r[e].cycles / cfg.loop_hz;
+        }
+        aggregate(&cands[c], r, episodes, cfg.duration_s, settle_buf);
+    }
+    qsort(cands, count, sizeof(sweep_candidate_t), compare_candidate);
+
+    printf("simulated %.0f s in %.2f s wall (%.0fx real time)\n\n",
+           sim_seconds, wall, (wall > 0.0) ? sim_seconds / wall : 0.0);
+    printf("rank       kp       ki       kd   q_angle    q_bias r_measure |  score  fall  p95 settle  overshoot\n");
+    for (uint32_t i = 0; i < count && i < top; i++) {
+        const sweep_candidate_t* c = &cands[i];
+        printf("%4u %8.3f %8.3f %8.3f %9.2e %9.2e %9.2e | %6.3f %4.0f%% %9.3f s %7.2f deg\n",
+               i + 1, c->param[SWEEP_KP], c->param[SWEEP_KI], c->param[SWEEP_KD],
+               c->param[SWEEP_Q_ANGLE], c->param[SWEEP_Q_BIAS], c->param[SWEEP_R_MEASURE],
+               c->score, c->fall_rate * 100.0, c->settle_p95_s, c->overshoot_mean_deg);
+    }
+
+    int rc = 0;
+    if (csv_path != NULL) {
+        FILE* f = open_output(csv_path);
+        if (f == NULL) {
+            fprintf(stderr, "cannot open %s\n", csv_path);
+            rc = 2;
+        } else {
+            write_csv(f, axes, cands, count);
+            close_output(f);
+        }
+    }
+    if (json_path != NULL) {
+        FILE* f = open_output(json_path);
+        if (f == NULL) {
+            fprintf(stderr, "cannot open %s\n", json_path);
+            rc = 2;
+        } else {
+            write_json(f, axes, cands, count, episodes, cfg.duration_s);
+            close_output(f);
+        }
+    }
+
+    free(cands);
+    free(scenarios);
+    free(results);
+    free(settle_buf);
+    return rc;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file sim_loop.c
+ * @brief 폐루프 밸런싱 시뮬레이션 구현 파일
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "sim_loop.h"
+#include "../src/config.h"
+#include "../src/logic/pid_controller.h"
+#include "../src/system/robot_state_machine.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define SIM_PI          3.14159265358979323846
+#define SIM_RAD2DEG     (180.0 / SIM_PI)
+
+void sim_config_default(sim_config_t* cfg) {
+    sim_plant_default_params(&cfg->plant);
+    cfg->initial_pitch_deg = 5.0;
+    cfg->duration_s = 10.0;
+    cfg->seed = 1u;
+
+    cfg->loop_hz = CONFIG_CONTROL_LOOP_HZ;
+    cfg->imu_rate_hz = 1000;
+    cfg->physics_hz = 10000;
+    cfg->encoder_window_s = 0.1;
+    cfg->filter = (attitude_filter_type_t)CONFIG_ATTITUDE_FILTER;
+    cfg->kalman_q_angle = CONFIG_KALMAN_Q_ANGLE;
+    cfg->kalman_q_bias = CONFIG_KALMAN_Q_BIAS;
+    cfg->kalman_r_measure = CONFIG_KALMAN_R_MEASURE;
+
+    cfg->balance_kp = CONFIG_BALANCE_PID_KP;
+    cfg->balance_ki = CONFIG_BALANCE_PID_KI;
+    cfg->balance_kd = CONFIG_BALANCE_PID_KD;
+    cfg->velocity_kp = CONFIG_VELOCITY_PID_KP;
+    cfg->velocity_ki = CONFIG_VELOCITY_PID_KI;
+    cfg->velocity_kd = CONFIG_VELOCITY_PID_KD;
+    cfg->velocity_tilt_limit = CONFIG_VELOCITY_TILT_LIMIT;
+    cfg->velocity_divider = CONFIG_VELOCITY_LOOP_DIVIDER;
+    cfg->fallen_angle = CONFIG_FALLEN_ANGLE_THRESHOLD;
+    cfg->target_velocity_cms = 0.0f;
+
+    cfg->push_time_s = -1.0;
+    cfg->push_rate_dps = 0.0;
+    cfg->settle_band_deg = 1.0;
+}
+
+/**
+ * @brief 기록된 피치 궤적에서 정착 시간과 오버슈트 계산
+ *
+ * 기준값은 마지막 1초(또는 마지막 10%) 평균이며, 정착 시간은
+ * 그 이후로 계속 대역 안에 머무르기 시작한 시각입니다.
+ */
+static void compute_settle_metrics(const float* pitch, uint32_t n, uint32_t loop_hz,
+                                   double initial, double band, sim_result_t* r) {
+    uint32_t tail = loop_hz;
+    if (tail > n / 10) tail = n / 10;
+    if (tail == 0) tail = 1;
+    double sum = 0.0;
+    for (uint32_t i = n - tail; i < n; i++) sum += pitch[i];
+    double final_pitch = sum / tail;
+    r->final_pitch_deg = final_pitch;
+
+    double dir = (initial >= final_pitch) ? 1.0 : -1.0;
+    uint32_t last_outside = 0;
+    bool ever_outside = false;
+    r->overshoot_deg = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        double err = pitch[i] - final_pitch;
+        if (fabs(err) > band) {
+            last_outside = i;
+            ever_outside = true;
+        }
+        double over = -err * dir;
+        if (over > r->overshoot_deg) r->overshoot_deg = over;
+    }
+    if (!ever_outside) {
+        r->settle_time_s = 0.0;
+    } else if (last_outside + tail >= n) {
+        r->settle_time_s = -1.0; // still moving in the averaging window
+    } else {
+        r->settle_time_s = (double)(last_outside + 1) / loop_hz;
+    }
+}
+
+bool sim_run(const sim_config_t* cfg, sim_result_t* result) {
+    if (cfg->loop_hz == 0 || cfg->imu_rate_hz % cfg->loop_hz != 0 ||
+        cfg->physics_hz % cfg->imu_rate_hz != 0) {
+        return false;
+    }
+    const uint32_t samples_per_cycle = cfg->imu_rate_hz / cfg->loop_hz;
+    const uint32_t steps_per_sample = cfg->physics_hz / cfg->imu_rate_hz;
+    const double physics_dt = 1.0 / cfg->physics_hz;
+    const float sample_dt = 1.0f / (float)cfg->imu_rate_hz;
+    const float loop_dt = 1.0f / (float)cfg->loop_hz;
+    const uint32_t total_cycles = (uint32_t)(cfg->duration_s * cfg->loop_hz + 0.5);
+    const double wheel_diameter_cm = cfg->plant.wheel_radius * 200.0;
+
+    sim_plant_t plant;
+    sim_plant_init(&plant, &cfg->plant, cfg->initial_pitch_deg, cfg->seed);
+
+    // Firmware modules, configured as app_main does
+    attitude_estimator_t attitude;
+    attitude_estimator_init(&attitude, cfg->filter);
+    attitude_estimator_set_mahony_gains(&attitude, CONFIG_MAHONY_KP, CONFIG_MAHONY_KI);
+    attitude_estimator_set_madgwick_beta(&attitude, CONFIG_MADGWICK_BETA);
+    attitude_estimator_set_kalman_noise(&attitude, cfg->kalman_q_angle, cfg->kalman_q_bias, cfg->kalman_r_measure);
+    attitude_estimator_set_complementary_tau(&attitude, CONFIG_COMPLEMENTARY_TAU_S);
+    balance_pid_t balance_pid;
+    balance_pid_init(&balance_pid);
+    balance_pid_set_balance_tunings(&balance_pid, cfg->balance_kp, cfg->balance_ki, cfg->balance_kd);
+    balance_pid_set_velocity_tunings(&balance_pid, cfg->velocity_kp, cfg->velocity_ki, cfg->velocity_kd);
+    pid_controller_set_output_limits(&balance_pid.pitch_pid, CONFIG_PID_OUTPUT_MIN, CONFIG_PID_OUTPUT_MAX);
+    pid_controller_set_output_limits(&balance_pid.velocity_pid, -cfg->velocity_tilt_limit, cfg->velocity_tilt_limit);
+    balance_pid_set_max_tilt_angle(&balance_pid, cfg->fallen_angle);
+    balance_pid_set_angle_offset(&balance_pid, CONFIG_BALANCE_ANGLE_TARGET);
+    balance_pid_set_velocity_divider(&balance_pid, cfg->velocity_divider);
+    balance_pid_reset(&balance_pid);
+    robot_state_t state = ROBOT_STATE_IDLE;
+
+    float* pitch_trace = (float*)malloc(sizeof(float) * (total_cycles > 0 ? total_cycles : 1));
+    if (pitch_trace == NULL) {
+        return false;
+    }
+
+    result->fell = false;
+    result->fall_time_s = -1.0;
+    result->max_abs_pitch_deg = 0.0;
+    double motor_sq = 0.0, velocity_tail = 0.0;
+    uint32_t velocity_tail_count = 0;
+    bool pushed = false;
+
+    int32_t enc_last_count = sim_plant_encoder_count(&plant);
+    double enc_last_time = 0.0;
+    float velocity = 0.0f;
+    float angle = 0.0f, angle_rate = 0.0f;
+    int motor_cmd = 0;
+    uint32_t cycle;
+
+    for (cycle = 0; cycle < total_cycles; cycle++) {
+        // Plant runs until the data-ready edge of this cycle; the FIFO batch is fused in one go
+        const attitude_t* att = NULL;
+        for (uint32_t k = 0; k < samples_per_cycle; k++) {
+            for (uint32_t s = 0; s < steps_per_sample; s++) {
+                sim_plant_step(&plant, (double)motor_cmd, physics_dt);
+            }
+            if (!pushed && cfg->push_time_s >= 0.0 && plant.time >= cfg->push_time_s) {
+                plant.pitch_rate += cfg->push_rate_dps / SIM_RAD2DEG;
+                pushed = true;
+            }
+            sim_imu_sample_t imu;
+            sim_plant_sample_imu(&plant, &imu);
+            att = attitude_estimator_update(&attitude, imu.accel_x, imu.accel_y, imu.accel_z,
+                                            imu.gyro_x, imu.gyro_y, imu.gyro_z, sample_dt);
+        }
+        angle = att->pitch;
+        angle_rate = att->pitch_rate;
+
+        // Encoder speed over a fixed window, like encoder_sensor_update_speed()
+        if (plant.time - enc_last_time >= cfg->encoder_window_s - 1e-9) {
+            int32_t count = sim_plant_encoder_count(&plant);
+            double distance_cm = (double)(count - enc_last_count) / cfg->plant.encoder_ppr * SIM_PI * wheel_diameter_cm;
+            velocity = (float)(distance_cm / (plant.time - enc_last_time));
+            enc_last_count = count;
+            enc_last_time = plant.time;
+        }
+
+        // State machine: operator holds "balance" the whole run
+        robot_state_inputs_t in = {
+            .angle = angle,
+            .fallen_angle = cfg->fallen_angle,
+            .balance_cmd = true,
+            .standup_cmd = false,
+            .standup_active = false,
+            .standup_complete = false,
+        };
+        state = robot_state_machine_next(state, &in);
+
+        if (state == ROBOT_STATE_BALANCING) {
+            balance_pid_set_target_velocity(&balance_pid, cfg->target_velocity_cms);
+            float out = balance_pid_compute_balance(&balance_pid, angle, angle_rate, velocity, loop_dt);
+            if (out > 255.0f) out = 255.0f;
+            if (out < -255.0f) out = -255.0f;
+            motor_cmd = (int)out;
+        } else {
+            motor_cmd = 0;
+            balance_pid_reset(&balance_pid);
+        }
+
+        double pitch_deg = plant.pitch * SIM_RAD2DEG;
+        pitch_trace[cycle] = (float)pitch_deg;
+        if (fabs(pitch_deg) > result->max_abs_pitch_deg) result->max_abs_pitch_deg = fabs(pitch_deg);
+        motor_sq += (double)motor_cmd * motor_cmd;
+        if (cycle + cfg->loop_hz >= total_cycles) {
+            velocity_tail += plant.velocity * 100.0;
+            velocity_tail_count++;
+        }
+
+        if (state == ROBOT_STATE_FALLEN) {
+            result->fell = true;
+            result->fall_time_s = plant.time;
+            cycle++;
+            break;
+        }
+    }
+
+    result->cycles = cycle;
+    result->drift_cm = plant.position * 100.0;
+    result->rms_motor_cmd = (cycle > 0) ? sqrt(motor_sq / cycle) : 0.0;
+    result->final_velocity_cms = (velocity_tail_count > 0) ? velocity_tail / velocity_tail_count : plant.velocity * 100.0;
+    if (result->fell || cycle == 0) {
+        result->settle_time_s = -1.0;
+        result->overshoot_deg = 0.0;
+        result->final_pitch_deg = plant.pitch * SIM_RAD2DEG;
+    } else {
+        compute_settle_metrics(pitch_trace, cycle, cfg->loop_hz, cfg->initial_pitch_deg,
+                               cfg->settle_band_deg, result);
+    }
+    free(pitch_trace);
+    return true;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file sim_loop.h
+ * @brief 폐루프 밸런싱 시뮬레이션 헤더 파일 (호스트 시뮬레이터 전용)
+ *
+ * 펌웨어의 실제 제어 코드(attitude_estimator/kalman_filter, balance_pid,
+ * robot_state_machine)를 sim_plant 모델과 연결해 main.c의 제어 주기를 재현합니다.
+ * - IMU 샘플은 IMU 출력 레이트로 생성되어 FIFO처럼 한 주기분이 한 번에 추정기로 들어감
+ * - 엔코더 속도는 encoder_sensor와 같이 고정 창(기본 100ms)의 카운트 차이로 계산
+ * - 모터 명령은 update_motors와 같이 ±255로 제한 후 정수로 버림, 다음 주기까지 유지
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef SIM_LOOP_H
+#define SIM_LOOP_H
+
+#include "sim_plant.h"
+#include "../src/logic/attitude_estimator.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct sim_config_t
+ * @brief 시뮬레이션 시나리오 및 제어기 설정
+ */
+typedef struct {
+    sim_plant_params_t plant;       ///< 플랜트 파라미터
+    double initial_pitch_deg;       ///< 초기 피치 (degree)
+    double duration_s;              ///< 시뮬레이션 시간 (s)
+    uint32_t seed;                  ///< 센서 노이즈 시드
+
+    uint32_t loop_hz;               ///< 제어 주기 (Hz)
+    uint32_t imu_rate_hz;           ///< IMU 출력 레이트 (Hz, loop_hz의 배수)
+    uint32_t physics_hz;            ///< 플랜트 적분 레이트 (Hz, imu_rate_hz의 배수)
+    double encoder_window_s;        ///< 엔코더 속도 계산 창 (s)
+    attitude_filter_type_t filter;  ///< 자세 추정 필터
+    float kalman_q_angle;           ///< 칼만 각도 프로세스 노이즈
+    float kalman_q_bias;            ///< 칼만 바이어스 프로세스 노이즈
+    float kalman_r_measure;         ///< 칼만 측정 노이즈
+
+    float balance_kp, balance_ki, balance_kd;       ///< 각도 루프 게인
+    float velocity_kp, velocity_ki, velocity_kd;    ///< 속도 루프 게인
+    float velocity_tilt_limit;      ///< 속도 루프 목표 기울기 제한 (degree)
+    uint32_t velocity_divider;      ///< 속도 루프 분주비
+    float fallen_angle;             ///< 넘어짐 판정 각도 (degree)
+    float target_velocity_cms;      ///< 목표 이동 속도 (cm/s)
+
+    double push_time_s;             ///< 외란 시각 (s, 음수면 없음)
+    double push_rate_dps;           ///< 외란으로 더해지는 피치 각속도 (deg/s)
+    double settle_band_deg;         ///< 정착 판정 대역 (degree)
+} sim_config_t;
+
+/**
+ * @struct sim_result_t
+ * @brief 시뮬레이션 결과 지표
+ */
+typedef struct {
+    bool fell;                  ///< 넘어짐(FALLEN 상태 진입) 여부
+    double fall_time_s;         ///< 넘어진 시각 (s, 넘어지지 않았으면 -1)
+    double settle_time_s;       ///< 정착 시간 (s, 정착하지 못했으면 -1)
+    double overshoot_deg;       ///< 최종 자세를 지나친 최대 각도 (degree)
+    double max_abs_pitch_deg;   ///< 최대 |피치| (degree)
+    double final_pitch_deg;     ///< 마지막 1초 평균 피치 (degree)
+    double final_velocity_cms;  ///< 마지막 1초 평균 속도 (cm/s)
+    double drift_cm;            ///< 최종 위치 (cm)
+    double rms_motor_cmd;       ///< 모터 명령 RMS (0~255)
+    uint32_t cycles;            ///< 실행된 제어 주기 수
+} sim_result_t;
+
+/**
+ * @brief 펌웨어 config.h 값으로 기본 설정 생성
+ *
+ * 기본 시나리오: 5도 기울어진 정지 상태에서 10초간 제자리 밸런싱.
+ *
+ * @param cfg 채울 설정 구조체
+ */
+void sim_config_default(sim_config_t* cfg);
+
+/**
+ * @brief 폐루프 시뮬레이션 한 번 실행
+ * @param cfg 시뮬레이션 설정
+ * @param result 결과 지표 출력
+ * @return bool 설정이 유효하면 true (레이트가 서로 나누어떨어지지 않으면 false)
+ */
+bool sim_run(const sim_config_t* cfg, sim_result_t* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIM_LOOP_H
@@ -0,0 +1,179 @@
+/**
+ * @file sim_plant.c
+ * @brief 2륜 도립진자 플랜트 모델 구현 파일
+ *
+ * 일반화 좌표는 경사면을 따른 바퀴 축 위치 s와 연직 기준 차체 피치 θ입니다.
+ * β = θ + α (α: 노면 경사)일 때 운동 방정식:
+ *
+ *   (M + m + Iw/r²)·s̈ + M·l·cosβ·θ̈ = τ/r + M·l·sinβ·θ̇² - (M + m)·g·sinα - c·ṡ
+ *   M·l·cosβ·s̈ + (Ib + M·l²)·θ̈     = M·g·l·sinθ - τ
+ *
+ * τ는 모터가 차체와 바퀴 사이에 거는 토크(전진 방향 양수)입니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "sim_plant.h"
+#include <math.h>
+
+#define SIM_G           9.80665     ///< 중력 가속도 (m/s²)
+#define SIM_PI          3.14159265358979323846
+#define SIM_DEG2RAD     (SIM_PI / 180.0)
+#define SIM_RAD2DEG     (180.0 / SIM_PI)
+#define SIM_ACCEL_LSB   16384.0     ///< MPU6050 ±2g LSB/g
+#define SIM_GYRO_LSB    131.0       ///< MPU6050 ±250dps LSB/(deg/s)
+
+void sim_plant_default_params(sim_plant_params_t* p) {
+    p->body_mass = 0.80;
+    p->body_com_height = 0.07;
+    p->body_inertia = 0.0017;
+    p->wheel_mass = 0.08;
+    p->wheel_radius = 0.0325;
+    p->wheel_inertia = 2.2e-4;
+    p->stall_torque = 0.25;
+    p->no_load_speed = 42.0;
+    p->deadband = 12.0;
+    p->rolling_friction = 0.5;
+    p->slope_deg = 0.0;
+    p->imu_height = 0.05;
+    p->gyro_noise_dps = 0.05;
+    p->accel_noise_g = 0.004;
+    p->gyro_bias_dps[0] = 0.0;
+    p->gyro_bias_dps[1] = 0.0;
+    p->gyro_bias_dps[2] = 0.0;
+    p->encoder_ppr = 360;
+}
+
+void sim_plant_init(sim_plant_t* plant, const sim_plant_params_t* params, double pitch_deg, uint32_t seed) {
+    plant->p = *params;
+    plant->pitch = pitch_deg * SIM_DEG2RAD;
+    plant->pitch_rate = 0.0;
+    plant->position = 0.0;
+    plant->velocity = 0.0;
+    plant->accel = 0.0;
+    plant->pitch_accel = 0.0;
+    plant->time = 0.0;
+    plant->rng = seed ? seed : 1u;
+}
+
+double sim_uniform(uint32_t* rng, double lo, double hi) {
+    *rng = *rng * 1664525u + 1013904223u;
+    return lo + (hi - lo) * (double)(*rng >> 8) / 16777216.0;
+}
+
+double sim_noise(uint32_t* rng, double sigma) {
+    double sum = 0.0;
+    for (int i = 0; i < 4; i++) {
+        sum += sim_uniform(rng, -0.5, 0.5);
+    }
+    return sum * sigma * 1.7320508;
+}
+
+/**
+ * @brief 모터 명령 → 구동 비율 (-1 ~ 1, 전진 양수)
+ *
+ * 펌웨어 규약(양의 명령 = 후진 토크)을 반영하고 데드밴드를 적용합니다.
+ */
+static double drive_fraction(const sim_plant_params_t* p, double motor_cmd) {
+    double c = -motor_cmd;
+    double mag = fabs(c);
+    if (mag > 255.0) mag = 255.0;
+    if (mag <= p->deadband) return 0.0;
+    double d = (mag - p->deadband) / (255.0 - p->deadband);
+    return (c > 0.0) ? d : -d;
+}
+
+/**
+ * @brief 상태 미분 계산
+ * @param y 상태 [θ, θ̇, s, ṡ]
+ * @param dy 출력 미분
+ */
+static void derivatives(const sim_plant_params_t* p, double drive, const double y[4], double dy[4]) {
+    const double M = p->body_mass, m = p->wheel_mass, l = p->body_com_height, r = p->wheel_radius;
+    const double alpha = p->slope_deg * SIM_DEG2RAD;
+    double theta = y[0], theta_dot = y[1], s_dot = y[3];
+    double beta = theta + alpha;
+
+    // DC motor: torque falls linearly with wheel speed relative to the body (coasts at zero duty)
+    double omega_rel = s_dot / r - theta_dot;
+    double tau = (drive != 0.0) ? p->stall_torque * (drive - omega_rel / p->no_load_speed) : 0.0;
+
+    double a11 = M + m + p->wheel_inertia / (r * r);
+    double a12 = M * l * cos(beta);
+    double a22 = p->body_inertia + M * l * l;
+    double b1 = tau / r + M * l * sin(beta) * theta_dot * theta_dot
+              - (M + m) * SIM_G * sin(alpha) - p->rolling_friction * s_dot;
+    double b2 = M * SIM_G * l * sin(theta) - tau;
+
+    double det = a11 * a22 - a12 * a12;
+    double s_ddot = (b1 * a22 - a12 * b2) / det;
+    double theta_ddot = (a11 * b2 - a12 * b1) / det;
+
+    dy[0] = theta_dot;
+    dy[1] = theta_ddot;
+    dy[2] = s_dot;
+    dy[3] = s_ddot;
+}
+
+void sim_plant_step(sim_plant_t* plant, double motor_cmd, double dt) {
+    double drive = drive_fraction(&plant->p, motor_cmd);
+    double y[4] = {plant->pitch, plant->pitch_rate, plant->position, plant->velocity};
+    double k1[4], k2[4], k3[4], k4[4], tmp[4];
+
+    derivatives(&plant->p, drive, y, k1);
+    for (int i = 0; i < 4; i++) tmp[i] = y[i] + 0.5 * dt * k1[i];
+    derivatives(&plant->p, drive, tmp, k2);
+    for (int i = 0; i < 4; i++) tmp[i] = y[i] + 0.5 * dt * k2[i];
+    derivatives(&plant->p, drive, tmp, k3);
+    for (int i = 0; i < 4; i++) tmp[i] = y[i] + dt * k3[i];
+    derivatives(&plant->p, drive, tmp, k4);
+
+    for (int i = 0; i < 4; i++) {
+        y[i] += dt / 6.0 * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]);
+    }
+    plant->pitch = y[0];
+    plant->pitch_rate = y[1];
+    plant->position = y[2];
+    plant->velocity = y[3];
+    plant->pitch_accel = k4[1];
+    plant->accel = k4[3];
+    plant->time += dt;
+}
+
+/**
+ * @brief MPU6050 출력 양자화 및 범위 포화
+ */
+static float quantize(double value, double lsb_per_unit) {
+    double raw = floor(value * lsb_per_unit + 0.5);
+    if (raw > 32767.0) raw = 32767.0;
+    if (raw < -32768.0) raw = -32768.0;
+    return (float)(raw / lsb_per_unit);
+}
+
+void sim_plant_sample_imu(sim_plant_t* plant, sim_imu_sample_t* out) {
+    const sim_plant_params_t* p = &plant->p;
+    const double alpha = p->slope_deg * SIM_DEG2RAD;
+    const double h = p->imu_height;
+    double theta = plant->pitch, w = plant->pitch_rate, w_dot = plant->pitch_accel;
+
+    // Specific force at the IMU: wheel acceleration along the slope + body rotation - gravity
+    double fx_world = plant->accel * cos(alpha) + h * (w_dot * cos(theta) - w * w * sin(theta));
+    double fz_world = plant->accel * sin(alpha) + h * (-w_dot * sin(theta) - w * w * cos(theta)) + SIM_G;
+    double fx = (fx_world * cos(theta) - fz_world * sin(theta)) / SIM_G;
+    double fz = (fx_world * sin(theta) + fz_world * cos(theta)) / SIM_G;
+
+    out->accel_x = quantize(fx + sim_noise(&plant->rng, p->accel_noise_g), SIM_ACCEL_LSB);
+    out->accel_y = quantize(sim_noise(&plant->rng, p->accel_noise_g), SIM_ACCEL_LSB);
+    out->accel_z = quantize(fz + sim_noise(&plant->rng, p->accel_noise_g), SIM_ACCEL_LSB);
+    out->gyro_x = quantize(p->gyro_bias_dps[0] + sim_noise(&plant->rng, p->gyro_noise_dps), SIM_GYRO_LSB);
+    out->gyro_y = quantize(w * SIM_RAD2DEG + p->gyro_bias_dps[1] + sim_noise(&plant->rng, p->gyro_noise_dps),
+                           SIM_GYRO_LSB);
+    out->gyro_z = quantize(p->gyro_bias_dps[2] + sim_noise(&plant->rng, p->gyro_noise_dps), SIM_GYRO_LSB);
+}
+
+int32_t sim_plant_encoder_count(const sim_plant_t* plant) {
+    double wheel_rel = plant->position / plant->p.wheel_radius - plant->pitch;
+    return (int32_t)floor(wheel_rel / (2.0 * SIM_PI) * (double)plant->p.encoder_ppr);
+}
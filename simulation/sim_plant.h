@@ -0,0 +1,137 @@
+/**
+ * @file sim_plant.h
+ * @brief 2륜 도립진자 플랜트 모델 헤더 파일 (호스트 시뮬레이터 전용)
+ *
+ * 밸런싱 로봇의 종방향(피치) 동역학과 센서/구동기를 모델링합니다.
+ * - 도립진자 + 바퀴 동역학 (라그랑주 방정식, 경사면 포함)
+ * - DC 모터: 정지 토크/무부하 속도 직선 특성, 역기전력, PWM 데드밴드
+ * - 엔코더: 차체 기준 바퀴 회전을 PPR로 양자화한 누적 카운트
+ * - IMU: MPU6050 LSB 양자화, 자이로 바이어스, 가우시안 근사 노이즈,
+ *   차체 가속이 가속도계에 섞이는 효과
+ *
+ * 부호 규약 (펌웨어와 동일):
+ * - 피치 양수 = 전방으로 기울어짐, 엔코더 속도 양수 = 전진
+ * - 모터 명령 양수 = 후진 방향 토크 (양의 피치 오차를 키우는 방향).
+ *   balance_pid의 출력 Kp*(목표 - 각도)를 그대로 넣으면 넘어지는 쪽으로 바퀴가 따라갑니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef SIM_PLANT_H
+#define SIM_PLANT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct sim_plant_params_t
+ * @brief 플랜트 물리 파라미터
+ */
+typedef struct {
+    double body_mass;           ///< 차체 질량 (kg, 배터리 포함)
+    double body_com_height;     ///< 바퀴 축에서 차체 무게중심까지 거리 (m)
+    double body_inertia;        ///< 무게중심 기준 차체 피치 관성 (kg·m²)
+    double wheel_mass;          ///< 바퀴 두 개 질량 합 (kg)
+    double wheel_radius;        ///< 바퀴 반지름 (m)
+    double wheel_inertia;       ///< 바퀴 두 개 관성 합 (kg·m², 기어 반사 관성 포함)
+    double stall_torque;        ///< 모터 두 개 정지 토크 합 (N·m, 바퀴축, 배터리 전압 기준)
+    double no_load_speed;       ///< 무부하 바퀴 속도 (rad/s, 배터리 전압 기준)
+    double deadband;            ///< PWM 데드밴드 (명령 0~255 중 토크가 나오지 않는 구간)
+    double rolling_friction;    ///< 구름 저항 계수 (N per m/s)
+    double slope_deg;           ///< 노면 경사 (degree, 양수 = 전방 오르막)
+    double imu_height;          ///< 바퀴 축에서 IMU까지 거리 (m)
+    double gyro_noise_dps;      ///< 자이로 노이즈 표준편차 (deg/s)
+    double accel_noise_g;       ///< 가속도계 노이즈 표준편차 (g)
+    double gyro_bias_dps[3];    ///< 자이로 바이어스 (deg/s, x/y/z)
+    uint32_t encoder_ppr;       ///< 엔코더 펄스/회전
+} sim_plant_params_t;
+
+/**
+ * @struct sim_imu_sample_t
+ * @brief 시뮬레이션 IMU 샘플 (imu_sample_t와 같은 단위)
+ */
+typedef struct {
+    float accel_x, accel_y, accel_z;    ///< 가속도 (g)
+    float gyro_x, gyro_y, gyro_z;       ///< 각속도 (deg/s)
+} sim_imu_sample_t;
+
+/**
+ * @struct sim_plant_t
+ * @brief 플랜트 상태
+ */
+typedef struct {
+    sim_plant_params_t p;   ///< 물리 파라미터
+    double pitch;           ///< 차체 피치 (rad)
+    double pitch_rate;      ///< 차체 피치 각속도 (rad/s)
+    double position;        ///< 바퀴 축 위치 (m)
+    double velocity;        ///< 바퀴 축 속도 (m/s)
+    double accel;           ///< 마지막 스텝의 바퀴 축 가속도 (m/s²)
+    double pitch_accel;     ///< 마지막 스텝의 피치 각가속도 (rad/s²)
+    double time;            ///< 경과 시간 (s)
+    uint32_t rng;           ///< 노이즈 난수 상태
+} sim_plant_t;
+
+/**
+ * @brief 기본 파라미터 (0.9kg급 소형 밸런싱 로봇, 6.5cm 바퀴, 2S 배터리)
+ * @param p 채울 파라미터 구조체
+ */
+void sim_plant_default_params(sim_plant_params_t* p);
+
+/**
+ * @brief 플랜트 초기화 (정지 상태, 지정한 기울기)
+ * @param plant 플랜트 구조체 포인터
+ * @param params 물리 파라미터
+ * @param pitch_deg 초기 피치 (degree)
+ * @param seed 노이즈 난수 시드
+ */
+void sim_plant_init(sim_plant_t* plant, const sim_plant_params_t* params, double pitch_deg, uint32_t seed);
+
+/**
+ * @brief 한 스텝 적분 (RK4, 모터 명령은 스텝 동안 유지)
+ * @param plant 플랜트 구조체 포인터
+ * @param motor_cmd 모터 명령 (-255 ~ 255, 펌웨어 규약)
+ * @param dt 적분 간격 (s)
+ */
+void sim_plant_step(sim_plant_t* plant, double motor_cmd, double dt);
+
+/**
+ * @brief 현재 상태의 IMU 샘플 생성
+ * @param plant 플랜트 구조체 포인터
+ * @param out 출력 샘플
+ */
+void sim_plant_sample_imu(sim_plant_t* plant, sim_imu_sample_t* out);
+
+/**
+ * @brief 현재 엔코더 누적 카운트 (차체 기준 바퀴 회전)
+ * @param plant 플랜트 구조체 포인터
+ * @return int32_t 누적 카운트
+ */
+int32_t sim_plant_encoder_count(const sim_plant_t* plant);
+
+/**
+ * @brief 가우시안 근사 노이즈 (균등분포 4개 합, 실행 간 결정적)
+ * @param rng 난수 상태
+ * @param sigma 표준편차
+ * @return double 노이즈 값
+ */
+double sim_noise(uint32_t* rng, double sigma);
+
+/**
+ * @brief [lo, hi) 균등 난수
+ * @param rng 난수 상태
+ * @param lo 하한
+ * @param hi 상한
+ * @return double 난수 값
+ */
+double sim_uniform(uint32_t* rng, double lo, double hi);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIM_PLANT_H
@@ -0,0 +1,168 @@
+/**
+ * @file work_pool.c
+ * @brief 작업 훔치기(work-stealing) 스레드 풀 구현 파일
+ *
+ * 워커 큐는 [begin, end) 구간 하나로 표현합니다. 작업은 생성 후 추가되지 않고
+ * 구간은 줄어들기만 하므로, 모든 큐가 비어 있는 것을 한 번 확인하면 종료해도 안전합니다.
+ * 스레드 생성에 실패한 워커의 구간은 다른 워커가 훔쳐 처리합니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "work_pool.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * @struct work_queue_t
+ * @brief 워커별 작업 구간
+ */
+typedef struct {
+    pthread_mutex_t lock;   ///< 구간 보호
+    uint32_t begin;         ///< 다음에 꺼낼 작업 (소유 워커가 증가)
+    uint32_t end;           ///< 구간 끝 (훔치는 워커가 감소)
+} work_queue_t;
+
+/**
+ * @struct work_pool_t
+ * @brief 풀 공유 상태
+ */
+typedef struct {
+    work_queue_t* queues;   ///< 워커 큐 배열
+    uint32_t threads;       ///< 워커 수
+    work_pool_fn_t fn;      ///< 작업 함수
+    void* ctx;              ///< 사용자 컨텍스트
+} work_pool_t;
+
+/**
+ * @struct work_worker_t
+ * @brief 워커 스레드 인자
+ */
+typedef struct {
+    work_pool_t* pool;      ///< 풀 공유 상태
+    uint32_t id;            ///< 워커 번호
+} work_worker_t;
+
+uint32_t work_pool_cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (uint32_t)n : 1u;
+}
+
+/**
+ * @brief 자기 큐 앞에서 작업 하나 꺼내기
+ */
+static bool pop_local(work_queue_t* q, uint32_t* item) {
+    bool ok = false;
+    pthread_mutex_lock(&q->lock);
+    if (q->begin < q->end) {
+        *item = q->begin++;
+        ok = true;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+/**
+ * @brief 다른 워커 큐의 뒤쪽 절반을 훔쳐 자기 큐로 옮기기
+ *
+ * 희생 워커는 자기 번호 다음부터 순서대로 찾아 특정 큐에 몰리지 않게 합니다.
+ *
+ * @return bool 훔친 작업이 있으면 true (모든 큐가 비었으면 false)
+ */
+static bool steal(work_pool_t* pool, uint32_t self) {
+    for (uint32_t k = 1; k < pool->threads; k++) {
+        work_queue_t* victim = &pool->queues[(self + k) % pool->threads];
+        uint32_t begin = 0, end = 0;
+        pthread_mutex_lock(&victim->lock);
+        uint32_t remaining = victim->end - victim->begin;
+        if (remaining > 0) {
+            uint32_t take = (remaining + 1) / 2;
+            end = victim->end;
+            begin = end - take;
+            victim->end = begin;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (end > begin) {
+            work_queue_t* own = &pool->queues[self];
+            pthread_mutex_lock(&own->lock);
+            own->begin = begin;
+            own->end = end;
+            pthread_mutex_unlock(&own->lock);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void* worker_main(void* arg) {
+    work_worker_t* w = (work_worker_t*)arg;
+    work_pool_t* pool = w->pool;
+    work_queue_t* own = &pool->queues[w->id];
+    uint32_t item;
+
+    for (;;) {
+        while (pop_local(own, &item)) {
+            pool->fn(item, w->id, pool->ctx);
+        }
+        if (!steal(pool, w->id)) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+int work_pool_run(uint32_t count, uint32_t threads, work_pool_fn_t fn, void* ctx) {
+    if (threads == 0) threads = work_pool_cpu_count();
+    if (threads > count) threads = (count > 0) ? count : 1;
+
+    work_pool_t pool = {
+        .queues = (work_queue_t*)calloc(threads, sizeof(work_queue_t)),
+        .threads = threads,
+        .fn = fn,
+        .ctx = ctx,
+    };
+    work_worker_t* workers = (work_worker_t*)calloc(threads, sizeof(work_worker_t));
+    pthread_t* handles = (pthread_t*)calloc(threads, sizeof(pthread_t));
+    bool* started = (bool*)calloc(threads, sizeof(bool));
+    if (pool.queues == NULL || workers == NULL || handles == NULL || started == NULL) {
+        free(pool.queues);
+        free(workers);
+        free(handles);
+        free(started);
+        return -1;
+    }
+
+    // Contiguous initial split keeps neighbouring items (similar cost) on one worker
+    for (uint32_t i = 0; i < threads; i++) {
+        pthread_mutex_init(&pool.queues[i].lock, NULL);
+        pool.queues[i].begin = (uint32_t)((uint64_t)count * i / threads);
+        pool.queues[i].end = (uint32_t)((uint64_t)count * (i + 1) / threads);
+        workers[i].pool = &pool;
+        workers[i].id = i;
+    }
+
+    // Worker 0 is the calling thread
+    for (uint32_t i = 1; i < threads; i++) {
+        started[i] = (pthread_create(&handles[i], NULL, worker_main, &workers[i]) == 0);
+    }
+    worker_main(&workers[0]);
+    for (uint32_t i = 1; i < threads; i++) {
+        if (started[i]) {
+            pthread_join(handles[i], NULL);
+        }
+    }
+
+    for (uint32_t i = 0; i < threads; i++) {
+        pthread_mutex_destroy(&pool.queues[i].lock);
+    }
+    free(pool.queues);
+    free(workers);
+    free(handles);
+    free(started);
+    return 0;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file work_pool.h
+ * @brief 작업 훔치기(work-stealing) 스레드 풀 헤더 파일 (호스트 시뮬레이터 전용)
+ *
+ * 0 ~ N-1 번 작업을 스레드 수만큼 연속 구간으로 나눠 각 워커의 큐에 넣습니다.
+ * 워커는 자기 구간의 앞에서 하나씩 꺼내 실행하고, 비면 다른 워커 구간의
+ * 뒤쪽 절반을 훔쳐옵니다. 넘어져 일찍 끝나는 에피소드처럼 작업마다 비용이
+ * 크게 다를 때도 모든 코어가 끝까지 바쁘게 유지됩니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 작업 함수 타입
+ * @param item 작업 번호 (0 ~ N-1)
+ * @param worker 실행 중인 워커 번호 (워커별 버퍼 인덱싱용)
+ * @param ctx 사용자 컨텍스트
+ */
+typedef void (*work_pool_fn_t)(uint32_t item, uint32_t worker, void* ctx);
+
+/**
+ * @brief 호스트의 온라인 CPU 수 반환
+ * @return uint32_t CPU 수 (알 수 없으면 1)
+ */
+uint32_t work_pool_cpu_count(void);
+
+/**
+ * @brief 작업 N개를 병렬 실행하고 모두 끝날 때까지 대기
+ *
+ * 각 작업은 정확히 한 번 실행됩니다. 실행 순서는 정해지지 않으므로
+ * 결과는 작업 번호로 인덱싱된 버퍼에 기록해야 합니다.
+ *
+ * @param count 작업 수
+ * @param threads 워커 스레드 수 (0이면 CPU 수, 1이면 호출 스레드에서 실행)
+ * @param fn 작업 함수
+ * @param ctx 사용자 컨텍스트
+ * @return int 0 성공, -1 스레드 생성 실패
+ */
+int work_pool_run(uint32_t count, uint32_t threads, work_pool_fn_t fn, void* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORK_POOL_H
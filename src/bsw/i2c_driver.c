@@ -8,8 +8,9 @@
  * 구현 특징:
  * - 400kHz 고속 통신 지원
  * - 내부 풀업 저항 활성화
- * - 1초 타임아웃 설정
- * - 네이티브 빌드 지원 (테스트용)
+ * - 1초 타임아웃 설정 (레지스터 단건 API), 트랜잭션별 타임아웃
+ * - 정적 명령 링크를 재사용하는 트랜잭션 (주기 경로 힙 할당 없음)
+ * - 네이티브 빌드 지원 (테스트용 가상 버스)
  * 
  * @author BalanceBot Team
  * @date 2025-09-20
@@ -27,6 +28,93 @@ static const char* I2C_TAG = "I2C_DRIVER"; ///< ESP-IDF 로깅 태그
 #define I2C_TAG "I2C_DRIVER" ///< 네이티브 빌드용 로깅 태그
 #endif
 
+static i2c_driver_stats_t i2c_stats; ///< 버스 사용 통계
+
+#ifdef NATIVE_BUILD
+static i2c_fake_bus_handler_t fake_bus = NULL; ///< 가상 버스 핸들러
+
+/**
+ * @brief 가상 버스로 전송 (핸들러가 없으면 읽기는 고정 패턴)
+ */
+static esp_err_t fake_bus_transfer(uint8_t device_addr, uint8_t reg_addr, uint8_t* data, size_t len, bool is_read) {
+    if (fake_bus != NULL) {
+        return fake_bus(device_addr, reg_addr, data, len, is_read);
+    }
+    if (is_read) {
+        // Mock data for native build
+        for (size_t i = 0; i < len; i++) {
+            data[i] = 0x42 + i;
+        }
+    }
+    return ESP_OK;
+}
+#else
+/**
+ * @brief 트랜잭션 명령 링크를 정적 버퍼에 구성
+ * 
+ * 링크 버퍼가 부족하면 i2c_master_* 함수가 ESP_ERR_NO_MEM을 반환하므로
+ * 각 단계의 결과를 확인합니다.
+ * 
+ * @param txn 트랜잭션 구조체 포인터
+ * @return esp_err_t 구성 결과
+ */
+static esp_err_t i2c_transaction_build(i2c_transaction_t* txn) {
+    if (txn->cmd != NULL) {
+        i2c_cmd_link_delete_static(txn->cmd);
+    }
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(txn->link_buf, sizeof(txn->link_buf));
+    txn->cmd = cmd;
+    if (cmd == NULL) {
+        return ESP_FAIL;
+    }
+
+    esp_err_t ret = i2c_master_start(cmd);
+    if (ret == ESP_OK) ret = i2c_master_write_byte(cmd, (txn->device_addr << 1), true);
+    if (ret == ESP_OK) ret = i2c_master_write_byte(cmd, txn->reg_addr, true);
+    if (txn->is_read) {
+        if (ret == ESP_OK) ret = i2c_master_start(cmd);
+        if (ret == ESP_OK) ret = i2c_master_write_byte(cmd, (txn->device_addr << 1) | I2C_MASTER_READ, true);
+        if (ret == ESP_OK && txn->len > 1) ret = i2c_master_read(cmd, txn->data, txn->len - 1, I2C_MASTER_ACK);
+        if (ret == ESP_OK) ret = i2c_master_read_byte(cmd, txn->data + txn->len - 1, I2C_MASTER_NACK);
+    } else {
+        if (ret == ESP_OK) ret = i2c_master_write(cmd, txn->data, txn->len, true);
+    }
+    if (ret == ESP_OK) ret = i2c_master_stop(cmd);
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(I2C_TAG, "Transaction link build failed (reg 0x%02X, %u bytes)", txn->reg_addr, (unsigned)txn->len);
+        i2c_cmd_link_delete_static(cmd);
+        txn->cmd = NULL;
+    }
+    return ret;
+}
+#endif
+
+/**
+ * @brief 트랜잭션 공통 구성
+ */
+static esp_err_t i2c_transaction_setup(i2c_transaction_t* txn, i2c_port_t port, uint8_t device_addr, uint8_t reg_addr,
+                                       uint8_t* data, size_t len, uint32_t timeout_ms, bool is_read) {
+    txn->port = port;
+    txn->device_addr = device_addr;
+    txn->reg_addr = reg_addr;
+    txn->data = data;
+    txn->len = len;
+    txn->is_read = is_read;
+    txn->timeout_ms = timeout_ms;
+#ifndef NATIVE_BUILD
+    txn->cmd = NULL;
+#endif
+    if (data == NULL || len == 0) {
+        return ESP_FAIL;
+    }
+#ifndef NATIVE_BUILD
+    return i2c_transaction_build(txn);
+#else
+    return ESP_OK;
+#endif
+}
+
 /**
  * @brief I2C 인터페이스 초기화 구현
  * 
@@ -90,6 +178,7 @@ esp_err_t i2c_driver_init(i2c_port_t port, gpio_num_t sda_pin, gpio_num_t scl_pi
  * @return esp_err_t 전송 결과
  */
 esp_err_t i2c_write_register(i2c_port_t port, uint8_t device_addr, uint8_t reg_addr, uint8_t value) {
+    i2c_stats.dynamic_link_count++;
 #ifndef NATIVE_BUILD
     i2c_cmd_handle_t cmd = i2c_cmd_link_create();
     i2c_master_start(cmd);
@@ -100,10 +189,14 @@ esp_err_t i2c_write_register(i2c_port_t port, uint8_t device_addr, uint8_t reg_a
 
     esp_err_t ret = i2c_master_cmd_begin(port, cmd, 1000 / portTICK_PERIOD_MS);
     i2c_cmd_link_delete(cmd);
-    return ret;
 #else
-    return ESP_OK;
+    (void)port;
+    esp_err_t ret = fake_bus_transfer(device_addr, reg_addr, &value, 1, false);
 #endif
+    if (ret != ESP_OK) {
+        i2c_stats.error_count++;
+    }
+    return ret;
 }
 
 /**
@@ -128,6 +221,7 @@ esp_err_t i2c_write_register(i2c_port_t port, uint8_t device_addr, uint8_t reg_a
  * @return esp_err_t 전송 결과
  */
 esp_err_t i2c_read_register(i2c_port_t port, uint8_t device_addr, uint8_t reg_addr, uint8_t* data, size_t len) {
+    i2c_stats.dynamic_link_count++;
 #ifndef NATIVE_BUILD
     i2c_cmd_handle_t cmd = i2c_cmd_link_create();
     i2c_master_start(cmd);
@@ -144,12 +238,135 @@ esp_err_t i2c_read_register(i2c_port_t port, uint8_t device_addr, uint8_t reg_ad
 
     esp_err_t ret = i2c_master_cmd_begin(port, cmd, 1000 / portTICK_PERIOD_MS);
     i2c_cmd_link_delete(cmd);
-    return ret;
 #else
-    // Mock data for native build
-    for (size_t i = 0; i < len; i++) {
-        data[i] = 0x42 + i;
+    (void)port;
+    esp_err_t ret = fake_bus_transfer(device_addr, reg_addr, data, len, true);
+#endif
+    if (ret != ESP_OK) {
+        i2c_stats.error_count++;
     }
+    return ret;
+}
+
+esp_err_t i2c_transaction_init_read(i2c_transaction_t* txn, i2c_port_t port, uint8_t device_addr,
+                                    uint8_t reg_addr, uint8_t* data, size_t len, uint32_t timeout_ms) {
+    return i2c_transaction_setup(txn, port, device_addr, reg_addr, data, len, timeout_ms, true);
+}
+
+esp_err_t i2c_transaction_init_write(i2c_transaction_t* txn, i2c_port_t port, uint8_t device_addr,
+                                     uint8_t reg_addr, uint8_t* data, size_t len, uint32_t timeout_ms) {
+    return i2c_transaction_setup(txn, port, device_addr, reg_addr, data, len, timeout_ms, false);
+}
+
+esp_err_t i2c_transaction_set_length(i2c_transaction_t* txn, size_t len) {
+    if (len == 0) {
+        return ESP_FAIL;
+    }
+    if (len == txn->len) {
+        return ESP_OK;
+    }
+    txn->len = len;
+#ifndef NATIVE_BUILD
+    return i2c_transaction_build(txn);
+#else
     return ESP_OK;
 #endif
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 트랜잭션 실행 구현
+ * 
+ * i2c_master_cmd_begin()은 명령 링크를 소비하지 않으므로 같은 링크를
+ * 반복 실행할 수 있습니다. 전송 중에는 호출 태스크가 드라이버 세마포어에서
+ * 대기하므로 CPU는 다른 작업에 양보됩니다.
+ * 
+ * @param txn 트랜잭션 구조체 포인터
+ * @return esp_err_t 전송 결과
+ */
+esp_err_t i2c_transaction_execute(i2c_transaction_t* txn) {
+    i2c_stats.transaction_count++;
+#ifndef NATIVE_BUILD
+    if (txn->cmd == NULL) {
+        i2c_stats.error_count++;
+        return ESP_FAIL;
+    }
+    TickType_t timeout = pdMS_TO_TICKS(txn->timeout_ms);
+    esp_err_t ret = i2c_master_cmd_begin(txn->port, txn->cmd, timeout > 0 ? timeout : 1);
+#else
+    esp_err_t ret = fake_bus_transfer(txn->device_addr, txn->reg_addr, txn->data, txn->len, txn->is_read);
+#endif
+    if (ret != ESP_OK) {
+        i2c_stats.error_count++;
+    }
+    return ret;
+}
+
+/**
+ * @brief 일괄 쓰기 구현
+ * 
+ * I2C 전송 시퀀스 (항목마다 반복):
+ * 1. START (첫 항목) 또는 Repeated START
+ * 2. 디바이스 주소 + WRITE 비트, 레지스터 주소, 값 전송
+ * 3. 마지막 항목 뒤 STOP 조건 생성
+ * 
+ * 초기화 경로에서만 호출되므로 명령 링크 버퍼는 함수 내 정적 버퍼를 사용합니다.
+ * 
+ * @param port I2C 포트 번호
+ * @param device_addr I2C 디바이스 주소 (7비트)
+ * @param writes 쓸 항목 배열
+ * @param count 항목 수
+ * @return esp_err_t 전송 결과
+ */
+esp_err_t i2c_write_registers(i2c_port_t port, uint8_t device_addr, const i2c_reg_write_t* writes, size_t count) {
+    if (writes == NULL || count == 0 || count > I2C_BATCH_MAX_WRITES) {
+        return ESP_FAIL;
+    }
+    i2c_stats.batch_count++;
+
+#ifndef NATIVE_BUILD
+    static uint8_t link_buf[I2C_LINK_RECOMMENDED_SIZE(I2C_BATCH_MAX_WRITES)];
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(link_buf, sizeof(link_buf));
+    if (cmd == NULL) {
+        return ESP_FAIL;
+    }
+
+    esp_err_t ret = ESP_OK;
+    for (size_t i = 0; i < count && ret == ESP_OK; i++) {
+        ret = i2c_master_start(cmd);
+        if (ret == ESP_OK) ret = i2c_master_write_byte(cmd, (device_addr << 1), true);
+        if (ret == ESP_OK) ret = i2c_master_write_byte(cmd, writes[i].reg_addr, true);
+        if (ret == ESP_OK) ret = i2c_master_write_byte(cmd, writes[i].value, true);
+    }
+    if (ret == ESP_OK) ret = i2c_master_stop(cmd);
+    if (ret == ESP_OK) ret = i2c_master_cmd_begin(port, cmd, 1000 / portTICK_PERIOD_MS);
+    i2c_cmd_link_delete_static(cmd);
+#else
+    (void)port;
+    esp_err_t ret = ESP_OK;
+    for (size_t i = 0; i < count && ret == ESP_OK; i++) {
+        uint8_t value = writes[i].value;
+        ret = fake_bus_transfer(device_addr, writes[i].reg_addr, &value, 1, false);
+    }
+#endif
+    if (ret != ESP_OK) {
+        i2c_stats.error_count++;
+    }
+    return ret;
+}
+
+void i2c_driver_get_stats(i2c_driver_stats_t* stats) {
+    *stats = i2c_stats;
+}
+
+void i2c_driver_reset_stats(void) {
+    i2c_stats.dynamic_link_count = 0;
+    i2c_stats.transaction_count = 0;
+    i2c_stats.batch_count = 0;
+    i2c_stats.error_count = 0;
+}
+
+#ifdef NATIVE_BUILD
+void i2c_driver_fake_set_bus(i2c_fake_bus_handler_t handler) {
+    fake_bus = handler;
+}
+#endif
\ No newline at end of file
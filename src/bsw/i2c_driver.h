@@ -8,6 +8,8 @@
  * 주요 기능:
  * - I2C 마스터 모드 초기화
  * - 디바이스 레지스터 읽기/쓰기
+ * - 재사용 트랜잭션 (정적 명령 링크, 힙 할당 없음)
+ * - 다중 레지스터 일괄 쓰기 (초기화 시퀀스)
  * - 오류 처리 및 타임아웃 관리
  * 
  * @author BalanceBot Team
@@ -29,12 +31,62 @@ typedef int gpio_num_t;
 #define ESP_FAIL -1
 #endif
 
+#include <stdbool.h>
 #include <stdint.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define I2C_BATCH_MAX_WRITES    8   ///< i2c_write_registers() 한 번에 쓸 수 있는 최대 레지스터 수
+
+#ifndef NATIVE_BUILD
+/// 레지스터 읽기 한 건(START, 주소, 레지스터, RESTART, 주소, 읽기, STOP)을 담는 명령 링크 크기
+#define I2C_TRANSACTION_LINK_SIZE   I2C_LINK_RECOMMENDED_SIZE(2)
+#endif
+
+/**
+ * @struct i2c_transaction_t
+ * @brief 재사용 가능한 레지스터 전송 디스크립터
+ * 
+ * 명령 링크를 구조체 내부의 정적 버퍼에 한 번만 구성하고 반복 실행합니다.
+ * 데이터 버퍼는 호출자가 소유하며 트랜잭션보다 오래 유지되어야 합니다.
+ */
+typedef struct {
+    i2c_port_t port;                ///< I2C 포트 번호
+    uint8_t device_addr;            ///< I2C 디바이스 주소 (7비트)
+    uint8_t reg_addr;               ///< 시작 레지스터 주소
+    uint8_t* data;                  ///< 읽기 대상 / 쓰기 원본 버퍼 (호출자 소유)
+    size_t len;                     ///< 전송 길이 (바이트)
+    bool is_read;                   ///< true: 읽기, false: 쓰기
+    uint32_t timeout_ms;            ///< 전송 타임아웃 (ms)
+#ifndef NATIVE_BUILD
+    i2c_cmd_handle_t cmd;           ///< link_buf에 구성된 명령 링크
+    uint8_t link_buf[I2C_TRANSACTION_LINK_SIZE]; ///< 명령 링크 저장 공간
+#endif
+} i2c_transaction_t;
+
+/**
+ * @struct i2c_reg_write_t
+ * @brief 일괄 쓰기 항목 (레지스터, 값)
+ */
+typedef struct {
+    uint8_t reg_addr;   ///< 레지스터 주소
+    uint8_t value;      ///< 쓸 값
+} i2c_reg_write_t;
+
+/**
+ * @struct i2c_driver_stats_t
+ * @brief 버스 사용 통계
+ */
+typedef struct {
+    uint32_t dynamic_link_count;    ///< 힙에 명령 링크를 할당한 전송 수 (레지스터 단건 API)
+    uint32_t transaction_count;     ///< 재사용 트랜잭션 실행 수
+    uint32_t batch_count;           ///< 일괄 쓰기 실행 수
+    uint32_t error_count;           ///< 실패한 전송 수
+} i2c_driver_stats_t;
+
 /**
  * @defgroup I2C_DRIVER I2C 드라이버 API
  * @brief I2C 마스터 인터페이스 함수들
@@ -91,10 +143,118 @@ esp_err_t i2c_write_register(i2c_port_t port, uint8_t device_addr, uint8_t reg_a
  *         - ESP_FAIL: 통신 실패 또는 디바이스 응답 없음
  * 
  * @note 타임아웃은 1초로 설정됩니다.
+ * @note 호출마다 명령 링크를 힙에 할당하므로 주기적인 읽기에는 i2c_transaction_t를 사용합니다.
  * @warning data 버퍼는 len 바이트 이상의 크기를 가져야 합니다.
  */
 esp_err_t i2c_read_register(i2c_port_t port, uint8_t device_addr, uint8_t reg_addr, uint8_t* data, size_t len);
 
+/**
+ * @brief 재사용 읽기 트랜잭션 구성
+ * 
+ * 예: MPU6050(0x68) 0x3B부터 14바이트 읽기를 초기화 시 한 번 구성하고
+ * 제어 주기마다 i2c_transaction_execute()로 실행합니다.
+ * 
+ * @param txn 트랜잭션 구조체 포인터
+ * @param port I2C 포트 번호
+ * @param device_addr I2C 디바이스 주소 (7비트)
+ * @param reg_addr 시작 레지스터 주소
+ * @param data 읽은 데이터를 저장할 버퍼 (트랜잭션 수명 동안 유지)
+ * @param len 읽을 길이 (1 이상)
+ * @param timeout_ms 전송 타임아웃 (ms)
+ * @return esp_err_t 
+ *         - ESP_OK: 구성 성공
+ *         - ESP_FAIL: 잘못된 인자 또는 명령 링크 버퍼 부족
+ */
+esp_err_t i2c_transaction_init_read(i2c_transaction_t* txn, i2c_port_t port, uint8_t device_addr,
+                                    uint8_t reg_addr, uint8_t* data, size_t len, uint32_t timeout_ms);
+
+/**
+ * @brief 재사용 쓰기 트랜잭션 구성
+ * 
+ * 명령 링크는 data 버퍼를 가리키므로 실행 전에 버퍼 내용을 바꾸면
+ * 다시 구성하지 않고도 다른 값을 쓸 수 있습니다.
+ * 
+ * @param txn 트랜잭션 구조체 포인터
+ * @param port I2C 포트 번호
+ * @param device_addr I2C 디바이스 주소 (7비트)
+ * @param reg_addr 시작 레지스터 주소
+ * @param data 쓸 데이터 버퍼 (트랜잭션 수명 동안 유지)
+ * @param len 쓸 길이 (1 이상)
+ * @param timeout_ms 전송 타임아웃 (ms)
+ * @return esp_err_t ESP_OK 성공, ESP_FAIL 잘못된 인자 또는 명령 링크 버퍼 부족
+ */
+esp_err_t i2c_transaction_init_write(i2c_transaction_t* txn, i2c_port_t port, uint8_t device_addr,
+                                     uint8_t reg_addr, uint8_t* data, size_t len, uint32_t timeout_ms);
+
+/**
+ * @brief 트랜잭션 전송 길이 변경
+ * 
+ * FIFO처럼 주기마다 읽을 길이가 달라지는 경우에 사용합니다.
+ * 길이가 같으면 아무 일도 하지 않고, 다르면 같은 정적 버퍼에 명령 링크를 다시 구성합니다.
+ * 
+ * @param txn 트랜잭션 구조체 포인터
+ * @param len 새 전송 길이 (1 이상, data 버퍼 크기 이하)
+ * @return esp_err_t ESP_OK 성공, ESP_FAIL 잘못된 길이 또는 명령 링크 버퍼 부족
+ */
+esp_err_t i2c_transaction_set_length(i2c_transaction_t* txn, size_t len);
+
+/**
+ * @brief 구성된 트랜잭션 실행
+ * 
+ * 힙 할당 없이 미리 구성된 명령 링크를 그대로 실행합니다.
+ * 
+ * @param txn 트랜잭션 구조체 포인터
+ * @return esp_err_t 
+ *         - ESP_OK: 전송 성공
+ *         - ESP_ERR_TIMEOUT: 타임아웃 (버스 점유 등)
+ *         - ESP_FAIL: 통신 실패 또는 디바이스 응답 없음
+ */
+esp_err_t i2c_transaction_execute(i2c_transaction_t* txn);
+
+/**
+ * @brief 여러 레지스터 일괄 쓰기
+ * 
+ * (레지스터, 값) 쌍을 Repeated START로 이어 하나의 버스 트랜잭션으로 전송합니다.
+ * 초기화 시퀀스처럼 여러 설정 레지스터를 연속으로 쓸 때 사용합니다.
+ * 
+ * @param port I2C 포트 번호
+ * @param device_addr I2C 디바이스 주소 (7비트)
+ * @param writes 쓸 항목 배열 (배열 순서대로 기록)
+ * @param count 항목 수 (1 ~ I2C_BATCH_MAX_WRITES)
+ * @return esp_err_t ESP_OK 성공, ESP_FAIL 잘못된 인자 또는 통신 실패
+ * 
+ * @note 타임아웃은 1초로 설정됩니다.
+ * @warning 단일 명령 링크 버퍼를 공유하므로 여러 태스크에서 동시에 호출하면 안 됩니다.
+ */
+esp_err_t i2c_write_registers(i2c_port_t port, uint8_t device_addr, const i2c_reg_write_t* writes, size_t count);
+
+/**
+ * @brief 버스 사용 통계 조회
+ * @param stats 출력 통계 구조체
+ */
+void i2c_driver_get_stats(i2c_driver_stats_t* stats);
+
+/**
+ * @brief 버스 사용 통계 초기화
+ */
+void i2c_driver_reset_stats(void);
+
+#ifdef NATIVE_BUILD
+/**
+ * @brief 가상 버스 핸들러 (네이티브 테스트용)
+ * 
+ * 읽기는 data를 채우고, 쓰기는 data의 len 바이트를 디바이스에 기록합니다.
+ */
+typedef esp_err_t (*i2c_fake_bus_handler_t)(uint8_t device_addr, uint8_t reg_addr,
+                                            uint8_t* data, size_t len, bool is_read);
+
+/**
+ * @brief 가상 버스 핸들러 설정 (네이티브 테스트용)
+ * @param handler 모든 전송을 처리할 핸들러 (NULL: 고정 패턴 데이터)
+ */
+void i2c_driver_fake_set_bus(i2c_fake_bus_handler_t handler);
+#endif
+
 /** @} */ // I2C_DRIVER
 
 #ifdef __cplusplus
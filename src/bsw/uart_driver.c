@@ -11,37 +11,29 @@
  */
 
 #include "uart_driver.h"
+#include <string.h>
 #ifndef NATIVE_BUILD
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
 #endif
 
 #ifndef NATIVE_BUILD
 static const char* UART_TAG = "UART_DRIVER"; ///< ESP-IDF 로깅 태그
+static QueueHandle_t uart_event_queues[UART_NUM_MAX]; ///< 포트별 드라이버 이벤트 큐 (이벤트 모드가 아니면 NULL)
 #else
 #define UART_TAG "UART_DRIVER" ///< 네이티브 빌드용 로깅 태그
 #endif
 
+#ifndef NATIVE_BUILD
 /**
- * @brief UART 인터페이스 초기화 구현
- * 
- * ESP-IDF UART 드라이버를 사용하여 시리얼 통신을 설정합니다.
- * 
- * 설정 파라미터:
- * - 데이터 비트: 8비트
- * - 패리티: 없음
- * - 스톱 비트: 1비트
- * - 하드웨어 플로우 제어: 비활성화
- * - 클록 소스: APB 클록
- * - RX 버퍼: 1024바이트
+ * @brief UART 드라이버 설치와 8N1 설정 공통 구현
  * 
- * @param port UART 포트 번호
- * @param tx_pin TX 핀 번호
- * @param rx_pin RX 핀 번호
- * @param baudrate 통신 속도
- * @return esp_err_t 초기화 결과
+ * @param rx_buffer_size RX 링 버퍼 크기 (바이트)
+ * @param event_queue_size 이벤트 큐 길이 (0이면 이벤트 큐 없음)
  */
-esp_err_t uart_driver_init(uart_port_t port, gpio_num_t tx_pin, gpio_num_t rx_pin, int baudrate) {
-#ifndef NATIVE_BUILD
+static esp_err_t uart_driver_setup(uart_port_t port, gpio_num_t tx_pin, gpio_num_t rx_pin, int baudrate,
+                                   int rx_buffer_size, int event_queue_size) {
     uart_config_t uart_config = {
         .baud_rate = baudrate,                    // 사용자 지정 보드레이트
         .data_bits = UART_DATA_8_BITS,           // 8비트 데이터
@@ -51,8 +43,9 @@ esp_err_t uart_driver_init(uart_port_t port, gpio_num_t tx_pin, gpio_num_t rx_pi
         .source_clk = UART_SCLK_APB,             // APB 클록 사용
     };
 
-    // UART 드라이버 설치 (RX 버퍼 1024바이트, TX 버퍼 없음)
-    esp_err_t ret = uart_driver_install(port, 1024, 0, 0, NULL, 0);
+    // UART 드라이버 설치 (TX 버퍼 없음, 이벤트 큐는 요청한 경우에만)
+    QueueHandle_t* queue = event_queue_size > 0 ? &uart_event_queues[port] : NULL;
+    esp_err_t ret = uart_driver_install(port, rx_buffer_size, 0, event_queue_size, queue, 0);
     if (ret != ESP_OK) {
         ESP_LOGE(UART_TAG, "UART driver install failed");
         return ret;
@@ -73,8 +66,59 @@ esp_err_t uart_driver_init(uart_port_t port, gpio_num_t tx_pin, gpio_num_t rx_pi
     }
 
     ESP_LOGI(UART_TAG, "UART driver initialized");
+    return ESP_OK;
+}
 #endif
+
+/**
+ * @brief UART 인터페이스 초기화 구현
+ * 
+ * ESP-IDF UART 드라이버를 사용하여 시리얼 통신을 설정합니다.
+ * 
+ * 설정 파라미터:
+ * - 데이터 비트: 8비트
+ * - 패리티: 없음
+ * - 스톱 비트: 1비트
+ * - 하드웨어 플로우 제어: 비활성화
+ * - 클록 소스: APB 클록
+ * - RX 버퍼: 1024바이트
+ * 
+ * @param port UART 포트 번호
+ * @param tx_pin TX 핀 번호
+ * @param rx_pin RX 핀 번호
+ * @param baudrate 통신 속도
+ * @return esp_err_t 초기화 결과
+ */
+esp_err_t uart_driver_init(uart_port_t port, gpio_num_t tx_pin, gpio_num_t rx_pin, int baudrate) {
+#ifndef NATIVE_BUILD
+    // RX 버퍼 1024바이트, 이벤트 큐 없음
+    return uart_driver_setup(port, tx_pin, rx_pin, baudrate, 1024, 0);
+#else
     return ESP_OK;
+#endif
+}
+
+/**
+ * @brief 이벤트 큐 UART 초기화 구현
+ * 
+ * ESP-IDF 드라이버의 RX 링 버퍼와 이벤트 큐를 함께 설치하고,
+ * 이벤트 큐 핸들을 포트별로 보관하여 uart_wait_data()에서 사용합니다.
+ * 
+ * @param port UART 포트 번호
+ * @param tx_pin TX 핀 번호
+ * @param rx_pin RX 핀 번호
+ * @param baudrate 통신 속도
+ * @param rx_buffer_size RX 링 버퍼 크기 (바이트)
+ * @param event_queue_size 이벤트 큐 길이
+ * @return esp_err_t 초기화 결과
+ */
+esp_err_t uart_driver_init_events(uart_port_t port, gpio_num_t tx_pin, gpio_num_t rx_pin, int baudrate,
+                                  int rx_buffer_size, int event_queue_size) {
+#ifndef NATIVE_BUILD
+    return uart_driver_setup(port, tx_pin, rx_pin, baudrate, rx_buffer_size, event_queue_size);
+#else
+    return ESP_OK;
+#endif
 }
 
 /**
@@ -103,6 +147,80 @@ int uart_read_data(uart_port_t port, uint8_t* data, size_t max_len, uint32_t tim
 #endif
 }
 
+/**
+ * @brief 수신 이벤트 대기 구현
+ * 
+ * 데이터 이벤트 하나당 링 버퍼 전체를 읽으므로 뒤따르는 이벤트는 0바이트를
+ * 읽고 끝날 수 있습니다. 오버플로 뒤에는 이미 잘린 데이터와 쌓인 이벤트를 함께
+ * 버려 다음 수신부터 깨끗하게 다시 시작합니다.
+ * 
+ * @param port UART 포트 번호
+ * @param data 데이터 저장 버퍼
+ * @param max_len 최대 읽기 길이
+ * @param timeout_ms 이벤트 대기 타임아웃 (밀리초)
+ * @return int 읽은 바이트 수, 0 또는 UART_DRIVER_OVERFLOW
+ */
+int uart_wait_data(uart_port_t port, uint8_t* data, size_t max_len, uint32_t timeout_ms) {
+#ifndef NATIVE_BUILD
+    QueueHandle_t queue = uart_event_queues[port];
+    if (queue == NULL) {
+        return uart_read_data(port, data, max_len, timeout_ms);
+    }
+
+    uart_event_t event;
+    if (xQueueReceive(queue, &event, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        return 0;
+    }
+    switch (event.type) {
+        case UART_DATA: {
+            size_t buffered = 0;
+            uart_get_buffered_data_len(port, &buffered);
+            if (buffered > max_len) {
+                buffered = max_len;
+            }
+            return buffered > 0 ? uart_read_bytes(port, data, buffered, 0) : 0;
+        }
+        case UART_FIFO_OVF:
+        case UART_BUFFER_FULL:
+            uart_flush_input(port);
+            xQueueReset(queue);
+            return UART_DRIVER_OVERFLOW;
+        default:
+            return 0;
+    }
+#else
+    (void)port;
+    (void)data;
+    (void)max_len;
+    (void)timeout_ms;
+    return 0;
+#endif
+}
+
+/**
+ * @brief UART 보드레이트 변경 구현
+ * 
+ * TX FIFO가 비기를 최대 100ms 기다린 뒤 보드레이트를 바꿉니다.
+ * 
+ * @param port UART 포트 번호
+ * @param baudrate 새 통신 속도
+ * @return esp_err_t 변경 결과
+ */
+esp_err_t uart_driver_set_baudrate(uart_port_t port, int baudrate) {
+#ifndef NATIVE_BUILD
+    uart_wait_tx_done(port, pdMS_TO_TICKS(100));
+    esp_err_t ret = uart_set_baudrate(port, (uint32_t)baudrate);
+    if (ret != ESP_OK) {
+        ESP_LOGE(UART_TAG, "UART set baudrate failed");
+    }
+    return ret;
+#else
+    (void)port;
+    (void)baudrate;
+    return ESP_OK;
+#endif
+}
+
 /**
  * @brief UART 데이터 전송 구현
  * 
@@ -9,6 +9,7 @@
  * - 가변 보드레이트 설정
  * - 논블로킹/블로킹 읽기 모드
  * - 타임아웃 기반 읽기
+ * - 이벤트 큐 기반 수신 대기 (RX 링 버퍼, 오버플로 감지)
  * - 효율적인 버퍼 관리
  * 
  * @author BalanceBot Team
@@ -32,11 +33,14 @@ typedef int gpio_num_t;
 #endif
 
 #include <stdint.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define UART_DRIVER_OVERFLOW    (-2)    ///< uart_wait_data: 수신 FIFO/링 버퍼가 넘쳐 데이터가 유실됨
+
 /**
  * @defgroup UART_DRIVER UART 드라이버 API
  * @brief UART 시리얼 통신 인터페이스 함수들
@@ -68,6 +72,45 @@ extern "C" {
  */
 esp_err_t uart_driver_init(uart_port_t port, gpio_num_t tx_pin, gpio_num_t rx_pin, int baudrate);
 
+/**
+ * @brief 이벤트 큐를 사용하는 UART 인터페이스 초기화
+ * 
+ * 설정은 uart_driver_init()과 같습니다. 수신 바이트는 드라이버 ISR이 RX 링 버퍼에
+ * 쌓고, 수신/오버플로 이벤트는 포트별 이벤트 큐로 전달됩니다.
+ * 수신은 uart_wait_data()로 이벤트를 기다려 읽습니다.
+ * 
+ * @param port UART 포트 번호
+ * @param tx_pin TX 핀 번호
+ * @param rx_pin RX 핀 번호
+ * @param baudrate 통신 속도 (bps)
+ * @param rx_buffer_size RX 링 버퍼 크기 (바이트)
+ * @param event_queue_size 이벤트 큐 길이
+ * @return esp_err_t 
+ *         - ESP_OK: 초기화 성공
+ *         - ESP_FAIL: 초기화 실패
+ */
+esp_err_t uart_driver_init_events(uart_port_t port, gpio_num_t tx_pin, gpio_num_t rx_pin, int baudrate,
+                                  int rx_buffer_size, int event_queue_size);
+
+/**
+ * @brief 수신 이벤트를 기다렸다가 RX 링 버퍼의 데이터 읽기
+ * 
+ * 이벤트를 기다리는 동안 태스크는 블록되어 CPU를 쓰지 않습니다. 데이터 이벤트가
+ * 오면 링 버퍼에 쌓인 바이트를 기다리지 않고 max_len까지 읽습니다. 수신 FIFO나
+ * 링 버퍼가 넘친 경우 남은 데이터와 이벤트를 비우고 UART_DRIVER_OVERFLOW를 반환합니다.
+ * uart_driver_init()으로 초기화한 포트는 uart_read_data()와 같이 동작합니다.
+ * 
+ * @param port UART 포트 번호
+ * @param data 읽은 데이터를 저장할 버퍼
+ * @param max_len 최대 읽을 데이터 길이 (바이트)
+ * @param timeout_ms 이벤트 대기 타임아웃 (밀리초)
+ * @return int 
+ *         - 양수: 읽은 바이트 수
+ *         - 0: 타임아웃 또는 데이터 없는 이벤트
+ *         - UART_DRIVER_OVERFLOW: 수신 데이터 유실
+ */
+int uart_wait_data(uart_port_t port, uint8_t* data, size_t max_len, uint32_t timeout_ms);
+
 /**
  * @brief UART에서 데이터 읽기
  * 
@@ -87,6 +130,19 @@ esp_err_t uart_driver_init(uart_port_t port, gpio_num_t tx_pin, gpio_num_t rx_pi
  */
 int uart_read_data(uart_port_t port, uint8_t* data, size_t max_len, uint32_t timeout_ms);
 
+/**
+ * @brief UART 보드레이트 변경
+ * 
+ * 전송 중인 데이터가 이전 보드레이트로 모두 나간 뒤 바꿉니다.
+ * 
+ * @param port UART 포트 번호
+ * @param baudrate 새 통신 속도 (bps)
+ * @return esp_err_t 
+ *         - ESP_OK: 변경 성공
+ *         - ESP_FAIL: 변경 실패
+ */
+esp_err_t uart_driver_set_baudrate(uart_port_t port, int baudrate);
+
 /**
  * @brief UART로 데이터 전송
  * 
@@ -75,6 +75,10 @@ extern "C" {
 #define CONFIG_MPU6050_SDA_PIN          GPIO_NUM_8   ///< I2C SDA 핀 (ESP32-S3 표준)
 #define CONFIG_MPU6050_SCL_PIN          GPIO_NUM_9   ///< I2C SCL 핀 (ESP32-S3 표준)
 #define CONFIG_MPU6050_I2C_PORT         I2C_NUM_0    ///< I2C 포트 번호
+#define CONFIG_IMU_FIFO_MODE            1            ///< 하드웨어 FIFO 배치 읽기 (0: 주기마다 레지스터 직접 읽기)
+#define CONFIG_IMU_FIFO_SAMPLE_RATE_HZ  1000         ///< FIFO 모드 IMU 출력 레이트 (Hz) - 제어 주기보다 빠르게 샘플링
+#define CONFIG_MPU6050_INT_PIN          GPIO_NUM_11  ///< MPU6050 INT (데이터 레디) 입력 핀
+#define CONFIG_IMU_DRDY_MODE            1            ///< 데이터 레디 인터럽트로 제어 주기 시작 (0: 타이머 기반 주기)
 /** @} */
 
 /**
@@ -85,7 +89,12 @@ extern "C" {
 #define CONFIG_GPS_RX_PIN               GPIO_NUM_18  ///< GPS UART RX 핀
 #define CONFIG_GPS_TX_PIN               GPIO_NUM_17  ///< GPS UART TX 핀
 #define CONFIG_GPS_UART_PORT            UART_NUM_2   ///< UART 포트 번호
-#define CONFIG_GPS_BAUDRATE             9600         ///< GPS 통신 속도 (bps)
+#define CONFIG_GPS_BAUDRATE             9600         ///< GPS 기본 통신 속도 (bps, 수신기 전원 투입 시 값)
+#define CONFIG_GPS_EVENT_WAIT_MS        1000         ///< GPS 태스크의 UART 수신 이벤트 대기 타임아웃 (ms)
+#define CONFIG_GPS_UBX_MODE             1            ///< u-blox 수신기를 UBX NAV-PVT로 설정 (0: NMEA만, 설정 명령도 보내지 않음)
+#define CONFIG_GPS_UBX_BAUDRATE         115200       ///< UBX 모드 통신 속도 (bps)
+#define CONFIG_GPS_UBX_RATE_HZ          10           ///< UBX 모드 측정 주기 (Hz, 5~10)
+#define CONFIG_GPS_UBX_PROBE_MS         3000         ///< 설정 후 이 시간 동안 데이터가 없으면 CONFIG_GPS_BAUDRATE로 복귀 (ms)
 /** @} */
 
 /**
@@ -171,9 +180,15 @@ extern "C" {
  */
 #define CONFIG_BALANCE_PID_KP           50.0f        ///< 비례 게인 (Proportional)
 #define CONFIG_BALANCE_PID_KI           0.5f         ///< 적분 게인 (Integral)
-#define CONFIG_BALANCE_PID_KD           2.0f         ///< 미분 게인 (Derivative)
+#define CONFIG_BALANCE_PID_KD           2.0f         ///< 미분 게인 (Derivative, 자이로 각속도에 곱함)
 #define CONFIG_PID_OUTPUT_MIN           -255.0f      ///< PID 출력 최솟값
 #define CONFIG_PID_OUTPUT_MAX           255.0f       ///< PID 출력 최댓값
+#define CONFIG_VELOCITY_PID_KP          0.08f        ///< 속도 루프 비례 게인 (degree per cm/s)
+#define CONFIG_VELOCITY_PID_KI          0.03f        ///< 속도 루프 적분 게인 (경사면 드리프트 보상, 적분항은 기울기 제한 전체까지)
+#define CONFIG_VELOCITY_PID_KD          0.02f        ///< 속도 루프 미분 게인 (가속도 감쇠)
+#define CONFIG_VELOCITY_TILT_LIMIT      10.0f        ///< 속도 루프가 만들 수 있는 최대 목표 기울기 (degree)
+#define CONFIG_VELOCITY_LOOP_DIVIDER    10           ///< 속도 루프 분주비 (각도 루프 N회당 1회)
+#define CONFIG_BALANCE_MAX_SPEED_CMS    30.0f        ///< 원격 속도 100%일 때 목표 이동 속도 (cm/s)
 /** @} */
 
 /**
@@ -186,13 +201,78 @@ extern "C" {
 #define CONFIG_KALMAN_R_MEASURE         0.03f        ///< 측정 노이즈
 /** @} */
 
+/**
+ * @defgroup ATTITUDE_CONFIG 자세 추정 설정
+ * @brief 자세 추정 필터 선택 및 필터별 게인
+ * @{
+ */
+#ifndef CONFIG_CONTROL_FIXED_POINT
+#define CONFIG_CONTROL_FIXED_POINT      0            ///< 고정소수점 제어 경로 (1: 칼만/캐스케이드 PID를 Q16.16/Q2.30 정수 연산으로 실행)
+#endif
+#if CONFIG_CONTROL_FIXED_POINT
+#define CONFIG_ATTITUDE_FILTER          4            ///< 기본 필터 (4: 고정소수점 칼만)
+#else
+#define CONFIG_ATTITUDE_FILTER          0            ///< 기본 필터 (0: 칼만, 1: Mahony, 2: Madgwick, 3: 상보, 4: 고정소수점 칼만)
+#endif
+#define CONFIG_MAHONY_KP                1.0f         ///< Mahony 비례 게인
+#define CONFIG_MAHONY_KI                0.3f         ///< Mahony 적분 게인 (자이로 바이어스 추정)
+#define CONFIG_MADGWICK_BETA            0.08f        ///< Madgwick 보정 게인 (rad/s)
+#define CONFIG_COMPLEMENTARY_TAU_S      0.5f         ///< 상보 필터 시정수 (s)
+/** @} */
+
+/**
+ * @defgroup IMU_CALIB_CONFIG IMU 오프셋 보정 설정
+ * @brief 부팅 시 정지 샘플 평균 보정과 실행 중 자이로 바이어스 추적
+ * @{
+ */
+#define CONFIG_IMU_CALIB_DURATION_MS    500          ///< 부팅 보정 정지 샘플 수집 시간 (ms)
+#define CONFIG_IMU_CALIB_TIMEOUT_MS     3000         ///< 움직임이 계속되면 저장된 오프셋으로 시작하는 시간 (ms)
+#define CONFIG_IMU_CALIB_GYRO_MOTION_DPS 2.0f        ///< 움직임 판정 자이로 편차 (deg/s)
+#define CONFIG_IMU_CALIB_ACCEL_MOTION_G 0.05f        ///< 움직임 판정 가속도 편차 (g)
+#define CONFIG_IMU_CALIB_LEVEL_TOL_G    0.02f        ///< 가속도 보정 허용 수평 오차 (g, 약 1.1도)
+#define CONFIG_IMU_CALIB_QUIET_DPS      0.5f         ///< 실행 중 추적 정지 판정 자이로 잔차 (deg/s)
+#define CONFIG_IMU_CALIB_QUIET_HOLD_S   1.0f         ///< 정지가 이만큼 이어진 뒤부터 추적 (s)
+#define CONFIG_IMU_CALIB_TRACK_TAU_S    20.0f        ///< 실행 중 바이어스 추적 시정수 (s)
+#define CONFIG_IMU_CALIB_SAVE_DELTA_DPS 0.05f        ///< 저장값과 이만큼 달라야 새 자이로 오프셋 발행 (deg/s, 플래시 마모 방지)
+/** @} */
+
 /**
  * @defgroup ROBOT_PHYSICAL_CONFIG 로봇 물리 파라미터
  * @brief 로봇의 물리적 특성 정의
  * @{
  */
 #define CONFIG_WHEEL_DIAMETER_CM        6.5f         ///< 바퀴 직경 (cm)
+#define CONFIG_WHEEL_BASE_CM            17.0f        ///< 좌우 바퀴 접지점 간격 (cm)
 #define CONFIG_ENCODER_PPR              360          ///< 엔코더 펄스/회전
+#define CONFIG_ENCODER_PCNT_MODE        1            ///< PCNT 하드웨어 카운터로 엔코더 카운트 (0: 엣지마다 GPIO 인터럽트)
+#define CONFIG_ENCODER_GLITCH_NS        1000         ///< PCNT 글리치 필터: 이보다 짧은 펄스 무시 (ns)
+#define CONFIG_ENCODER_VEL_TRACKER      1            ///< 바퀴 속도 추적기 (0: 알파-베타, 1: 칼만)
+#define CONFIG_ENCODER_VEL_ALPHA        0.5f         ///< 알파-베타 속도 보정 게인
+#define CONFIG_ENCODER_VEL_BETA         0.1f         ///< 알파-베타 가속도 보정 게인
+#define CONFIG_ENCODER_VEL_JERK_NOISE   1.0e8f       ///< 칼만 가가속도 프로세스 노이즈 밀도 ((counts/s^3)^2*s)
+#if CONFIG_ENCODER_PCNT_MODE
+#define CONFIG_ENCODER_EDGE_JITTER_US   (CONFIG_CONTROL_PERIOD_US * 0.29f) ///< 엣지 시각 오차 (us) - PCNT는 폴링 주기 안 균등 분포 (주기/sqrt(12))
+#define CONFIG_ENCODER_MIN_SPAN_US      (2 * CONFIG_CONTROL_PERIOD_US)     ///< 속도 측정 최소 구간 (us) - 폴링 시각 양자화 완화
+#else
+#define CONFIG_ENCODER_EDGE_JITTER_US   5.0f         ///< 엣지 시각 오차 (us) - ISR 진입 지연
+#define CONFIG_ENCODER_MIN_SPAN_US      0            ///< 속도 측정 최소 구간 (us) - ISR 엣지 시각은 정확하므로 매 엣지 측정
+#endif
+#define CONFIG_ENCODER_STOP_TIMEOUT_MS  200          ///< 엣지가 이 시간 동안 없으면 바퀴 정지로 판단 (ms)
+/** @} */
+
+/**
+ * @defgroup ODOMETRY_CONFIG 오도메트리 설정
+ * @brief 추측 항법 위치 추정과 GPS 융합 설정
+ * @{
+ */
+#define CONFIG_ODOM_GYRO_WEIGHT         0.9f         ///< 헤딩 증분 중 자이로 비중 (0: 바퀴만, 1: 자이로만)
+#define CONFIG_ODOM_DISTANCE_NOISE      0.04f        ///< 이동 거리 분산 증가율 (cm^2 / 이동 cm)
+#define CONFIG_ODOM_HEADING_WALK_DEG    0.5f         ///< 헤딩 랜덤 워크 (deg / sqrt(s))
+#define CONFIG_ODOM_INITIAL_HEADING_STD_DEG 20.0f    ///< 초기 헤딩 불확실성 (deg)
+#define CONFIG_ODOM_GPS_FUSION          1            ///< GPS 고정을 위치 추정에 융합 (0: 추측 항법만)
+#define CONFIG_ODOM_GPS_STD_CM          300.0f       ///< GPS 위치 측정 표준편차 (cm)
+#define CONFIG_ODOM_GPS_GATE            13.8f        ///< GPS 혁신 게이트 (마할라노비스 거리 제곱, 자유도 2에서 99.9%)
+#define CONFIG_ODOM_GPS_ALIGN_DISTANCE_CM 2000.0f    ///< 헤딩 정렬 직진 거리 (cm, 3m 오차 고정에서 약 12도 정렬 오차)
 /** @} */
 
 /**
@@ -232,9 +312,24 @@ extern "C" {
  * @brief 각 태스크별 스택 메모리 할당 크기
  * @{
  */
-#define CONFIG_SENSOR_TASK_STACK        4096         ///< 센서 읽기 태스크 스택 크기 (bytes)
-#define CONFIG_BALANCE_TASK_STACK       4096         ///< 밸런싱 제어 태스크 스택 크기 (bytes)
+#define CONFIG_CONTROL_TASK_STACK       4096         ///< 제어 파이프라인 태스크 스택 크기 (bytes)
 #define CONFIG_STATUS_TASK_STACK        4096         ///< 상태 모니터링 태스크 스택 크기 (bytes)
+#define CONFIG_TELEMETRY_TASK_STACK     3072         ///< 텔레메트리 전송 태스크 스택 크기 (bytes)
+#define CONFIG_GPS_TASK_STACK           3072         ///< GPS 수신 태스크 스택 크기 (bytes)
+/** @} */
+
+/**
+ * @defgroup TASK_CORE_CONFIG 태스크 코어 할당 설정
+ * @brief 제어 태스크를 한 코어에 고정하고 GPS/BLE/로깅은 다른 코어에서 실행
+ * 
+ * BLE 호스트 스택과 app_main은 PRO_CPU(0)에서 실행되므로
+ * 제어 파이프라인은 APP_CPU(1)를 단독으로 사용합니다.
+ * @{
+ */
+#define CONFIG_CONTROL_TASK_CORE        1            ///< 제어 파이프라인 태스크 코어 (APP_CPU)
+#define CONFIG_STATUS_TASK_CORE         0            ///< 상태/BLE 태스크 코어 (PRO_CPU)
+#define CONFIG_TELEMETRY_TASK_CORE      0            ///< 텔레메트리 전송 태스크 코어 (PRO_CPU, BLE 스택과 동일)
+#define CONFIG_GPS_TASK_CORE            0            ///< GPS 수신 태스크 코어 (PRO_CPU)
 /** @} */
 
 /**
@@ -242,9 +337,10 @@ extern "C" {
  * @brief FreeRTOS 태스크 우선순위 (높을수록 우선순위 높음)
  * @{
  */
-#define CONFIG_SENSOR_TASK_PRIORITY     5            ///< 센서 태스크 우선순위 (최고)
-#define CONFIG_BALANCE_TASK_PRIORITY    4            ///< 밸런싱 태스크 우선순위 (높음)
+#define CONFIG_CONTROL_TASK_PRIORITY    5            ///< 제어 파이프라인 태스크 우선순위 (최고)
 #define CONFIG_STATUS_TASK_PRIORITY     3            ///< 상태 태스크 우선순위 (중간)
+#define CONFIG_TELEMETRY_TASK_PRIORITY  2            ///< 텔레메트리 전송 태스크 우선순위 (낮음)
+#define CONFIG_GPS_TASK_PRIORITY        1            ///< GPS 수신 태스크 우선순위 (최저, 유휴 태스크 바로 위)
 /** @} */
 
 /**
@@ -252,8 +348,21 @@ extern "C" {
  * @brief 각 태스크의 실행 주기 (밀리초)
  * @{
  */
-#define CONFIG_SENSOR_UPDATE_RATE       20           ///< 센서 업데이트 주기 (ms) - 50Hz
-#define CONFIG_BALANCE_UPDATE_RATE      20           ///< 밸런싱 업데이트 주기 (ms) - 50Hz
+#ifndef CONFIG_CONTROL_HIGH_RATE_MODE
+#define CONFIG_CONTROL_HIGH_RATE_MODE   1            ///< 고속 제어 모드 (1: 500Hz~1kHz, 0: 기존 50Hz)
+#endif
+
+#ifndef CONFIG_CONTROL_LOOP_HZ
+#if CONFIG_CONTROL_HIGH_RATE_MODE
+#define CONFIG_CONTROL_LOOP_HZ          500          ///< 제어 파이프라인 주파수 (Hz, 최대 CONFIG_FREERTOS_HZ)
+#else
+#define CONFIG_CONTROL_LOOP_HZ          50           ///< 제어 파이프라인 주파수 (Hz)
+#endif
+#endif
+
+#define CONFIG_CONTROL_PERIOD_US        (1000000 / CONFIG_CONTROL_LOOP_HZ) ///< 제어 파이프라인 주기 (us) - 센서→칼만→PID→모터
+#define CONFIG_CONTROL_BUDGET_WARN_PCT  80           ///< 최악 루프 시간이 주기의 이 비율(%)을 넘으면 경고
+#define CONFIG_CONTROL_MAX_DT_MS        100          ///< 측정 dt 상한 (ms) - 스톨 후 필터 발산 방지
 #define CONFIG_STATUS_UPDATE_RATE       1000         ///< 상태 업데이트 주기 (ms) - 1Hz
 /** @} */
 
@@ -271,6 +380,26 @@ extern "C" {
 
 #define CONFIG_BLE_DEVICE_NAME          "BalanceBot" ///< BLE 광고 디바이스 이름
 #define CONFIG_STATUS_BUFFER_SIZE       128          ///< 상태 메시지 버퍼 크기 (bytes)
+#ifndef CONFIG_PROTOCOL_CRC_IMPL
+#define CONFIG_PROTOCOL_CRC_IMPL        2            ///< 프로토콜 CRC16 구현 (0: 비트 단위, 1: 256항목 테이블, 2: 4바이트 슬라이싱)
+#endif
+#define CONFIG_BLE_LOCAL_MTU            512          ///< 수용할 최대 ATT MTU (교환은 클라이언트가 시작)
+#define CONFIG_BLE_CONN_INTERVAL_MIN    6            ///< 요청 최소 연결 간격 (1.25ms 단위, 7.5ms)
+#define CONFIG_BLE_CONN_INTERVAL_MAX    12           ///< 요청 최대 연결 간격 (1.25ms 단위, 15ms)
+#define CONFIG_BLE_CONN_FALLBACK_MIN    12           ///< 거부 시 폴백 최소 연결 간격 (1.25ms 단위, 15ms)
+#define CONFIG_BLE_CONN_FALLBACK_MAX    24           ///< 거부 시 폴백 최대 연결 간격 (1.25ms 단위, 30ms)
+#define CONFIG_BLE_SUPERVISION_TIMEOUT  400          ///< 감독 타임아웃 (10ms 단위, 4초)
+#define CONFIG_BLE_DATA_LENGTH          251          ///< 요청할 LE 데이터 길이 (송신 옥텟, 27~251)
+#define CONFIG_BLE_PREFER_2M_PHY        1            ///< 2M PHY 요청 (1: 요청, 0: 1M 유지)
+#define CONFIG_COMMAND_MAX_AGE_MS       200          ///< 원격 명령 최대 허용 나이 (ms, 추정 전송 지연 + 큐 대기)
+#define CONFIG_COMMAND_TIMEOUT_MS       300          ///< 마지막 원격 명령 후 이동 명령 감속 시작까지 시간 (ms, 앱 재전송 주기 100ms)
+#define CONFIG_COMMAND_DECAY_MS         500          ///< 이동 명령을 0까지 줄이는 감속 시간 (ms)
+#ifndef CONFIG_TELEMETRY_ENABLED
+#define CONFIG_TELEMETRY_ENABLED        1            ///< 고속 텔레메트리 스트림 (1: 사용, 0: 사용 안 함)
+#endif
+#define CONFIG_TELEMETRY_SAMPLE_HZ      100          ///< 텔레메트리 샘플링 주파수 (Hz, CONFIG_CONTROL_LOOP_HZ의 약수)
+#define CONFIG_TELEMETRY_FLUSH_MS       40           ///< 텔레메트리 패킷 전송 주기 (ms) - 알림당 여러 샘플
+#define CONFIG_TELEMETRY_RING_SIZE      64           ///< 텔레메트리 샘플 링 버퍼 크기 (2의 거듭제곱)
 
 /** @} */ // COMM_CONFIG
 
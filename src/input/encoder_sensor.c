@@ -12,18 +12,87 @@
 
 #include "encoder_sensor.h"
 #ifndef NATIVE_BUILD
+#include "driver/pulse_cnt.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
 #endif
 #include <math.h>
+#include <stddef.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
 
 #ifndef NATIVE_BUILD
 static const char* ENCODER_TAG = "ENCODER_SENSOR"; ///< ESP-IDF 로깅 태그
+
+#define ENCODER_ENTER_ISR(e)    portENTER_CRITICAL_ISR(&(e)->lock)
+#define ENCODER_EXIT_ISR(e)     portEXIT_CRITICAL_ISR(&(e)->lock)
+#define ENCODER_ENTER(e)        portENTER_CRITICAL(&(e)->lock)
+#define ENCODER_EXIT(e)         portEXIT_CRITICAL(&(e)->lock)
 #else
 #define ENCODER_TAG "ENCODER_SENSOR" ///< 네이티브 빌드용 로깅 태그
+
+#define ENCODER_ENTER(e)        (void)(e)
+#define ENCODER_EXIT(e)         (void)(e)
+#endif
+
+/**
+ * @brief 현재 시각 (us)
+ * 
+ * 네이티브 빌드에는 시계가 없으므로 마지막 갱신 시각을 돌려주어
+ * 위치만 갱신되게 합니다. 테스트는 encoder_sensor_update_speed_at()을 씁니다.
+ */
+static inline int64_t encoder_now_us(const encoder_sensor_t* encoder) {
+#ifndef NATIVE_BUILD
+    (void)encoder;
+    return esp_timer_get_time();
+#else
+    return encoder->velocity.update_time_us;
 #endif
+}
 
+/**
+ * @brief 두 백엔드 공통 상태 초기화
+ */
+static void encoder_reset_state(encoder_sensor_t* encoder, int pulses_per_rev, float wheel_diam) {
+    velocity_estimator_config_t velocity_config;
+    velocity_estimator_default_config(&velocity_config);
+    velocity_estimator_init(&encoder->velocity, &velocity_config);
+
+    encoder->ppr = pulses_per_rev;
+    encoder->wheel_diameter = wheel_diam;
+    encoder->encoder_count = 0;
+    encoder->last_encoded = 0;
+    encoder->edge_time_us = 0;
+    encoder->current_speed = 0.0f;
+    encoder->current_accel = 0.0f;
+    encoder->backend = ENCODER_BACKEND_ISR;
+    encoder->counter_ops = NULL;
+    encoder->counter_ctx = NULL;
+    encoder->counter_limit = 0;
+    encoder->counter_last = 0;
+#ifndef NATIVE_BUILD
+    portMUX_INITIALIZE(&encoder->lock);
+#endif
+}
+
+/**
+ * @brief 속도 추정기를 현재 카운트와 시각으로 재시작
+ */
+static void encoder_restart_velocity(encoder_sensor_t* encoder) {
+    int64_t now_us = encoder_now_us(encoder);
+    ENCODER_ENTER(encoder);
+    int32_t count = encoder->encoder_count;
+    encoder->edge_time_us = now_us;
+    ENCODER_EXIT(encoder);
+    velocity_estimator_reset(&encoder->velocity, count, now_us);
+    encoder->current_speed = 0.0f;
+    encoder->current_accel = 0.0f;
+}
+
+#ifndef NATIVE_BUILD
 /**
  * @brief 엔코더 인터럽트 서비스 루틴
  * 
@@ -35,29 +104,30 @@ static const char* ENCODER_TAG = "ENCODER_SENSOR"; ///< ESP-IDF 로깅 태그
 static void IRAM_ATTR encoder_isr_handler(void* arg) {
     encoder_sensor_t* encoder = (encoder_sensor_t*)arg;
 
-#ifndef NATIVE_BUILD
     int msb = gpio_get_level(encoder->encoder_pin_a);
     int lsb = gpio_get_level(encoder->encoder_pin_b);
-#else
-    // Mock for native build
-    static int mock_counter = 0;
-    int msb = (mock_counter >> 1) & 1;
-    int lsb = mock_counter & 1;
-    mock_counter++;
-#endif
 
     int encoded = (msb << 1) | lsb;
     int sum = (encoder->last_encoded << 2) | encoded;
+    int step = 0;
 
     if (sum == 0b1101 || sum == 0b0100 || sum == 0b0010 || sum == 0b1011) {
-        encoder->encoder_count++;
+        step = 1;
     }
     if (sum == 0b1110 || sum == 0b0111 || sum == 0b0001 || sum == 0b1000) {
-        encoder->encoder_count--;
+        step = -1;
     }
 
+    // Stamp the edge together with the count so the velocity estimator sees a consistent pair
+    ENCODER_ENTER_ISR(encoder);
+    if (step != 0) {
+        encoder->encoder_count += step;
+        encoder->edge_time_us = esp_timer_get_time();
+    }
     encoder->last_encoded = encoded;
+    ENCODER_EXIT_ISR(encoder);
 }
+#endif
 
 /**
  * @brief 로터리 엔코더 센서를 초기화하고 인터럽트 설정
@@ -81,15 +151,9 @@ static void IRAM_ATTR encoder_isr_handler(void* arg) {
 esp_err_t encoder_sensor_init(encoder_sensor_t* encoder,
                              gpio_num_t pin_a, gpio_num_t pin_b,
                              int pulses_per_rev, float wheel_diam) {
+    encoder_reset_state(encoder, pulses_per_rev, wheel_diam);
     encoder->encoder_pin_a = pin_a;
     encoder->encoder_pin_b = pin_b;
-    encoder->ppr = pulses_per_rev;
-    encoder->wheel_diameter = wheel_diam;
-    encoder->encoder_count = 0;
-    encoder->last_encoded = 0;
-    encoder->last_time = 0;
-    encoder->last_position = 0;
-    encoder->current_speed = 0.0f;
 
 #ifndef NATIVE_BUILD
     // Configure encoder pins
@@ -126,28 +190,208 @@ esp_err_t encoder_sensor_init(encoder_sensor_t* encoder,
         return ret;
     }
 
-    encoder->last_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    encoder_restart_velocity(encoder);
     ESP_LOGI(ENCODER_TAG, "Encoder sensor initialized");
 #endif
 
     return ESP_OK;
 }
 
+/**
+ * @brief 하드웨어 카운터 백엔드로 엔코더 상태 초기화
+ * 
+ * @param encoder 엔코더 센서 구조체 포인터
+ * @param ops 하드웨어 카운터 호출
+ * @param ctx 하드웨어 카운터 호출 컨텍스트
+ * @param limit 카운터가 0으로 돌아가는 한계 (±)
+ * @param pulses_per_rev 회전당 펄스 수
+ * @param wheel_diam 바퀴 직경 (cm)
+ * @return 카운터 초기화 결과
+ */
+esp_err_t encoder_sensor_init_counter(encoder_sensor_t* encoder,
+                                      const encoder_counter_ops_t* ops, void* ctx, int limit,
+                                      int pulses_per_rev, float wheel_diam) {
+    encoder_reset_state(encoder, pulses_per_rev, wheel_diam);
+    encoder->encoder_pin_a = 0;
+    encoder->encoder_pin_b = 0;
+    encoder->backend = ENCODER_BACKEND_COUNTER;
+    encoder->counter_ops = ops;
+    encoder->counter_ctx = ctx;
+    encoder->counter_limit = limit;
+
+    esp_err_t ret = ops->clear_count(ctx);
+    encoder_restart_velocity(encoder);
+    return ret;
+}
+
+/**
+ * @brief 하드웨어 카운터 변화량을 위치에 누적
+ * 
+ * 카운터는 ±limit에서 0으로 돌아가므로 변화량을 limit 주기로 보고
+ * (-limit/2, limit/2] 범위로 접어 실제 이동량을 복원합니다.
+ * 카운터는 엣지 시각을 주지 않으므로 변화를 처음 본 폴링 시각을 씁니다.
+ * 
+ * @param encoder 엔코더 센서 구조체 포인터
+ * @param now_us 폴링 시각 (us)
+ * @return 카운터 읽기 결과
+ */
+static esp_err_t encoder_poll_counter(encoder_sensor_t* encoder, int64_t now_us) {
+    int raw = 0;
+    esp_err_t ret = encoder->counter_ops->get_count(encoder->counter_ctx, &raw);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    // Between polls the wheel moves far less than half the limit, so the short way round is the real motion
+    int delta = raw - encoder->counter_last;
+    int half = encoder->counter_limit / 2;
+    if (delta > half) {
+        delta -= encoder->counter_limit;
+    } else if (delta < -half) {
+        delta += encoder->counter_limit;
+    }
+    encoder->counter_last = raw;
+    if (delta != 0) {
+        encoder->encoder_count += delta;
+        encoder->edge_time_us = now_us;
+    }
+    return ESP_OK;
+}
+
+#ifndef NATIVE_BUILD
+static esp_err_t pcnt_get_count(void* ctx, int* count) {
+    return pcnt_unit_get_count((pcnt_unit_handle_t)ctx, count);
+}
+
+static esp_err_t pcnt_clear_count(void* ctx) {
+    return pcnt_unit_clear_count((pcnt_unit_handle_t)ctx);
+}
+
+static const encoder_counter_ops_t pcnt_counter_ops = {
+    .get_count = pcnt_get_count,
+    .clear_count = pcnt_clear_count,
+};
+
+/**
+ * @brief PCNT 주변장치로 엔코더를 초기화
+ * 
+ * 초기화 과정:
+ * 1. GPIO 핀을 입력 모드로 설정 (풀업 저항 활성화, 인터럽트 없음)
+ * 2. ±ENCODER_PCNT_LIMIT 한계의 PCNT 유닛 생성 및 글리치 필터 설정
+ * 3. A 엣지/B 레벨, B 엣지/A 레벨 두 채널로 4체배 Quadrature 설정
+ * 4. 유닛 활성화, 카운트 초기화 및 시작
+ * 
+ * @param encoder 엔코더 센서 구조체 포인터
+ * @param pin_a 엔코더 A 채널 GPIO 핀 번호
+ * @param pin_b 엔코더 B 채널 GPIO 핀 번호
+ * @param pulses_per_rev 엔코더의 회전당 펄스 수 (PPR)
+ * @param wheel_diam 연결된 휠의 직경 (cm 단위)
+ * @param glitch_ns 이보다 짧은 펄스는 무시 (ns)
+ * @return ESP_OK 성공, 그 외 GPIO 또는 PCNT 설정 실패
+ */
+esp_err_t encoder_sensor_init_pcnt(encoder_sensor_t* encoder,
+                                   gpio_num_t pin_a, gpio_num_t pin_b,
+                                   int pulses_per_rev, float wheel_diam, uint32_t glitch_ns) {
+    // Keep the same pull-ups as the ISR backend; the PCNT channel only routes the pins
+    gpio_config_t encoder_config = {
+        .pin_bit_mask = (1ULL << pin_a) | (1ULL << pin_b),
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_DISABLE,
+    };
+    esp_err_t ret = gpio_config(&encoder_config);
+    if (ret != ESP_OK) {
+        ESP_LOGE(ENCODER_TAG, "Failed to configure encoder GPIO");
+        return ret;
+    }
+
+    // No watch points and no accumulation interrupt: wraps are recovered when polling
+    pcnt_unit_config_t unit_config = {
+        .low_limit = -ENCODER_PCNT_LIMIT,
+        .high_limit = ENCODER_PCNT_LIMIT,
+    };
+    pcnt_unit_handle_t unit = NULL;
+    ret = pcnt_new_unit(&unit_config, &unit);
+    if (ret != ESP_OK) {
+        ESP_LOGE(ENCODER_TAG, "Failed to create PCNT unit");
+        return ret;
+    }
+
+    pcnt_glitch_filter_config_t filter_config = {
+        .max_glitch_ns = glitch_ns,
+    };
+    ret = pcnt_unit_set_glitch_filter(unit, &filter_config);
+    if (ret != ESP_OK) {
+        ESP_LOGE(ENCODER_TAG, "Failed to set PCNT glitch filter");
+        return ret;
+    }
+
+    pcnt_chan_config_t chan_a_config = {
+        .edge_gpio_num = pin_a,
+        .level_gpio_num = pin_b,
+    };
+    pcnt_channel_handle_t chan_a = NULL;
+    ret = pcnt_new_channel(unit, &chan_a_config, &chan_a);
+    if (ret != ESP_OK) {
+        ESP_LOGE(ENCODER_TAG, "Failed to create PCNT channel A");
+        return ret;
+    }
+
+    pcnt_chan_config_t chan_b_config = {
+        .edge_gpio_num = pin_b,
+        .level_gpio_num = pin_a,
+    };
+    pcnt_channel_handle_t chan_b = NULL;
+    ret = pcnt_new_channel(unit, &chan_b_config, &chan_b);
+    if (ret != ESP_OK) {
+        ESP_LOGE(ENCODER_TAG, "Failed to create PCNT channel B");
+        return ret;
+    }
+
+    // Same direction as the ISR table: A rising with B low counts up, B rising with A high counts up
+    pcnt_channel_set_edge_action(chan_a, PCNT_CHANNEL_EDGE_ACTION_DECREASE, PCNT_CHANNEL_EDGE_ACTION_INCREASE);
+    pcnt_channel_set_level_action(chan_a, PCNT_CHANNEL_LEVEL_ACTION_KEEP, PCNT_CHANNEL_LEVEL_ACTION_INVERSE);
+    pcnt_channel_set_edge_action(chan_b, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_DECREASE);
+    pcnt_channel_set_level_action(chan_b, PCNT_CHANNEL_LEVEL_ACTION_KEEP, PCNT_CHANNEL_LEVEL_ACTION_INVERSE);
+
+    ret = pcnt_unit_enable(unit);
+    if (ret == ESP_OK) {
+        ret = encoder_sensor_init_counter(encoder, &pcnt_counter_ops, unit, ENCODER_PCNT_LIMIT,
+                                          pulses_per_rev, wheel_diam);
+    }
+    if (ret == ESP_OK) {
+        ret = pcnt_unit_start(unit);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(ENCODER_TAG, "Failed to start PCNT unit");
+        return ret;
+    }
+
+    encoder->encoder_pin_a = pin_a;
+    encoder->encoder_pin_b = pin_b;
+    ESP_LOGI(ENCODER_TAG, "Encoder sensor initialized (PCNT)");
+    return ESP_OK;
+}
+#endif
+
 /**
  * @brief 엔코더 카운터와 속도를 리셋
  * 
- * 엔코더의 위치 카운터, 이전 위치, 속도 정보를 모두 0으로 초기화합니다.
- * 시간 기준점도 현재 시각으로 재설정합니다.
+ * 엔코더의 위치 카운터와 속도/가속도 추정 상태를 모두 0으로 초기화합니다.
+ * 속도 추정기는 현재 시각부터 다음 엣지를 기준으로 다시 측정합니다.
  * 
  * @param encoder 엔코더 센서 구조체 포인터
  */
 void encoder_sensor_reset(encoder_sensor_t* encoder) {
+    if (encoder->backend == ENCODER_BACKEND_COUNTER) {
+        encoder->counter_ops->clear_count(encoder->counter_ctx);
+        encoder->counter_last = 0;
+    }
+    ENCODER_ENTER(encoder);
     encoder->encoder_count = 0;
-    encoder->last_position = 0;
-    encoder->current_speed = 0.0f;
-#ifndef NATIVE_BUILD
-    encoder->last_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
-#endif
+    ENCODER_EXIT(encoder);
+    encoder_restart_velocity(encoder);
 }
 
 /**
@@ -163,6 +407,13 @@ int32_t encoder_sensor_get_position(const encoder_sensor_t* encoder) {
     return encoder->encoder_count;
 }
 
+/**
+ * @brief 카운트 단위 값을 바퀴 이동 거리(cm) 단위로 변환하는 배율
+ */
+static inline float encoder_cm_per_count(const encoder_sensor_t* encoder) {
+    return (float)M_PI * encoder->wheel_diameter / (float)encoder->ppr;
+}
+
 /**
  * @brief 엔코더로부터 계산된 이동 거리 반환
  * 
@@ -178,10 +429,10 @@ float encoder_sensor_get_distance(const encoder_sensor_t* encoder) {
 }
 
 /**
- * @brief 현재 계산된 이동 속도 반환
+ * @brief 현재 추정된 이동 속도 반환
  * 
- * encoder_sensor_update_speed() 함수에서 계산된 현재 속도를 반환합니다.
- * 속도는 100ms 주기로 업데이트됩니다.
+ * encoder_sensor_update_speed() 함수에서 추정된 현재 속도를 반환합니다.
+ * 속도는 호출 주기(제어 주기)마다 업데이트됩니다.
  * 
  * @param encoder 엔코더 센서 구조체 포인터
  * @return 현재 이동 속도 (cm/s 단위)
@@ -190,34 +441,65 @@ float encoder_sensor_get_speed(const encoder_sensor_t* encoder) {
     return encoder->current_speed;
 }
 
+/**
+ * @brief 현재 추정된 가속도 반환
+ * 
+ * @param encoder 엔코더 센서 구조체 포인터
+ * @return 현재 가속도 (cm/s^2 단위)
+ */
+float encoder_sensor_get_accel(const encoder_sensor_t* encoder) {
+    return encoder->current_accel;
+}
+
+/**
+ * @brief 속도 추정기 설정 변경
+ * 
+ * @param encoder 엔코더 센서 구조체 포인터
+ * @param config 속도 추정기 설정
+ */
+void encoder_sensor_set_velocity_config(encoder_sensor_t* encoder, const velocity_estimator_config_t* config) {
+    velocity_estimator_set_config(&encoder->velocity, config);
+}
+
 /**
  * @brief 엔코더 속도를 계산하고 업데이트
  * 
- * 이전 위치와 현재 위치의 차이를 시간 간격으로 나누어 속도를 계산합니다.
- * 100ms마다 속도를 업데이트하여 안정적인 속도 측정을 제공합니다.
+ * @param encoder 엔코더 센서 구조체 포인터
+ * @return ESP_OK 성공, 그 외 하드웨어 카운터 읽기 실패
+ */
+esp_err_t encoder_sensor_update_speed(encoder_sensor_t* encoder) {
+    return encoder_sensor_update_speed_at(encoder, encoder_now_us(encoder));
+}
+
+/**
+ * @brief 주어진 시각 기준으로 엔코더 속도를 계산하고 업데이트
  * 
  * 속도 계산 과정:
- * 1. 현재 시간과 이전 업데이트 시간의 차이 계산
- * 2. 100ms 이상 경과 시에만 속도 업데이트
- * 3. 위치 차이를 거리로 변환
- * 4. 거리를 시간으로 나누어 속도 계산
+ * 1. 카운터 백엔드는 하드웨어 카운터를 폴링하여 위치와 엣지 시각 갱신
+ * 2. 카운트와 마지막 엣지 시각을 한 쌍으로 읽기 (ISR과 경합 방지)
+ * 3. 속도 추정기에서 엣지 간 시간으로 속도를 측정하고 추적기 갱신
+ * 4. 카운트 단위 속도/가속도를 cm/s, cm/s^2로 변환
  * 
  * @param encoder 엔코더 센서 구조체 포인터
- * @return ESP_OK 성공
+ * @param now_us 현재 시각 (us)
+ * @return ESP_OK 성공, 그 외 하드웨어 카운터 읽기 실패
  */
-esp_err_t encoder_sensor_update_speed(encoder_sensor_t* encoder) {
-#ifndef NATIVE_BUILD
-    uint32_t current_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
-    uint32_t time_diff = current_time - encoder->last_time;
+esp_err_t encoder_sensor_update_speed_at(encoder_sensor_t* encoder, int64_t now_us) {
+    if (encoder->backend == ENCODER_BACKEND_COUNTER) {
+        esp_err_t ret = encoder_poll_counter(encoder, now_us);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
 
-    if (time_diff >= 100) { // Update every 100ms
-        int32_t position_diff = encoder->encoder_count - encoder->last_position;
-        float distance_diff = (float)position_diff / encoder->ppr * M_PI * encoder->wheel_diameter;
-        encoder->current_speed = (distance_diff / (time_diff / 1000.0f)) * 100.0f; // cm/s
+    ENCODER_ENTER(encoder);
+    int32_t count = encoder->encoder_count;
+    int64_t edge_time_us = encoder->edge_time_us;
+    ENCODER_EXIT(encoder);
 
-        encoder->last_time = current_time;
-        encoder->last_position = encoder->encoder_count;
-    }
-#endif
+    velocity_estimator_update(&encoder->velocity, count, edge_time_us, now_us);
+    float scale = encoder_cm_per_count(encoder);
+    encoder->current_speed = velocity_estimator_get_velocity(&encoder->velocity) * scale;
+    encoder->current_accel = velocity_estimator_get_accel(&encoder->velocity) * scale;
     return ESP_OK;
-}
\ No newline at end of file
+}
@@ -9,9 +9,17 @@
  * - A/B 상 신호 처리 (Quadrature decoding)
  * - 회전 위치 카운팅
  * - 이동 거리 계산
- * - 회전 속도 측정
+ * - 회전 속도/가속도 측정 (엣지 시각 기반 추정기, velocity_estimator.h)
  * - 인터럽트 기반 실시간 처리
  * 
+ * 카운팅 백엔드는 두 가지입니다:
+ * - ISR: A/B 상의 모든 엣지에서 GPIO 인터럽트로 카운트 (encoder_sensor_init)
+ * - 하드웨어 카운터: PCNT 주변장치가 4체배 Quadrature로 카운트하고, 속도
+ *   업데이트 때마다 카운터를 폴링하여 누적합니다 (encoder_sensor_init_pcnt).
+ *   PCNT는 ±한계에서 0으로 돌아가지만 폴링 사이의 변화량이 한계의 절반보다
+ *   작으면 최단 거리로 복원되므로 오버플로 인터럽트도 필요 없습니다.
+ * 두 백엔드 모두 같은 encoder_sensor_* API로 위치, 거리, 속도를 제공합니다.
+ * 
  * @author BalanceBot Team
  * @date 2025-09-20
  * @version 1.0
@@ -22,6 +30,7 @@
 
 #ifndef NATIVE_BUILD
 #include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
 #include "esp_err.h"
 #else
 typedef int esp_err_t;
@@ -31,6 +40,8 @@ typedef int gpio_num_t;
 #define IRAM_ATTR
 #endif
 
+#include "../logic/velocity_estimator.h"
+
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -38,6 +49,27 @@ typedef int gpio_num_t;
 extern "C" {
 #endif
 
+#define ENCODER_PCNT_LIMIT      32767   ///< PCNT 카운트 한계 (이 값에 닿으면 0으로 돌아감)
+
+/**
+ * @brief 엔코더 카운팅 백엔드
+ */
+typedef enum {
+    ENCODER_BACKEND_ISR = 0,    ///< GPIO 엣지 인터럽트로 카운트
+    ENCODER_BACKEND_COUNTER,    ///< 하드웨어 카운터를 폴링하여 누적
+} encoder_backend_t;
+
+/**
+ * @struct encoder_counter_ops_t
+ * @brief 하드웨어 카운터 호출 (타깃: PCNT, 테스트: 모의 카운터)
+ *
+ * 카운터는 ±한계에 닿으면 0으로 돌아가는 것으로 가정합니다.
+ */
+typedef struct {
+    esp_err_t (*get_count)(void* ctx, int* count);  ///< 현재 카운트 읽기
+    esp_err_t (*clear_count)(void* ctx);            ///< 카운트 0으로 초기화
+} encoder_counter_ops_t;
+
 /**
  * @struct encoder_sensor_t
  * @brief 엔코더 센서 제어 구조체
@@ -49,11 +81,20 @@ typedef struct {
     gpio_num_t encoder_pin_b;    ///< B상 신호 GPIO 핀
     volatile int32_t encoder_count; ///< 현재 엔코더 카운트 (인터럽트에서 업데이트)
     volatile int last_encoded;   ///< 마지막 인코딩 상태 (A/B 조합)
+    volatile int64_t edge_time_us; ///< encoder_count를 바꾼 마지막 엣지 시각 (us)
     int ppr;                     ///< 회전당 펄스 수 (Pulses Per Revolution)
     float wheel_diameter;        ///< 바퀴 직경 (cm)
-    uint32_t last_time;          ///< 마지막 속도 계산 시간 (ms)
-    int32_t last_position;       ///< 마지막 위치 (속도 계산용)
+    velocity_estimator_t velocity; ///< 속도/가속도 추정기 (counts/s)
     float current_speed;         ///< 현재 속도 (cm/s)
+    float current_accel;         ///< 현재 가속도 (cm/s^2)
+    encoder_backend_t backend;   ///< 카운팅 백엔드
+    const encoder_counter_ops_t* counter_ops; ///< 하드웨어 카운터 호출 (카운터 백엔드)
+    void* counter_ctx;           ///< 하드웨어 카운터 호출 컨텍스트
+    int counter_limit;           ///< 하드웨어 카운터 한계 (±)
+    int counter_last;            ///< 마지막 폴링 시 하드웨어 카운트
+#ifndef NATIVE_BUILD
+    portMUX_TYPE lock;           ///< ISR/태스크 간 카운트와 엣지 시각 보호
+#endif
 } encoder_sensor_t;
 
 /**
@@ -80,6 +121,46 @@ esp_err_t encoder_sensor_init(encoder_sensor_t* encoder,
                              gpio_num_t pin_a, gpio_num_t pin_b,
                              int pulses_per_rev, float wheel_diam);
 
+/**
+ * @brief 하드웨어 카운터 백엔드로 엔코더 초기화
+ * 
+ * 카운터를 0으로 초기화하고, 이후 encoder_sensor_update_speed() 호출마다
+ * 카운터 변화량을 encoder_count에 누적합니다. 폴링 사이의 변화량은
+ * limit / 2 미만이어야 합니다.
+ * 
+ * @param encoder 엔코더 센서 구조체 포인터
+ * @param ops 하드웨어 카운터 호출
+ * @param ctx 하드웨어 카운터 호출 컨텍스트
+ * @param limit 카운터가 0으로 돌아가는 한계 (±)
+ * @param pulses_per_rev 회전당 펄스 수
+ * @param wheel_diam 바퀴 직경 (cm)
+ * @return esp_err_t 카운터 초기화 결과
+ */
+esp_err_t encoder_sensor_init_counter(encoder_sensor_t* encoder,
+                                      const encoder_counter_ops_t* ops, void* ctx, int limit,
+                                      int pulses_per_rev, float wheel_diam);
+
+#ifndef NATIVE_BUILD
+/**
+ * @brief PCNT 주변장치로 엔코더 초기화
+ * 
+ * PCNT 유닛 하나에 두 채널을 4체배 Quadrature로 설정하고 글리치 필터를
+ * 켭니다. 카운트 방향은 ISR 백엔드와 같습니다. 엔코더 핀에는 인터럽트를
+ * 등록하지 않습니다.
+ * 
+ * @param encoder 엔코더 센서 구조체 포인터
+ * @param pin_a A상 신호 GPIO 핀
+ * @param pin_b B상 신호 GPIO 핀
+ * @param pulses_per_rev 회전당 펄스 수
+ * @param wheel_diam 바퀴 직경 (cm)
+ * @param glitch_ns 이보다 짧은 펄스는 무시 (ns)
+ * @return esp_err_t PCNT 설정 결과
+ */
+esp_err_t encoder_sensor_init_pcnt(encoder_sensor_t* encoder,
+                                   gpio_num_t pin_a, gpio_num_t pin_b,
+                                   int pulses_per_rev, float wheel_diam, uint32_t glitch_ns);
+#endif
+
 /**
  * @brief 엔코더 카운트 리셋
  * 
@@ -116,7 +197,7 @@ float encoder_sensor_get_distance(const encoder_sensor_t* encoder);
 /**
  * @brief 현재 속도 읽기
  * 
- * 가장 최근에 계산된 속도 값을 반환합니다.
+ * 가장 최근에 추정된 속도 값을 반환합니다.
  * 
  * @param encoder 엔코더 센서 구조체 포인터
  * @return float 현재 속도 (cm/s)
@@ -125,21 +206,53 @@ float encoder_sensor_get_distance(const encoder_sensor_t* encoder);
  */
 float encoder_sensor_get_speed(const encoder_sensor_t* encoder);
 
+/**
+ * @brief 현재 가속도 읽기
+ * 
+ * @param encoder 엔코더 센서 구조체 포인터
+ * @return float 가장 최근에 추정된 가속도 (cm/s^2)
+ */
+float encoder_sensor_get_accel(const encoder_sensor_t* encoder);
+
+/**
+ * @brief 속도 추정기 설정 변경 (추정 상태는 유지)
+ * 
+ * 초기화 시에는 velocity_estimator_default_config() 설정이 적용됩니다.
+ * 
+ * @param encoder 엔코더 센서 구조체 포인터
+ * @param config 속도 추정기 설정
+ */
+void encoder_sensor_set_velocity_config(encoder_sensor_t* encoder, const velocity_estimator_config_t* config);
+
 /**
  * @brief 속도 계산 업데이트
  * 
- * 현재 위치와 시간을 기반으로 속도를 계산하여 업데이트합니다.
+ * 마지막 엣지의 카운트와 시각(us)으로 속도를 측정하고 추적기를 갱신합니다.
  * 주기적으로 호출해야 정확한 속도 측정이 가능합니다.
+ * 카운터 백엔드는 이 호출에서 하드웨어 카운터를 폴링하여 위치를 누적하며,
+ * 카운트 변화를 처음 본 폴링 시각을 엣지 시각으로 사용합니다.
  * 
  * @param encoder 엔코더 센서 구조체 포인터
  * @return esp_err_t 
  *         - ESP_OK: 업데이트 성공
- *         - ESP_FAIL: 업데이트 실패
+ *         - 그 외: 하드웨어 카운터 읽기 실패
  * 
- * @note 센서 태스크에서 50Hz 주기로 호출하는 것을 권장합니다.
+ * @note 제어 주기마다 호출합니다. 현재 시각은 esp_timer에서 읽습니다.
  */
 esp_err_t encoder_sensor_update_speed(encoder_sensor_t* encoder);
 
+/**
+ * @brief 주어진 시각 기준으로 속도 계산 업데이트
+ * 
+ * encoder_sensor_update_speed()와 같으며 현재 시각을 호출자가 지정합니다
+ * (네이티브 테스트, 제어 주기 시작 시각 재사용).
+ * 
+ * @param encoder 엔코더 센서 구조체 포인터
+ * @param now_us 현재 시각 (us, esp_timer 기준)
+ * @return esp_err_t ESP_OK, 그 외 하드웨어 카운터 읽기 실패
+ */
+esp_err_t encoder_sensor_update_speed_at(encoder_sensor_t* encoder, int64_t now_us);
+
 /** @} */ // ENCODER_SENSOR_API
 
 #ifdef __cplusplus
@@ -2,8 +2,8 @@
  * @file gps_sensor.c
  * @brief GPS 위성 위치 센서 드라이버 구현 파일
  * 
- * UART를 통해 GPS 모듈로부터 NMEA 0183 형식의 데이터를 수신하고
- * 파싱하여 위도, 경도, 고도 등의 위치 정보를 추출합니다.
+ * UART 이벤트로 수신 데이터를 받아 NMEA 0183과 UBX 스트림 파서에 바이트 단위로 넣고,
+ * 검증된 문장/프레임에서 위도, 경도, 고도 등의 위치 정보를 추출합니다.
  * 
  * @author BalanceBot Team
  * @date 2025-09-20
@@ -14,22 +14,10 @@
 #include "../bsw/uart_driver.h"
 #ifndef NATIVE_BUILD
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #endif
 #include <string.h>
-#include <stdlib.h>
-
-// Mock functions for native build
-#ifndef NATIVE_BUILD
-#else
-char* strdup(const char* s) {
-    size_t len = strlen(s) + 1;
-    char* dup = malloc(len);
-    if (dup) {
-        memcpy(dup, s, len);
-    }
-    return dup;
-}
-#endif
 
 #ifndef NATIVE_BUILD
 static const char* GPS_TAG = "GPS_SENSOR";
@@ -38,41 +26,25 @@ static const char* GPS_TAG = "GPS_SENSOR";
 #endif
 
 /**
- * @brief 도분(degree-minute) 형식을 십진도(decimal degree) 형식으로 변환
- * @param deg_min 도분 형식의 좌표값 (DDMM.MMMM)
- * @return 십진도 형식의 좌표값
- */
-static float convert_deg_min_to_dec_deg(float deg_min);
-
-/**
- * @brief NMEA 0183 문장을 파싱하여 GPS 데이터 추출
- * @param gps GPS 센서 구조체 포인터
- * @param sentence NMEA 문장 문자열
- * @return 파싱 성공 시 true, 실패 시 false
- */
-static bool parse_nmea(gps_sensor_t* gps, const char* sentence);
-
-/**
- * @brief GPGGA 문장을 파싱하여 위치/고도 정보 추출
+ * @brief 검증된 NMEA 문장을 GPS 데이터에 반영
  * @param gps GPS 센서 구조체 포인터
- * @param sentence GPGGA NMEA 문장
- * @return 파싱 성공 시 true, 실패 시 false
+ * @param sentence 완성된 문장 종류
+ * @return 위치 데이터(고정 여부 포함)가 바뀌었으면 true
  */
-static bool parse_gpgga(gps_sensor_t* gps, const char* sentence);
+static bool apply_sentence(gps_sensor_t* gps, nmea_sentence_t sentence);
 
 /**
- * @brief GPRMC 문장을 파싱하여 수신 상태 확인
+ * @brief 검증된 NAV-PVT를 GPS 데이터에 반영
  * @param gps GPS 센서 구조체 포인터
- * @param sentence GPRMC NMEA 문장
- * @return 항상 false (위치 정보는 GPGGA에서만 업데이트)
+ * @param pvt NAV-PVT 페이로드 뷰
  */
-static bool parse_gprmc(gps_sensor_t* gps, const char* sentence);
+static void apply_nav_pvt(gps_sensor_t* gps, const ubx_nav_pvt_t* pvt);
 
 /**
  * @brief GPS 센서를 초기화하고 UART 통신 설정
  * 
  * 지정된 UART 포트와 핀을 사용하여 GPS 모듈과의 통신을 설정합니다.
- * GPS 데이터 구조체를 초기화하고 UART 드라이버를 구성합니다.
+ * UART 드라이버는 RX 링 버퍼와 이벤트 큐를 함께 설치하여 수신을 이벤트로 알립니다.
  * 
  * @param gps GPS 센서 구조체 포인터
  * @param port 사용할 UART 포트 번호
@@ -89,8 +61,19 @@ esp_err_t gps_sensor_init(gps_sensor_t* gps, uart_port_t port, gpio_num_t tx_pin
     gps->data.satellites = 0;
     gps->data.fix_valid = false;
     gps->data.initialized = false;
-
-    esp_err_t ret = uart_driver_init(port, tx_pin, rx_pin, baudrate);
+    gps->data.accuracy = 0.0f;
+    gps->data.speed = 0.0f;
+    gps->data.course = 0.0f;
+    gps->data.has_velocity = false;
+    gps->rx_overflows = 0;
+    gps->base_baudrate = baudrate;
+    gps->baudrate = baudrate;
+    gps->probe_count = 0;
+    gps->nmea_since_pvt = GPS_NMEA_FALLBACK_GGA;
+    nmea_parser_init(&gps->parser);
+    ubx_parser_init(&gps->ubx);
+
+    esp_err_t ret = uart_driver_init_events(port, tx_pin, rx_pin, baudrate, GPS_RX_BUFFER_SIZE, GPS_EVENT_QUEUE_SIZE);
     if (ret != ESP_OK) {
         return ret;
     }
@@ -106,36 +89,197 @@ esp_err_t gps_sensor_init(gps_sensor_t* gps, uart_port_t port, gpio_num_t tx_pin
 /**
  * @brief GPS 센서 데이터를 업데이트하여 최신 위치 정보 수신
  * 
- * UART를 통해 GPS 모듈로부터 NMEA 문장을 읽어와 파싱합니다.
- * 수신된 데이터에서 GPGGA, GPRMC 문장을 추출하여 위치, 고도, 위성 수 등의
- * 정보를 업데이트합니다.
+ * UART 수신 이벤트를 기다렸다가 링 버퍼에 쌓인 바이트를 GPS_READ_CHUNK_SIZE씩
+ * 꺼내 파서에 넣습니다. 문장이 조각 경계에 걸쳐도 파서가 이어서 조립합니다.
+ * 수신 버퍼가 넘쳤으면 파서도 다음 '$'부터 다시 동기화합니다.
  * 
  * @param gps GPS 센서 구조체 포인터
- * @return ESP_OK 성공, ESP_FAIL 센서가 초기화되지 않음
+ * @param timeout_ms 수신 이벤트 대기 타임아웃 (밀리초)
+ * @return 위치 데이터(고정 여부 포함)가 바뀌었으면 true
  */
-esp_err_t gps_sensor_update(gps_sensor_t* gps) {
+bool gps_sensor_update(gps_sensor_t* gps, uint32_t timeout_ms) {
     if (!gps->data.initialized) {
-        return ESP_FAIL;
+        return false;
     }
 
-    uint8_t buffer[256];
-    int len = uart_read_data(gps->uart_port, buffer, sizeof(buffer) - 1, 100);
+    uint8_t buffer[GPS_READ_CHUNK_SIZE];
+    int len = uart_wait_data(gps->uart_port, buffer, sizeof(buffer), timeout_ms);
+    if (len == UART_DRIVER_OVERFLOW) {
+        gps->rx_overflows++;
+        // Counters survive; only the half-assembled sentence/frame is dropped
+        gps->parser.state = 0;
+        gps->ubx.state = 0;
+        return false;
+    }
 
-    if (len > 0) {
-        buffer[len] = '\0';
-        char* sentence = strtok((char*)buffer, "\r\n");
+    bool changed = false;
+    while (len > 0) {
+        changed |= gps_sensor_feed(gps, buffer, (size_t)len);
+        // Drain whatever else the ring buffer holds without waiting
+        len = len == (int)sizeof(buffer) ? uart_read_data(gps->uart_port, buffer, sizeof(buffer), 0) : 0;
+    }
+    return changed;
+}
 
-        while (sentence != NULL) {
-            if (parse_nmea(gps, sentence)) {
-                return ESP_OK;
+/**
+ * @brief 수신 바이트를 파서에 입력
+ * 
+ * @param gps GPS 센서 구조체 포인터
+ * @param data 수신 데이터
+ * @param length 수신 데이터 길이
+ * @return 위치 데이터(고정 여부 포함)가 바뀌었으면 true
+ */
+bool gps_sensor_feed(gps_sensor_t* gps, const uint8_t* data, size_t length) {
+    bool changed = false;
+    for (size_t i = 0; i < length; i++) {
+        // 0xB5 never appears in NMEA text, so both parsers can see every byte
+        const ubx_frame_t* frame = ubx_parser_feed(&gps->ubx, data[i]);
+        if (frame != NULL) {
+            const ubx_nav_pvt_t* pvt = ubx_frame_nav_pvt(frame);
+            if (pvt != NULL) {
+                apply_nav_pvt(gps, pvt);
+                changed = true;
             }
-            sentence = strtok(NULL, "\r\n");
+        }
+        nmea_sentence_t sentence = nmea_parser_feed(&gps->parser, data[i]);
+        if (sentence != NMEA_SENTENCE_NONE) {
+            changed |= apply_sentence(gps, sentence);
         }
     }
+    return changed;
+}
 
+/**
+ * @brief 리틀 엔디언 16비트 값 기록
+ */
+static uint8_t* put_u16(uint8_t* p, uint16_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    return p + 2;
+}
+
+/**
+ * @brief 리틀 엔디언 32비트 값 기록
+ */
+static uint8_t* put_u32(uint8_t* p, uint32_t value) {
+    p = put_u16(p, (uint16_t)value);
+    return put_u16(p, (uint16_t)(value >> 16));
+}
+
+/**
+ * @brief UBX 메시지 하나 전송
+ */
+static esp_err_t send_ubx(gps_sensor_t* gps, uint8_t cls, uint8_t id, const uint8_t* payload, uint16_t length) {
+    uint8_t frame[UBX_FRAME_OVERHEAD + 32];
+    size_t size = ubx_build_frame(frame, sizeof(frame), cls, id, payload, length);
+    if (size == 0) {
+        return ESP_FAIL;
+    }
+    return uart_write_data(gps->uart_port, frame, size);
+}
+
+/**
+ * @brief u-blox 수신기를 UBX NAV-PVT 출력으로 설정
+ * 
+ * u-blox 9 이상은 CFG-VALSET 하나로 측정 주기, NAV-PVT 출력, 보드레이트를 RAM 계층에
+ * 적용하고 CFG-PRT는 이미 바뀐 보드레이트에서 깨진 바이트로 무시합니다. u-blox 8 이하는
+ * CFG-VALSET을 거부(NAK)하고 CFG-PRT로 보드레이트를 바꾸며, 새 보드레이트에서 보내는
+ * CFG-RATE/CFG-MSG로 주기와 NAV-PVT 출력을 설정합니다. 전원이 꺼지면 수신기 설정은
+ * 기본값으로 돌아가므로 부팅마다 다시 보냅니다.
+ * 
+ * @param gps GPS 센서 구조체 포인터
+ * @param baudrate 새 보드레이트 (bps)
+ * @param rate_hz 측정 주기 (Hz, 1~10)
+ * @return ESP_OK 전송 완료, ESP_FAIL 실패
+ */
+esp_err_t gps_sensor_configure_ubx(gps_sensor_t* gps, int baudrate, int rate_hz) {
+    if (!gps->data.initialized || rate_hz <= 0) {
+        return ESP_FAIL;
+    }
+    uint16_t meas_ms = (uint16_t)(1000 / rate_hz);
+
+    // u-blox 9+: RAM layer, keys CFG-RATE-MEAS, CFG-MSGOUT-UBX_NAV_PVT_UART1, CFG-UART1-BAUDRATE
+    uint8_t valset[4 + 6 + 5 + 8];
+    uint8_t* p = valset;
+    *p++ = 0x00;
+    *p++ = 0x01;
+    p = put_u16(p, 0);
+    p = put_u32(p, 0x30210001);
+    p = put_u16(p, meas_ms);
+    p = put_u32(p, 0x20910007);
+    *p++ = 1;
+    p = put_u32(p, 0x40520001);
+    p = put_u32(p, (uint32_t)baudrate);
+
+    // u-blox 8: UART1 8N1, UBX+NMEA in and out
+    uint8_t prt[20] = { 0 };
+    p = prt;
+    *p++ = 1;
+    p += 3;
+    p = put_u32(p, 0x000008D0);
+    p = put_u32(p, (uint32_t)baudrate);
+    p = put_u16(p, 0x0003);
+    put_u16(p, 0x0003);
+
+    esp_err_t ret = send_ubx(gps, UBX_CLASS_CFG, UBX_ID_CFG_VALSET, valset, sizeof(valset));
+    if (ret == ESP_OK) {
+        ret = send_ubx(gps, UBX_CLASS_CFG, UBX_ID_CFG_PRT, prt, sizeof(prt));
+    }
+    if (ret == ESP_OK) {
+        ret = uart_driver_set_baudrate(gps->uart_port, baudrate);
+    }
+    if (ret != ESP_OK) {
+        return ESP_FAIL;
+    }
+    gps->baudrate = baudrate;
+#ifndef NATIVE_BUILD
+    vTaskDelay(pdMS_TO_TICKS(GPS_UBX_SWITCH_DELAY_MS));
+#endif
+
+    // u-blox 8 rate and NAV-PVT output on the port this arrives on (u-blox 9+ NAKs these)
+    uint8_t rate[6];
+    p = put_u16(rate, meas_ms);
+    p = put_u16(p, 1);
+    put_u16(p, 1);
+    const uint8_t msg[3] = { UBX_CLASS_NAV, UBX_ID_NAV_PVT, 1 };
+    send_ubx(gps, UBX_CLASS_CFG, UBX_ID_CFG_RATE, rate, sizeof(rate));
+    send_ubx(gps, UBX_CLASS_CFG, UBX_ID_CFG_MSG, msg, sizeof(msg));
+
+    gps->probe_count = gps->parser.sentences + gps->ubx.frames;
+#ifndef NATIVE_BUILD
+    ESP_LOGI(GPS_TAG, "UBX NAV-PVT requested at %d baud, %d Hz", baudrate, rate_hz);
+#endif
     return ESP_OK;
 }
 
+/**
+ * @brief UBX 설정 후 새 보드레이트 확인
+ * 
+ * @param gps GPS 센서 구조체 포인터
+ * @return 새 보드레이트를 유지하면 true, 되돌렸으면 false
+ */
+bool gps_sensor_confirm_baudrate(gps_sensor_t* gps) {
+    if (gps->baudrate == gps->base_baudrate ||
+        gps->parser.sentences + gps->ubx.frames != gps->probe_count) {
+        return true;
+    }
+    uart_driver_set_baudrate(gps->uart_port, gps->base_baudrate);
+    gps->baudrate = gps->base_baudrate;
+#ifndef NATIVE_BUILD
+    ESP_LOGW(GPS_TAG, "No GPS data after UBX setup, back to %d baud", gps->base_baudrate);
+#endif
+    return false;
+}
+
+/**
+ * @brief 현재 위치 소스가 UBX NAV-PVT인지 확인
+ * @param gps GPS 센서 구조체 포인터
+ * @return NAV-PVT 사용 중이면 true
+ */
+bool gps_sensor_is_ubx(gps_sensor_t* gps) {
+    return gps->nmea_since_pvt < GPS_NMEA_FALLBACK_GGA;
+}
+
 /**
  * @brief 현재 GPS 위도 좌표 반환
  * @param gps GPS 센서 구조체 포인터
@@ -191,117 +335,73 @@ bool gps_sensor_is_initialized(gps_sensor_t* gps) {
 }
 
 /**
- * @brief 도분(degree-minute) 형식을 십진도(decimal degree) 형식으로 변환
- * 
- * GPS NMEA 데이터에서 사용하는 DDMM.MMMM 형식을 표준 십진도 형식으로 변환합니다.
- * 예: 3723.2475 → 37.387458도
+ * @brief 검증된 NMEA 문장을 GPS 데이터에 반영
  * 
- * @param deg_min 도분 형식의 좌표값 (DDMM.MMMM)
- * @return 십진도 형식의 좌표값
- */
-static float convert_deg_min_to_dec_deg(float deg_min) {
-    int degrees = (int)(deg_min / 100);
-    float minutes = deg_min - (degrees * 100);
-    return degrees + (minutes / 60.0f);
-}
-
-/**
- * @brief NMEA 0183 문장을 파싱하여 GPS 데이터 추출
+ * 토커 ID는 구분하지 않으므로 GPS 단독($GP)과 다중 GNSS($GN, $GL 등) 수신기를 모두 받습니다.
+ * GGA (Global Positioning System Fix Data) 문장은 고정 품질이 0보다 크고
+ * 위도/경도가 있을 때 위치를 갱신하고, 그렇지 않으면 고정을 해제합니다.
+ * RMC (Recommended Minimum Course) 문장은 상태가 'V'(무효)이면 고정을 해제합니다.
+ * 위치는 GGA에서만 갱신합니다.
  * 
- * 수신된 NMEA 문장의 타입을 확인하고 해당하는 파서 함수를 호출합니다.
- * 현재 GPGGA(위치/고도)와 GPRMC(수신상태) 문장을 지원합니다.
+ * NAV-PVT가 들어오는 동안에는 NMEA를 반영하지 않습니다. NAV-PVT 없이 GGA가
+ * GPS_NMEA_FALLBACK_GGA개 이어지면 NMEA로 전환합니다.
  * 
  * @param gps GPS 센서 구조체 포인터
- * @param sentence NMEA 문장 문자열
- * @return 파싱 성공 및 데이터 업데이트 시 true, 그 외 false
+ * @param sentence 완성된 문장 종류
+ * @return 위치 데이터(고정 여부 포함)가 바뀌었으면 true
  */
-static bool parse_nmea(gps_sensor_t* gps, const char* sentence) {
-    if (strncmp(sentence, "$GPGGA", 6) == 0) {
-        return parse_gpgga(gps, sentence);
-    } else if (strncmp(sentence, "$GPRMC", 6) == 0) {
-        return parse_gprmc(gps, sentence);
+static bool apply_sentence(gps_sensor_t* gps, nmea_sentence_t sentence) {
+    const nmea_data_t* nmea = nmea_parser_data(&gps->parser);
+    if (sentence == NMEA_SENTENCE_GGA && gps->nmea_since_pvt < GPS_NMEA_FALLBACK_GGA) {
+        gps->nmea_since_pvt++;
+    }
+    if (gps_sensor_is_ubx(gps)) {
+        return false;
     }
-    return false;
-}
 
-/**
- * @brief GPGGA 문장을 파싱하여 위치/고도 정보 추출
- * 
- * GPGGA (Global Positioning System Fix Data) 문장에서 위도, 경도, 고도,
- * 위성 개수, GPS 품질 등의 정보를 추출하여 GPS 데이터 구조체에 저장합니다.
- * 
- * GPGGA 문장 형식:
- * $GPGGA,time,lat,lat_dir,lon,lon_dir,quality,satellites,hdop,altitude,M,height,M,time,checksum
- * 
- * @param gps GPS 센서 구조체 포인터
- * @param sentence GPGGA NMEA 문장
- * @return GPS 수신이 유효한 경우 true, 무효한 경우 false
- */
-static bool parse_gpgga(gps_sensor_t* gps, const char* sentence) {
-    char* copy = strdup(sentence);
-    char* token = strtok(copy, ",");
-    int field = 0;
-
-    float lat_raw = 0, lon_raw = 0;
-    char lat_dir = 'N', lon_dir = 'E';
-    int quality = 0;
-
-    while (token != NULL && field < 15) {
-        switch (field) {
-            case 2: lat_raw = atof(token); break;
-            case 3: lat_dir = token[0]; break;
-            case 4: lon_raw = atof(token); break;
-            case 5: lon_dir = token[0]; break;
-            case 6: quality = atoi(token); break;
-            case 7: gps->data.satellites = atoi(token); break;
-            case 9: gps->data.altitude = atof(token); break;
+    if (sentence == NMEA_SENTENCE_GGA) {
+        gps->data.accuracy = 0.0f;
+        gps->data.has_velocity = false;
+        gps->data.satellites = nmea->satellites;
+        gps->data.altitude = nmea->altitude;
+        if (nmea->quality > 0 && nmea->has_position) {
+            gps->data.latitude = nmea->latitude;
+            gps->data.longitude = nmea->longitude;
+            gps->data.fix_valid = true;
+        } else {
+            gps->data.fix_valid = false;
         }
-        token = strtok(NULL, ",");
-        field++;
+        return true;
     }
 
-    if (quality > 0 && lat_raw != 0 && lon_raw != 0) {
-        gps->data.latitude = convert_deg_min_to_dec_deg(lat_raw);
-        gps->data.longitude = convert_deg_min_to_dec_deg(lon_raw);
-
-        if (lat_dir == 'S') gps->data.latitude = -gps->data.latitude;
-        if (lon_dir == 'W') gps->data.longitude = -gps->data.longitude;
-
-        gps->data.fix_valid = true;
-    } else {
+    if (sentence == NMEA_SENTENCE_RMC && !nmea->status_valid && gps->data.fix_valid) {
         gps->data.fix_valid = false;
+        return true;
     }
-
-    free(copy);
-    return gps->data.fix_valid;
+    return false;
 }
 
 /**
- * @brief GPRMC 문장을 파싱하여 수신 상태 확인
+ * @brief 검증된 NAV-PVT를 GPS 데이터에 반영
  * 
- * GPRMC (Recommended Minimum Course) 문장에서 GPS 수신 유효성을 확인합니다.
- * 'A'는 유효한 수신, 'V'는 무효한 수신을 나타냅니다.
- * 위치 정보는 GPGGA에서만 업데이트하므로 이 함수는 상태 확인용입니다.
+ * gnssFixOK이고 2D/3D (또는 GNSS+추측항법) 고정일 때만 위치를 갱신합니다.
+ * 정수 필드를 단위만 바꿔 그대로 씁니다.
  * 
  * @param gps GPS 센서 구조체 포인터
- * @param sentence GPRMC NMEA 문장
- * @return 항상 false (위치 정보는 GPGGA에서만 업데이트)
+ * @param pvt NAV-PVT 페이로드 뷰
  */
-static bool parse_gprmc(gps_sensor_t* gps, const char* sentence) {
-    // Simplified GPRMC parsing - mainly for fix validity
-    char* copy = strdup(sentence);
-    char* token = strtok(copy, ",");
-    int field = 0;
-
-    while (token != NULL && field < 3) {
-        if (field == 2) {
-            gps->data.fix_valid = (token[0] == 'A');
-            break;
-        }
-        token = strtok(NULL, ",");
-        field++;
+static void apply_nav_pvt(gps_sensor_t* gps, const ubx_nav_pvt_t* pvt) {
+    gps->nmea_since_pvt = 0;
+    gps->data.satellites = pvt->num_sv;
+    bool fix = (pvt->flags & UBX_NAV_PVT_FIX_OK) && pvt->fix_type >= 2 && pvt->fix_type <= 4;
+    if (fix) {
+        gps->data.latitude = pvt->lat * 1e-7;
+        gps->data.longitude = pvt->lon * 1e-7;
+        gps->data.altitude = pvt->h_msl * 1e-3f;
+        gps->data.accuracy = pvt->h_acc * 1e-3f;
+        gps->data.speed = pvt->g_speed * 1e-3f;
+        gps->data.course = pvt->head_mot * 1e-5f;
     }
-
-    free(copy);
-    return false; // Don't update position from RMC
-}
\ No newline at end of file
+    gps->data.has_velocity = fix;
+    gps->data.fix_valid = fix;
+}
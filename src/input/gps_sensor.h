@@ -3,10 +3,22 @@
  * @brief GPS 위성 위치 센서 드라이버 헤더 파일
  * 
  * UART 기반 GPS 모듈을 위한 드라이버입니다.
- * NMEA 0183 프로토콜을 파싱하여 위치, 고도, 위성 정보를 제공합니다.
+ * NMEA 0183 또는 u-blox UBX 프로토콜을 파싱하여 위치, 고도, 위성 정보를 제공합니다.
+ * 
+ * UART 드라이버가 수신 바이트를 RX 링 버퍼에 쌓고 이벤트로 알리면, GPS 전용
+ * 저우선순위 태스크가 이벤트를 기다렸다가 쌓인 바이트를 바이트 단위 NMEA 파서에
+ * 넣습니다 (UBX 파서에도 같은 바이트를 넣어 두 프로토콜을 나눕니다).
+ * 데이터가 없을 때는 이벤트 대기로 블록되므로 다른 태스크에 영향이 없고,
+ * GPS 구조체는 그 태스크만 소유합니다. 다른 태스크에는 고정을 스냅샷으로 넘깁니다.
+ * 
+ * u-blox 수신기는 gps_sensor_configure_ubx()로 높은 보드레이트, 5~10Hz NAV-PVT 출력으로
+ * 설정할 수 있습니다. NAV-PVT는 문자열 변환 없이 정수 필드를 바로 읽고 속도/이동 방향과
+ * 정확도 추정도 함께 줍니다. NAV-PVT가 끊기면 NMEA로 자동 전환하고, 설정 후 아무 데이터도
+ * 오지 않으면 (u-blox가 아니거나 설정 거부) 원래 보드레이트로 돌아갑니다.
  * 
  * 지원 기능:
- * - NMEA 문장 파싱 (GPGGA, GPRMC)
+ * - NMEA 문장 파싱 (GGA, RMC, 모든 토커 ID: $GP/$GN/$GL..., 체크섬 검증)
+ * - UBX NAV-PVT 파싱과 u-blox 수신기 설정 (u-blox 8 CFG-PRT/RATE/MSG, 9 이상 CFG-VALSET)
  * - 위도/경도 좌표 변환
  * - GPS Fix 상태 확인
  * - 위성 개수 모니터링
@@ -32,12 +44,22 @@ typedef int gpio_num_t;
 #define ESP_FAIL -1
 #endif
 
+#include "nmea_parser.h"
+#include "ubx_parser.h"
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define GPS_RX_BUFFER_SIZE      4096    ///< UART RX 링 버퍼 크기 (바이트, 115200bps에서 약 0.35초)
+#define GPS_EVENT_QUEUE_SIZE    16      ///< UART 이벤트 큐 길이
+#define GPS_READ_CHUNK_SIZE     128     ///< 한 번에 링 버퍼에서 꺼내 파싱하는 바이트 수
+#define GPS_NMEA_FALLBACK_GGA   3       ///< NAV-PVT 없이 GGA가 이만큼 연속되면 NMEA로 전환
+#define GPS_UBX_SWITCH_DELAY_MS 100     ///< 보드레이트 변경 명령 후 수신기가 전환할 때까지 대기 (ms)
+
 /**
  * @defgroup GPS_SENSOR_STRUCTS GPS 센서 데이터 구조체
  * @brief GPS 센서 데이터 및 설정을 위한 구조체 정의
@@ -55,6 +77,10 @@ typedef struct {
     double longitude;   ///< 경도 (도 단위, WGS84 좌표계)
     float altitude;     ///< 고도 (미터 단위, 해수면 기준)
     int satellites;     ///< 사용 중인 위성 개수
+    float accuracy;     ///< 수평 정확도 추정 (미터, 0: 모름 - NMEA)
+    float speed;        ///< 지면 속도 (m/s, UBX)
+    float course;       ///< 이동 방향 (도 단위, 북쪽에서 시계 방향, UBX)
+    bool has_velocity;  ///< speed/course 유효 (UBX 고정)
     bool fix_valid;     ///< GPS Fix 유효성 (true: 유효한 위치)
     bool initialized;   ///< 센서 초기화 상태
 } gps_data_t;
@@ -68,6 +94,13 @@ typedef struct {
 typedef struct {
     uart_port_t uart_port; ///< UART 포트 번호
     gps_data_t data;       ///< GPS 위치 데이터
+    nmea_parser_t parser;  ///< NMEA 스트림 파서
+    ubx_parser_t ubx;      ///< UBX 스트림 파서
+    uint8_t nmea_since_pvt; ///< 마지막 NAV-PVT 이후 GGA 수 (GPS_NMEA_FALLBACK_GGA 이상이면 NMEA 사용)
+    int base_baudrate;     ///< 초기화 보드레이트 (UBX 설정 실패 시 복귀)
+    int baudrate;          ///< 현재 보드레이트
+    uint32_t probe_count;  ///< UBX 설정 시점의 수신 문장+프레임 수
+    uint32_t rx_overflows; ///< UART 수신 버퍼가 넘쳐 데이터를 잃은 횟수
 } gps_sensor_t;
 
 /** @} */ // GPS_SENSOR_STRUCTS
@@ -97,16 +130,64 @@ esp_err_t gps_sensor_init(gps_sensor_t* gps, uart_port_t port, gpio_num_t tx_pin
 /**
  * @brief GPS 데이터 업데이트
  * 
- * UART에서 NMEA 문장을 읽어와 파싱하여 위치 데이터를 업데이트합니다.
+ * UART 수신 이벤트를 최대 timeout_ms 동안 기다렸다가 RX 링 버퍼에 쌓인 바이트를
+ * 모두 파서에 넣습니다. 이벤트를 기다리는 동안 호출 태스크는 블록되므로
+ * GPS 전용 태스크에서만 호출합니다.
+ * 
+ * @param gps GPS 센서 구조체 포인터
+ * @param timeout_ms 수신 이벤트 대기 타임아웃 (밀리초)
+ * @return bool 위치 데이터(고정 여부 포함)가 바뀌었으면 true
+ */
+bool gps_sensor_update(gps_sensor_t* gps, uint32_t timeout_ms);
+
+/**
+ * @brief 수신 바이트를 파서에 입력
+ * 
+ * 체크섬이 맞는 NAV-PVT 프레임은 위치/속도/정확도를 반영합니다. NAV-PVT가 끊긴 동안에는
+ * GGA 문장이 위치/고도/위성 수를, RMC 문장이 수신 상태를 반영합니다.
+ * 
+ * @param gps GPS 센서 구조체 포인터
+ * @param data 수신 데이터
+ * @param length 수신 데이터 길이
+ * @return bool 위치 데이터(고정 여부 포함)가 바뀌었으면 true
+ */
+bool gps_sensor_feed(gps_sensor_t* gps, const uint8_t* data, size_t length);
+
+/**
+ * @brief u-blox 수신기를 UBX NAV-PVT 출력으로 설정
+ * 
+ * 현재 보드레이트에서 u-blox 9 이상용 CFG-VALSET과 u-blox 8 이하용 CFG-PRT로
+ * 측정 주기, NAV-PVT 출력, 보드레이트를 바꾼 뒤 (지원하지 않는 쪽은 무시됨)
+ * 이쪽 UART도 새 보드레이트로 바꾸고 CFG-RATE/CFG-MSG를 다시 보냅니다.
+ * NMEA 출력은 그대로 두므로 UBX가 없는 수신기에서도 NMEA로 계속 동작합니다.
+ * 잠시 뒤 gps_sensor_confirm_baudrate()로 새 보드레이트에서 데이터가 오는지 확인합니다.
  * 
  * @param gps GPS 센서 구조체 포인터
+ * @param baudrate 새 보드레이트 (bps)
+ * @param rate_hz 측정 주기 (Hz, 1~10)
  * @return esp_err_t 
- *         - ESP_OK: 업데이트 성공
- *         - ESP_FAIL: 업데이트 실패 (통신 오류 또는 파싱 실패)
+ *         - ESP_OK: 설정 명령 전송 완료
+ *         - ESP_FAIL: 센서가 초기화되지 않았거나 전송 실패
+ */
+esp_err_t gps_sensor_configure_ubx(gps_sensor_t* gps, int baudrate, int rate_hz);
+
+/**
+ * @brief UBX 설정 후 새 보드레이트 확인
  * 
- * @note 1Hz 주기로 호출하는 것을 권장합니다.
+ * 설정 이후 검증된 NMEA 문장이나 UBX 프레임이 하나도 없으면 수신기가 설정을
+ * 받지 않은 것으로 보고 이쪽 UART를 초기화 보드레이트로 되돌립니다.
+ * 
+ * @param gps GPS 센서 구조체 포인터
+ * @return bool 새 보드레이트를 유지하면 true, 되돌렸으면 false
+ */
+bool gps_sensor_confirm_baudrate(gps_sensor_t* gps);
+
+/**
+ * @brief 현재 위치 소스가 UBX NAV-PVT인지 확인
+ * @param gps GPS 센서 구조체 포인터
+ * @return bool NAV-PVT 사용 중이면 true, NMEA이면 false
  */
-esp_err_t gps_sensor_update(gps_sensor_t* gps);
+bool gps_sensor_is_ubx(gps_sensor_t* gps);
 
 /**
  * @brief 위도 읽기
@@ -0,0 +1,122 @@
+/**
+ * @file imu_calibration.c
+ * @brief IMU 자이로/가속도 오프셋 부팅 보정 및 실행 중 자이로 바이어스 추적 구현
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "imu_calibration.h"
+#include <math.h>
+#include <string.h>
+
+void imu_calibration_init(imu_calibration_t* cal, const imu_calibration_config_t* config) {
+    memset(cal, 0, sizeof(*cal));
+    cal->config = *config;
+}
+
+void imu_calibration_start(imu_calibration_t* cal, bool calibrate_accel) {
+    cal->calibrate_accel = calibrate_accel;
+    cal->count = 0;
+    cal->restarts = 0;
+    for (int i = 0; i < 3; i++) {
+        cal->gyro_sum[i] = 0.0f;
+        cal->accel_sum[i] = 0.0f;
+    }
+}
+
+/**
+ * @brief 수집 구간을 비우고 이 샘플로 새로 시작
+ */
+static void restart_with(imu_calibration_t* cal, const float gyro[3], const float accel[3]) {
+    cal->count = 1;
+    for (int i = 0; i < 3; i++) {
+        cal->gyro_sum[i] = gyro[i];
+        cal->accel_sum[i] = accel[i];
+    }
+}
+
+imu_calib_status_t imu_calibration_add(imu_calibration_t* cal, const imu_sample_t* sample) {
+    const float gyro[3] = { sample->gyro_x, sample->gyro_y, sample->gyro_z };
+    const float accel[3] = { sample->accel_x, sample->accel_y, sample->accel_z };
+
+    if (cal->count == 0) {
+        restart_with(cal, gyro, accel);
+    } else {
+        // Compare against the mean so far: slow drift is bias, a jump is someone touching the robot
+        float n = (float)cal->count;
+        for (int i = 0; i < 3; i++) {
+            if (fabsf(gyro[i] - cal->gyro_sum[i] / n) > cal->config.gyro_motion_dps ||
+                fabsf(accel[i] - cal->accel_sum[i] / n) > cal->config.accel_motion_g) {
+                cal->restarts++;
+                restart_with(cal, gyro, accel);
+                return IMU_CALIB_RESTARTED;
+            }
+        }
+        cal->count++;
+        for (int i = 0; i < 3; i++) {
+            cal->gyro_sum[i] += gyro[i];
+            cal->accel_sum[i] += accel[i];
+        }
+    }
+    return (cal->count >= cal->config.target_samples) ? IMU_CALIB_DONE : IMU_CALIB_COLLECTING;
+}
+
+bool imu_calibration_apply(const imu_calibration_t* cal, imu_offsets_t* offsets) {
+    if (cal->count == 0) {
+        return false;
+    }
+
+    float n = (float)cal->count;
+    for (int i = 0; i < 3; i++) {
+        offsets->gyro[i] += cal->gyro_sum[i] / n;
+    }
+
+    if (!cal->calibrate_accel) {
+        return false;
+    }
+    float mean[3] = { cal->accel_sum[0] / n, cal->accel_sum[1] / n, cal->accel_sum[2] / n };
+    if (fabsf(mean[0]) > cal->config.level_tolerance_g || fabsf(mean[1]) > cal->config.level_tolerance_g ||
+        mean[2] < 0.5f) {
+        return false;
+    }
+    offsets->accel[0] += mean[0];
+    offsets->accel[1] += mean[1];
+    offsets->accel[2] += mean[2] - 1.0f;
+    return true;
+}
+
+bool imu_calibration_track(imu_calibration_t* cal, const imu_sample_t* sample, float dt, imu_offsets_t* offsets) {
+    const float gyro[3] = { sample->gyro_x, sample->gyro_y, sample->gyro_z };
+    float accel_norm = sqrtf(sample->accel_x * sample->accel_x + sample->accel_y * sample->accel_y +
+                             sample->accel_z * sample->accel_z);
+
+    bool quiet = fabsf(accel_norm - 1.0f) < cal->config.accel_motion_g;
+    for (int i = 0; i < 3 && quiet; i++) {
+        quiet = fabsf(gyro[i]) < cal->config.quiet_dps;
+    }
+    if (!quiet) {
+        cal->quiet_time_s = 0.0f;
+        return false;
+    }
+    if (cal->quiet_time_s < cal->config.quiet_hold_s) {
+        cal->quiet_time_s += dt;
+        return false;
+    }
+
+    // First-order tracking: the residual decays with the configured time constant
+    float k = dt / cal->config.track_tau_s;
+    if (k > 1.0f) {
+        k = 1.0f;
+    }
+    for (int i = 0; i < 3; i++) {
+        offsets->gyro[i] += k * gyro[i];
+    }
+    cal->track_updates++;
+    return true;
+}
+
+void imu_calibration_track_reset(imu_calibration_t* cal) {
+    cal->quiet_time_s = 0.0f;
+}
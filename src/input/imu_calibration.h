@@ -0,0 +1,139 @@
+/**
+ * @file imu_calibration.h
+ * @brief IMU 자이로/가속도 오프셋 부팅 보정 및 실행 중 자이로 바이어스 추적
+ *
+ * 부팅 보정은 정지 상태 샘플을 모아 평균으로 6축 오프셋을 추정합니다.
+ * 샘플이 지금까지의 평균에서 임계값 이상 벗어나면 움직임으로 보고 처음부터
+ * 다시 모읍니다. 입력 샘플은 현재 오프셋을 이미 뺀 값이므로 결과는 현재
+ * 오프셋에 더할 잔차이며, 저장된 오프셋이 있으면 그 위에서 미세 조정됩니다.
+ *
+ * 가속도 오프셋은 기준 자세(Z축 위, 수평)를 알아야 구할 수 있으므로 요청한
+ * 경우에만, 그리고 평균 중력이 수평 허용 범위 안일 때만 추정합니다. 그렇지
+ * 않으면 받침대에 기댄 자세가 피치 0으로 굳어 버립니다.
+ *
+ * 실행 중 추적은 자이로와 가속도가 일정 시간 조용하면 자이로 잔차를 긴
+ * 시정수로 오프셋에 반영하여 온도에 따른 바이어스 변화를 따라갑니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef IMU_CALIBRATION_H
+#define IMU_CALIBRATION_H
+
+#include "imu_sensor.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 부팅 보정 샘플 처리 결과
+ */
+typedef enum {
+    IMU_CALIB_COLLECTING = 0,   ///< 샘플 수집 중
+    IMU_CALIB_RESTARTED,        ///< 움직임 감지, 이 샘플부터 다시 수집
+    IMU_CALIB_DONE,             ///< 목표 샘플 수 도달
+} imu_calib_status_t;
+
+/**
+ * @struct imu_calibration_config_t
+ * @brief 보정 설정
+ */
+typedef struct {
+    uint32_t target_samples;    ///< 부팅 보정 평균 샘플 수
+    float gyro_motion_dps;      ///< 평균에서 이만큼 벗어난 자이로 샘플은 움직임 (deg/s)
+    float accel_motion_g;       ///< 평균에서 이만큼 벗어난 가속도 샘플은 움직임 (g)
+    float level_tolerance_g;    ///< 가속도 보정을 허용하는 평균 X/Y 중력 성분 한계 (g)
+    float quiet_dps;            ///< 실행 중 추적: 잔차 자이로가 이보다 작아야 정지 (deg/s)
+    float quiet_hold_s;         ///< 실행 중 추적: 정지가 이만큼 이어진 뒤부터 반영 (s)
+    float track_tau_s;          ///< 실행 중 추적: 바이어스 반영 시정수 (s)
+} imu_calibration_config_t;
+
+/**
+ * @struct imu_calibration_t
+ * @brief 보정 상태
+ */
+typedef struct {
+    imu_calibration_config_t config;    ///< 설정
+    bool calibrate_accel;               ///< 이번 부팅 보정에서 가속도 오프셋도 추정
+    uint32_t count;                     ///< 현재 수집 구간의 샘플 수
+    float gyro_sum[3];                  ///< 현재 수집 구간의 자이로 합 (deg/s)
+    float accel_sum[3];                 ///< 현재 수집 구간의 가속도 합 (g)
+    uint32_t restarts;                  ///< 움직임으로 다시 시작한 횟수
+    float quiet_time_s;                 ///< 실행 중 추적: 연속 정지 시간 (s)
+    uint32_t track_updates;             ///< 실행 중 추적: 오프셋에 반영한 샘플 수
+} imu_calibration_t;
+
+/**
+ * @defgroup IMU_CALIBRATION_API IMU 보정 API
+ * @brief 부팅 보정과 실행 중 바이어스 추적 함수들
+ * @{
+ */
+
+/**
+ * @brief 보정 상태 초기화
+ * @param cal 보정 상태
+ * @param config 설정
+ */
+void imu_calibration_init(imu_calibration_t* cal, const imu_calibration_config_t* config);
+
+/**
+ * @brief 부팅 보정 시작 (수집 구간 초기화)
+ * @param cal 보정 상태
+ * @param calibrate_accel 가속도 오프셋도 추정할지 여부 (보드가 수평일 때만)
+ */
+void imu_calibration_start(imu_calibration_t* cal, bool calibrate_accel);
+
+/**
+ * @brief 부팅 보정 샘플 추가
+ * @param cal 보정 상태
+ * @param sample 현재 오프셋을 뺀 샘플
+ * @return imu_calib_status_t 수집 상태
+ */
+imu_calib_status_t imu_calibration_add(imu_calibration_t* cal, const imu_sample_t* sample);
+
+/**
+ * @brief 부팅 보정 결과를 오프셋에 반영 (IMU_CALIB_DONE 이후)
+ *
+ * 자이로 오프셋에는 평균 잔차를 더합니다. 가속도는 보정을 요청했고 평균
+ * 중력이 수평 허용 범위 안일 때만 (0, 0, 1g) 기준으로 반영합니다.
+ *
+ * @param cal 보정 상태
+ * @param offsets 갱신할 오프셋 (수집 중 센서에 적용된 값)
+ * @return bool 가속도 오프셋까지 반영했으면 true
+ */
+bool imu_calibration_apply(const imu_calibration_t* cal, imu_offsets_t* offsets);
+
+/**
+ * @brief 실행 중 자이로 바이어스 추적 (호출자가 로봇이 정지해 있을 수 있는 상태에서만 호출)
+ *
+ * 자이로 잔차가 quiet_dps 미만이고 가속도 크기가 1g ± accel_motion_g인 샘플이
+ * quiet_hold_s 동안 이어지면, 이후 샘플마다 잔차를 dt / track_tau_s 비율로
+ * 자이로 오프셋에 더합니다. 조용하지 않은 샘플이 오면 대기 시간을 다시 셉니다.
+ *
+ * @param cal 보정 상태
+ * @param sample 현재 오프셋을 뺀 샘플
+ * @param dt 샘플 간격 (초)
+ * @param offsets 갱신할 오프셋
+ * @return bool 이번 샘플로 오프셋을 바꿨으면 true
+ */
+bool imu_calibration_track(imu_calibration_t* cal, const imu_sample_t* sample, float dt, imu_offsets_t* offsets);
+
+/**
+ * @brief 실행 중 추적 정지 시간 초기화 (밸런싱 시작 등 추적을 멈출 때)
+ * @param cal 보정 상태
+ */
+void imu_calibration_track_reset(imu_calibration_t* cal);
+
+/** @} */ // IMU_CALIBRATION_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IMU_CALIBRATION_H
@@ -0,0 +1,147 @@
+/**
+ * @file imu_drdy.c
+ * @brief MPU6050 데이터 레디 인터럽트 기반 제어 주기 트리거 구현
+ *
+ * ISR은 타임스탬프 기록과 태스크 알림만 수행하고, I2C 읽기는
+ * 알림을 받은 제어 태스크가 수행합니다. ISR은 IRAM에 두어
+ * 플래시 캐시가 비활성화된 동안에도 지연 없이 실행됩니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "imu_drdy.h"
+#ifndef NATIVE_BUILD
+#include "esp_log.h"
+#include "esp_timer.h"
+#endif
+
+#ifndef NATIVE_BUILD
+static const char* DRDY_TAG = "IMU_DRDY"; ///< ESP-IDF 로깅 태그
+
+#define DRDY_ENTER_ISR(d)   portENTER_CRITICAL_ISR(&(d)->lock)
+#define DRDY_EXIT_ISR(d)    portEXIT_CRITICAL_ISR(&(d)->lock)
+#define DRDY_ENTER(d)       portENTER_CRITICAL(&(d)->lock)
+#define DRDY_EXIT(d)        portEXIT_CRITICAL(&(d)->lock)
+#else
+#define DRDY_ENTER_ISR(d)   (void)(d)
+#define DRDY_EXIT_ISR(d)    (void)(d)
+#define DRDY_ENTER(d)       (void)(d)
+#define DRDY_EXIT(d)        (void)(d)
+#endif
+
+void imu_drdy_init(imu_drdy_t* drdy, gpio_num_t int_pin, uint16_t decimation) {
+    drdy->int_pin = int_pin;
+    drdy->decimation = (decimation == 0) ? 1 : decimation;
+    drdy->sample_count = 0;
+    drdy->ready_seq = 0;
+    drdy->ready_sample_us = 0;
+    drdy->consumed_seq = 0;
+    drdy->dropped_cycles = 0;
+    drdy->timeout_count = 0;
+#ifndef NATIVE_BUILD
+    drdy->notify_task = NULL;
+    portMUX_INITIALIZE(&drdy->lock);
+#endif
+}
+
+/**
+ * @brief 데이터 레디 펄스 처리 구현
+ *
+ * 분주 카운터가 한 바퀴 돌 때만 주기를 완료하므로, FIFO 모드에서는
+ * 태스크가 깨어날 때 FIFO에 정확히 decimation개의 샘플이 쌓여 있습니다.
+ */
+bool IRAM_ATTR imu_drdy_on_sample(imu_drdy_t* drdy, int64_t now_us) {
+    uint32_t count = drdy->sample_count + 1;
+    drdy->sample_count = count;
+    if ((count % drdy->decimation) != 0) {
+        return false;
+    }
+
+    DRDY_ENTER_ISR(drdy);
+    drdy->ready_sample_us = now_us;
+    drdy->ready_seq++;
+    DRDY_EXIT_ISR(drdy);
+    return true;
+}
+
+uint32_t imu_drdy_consume(imu_drdy_t* drdy, int64_t* sample_us) {
+    DRDY_ENTER(drdy);
+    uint32_t seq = drdy->ready_seq;
+    int64_t stamp = drdy->ready_sample_us;
+    DRDY_EXIT(drdy);
+
+    uint32_t pending = seq - drdy->consumed_seq;
+    if (pending == 0) {
+        return 0;
+    }
+    drdy->consumed_seq = seq;
+    drdy->dropped_cycles += pending - 1;
+    *sample_us = stamp;
+    return pending;
+}
+
+#ifndef NATIVE_BUILD
+/**
+ * @brief INT 핀 GPIO ISR
+ * @param arg imu_drdy_t 포인터
+ */
+static void IRAM_ATTR imu_drdy_isr_handler(void* arg) {
+    imu_drdy_t* drdy = (imu_drdy_t*)arg;
+    if (imu_drdy_on_sample(drdy, esp_timer_get_time()) && drdy->notify_task != NULL) {
+        BaseType_t higher_priority_woken = pdFALSE;
+        vTaskNotifyGiveFromISR(drdy->notify_task, &higher_priority_woken);
+        if (higher_priority_woken) {
+            portYIELD_FROM_ISR();
+        }
+    }
+}
+
+/**
+ * @brief INT 핀 인터럽트 등록 구현
+ *
+ * MPU6050 INT는 액티브 하이 50us 펄스로 설정되므로 상승 에지에서 트리거합니다.
+ * GPIO ISR 서비스는 엔코더와 공유하므로 이미 설치된 경우를 허용합니다.
+ */
+esp_err_t imu_drdy_start(imu_drdy_t* drdy) {
+    drdy->notify_task = xTaskGetCurrentTaskHandle();
+
+    gpio_config_t int_config = {
+        .pin_bit_mask = (1ULL << drdy->int_pin),
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_DISABLE,
+        .pull_down_en = GPIO_PULLDOWN_ENABLE,
+        .intr_type = GPIO_INTR_POSEDGE,
+    };
+    esp_err_t ret = gpio_config(&int_config);
+    if (ret != ESP_OK) {
+        ESP_LOGE(DRDY_TAG, "Failed to configure IMU INT GPIO");
+        return ret;
+    }
+
+    ret = gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(DRDY_TAG, "Failed to install ISR service");
+        return ret;
+    }
+
+    ret = gpio_isr_handler_add(drdy->int_pin, imu_drdy_isr_handler, drdy);
+    if (ret != ESP_OK) {
+        ESP_LOGE(DRDY_TAG, "Failed to add IMU INT ISR handler");
+        return ret;
+    }
+
+    ESP_LOGI(DRDY_TAG, "IMU data-ready trigger on GPIO %d (every %u samples)",
+             drdy->int_pin, drdy->decimation);
+    return ESP_OK;
+}
+
+bool imu_drdy_wait(imu_drdy_t* drdy, TickType_t timeout, int64_t* sample_us) {
+    if (ulTaskNotifyTake(pdTRUE, timeout) > 0 && imu_drdy_consume(drdy, sample_us) > 0) {
+        return true;
+    }
+    drdy->timeout_count++;
+    return false;
+}
+#endif
@@ -0,0 +1,134 @@
+/**
+ * @file imu_drdy.h
+ * @brief MPU6050 데이터 레디 인터럽트 기반 제어 주기 트리거
+ *
+ * MPU6050 INT 핀의 데이터 레디 펄스를 GPIO 인터럽트로 받아
+ * 정해진 샘플 수마다 제어 태스크를 깨웁니다.
+ * 타임스탬프는 ISR 진입 시각으로 기록되므로 I2C 전송 지연이나
+ * 태스크 스케줄링 지연과 무관하게 샘플 시각이 정확합니다.
+ *
+ * 주요 기능:
+ * - INT 핀 상승 에지 ISR 및 태스크 알림
+ * - 샘플 레이트 → 제어 주기 분주 (FIFO 모드에서 한 번에 여러 샘플)
+ * - 주기별 샘플 타임스탬프 제공
+ * - 놓친 주기 / 타임아웃 통계
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef IMU_DRDY_H
+#define IMU_DRDY_H
+
+#ifndef NATIVE_BUILD
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_err.h"
+#else
+typedef int esp_err_t;
+typedef int gpio_num_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define IRAM_ATTR
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct imu_drdy_t
+ * @brief 데이터 레디 트리거 상태 구조체
+ *
+ * ready_* 필드는 ISR이 쓰고 제어 태스크가 읽습니다.
+ */
+typedef struct {
+    gpio_num_t int_pin;                 ///< MPU6050 INT 핀
+    uint16_t decimation;                ///< 제어 주기당 샘플 수
+    volatile uint32_t sample_count;     ///< ISR이 받은 데이터 레디 펄스 수
+    volatile uint32_t ready_seq;        ///< 완료된 주기 수 (ISR 갱신)
+    volatile int64_t ready_sample_us;   ///< 마지막 완료 주기의 샘플 시각 (us, ISR 갱신)
+    uint32_t consumed_seq;              ///< 제어 태스크가 처리한 주기 수
+    uint32_t dropped_cycles;            ///< 제어 태스크가 늦어 건너뛴 주기 수
+    uint32_t timeout_count;             ///< 데이터 레디가 오지 않아 시간 기준으로 진행한 횟수
+#ifndef NATIVE_BUILD
+    TaskHandle_t notify_task;           ///< 깨울 제어 태스크
+    portMUX_TYPE lock;                  ///< ISR/태스크 간 타임스탬프 보호
+#endif
+} imu_drdy_t;
+
+/**
+ * @defgroup IMU_DRDY_API 데이터 레디 트리거 API
+ * @{
+ */
+
+/**
+ * @brief 데이터 레디 트리거 초기화
+ *
+ * @param drdy 트리거 구조체 포인터
+ * @param int_pin MPU6050 INT 핀
+ * @param decimation 제어 주기당 샘플 수 (샘플 레이트 / 제어 주파수, 최소 1)
+ */
+void imu_drdy_init(imu_drdy_t* drdy, gpio_num_t int_pin, uint16_t decimation);
+
+/**
+ * @brief INT 핀 인터럽트 등록 및 알림 대상 태스크 지정
+ *
+ * 제어 태스크 안에서 호출하며, 센서 측 데이터 레디 출력은
+ * imu_sensor_enable_data_ready()로 먼저 켜 두어야 합니다.
+ *
+ * @param drdy 트리거 구조체 포인터
+ * @return esp_err_t ESP_OK 성공, 그 외 GPIO 설정 오류
+ */
+esp_err_t imu_drdy_start(imu_drdy_t* drdy);
+
+/**
+ * @brief 데이터 레디 펄스 처리 (ISR 본체)
+ *
+ * decimation번째 펄스마다 주기를 완료하고 타임스탬프를 기록합니다.
+ *
+ * @param drdy 트리거 구조체 포인터
+ * @param now_us 펄스 수신 시각 (us)
+ * @return bool 제어 태스크를 깨워야 하면 true
+ */
+bool imu_drdy_on_sample(imu_drdy_t* drdy, int64_t now_us);
+
+/**
+ * @brief 완료된 주기 가져오기 (논블로킹)
+ *
+ * 마지막으로 처리한 이후 완료된 주기가 있으면 가장 최근 주기의 샘플 시각을 반환합니다.
+ * 둘 이상 쌓였다면 제어 태스크가 늦은 것이므로 건너뛴 수를 dropped_cycles에 더합니다.
+ *
+ * @param drdy 트리거 구조체 포인터
+ * @param sample_us 출력: 주기 마지막 샘플 시각 (us)
+ * @return uint32_t 새로 완료된 주기 수 (0: 없음)
+ */
+uint32_t imu_drdy_consume(imu_drdy_t* drdy, int64_t* sample_us);
+
+#ifndef NATIVE_BUILD
+/**
+ * @brief 다음 주기 완료까지 대기
+ *
+ * 타임아웃 시(INT 배선 불량, 센서 정지 등) timeout_count를 올리고 false를 반환하므로
+ * 호출자는 시간 기준으로 주기를 계속 진행해 안전 처리를 수행해야 합니다.
+ *
+ * @param drdy 트리거 구조체 포인터
+ * @param timeout 최대 대기 시간 (틱)
+ * @param sample_us 출력: 주기 마지막 샘플 시각 (us)
+ * @return bool 데이터 레디로 깨어났으면 true
+ */
+bool imu_drdy_wait(imu_drdy_t* drdy, TickType_t timeout, int64_t* sample_us);
+#endif
+
+/** @} */ // IMU_DRDY_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IMU_DRDY_H
@@ -17,6 +17,10 @@
 #endif
 #include <math.h>
 
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
 #ifndef NATIVE_BUILD
 static const char* IMU_TAG = "IMU_SENSOR"; ///< ESP-IDF 로깅 태그
 #else
@@ -31,12 +35,62 @@ static const char* IMU_TAG = "IMU_SENSOR"; ///< ESP-IDF 로깅 태그
 #define MPU6050_ADDR            0x68  ///< MPU6050 I2C 디바이스 주소
 #define MPU6050_WHO_AM_I        0x75  ///< 디바이스 ID 레지스터
 #define MPU6050_PWR_MGMT_1      0x6B  ///< 전원 관리 레지스터 1
+#define MPU6050_SMPLRT_DIV      0x19  ///< 샘플 레이트 분주 레지스터
+#define MPU6050_CONFIG          0x1A  ///< DLPF 설정 레지스터
 #define MPU6050_GYRO_CONFIG     0x1B  ///< 자이로스코프 설정 레지스터
 #define MPU6050_ACCEL_CONFIG    0x1C  ///< 가속도계 설정 레지스터
 #define MPU6050_ACCEL_XOUT_H    0x3B  ///< 가속도계 X축 상위 바이트
 #define MPU6050_GYRO_XOUT_H     0x43  ///< 자이로스코프 X축 상위 바이트
+#define MPU6050_FIFO_EN         0x23  ///< FIFO 데이터 선택 레지스터
+#define MPU6050_INT_PIN_CFG     0x37  ///< INT 핀 동작 설정 레지스터
+#define MPU6050_INT_ENABLE      0x38  ///< 인터럽트 활성화 레지스터
+#define MPU6050_USER_CTRL       0x6A  ///< 사용자 제어 레지스터 (FIFO 활성화/리셋)
+#define MPU6050_FIFO_COUNTH     0x72  ///< FIFO 바이트 수 상위 바이트
+#define MPU6050_FIFO_R_W        0x74  ///< FIFO 데이터 레지스터
+/** @} */
+
+/**
+ * @defgroup MPU6050_FIFO_BITS MPU6050 FIFO 설정 비트
+ * @{
+ */
+#define MPU6050_FIFO_EN_GYRO_ACCEL  0x78  ///< XG, YG, ZG, ACCEL 샘플을 FIFO에 기록 (온도 제외)
+#define MPU6050_USER_CTRL_FIFO_EN   0x40  ///< FIFO 동작 활성화
+#define MPU6050_USER_CTRL_FIFO_RST  0x04  ///< FIFO 리셋
+#define MPU6050_FIFO_SIZE           1024  ///< FIFO 용량 (bytes)
+#define MPU6050_INT_PIN_PULSE       0x00  ///< 액티브 하이, 푸시풀, 50us 펄스 (래치 없음)
+#define MPU6050_INT_DATA_RDY_EN     0x01  ///< 데이터 레디 인터럽트 활성화
 /** @} */
 
+#define IMU_I2C_TIMEOUT_MS  10  ///< 주기 경로 전송 타임아웃 (최대 FIFO 버스트 384바이트 ≈ 9ms @400kHz)
+
+/**
+ * @brief 빅엔디안 가속도/자이로 원시 데이터를 오프셋을 뺀 물리 단위 샘플로 변환
+ * @param accel 가속도 X/Y/Z 6바이트
+ * @param gyro 자이로 X/Y/Z 6바이트
+ * @param offsets 축별 오프셋
+ * @param out 출력 샘플
+ */
+static void convert_raw_sample(const uint8_t* accel, const uint8_t* gyro, const imu_offsets_t* offsets,
+                               imu_sample_t* out) {
+    int16_t accel_x = (int16_t)((accel[0] << 8) | accel[1]);
+    int16_t accel_y = (int16_t)((accel[2] << 8) | accel[3]);
+    int16_t accel_z = (int16_t)((accel[4] << 8) | accel[5]);
+
+    int16_t gyro_x = (int16_t)((gyro[0] << 8) | gyro[1]);
+    int16_t gyro_y = (int16_t)((gyro[2] << 8) | gyro[3]);
+    int16_t gyro_z = (int16_t)((gyro[4] << 8) | gyro[5]);
+
+    out->accel_x = accel_x / 16384.0f - offsets->accel[0];  // ±2g range
+    out->accel_y = accel_y / 16384.0f - offsets->accel[1];
+    out->accel_z = accel_z / 16384.0f - offsets->accel[2];
+
+    out->gyro_x = gyro_x / 131.0f - offsets->gyro[0];       // ±250°/s range
+    out->gyro_y = gyro_y / 131.0f - offsets->gyro[1];
+    out->gyro_z = gyro_z / 131.0f - offsets->gyro[2];
+
+    out->pitch = atan2f(-out->accel_x, sqrtf(out->accel_y * out->accel_y + out->accel_z * out->accel_z)) * 180.0f / (float)M_PI;
+}
+
 /**
  * @brief MPU6050 IMU 센서를 초기화하고 I2C 통신 설정
  * 
@@ -63,6 +117,13 @@ esp_err_t imu_sensor_init(imu_sensor_t* sensor, i2c_port_t port, gpio_num_t sda_
     sensor->data.gyro_x = sensor->data.gyro_y = sensor->data.gyro_z = 0.0f;
     sensor->data.pitch = sensor->data.roll = 0.0f;
     sensor->data.initialized = false;
+    for (int i = 0; i < 3; i++) {
+        sensor->offsets.gyro[i] = 0.0f;
+        sensor->offsets.accel[i] = 0.0f;
+    }
+    sensor->sample_rate_hz = 0;
+    sensor->fifo_enabled = false;
+    sensor->fifo_overflow_count = 0;
 
     // Initialize I2C driver
     esp_err_t ret = i2c_driver_init(port, sda_pin, scl_pin);
@@ -70,6 +131,13 @@ esp_err_t imu_sensor_init(imu_sensor_t* sensor, i2c_port_t port, gpio_num_t sda_
         return ret;
     }
 
+    // Build the per-cycle register read once; executing it allocates nothing
+    ret = i2c_transaction_init_read(&sensor->raw_txn, port, MPU6050_ADDR, MPU6050_ACCEL_XOUT_H,
+                                    sensor->raw_buf, sizeof(sensor->raw_buf), IMU_I2C_TIMEOUT_MS);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
     // Check WHO_AM_I register
     uint8_t who_am_i;
     ret = i2c_read_register(port, MPU6050_ADDR, MPU6050_WHO_AM_I, &who_am_i, 1);
@@ -84,32 +152,240 @@ esp_err_t imu_sensor_init(imu_sensor_t* sensor, i2c_port_t port, gpio_num_t sda_
         return ESP_FAIL;
     }
 
-    // Wake up MPU6050
-    ret = i2c_write_register(port, MPU6050_ADDR, MPU6050_PWR_MGMT_1, 0x00);
+    const i2c_reg_write_t init_sequence[] = {
+        { MPU6050_PWR_MGMT_1,   0x00 },  // Wake up MPU6050
+        { MPU6050_GYRO_CONFIG,  0x00 },  // Configure gyroscope (±250 degrees/s)
+        { MPU6050_ACCEL_CONFIG, 0x00 },  // Configure accelerometer (±2g)
+    };
+    ret = i2c_write_registers(port, MPU6050_ADDR, init_sequence, 3);
     if (ret != ESP_OK) {
         return ret;
     }
 
-    // Configure gyroscope (±250 degrees/s)
-    ret = i2c_write_register(port, MPU6050_ADDR, MPU6050_GYRO_CONFIG, 0x00);
+    sensor->data.initialized = true;
+
+#ifndef NATIVE_BUILD
+    ESP_LOGI(IMU_TAG, "IMU sensor initialized successfully");
+#endif
+    return ESP_OK;
+}
+
+/**
+ * @brief 출력 데이터 레이트와 DLPF 대역폭을 제어 주기에 맞게 설정
+ * 
+ * DLPF를 켜면 내부 샘플링이 1kHz가 되며, SMPLRT_DIV로 출력 레이트를 나눕니다.
+ * DLPF 대역폭은 출력 레이트의 나이퀴스트 주파수보다 낮은 값 중 가장 넓은 것을
+ * 선택하여 위상 지연을 최소화합니다.
+ * 
+ * | 출력 레이트 | DLPF_CFG | 자이로 대역폭 |
+ * |------------|----------|---------------|
+ * | >= 500Hz   | 1        | 188Hz         |
+ * | >= 200Hz   | 2        | 98Hz          |
+ * | >= 100Hz   | 3        | 42Hz          |
+ * | < 100Hz    | 4        | 20Hz          |
+ * 
+ * @param sensor IMU 센서 구조체 포인터
+ * @param rate_hz 원하는 출력 데이터 레이트 (Hz, 4 ~ 1000)
+ * @return ESP_OK 성공, ESP_FAIL 센서가 초기화되지 않음 또는 I2C 오류
+ */
+esp_err_t imu_sensor_configure_rate(imu_sensor_t* sensor, uint16_t rate_hz) {
+    if (!sensor->data.initialized || rate_hz == 0) {
+        return ESP_FAIL;
+    }
+    if (rate_hz > 1000) {
+        rate_hz = 1000;
+    }
+
+    uint8_t dlpf_cfg;
+    if (rate_hz >= 500) {
+        dlpf_cfg = 1;
+    } else if (rate_hz >= 200) {
+        dlpf_cfg = 2;
+    } else if (rate_hz >= 100) {
+        dlpf_cfg = 3;
+    } else {
+        dlpf_cfg = 4;
+    }
+
+    uint16_t divider = (1000 / rate_hz) - 1;
+    if (divider > 255) {
+        divider = 255;
+    }
+
+    const i2c_reg_write_t rate_sequence[] = {
+        { MPU6050_CONFIG,     dlpf_cfg },
+        { MPU6050_SMPLRT_DIV, (uint8_t)divider },
+    };
+    esp_err_t ret = i2c_write_registers(sensor->i2c_port, MPU6050_ADDR, rate_sequence, 2);
     if (ret != ESP_OK) {
         return ret;
     }
+    sensor->sample_rate_hz = 1000 / (divider + 1);
+
+#ifndef NATIVE_BUILD
+    ESP_LOGI(IMU_TAG, "IMU output rate %u Hz (DLPF_CFG=%u)", (unsigned)(1000 / (divider + 1)), dlpf_cfg);
+#endif
+    return ESP_OK;
+}
+
+/**
+ * @brief 하드웨어 FIFO 모드 활성화
+ * 
+ * FIFO를 리셋한 뒤 가속도/자이로만 기록하도록 선택하고 FIFO를 켭니다.
+ * 온도는 제어에 쓰이지 않으므로 제외하여 프레임을 12바이트로 줄입니다.
+ * 
+ * @param sensor IMU 센서 구조체 포인터
+ * @return ESP_OK 성공, ESP_FAIL 초기화/레이트 설정 전 또는 I2C 오류
+ */
+esp_err_t imu_sensor_enable_fifo(imu_sensor_t* sensor) {
+    if (!sensor->data.initialized || sensor->sample_rate_hz == 0) {
+        return ESP_FAIL;
+    }
 
-    // Configure accelerometer (±2g)
-    ret = i2c_write_register(port, MPU6050_ADDR, MPU6050_ACCEL_CONFIG, 0x00);
+    // Per-cycle FIFO transfers; the data read is resized in place each cycle
+    i2c_port_t port = sensor->i2c_port;
+    sensor->fifo_reset_value = MPU6050_USER_CTRL_FIFO_EN | MPU6050_USER_CTRL_FIFO_RST;
+    esp_err_t ret = i2c_transaction_init_read(&sensor->fifo_count_txn, port, MPU6050_ADDR, MPU6050_FIFO_COUNTH,
+                                              sensor->fifo_count_buf, sizeof(sensor->fifo_count_buf), IMU_I2C_TIMEOUT_MS);
+    if (ret == ESP_OK) {
+        ret = i2c_transaction_init_read(&sensor->fifo_data_txn, port, MPU6050_ADDR, MPU6050_FIFO_R_W,
+                                        sensor->fifo_buf, IMU_FIFO_FRAME_SIZE, IMU_I2C_TIMEOUT_MS);
+    }
+    if (ret == ESP_OK) {
+        ret = i2c_transaction_init_write(&sensor->fifo_reset_txn, port, MPU6050_ADDR, MPU6050_USER_CTRL,
+                                         &sensor->fifo_reset_value, 1, IMU_I2C_TIMEOUT_MS);
+    }
     if (ret != ESP_OK) {
         return ret;
     }
 
-    sensor->data.initialized = true;
+    const i2c_reg_write_t fifo_sequence[] = {
+        { MPU6050_USER_CTRL, MPU6050_USER_CTRL_FIFO_RST },
+        { MPU6050_FIFO_EN,   MPU6050_FIFO_EN_GYRO_ACCEL },
+        { MPU6050_USER_CTRL, MPU6050_USER_CTRL_FIFO_EN },
+    };
+    ret = i2c_write_registers(port, MPU6050_ADDR, fifo_sequence, 3);
+    if (ret != ESP_OK) {
+        return ret;
+    }
 
+    sensor->fifo_enabled = true;
 #ifndef NATIVE_BUILD
-    ESP_LOGI(IMU_TAG, "IMU sensor initialized successfully");
+    ESP_LOGI(IMU_TAG, "IMU FIFO enabled (%u Hz, %d-byte frames)", sensor->sample_rate_hz, IMU_FIFO_FRAME_SIZE);
 #endif
     return ESP_OK;
 }
 
+/**
+ * @brief 데이터 레디 인터럽트 출력 활성화
+ * 
+ * 샘플이 갱신될 때마다 INT 핀에 50us 펄스를 출력합니다.
+ * 래치하지 않으므로 상태 레지스터를 읽어 지울 필요가 없어
+ * 주기당 I2C 트랜잭션이 늘어나지 않습니다.
+ * 
+ * @param sensor IMU 센서 구조체 포인터
+ * @return ESP_OK 성공, ESP_FAIL 초기화되지 않음 또는 I2C 오류
+ */
+esp_err_t imu_sensor_enable_data_ready(imu_sensor_t* sensor) {
+    if (!sensor->data.initialized) {
+        return ESP_FAIL;
+    }
+
+    const i2c_reg_write_t int_sequence[] = {
+        { MPU6050_INT_PIN_CFG, MPU6050_INT_PIN_PULSE },
+        { MPU6050_INT_ENABLE,  MPU6050_INT_DATA_RDY_EN },
+    };
+    return i2c_write_registers(sensor->i2c_port, MPU6050_ADDR, int_sequence, 2);
+}
+
+/**
+ * @brief FIFO 버스트 읽기 구현
+ * 
+ * 읽기 순서:
+ * 1. FIFO_COUNTH/L 2바이트 읽기 (이하 모든 전송은 초기화 시 구성한 트랜잭션 사용)
+ * 2. 오버플로(FIFO 가득 참) 시 FIFO 리셋 후 0개 반환
+ * 3. 완전한 프레임 수만큼 FIFO_R_W에서 한 번에 버스트 읽기
+ * 4. 프레임별로 가속도/자이로 변환
+ * 
+ * @param sensor IMU 센서 구조체 포인터
+ * @param samples 출력 샘플 배열
+ * @param max_samples 배열 크기
+ * @param count 읽은 샘플 수
+ * @return ESP_OK 성공, ESP_FAIL FIFO 모드가 아님 또는 I2C 오류
+ */
+esp_err_t imu_sensor_read_fifo(imu_sensor_t* sensor, imu_sample_t* samples, size_t max_samples, size_t* count) {
+    *count = 0;
+    if (!sensor->fifo_enabled) {
+        return ESP_FAIL;
+    }
+
+    esp_err_t ret = i2c_transaction_execute(&sensor->fifo_count_txn);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    uint16_t fifo_bytes = (uint16_t)((sensor->fifo_count_buf[0] << 8) | sensor->fifo_count_buf[1]);
+    if (fifo_bytes >= MPU6050_FIFO_SIZE) {
+        // Oldest bytes were dropped; frame boundaries are lost, start over
+        sensor->fifo_overflow_count++;
+        i2c_transaction_execute(&sensor->fifo_reset_txn);
+#ifndef NATIVE_BUILD
+        ESP_LOGW(IMU_TAG, "IMU FIFO overflow, reset (%lu)", (unsigned long)sensor->fifo_overflow_count);
+#endif
+        return ESP_OK;
+    }
+
+    size_t frames = fifo_bytes / IMU_FIFO_FRAME_SIZE;
+    if (max_samples > IMU_FIFO_MAX_BATCH) {
+        max_samples = IMU_FIFO_MAX_BATCH;
+    }
+    if (frames > max_samples) {
+        frames = max_samples;
+    }
+    if (frames == 0) {
+        return ESP_OK;
+    }
+
+    ret = i2c_transaction_set_length(&sensor->fifo_data_txn, frames * IMU_FIFO_FRAME_SIZE);
+    if (ret == ESP_OK) {
+        ret = i2c_transaction_execute(&sensor->fifo_data_txn);
+    }
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    for (size_t i = 0; i < frames; i++) {
+        const uint8_t* frame = &sensor->fifo_buf[i * IMU_FIFO_FRAME_SIZE];
+        convert_raw_sample(frame, frame + 6, &sensor->offsets, &samples[i]);
+    }
+
+    const imu_sample_t* last = &samples[frames - 1];
+    sensor->data.accel_x = last->accel_x;
+    sensor->data.accel_y = last->accel_y;
+    sensor->data.accel_z = last->accel_z;
+    sensor->data.gyro_x = last->gyro_x;
+    sensor->data.gyro_y = last->gyro_y;
+    sensor->data.gyro_z = last->gyro_z;
+    sensor->data.pitch = last->pitch;
+    sensor->data.roll = atan2f(last->accel_y, last->accel_z) * 180.0f / (float)M_PI;
+
+    *count = frames;
+    return ESP_OK;
+}
+
+/**
+ * @brief FIFO 샘플 간격 반환
+ * 
+ * @param sensor IMU 센서 구조체 포인터
+ * @return 샘플 간격 (초), 레이트가 설정되지 않았으면 0
+ */
+float imu_sensor_get_sample_period(const imu_sensor_t* sensor) {
+    if (sensor->sample_rate_hz == 0) {
+        return 0.0f;
+    }
+    return 1.0f / sensor->sample_rate_hz;
+}
+
 /**
  * @brief IMU 센서 데이터를 업데이트하여 최신 관성 측정값 수신
  * 
@@ -119,7 +395,7 @@ esp_err_t imu_sensor_init(imu_sensor_t* sensor, i2c_port_t port, gpio_num_t sda_
  * 데이터 처리 과정:
  * 1. I2C로 14바이트 연속 읽기 (가속도 6바이트 + 온도 2바이트 + 자이로 6바이트)
  * 2. 16비트 빅엔디안 데이터를 정수로 변환
- * 3. 스케일링 팩터 적용 (가속도: /16384, 자이로: /131)
+ * 3. 스케일링 팩터 적용 (가속도: /16384, 자이로: /131) 후 오프셋 보정
  * 4. 가속도계 데이터로 피치/롤 각도 계산 (atan2 함수 사용)
  * 
  * @param sensor IMU 센서 구조체 포인터
@@ -130,38 +406,52 @@ esp_err_t imu_sensor_update(imu_sensor_t* sensor) {
         return ESP_FAIL;
     }
 
-    uint8_t raw_data[14];
-    esp_err_t ret = i2c_read_register(sensor->i2c_port, MPU6050_ADDR, MPU6050_ACCEL_XOUT_H, raw_data, 14);
+    esp_err_t ret = i2c_transaction_execute(&sensor->raw_txn);
     if (ret != ESP_OK) {
         return ret;
     }
+    const uint8_t* raw_data = sensor->raw_buf;
 
-    // Parse accelerometer data
-    int16_t accel_x = (int16_t)((raw_data[0] << 8) | raw_data[1]);
-    int16_t accel_y = (int16_t)((raw_data[2] << 8) | raw_data[3]);
-    int16_t accel_z = (int16_t)((raw_data[4] << 8) | raw_data[5]);
-
-    // Parse gyroscope data
-    int16_t gyro_x = (int16_t)((raw_data[8] << 8) | raw_data[9]);
-    int16_t gyro_y = (int16_t)((raw_data[10] << 8) | raw_data[11]);
-    int16_t gyro_z = (int16_t)((raw_data[12] << 8) | raw_data[13]);
+    // Parse accelerometer (bytes 0-5) and gyroscope (bytes 8-13), skipping temperature
+    imu_sample_t sample;
+    convert_raw_sample(&raw_data[0], &raw_data[8], &sensor->offsets, &sample);
 
-    // Convert to physical units
-    sensor->data.accel_x = accel_x / 16384.0f;  // ±2g range
-    sensor->data.accel_y = accel_y / 16384.0f;
-    sensor->data.accel_z = accel_z / 16384.0f;
-
-    sensor->data.gyro_x = gyro_x / 131.0f;      // ±250°/s range
-    sensor->data.gyro_y = gyro_y / 131.0f;
-    sensor->data.gyro_z = gyro_z / 131.0f;
+    sensor->data.accel_x = sample.accel_x;
+    sensor->data.accel_y = sample.accel_y;
+    sensor->data.accel_z = sample.accel_z;
+    sensor->data.gyro_x = sample.gyro_x;
+    sensor->data.gyro_y = sample.gyro_y;
+    sensor->data.gyro_z = sample.gyro_z;
 
     // Calculate pitch and roll from accelerometer
-    sensor->data.pitch = atan2(-sensor->data.accel_x, sqrt(sensor->data.accel_y * sensor->data.accel_y + sensor->data.accel_z * sensor->data.accel_z)) * 180.0f / M_PI;
-    sensor->data.roll = atan2(sensor->data.accel_y, sensor->data.accel_z) * 180.0f / M_PI;
+    sensor->data.pitch = sample.pitch;
+    sensor->data.roll = atan2f(sample.accel_y, sample.accel_z) * 180.0f / (float)M_PI;
 
     return ESP_OK;
 }
 
+/**
+ * @brief 오프셋 설정
+ * 
+ * 샘플을 읽는 태스크에서만 호출하므로 읽기 도중 오프셋이 바뀌지 않습니다.
+ * 
+ * @param sensor IMU 센서 구조체 포인터
+ * @param offsets 축별 오프셋
+ */
+void imu_sensor_set_offsets(imu_sensor_t* sensor, const imu_offsets_t* offsets) {
+    sensor->offsets = *offsets;
+}
+
+/**
+ * @brief 현재 오프셋 반환
+ * 
+ * @param sensor IMU 센서 구조체 포인터
+ * @param offsets 출력 오프셋
+ */
+void imu_sensor_get_offsets(const imu_sensor_t* sensor, imu_offsets_t* offsets) {
+    *offsets = sensor->offsets;
+}
+
 /**
  * @brief 현재 피치(Pitch) 각도 반환
  * 
@@ -9,7 +9,10 @@
  * - MPU6050 초기화 및 설정
  * - 가속도계 데이터 읽기 (3축)
  * - 자이로스코프 데이터 읽기 (3축)
+ * - 자이로/가속도 오프셋 보정 (스케일 변환 직후 적용)
  * - 피치/롤 각도 계산
+ * - 하드웨어 FIFO 버스트 읽기 (센서 고유 샘플 레이트로 배치 수신)
+ * - 주기 경로 I2C 전송은 초기화 시 구성한 재사용 트랜잭션 사용 (힙 할당 없음)
  * - 데이터 유효성 검증
  * 
  * @author BalanceBot Team
@@ -20,18 +23,11 @@
 #ifndef IMU_SENSOR_H
 #define IMU_SENSOR_H
 
-#ifndef NATIVE_BUILD
-#include "driver/i2c.h"
-#include "esp_err.h"
-#else
-typedef int esp_err_t;
-typedef int i2c_port_t;
-typedef int gpio_num_t;
-#define ESP_OK 0
-#define ESP_FAIL -1
-#endif
+#include "../bsw/i2c_driver.h"
 
 #include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -62,15 +58,57 @@ typedef struct {
     bool initialized; ///< 센서 초기화 상태
 } imu_data_t;
 
+#define IMU_FIFO_FRAME_SIZE     12    ///< FIFO 프레임 크기 (가속도 6바이트 + 자이로 6바이트)
+#define IMU_FIFO_MAX_BATCH      32    ///< 한 번의 버스트로 읽는 최대 샘플 수
+
+/**
+ * @struct imu_sample_t
+ * @brief FIFO에서 읽은 단일 샘플
+ * 
+ * 샘플 간격은 센서 출력 레이트로 고정되므로 타임스탬프 대신
+ * imu_sensor_get_sample_period()로 적분 간격을 얻습니다.
+ */
+typedef struct {
+    float accel_x;    ///< X축 가속도 (g)
+    float accel_y;    ///< Y축 가속도 (g)
+    float accel_z;    ///< Z축 가속도 (g)
+    float gyro_x;     ///< X축 각속도 (deg/s)
+    float gyro_y;     ///< Y축 각속도 (deg/s)
+    float gyro_z;     ///< Z축 각속도 (deg/s)
+    float pitch;      ///< 가속도계 기반 피치 각도 (degree)
+} imu_sample_t;
+
+/**
+ * @struct imu_offsets_t
+ * @brief 물리 단위로 변환한 값에서 빼는 축별 오프셋
+ */
+typedef struct {
+    float gyro[3];    ///< X/Y/Z축 자이로 오프셋 (deg/s)
+    float accel[3];   ///< X/Y/Z축 가속도 오프셋 (g)
+} imu_offsets_t;
+
 /**
  * @struct imu_sensor_t
  * @brief IMU 센서 제어 구조체
  * 
  * IMU 센서의 I2C 포트 정보와 측정 데이터를 관리합니다.
+ * 주기마다 실행하는 I2C 트랜잭션과 그 데이터 버퍼를 함께 소유합니다.
  */
 typedef struct {
-    i2c_port_t i2c_port; ///< I2C 포트 번호
-    imu_data_t data;      ///< 센서 측정 데이터
+    i2c_port_t i2c_port;          ///< I2C 포트 번호
+    imu_data_t data;              ///< 센서 측정 데이터 (FIFO 모드에서는 마지막 샘플)
+    imu_offsets_t offsets;        ///< 변환 시 빼는 오프셋 (초기화 시 0)
+    uint16_t sample_rate_hz;      ///< 설정된 출력 데이터 레이트 (Hz)
+    bool fifo_enabled;            ///< 하드웨어 FIFO 모드 활성화 여부
+    uint32_t fifo_overflow_count; ///< FIFO 오버플로로 리셋한 횟수
+    i2c_transaction_t raw_txn;        ///< ACCEL_XOUT_H부터 14바이트 읽기
+    i2c_transaction_t fifo_count_txn; ///< FIFO_COUNTH/L 2바이트 읽기
+    i2c_transaction_t fifo_data_txn;  ///< FIFO_R_W 버스트 읽기 (길이는 주기마다 조정)
+    i2c_transaction_t fifo_reset_txn; ///< 오버플로 시 FIFO 리셋 쓰기
+    uint8_t raw_buf[14];                                          ///< raw_txn 데이터 버퍼
+    uint8_t fifo_count_buf[2];                                    ///< fifo_count_txn 데이터 버퍼
+    uint8_t fifo_reset_value;                                     ///< fifo_reset_txn 쓰기 값
+    uint8_t fifo_buf[IMU_FIFO_MAX_BATCH * IMU_FIFO_FRAME_SIZE];   ///< fifo_data_txn 데이터 버퍼
 } imu_sensor_t;
 
 /** @} */ // IMU_SENSOR_STRUCTS
@@ -114,10 +152,93 @@ esp_err_t imu_sensor_init(imu_sensor_t* sensor, i2c_port_t port, gpio_num_t sda_
  *         - ESP_OK: 업데이트 성공
  *         - ESP_FAIL: 업데이트 실패 (통신 오류)
  * 
- * @note 밸런싱 제어를 위해 50Hz 주기로 호출하는 것을 권장합니다.
+ * @note 제어 주기마다 호출하며, imu_sensor_configure_rate()로 출력 레이트를 맞춰 두어야
+ *       매 주기 새로운 샘플을 읽습니다.
  */
 esp_err_t imu_sensor_update(imu_sensor_t* sensor);
 
+/**
+ * @brief 출력 데이터 레이트 및 저역 통과 필터 설정
+ * 
+ * 제어 루프 주파수에 맞춰 샘플 레이트 분주와 DLPF 대역폭을 설정합니다.
+ * imu_sensor_init() 이후에 호출해야 합니다.
+ * 
+ * @param sensor IMU 센서 구조체 포인터
+ * @param rate_hz 출력 데이터 레이트 (Hz, 최대 1000)
+ * @return esp_err_t 
+ *         - ESP_OK: 설정 성공
+ *         - ESP_FAIL: 초기화되지 않았거나 통신 오류
+ */
+esp_err_t imu_sensor_configure_rate(imu_sensor_t* sensor, uint16_t rate_hz);
+
+/**
+ * @brief 하드웨어 FIFO 모드 활성화
+ * 
+ * 가속도계와 자이로스코프 샘플을 FIFO에 쌓도록 설정하고 FIFO를 비웁니다.
+ * 이후에는 imu_sensor_update() 대신 imu_sensor_read_fifo()로 샘플을 읽습니다.
+ * imu_sensor_configure_rate() 이후에 호출해야 합니다.
+ * 
+ * @param sensor IMU 센서 구조체 포인터
+ * @return esp_err_t 
+ *         - ESP_OK: 활성화 성공
+ *         - ESP_FAIL: 초기화되지 않았거나 통신 오류
+ */
+esp_err_t imu_sensor_enable_fifo(imu_sensor_t* sensor);
+
+/**
+ * @brief 데이터 레디 인터럽트 출력 활성화
+ * 
+ * 새 샘플이 준비될 때마다 INT 핀에 펄스를 출력하도록 설정합니다.
+ * 호스트 측 인터럽트 처리는 imu_drdy 모듈이 담당합니다.
+ * 
+ * @param sensor IMU 센서 구조체 포인터
+ * @return esp_err_t 
+ *         - ESP_OK: 설정 성공
+ *         - ESP_FAIL: 초기화되지 않았거나 통신 오류
+ */
+esp_err_t imu_sensor_enable_data_ready(imu_sensor_t* sensor);
+
+/**
+ * @brief FIFO에 쌓인 샘플을 한 번의 버스트로 읽기
+ * 
+ * FIFO_COUNT를 읽은 뒤 완전한 프레임만 한 번의 I2C 트랜잭션으로 읽어
+ * 오래된 순서대로 samples에 채웁니다. max_samples를 넘는 샘플은 FIFO에 남아
+ * 다음 호출에서 읽힙니다. FIFO가 가득 차 샘플이 유실되었으면 프레임 정렬이
+ * 깨지므로 FIFO를 리셋하고 0개를 반환합니다.
+ * 
+ * 마지막 샘플은 imu_sensor_get_*() 함수로도 조회할 수 있습니다.
+ * 
+ * @param sensor IMU 센서 구조체 포인터
+ * @param samples 출력 샘플 배열
+ * @param max_samples 배열 크기 (IMU_FIFO_MAX_BATCH 이하로 제한됨)
+ * @param count 읽은 샘플 수
+ * @return esp_err_t 
+ *         - ESP_OK: 읽기 성공 (샘플이 없으면 count = 0)
+ *         - ESP_FAIL: FIFO 모드가 아니거나 통신 오류
+ */
+esp_err_t imu_sensor_read_fifo(imu_sensor_t* sensor, imu_sample_t* samples, size_t max_samples, size_t* count);
+
+/**
+ * @brief FIFO 샘플 간격 읽기
+ * @param sensor IMU 센서 구조체 포인터
+ * @return float 샘플 간격 (초), 출력 레이트 기준
+ */
+float imu_sensor_get_sample_period(const imu_sensor_t* sensor);
+
+/**
+ * @brief 오프셋 설정 (다음 읽기부터 적용)
+ * @param sensor IMU 센서 구조체 포인터
+ * @param offsets 축별 오프셋
+ */
+void imu_sensor_set_offsets(imu_sensor_t* sensor, const imu_offsets_t* offsets);
+
+/**
+ * @brief 현재 오프셋 읽기
+ * @param sensor IMU 센서 구조체 포인터
+ * @param offsets 출력 오프셋
+ */
+void imu_sensor_get_offsets(const imu_sensor_t* sensor, imu_offsets_t* offsets);
+
 /**
  * @brief 피치 각도 읽기
  * @param sensor IMU 센서 구조체 포인터
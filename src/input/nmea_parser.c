@@ -0,0 +1,269 @@
+/**
+ * @file nmea_parser.c
+ * @brief 바이트 단위 NMEA 0183 스트림 파서 구현
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "nmea_parser.h"
+#include <string.h>
+
+/**
+ * @brief 상태 머신 단계
+ */
+enum {
+    NMEA_STATE_IDLE = 0,        ///< '$' 대기
+    NMEA_STATE_BODY,            ///< 주소와 필드 수신 중
+    NMEA_STATE_CHECKSUM_HI,     ///< 체크섬 상위 니블 대기
+    NMEA_STATE_CHECKSUM_LO,     ///< 체크섬 하위 니블 대기
+};
+
+#define POSITION_LAT    0x01    ///< 위도 필드 읽음
+#define POSITION_LON    0x02    ///< 경도 필드 읽음
+
+static const double POW10[NMEA_FIELD_MAX_LENGTH + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+};
+
+/**
+ * @brief 10진수 필드를 정수 가수와 소수 자릿수로 읽기
+ * @return bool 숫자가 하나 이상 있고 형식이 맞으면 true
+ */
+static bool parse_decimal(const char* text, uint8_t length, int64_t* mantissa, int* decimals) {
+    int64_t value = 0;
+    int places = -1;
+    bool negative = false;
+    bool digits = false;
+    for (uint8_t i = 0; i < length; i++) {
+        char c = text[i];
+        if (c >= '0' && c <= '9') {
+            value = value * 10 + (c - '0');
+            digits = true;
+            if (places >= 0) {
+                places++;
+            }
+        } else if (c == '.' && places < 0) {
+            places = 0;
+        } else if (c == '-' && i == 0) {
+            negative = true;
+        } else {
+            return false;
+        }
+    }
+    *mantissa = negative ? -value : value;
+    *decimals = places < 0 ? 0 : places;
+    return digits;
+}
+
+/**
+ * @brief 10진수 필드를 실수로 읽기
+ */
+static bool parse_number(const char* text, uint8_t length, double* out) {
+    int64_t mantissa;
+    int decimals;
+    if (!parse_decimal(text, length, &mantissa, &decimals)) {
+        return false;
+    }
+    *out = (double)mantissa / POW10[decimals];
+    return true;
+}
+
+/**
+ * @brief 도분 형식(DDMM.MMMM / DDDMM.MMMM) 좌표를 십진도로 읽기
+ *
+ * 정수부와 소수부를 따로 나눠 계산하므로 float 변환에서 생기던 m 단위 오차가 없습니다.
+ */
+static bool parse_coordinate(const char* text, uint8_t length, double* out) {
+    int64_t mantissa;
+    int decimals;
+    if (!parse_decimal(text, length, &mantissa, &decimals) || mantissa < 0) {
+        return false;
+    }
+    int64_t scale = (int64_t)POW10[decimals];
+    int64_t whole = mantissa / scale;
+    double minutes = (double)(whole % 100) + (double)(mantissa % scale) / (double)scale;
+    *out = (double)(whole / 100) + minutes / 60.0;
+    return true;
+}
+
+/**
+ * @brief 16진수 문자 값 (아니면 -1)
+ */
+static int hex_value(uint8_t c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief 주소 필드로 문장 종류 판별
+ */
+static nmea_sentence_t classify(nmea_parser_t* parser) {
+    if (parser->text_length != 5) {
+        return NMEA_SENTENCE_NONE;
+    }
+    parser->data.talker[0] = parser->text[0];
+    parser->data.talker[1] = parser->text[1];
+    const char* formatter = &parser->text[2];
+    if (memcmp(formatter, "GGA", 3) == 0) {
+        return NMEA_SENTENCE_GGA;
+    }
+    if (memcmp(formatter, "RMC", 3) == 0) {
+        return NMEA_SENTENCE_RMC;
+    }
+    return NMEA_SENTENCE_NONE;
+}
+
+/**
+ * @brief 위도/경도와 방향 필드 처리 (GGA, RMC 공통 배치)
+ * @param offset 위도 필드 번호
+ */
+static void parse_position_field(nmea_parser_t* parser, uint8_t offset) {
+    nmea_data_t* data = &parser->data;
+    const char* text = parser->text;
+    uint8_t length = parser->text_length;
+    uint8_t field = parser->field - offset;
+    if (field == 0 && parse_coordinate(text, length, &data->latitude)) {
+        parser->position_fields |= POSITION_LAT;
+    } else if (field == 1 && length == 1 && text[0] == 'S') {
+        data->latitude = -data->latitude;
+    } else if (field == 2 && parse_coordinate(text, length, &data->longitude)) {
+        parser->position_fields |= POSITION_LON;
+    } else if (field == 3 && length == 1 && text[0] == 'W') {
+        data->longitude = -data->longitude;
+    }
+}
+
+/**
+ * @brief 완성된 필드 하나 처리
+ * @return bool 문장을 계속 읽어야 하면 true
+ */
+static bool end_field(nmea_parser_t* parser) {
+    nmea_data_t* data = &parser->data;
+    const char* text = parser->text;
+    uint8_t length = parser->text_length;
+    double value;
+
+    if (parser->field == 0) {
+        parser->sentence = classify(parser);
+        return parser->sentence != NMEA_SENTENCE_NONE;
+    }
+
+    if (parser->sentence == NMEA_SENTENCE_GGA) {
+        // $xxGGA,time,lat,N,lon,E,quality,satellites,hdop,altitude,M,...
+        if (parser->field >= 2 && parser->field <= 5) {
+            parse_position_field(parser, 2);
+        } else if (parser->field == 6 && parse_number(text, length, &value)) {
+            data->quality = (int)value;
+        } else if (parser->field == 7 && parse_number(text, length, &value)) {
+            data->satellites = (int)value;
+        } else if (parser->field == 9 && parse_number(text, length, &value)) {
+            data->altitude = (float)value;
+        }
+    } else {
+        // $xxRMC,time,status,lat,N,lon,E,...
+        if (parser->field == 2) {
+            data->status_valid = (length == 1 && text[0] == 'A');
+        } else if (parser->field >= 3 && parser->field <= 6) {
+            parse_position_field(parser, 3);
+        }
+    }
+    return true;
+}
+
+void nmea_parser_init(nmea_parser_t* parser) {
+    memset(parser, 0, sizeof(*parser));
+}
+
+nmea_sentence_t nmea_parser_feed(nmea_parser_t* parser, uint8_t byte) {
+    if (byte == '$') {
+        // Start of a sentence always resynchronizes, even mid-sentence
+        parser->state = NMEA_STATE_BODY;
+        parser->checksum = 0;
+        parser->length = 1;
+        parser->field = 0;
+        parser->text_length = 0;
+        parser->position_fields = 0;
+        parser->sentence = NMEA_SENTENCE_NONE;
+        memset(&parser->data, 0, sizeof(parser->data));
+        return NMEA_SENTENCE_NONE;
+    }
+    if (parser->state == NMEA_STATE_IDLE) {
+        return NMEA_SENTENCE_NONE;
+    }
+    // CR LF are not counted, so the body and checksum must fit in the rest
+    if (++parser->length > NMEA_SENTENCE_MAX_LENGTH - 2) {
+        parser->overflows++;
+        parser->state = NMEA_STATE_IDLE;
+        return NMEA_SENTENCE_NONE;
+    }
+
+    switch (parser->state) {
+        case NMEA_STATE_BODY:
+            if (byte == '*' || byte == ',') {
+                if (!end_field(parser)) {
+                    // Not a sentence we decode; skip to the next '$'
+                    parser->state = NMEA_STATE_IDLE;
+                    return NMEA_SENTENCE_NONE;
+                }
+                if (byte == '*') {
+                    parser->state = NMEA_STATE_CHECKSUM_HI;
+                    return NMEA_SENTENCE_NONE;
+                }
+                parser->checksum ^= byte;
+                parser->field++;
+                parser->text_length = 0;
+            } else if (byte == '\r' || byte == '\n') {
+                parser->checksum_errors++;
+                parser->state = NMEA_STATE_IDLE;
+            } else if (parser->text_length >= NMEA_FIELD_MAX_LENGTH) {
+                parser->overflows++;
+                parser->state = NMEA_STATE_IDLE;
+            } else {
+                parser->checksum ^= byte;
+                parser->text[parser->text_length++] = (char)byte;
+            }
+            return NMEA_SENTENCE_NONE;
+
+        case NMEA_STATE_CHECKSUM_HI: {
+            int hi = hex_value(byte);
+            if (hi < 0) {
+                parser->checksum_errors++;
+                parser->state = NMEA_STATE_IDLE;
+                return NMEA_SENTENCE_NONE;
+            }
+            parser->expected = (uint8_t)(hi << 4);
+            parser->state = NMEA_STATE_CHECKSUM_LO;
+            return NMEA_SENTENCE_NONE;
+        }
+
+        case NMEA_STATE_CHECKSUM_LO: {
+            int lo = hex_value(byte);
+            parser->state = NMEA_STATE_IDLE;
+            if (lo < 0 || (parser->expected | lo) != parser->checksum) {
+                parser->checksum_errors++;
+                return NMEA_SENTENCE_NONE;
+            }
+            parser->data.has_position = (parser->position_fields == (POSITION_LAT | POSITION_LON));
+            parser->sentences++;
+            return parser->sentence;
+        }
+
+        default:
+            parser->state = NMEA_STATE_IDLE;
+            return NMEA_SENTENCE_NONE;
+    }
+}
+
+const nmea_data_t* nmea_parser_data(const nmea_parser_t* parser) {
+    return &parser->data;
+}
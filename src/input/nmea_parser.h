@@ -0,0 +1,118 @@
+/**
+ * @file nmea_parser.h
+ * @brief 바이트 단위 NMEA 0183 스트림 파서
+ *
+ * UART에서 들어오는 바이트를 한 개씩 받아 상태 머신으로 문장을 조립합니다.
+ * 문장을 버퍼에 모아 strtok/atof로 자르지 않고, 필드가 끝날 때마다 그 자리에서
+ * 정수 연산으로 값을 읽으므로 힙 할당이 없고 파서 상태는 모두 구조체 안에
+ * 있습니다 (재진입 가능, 파서 인스턴스별 독립).
+ *
+ * 문장은 '*' 뒤 체크섬(주소부터 '*' 전까지 XOR)이 맞을 때만 전달합니다.
+ * 체크섬이 없거나 틀린 문장, NMEA 최대 길이(82자)를 넘는 문장은 버리고
+ * 다음 '$'에서 재동기화합니다. 관심 없는 문장 종류는 주소 필드만 보고
+ * 나머지를 건너뜁니다.
+ *
+ * 지원 문장: GGA (위치/고도/위성 수), RMC (수신 상태)
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef NMEA_PARSER_H
+#define NMEA_PARSER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NMEA_SENTENCE_MAX_LENGTH    82  ///< '$'부터 줄바꿈까지 최대 문장 길이 (NMEA 0183)
+#define NMEA_FIELD_MAX_LENGTH       15  ///< 값을 읽는 필드의 최대 길이 (넘으면 문장 폐기)
+
+/**
+ * @enum nmea_sentence_t
+ * @brief 검증된 문장 종류
+ */
+typedef enum {
+    NMEA_SENTENCE_NONE = 0,     ///< 완성된 문장 없음 (또는 지원하지 않는 문장)
+    NMEA_SENTENCE_GGA,          ///< GGA: 위치 고정 데이터
+    NMEA_SENTENCE_RMC,          ///< RMC: 권장 최소 데이터
+} nmea_sentence_t;
+
+/**
+ * @struct nmea_data_t
+ * @brief 문장에서 읽은 값
+ */
+typedef struct {
+    char talker[2];             ///< 토커 ID (예: "GP")
+    double latitude;            ///< 위도 (degree, 남위 음수)
+    double longitude;           ///< 경도 (degree, 서경 음수)
+    float altitude;             ///< 해수면 기준 고도 (m, GGA)
+    int quality;                ///< 고정 품질 (GGA, 0: 고정 없음)
+    int satellites;             ///< 사용 위성 수 (GGA)
+    bool has_position;          ///< 위도/경도 필드가 모두 있었음
+    bool status_valid;          ///< 상태 'A' (RMC)
+} nmea_data_t;
+
+/**
+ * @struct nmea_parser_t
+ * @brief 파서 상태
+ */
+typedef struct {
+    uint8_t state;              ///< 상태 머신 단계
+    uint8_t checksum;           ///< 지금까지의 XOR 체크섬
+    uint8_t expected;           ///< 문장 끝에서 받은 체크섬
+    uint8_t length;             ///< 현재 문장 길이
+    uint8_t field;              ///< 현재 필드 번호 (0: 주소)
+    uint8_t text_length;        ///< 현재 필드 길이
+    uint8_t position_fields;    ///< 현재 문장에서 읽은 위도/경도 필드 (비트마스크)
+    char text[NMEA_FIELD_MAX_LENGTH + 1]; ///< 현재 필드 문자
+    nmea_sentence_t sentence;   ///< 현재 문장 종류
+    nmea_data_t data;           ///< 현재 문장에서 읽은 값
+    uint32_t sentences;         ///< 전달한 문장 수
+    uint32_t checksum_errors;   ///< 체크섬이 없거나 틀려 버린 문장 수
+    uint32_t overflows;         ///< 길이 초과로 버린 문장 수
+} nmea_parser_t;
+
+/**
+ * @defgroup NMEA_PARSER_API NMEA 파서 API
+ * @brief 바이트 단위 NMEA 문장 파싱 함수들
+ * @{
+ */
+
+/**
+ * @brief 파서 초기화
+ * @param parser 파서 상태
+ */
+void nmea_parser_init(nmea_parser_t* parser);
+
+/**
+ * @brief 수신 바이트 하나를 파서에 입력
+ *
+ * 체크섬까지 확인된 지원 문장이 이 바이트로 끝나면 그 종류를 반환합니다.
+ * 이때 읽은 값은 다음 바이트를 넣기 전까지 nmea_parser_data()로 읽을 수 있습니다.
+ *
+ * @param parser 파서 상태
+ * @param byte 수신 바이트
+ * @return nmea_sentence_t 완성된 문장 종류 (NMEA_SENTENCE_NONE: 아직 없음)
+ */
+nmea_sentence_t nmea_parser_feed(nmea_parser_t* parser, uint8_t byte);
+
+/**
+ * @brief 마지막으로 완성된 문장의 값
+ * @param parser 파서 상태
+ * @return const nmea_data_t* 문장 값
+ */
+const nmea_data_t* nmea_parser_data(const nmea_parser_t* parser);
+
+/** @} */ // NMEA_PARSER_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NMEA_PARSER_H
@@ -0,0 +1,152 @@
+/**
+ * @file ubx_parser.c
+ * @brief u-blox UBX 바이너리 프로토콜 스트림 파서 구현
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "ubx_parser.h"
+#include <string.h>
+
+_Static_assert(sizeof(ubx_nav_pvt_t) == 92, "NAV-PVT payload is 92 bytes");
+
+/**
+ * @brief 상태 머신 단계
+ */
+enum {
+    UBX_STATE_SYNC_1 = 0,       ///< 0xB5 대기
+    UBX_STATE_SYNC_2,           ///< 0x62 대기
+    UBX_STATE_CLASS,            ///< class
+    UBX_STATE_ID,               ///< id
+    UBX_STATE_LENGTH_LO,        ///< 길이 하위 바이트
+    UBX_STATE_LENGTH_HI,        ///< 길이 상위 바이트
+    UBX_STATE_PAYLOAD,          ///< 페이로드
+    UBX_STATE_CK_A,             ///< 체크섬 A
+    UBX_STATE_CK_B,             ///< 체크섬 B
+};
+
+/**
+ * @brief 체크섬 누적 (class부터 페이로드 끝까지)
+ */
+static void checksum_add(ubx_parser_t* parser, uint8_t byte) {
+    parser->ck_a += byte;
+    parser->ck_b += parser->ck_a;
+}
+
+void ubx_parser_init(ubx_parser_t* parser) {
+    memset(parser, 0, sizeof(*parser));
+    parser->frame.payload = parser->buf;
+}
+
+const ubx_frame_t* ubx_parser_feed(ubx_parser_t* parser, uint8_t byte) {
+    switch (parser->state) {
+        case UBX_STATE_SYNC_1:
+            if (byte == UBX_SYNC_1) {
+                parser->state = UBX_STATE_SYNC_2;
+            }
+            return NULL;
+
+        case UBX_STATE_SYNC_2:
+            if (byte == UBX_SYNC_2) {
+                parser->ck_a = 0;
+                parser->ck_b = 0;
+                parser->state = UBX_STATE_CLASS;
+            } else {
+                parser->state = byte == UBX_SYNC_1 ? UBX_STATE_SYNC_2 : UBX_STATE_SYNC_1;
+            }
+            return NULL;
+
+        case UBX_STATE_CLASS:
+            checksum_add(parser, byte);
+            parser->frame.cls = byte;
+            parser->state = UBX_STATE_ID;
+            return NULL;
+
+        case UBX_STATE_ID:
+            checksum_add(parser, byte);
+            parser->frame.id = byte;
+            parser->state = UBX_STATE_LENGTH_LO;
+            return NULL;
+
+        case UBX_STATE_LENGTH_LO:
+            checksum_add(parser, byte);
+            parser->frame.length = byte;
+            parser->state = UBX_STATE_LENGTH_HI;
+            return NULL;
+
+        case UBX_STATE_LENGTH_HI:
+            checksum_add(parser, byte);
+            parser->frame.length |= (uint16_t)(byte << 8);
+            parser->index = 0;
+            parser->state = parser->frame.length > 0 ? UBX_STATE_PAYLOAD : UBX_STATE_CK_A;
+            return NULL;
+
+        case UBX_STATE_PAYLOAD:
+            checksum_add(parser, byte);
+            // Oversized frames are still walked to their end so the stream stays in sync
+            if (parser->index < UBX_MAX_PAYLOAD) {
+                parser->buf[parser->index] = byte;
+            }
+            if (++parser->index == parser->frame.length) {
+                parser->state = UBX_STATE_CK_A;
+            }
+            return NULL;
+
+        case UBX_STATE_CK_A:
+            parser->expected_a = byte;
+            parser->state = UBX_STATE_CK_B;
+            return NULL;
+
+        case UBX_STATE_CK_B:
+            parser->state = UBX_STATE_SYNC_1;
+            if (parser->expected_a != parser->ck_a || byte != parser->ck_b) {
+                parser->checksum_errors++;
+                return NULL;
+            }
+            if (parser->frame.length > UBX_MAX_PAYLOAD) {
+                parser->oversized++;
+                return NULL;
+            }
+            parser->frames++;
+            return &parser->frame;
+
+        default:
+            parser->state = UBX_STATE_SYNC_1;
+            return NULL;
+    }
+}
+
+const ubx_nav_pvt_t* ubx_frame_nav_pvt(const ubx_frame_t* frame) {
+    if (frame->cls != UBX_CLASS_NAV || frame->id != UBX_ID_NAV_PVT ||
+        frame->length < sizeof(ubx_nav_pvt_t)) {
+        return NULL;
+    }
+    return (const ubx_nav_pvt_t*)frame->payload;
+}
+
+size_t ubx_build_frame(uint8_t* out, size_t size, uint8_t cls, uint8_t id, const uint8_t* payload, uint16_t length) {
+    size_t total = (size_t)length + UBX_FRAME_OVERHEAD;
+    if (size < total) {
+        return 0;
+    }
+    out[0] = UBX_SYNC_1;
+    out[1] = UBX_SYNC_2;
+    out[2] = cls;
+    out[3] = id;
+    out[4] = (uint8_t)(length & 0xFF);
+    out[5] = (uint8_t)(length >> 8);
+    if (length > 0) {
+        memcpy(&out[6], payload, length);
+    }
+    uint8_t ck_a = 0;
+    uint8_t ck_b = 0;
+    for (size_t i = 2; i < total - 2; i++) {
+        ck_a += out[i];
+        ck_b += ck_a;
+    }
+    out[total - 2] = ck_a;
+    out[total - 1] = ck_b;
+    return total;
+}
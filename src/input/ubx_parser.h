@@ -0,0 +1,165 @@
+/**
+ * @file ubx_parser.h
+ * @brief u-blox UBX 바이너리 프로토콜 스트림 파서와 무복사(zero-copy) 메시지 뷰
+ *
+ * UBX 프레임: 0xB5 0x62 | class | id | 길이 (LE16) | 페이로드 | CK_A CK_B
+ * 체크섬은 class부터 페이로드 끝까지의 8비트 Fletcher 합입니다.
+ *
+ * 파서는 NMEA 파서와 같이 바이트를 하나씩 받는 상태 머신이며, 체크섬이 맞는
+ * 프레임이 완성되면 내부 버퍼 위의 프레임 뷰를 돌려줍니다. 페이로드는 복사하거나
+ * 문자열로 바꾸지 않고, packed 구조체 포인터로 필드를 바로 읽습니다
+ * (UBX와 ESP32 모두 리틀 엔디언). UBX_MAX_PAYLOAD를 넘는 프레임은 저장하지 않고 건너뜁니다.
+ *
+ * NMEA 문장에는 0xB5가 나오지 않으므로 같은 바이트 스트림을 NMEA 파서와 이 파서에
+ * 함께 넣어 두 프로토콜이 섞인 출력을 나눌 수 있습니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef UBX_PARSER_H
+#define UBX_PARSER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UBX_SYNC_1              0xB5    ///< 첫 번째 동기 문자
+#define UBX_SYNC_2              0x62    ///< 두 번째 동기 문자
+#define UBX_FRAME_OVERHEAD      8       ///< 동기 2 + class/id 2 + 길이 2 + 체크섬 2
+#define UBX_MAX_PAYLOAD         100     ///< 저장하는 최대 페이로드 (NAV-PVT 92바이트)
+
+#define UBX_CLASS_NAV           0x01    ///< 항법 결과
+#define UBX_CLASS_ACK           0x05    ///< 설정 응답
+#define UBX_CLASS_CFG           0x06    ///< 설정
+#define UBX_ID_NAV_PVT          0x07    ///< 위치/속도/시각 해
+#define UBX_ID_CFG_PRT          0x00    ///< 포트 설정 (u-blox 8 이하)
+#define UBX_ID_CFG_MSG          0x01    ///< 메시지 출력 주기 (u-blox 8 이하)
+#define UBX_ID_CFG_RATE         0x08    ///< 측정 주기 (u-blox 8 이하)
+#define UBX_ID_CFG_VALSET       0x8A    ///< 키/값 설정 (u-blox 9 이상)
+
+#define UBX_NAV_PVT_FIX_OK      0x01    ///< NAV-PVT flags: gnssFixOK
+
+/**
+ * @struct ubx_nav_pvt_t
+ * @brief UBX-NAV-PVT 페이로드 (92바이트, 리틀 엔디언)
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t itow;              ///< GPS 주간 시각 (ms)
+    uint16_t year;              ///< UTC 연도
+    uint8_t month;              ///< UTC 월
+    uint8_t day;                ///< UTC 일
+    uint8_t hour;               ///< UTC 시
+    uint8_t min;                ///< UTC 분
+    uint8_t sec;                ///< UTC 초
+    uint8_t valid;              ///< 날짜/시각 유효 플래그
+    uint32_t t_acc;             ///< 시각 정확도 (ns)
+    int32_t nano;               ///< 초 이하 시각 (ns)
+    uint8_t fix_type;           ///< 고정 종류 (0: 없음, 2: 2D, 3: 3D, 4: GNSS+추측항법)
+    uint8_t flags;              ///< 고정 플래그 (bit0: gnssFixOK)
+    uint8_t flags2;             ///< 추가 플래그
+    uint8_t num_sv;             ///< 해에 사용한 위성 수
+    int32_t lon;                ///< 경도 (1e-7 degree)
+    int32_t lat;                ///< 위도 (1e-7 degree)
+    int32_t height;             ///< 타원체 고도 (mm)
+    int32_t h_msl;              ///< 해수면 고도 (mm)
+    uint32_t h_acc;             ///< 수평 정확도 추정 (mm)
+    uint32_t v_acc;             ///< 수직 정확도 추정 (mm)
+    int32_t vel_n;              ///< 북쪽 속도 (mm/s)
+    int32_t vel_e;              ///< 동쪽 속도 (mm/s)
+    int32_t vel_d;              ///< 아래쪽 속도 (mm/s)
+    int32_t g_speed;            ///< 지면 속도 (mm/s)
+    int32_t head_mot;           ///< 이동 방향 (1e-5 degree, 북쪽에서 시계 방향)
+    uint32_t s_acc;             ///< 속도 정확도 추정 (mm/s)
+    uint32_t head_acc;          ///< 방향 정확도 추정 (1e-5 degree)
+    uint16_t p_dop;             ///< 위치 DOP (0.01)
+    uint8_t flags3;             ///< 추가 플래그
+    uint8_t reserved[5];        ///< 예약
+    int32_t head_veh;           ///< 차량 방향 (1e-5 degree)
+    int16_t mag_dec;            ///< 자기 편차 (1e-2 degree)
+    uint16_t mag_acc;           ///< 자기 편차 정확도 (1e-2 degree)
+} ubx_nav_pvt_t;
+
+/**
+ * @struct ubx_frame_t
+ * @brief 검증된 프레임에 대한 읽기 전용 뷰 (파서 버퍼를 가리킴)
+ */
+typedef struct {
+    uint8_t cls;                ///< 메시지 class
+    uint8_t id;                 ///< 메시지 id
+    uint16_t length;            ///< 페이로드 길이
+    const uint8_t* payload;     ///< 페이로드 시작
+} ubx_frame_t;
+
+/**
+ * @struct ubx_parser_t
+ * @brief 스트리밍 파서 상태
+ */
+typedef struct {
+    uint8_t state;              ///< 상태 머신 단계
+    uint8_t ck_a;               ///< Fletcher 체크섬 A
+    uint8_t ck_b;               ///< Fletcher 체크섬 B
+    uint8_t expected_a;         ///< 받은 체크섬 A
+    uint16_t index;             ///< 현재 페이로드 위치
+    ubx_frame_t frame;          ///< 조립 중/마지막으로 완성된 프레임
+    uint8_t buf[UBX_MAX_PAYLOAD]; ///< 페이로드 버퍼
+    uint32_t frames;            ///< 전달한 프레임 수
+    uint32_t checksum_errors;   ///< 체크섬이 틀려 버린 프레임 수
+    uint32_t oversized;         ///< 너무 길어 건너뛴 프레임 수
+} ubx_parser_t;
+
+/**
+ * @defgroup UBX_PARSER_API UBX 파서 API
+ * @brief UBX 프레임 파싱, 메시지 뷰, 프레임 생성 함수들
+ * @{
+ */
+
+/**
+ * @brief 파서 초기화
+ * @param parser 파서 상태
+ */
+void ubx_parser_init(ubx_parser_t* parser);
+
+/**
+ * @brief 수신 바이트 하나를 파서에 입력
+ *
+ * 체크섬이 맞는 프레임이 이 바이트로 끝나면 프레임 뷰를 반환합니다.
+ * 뷰는 다음 바이트를 넣기 전까지만 유효합니다.
+ *
+ * @param parser 파서 상태
+ * @param byte 수신 바이트
+ * @return const ubx_frame_t* 완성된 프레임 (없으면 NULL)
+ */
+const ubx_frame_t* ubx_parser_feed(ubx_parser_t* parser, uint8_t byte);
+
+/**
+ * @brief NAV-PVT 페이로드 뷰 (NAV-PVT가 아니거나 짧으면 NULL)
+ * @param frame 검증된 프레임
+ * @return const ubx_nav_pvt_t* 페이로드 뷰
+ */
+const ubx_nav_pvt_t* ubx_frame_nav_pvt(const ubx_frame_t* frame);
+
+/**
+ * @brief UBX 프레임 생성 (동기 문자, 길이, 체크섬 포함)
+ * @param out 출력 버퍼
+ * @param size 출력 버퍼 크기
+ * @param cls 메시지 class
+ * @param id 메시지 id
+ * @param payload 페이로드 (length가 0이면 NULL 가능)
+ * @param length 페이로드 길이
+ * @return size_t 프레임 길이 (버퍼가 작으면 0)
+ */
+size_t ubx_build_frame(uint8_t* out, size_t size, uint8_t cls, uint8_t id, const uint8_t* payload, uint16_t length);
+
+/** @} */ // UBX_PARSER_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UBX_PARSER_H
@@ -0,0 +1,380 @@
+/**
+ * @file attitude_estimator.c
+ * @brief 자세 추정 엔진 구현 파일
+ *
+ * 칼만, Mahony, Madgwick, 상보 필터의 샘플 단위 갱신을 구현합니다.
+ * 쿼터니언 필터는 자이로를 rad/s로 변환해 적분하고, 출력은 degree로 통일합니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "attitude_estimator.h"
+#include <math.h>
+
+#define ATT_DEG_TO_RAD  0.017453292519943295f  ///< degree → rad
+#define ATT_RAD_TO_DEG  57.29577951308232f     ///< rad → degree
+
+/**
+ * @brief 가속도계로 피치/롤 계산 (imu_sensor와 같은 좌표계)
+ */
+static void accel_angles(float ax, float ay, float az, float* pitch, float* roll) {
+    *pitch = atan2f(-ax, sqrtf(ay * ay + az * az)) * ATT_RAD_TO_DEG;
+    *roll = atan2f(ay, az) * ATT_RAD_TO_DEG;
+}
+
+/**
+ * @brief 피치/롤(요 0)로 쿼터니언 설정
+ */
+static void quaternion_from_euler(float* q, float pitch_deg, float roll_deg) {
+    float cp = cosf(pitch_deg * ATT_DEG_TO_RAD * 0.5f);
+    float sp = sinf(pitch_deg * ATT_DEG_TO_RAD * 0.5f);
+    float cr = cosf(roll_deg * ATT_DEG_TO_RAD * 0.5f);
+    float sr = sinf(roll_deg * ATT_DEG_TO_RAD * 0.5f);
+    q[0] = cr * cp;
+    q[1] = sr * cp;
+    q[2] = cr * sp;
+    q[3] = -sr * sp;
+}
+
+/**
+ * @brief 쿼터니언에서 피치/롤 추출
+ */
+static void quaternion_to_euler(const float* q, attitude_t* out) {
+    float sinp = 2.0f * (q[0] * q[2] - q[1] * q[3]);
+    if (sinp > 1.0f) sinp = 1.0f;
+    if (sinp < -1.0f) sinp = -1.0f;
+    out->pitch = asinf(sinp) * ATT_RAD_TO_DEG;
+    out->roll = atan2f(2.0f * (q[0] * q[1] + q[2] * q[3]),
+                       1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2])) * ATT_RAD_TO_DEG;
+}
+
+/**
+ * @brief 쿼터니언 정규화
+ */
+static void quaternion_normalize(float* q) {
+    float norm = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    if (norm > 0.0f) {
+        float inv = 1.0f / norm;
+        q[0] *= inv;
+        q[1] *= inv;
+        q[2] *= inv;
+        q[3] *= inv;
+    }
+}
+
+/**
+ * @brief 현재 추정 자세에서 활성 필터 상태를 시작
+ *
+ * 정렬 시와 필터 전환 시에 사용하며, 바이어스 추정은 유지합니다.
+ */
+static void seed_active_filter(attitude_estimator_t* est) {
+    switch (est->type) {
+        case ATTITUDE_FILTER_KALMAN:
+            kalman_filter_set_angle(&est->kalman_pitch, est->out.pitch);
+            kalman_filter_set_angle(&est->kalman_roll, est->out.roll);
+            break;
+        case ATTITUDE_FILTER_KALMAN_FIXED:
+            est->kalman_q_pitch.angle = q16_from_float(est->out.pitch);
+            est->kalman_q_roll.angle = q16_from_float(est->out.roll);
+            break;
+        case ATTITUDE_FILTER_MAHONY:
+        case ATTITUDE_FILTER_MADGWICK:
+            quaternion_from_euler(est->q, est->out.pitch, est->out.roll);
+            break;
+        default:
+            // Complementary filter integrates est->out directly
+            break;
+    }
+}
+
+void attitude_estimator_init(attitude_estimator_t* est, attitude_filter_type_t type) {
+    est->type = (type < ATTITUDE_FILTER_COUNT) ? type : ATTITUDE_FILTER_KALMAN;
+    atomic_store(&est->pending_type, -1);
+    est->aligned = false;
+    est->out.pitch = est->out.roll = 0.0f;
+    est->out.pitch_rate = est->out.roll_rate = est->out.yaw_rate = 0.0f;
+
+    kalman_filter_init(&est->kalman_pitch);
+    kalman_filter_init(&est->kalman_roll);
+    kalman_filter_q_load(&est->kalman_q_pitch, &est->kalman_pitch);
+    kalman_filter_q_load(&est->kalman_q_roll, &est->kalman_roll);
+
+    est->q[0] = 1.0f;
+    est->q[1] = est->q[2] = est->q[3] = 0.0f;
+    est->integral_fb[0] = est->integral_fb[1] = est->integral_fb[2] = 0.0f;
+    est->mahony_kp = 1.0f;
+    est->mahony_ki = 0.3f;
+    est->madgwick_beta = 0.08f;
+
+    est->comp_tau = 0.5f;
+}
+
+bool attitude_estimator_select(attitude_estimator_t* est, attitude_filter_type_t type) {
+    if (type >= ATTITUDE_FILTER_COUNT) {
+        return false;
+    }
+    atomic_store(&est->pending_type, (int)type);
+    return true;
+}
+
+/**
+ * @brief 칼만 갱신: 피치/롤 축을 각각 2상태 칼만 필터로 추정
+ */
+static void update_kalman(attitude_estimator_t* est, float ax, float ay, float az,
+                          float gx, float gy, float dt) {
+    float acc_pitch, acc_roll;
+    accel_angles(ax, ay, az, &acc_pitch, &acc_roll);
+    est->out.pitch = kalman_filter_get_angle(&est->kalman_pitch, acc_pitch, gy, dt);
+    est->out.roll = kalman_filter_get_angle(&est->kalman_roll, acc_roll, gx, dt);
+    est->out.pitch_rate = est->kalman_pitch.rate;
+    est->out.roll_rate = est->kalman_roll.rate;
+}
+
+/**
+ * @brief 가속도계로 피치/롤 계산 (고정소수점, accel_angles와 같은 좌표계)
+ */
+static void accel_angles_q(q16_t ax, q16_t ay, q16_t az, q16_t* pitch, q16_t* roll) {
+    *pitch = q16_atan2_deg(q_sub(0, ax), q16_hypot(ay, az));
+    *roll = q16_atan2_deg(ay, az);
+}
+
+/**
+ * @brief 고정소수점 칼만 갱신: update_kalman과 같으나 가속도계 각도와 필터 연산을 정수로 수행
+ *
+ * 센서 값은 드라이버 경계에서 한 번만 Q16.16으로 바꾸고, float 출력(est->out)은
+ * 텔레메트리 등 float 소비자를 위해 결과에서 변환합니다.
+ */
+static void update_kalman_fixed(attitude_estimator_t* est, float ax, float ay, float az,
+                                float gx, float gy, float dt) {
+    q16_t acc_pitch, acc_roll;
+    accel_angles_q(q16_from_float(ax), q16_from_float(ay), q16_from_float(az), &acc_pitch, &acc_roll);
+    q30_t dt_q = q30_from_float(dt);
+    est->out.pitch = q16_to_float(kalman_filter_q_get_angle(&est->kalman_q_pitch, acc_pitch,
+                                                            q16_from_float(gy), dt_q));
+    est->out.roll = q16_to_float(kalman_filter_q_get_angle(&est->kalman_q_roll, acc_roll,
+                                                           q16_from_float(gx), dt_q));
+    est->out.pitch_rate = q16_to_float(est->kalman_q_pitch.rate);
+    est->out.roll_rate = q16_to_float(est->kalman_q_roll.rate);
+}
+
+/**
+ * @brief Mahony 갱신 구현
+ *
+ * 쿼터니언으로 예측한 중력 방향과 가속도계 방향의 외적을 오차로 삼아
+ * PI 보정량을 자이로에 더한 뒤 쿼터니언을 적분합니다.
+ * 적분 항은 자이로 바이어스를 추정하므로 출력 각속도 보정에도 사용합니다.
+ */
+static void update_mahony(attitude_estimator_t* est, float ax, float ay, float az,
+                          float gx, float gy, float gz, float dt) {
+    float* q = est->q;
+    gx *= ATT_DEG_TO_RAD;
+    gy *= ATT_DEG_TO_RAD;
+    gz *= ATT_DEG_TO_RAD;
+
+    float norm = sqrtf(ax * ax + ay * ay + az * az);
+    if (norm > 0.0f) {
+        float inv = 1.0f / norm;
+        ax *= inv;
+        ay *= inv;
+        az *= inv;
+
+        // Half of the estimated gravity direction in the body frame
+        float halfvx = q[1] * q[3] - q[0] * q[2];
+        float halfvy = q[0] * q[1] + q[2] * q[3];
+        float halfvz = q[0] * q[0] - 0.5f + q[3] * q[3];
+
+        float halfex = ay * halfvz - az * halfvy;
+        float halfey = az * halfvx - ax * halfvz;
+        float halfez = ax * halfvy - ay * halfvx;
+
+        if (est->mahony_ki > 0.0f) {
+            est->integral_fb[0] += 2.0f * est->mahony_ki * halfex * dt;
+            est->integral_fb[1] += 2.0f * est->mahony_ki * halfey * dt;
+            est->integral_fb[2] += 2.0f * est->mahony_ki * halfez * dt;
+        } else {
+            est->integral_fb[0] = est->integral_fb[1] = est->integral_fb[2] = 0.0f;
+        }
+        gx += est->integral_fb[0] + 2.0f * est->mahony_kp * halfex;
+        gy += est->integral_fb[1] + 2.0f * est->mahony_kp * halfey;
+        gz += est->integral_fb[2] + 2.0f * est->mahony_kp * halfez;
+    }
+
+    gx *= 0.5f * dt;
+    gy *= 0.5f * dt;
+    gz *= 0.5f * dt;
+    float qa = q[0], qb = q[1], qc = q[2];
+    q[0] += -qb * gx - qc * gy - q[3] * gz;
+    q[1] += qa * gx + qc * gz - q[3] * gy;
+    q[2] += qa * gy - qb * gz + q[3] * gx;
+    q[3] += qa * gz + qb * gy - qc * gx;
+    quaternion_normalize(q);
+    quaternion_to_euler(q, &est->out);
+}
+
+/**
+ * @brief Madgwick 갱신 구현
+ *
+ * 자이로로 구한 쿼터니언 변화율에서 중력 정렬 목적 함수의 정규화된
+ * 기울기를 beta만큼 빼서 적분합니다.
+ */
+static void update_madgwick(attitude_estimator_t* est, float ax, float ay, float az,
+                            float gx, float gy, float gz, float dt) {
+    float* q = est->q;
+    gx *= ATT_DEG_TO_RAD;
+    gy *= ATT_DEG_TO_RAD;
+    gz *= ATT_DEG_TO_RAD;
+
+    float qdot0 = 0.5f * (-q[1] * gx - q[2] * gy - q[3] * gz);
+    float qdot1 = 0.5f * (q[0] * gx + q[2] * gz - q[3] * gy);
+    float qdot2 = 0.5f * (q[0] * gy - q[1] * gz + q[3] * gx);
+    float qdot3 = 0.5f * (q[0] * gz + q[1] * gy - q[2] * gx);
+
+    float norm = sqrtf(ax * ax + ay * ay + az * az);
+    if (norm > 0.0f) {
+        float inv = 1.0f / norm;
+        ax *= inv;
+        ay *= inv;
+        az *= inv;
+
+        float _2q0 = 2.0f * q[0], _2q1 = 2.0f * q[1], _2q2 = 2.0f * q[2], _2q3 = 2.0f * q[3];
+        float _4q0 = 4.0f * q[0], _4q1 = 4.0f * q[1], _4q2 = 4.0f * q[2];
+        float _8q1 = 8.0f * q[1], _8q2 = 8.0f * q[2];
+        float q0q0 = q[0] * q[0], q1q1 = q[1] * q[1], q2q2 = q[2] * q[2], q3q3 = q[3] * q[3];
+
+        float s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+        float s1 = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q[1] - _2q0 * ay - _4q1
+                 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+        float s2 = 4.0f * q0q0 * q[2] + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2
+                 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+        float s3 = 4.0f * q1q1 * q[3] - _2q1 * ax + 4.0f * q2q2 * q[3] - _2q2 * ay;
+
+        float s_norm = sqrtf(s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3);
+        if (s_norm > 0.0f) {
+            float step = est->madgwick_beta / s_norm;
+            qdot0 -= step * s0;
+            qdot1 -= step * s1;
+            qdot2 -= step * s2;
+            qdot3 -= step * s3;
+        }
+    }
+
+    q[0] += qdot0 * dt;
+    q[1] += qdot1 * dt;
+    q[2] += qdot2 * dt;
+    q[3] += qdot3 * dt;
+    quaternion_normalize(q);
+    quaternion_to_euler(q, &est->out);
+}
+
+/**
+ * @brief 상보 필터 갱신: 자이로 적분과 가속도계 각도를 시정수로 혼합
+ */
+static void update_complementary(attitude_estimator_t* est, float ax, float ay, float az,
+                                 float gx, float gy, float dt) {
+    float acc_pitch, acc_roll;
+    accel_angles(ax, ay, az, &acc_pitch, &acc_roll);
+    float alpha = est->comp_tau / (est->comp_tau + dt);
+    est->out.pitch = alpha * (est->out.pitch + gy * dt) + (1.0f - alpha) * acc_pitch;
+    est->out.roll = alpha * (est->out.roll + gx * dt) + (1.0f - alpha) * acc_roll;
+    est->out.pitch_rate = gy;
+    est->out.roll_rate = gx;
+}
+
+/**
+ * @brief 자세 갱신 구현
+ *
+ * 대기 중인 필터 전환 요청을 먼저 적용하고, 첫 샘플이면 가속도계 각도로
+ * 자세를 정렬한 뒤 활성 필터 하나만 갱신합니다.
+ */
+const attitude_t* attitude_estimator_update(attitude_estimator_t* est,
+                                            float ax, float ay, float az,
+                                            float gx, float gy, float gz, float dt) {
+    int pending = atomic_exchange(&est->pending_type, -1);
+    if (pending >= 0 && pending != (int)est->type) {
+        est->type = (attitude_filter_type_t)pending;
+        seed_active_filter(est);
+    }
+
+    if (!est->aligned) {
+        accel_angles(ax, ay, az, &est->out.pitch, &est->out.roll);
+        seed_active_filter(est);
+        est->aligned = true;
+    }
+
+    switch (est->type) {
+        case ATTITUDE_FILTER_MAHONY:
+            update_mahony(est, ax, ay, az, gx, gy, gz, dt);
+            est->out.pitch_rate = gy + est->integral_fb[1] * ATT_RAD_TO_DEG;
+            est->out.roll_rate = gx + est->integral_fb[0] * ATT_RAD_TO_DEG;
+            break;
+        case ATTITUDE_FILTER_MADGWICK:
+            update_madgwick(est, ax, ay, az, gx, gy, gz, dt);
+            est->out.pitch_rate = gy;
+            est->out.roll_rate = gx;
+            break;
+        case ATTITUDE_FILTER_COMPLEMENTARY:
+            update_complementary(est, ax, ay, az, gx, gy, dt);
+            break;
+        case ATTITUDE_FILTER_KALMAN_FIXED:
+            update_kalman_fixed(est, ax, ay, az, gx, gy, dt);
+            break;
+        default:
+            update_kalman(est, ax, ay, az, gx, gy, dt);
+            break;
+    }
+    est->out.yaw_rate = gz;
+    return &est->out;
+}
+
+attitude_filter_type_t attitude_estimator_get_type(const attitude_estimator_t* est) {
+    return est->type;
+}
+
+void attitude_estimator_get_pitch_q(const attitude_estimator_t* est, q16_t* pitch, q16_t* pitch_rate) {
+    if (est->type == ATTITUDE_FILTER_KALMAN_FIXED) {
+        *pitch = est->kalman_q_pitch.angle;
+        *pitch_rate = est->kalman_q_pitch.rate;
+    } else {
+        *pitch = q16_from_float(est->out.pitch);
+        *pitch_rate = q16_from_float(est->out.pitch_rate);
+    }
+}
+
+const char* attitude_estimator_type_name(attitude_filter_type_t type) {
+    switch (type) {
+        case ATTITUDE_FILTER_KALMAN:        return "Kalman";
+        case ATTITUDE_FILTER_MAHONY:        return "Mahony";
+        case ATTITUDE_FILTER_MADGWICK:      return "Madgwick";
+        case ATTITUDE_FILTER_COMPLEMENTARY: return "Complementary";
+        case ATTITUDE_FILTER_KALMAN_FIXED:  return "Kalman (Q16)";
+        default:                            return "Unknown";
+    }
+}
+
+void attitude_estimator_set_mahony_gains(attitude_estimator_t* est, float kp, float ki) {
+    est->mahony_kp = kp;
+    est->mahony_ki = ki;
+}
+
+void attitude_estimator_set_madgwick_beta(attitude_estimator_t* est, float beta) {
+    est->madgwick_beta = beta;
+}
+
+void attitude_estimator_set_kalman_noise(attitude_estimator_t* est, float q_angle, float q_bias, float r_measure) {
+    kalman_filter_t* axes[2] = {&est->kalman_pitch, &est->kalman_roll};
+    kalman_filter_q_t* axes_q[2] = {&est->kalman_q_pitch, &est->kalman_q_roll};
+    for (int i = 0; i < 2; i++) {
+        kalman_filter_set_qangle(axes[i], q_angle);
+        kalman_filter_set_qbias(axes[i], q_bias);
+        kalman_filter_set_rmeasure(axes[i], r_measure);
+        axes_q[i]->Q_angle = q30_from_float(q_angle);
+        axes_q[i]->Q_bias = q30_from_float(q_bias);
+        axes_q[i]->R_measure = q30_from_float(r_measure);
+    }
+}
+
+void attitude_estimator_set_complementary_tau(attitude_estimator_t* est, float tau) {
+    est->comp_tau = tau;
+}
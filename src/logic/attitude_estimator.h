@@ -0,0 +1,206 @@
+/**
+ * @file attitude_estimator.h
+ * @brief 자세 추정 엔진 헤더 파일
+ *
+ * 여러 센서 융합 필터를 하나의 인터페이스로 묶은 자세 추정기입니다.
+ * 6축 IMU 샘플(가속도 + 자이로)을 받아 피치, 롤, 바이어스 보정된 각속도를 추정하며,
+ * 사용할 필터는 실행 중에 바꿀 수 있습니다.
+ *
+ * 지원 필터:
+ * - 칼만: 축별 2상태(각도, 바이어스) 칼만 필터 (피치/롤 각각)
+ * - 고정소수점 칼만: 같은 칼만 커널의 Q16.16/Q2.30 인스턴스 (가속도계 각도 포함 정수 연산)
+ * - Mahony: 쿼터니언 + PI 보정 (자이로 바이어스 적분 보상)
+ * - Madgwick: 쿼터니언 + 경사 하강 보정
+ * - 상보: 축별 1차 상보 필터 (가장 가벼움)
+ *
+ * 좌표계는 imu_sensor와 같습니다: 피치 = atan2(-ax, sqrt(ay² + az²)),
+ * 롤 = atan2(ay, az), 피치 각속도 = gyro_y.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef ATTITUDE_ESTIMATOR_H
+#define ATTITUDE_ESTIMATOR_H
+
+#include "kalman_filter.h"
+#include "control_fixed.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @enum attitude_filter_type_t
+ * @brief 자세 추정 필터 종류
+ */
+typedef enum {
+    ATTITUDE_FILTER_KALMAN = 0,     ///< 축별 2상태 칼만 필터
+    ATTITUDE_FILTER_MAHONY,         ///< Mahony 쿼터니언 필터
+    ATTITUDE_FILTER_MADGWICK,       ///< Madgwick 쿼터니언 필터
+    ATTITUDE_FILTER_COMPLEMENTARY,  ///< 상보 필터
+    ATTITUDE_FILTER_KALMAN_FIXED,   ///< 축별 2상태 칼만 필터 (고정소수점)
+    ATTITUDE_FILTER_COUNT           ///< 필터 종류 수
+} attitude_filter_type_t;
+
+/**
+ * @struct attitude_t
+ * @brief 추정된 자세
+ */
+typedef struct {
+    float pitch;        ///< 피치 각도 (degree)
+    float roll;         ///< 롤 각도 (degree)
+    float pitch_rate;   ///< 피치 각속도 (deg/s, 필터가 추정한 바이어스 보정)
+    float roll_rate;    ///< 롤 각속도 (deg/s, 필터가 추정한 바이어스 보정)
+    float yaw_rate;     ///< 요 각속도 (deg/s)
+} attitude_t;
+
+/**
+ * @struct attitude_estimator_t
+ * @brief 자세 추정기 상태 구조체
+ *
+ * 모든 필터의 상태를 함께 보관하므로 필터 전환에 메모리 할당이 필요 없습니다.
+ * 활성 필터만 매 샘플 갱신됩니다.
+ */
+typedef struct {
+    attitude_filter_type_t type;    ///< 활성 필터
+    atomic_int pending_type;        ///< 다른 태스크가 요청한 필터 (-1: 요청 없음)
+    bool aligned;                   ///< 첫 샘플로 가속도계 정렬을 마쳤는지 여부
+    attitude_t out;                 ///< 마지막 추정 결과
+
+    kalman_filter_t kalman_pitch;   ///< 칼만: 피치 축
+    kalman_filter_t kalman_roll;    ///< 칼만: 롤 축
+    kalman_filter_q_t kalman_q_pitch; ///< 고정소수점 칼만: 피치 축
+    kalman_filter_q_t kalman_q_roll;  ///< 고정소수점 칼만: 롤 축
+
+    float q[4];                     ///< Mahony/Madgwick 쿼터니언 (w, x, y, z)
+    float integral_fb[3];           ///< Mahony 적분 보정 (rad/s, 자이로 바이어스의 음수)
+    float mahony_kp;                ///< Mahony 비례 게인
+    float mahony_ki;                ///< Mahony 적분 게인
+    float madgwick_beta;            ///< Madgwick 보정 게인 (rad/s)
+
+    float comp_tau;                 ///< 상보 필터 시정수 (s)
+} attitude_estimator_t;
+
+/**
+ * @defgroup ATTITUDE_ESTIMATOR_API 자세 추정 API
+ * @brief 필터 선택 및 갱신 함수들
+ * @{
+ */
+
+/**
+ * @brief 자세 추정기 초기화
+ *
+ * 모든 필터를 기본 파라미터로 초기화하고 지정한 필터를 활성화합니다.
+ * 첫 샘플의 가속도계 각도로 자세를 정렬합니다.
+ *
+ * 기본값: Mahony Kp 1.0 / Ki 0.3, Madgwick beta 0.08, 상보 시정수 0.5s,
+ * 칼만 파라미터는 kalman_filter_init() 기본값
+ *
+ * @param est 자세 추정기 구조체 포인터
+ * @param type 활성화할 필터
+ */
+void attitude_estimator_init(attitude_estimator_t* est, attitude_filter_type_t type);
+
+/**
+ * @brief 사용할 필터 변경 요청
+ *
+ * 어느 태스크에서나 호출할 수 있으며, 다음 attitude_estimator_update()에서
+ * 제어 태스크가 적용합니다. 새 필터는 현재 추정 자세에서 시작하므로 각도가 튀지 않습니다.
+ *
+ * @param est 자세 추정기 구조체 포인터
+ * @param type 새 필터
+ * @return bool 유효한 필터면 true
+ */
+bool attitude_estimator_select(attitude_estimator_t* est, attitude_filter_type_t type);
+
+/**
+ * @brief IMU 샘플 하나로 자세 갱신
+ *
+ * @param est 자세 추정기 구조체 포인터
+ * @param ax X축 가속도 (g)
+ * @param ay Y축 가속도 (g)
+ * @param az Z축 가속도 (g)
+ * @param gx X축 각속도 (deg/s)
+ * @param gy Y축 각속도 (deg/s)
+ * @param gz Z축 각속도 (deg/s)
+ * @param dt 샘플 간격 (s)
+ * @return const attitude_t* 갱신된 자세
+ */
+const attitude_t* attitude_estimator_update(attitude_estimator_t* est,
+                                            float ax, float ay, float az,
+                                            float gx, float gy, float gz, float dt);
+
+/**
+ * @brief 활성 필터 반환
+ * @param est 자세 추정기 구조체 포인터
+ * @return attitude_filter_type_t 현재 필터
+ */
+attitude_filter_type_t attitude_estimator_get_type(const attitude_estimator_t* est);
+
+/**
+ * @brief 피치와 피치 각속도를 Q16.16으로 반환 (고정소수점 제어 경로용)
+ *
+ * 고정소수점 칼만이 활성이면 필터 상태를 그대로 반환하고,
+ * 다른 필터이면 float 출력을 변환합니다.
+ *
+ * @param est 자세 추정기 구조체 포인터
+ * @param pitch 피치 각도 (degree, Q16.16)
+ * @param pitch_rate 피치 각속도 (degree/s, Q16.16)
+ */
+void attitude_estimator_get_pitch_q(const attitude_estimator_t* est, q16_t* pitch, q16_t* pitch_rate);
+
+/**
+ * @brief 필터 이름 반환 (로그용)
+ * @param type 필터 종류
+ * @return const char* 필터 이름
+ */
+const char* attitude_estimator_type_name(attitude_filter_type_t type);
+
+/**
+ * @brief Mahony 게인 설정
+ * @param est 자세 추정기 구조체 포인터
+ * @param kp 비례 게인 (가속도계 신뢰도)
+ * @param ki 적분 게인 (자이로 바이어스 추정 속도)
+ */
+void attitude_estimator_set_mahony_gains(attitude_estimator_t* est, float kp, float ki);
+
+/**
+ * @brief Madgwick 보정 게인 설정
+ * @param est 자세 추정기 구조체 포인터
+ * @param beta 보정 게인 (rad/s, 클수록 가속도계를 더 신뢰)
+ */
+void attitude_estimator_set_madgwick_beta(attitude_estimator_t* est, float beta);
+
+/**
+ * @brief 칼만 필터 노이즈 파라미터 설정 (피치/롤 축 공통, 고정소수점 필터 포함)
+ *
+ * 고정소수점 필터는 Q2.30으로 저장하므로 각 값은 2.0 미만이어야 합니다.
+ *
+ * @param est 자세 추정기 구조체 포인터
+ * @param q_angle 각도 프로세스 노이즈
+ * @param q_bias 바이어스 프로세스 노이즈
+ * @param r_measure 측정 노이즈
+ */
+void attitude_estimator_set_kalman_noise(attitude_estimator_t* est, float q_angle, float q_bias, float r_measure);
+
+/**
+ * @brief 상보 필터 시정수 설정
+ *
+ * 샘플 간격과 무관하게 같은 응답을 얻도록 계수는 매 샘플 tau / (tau + dt)로 계산합니다.
+ *
+ * @param est 자세 추정기 구조체 포인터
+ * @param tau 시정수 (s, 클수록 자이로를 더 신뢰)
+ */
+void attitude_estimator_set_complementary_tau(attitude_estimator_t* est, float tau);
+
+/** @} */ // ATTITUDE_ESTIMATOR_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ATTITUDE_ESTIMATOR_H
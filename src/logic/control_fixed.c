@@ -0,0 +1,125 @@
+/**
+ * @file control_fixed.c
+ * @brief 고정소수점 제어 커널 구현 파일
+ *
+ * control_kernels.h를 Q16.16/Q2.30 연산으로 인스턴스화하고,
+ * float 구조체와의 변환 함수를 제공합니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "control_fixed.h"
+
+void pid_controller_q_load(pid_controller_q_t* q, const pid_controller_t* pid) {
+    q->kp = q16_from_float(pid->kp);
+    q->ki = q16_from_float(pid->ki);
+    q->kd = q16_from_float(pid->kd);
+    q->setpoint = q16_from_float(pid->setpoint);
+    q->integral = q16_from_float(pid->integral);
+    q->previous_error = q16_from_float(pid->previous_error);
+    q->output = q16_from_float(pid->output);
+    q->output_min = q16_from_float(pid->output_min);
+    q->output_max = q16_from_float(pid->output_max);
+    q->integral_min = q16_from_float(pid->integral_min);
+    q->integral_max = q16_from_float(pid->integral_max);
+    q->first_run = pid->first_run;
+}
+
+void pid_controller_q_set_setpoint(pid_controller_q_t* q, q16_t setpoint) {
+    q->setpoint = setpoint;
+}
+
+void pid_controller_q_set_tunings(pid_controller_q_t* q, q16_t kp, q16_t ki, q16_t kd) {
+    q->kp = kp;
+    q->ki = ki;
+    q->kd = kd;
+}
+
+void pid_controller_q_reset(pid_controller_q_t* q) {
+    q->integral = 0;
+    q->previous_error = 0;
+    q->output = 0;
+    q->first_run = true;
+}
+
+void kalman_filter_q_load(kalman_filter_q_t* q, const kalman_filter_t* kf) {
+    q->Q_angle = q30_from_float(kf->Q_angle);
+    q->Q_bias = q30_from_float(kf->Q_bias);
+    q->R_measure = q30_from_float(kf->R_measure);
+    q->angle = q16_from_float(kf->angle);
+    q->bias = q16_from_float(kf->bias);
+    q->rate = q16_from_float(kf->rate);
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            q->P[i][j] = q30_from_float(kf->P[i][j]);
+        }
+        q->K[i] = 0;
+    }
+    q->y = 0;
+    q->S = 0;
+}
+
+/**
+ * @brief 게인과 제한값만 복사하고 현재 적분값/출력을 새 제한으로 클램핑
+ */
+static void pid_controller_q_load_config(pid_controller_q_t* q, const pid_controller_t* pid) {
+    pid_controller_q_set_tunings(q, q16_from_float(pid->kp), q16_from_float(pid->ki), q16_from_float(pid->kd));
+    q->output_min = q16_from_float(pid->output_min);
+    q->output_max = q16_from_float(pid->output_max);
+    q->integral_min = q16_from_float(pid->integral_min);
+    q->integral_max = q16_from_float(pid->integral_max);
+    if (q->output > q->output_max) q->output = q->output_max;
+    else if (q->output < q->output_min) q->output = q->output_min;
+    if (q->integral > q->integral_max) q->integral = q->integral_max;
+    else if (q->integral < q->integral_min) q->integral = q->integral_min;
+}
+
+void balance_pid_q_load(balance_pid_q_t* q, const balance_pid_t* bp) {
+    pid_controller_q_load(&q->pitch_pid, &bp->pitch_pid);
+    pid_controller_q_load(&q->velocity_pid, &bp->velocity_pid);
+    q->target_velocity = q16_from_float(bp->target_velocity);
+    q->max_tilt_angle = q16_from_float(bp->max_tilt_angle);
+    q->angle_offset = q16_from_float(bp->angle_offset);
+    q->velocity_divider = bp->velocity_divider;
+    q->velocity_counter = bp->velocity_counter;
+    q->velocity_dt = q30_from_float(bp->velocity_dt);
+    q->tilt_target = q16_from_float(bp->tilt_target);
+}
+
+void balance_pid_q_configure(balance_pid_q_t* q, const balance_pid_t* bp) {
+    pid_controller_q_load_config(&q->pitch_pid, &bp->pitch_pid);
+    pid_controller_q_load_config(&q->velocity_pid, &bp->velocity_pid);
+    q->max_tilt_angle = q16_from_float(bp->max_tilt_angle);
+    q->angle_offset = q16_from_float(bp->angle_offset);
+    if (q->velocity_divider != bp->velocity_divider) {
+        q->velocity_divider = bp->velocity_divider;
+        q->velocity_counter = 0;
+        q->velocity_dt = 0;
+    }
+}
+
+void balance_pid_q_set_target_velocity(balance_pid_q_t* q, q16_t velocity) {
+    q->target_velocity = velocity;
+    pid_controller_q_set_setpoint(&q->velocity_pid, velocity);
+}
+
+void balance_pid_q_reset(balance_pid_q_t* q) {
+    pid_controller_q_reset(&q->pitch_pid);
+    pid_controller_q_reset(&q->velocity_pid);
+    q->velocity_counter = 0;
+    q->velocity_dt = 0;
+    q->tilt_target = q->angle_offset;
+}
+
+#define CK_FIXED_POINT  1
+#define CK_PID_T        pid_controller_q_t
+#define CK_PID_COMPUTE  pid_controller_q_compute
+#define CK_PID_COMPUTE_RATE pid_controller_q_compute_rate
+#define CK_KALMAN_T     kalman_filter_q_t
+#define CK_KALMAN_UPDATE kalman_filter_q_get_angle
+#define CK_BALANCE_T    balance_pid_q_t
+#define CK_BALANCE_UPDATE_TILT balance_pid_q_update_tilt_target
+#define CK_BALANCE_COMPUTE balance_pid_q_compute_balance
+#include "control_kernels.h"
@@ -0,0 +1,218 @@
+/**
+ * @file control_fixed.h
+ * @brief 고정소수점 제어 커널 (PID, 칼만, 캐스케이드 밸런싱) 헤더 파일
+ *
+ * pid_controller / kalman_filter / balance_pid와 같은 커널 코드(control_kernels.h)를
+ * Q16.16 신호 값과 Q2.30 샘플 간격/공분산으로 인스턴스화한 고정소수점 구현입니다.
+ * 각도/각속도/속도를 받아 모터 출력을 내기까지 정수 연산만 사용합니다.
+ *
+ * 게인과 제한값은 float 구조체에서 그대로 가져오므로 튜닝 API는 float 쪽을 사용합니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef CONTROL_FIXED_H
+#define CONTROL_FIXED_H
+
+#include "fixed_point.h"
+#include "pid_controller.h"
+#include "kalman_filter.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct pid_controller_q_t
+ * @brief 고정소수점 PID 제어기 (필드 의미는 pid_controller_t와 동일, Q16.16)
+ */
+typedef struct {
+    q16_t kp, ki, kd;        ///< PID 게인
+    q16_t setpoint;          ///< 목표값
+    q16_t integral;          ///< 적분 누적값
+    q16_t previous_error;    ///< 이전 오차
+    q16_t output;            ///< 현재 출력값
+    q16_t output_min;        ///< 출력 최솟값
+    q16_t output_max;        ///< 출력 최댓값
+    q16_t integral_min;      ///< 적분 누적값 최솟값
+    q16_t integral_max;      ///< 적분 누적값 최댓값
+    bool first_run;          ///< 첫 실행 플래그
+} pid_controller_q_t;
+
+/**
+ * @struct kalman_filter_q_t
+ * @brief 고정소수점 칼만 필터 (필드 의미는 kalman_filter_t와 동일)
+ *
+ * 각도/바이어스/혁신은 Q16.16, 노이즈 분산/공분산/게인은 Q2.30입니다.
+ * 갱신 후 P[0][0]은 R_measure보다 작으므로 R_measure < 1이면 범위를 넘지 않습니다.
+ */
+typedef struct {
+    q30_t Q_angle;      ///< 각도 프로세스 노이즈 분산
+    q30_t Q_bias;       ///< 바이어스 프로세스 노이즈 분산
+    q30_t R_measure;    ///< 측정 노이즈 분산
+    q16_t angle;        ///< 추정된 각도 (degree)
+    q16_t bias;         ///< 추정된 자이로 바이어스 (degree/s)
+    q16_t rate;         ///< 바이어스 보정된 각속도 (degree/s)
+    q30_t P[2][2];      ///< 오차 공분산 행렬
+    q30_t K[2];         ///< 칼만 게인 벡터
+    q16_t y;            ///< 혁신
+    q30_t S;            ///< 혁신 공분산
+} kalman_filter_q_t;
+
+/**
+ * @struct balance_pid_q_t
+ * @brief 고정소수점 캐스케이드 밸런싱 제어기 (필드 의미는 balance_pid_t와 동일)
+ *
+ * 기울기/속도는 Q16.16, 속도 루프 누적 시간은 Q2.30입니다.
+ * 누적 시간은 2초에서 포화하지만 분주비 × 최대 dt보다 충분히 큽니다.
+ */
+typedef struct {
+    pid_controller_q_t pitch_pid;     ///< 피치 각도 제어 PID (내부 루프)
+    pid_controller_q_t velocity_pid;  ///< 속도 제어 PID (외부 루프)
+    q16_t target_velocity;            ///< 목표 이동 속도 (cm/s)
+    q16_t max_tilt_angle;             ///< 최대 허용 기울기 각도 (degree)
+    q16_t angle_offset;               ///< 기준 기울기 각도 (degree)
+    uint32_t velocity_divider;        ///< 속도 루프 분주비
+    uint32_t velocity_counter;        ///< 분주 카운터
+    q30_t velocity_dt;                ///< 마지막 속도 루프 실행 후 누적 시간 (초)
+    q16_t tilt_target;                ///< 속도 루프가 만든 목표 기울기 (degree)
+} balance_pid_q_t;
+
+/**
+ * @defgroup CONTROL_FIXED_API 고정소수점 제어 커널 API
+ * @{
+ */
+
+/**
+ * @brief float PID 설정을 고정소수점 PID로 변환
+ *
+ * 게인, 목표값, 출력 제한과 현재 상태를 모두 복사합니다.
+ *
+ * @param q 고정소수점 PID 구조체 포인터
+ * @param pid 원본 float PID 구조체 포인터
+ */
+void pid_controller_q_load(pid_controller_q_t* q, const pid_controller_t* pid);
+
+/**
+ * @brief 목표값 설정
+ * @param q 고정소수점 PID 구조체 포인터
+ * @param setpoint 목표값 (Q16.16)
+ */
+void pid_controller_q_set_setpoint(pid_controller_q_t* q, q16_t setpoint);
+
+/**
+ * @brief 게인 설정 (적분/이전 오차 상태는 유지)
+ * @param q 고정소수점 PID 구조체 포인터
+ * @param kp 비례 게인 (Q16.16)
+ * @param ki 적분 게인 (Q16.16)
+ * @param kd 미분 게인 (Q16.16)
+ */
+void pid_controller_q_set_tunings(pid_controller_q_t* q, q16_t kp, q16_t ki, q16_t kd);
+
+/**
+ * @brief PID 상태 리셋 (적분, 이전 오차, 출력)
+ * @param q 고정소수점 PID 구조체 포인터
+ */
+void pid_controller_q_reset(pid_controller_q_t* q);
+
+/**
+ * @brief 고정소수점 PID 제어 계산 (pid_controller_compute와 같은 커널)
+ * @param q 고정소수점 PID 구조체 포인터
+ * @param input 현재 측정값 (Q16.16)
+ * @param dt 샘플링 시간 간격 (초, Q2.30)
+ * @return q16_t 제어 출력 (Q16.16)
+ */
+q16_t pid_controller_q_compute(pid_controller_q_t* q, q16_t input, q30_t dt);
+
+/**
+ * @brief 고정소수점 측정 미분 PID 계산 (pid_controller_compute_rate와 같은 커널)
+ * @param q 고정소수점 PID 구조체 포인터
+ * @param input 현재 측정값 (Q16.16)
+ * @param input_rate 측정값의 변화율 (Q16.16)
+ * @param dt 샘플링 시간 간격 (초, Q2.30)
+ * @return q16_t 제어 출력 (Q16.16)
+ */
+q16_t pid_controller_q_compute_rate(pid_controller_q_t* q, q16_t input, q16_t input_rate, q30_t dt);
+
+/**
+ * @brief float 칼만 필터 설정/상태를 고정소수점 칼만 필터로 변환
+ * @param q 고정소수점 칼만 구조체 포인터
+ * @param kf 원본 float 칼만 구조체 포인터
+ */
+void kalman_filter_q_load(kalman_filter_q_t* q, const kalman_filter_t* kf);
+
+/**
+ * @brief 고정소수점 칼만 갱신 (kalman_filter_get_angle과 같은 커널)
+ * @param q 고정소수점 칼만 구조체 포인터
+ * @param new_angle 가속도계 각도 (degree, Q16.16)
+ * @param new_rate 자이로 각속도 (degree/s, Q16.16)
+ * @param dt 샘플링 시간 간격 (초, Q2.30)
+ * @return q16_t 추정된 각도 (degree, Q16.16)
+ */
+q16_t kalman_filter_q_get_angle(kalman_filter_q_t* q, q16_t new_angle, q16_t new_rate, q30_t dt);
+
+/**
+ * @brief float 밸런싱 제어기의 설정과 상태를 고정소수점 제어기로 변환
+ * @param q 고정소수점 밸런싱 구조체 포인터
+ * @param bp 원본 float 밸런싱 구조체 포인터
+ */
+void balance_pid_q_load(balance_pid_q_t* q, const balance_pid_t* bp);
+
+/**
+ * @brief float 밸런싱 제어기의 설정만 반영 (적분/분주 상태는 유지)
+ *
+ * 게인, 출력/적분 제한, 최대 기울기, 기준 기울기를 복사하고 현재 적분값과 출력을
+ * 새 제한으로 클램핑합니다. 분주비가 바뀐 경우에만 분주 카운터와 누적 시간을 초기화합니다.
+ *
+ * @param q 고정소수점 밸런싱 구조체 포인터
+ * @param bp 원본 float 밸런싱 구조체 포인터
+ */
+void balance_pid_q_configure(balance_pid_q_t* q, const balance_pid_t* bp);
+
+/**
+ * @brief 목표 이동 속도 설정
+ * @param q 고정소수점 밸런싱 구조체 포인터
+ * @param velocity 목표 속도 (cm/s, Q16.16)
+ */
+void balance_pid_q_set_target_velocity(balance_pid_q_t* q, q16_t velocity);
+
+/**
+ * @brief 속도 루프 갱신 (balance_pid_update_tilt_target과 같은 커널)
+ * @param q 고정소수점 밸런싱 구조체 포인터
+ * @param current_velocity 현재 이동 속도 (cm/s, Q16.16)
+ * @param dt 내부 루프 샘플링 시간 간격 (초, Q2.30)
+ * @return q16_t 목표 기울기 각도 (degree, Q16.16)
+ */
+q16_t balance_pid_q_update_tilt_target(balance_pid_q_t* q, q16_t current_velocity, q30_t dt);
+
+/**
+ * @brief 캐스케이드 밸런싱 계산 (balance_pid_compute_balance와 같은 커널)
+ *
+ * 최대 기울기 각도를 넘으면 0을 반환합니다.
+ *
+ * @param q 고정소수점 밸런싱 구조체 포인터
+ * @param current_angle 현재 피치 각도 (degree, Q16.16)
+ * @param gyro_rate 현재 각속도 (degree/s, Q16.16)
+ * @param current_velocity 현재 이동 속도 (cm/s, Q16.16)
+ * @param dt 샘플링 시간 간격 (초, Q2.30)
+ * @return q16_t 모터 출력 (Q16.16)
+ */
+q16_t balance_pid_q_compute_balance(balance_pid_q_t* q, q16_t current_angle, q16_t gyro_rate,
+                                    q16_t current_velocity, q30_t dt);
+
+/**
+ * @brief 밸런싱 제어기 리셋 (balance_pid_reset과 동일)
+ * @param q 고정소수점 밸런싱 구조체 포인터
+ */
+void balance_pid_q_reset(balance_pid_q_t* q);
+
+/** @} */ // CONTROL_FIXED_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CONTROL_FIXED_H
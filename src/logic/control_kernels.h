@@ -0,0 +1,289 @@
+/**
+ * @file control_kernels.h
+ * @brief PID / 칼만 제어 커널 템플릿 (헤더 전용, 여러 번 포함)
+ *
+ * 제어 커널 본문을 산술 연산 매크로로 한 번만 작성하고, 포함하는 쪽에서
+ * float 또는 고정소수점으로 인스턴스화합니다. float 빌드와 고정소수점 빌드가
+ * 같은 알고리즘 코드를 공유하므로 두 구현이 어긋나지 않습니다.
+ *
+ * 포함 전에 정의하는 매크로:
+ * - CK_FIXED_POINT: 1이면 Q16.16/Q2.30 연산, 0이면 float 연산
+ * - CK_PID_T, CK_PID_COMPUTE: PID 상태 구조체 타입과 생성할 함수 이름 (선택)
+ * - CK_PID_COMPUTE_RATE: 측정 각속도를 D항으로 쓰는 PID 함수 이름 (선택, CK_PID_T 필요)
+ * - CK_KALMAN_T, CK_KALMAN_UPDATE: 칼만 상태 구조체 타입과 생성할 함수 이름 (선택)
+ * - CK_BALANCE_T, CK_BALANCE_UPDATE_TILT, CK_BALANCE_COMPUTE: 캐스케이드 밸런싱 구조체 타입과
+ *   생성할 속도 루프/전체 캐스케이드 함수 이름 (선택, CK_PID_T와 CK_PID_COMPUTE_RATE 필요)
+ *
+ * 상태 구조체는 pid_controller_t / kalman_filter_t / balance_pid_t와 같은 필드 이름을 가져야 합니다.
+ * 신호 값(CK_SIG_T)과 작은 값(샘플 간격, 공분산, 게인: CK_COV_T)은 고정소수점에서
+ * 서로 다른 형식을 쓰므로 연산 매크로도 구분됩니다.
+ *
+ * 포함이 끝나면 모든 CK_ 매크로를 해제하므로 한 번역 단위에서 여러 번 포함할 수 있습니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+// Intentionally no include guard: each inclusion instantiates the kernels once
+
+#if CK_FIXED_POINT
+#include "fixed_point.h"
+#define CK_SIG_T                q16_t
+#define CK_COV_T                q30_t
+#define CK_SIG_ZERO             0
+#define CK_COV_ZERO             0
+#define CK_SIG_ADD(a, b)        q_add((a), (b))
+#define CK_SIG_SUB(a, b)        q_sub((a), (b))
+#define CK_SIG_MUL(a, b)        q16_mul((a), (b))
+#define CK_SIG_DIV(a, b)        q16_div((a), (b))
+#define CK_SIG_DIV_COV(s, c)    q16_div_q30((s), (c))
+#define CK_COV_MUL_SIG(c, s)    q30_mul_q16((c), (s))
+#define CK_COV_ADD(a, b)        q_add((a), (b))
+#define CK_COV_SUB(a, b)        q_sub((a), (b))
+#define CK_COV_MUL(a, b)        q30_mul((a), (b))
+#define CK_COV_DIV(a, b)        q30_div((a), (b))
+#else
+#define CK_SIG_T                float
+#define CK_COV_T                float
+#define CK_SIG_ZERO             0.0f
+#define CK_COV_ZERO             0.0f
+#define CK_SIG_ADD(a, b)        ((a) + (b))
+#define CK_SIG_SUB(a, b)        ((a) - (b))
+#define CK_SIG_MUL(a, b)        ((a) * (b))
+#define CK_SIG_DIV(a, b)        ((a) / (b))
+#define CK_SIG_DIV_COV(s, c)    ((s) / (c))
+#define CK_COV_MUL_SIG(c, s)    ((c) * (s))
+#define CK_COV_ADD(a, b)        ((a) + (b))
+#define CK_COV_SUB(a, b)        ((a) - (b))
+#define CK_COV_MUL(a, b)        ((a) * (b))
+#define CK_COV_DIV(a, b)        ((a) / (b))
+#endif
+
+#ifdef CK_PID_T
+/**
+ * @brief PID 제어 계산 커널
+ *
+ * Output = Kp*error + Ki*integral + Kd*derivative
+ * - 첫 실행 시 미분 킥 방지 (0 반환)
+ * - 잘못된 시간 간격이면 직전 출력 유지
+ * - 적분값은 적분 제한, 출력은 출력 제한으로 포화
+ *
+ * @param pid PID 상태 구조체 포인터
+ * @param input 현재 측정값
+ * @param dt 샘플링 시간 간격 (초)
+ * @return 계산된 제어 출력
+ */
+CK_SIG_T CK_PID_COMPUTE(CK_PID_T* pid, CK_SIG_T input, CK_COV_T dt) {
+    if (pid->first_run) {
+        pid->previous_error = CK_SIG_SUB(pid->setpoint, input);
+        pid->first_run = false;
+        return CK_SIG_ZERO; // 첫 실행 시 미분 킥 방지
+    }
+
+    if (dt <= 0) return pid->output; // 잘못된 시간 간격 처리
+
+    CK_SIG_T error = CK_SIG_SUB(pid->setpoint, input);
+
+    // 적분 계산 및 와인드업 방지
+    pid->integral = CK_SIG_ADD(pid->integral, CK_COV_MUL_SIG(dt, error));
+    if (pid->integral > pid->integral_max) pid->integral = pid->integral_max;
+    else if (pid->integral < pid->integral_min) pid->integral = pid->integral_min;
+
+    // 미분 계산
+    CK_SIG_T derivative = CK_SIG_DIV_COV(CK_SIG_SUB(error, pid->previous_error), dt);
+
+    // PID 출력 계산
+    pid->output = CK_SIG_ADD(CK_SIG_ADD(CK_SIG_MUL(pid->kp, error),
+                                        CK_SIG_MUL(pid->ki, pid->integral)),
+                             CK_SIG_MUL(pid->kd, derivative));
+
+    // 출력 제한
+    if (pid->output > pid->output_max) pid->output = pid->output_max;
+    else if (pid->output < pid->output_min) pid->output = pid->output_min;
+
+    pid->previous_error = error;
+
+    return pid->output;
+}
+#endif // CK_PID_T
+
+#if defined(CK_PID_T) && defined(CK_PID_COMPUTE_RATE)
+/**
+ * @brief 측정 미분 PID 제어 계산 커널
+ *
+ * Output = Kp*error + Ki*integral - Kd*input_rate
+ * - 오차를 미분하지 않고 측정된 변화율(자이로 각속도)을 D항으로 사용하므로
+ *   미분 노이즈와 목표값 변경 시의 미분 킥이 없습니다
+ * - 잘못된 시간 간격이면 직전 출력 유지
+ * - 적분값은 적분 제한, 출력은 출력 제한으로 포화
+ *
+ * @param pid PID 상태 구조체 포인터
+ * @param input 현재 측정값
+ * @param input_rate 측정값의 변화율 (단위/s)
+ * @param dt 샘플링 시간 간격 (초)
+ * @return 계산된 제어 출력
+ */
+CK_SIG_T CK_PID_COMPUTE_RATE(CK_PID_T* pid, CK_SIG_T input, CK_SIG_T input_rate, CK_COV_T dt) {
+    if (dt <= 0) return pid->output; // 잘못된 시간 간격 처리
+
+    CK_SIG_T error = CK_SIG_SUB(pid->setpoint, input);
+
+    // 적분 계산 및 와인드업 방지
+    pid->integral = CK_SIG_ADD(pid->integral, CK_COV_MUL_SIG(dt, error));
+    if (pid->integral > pid->integral_max) pid->integral = pid->integral_max;
+    else if (pid->integral < pid->integral_min) pid->integral = pid->integral_min;
+
+    // PID 출력 계산 (D항: 측정 변화율의 음수)
+    pid->output = CK_SIG_SUB(CK_SIG_ADD(CK_SIG_MUL(pid->kp, error),
+                                        CK_SIG_MUL(pid->ki, pid->integral)),
+                             CK_SIG_MUL(pid->kd, input_rate));
+
+    // 출력 제한
+    if (pid->output > pid->output_max) pid->output = pid->output_max;
+    else if (pid->output < pid->output_min) pid->output = pid->output_min;
+
+    pid->previous_error = error;
+    pid->first_run = false;
+
+    return pid->output;
+}
+#endif // CK_PID_COMPUTE_RATE
+
+#ifdef CK_KALMAN_T
+/**
+ * @brief 2상태(각도, 바이어스) 칼만 필터 갱신 커널
+ *
+ * 1. 예측: 바이어스 보정 각속도로 각도 적분, 공분산 전파
+ * 2. 갱신: 가속도계 각도와의 혁신으로 칼만 게인 계산 후 상태/공분산 보정
+ *
+ * @param kf 칼만 상태 구조체 포인터
+ * @param new_angle 가속도계로부터 계산된 각도 (degree)
+ * @param new_rate 자이로스코프 각속도 (degree/s)
+ * @param dt 샘플링 시간 간격 (s)
+ * @return 추정된 각도 (degree)
+ */
+CK_SIG_T CK_KALMAN_UPDATE(CK_KALMAN_T* kf, CK_SIG_T new_angle, CK_SIG_T new_rate, CK_COV_T dt) {
+    kf->rate = CK_SIG_SUB(new_rate, kf->bias);
+    kf->angle = CK_SIG_ADD(kf->angle, CK_COV_MUL_SIG(dt, kf->rate));
+
+    kf->P[0][0] = CK_COV_ADD(kf->P[0][0],
+                             CK_COV_MUL(dt, CK_COV_ADD(CK_COV_SUB(CK_COV_SUB(CK_COV_MUL(dt, kf->P[1][1]),
+                                                                             kf->P[0][1]),
+                                                                  kf->P[1][0]),
+                                                       kf->Q_angle)));
+    kf->P[0][1] = CK_COV_SUB(kf->P[0][1], CK_COV_MUL(dt, kf->P[1][1]));
+    kf->P[1][0] = CK_COV_SUB(kf->P[1][0], CK_COV_MUL(dt, kf->P[1][1]));
+    kf->P[1][1] = CK_COV_ADD(kf->P[1][1], CK_COV_MUL(kf->Q_bias, dt));
+
+    kf->S = CK_COV_ADD(kf->P[0][0], kf->R_measure);
+    kf->K[0] = CK_COV_DIV(kf->P[0][0], kf->S);
+    kf->K[1] = CK_COV_DIV(kf->P[1][0], kf->S);
+
+    kf->y = CK_SIG_SUB(new_angle, kf->angle);
+
+    kf->angle = CK_SIG_ADD(kf->angle, CK_COV_MUL_SIG(kf->K[0], kf->y));
+    kf->bias = CK_SIG_ADD(kf->bias, CK_COV_MUL_SIG(kf->K[1], kf->y));
+
+    CK_COV_T P00_temp = kf->P[0][0];
+    CK_COV_T P01_temp = kf->P[0][1];
+
+    kf->P[0][0] = CK_COV_SUB(kf->P[0][0], CK_COV_MUL(kf->K[0], P00_temp));
+    kf->P[0][1] = CK_COV_SUB(kf->P[0][1], CK_COV_MUL(kf->K[0], P01_temp));
+    kf->P[1][0] = CK_COV_SUB(kf->P[1][0], CK_COV_MUL(kf->K[1], P00_temp));
+    kf->P[1][1] = CK_COV_SUB(kf->P[1][1], CK_COV_MUL(kf->K[1], P01_temp));
+
+    return kf->angle;
+}
+#endif // CK_KALMAN_T
+
+#if defined(CK_BALANCE_T) && defined(CK_PID_T) && defined(CK_PID_COMPUTE_RATE)
+/**
+ * @brief 속도 루프 갱신 커널 (외부 루프, 분주된 주기)
+ *
+ * 호출마다 dt를 누적하고, 분주비만큼 호출될 때마다 누적된 시간으로
+ * 속도 PID를 한 번 실행합니다. 그 사이에는 직전 목표 기울기를 유지합니다.
+ * 적분 제한이 출력 제한 그대로면 Ki가 작을 때 적분항이 경사면에 필요한
+ * 기울기를 만들지 못하므로, 적분 제한을 출력 제한 / Ki로 다시 계산합니다.
+ *
+ * @param bp 밸런싱 상태 구조체 포인터
+ * @param current_velocity 현재 이동 속도 (cm/s)
+ * @param dt 내부 루프 샘플링 시간 간격 (초)
+ * @return 목표 기울기 각도 (degree)
+ */
+CK_SIG_T CK_BALANCE_UPDATE_TILT(CK_BALANCE_T* bp, CK_SIG_T current_velocity, CK_COV_T dt) {
+    bp->velocity_dt = CK_COV_ADD(bp->velocity_dt, dt);
+    if (bp->velocity_counter == 0) {
+        CK_PID_T* velocity_pid = &bp->velocity_pid;
+        // The integral term alone may span the whole tilt range: holding on a slope needs a standing lean
+        if (velocity_pid->ki > CK_SIG_ZERO) {
+            velocity_pid->integral_min = CK_SIG_DIV(velocity_pid->output_min, velocity_pid->ki);
+            velocity_pid->integral_max = CK_SIG_DIV(velocity_pid->output_max, velocity_pid->ki);
+            if (velocity_pid->integral > velocity_pid->integral_max) velocity_pid->integral = velocity_pid->integral_max;
+            else if (velocity_pid->integral < velocity_pid->integral_min) velocity_pid->integral = velocity_pid->integral_min;
+        }
+        CK_SIG_T velocity_adjustment = CK_PID_COMPUTE(velocity_pid, current_velocity, bp->velocity_dt);
+        bp->tilt_target = CK_SIG_ADD(bp->angle_offset, velocity_adjustment);
+        bp->velocity_dt = CK_COV_ZERO;
+    }
+    if (++bp->velocity_counter >= bp->velocity_divider) {
+        bp->velocity_counter = 0;
+    }
+    return bp->tilt_target;
+}
+
+/**
+ * @brief 캐스케이드 밸런싱 커널
+ *
+ * 1. 속도 PID (외부, 분주된 주기): 현재 속도와 목표 속도의 차이로 목표 기울기 각도 계산
+ * 2. 각도 PID (내부, 매 주기): 목표 기울기와 현재 각도의 차이로 모터 출력 계산,
+ *    D항은 자이로 각속도를 직접 사용 (각도 오차를 미분하지 않음)
+ *
+ * 안전 기능: 최대 기울기 각도 초과 시 모터 정지
+ *
+ * @param bp 밸런싱 상태 구조체 포인터
+ * @param current_angle 현재 피치 각도 (degree)
+ * @param gyro_rate 현재 각속도 (degree/s)
+ * @param current_velocity 현재 이동 속도 (cm/s)
+ * @param dt 샘플링 시간 간격 (초)
+ * @return 모터 출력
+ */
+CK_SIG_T CK_BALANCE_COMPUTE(CK_BALANCE_T* bp, CK_SIG_T current_angle, CK_SIG_T gyro_rate,
+                            CK_SIG_T current_velocity, CK_COV_T dt) {
+    // 안전 검사: 로봇이 넘어졌는지 확인
+    CK_SIG_T abs_angle = (current_angle > CK_SIG_ZERO) ? current_angle : CK_SIG_SUB(CK_SIG_ZERO, current_angle);
+    if (abs_angle > bp->max_tilt_angle) {
+        return CK_SIG_ZERO; // 로봇이 넘어짐, 모터 정지
+    }
+
+    // 1단계: 속도 제어 - 목표 기울기 각도 계산
+    bp->pitch_pid.setpoint = CK_BALANCE_UPDATE_TILT(bp, current_velocity, dt);
+
+    // 2단계: 각도 제어 - 모터 출력 계산
+    return CK_PID_COMPUTE_RATE(&bp->pitch_pid, current_angle, gyro_rate, dt);
+}
+#endif // CK_BALANCE_T
+
+#undef CK_SIG_T
+#undef CK_COV_T
+#undef CK_SIG_ZERO
+#undef CK_COV_ZERO
+#undef CK_SIG_ADD
+#undef CK_SIG_SUB
+#undef CK_SIG_MUL
+#undef CK_SIG_DIV
+#undef CK_SIG_DIV_COV
+#undef CK_COV_MUL_SIG
+#undef CK_COV_ADD
+#undef CK_COV_SUB
+#undef CK_COV_MUL
+#undef CK_COV_DIV
+#undef CK_FIXED_POINT
+#undef CK_PID_T
+#undef CK_PID_COMPUTE
+#undef CK_PID_COMPUTE_RATE
+#undef CK_KALMAN_T
+#undef CK_KALMAN_UPDATE
+#undef CK_BALANCE_T
+#undef CK_BALANCE_UPDATE_TILT
+#undef CK_BALANCE_COMPUTE
@@ -0,0 +1,180 @@
+/**
+ * @file fixed_point.h
+ * @brief 고정소수점 산술 헤더 (헤더 전용)
+ *
+ * 제어 커널의 고정소수점 빌드에서 사용하는 두 가지 형식을 정의합니다.
+ * - Q16.16 (q16_t): 각도, 각속도, 오차, PID 게인과 출력 등 신호 값 (범위 ±32768, 분해능 1.5e-5)
+ * - Q2.30 (q30_t): 샘플 간격, 칼만 공분산/게인 등 1 미만의 작은 값 (범위 ±2, 분해능 9.3e-10)
+ *
+ * 곱셈/나눗셈은 64비트 중간값으로 계산하고 반올림하며, 모든 연산은 포화합니다.
+ * 1ms 샘플 간격을 Q16.16으로 표현하면 1.5% 오차가 생기므로 dt는 Q2.30을 사용합니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int32_t q16_t;  ///< Q16.16 부호 있는 고정소수점
+typedef int32_t q30_t;  ///< Q2.30 부호 있는 고정소수점
+
+#define Q16_FRAC_BITS   16                  ///< Q16.16 소수부 비트 수
+#define Q30_FRAC_BITS   30                  ///< Q2.30 소수부 비트 수
+#define Q16_ONE         ((q16_t)1 << Q16_FRAC_BITS) ///< Q16.16의 1.0
+#define Q30_ONE         ((q30_t)1 << Q30_FRAC_BITS) ///< Q2.30의 1.0
+#define Q_MAX           INT32_MAX           ///< 포화 상한
+#define Q_MIN           INT32_MIN           ///< 포화 하한
+
+/**
+ * @brief 64비트 중간값을 32비트로 포화
+ */
+static inline int32_t q_sat(int64_t v) {
+    if (v > Q_MAX) return Q_MAX;
+    if (v < Q_MIN) return Q_MIN;
+    return (int32_t)v;
+}
+
+/**
+ * @brief 반올림 산술 오른쪽 시프트
+ */
+static inline int64_t q_round_shift(int64_t v, int bits) {
+    return (v + ((int64_t)1 << (bits - 1))) >> bits;
+}
+
+/** @brief float → Q16.16 (반올림, 포화) */
+static inline q16_t q16_from_float(float f) {
+    float scaled = f * (float)Q16_ONE;
+    if (scaled >= 2147483647.0f) return Q_MAX;
+    if (scaled <= -2147483648.0f) return Q_MIN;
+    return (q16_t)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+/** @brief Q16.16 → float */
+static inline float q16_to_float(q16_t q) {
+    return (float)q / (float)Q16_ONE;
+}
+
+/** @brief Q16.16 → 정수 (0 방향 버림, float 캐스트와 같은 규칙) */
+static inline int32_t q16_to_int(q16_t q) {
+    return (q >= 0) ? (q >> Q16_FRAC_BITS) : -((-(int64_t)q) >> Q16_FRAC_BITS);
+}
+
+/** @brief float → Q2.30 (반올림, 포화) */
+static inline q30_t q30_from_float(float f) {
+    float scaled = f * (float)Q30_ONE;
+    if (scaled >= 2147483647.0f) return Q_MAX;
+    if (scaled <= -2147483648.0f) return Q_MIN;
+    return (q30_t)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+/** @brief Q2.30 → float */
+static inline float q30_to_float(q30_t q) {
+    return (float)q / (float)Q30_ONE;
+}
+
+/** @brief 포화 덧셈 (같은 형식) */
+static inline int32_t q_add(int32_t a, int32_t b) {
+    return q_sat((int64_t)a + b);
+}
+
+/** @brief 포화 뺄셈 (같은 형식) */
+static inline int32_t q_sub(int32_t a, int32_t b) {
+    return q_sat((int64_t)a - b);
+}
+
+/** @brief Q16.16 × Q16.16 → Q16.16 */
+static inline q16_t q16_mul(q16_t a, q16_t b) {
+    return q_sat(q_round_shift((int64_t)a * b, Q16_FRAC_BITS));
+}
+
+/** @brief Q2.30 × Q2.30 → Q2.30 */
+static inline q30_t q30_mul(q30_t a, q30_t b) {
+    return q_sat(q_round_shift((int64_t)a * b, Q30_FRAC_BITS));
+}
+
+/** @brief Q2.30 × Q16.16 → Q16.16 (dt·rate, 칼만 게인·혁신) */
+static inline q16_t q30_mul_q16(q30_t c, q16_t s) {
+    return q_sat(q_round_shift((int64_t)c * s, Q30_FRAC_BITS));
+}
+
+/** @brief Q2.30 ÷ Q2.30 → Q2.30 (b가 0이면 부호에 맞게 포화) */
+static inline q30_t q30_div(q30_t a, q30_t b) {
+    if (b == 0) return (a >= 0) ? Q_MAX : Q_MIN;
+    return q_sat(((int64_t)a * Q30_ONE) / b);
+}
+
+/** @brief Q16.16 ÷ Q2.30 → Q16.16 (오차 변화 / dt, b가 0이면 부호에 맞게 포화) */
+static inline q16_t q16_div_q30(q16_t a, q30_t b) {
+    if (b == 0) return (a >= 0) ? Q_MAX : Q_MIN;
+    return q_sat(((int64_t)a * Q30_ONE) / b);
+}
+
+/** @brief Q16.16 ÷ Q16.16 → Q16.16 (출력 제한 / Ki, b가 0이면 부호에 맞게 포화) */
+static inline q16_t q16_div(q16_t a, q16_t b) {
+    if (b == 0) return (a >= 0) ? Q_MAX : Q_MIN;
+    return q_sat(((int64_t)a * Q16_ONE) / b);
+}
+
+/**
+ * @brief sqrt(a² + b²) (Q16.16, 버림)
+ *
+ * 제곱합을 Q32.32 64비트로 모아 정수 제곱근을 구하므로 중간 포화가 없습니다.
+ */
+static inline q16_t q16_hypot(q16_t a, q16_t b) {
+    uint64_t sum = (uint64_t)((int64_t)a * a) + (uint64_t)((int64_t)b * b);
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > sum) bit >>= 2;
+    while (bit != 0) {
+        if (sum >= root + bit) {
+            sum -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return q_sat((int64_t)root);
+}
+
+/**
+ * @brief atan2(y, x) (degree, Q16.16)
+ *
+ * 팔분면으로 접어 0~1 구간의 atan을 9차 다항식(Abramowitz & Stegun 4.4.49,
+ * 오차 1e-5 rad)으로 계산합니다. 정수 연산 오차를 포함해 약 0.001° 이내입니다.
+ * x, y가 모두 0이면 0을 반환합니다.
+ */
+static inline q16_t q16_atan2_deg(q16_t y, q16_t x) {
+    int64_t ax = (x >= 0) ? (int64_t)x : -(int64_t)x;
+    int64_t ay = (y >= 0) ? (int64_t)y : -(int64_t)y;
+    if (ax == 0 && ay == 0) return 0;
+
+    bool swap = ay > ax;
+    int64_t z = swap ? (ax << Q16_FRAC_BITS) / ay : (ay << Q16_FRAC_BITS) / ax;  // 0..1
+    int64_t z2 = q_round_shift(z * z, Q16_FRAC_BITS);
+    int64_t p = 78234;                                           // 1.1937633°
+    p = q_round_shift(p * z2, Q16_FRAC_BITS) - 319669;           // -4.8777616°
+    p = q_round_shift(p * z2, Q16_FRAC_BITS) + 676418;           // 10.3213190°
+    p = q_round_shift(p * z2, Q16_FRAC_BITS) - 1240254;          // -18.9247673°
+    p = q_round_shift(p * z2, Q16_FRAC_BITS) + 3754433;          // 57.2881019°
+    int64_t angle = q_round_shift(p * z, Q16_FRAC_BITS);
+
+    if (swap) angle = 90 * (int64_t)Q16_ONE - angle;
+    if (x < 0) angle = 180 * (int64_t)Q16_ONE - angle;
+    return (q16_t)((y < 0) ? -angle : angle);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FIXED_POINT_H
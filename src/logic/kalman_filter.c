@@ -55,35 +55,13 @@ void kalman_filter_set_angle(kalman_filter_t* kf, float angle) {
  * 2. 업데이트 단계 (Update):
  *    - 가속도계 측정값으로 상태 보정
  *    - 칼만 게인 계산 및 상태 업데이트
+ * 
+ * 커널 본문은 control_kernels.h에 있으며 고정소수점 빌드(control_fixed.c)와 공유합니다.
  */
-float kalman_filter_get_angle(kalman_filter_t* kf, float new_angle, float new_rate, float dt) {
-    kf->rate = new_rate - kf->bias;
-    kf->angle += dt * kf->rate;
-
-    kf->P[0][0] += dt * (dt * kf->P[1][1] - kf->P[0][1] - kf->P[1][0] + kf->Q_angle);
-    kf->P[0][1] -= dt * kf->P[1][1];
-    kf->P[1][0] -= dt * kf->P[1][1];
-    kf->P[1][1] += kf->Q_bias * dt;
-
-    kf->S = kf->P[0][0] + kf->R_measure;
-    kf->K[0] = kf->P[0][0] / kf->S;
-    kf->K[1] = kf->P[1][0] / kf->S;
-
-    kf->y = new_angle - kf->angle;
-
-    kf->angle += kf->K[0] * kf->y;
-    kf->bias += kf->K[1] * kf->y;
-
-    float P00_temp = kf->P[0][0];
-    float P01_temp = kf->P[0][1];
-
-    kf->P[0][0] -= kf->K[0] * P00_temp;
-    kf->P[0][1] -= kf->K[0] * P01_temp;
-    kf->P[1][0] -= kf->K[1] * P00_temp;
-    kf->P[1][1] -= kf->K[1] * P01_temp;
-
-    return kf->angle;
-}
+#define CK_FIXED_POINT      0
+#define CK_KALMAN_T         kalman_filter_t
+#define CK_KALMAN_UPDATE    kalman_filter_get_angle
+#include "control_kernels.h"
 
 void kalman_filter_set_qangle(kalman_filter_t* kf, float Q_angle) {
     kf->Q_angle = Q_angle;
@@ -0,0 +1,261 @@
+/**
+ * @file odometry.c
+ * @brief 차동 구동 오도메트리 및 추측 항법 위치 추정기 구현
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "odometry.h"
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define DEG_TO_RAD          ((float)M_PI / 180.0f)
+#define RAD_TO_DEG          (180.0f / (float)M_PI)
+#define EARTH_RADIUS_CM     637100000.0     ///< 평균 지구 반지름 (cm)
+
+/**
+ * @brief 각도를 -pi ~ pi로 정규화
+ */
+static float wrap_pi(float angle) {
+    while (angle > (float)M_PI) {
+        angle -= 2.0f * (float)M_PI;
+    }
+    while (angle <= -(float)M_PI) {
+        angle += 2.0f * (float)M_PI;
+    }
+    return angle;
+}
+
+void odometry_init(odometry_t* odo, const odometry_config_t* config) {
+    memset(odo, 0, sizeof(*odo));
+    odo->config = *config;
+    odometry_reset(odo, 0.0f, 0.0f, 0.0f);
+}
+
+void odometry_reset(odometry_t* odo, float x_cm, float y_cm, float heading_deg) {
+    odo->x_cm = x_cm;
+    odo->y_cm = y_cm;
+    odo->heading_rad = wrap_pi(heading_deg * DEG_TO_RAD);
+    memset(odo->P, 0, sizeof(odo->P));
+    float heading_std = odo->config.initial_heading_std_deg * DEG_TO_RAD;
+    odo->P[2][2] = heading_std * heading_std;
+    odo->has_origin = false;
+    odo->heading_aligned = false;
+}
+
+void odometry_update(odometry_t* odo, int32_t left_count, int32_t right_count, float yaw_rate_dps, float dt) {
+    if (!odo->has_counts) {
+        odo->left_count = left_count;
+        odo->right_count = right_count;
+        odo->has_counts = true;
+        return;
+    }
+
+    // Count differences wrap safely, like the encoder's own accumulator
+    float dl = (float)(int32_t)((uint32_t)left_count - (uint32_t)odo->left_count) * odo->config.cm_per_count;
+    float dr = (float)(int32_t)((uint32_t)right_count - (uint32_t)odo->right_count) * odo->config.cm_per_count;
+    odo->left_count = left_count;
+    odo->right_count = right_count;
+
+    float ds = 0.5f * (dl + dr);
+    float dtheta_wheel = (dr - dl) / odo->config.wheel_base_cm;
+    float dtheta_gyro = yaw_rate_dps * DEG_TO_RAD * dt;
+    float w = odo->config.gyro_weight;
+    float dtheta = w * dtheta_gyro + (1.0f - w) * dtheta_wheel;
+
+    // Midpoint heading keeps arcs accurate at control rate
+    float mid = odo->heading_rad + 0.5f * dtheta;
+    float c = cosf(mid);
+    float s = sinf(mid);
+    odo->x_cm += ds * c;
+    odo->y_cm += ds * s;
+    odo->heading_rad = wrap_pi(odo->heading_rad + dtheta);
+    odo->align_path_cm += fabsf(ds);
+
+    // P = F P F' + Q, F = [1 0 -ds*s; 0 1 ds*c; 0 0 1]
+    float (*P)[3] = odo->P;
+    float f02 = -ds * s;
+    float f12 = ds * c;
+    float a[3][3];
+    for (int j = 0; j < 3; j++) {
+        a[0][j] = P[0][j] + f02 * P[2][j];
+        a[1][j] = P[1][j] + f12 * P[2][j];
+        a[2][j] = P[2][j];
+    }
+    for (int i = 0; i < 3; i++) {
+        P[i][0] = a[i][0] + a[i][2] * f02;
+        P[i][1] = a[i][1] + a[i][2] * f12;
+        P[i][2] = a[i][2];
+    }
+
+    // Distance noise grows along the direction of travel, heading noise with time
+    float var_s = odo->config.distance_noise * fabsf(ds);
+    float walk = odo->config.heading_walk_deg * DEG_TO_RAD;
+    P[0][0] += var_s * c * c;
+    P[0][1] += var_s * c * s;
+    P[1][0] += var_s * c * s;
+    P[1][1] += var_s * s * s;
+    P[2][2] += walk * walk * dt;
+}
+
+/**
+ * @brief 현재 고정과 추정 위치를 GPS 원점으로 설정
+ */
+static void set_gps_origin(odometry_t* odo, double latitude, double longitude) {
+    odo->origin_lat = latitude;
+    odo->origin_lon = longitude;
+    odo->origin_x_cm = odo->x_cm;
+    odo->origin_y_cm = odo->y_cm;
+    odo->align_path_cm = 0.0f;
+    odo->has_origin = true;
+}
+
+/**
+ * @brief 원점 이후의 GPS 이동 방향으로 헤딩 정렬 시도
+ *
+ * 추측 항법 이동 벡터를 원점을 중심으로 GPS 이동 벡터 방향까지 회전시키고,
+ * 헤딩 분산은 두 고정의 위치 오차가 이동 거리에 대해 만드는 각도 오차로 둡니다.
+ *
+ * @return bool 정렬했으면 true
+ */
+static bool align_heading(odometry_t* odo, double latitude, double longitude,
+                          float east, float north, float std_cm) {
+    float dx = odo->x_cm - odo->origin_x_cm;
+    float dy = odo->y_cm - odo->origin_y_cm;
+    float odo_dist = sqrtf(dx * dx + dy * dy);
+    float gps_dist = sqrtf(east * east + north * north);
+
+    // A turn since the origin breaks the single-rotation model: start over from this fix
+    if (odo_dist < 0.9f * odo->align_path_cm) {
+        set_gps_origin(odo, latitude, longitude);
+        return false;
+    }
+    if (odo_dist < odo->config.gps_align_distance_cm) {
+        return false;
+    }
+    // Both fixes carry std_cm of error; beyond that the distances must agree within wheel scale error
+    if (fabsf(gps_dist - odo_dist) > 3.0f * 1.41421356f * std_cm + 0.1f * odo_dist) {
+        return false;
+    }
+
+    float offset = wrap_pi(atan2f(north, east) - atan2f(dy, dx));
+    float c = cosf(offset);
+    float s = sinf(offset);
+    float ax = c * dx - s * dy;
+    float ay = s * dx + c * dy;
+    odo->x_cm = odo->origin_x_cm + ax;
+    odo->y_cm = odo->origin_y_cm + ay;
+    odo->heading_rad = wrap_pi(odo->heading_rad + offset);
+
+    // Position block rotates with the frame; heading error now swings the position about the origin
+    float (*P)[3] = odo->P;
+    float p00 = c * c * P[0][0] - 2.0f * c * s * P[0][1] + s * s * P[1][1];
+    float p11 = s * s * P[0][0] + 2.0f * c * s * P[0][1] + c * c * P[1][1];
+    float p01 = c * s * (P[0][0] - P[1][1]) + (c * c - s * s) * P[0][1];
+    float var_h = 2.0f * std_cm * std_cm / (gps_dist * gps_dist);
+    P[0][0] = p00 + ay * ay * var_h;
+    P[1][1] = p11 + ax * ax * var_h;
+    P[0][1] = p01 - ax * ay * var_h;
+    P[1][0] = P[0][1];
+    P[0][2] = -ay * var_h;
+    P[2][0] = P[0][2];
+    P[1][2] = ax * var_h;
+    P[2][1] = P[1][2];
+    P[2][2] = var_h;
+    odo->heading_aligned = true;
+    return true;
+}
+
+bool odometry_fuse_gps(odometry_t* odo, double latitude, double longitude, float std_cm) {
+    if (!odo->has_origin) {
+        set_gps_origin(odo, latitude, longitude);
+        odo->gps_accepted++;
+        return true;
+    }
+
+    // Local tangent plane around the origin; exact enough over the robot's range
+    double north = (latitude - odo->origin_lat) * (M_PI / 180.0) * EARTH_RADIUS_CM;
+    double east = (longitude - odo->origin_lon) * (M_PI / 180.0) * EARTH_RADIUS_CM *
+                  cos(odo->origin_lat * (M_PI / 180.0));
+
+    // Until the heading is known the position update would rotate the wrong way
+    if (!odo->heading_aligned) {
+        if (!align_heading(odo, latitude, longitude, (float)east, (float)north, std_cm)) {
+            return false;
+        }
+        // This fix already placed the frame; fusing it again would count it twice
+        odo->gps_accepted++;
+        return true;
+    }
+
+    float nu0 = (float)(odo->origin_x_cm + east - odo->x_cm);
+    float nu1 = (float)(odo->origin_y_cm + north - odo->y_cm);
+
+    // S = H P H' + R with H selecting x and y
+    float (*P)[3] = odo->P;
+    float r = std_cm * std_cm;
+    float s00 = P[0][0] + r;
+    float s01 = P[0][1];
+    float s10 = P[1][0];
+    float s11 = P[1][1] + r;
+    float det = s00 * s11 - s01 * s10;
+    if (det <= 0.0f) {
+        odo->gps_rejected++;
+        return false;
+    }
+    float i00 = s11 / det;
+    float i01 = -s01 / det;
+    float i10 = -s10 / det;
+    float i11 = s00 / det;
+
+    float d2 = nu0 * (i00 * nu0 + i01 * nu1) + nu1 * (i10 * nu0 + i11 * nu1);
+    if (d2 > odo->config.gps_gate) {
+        odo->gps_rejected++;
+        return false;
+    }
+
+    // K = P H' S^-1 (3x2)
+    float k[3][2];
+    for (int i = 0; i < 3; i++) {
+        k[i][0] = P[i][0] * i00 + P[i][1] * i10;
+        k[i][1] = P[i][0] * i01 + P[i][1] * i11;
+    }
+    odo->x_cm += k[0][0] * nu0 + k[0][1] * nu1;
+    odo->y_cm += k[1][0] * nu0 + k[1][1] * nu1;
+    odo->heading_rad = wrap_pi(odo->heading_rad + k[2][0] * nu0 + k[2][1] * nu1);
+
+    // P = (I - K H) P, then re-symmetrize against rounding
+    float hp[2][3];
+    for (int j = 0; j < 3; j++) {
+        hp[0][j] = P[0][j];
+        hp[1][j] = P[1][j];
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            P[i][j] -= k[i][0] * hp[0][j] + k[i][1] * hp[1][j];
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int j = i + 1; j < 3; j++) {
+            float m = 0.5f * (P[i][j] + P[j][i]);
+            P[i][j] = m;
+            P[j][i] = m;
+        }
+    }
+    odo->gps_accepted++;
+    return true;
+}
+
+float odometry_get_heading_deg(const odometry_t* odo) {
+    return odo->heading_rad * RAD_TO_DEG;
+}
+
+float odometry_get_position_std_cm(const odometry_t* odo) {
+    return sqrtf(0.5f * (odo->P[0][0] + odo->P[1][1]));
+}
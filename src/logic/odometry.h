@@ -0,0 +1,152 @@
+/**
+ * @file odometry.h
+ * @brief 차동 구동 오도메트리 및 추측 항법 위치 추정기
+ *
+ * 좌우 엔코더 누적 카운트와 요 각속도를 제어 주기마다 적분하여 평면 위치
+ * (x, y)와 헤딩을 추정합니다. 헤딩 증분은 바퀴 차이로 구한 값과 자이로 적분
+ * 값을 가중 평균하므로, 바퀴가 미끄러질 때는 자이로가, 자이로 바이어스가
+ * 쌓일 때는 바퀴가 서로를 보완합니다.
+ *
+ * 위치 오차 공분산을 함께 전파하는 확장 칼만 필터(EKF) 구조이므로, GPS
+ * 위치가 들어오면 선택적으로 융합할 수 있습니다. 첫 GPS 고정이 들어온
+ * 순간의 위치가 위경도 원점이 되고, 이후 고정은 원점 기준 동/북 거리(cm)로
+ * 바꿔 위치를 보정합니다. 위치와 헤딩의 상관 공분산을 통해 주행 중에는
+ * 헤딩도 함께 보정됩니다.
+ *
+ * 시작 헤딩은 북쪽 기준으로 알 수 없으므로, 원점에서 직진한 거리가
+ * gps_align_distance_cm을 넘으면 GPS 이동 방향과 추측 항법 이동 방향의 차이로
+ * 좌표계를 회전시켜 헤딩을 정렬합니다. 정렬 전에는 선형화가 성립하지 않으므로
+ * GPS 위치를 융합하지 않습니다.
+ *
+ * 좌표계: x = 동, y = 북 (GPS 미사용 시에는 시작 자세 기준), 헤딩은 x축에서
+ * 반시계 방향 (degree, -180 ~ 180). 요 각속도와 바퀴 회전은 반시계가 양수입니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef ODOMETRY_H
+#define ODOMETRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct odometry_config_t
+ * @brief 오도메트리 설정
+ */
+typedef struct {
+    float wheel_base_cm;        ///< 좌우 바퀴 접지점 간격 (cm)
+    float cm_per_count;         ///< 엔코더 카운트당 바퀴 이동 거리 (cm)
+    float gyro_weight;          ///< 헤딩 증분 중 자이로 비중 (0: 바퀴만, 1: 자이로만)
+    float distance_noise;       ///< 이동 거리 분산 증가율 (cm^2 / 이동 cm)
+    float heading_walk_deg;     ///< 헤딩 랜덤 워크 (deg / sqrt(s))
+    float initial_heading_std_deg; ///< 초기 헤딩 불확실성 (deg, GPS 정렬 전 위치 불확실성에 반영)
+    float gps_gate;             ///< GPS 혁신 게이트 (마할라노비스 거리 제곱, 넘으면 거부)
+    float gps_align_distance_cm; ///< 헤딩 정렬에 필요한 원점으로부터의 직진 거리 (cm)
+} odometry_config_t;
+
+/**
+ * @struct odometry_t
+ * @brief 오도메트리 상태
+ */
+typedef struct {
+    odometry_config_t config;   ///< 설정
+    bool has_counts;            ///< 기준 카운트 있음 (첫 갱신 전에는 false)
+    int32_t left_count;         ///< 직전 좌측 엔코더 카운트
+    int32_t right_count;        ///< 직전 우측 엔코더 카운트
+    float x_cm;                 ///< x 위치 (cm)
+    float y_cm;                 ///< y 위치 (cm)
+    float heading_rad;          ///< 헤딩 (rad, -pi ~ pi)
+    float P[3][3];              ///< 오차 공분산 (x, y, 헤딩)
+    bool has_origin;            ///< GPS 원점 설정됨
+    double origin_lat;          ///< GPS 원점 위도 (degree)
+    double origin_lon;          ///< GPS 원점 경도 (degree)
+    float origin_x_cm;          ///< GPS 원점의 x 위치 (cm)
+    float origin_y_cm;          ///< GPS 원점의 y 위치 (cm)
+    bool heading_aligned;       ///< GPS 이동 방향으로 헤딩 정렬됨 (정렬 전에는 융합하지 않음)
+    float align_path_cm;        ///< 원점 이후 주행 경로 길이 (cm, 직진 판정용)
+    uint32_t gps_accepted;      ///< 융합한 GPS 고정 수
+    uint32_t gps_rejected;      ///< 게이트로 거부한 GPS 고정 수
+} odometry_t;
+
+/**
+ * @defgroup ODOMETRY_API 오도메트리 API
+ * @brief 추측 항법 적분과 GPS 융합 함수들
+ * @{
+ */
+
+/**
+ * @brief 오도메트리 초기화 (원점, 헤딩 0에서 시작)
+ * @param odo 오도메트리
+ * @param config 설정
+ */
+void odometry_init(odometry_t* odo, const odometry_config_t* config);
+
+/**
+ * @brief 자세를 지정 값으로 재설정 (GPS 원점도 해제)
+ * @param odo 오도메트리
+ * @param x_cm x 위치 (cm)
+ * @param y_cm y 위치 (cm)
+ * @param heading_deg 헤딩 (degree)
+ */
+void odometry_reset(odometry_t* odo, float x_cm, float y_cm, float heading_deg);
+
+/**
+ * @brief 한 제어 주기 적분
+ *
+ * 첫 호출은 기준 카운트만 기록합니다. 이후에는 카운트 변화로 이동 거리와
+ * 바퀴 헤딩 증분을, yaw_rate_dps × dt로 자이로 헤딩 증분을 구해 구간 중간
+ * 헤딩으로 위치를 적분하고 공분산을 전파합니다.
+ *
+ * @param odo 오도메트리
+ * @param left_count 좌측 엔코더 누적 카운트
+ * @param right_count 우측 엔코더 누적 카운트
+ * @param yaw_rate_dps 요 각속도 (deg/s, 반시계 양수)
+ * @param dt 주기 (초)
+ */
+void odometry_update(odometry_t* odo, int32_t left_count, int32_t right_count, float yaw_rate_dps, float dt);
+
+/**
+ * @brief GPS 위치 융합 (EKF 측정 갱신)
+ *
+ * 첫 호출은 현재 추정 위치를 위경도 원점으로 삼습니다. 헤딩이 정렬되기
+ * 전에는 원점에서 직진한 거리가 충분해질 때까지 기다렸다가 좌표계를 GPS
+ * 이동 방향에 맞춰 회전시킵니다. 경로가 휘었으면 현재 고정을 새 원점으로
+ * 삼아 다시 기다립니다. 정렬 후에는 원점 기준 동/북 거리를 위치 측정값으로
+ * 보정하며, 혁신이 게이트를 넘으면 거부합니다.
+ *
+ * @param odo 오도메트리
+ * @param latitude 위도 (degree)
+ * @param longitude 경도 (degree)
+ * @param std_cm 위치 측정 표준편차 (cm)
+ * @return bool 융합했으면 true (원점 설정, 헤딩 정렬 포함), 정렬 대기 중이거나 거부했으면 false
+ */
+bool odometry_fuse_gps(odometry_t* odo, double latitude, double longitude, float std_cm);
+
+/**
+ * @brief 헤딩 읽기
+ * @param odo 오도메트리
+ * @return float 헤딩 (degree, -180 ~ 180)
+ */
+float odometry_get_heading_deg(const odometry_t* odo);
+
+/**
+ * @brief 위치 불확실성 읽기
+ * @param odo 오도메트리
+ * @return float x, y 표준편차의 RMS (cm)
+ */
+float odometry_get_position_std_cm(const odometry_t* odo);
+
+/** @} */ // ODOMETRY_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ODOMETRY_H
@@ -29,6 +29,8 @@ void pid_controller_init(pid_controller_t* pid, float Kp, float Ki, float Kd) {
     pid->output = 0.0f;
     pid->output_min = -255.0f;
     pid->output_max = 255.0f;
+    pid->integral_min = -255.0f;
+    pid->integral_max = 255.0f;
     pid->first_run = true;
 }
 
@@ -58,6 +60,7 @@ void pid_controller_set_setpoint(pid_controller_t* pid, float sp) {
  * 
  * PID 출력값의 상한/하한을 설정하고, 현재 출력과 적분값이
  * 제한 범위를 벗어나면 즉시 클램핑합니다.
+ * 적분 제한도 같은 범위로 맞춥니다.
  */
 void pid_controller_set_output_limits(pid_controller_t* pid, float min, float max) {
     pid->output_min = min;
@@ -67,52 +70,45 @@ void pid_controller_set_output_limits(pid_controller_t* pid, float min, float ma
     if (pid->output > pid->output_max) pid->output = pid->output_max;
     else if (pid->output < pid->output_min) pid->output = pid->output_min;
     
+    pid_controller_set_integral_limits(pid, min, max);
+}
+
+/**
+ * @brief 적분 제한 설정 구현
+ * 
+ * 적분 누적값의 상한/하한을 설정하고, 현재 적분값이
+ * 범위를 벗어나면 즉시 클램핑합니다.
+ */
+void pid_controller_set_integral_limits(pid_controller_t* pid, float min, float max) {
+    pid->integral_min = min;
+    pid->integral_max = max;
+    
     // 적분 와인드업 방지를 위한 적분값 클램핑
-    if (pid->integral > pid->output_max) pid->integral = pid->output_max;
-    else if (pid->integral < pid->output_min) pid->integral = pid->output_min;
+    if (pid->integral > pid->integral_max) pid->integral = pid->integral_max;
+    else if (pid->integral < pid->integral_min) pid->integral = pid->integral_min;
 }
 
 /**
  * @brief PID 제어 계산 구현
  * 
- * 표준 PID 알고리즘을 구현합니다:
- * Output = Kp*error + Ki*integral + Kd*derivative
+ * 커널 본문은 control_kernels.h에 있으며 고정소수점 빌드(control_fixed.c)와 공유합니다.
  * 
  * 특수 기능:
  * - 첫 실행 시 미분 킥 방지
  * - 적분 와인드업 방지
  * - 출력 포화 제한
+ *
+ * pid_controller_compute_rate()와 캐스케이드 밸런싱(balance_pid_update_tilt_target(),
+ * balance_pid_compute_balance())도 같은 템플릿에서 생성됩니다.
  */
-float pid_controller_compute(pid_controller_t* pid, float input, float dt) {
-    if (pid->first_run) {
-        pid->previous_error = pid->setpoint - input;
-        pid->first_run = false;
-        return 0.0f; // 첫 실행 시 미분 킥 방지
-    }
-
-    if (dt <= 0.0f) return pid->output; // 잘못된 시간 간격 처리
-    
-    float error = pid->setpoint - input;
-    
-    // 적분 계산 및 와인드업 방지
-    pid->integral += error * dt;
-    if (pid->integral > pid->output_max) pid->integral = pid->output_max;
-    else if (pid->integral < pid->output_min) pid->integral = pid->output_min;
-
-    // 미분 계산
-    float derivative = (error - pid->previous_error) / dt;
-    
-    // PID 출력 계산
-    pid->output = pid->kp * error + pid->ki * pid->integral + pid->kd * derivative;
-    
-    // 출력 제한
-    if (pid->output > pid->output_max) pid->output = pid->output_max;
-    else if (pid->output < pid->output_min) pid->output = pid->output_min;
-    
-    pid->previous_error = error;
-
-    return pid->output;
-}
+#define CK_FIXED_POINT  0
+#define CK_PID_T        pid_controller_t
+#define CK_PID_COMPUTE  pid_controller_compute
+#define CK_PID_COMPUTE_RATE pid_controller_compute_rate
+#define CK_BALANCE_T    balance_pid_t
+#define CK_BALANCE_UPDATE_TILT balance_pid_update_tilt_target
+#define CK_BALANCE_COMPUTE balance_pid_compute_balance
+#include "control_kernels.h"
 
 /**
  * @brief PID 제어기 리셋 구현
@@ -139,6 +135,11 @@ void balance_pid_init(balance_pid_t* balance_pid) {
     
     balance_pid->target_velocity = 0.0f;  // 정지 상태로 시작
     balance_pid->max_tilt_angle = 45.0f;  // 안전 각도 제한
+    balance_pid->angle_offset = 0.0f;     // 기구적 무게중심 보정 없음
+    balance_pid->velocity_divider = 1;    // 속도 루프도 매 주기 실행
+    balance_pid->velocity_counter = 0;
+    balance_pid->velocity_dt = 0.0f;
+    balance_pid->tilt_target = 0.0f;
     
     // 출력 제한 설정
     pid_controller_set_output_limits(&balance_pid->pitch_pid, -255.0f, 255.0f);   // 모터 출력 범위
@@ -175,28 +176,21 @@ void balance_pid_set_max_tilt_angle(balance_pid_t* balance_pid, float angle) {
 }
 
 /**
- * @brief 밸런싱 제어 계산 구현
- * 
- * 이중 루프 제어 구조:
- * 1. 속도 PID: 현재 속도와 목표 속도의 차이로 목표 기울기 각도 계산
- * 2. 각도 PID: 목표 기울기와 현재 각도의 차이로 모터 출력 계산
- * 
- * 안전 기능: 최대 기울기 각도 초과 시 모터 정지
+ * @brief 기준 각도 보정 설정 구현
  */
-float balance_pid_compute_balance(balance_pid_t* balance_pid, float current_angle, float gyro_rate, float current_velocity, float dt) {
-    // 안전 검사: 로봇이 넘어졌는지 확인
-    if ((current_angle > 0 ? current_angle : -current_angle) > balance_pid->max_tilt_angle) {
-        return 0.0f; // 로봇이 넘어짐, 모터 정지
-    }
-
-    // 1단계: 속도 제어 - 목표 기울기 각도 계산
-    float velocity_adjustment = pid_controller_compute(&balance_pid->velocity_pid, current_velocity, dt);
-
-    // 2단계: 각도 제어 - 모터 출력 계산
-    pid_controller_set_setpoint(&balance_pid->pitch_pid, velocity_adjustment);
-    float motor_output = pid_controller_compute(&balance_pid->pitch_pid, current_angle, dt);
+void balance_pid_set_angle_offset(balance_pid_t* balance_pid, float angle) {
+    balance_pid->angle_offset = angle;
+}
 
-    return motor_output;
+/**
+ * @brief 속도 루프 분주비 설정 구현
+ * 
+ * 다음 주기에 바로 속도 루프가 실행되도록 카운터와 누적 시간을 초기화합니다.
+ */
+void balance_pid_set_velocity_divider(balance_pid_t* balance_pid, uint32_t divider) {
+    balance_pid->velocity_divider = (divider > 0) ? divider : 1;
+    balance_pid->velocity_counter = 0;
+    balance_pid->velocity_dt = 0.0f;
 }
 
 /**
@@ -207,4 +201,7 @@ float balance_pid_compute_balance(balance_pid_t* balance_pid, float current_angl
 void balance_pid_reset(balance_pid_t* balance_pid) {
     pid_controller_reset(&balance_pid->pitch_pid);
     pid_controller_reset(&balance_pid->velocity_pid);
+    balance_pid->velocity_counter = 0;
+    balance_pid->velocity_dt = 0.0f;
+    balance_pid->tilt_target = balance_pid->angle_offset;
 }
\ No newline at end of file
@@ -46,6 +46,8 @@ typedef struct {
     float output;            ///< 현재 출력값
     float output_min;        ///< 출력 최솟값 제한
     float output_max;        ///< 출력 최댓값 제한
+    float integral_min;      ///< 적분 누적값 최솟값 (와인드업 방지)
+    float integral_max;      ///< 적분 누적값 최댓값 (와인드업 방지)
     bool first_run;          ///< 첫 실행 플래그 (미분 점프 방지)
 } pid_controller_t;
 
@@ -54,13 +56,19 @@ typedef struct {
  * @brief 밸런싱 전용 이중 PID 제어기 구조체
  * 
  * 각도 제어와 속도 제어를 결합한 캐스케이드 PID 시스템입니다.
- * 외부 루프는 각도를 제어하고, 내부 루프는 속도를 제어합니다.
+ * 외부 루프는 속도를 제어하여 목표 기울기를 만들고, 내부 루프는 각도를 제어합니다.
+ * 외부 루프는 내부 루프의 velocity_divider 주기마다 한 번 실행됩니다.
  */
 typedef struct {
-    pid_controller_t pitch_pid;     ///< 피치 각도 제어 PID
-    pid_controller_t velocity_pid;  ///< 속도 제어 PID
+    pid_controller_t pitch_pid;     ///< 피치 각도 제어 PID (내부 루프)
+    pid_controller_t velocity_pid;  ///< 속도 제어 PID (외부 루프)
     float target_velocity;          ///< 목표 이동 속도 (cm/s)
     float max_tilt_angle;          ///< 최대 허용 기울기 각도 (degree)
+    float angle_offset;             ///< 기준 기울기 각도 (degree, 무게중심 보정)
+    uint32_t velocity_divider;      ///< 속도 루프 분주비 (내부 루프 N회당 1회)
+    uint32_t velocity_counter;      ///< 분주 카운터
+    float velocity_dt;              ///< 마지막 속도 루프 실행 후 누적 시간 (초)
+    float tilt_target;              ///< 속도 루프가 만든 목표 기울기 (degree)
 } balance_pid_t;
 
 /** @} */ // PID_STRUCTS
@@ -117,6 +125,19 @@ void pid_controller_set_setpoint(pid_controller_t* pid, float sp);
  */
 void pid_controller_set_output_limits(pid_controller_t* pid, float min, float max);
 
+/**
+ * @brief 적분 제한 설정
+ * 
+ * 적분 누적값(오차 × 시간 단위)의 상한과 하한을 따로 설정합니다.
+ * pid_controller_set_output_limits()는 적분 제한을 출력 제한과 같게 맞추므로,
+ * 다른 범위가 필요하면 그 뒤에 호출합니다.
+ * 
+ * @param pid PID 제어기 구조체 포인터
+ * @param min 적분 최솟값
+ * @param max 적분 최댓값
+ */
+void pid_controller_set_integral_limits(pid_controller_t* pid, float min, float max);
+
 /**
  * @brief PID 제어 계산
  * 
@@ -129,6 +150,21 @@ void pid_controller_set_output_limits(pid_controller_t* pid, float min, float ma
  */
 float pid_controller_compute(pid_controller_t* pid, float input, float dt);
 
+/**
+ * @brief 측정 미분 PID 제어 계산
+ * 
+ * 오차를 미분하는 대신 측정된 변화율을 D항으로 사용합니다 (D = -Kd * input_rate).
+ * 자이로 각속도처럼 직접 측정되는 변화율이 있으면 미분 노이즈가 없고,
+ * 목표값이 바뀌어도 미분 킥이 생기지 않습니다.
+ * 
+ * @param pid PID 제어기 구조체 포인터
+ * @param input 현재 프로세스 변수 (측정값)
+ * @param input_rate 측정값의 변화율 (단위/s)
+ * @param dt 샘플링 시간 간격 (초)
+ * @return float 계산된 제어 출력
+ */
+float pid_controller_compute_rate(pid_controller_t* pid, float input, float input_rate, float dt);
+
 /**
  * @brief PID 제어기 리셋
  * 
@@ -200,14 +236,49 @@ void balance_pid_set_target_velocity(balance_pid_t* balance_pid, float velocity)
  */
 void balance_pid_set_max_tilt_angle(balance_pid_t* balance_pid, float angle);
 
+/**
+ * @brief 기준 기울기 각도 설정
+ * 
+ * 목표 속도로 주행할 때 유지할 기울기는 이 값에 속도 루프 출력을 더한 값입니다.
+ * 
+ * @param balance_pid 밸런싱 PID 구조체 포인터
+ * @param angle 기준 기울기 각도 (degree)
+ */
+void balance_pid_set_angle_offset(balance_pid_t* balance_pid, float angle);
+
+/**
+ * @brief 속도 루프 분주비 설정
+ * 
+ * 속도(외부) 루프를 각도(내부) 루프 divider회마다 한 번 실행합니다.
+ * 
+ * @param balance_pid 밸런싱 PID 구조체 포인터
+ * @param divider 분주비 (0은 1로 처리)
+ */
+void balance_pid_set_velocity_divider(balance_pid_t* balance_pid, uint32_t divider);
+
+/**
+ * @brief 속도 루프 갱신 및 목표 기울기 반환
+ * 
+ * 분주 주기가 된 호출에서만 속도 PID를 누적 시간으로 실행하고,
+ * 그 외에는 직전 목표 기울기를 반환합니다.
+ * 적분항(Ki × 적분값)은 속도 PID 출력 제한(목표 기울기 제한)까지 쓸 수 있도록
+ * 실행마다 적분 제한을 출력 제한 / Ki로 맞춥니다.
+ * 
+ * @param balance_pid 밸런싱 PID 구조체 포인터
+ * @param current_velocity 현재 이동 속도 (cm/s)
+ * @param dt 내부 루프 샘플링 시간 간격 (초)
+ * @return float 목표 기울기 각도 (degree)
+ */
+float balance_pid_update_tilt_target(balance_pid_t* balance_pid, float current_velocity, float dt);
+
 /**
  * @brief 밸런싱 제어 계산
  * 
  * 이중 루프 제어를 수행하여 모터 출력을 계산합니다.
  * 
  * 제어 구조:
- * 1. 속도 오차로부터 목표 기울기 각도 계산
- * 2. 각도 오차로부터 모터 출력 계산
+ * 1. 속도 오차로부터 목표 기울기 각도 계산 (분주된 주기)
+ * 2. 각도 오차와 자이로 각속도(D항)로부터 모터 출력 계산 (매 주기)
  * 
  * @param balance_pid 밸런싱 PID 구조체 포인터
  * @param current_angle 현재 피치 각도 (degree)
@@ -0,0 +1,166 @@
+/**
+ * @file velocity_estimator.c
+ * @brief 엣지 시각 기반 바퀴 속도/가속도 추정기 구현
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "velocity_estimator.h"
+#include <math.h>
+#include <string.h>
+
+#define VELOCITY_INIT_VAR   1.0e6f  ///< 리셋 직후 속도 분산 ((counts/s)^2)
+#define ACCEL_INIT_VAR      1.0e8f  ///< 리셋 직후 가속도 분산 ((counts/s^2)^2)
+#define MEASURE_MIN_VAR     1.0e-2f ///< 칼만 측정 분산 하한 ((counts/s)^2)
+
+void velocity_estimator_default_config(velocity_estimator_config_t* config) {
+    config->tracker = VELOCITY_TRACKER_KALMAN;
+    config->alpha = 0.5f;
+    config->beta = 0.1f;
+    config->jerk_noise = 1.0e8f;
+    config->edge_jitter_us = 5.0f;
+    config->min_span_s = 0.0f;
+    config->stop_timeout_s = 0.2f;
+}
+
+void velocity_estimator_init(velocity_estimator_t* est, const velocity_estimator_config_t* config) {
+    memset(est, 0, sizeof(*est));
+    est->config = *config;
+    velocity_estimator_reset(est, 0, 0);
+}
+
+void velocity_estimator_set_config(velocity_estimator_t* est, const velocity_estimator_config_t* config) {
+    est->config = *config;
+}
+
+void velocity_estimator_reset(velocity_estimator_t* est, int32_t count, int64_t now_us) {
+    est->ref_count = count;
+    est->ref_time_us = now_us;
+    est->edge_count = count;
+    est->edge_time_us = now_us;
+    est->update_time_us = now_us;
+    est->has_ref = false;
+    est->measured = false;
+    est->measurement = 0.0f;
+    est->velocity = 0.0f;
+    est->accel = 0.0f;
+    est->P[0][0] = VELOCITY_INIT_VAR;
+    est->P[0][1] = 0.0f;
+    est->P[1][0] = 0.0f;
+    est->P[1][1] = ACCEL_INIT_VAR;
+}
+
+/**
+ * @brief 등가속도 모델로 dt만큼 예측
+ */
+static void predict(velocity_estimator_t* est, float dt) {
+    est->velocity += est->accel * dt;
+    if (est->config.tracker != VELOCITY_TRACKER_KALMAN) {
+        return;
+    }
+
+    // P = F P F' + Q with F = [1 dt; 0 1] and white jerk noise
+    float (*P)[2] = est->P;
+    float q = est->config.jerk_noise;
+    float dt2 = dt * dt;
+    P[0][0] += dt * (P[0][1] + P[1][0]) + dt2 * P[1][1] + q * dt2 * dt / 3.0f;
+    P[0][1] += dt * P[1][1] + q * dt2 / 2.0f;
+    P[1][0] += dt * P[1][1] + q * dt2 / 2.0f;
+    P[1][1] += q * dt;
+}
+
+/**
+ * @brief 속도 측정값 반영
+ * @param z 측정 속도 (counts/s)
+ * @param span_s 측정 구간 길이 (s) - 칼만 측정 분산 계산용
+ * @param dt 직전 갱신 이후 시간 (s) - 알파-베타 가속도 보정용
+ */
+static void correct(velocity_estimator_t* est, float z, float span_s, float dt) {
+    float residual = z - est->velocity;
+    est->measured = true;
+    est->measurement = z;
+
+    if (est->config.tracker != VELOCITY_TRACKER_KALMAN) {
+        est->velocity += est->config.alpha * residual;
+        est->accel += est->config.beta * residual / dt;
+        return;
+    }
+
+    // Counts between edges are exact; the error is timestamp jitter at both ends of the span.
+    // Scale by the estimate rather than z so short spans are not systematically down-weighted.
+    float jitter = est->velocity * (est->config.edge_jitter_us * 1e-6f) / span_s;
+    float r = 2.0f * jitter * jitter + MEASURE_MIN_VAR;
+
+    float (*P)[2] = est->P;
+    float s = P[0][0] + r;
+    float k0 = P[0][0] / s;
+    float k1 = P[1][0] / s;
+    est->velocity += k0 * residual;
+    est->accel += k1 * residual;
+
+    float p00 = P[0][0];
+    float p01 = P[0][1];
+    P[0][0] -= k0 * p00;
+    P[0][1] -= k0 * p01;
+    P[1][0] -= k1 * p00;
+    P[1][1] -= k1 * p01;
+}
+
+float velocity_estimator_update(velocity_estimator_t* est, int32_t count, int64_t edge_time_us, int64_t now_us) {
+    int64_t elapsed_us = now_us - est->update_time_us;
+    if (elapsed_us <= 0) {
+        return est->velocity;
+    }
+    float dt = (float)elapsed_us * 1e-6f;
+    est->update_time_us = now_us;
+    est->measured = false;
+    predict(est, dt);
+
+    if (count != est->edge_count || edge_time_us != est->edge_time_us) {
+        est->edge_count = count;
+        est->edge_time_us = edge_time_us;
+        if (!est->has_ref) {
+            // The span would start at an arbitrary reset time, so this edge only opens the first span
+            est->ref_count = count;
+            est->ref_time_us = edge_time_us;
+            est->has_ref = true;
+            return est->velocity;
+        }
+        // Counts over the exact time between the span's first and last edge
+        float span_s = (float)(edge_time_us - est->ref_time_us) * 1e-6f;
+        if (span_s > 0.0f && span_s >= est->config.min_span_s) {
+            correct(est, (float)(count - est->ref_count) / span_s, span_s, dt);
+            est->ref_count = count;
+            est->ref_time_us = edge_time_us;
+        }
+        return est->velocity;
+    }
+
+    float since_s = (float)(now_us - est->edge_time_us) * 1e-6f;
+    if (since_s >= est->config.stop_timeout_s) {
+        // Stopped: hold zero and start the next span at the first edge after the stop
+        est->velocity = 0.0f;
+        est->accel = 0.0f;
+        est->ref_count = est->edge_count;
+        est->ref_time_us = est->edge_time_us;
+    } else if (est->has_ref && since_s > 0.0f) {
+        // No edge yet, so the wheel is slower than one count per elapsed time.
+        // Clamp instead of correcting so the decay cannot wind the acceleration past zero speed.
+        float bound = 1.0f / since_s;
+        if (fabsf(est->velocity) > bound) {
+            est->velocity = copysignf(bound, est->velocity);
+            est->accel = 0.0f;
+        }
+    }
+    return est->velocity;
+}
+
+float velocity_estimator_get_velocity(const velocity_estimator_t* est) {
+    return est->velocity;
+}
+
+float velocity_estimator_get_accel(const velocity_estimator_t* est) {
+    return est->accel;
+}
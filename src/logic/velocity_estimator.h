@@ -0,0 +1,150 @@
+/**
+ * @file velocity_estimator.h
+ * @brief 엣지 시각 기반 바퀴 속도/가속도 추정기
+ *
+ * 틱(ms) 단위 시간으로 위치 차이를 나누면 저속에서는 0과 1카운트 스파이크를
+ * 오가고, 1ms 틱 해상도 때문에 dt도 크게 양자화됩니다. 이 추정기는 카운트
+ * 차이를 마지막 엣지 사이의 us 시간으로 나눕니다 (M/T 방식):
+ * - 고속: 주기마다 여러 카운트가 바뀌므로 카운트 차이 / 엣지 간 시간
+ * - 저속: 여러 주기에 한 카운트씩 바뀌므로 엣지 주기 측정과 같음
+ * - 엣지가 없는 동안: 다음 엣지가 아직 오지 않았다는 사실로 속도 상한
+ *   (1카운트 / 마지막 엣지 이후 시간)을 걸어 정지 시 부드럽게 0으로 감쇠
+ *
+ * 엣지 시각이 폴링 시각으로 양자화되는 경우(PCNT)에는 최소 측정 구간을 두어
+ * 구간 양 끝의 시각 오차가 측정값에 미치는 영향을 줄입니다.
+ *
+ * 측정값은 속도와 가속도를 상태로 갖는 추적기에 넣습니다:
+ * - 알파-베타: 고정 게인, 튜닝이 단순
+ * - 칼만: 측정 분산을 엣지 시각 오차와 측정 구간 길이로 계산 (긴 구간일수록 정확)
+ *
+ * 단위는 카운트/s이며 거리 환산은 호출자가 합니다. 엣지 시각은 ISR 진입
+ * 시각(ISR 백엔드) 또는 카운트 변화를 처음 본 폴링 시각(PCNT 백엔드)입니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef VELOCITY_ESTIMATOR_H
+#define VELOCITY_ESTIMATOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 속도 추적기 종류
+ */
+typedef enum {
+    VELOCITY_TRACKER_ALPHA_BETA = 0,    ///< 고정 게인 알파-베타 추적기
+    VELOCITY_TRACKER_KALMAN,            ///< 속도/가속도 2상태 칼만 필터
+} velocity_tracker_t;
+
+/**
+ * @struct velocity_estimator_config_t
+ * @brief 속도 추정기 설정
+ */
+typedef struct {
+    velocity_tracker_t tracker; ///< 추적기 종류
+    float alpha;                ///< 알파-베타: 속도 보정 게인 (0~1)
+    float beta;                 ///< 알파-베타: 가속도 보정 게인 (0~1)
+    float jerk_noise;           ///< 칼만: 가가속도 프로세스 노이즈 밀도 ((counts/s^3)^2 * s)
+    float edge_jitter_us;       ///< 칼만: 엣지 시각 오차 표준편차 (us)
+    float min_span_s;           ///< 측정 구간 최소 길이 (s) - 짧으면 다음 엣지까지 누적
+    float stop_timeout_s;       ///< 엣지가 이 시간 동안 없으면 정지로 측정 (s)
+} velocity_estimator_config_t;
+
+/**
+ * @struct velocity_estimator_t
+ * @brief 속도 추정기 상태
+ */
+typedef struct {
+    velocity_estimator_config_t config; ///< 설정
+    int32_t ref_count;          ///< 측정 구간 시작 엣지의 카운트
+    int64_t ref_time_us;        ///< 측정 구간 시작 엣지 시각 (us)
+    int32_t edge_count;         ///< 마지막 엣지의 카운트
+    int64_t edge_time_us;       ///< 마지막 엣지 시각 (us)
+    int64_t update_time_us;     ///< 마지막 갱신 시각 (us)
+    bool has_ref;               ///< 구간 시작 엣지 있음 (리셋 후 첫 엣지 전에는 false)
+    bool measured;              ///< 마지막 갱신에서 측정값을 반영했는지
+    float measurement;          ///< 마지막 측정 속도 (counts/s)
+    float velocity;             ///< 추정 속도 (counts/s)
+    float accel;                ///< 추정 가속도 (counts/s^2)
+    float P[2][2];              ///< 칼만: 오차 공분산 (속도, 가속도)
+} velocity_estimator_t;
+
+/**
+ * @defgroup VELOCITY_ESTIMATOR_API 속도 추정기 API
+ * @brief 엣지 시각 기반 속도 측정과 추적 함수들
+ * @{
+ */
+
+/**
+ * @brief 기본 설정 (칼만, ISR 엣지 시각 기준)
+ * @param config 채울 설정
+ */
+void velocity_estimator_default_config(velocity_estimator_config_t* config);
+
+/**
+ * @brief 추정기 초기화 (설정 적용 후 시각 0, 카운트 0으로 리셋)
+ * @param est 추정기
+ * @param config 설정
+ */
+void velocity_estimator_init(velocity_estimator_t* est, const velocity_estimator_config_t* config);
+
+/**
+ * @brief 실행 중 설정 변경 (추정 상태는 유지)
+ * @param est 추정기
+ * @param config 설정
+ */
+void velocity_estimator_set_config(velocity_estimator_t* est, const velocity_estimator_config_t* config);
+
+/**
+ * @brief 추정 상태 리셋 (속도/가속도 0, 다음 엣지를 기준으로 측정 재시작)
+ * @param est 추정기
+ * @param count 현재 카운트
+ * @param now_us 현재 시각 (us)
+ */
+void velocity_estimator_reset(velocity_estimator_t* est, int32_t count, int64_t now_us);
+
+/**
+ * @brief 추정기 갱신 (제어 주기마다 호출)
+ *
+ * 카운트나 엣지 시각이 바뀌었고 구간 시작 엣지 이후 min_span_s가 지났으면
+ * (카운트 차이) / (엣지 간 시간)을 측정값으로 씁니다. 엣지가 없으면 마지막
+ * 엣지 이후 경과 시간으로 만든 속도 상한을 넘지 않게 하고, stop_timeout_s가
+ * 지나면 0을 측정값으로 씁니다.
+ * now_us가 이전 갱신보다 늦지 않으면 아무것도 하지 않습니다.
+ *
+ * @param est 추정기
+ * @param count 현재 카운트
+ * @param edge_time_us count를 만든 마지막 엣지 시각 (us)
+ * @param now_us 현재 시각 (us)
+ * @return float 추정 속도 (counts/s)
+ */
+float velocity_estimator_update(velocity_estimator_t* est, int32_t count, int64_t edge_time_us, int64_t now_us);
+
+/**
+ * @brief 추정 속도 읽기
+ * @param est 추정기
+ * @return float 속도 (counts/s)
+ */
+float velocity_estimator_get_velocity(const velocity_estimator_t* est);
+
+/**
+ * @brief 추정 가속도 읽기
+ * @param est 추정기
+ * @return float 가속도 (counts/s^2)
+ */
+float velocity_estimator_get_accel(const velocity_estimator_t* est);
+
+/** @} */ // VELOCITY_ESTIMATOR_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VELOCITY_ESTIMATOR_H
@@ -6,16 +6,20 @@
  * 
  * 주요 기능:
  * - FreeRTOS 태스크 기반 멀티태스킹 구조
- * - 센서 데이터 읽기 및 칼만 필터링
+ * - 센서 데이터 읽기 및 자세 추정 (칼만/Mahony/Madgwick/상보 필터 선택)
  * - PID 제어 기반 밸런싱 알고리즘
  * - BLE 무선 통신 및 원격 제어
+ * - BLE CONFIG_SET/GET으로 게인/필터 파라미터 실시간 조정 및 NVS 저장
  * - 서보 기반 기립 보조 시스템
  * - 안전한 상태 머신 관리
  * 
  * 태스크 구조:
- * - sensor_task: 센서 데이터 수집 및 필터링 (50Hz)
- * - balance_task: PID 제어 및 모터 제어 (50Hz)
- * - status_task: 상태 모니터링 및 BLE 통신 (1Hz)
+ * - control_task: 파라미터 갱신 → 센서 읽기 → 자세 추정 → 원격 명령 큐 → PID → 모터 출력 고정 위상 파이프라인
+ *   (CONFIG_CONTROL_LOOP_HZ, 고속 모드 기본 500Hz, APP_CPU 고정)
+ * - status_task: 상태 모니터링, 사이클 예산 보고, 파라미터 저장 (1Hz, PRO_CPU 고정)
+ * - gps_task: UART 수신 이벤트를 기다려 UBX/NMEA를 파싱하고 고정을 스냅샷으로 발행 (최저 우선순위, PRO_CPU)
+ * - telemetry_task: 제어 샘플을 묶어 BLE 알림으로 스트리밍 (CONFIG_TELEMETRY_FLUSH_MS, PRO_CPU)
+ * - app_main 루프: BLE 통신 및 서보 기립 처리 (PRO_CPU)
  * 
  * @author Hyeonsu Park, Suyong Kim
  * @date 2025-09-20
@@ -25,9 +29,9 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <stdatomic.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "freertos/semphr.h"
 #include "esp_log.h"
 #include "esp_system.h"
 #include "nvs_flash.h"
@@ -35,37 +39,65 @@
 #include "config.h"
 
 #include "input/imu_sensor.h"
-#include "logic/kalman_filter.h"
+#include "input/imu_drdy.h"
+#include "input/imu_calibration.h"
+#include "logic/attitude_estimator.h"
 #include "input/gps_sensor.h"
 #include "input/encoder_sensor.h"
 #include "output/motor_control.h"
 #include "output/ble_controller.h"
 #include "logic/pid_controller.h"
+#include "logic/odometry.h"
+#if CONFIG_CONTROL_FIXED_POINT
+#include "logic/control_fixed.h"
+#endif
 #include "output/servo_standup.h"
 #include "system/error_recovery.h"
+#include "system/control_scheduler.h"
+#include "system/state_snapshot.h"
+#include "system/robot_state_machine.h"
+#include "system/command_watchdog.h"
+#include "system/param_registry.h"
+#include "system/param_store.h"
+#if CONFIG_TELEMETRY_ENABLED
+#include "system/telemetry.h"
+#endif
 
 // Pin definitions are now in config.h
 
+// xTaskDelayUntil wakes on tick boundaries, so the control period must be a whole number of ticks
+#if (CONFIG_CONTROL_PERIOD_US * CONFIG_FREERTOS_HZ) % 1000000 != 0 || CONFIG_CONTROL_LOOP_HZ > CONFIG_FREERTOS_HZ
+#error "CONFIG_CONTROL_LOOP_HZ must divide CONFIG_FREERTOS_HZ"
+#endif
+
+#if CONFIG_IMU_FIFO_MODE
+#define IMU_SAMPLE_RATE_HZ  CONFIG_IMU_FIFO_SAMPLE_RATE_HZ ///< IMU 출력 레이트 (FIFO 모드: 제어 주기보다 빠름)
+#else
+#define IMU_SAMPLE_RATE_HZ  CONFIG_CONTROL_LOOP_HZ         ///< IMU 출력 레이트 (주기당 1샘플)
+#endif
+
+// Data-ready pacing completes a cycle every N samples
+#if IMU_SAMPLE_RATE_HZ % CONFIG_CONTROL_LOOP_HZ != 0
+#error "IMU sample rate must be a multiple of CONFIG_CONTROL_LOOP_HZ"
+#endif
+
+#if CONFIG_TELEMETRY_ENABLED
+// Telemetry samples every Nth control cycle; the ring index wraps with a mask
+#if CONFIG_CONTROL_LOOP_HZ % CONFIG_TELEMETRY_SAMPLE_HZ != 0
+#error "CONFIG_TELEMETRY_SAMPLE_HZ must divide CONFIG_CONTROL_LOOP_HZ"
+#endif
+#if (CONFIG_TELEMETRY_RING_SIZE & (CONFIG_TELEMETRY_RING_SIZE - 1)) != 0
+#error "CONFIG_TELEMETRY_RING_SIZE must be a power of two"
+#endif
+#endif
+
+_Static_assert(sizeof(robot_params_t) <= PARAM_STORE_MAX_PAYLOAD, "robot_params_t must fit in one parameter store slot");
+
 static const char* TAG = "BALANCE_ROBOT"; ///< ESP-IDF 로깅 태그
 
-/**
- * @enum robot_state_t
- * @brief 로봇 상태 머신 정의
- * 
- * 로봇의 현재 동작 상태를 나타내는 열거형입니다.
- * 각 상태는 로봇의 특정 동작 모드를 의미합니다.
- */
-typedef enum {
-    ROBOT_STATE_INIT,        ///< 초기화 상태
-    ROBOT_STATE_IDLE,        ///< 대기 상태 (모터 정지)
-    ROBOT_STATE_BALANCING,   ///< 밸런싱 제어 상태
-    ROBOT_STATE_STANDING_UP, ///< 기립 보조 동작 상태
-    ROBOT_STATE_FALLEN,      ///< 넘어진 상태
-    ROBOT_STATE_ERROR        ///< 오류 상태
-} robot_state_t;
+#define PARAM_PARTITION_LABEL "params" ///< 조정 파라미터 A/B 슬롯 파티션 (partitions.csv)
 
-static robot_state_t current_state = ROBOT_STATE_INIT; ///< 현재 로봇 상태
-static SemaphoreHandle_t state_mutex = NULL;           ///< 상태 변수 보호용 뮤텍스
+static robot_state_t current_state = ROBOT_STATE_INIT; ///< 현재 로봇 상태 (제어 태스크 소유)
 
 /**
  * @defgroup ROBOT_COMPONENTS 로봇 구성 요소
@@ -73,37 +105,88 @@ static SemaphoreHandle_t state_mutex = NULL;           ///< 상태 변수 보호
  * @{
  */
 static imu_sensor_t imu;                ///< IMU 센서 (MPU6050)
-static kalman_filter_t kalman_pitch;    ///< 피치 각도용 칼만 필터
+static imu_calibration_t imu_calibration; ///< IMU 오프셋 보정 (부팅 보정 후 제어 태스크 전용)
+static imu_offsets_t imu_offsets;       ///< 적용 중인 IMU 오프셋 (실행 중 추적 포함, 제어 태스크 전용)
+static attitude_estimator_t attitude;   ///< 자세 추정기 (필터는 실행 중 선택 가능)
 static gps_sensor_t gps;                ///< GPS 센서
 static encoder_sensor_t left_encoder;   ///< 좌측 바퀴 엔코더
 static motor_control_t left_motor;      ///< 좌측 모터 제어
 static encoder_sensor_t right_encoder;  ///< 우측 바퀴 엔코더
+static odometry_t odometry;             ///< 추측 항법 위치 추정기 (제어 태스크 전용)
 static motor_control_t right_motor;     ///< 우측 모터 제어
 static ble_controller_t ble_controller; ///< BLE 무선 통신 컨트롤러
-static pid_controller_t balance_pid;    ///< 밸런싱용 PID 제어기
+static balance_pid_t balance_pid;       ///< 밸런싱용 캐스케이드 제어기 (속도 → 각도 → 모터)
+#if CONFIG_CONTROL_FIXED_POINT
+static balance_pid_q_t balance_pid_q;   ///< 캐스케이드 고정소수점 실행본 (balance_pid에서 설정 로드)
+#endif
 static servo_standup_t servo_standup;   ///< 기립 보조용 서보 모터
+static control_scheduler_t control_scheduler; ///< 제어 파이프라인 고정 주기 스케줄러
+#if CONFIG_IMU_DRDY_MODE
+static imu_drdy_t imu_drdy;                   ///< IMU 데이터 레디 주기 트리거
+static bool imu_drdy_active = false;          ///< 데이터 레디로 주기를 시작하는지 여부 (제어 태스크 소유)
+#endif
 /** @} */
 
 /**
  * @defgroup SHARED_DATA 공유 데이터
- * @brief 태스크 간 공유되는 로봇 상태 데이터 (뮤텍스로 보호)
+ * @brief 태스크 간 공유되는 로봇 상태 데이터
+ * 
+ * 제어 태스크만 control_state를 갱신하고 주기마다 한 번 스냅샷으로 발행합니다.
+ * 다른 태스크는 뮤텍스 없이 스냅샷을 읽으므로 제어 경로가 블로킹되지 않습니다.
  * @{
  */
-static float filtered_angle = 0.0f;     ///< 칼만 필터링된 피치 각도 (degree)
-static float robot_velocity = 0.0f;     ///< 로봇 이동 속도 (cm/s)
-static bool balancing_enabled = true;   ///< 밸런싱 제어 활성화 플래그
+static robot_state_snapshot_t control_state;  ///< 현재 주기 상태 (제어 태스크 전용 작업 사본)
+#if CONFIG_CONTROL_FIXED_POINT
+/**
+ * @brief 고정소수점 제어 경로 신호 (제어 태스크 전용, Q16.16)
+ *
+ * 센서 드라이버 경계에서 한 번 변환한 뒤 캐스케이드 제어까지 정수로만 전달합니다.
+ */
+static struct {
+    q16_t angle;            ///< 피치 각도 (degree)
+    q16_t angle_rate;       ///< 피치 각속도 (degree/s)
+    q16_t velocity;         ///< 이동 속도 (cm/s)
+    q16_t max_speed;        ///< 최대 목표 속도 (cm/s, 파라미터 적용 시 갱신)
+} control_signals_q;
+#endif
+static state_snapshot_t robot_state_snapshot; ///< 발행된 로봇 상태 스냅샷 (lock-free)
+static uint8_t robot_state_buffer[STATE_SNAPSHOT_BUFFER_SIZE(sizeof(robot_state_snapshot_t))]; ///< 스냅샷 슬롯 저장 공간
+static atomic_bool balancing_enabled = true;  ///< 밸런싱 제어 활성화 플래그
+static int16_t control_motor_command[2];      ///< 이번 주기 좌/우 모터 명령 (제어 태스크 전용, 텔레메트리용)
+static remote_command_t received_command = { .balance = true }; ///< 명령 큐에서 마지막으로 받은 원격 명령 (제어 태스크 전용)
+static remote_command_t control_command = { .balance = true }; ///< 워치독을 거쳐 적용 중인 원격 명령 (제어 태스크 전용)
+static command_watchdog_t command_watchdog;   ///< 원격 명령 워치독 (제어 태스크 전용, 만료 횟수는 원자적)
+static param_registry_t param_registry;       ///< 실행 중 조정 파라미터 (BLE 콜백이 변경, lock-free 발행)
+static robot_params_t control_params;         ///< 적용 중인 파라미터 세트 (제어 태스크 전용)
+static uint32_t control_params_version;       ///< 적용 중인 세트의 발행 번호 (제어 태스크 전용)
+static param_store_t param_store;             ///< 파라미터 블롭 A/B 슬롯 저장소 (부팅 후 상태 태스크 전용)
+static bool param_store_ready;                ///< 파라미터 파티션을 찾았는지 여부
+static uint32_t params_saved_version;         ///< 플래시와 같은 세트의 발행 번호 (상태 태스크 전용)
+static uint32_t params_seen_version;          ///< 직전 상태 주기에 본 발행 번호 (상태 태스크 전용)
+static state_snapshot_t gps_snapshot;         ///< GPS 태스크가 발행한 GPS 데이터 (lock-free)
+static uint8_t gps_buffer[STATE_SNAPSHOT_BUFFER_SIZE(sizeof(gps_data_t))]; ///< GPS 스냅샷 슬롯 저장 공간
+#if CONFIG_ODOM_GPS_FUSION
+static uint32_t gps_fused_count;              ///< 마지막으로 확인한 GPS 스냅샷 발행 번호 (제어 태스크 전용)
+#endif
+#if CONFIG_TELEMETRY_ENABLED
+static telemetry_ring_t telemetry_ring;       ///< 제어 태스크 → 텔레메트리 태스크 샘플 링 (lock-free)
+static telemetry_sample_t telemetry_storage[CONFIG_TELEMETRY_RING_SIZE]; ///< 텔레메트리 링 저장 공간
+static atomic_uint_least32_t telemetry_packets_sent;  ///< 전송한 텔레메트리 패킷 수 (텔레메트리 태스크 전용 쓰기)
+static atomic_uint_least32_t telemetry_send_failures; ///< BLE 스택이 거부한 텔레메트리 패킷 수
+#endif
 /** @} */
 
-static SemaphoreHandle_t data_mutex = NULL; ///< 공유 데이터 보호용 뮤텍스
-
 /**
  * @defgroup TASK_HANDLES FreeRTOS 태스크 핸들
  * @brief 생성된 태스크들의 핸들
  * @{
  */
-static TaskHandle_t balance_task_handle = NULL; ///< 밸런싱 제어 태스크 핸들
-static TaskHandle_t sensor_task_handle = NULL;  ///< 센서 읽기 태스크 핸들
+static TaskHandle_t control_task_handle = NULL; ///< 제어 파이프라인 태스크 핸들
 static TaskHandle_t status_task_handle = NULL;  ///< 상태 모니터링 태스크 핸들
+static TaskHandle_t gps_task_handle = NULL;     ///< GPS 수신 태스크 핸들
+#if CONFIG_TELEMETRY_ENABLED
+static TaskHandle_t telemetry_task_handle = NULL; ///< 텔레메트리 전송 태스크 핸들
+#endif
 /** @} */
 
 /**
@@ -121,27 +204,113 @@ static TaskHandle_t status_task_handle = NULL;  ///< 상태 모니터링 태스
 static void initialize_robot(void);
 
 /**
- * @brief 밸런싱 제어 태스크
+ * @brief 제어 파이프라인 태스크
  * @param pvParameters FreeRTOS 태스크 파라미터 (사용안함)
  * 
- * 50Hz 주기로 실행되며 다음 작업을 수행합니다:
+ * 고정 주기(CONFIG_CONTROL_LOOP_HZ)로 실행되며, 데이터 레디 모드에서는 IMU INT 펄스가 주기를 시작합니다.
+ * 매 주기 다음 단계를 순서대로 수행합니다:
+ * - IMU 센서 읽기 및 자세 추정 (측정 dt 사용)
+ * - 엔코더 속도 계산
  * - 상태 머신 업데이트
- * - PID 제어 계산
- * - 모터 제어 명령 적용
+ * - PID 제어 계산 (측정 dt 사용) 및 모터 출력
  */
-static void balance_task(void *pvParameters);
+static void control_task(void *pvParameters);
 
 /**
- * @brief 센서 데이터 수집 태스크
- * @param pvParameters FreeRTOS 태스크 파라미터 (사용안함)
+ * @brief 다음 제어 주기 시작까지 대기
+ * @return float 이번 주기의 측정된 시간 간격 (초)
  * 
- * 50Hz 주기로 실행되며 다음 작업을 수행합니다:
- * - IMU 센서 데이터 읽기
- * - 칼만 필터링
- * - GPS 데이터 업데이트
- * - 엔코더 속도 계산
+ * 데이터 레디 모드에서는 IMU 샘플 시각을 주기 시작 시각으로 사용하고,
+ * 그렇지 않으면 고정 주기 스케줄러의 절대 시각 웨이크업을 사용합니다.
+ */
+static float control_wait_next_cycle(void);
+
+/**
+ * @brief 센서 단계: IMU 읽기, 자세 추정, 엔코더 속도 계산
+ * @param dt 이번 주기의 측정된 시간 간격 (초)
+ */
+static void control_update_sensors(float dt);
+
+/**
+ * @brief 파라미터 단계: 새로 발행된 파라미터 세트가 있으면 주기 시작 시 한 번에 적용
+ */
+static void control_update_params(void);
+
+/**
+ * @brief 오도메트리 단계: 바퀴 카운트와 요 각속도로 자세 적분, 새 GPS 고정 융합
+ * @param dt 이번 주기의 측정된 시간 간격 (초)
+ */
+static void control_update_odometry(float dt);
+
+/**
+ * @brief 파라미터 세트를 제어기와 자세 추정기에 적용
+ * @param params 적용할 세트
+ * @param previous 직전에 적용한 세트 (NULL: 처음 적용)
+ */
+static void apply_control_params(const robot_params_t* params, const robot_params_t* previous);
+
+/**
+ * @brief 부팅 시 IMU 오프셋 보정 (IMU 초기화 직후, BLE 초기화 전)
+ * @return esp_err_t IMU를 읽을 수 없으면 ESP_FAIL (움직임으로 보정을 못 해도 ESP_OK)
+ */
+static esp_err_t calibrate_imu_wrapper(void);
+
+/**
+ * @brief 파라미터 세트의 IMU 오프셋
+ * @param params 파라미터 세트
+ * @param offsets 출력 오프셋
+ */
+static void imu_offsets_from_params(const robot_params_t* params, imu_offsets_t* offsets);
+
+/**
+ * @brief 정지 중 IMU 샘플로 자이로 바이어스 추적 (IDLE 상태에서만)
+ * @param sample 오프셋을 뺀 샘플
+ * @param dt 샘플 간격 (초)
+ * @return bool 오프셋을 바꿨으면 true
+ */
+static bool track_imu_bias(const imu_sample_t* sample, float dt);
+
+/**
+ * @brief 플래시에 저장된 파라미터 세트 복원 (부팅 시, 태스크 생성 전)
+ */
+static void load_saved_params(void);
+
+/**
+ * @brief 바뀐 파라미터 세트를 플래시에 저장 (상태 태스크)
+ */
+static void save_params_if_changed(void);
+
+/**
+ * @brief 명령 단계: BLE 명령 큐를 순서대로 비워 적용 중인 원격 명령 갱신
+ */
+static void control_update_commands(void);
+
+/**
+ * @brief 제어 단계: 상태 머신 업데이트, PID 계산, 모터 출력
+ * @param dt 이번 주기의 측정된 시간 간격 (초)
  */
-static void sensor_task(void *pvParameters);
+static void control_update_actuators(float dt);
+
+/**
+ * @brief 밸런싱 제어기 상태 리셋 (고정소수점 경로 사용 시 실행본도 함께 리셋)
+ */
+static void reset_balance_controller(void);
+
+#if CONFIG_CONTROL_FIXED_POINT
+/**
+ * @brief 원격 명령의 방향/속도를 목표 이동 속도로 변환 (고정소수점 경로)
+ * @param cmd 원격 제어 명령 구조체
+ * @return q16_t 목표 이동 속도 (cm/s, Q16.16, 양수: 전진)
+ */
+static q16_t command_target_velocity_q(remote_command_t cmd);
+#else
+/**
+ * @brief 원격 명령의 방향/속도를 목표 이동 속도로 변환
+ * @param cmd 원격 제어 명령 구조체
+ * @return float 목표 이동 속도 (cm/s, 양수: 전진)
+ */
+static float command_target_velocity(remote_command_t cmd);
+#endif
 
 /**
  * @brief 상태 모니터링 및 통신 태스크
@@ -150,10 +319,37 @@ static void sensor_task(void *pvParameters);
  * 1Hz 주기로 실행되며 다음 작업을 수행합니다:
  * - BLE 상태 메시지 전송
  * - 시리얼 디버그 출력
- * - 시스템 상태 로깅
+ * - 시스템 상태, 제어 주기 지터 및 사이클 예산 로깅
  */
 static void status_task(void *pvParameters);
 
+/**
+ * @brief GPS 수신 태스크
+ * @param pvParameters FreeRTOS 태스크 파라미터 (사용안함)
+ * 
+ * UART 수신 이벤트를 기다려 NMEA 문장을 파싱하고, 위치 데이터가 바뀔 때마다
+ * GPS 스냅샷으로 발행합니다. GPS 초기화에 성공한 경우에만 생성됩니다.
+ */
+static void gps_task(void *pvParameters);
+
+#if CONFIG_TELEMETRY_ENABLED
+/**
+ * @brief 텔레메트리 전송 태스크
+ * @param pvParameters FreeRTOS 태스크 파라미터 (사용안함)
+ * 
+ * CONFIG_TELEMETRY_FLUSH_MS마다 링 버퍼의 샘플을 협상된 MTU 크기 패킷으로 묶어
+ * BLE 알림으로 전송합니다. 연결이 없으면 쌓인 샘플을 버립니다.
+ */
+static void telemetry_task(void *pvParameters);
+
+/**
+ * @brief 현재 주기의 텔레메트리 샘플을 링 버퍼에 추가 (제어 태스크 전용)
+ * 
+ * CONFIG_TELEMETRY_SAMPLE_HZ에 맞춰 제어 주기를 분주하며, 링이 가득 차면 샘플을 버립니다.
+ */
+static void publish_telemetry_sample(void);
+#endif
+
 /**
  * @brief PID 출력과 원격 명령을 기반으로 모터 제어
  * @param motor_output PID 제어기 출력값 (-255 ~ 255)
@@ -162,7 +358,7 @@ static void status_task(void *pvParameters);
  * PID 출력값에 조향 명령을 적용하여 좌우 모터 속도를 계산하고
  * 모터 제어 모듈에 명령을 전달합니다.
  */
-static void update_motors(float motor_output, remote_command_t cmd);
+static void update_motors(int32_t motor_output, remote_command_t cmd);
 
 /**
  * @brief 원격 제어 명령 처리
@@ -177,33 +373,20 @@ static void handle_remote_commands(void);
 
 /**
  * @defgroup THREAD_SAFE_ACCESS 스레드 안전 데이터 접근 함수
- * @brief 뮤텍스를 사용한 공유 데이터 안전 접근 함수들
+ * @brief lock-free 스냅샷 및 원자 변수를 사용한 공유 데이터 접근 함수들
  * @{
  */
 
 /**
- * @brief 칼만 필터링된 각도 값을 안전하게 읽기
- * @return float 현재 피치 각도 (degree)
- */
-static float get_filtered_angle(void);
-
-/**
- * @brief 칼만 필터링된 각도 값을 안전하게 설정
- * @param angle 설정할 피치 각도 (degree)
+ * @brief 최신 로봇 상태 스냅샷 읽기 (모든 태스크에서 호출 가능)
+ * @param out 출력 스냅샷
  */
-static void set_filtered_angle(float angle);
+static void get_robot_snapshot(robot_state_snapshot_t* out);
 
 /**
- * @brief 로봇 이동 속도를 안전하게 읽기
- * @return float 현재 이동 속도 (cm/s)
+ * @brief 현재 주기의 로봇 상태를 스냅샷으로 발행 (제어 태스크 전용)
  */
-static float get_robot_velocity(void);
-
-/**
- * @brief 로봇 이동 속도를 안전하게 설정
- * @param velocity 설정할 이동 속도 (cm/s)
- */
-static void set_robot_velocity(float velocity);
+static void publish_robot_snapshot(void);
 
 /**
  * @brief 밸런싱 활성화 상태를 안전하게 읽기
@@ -226,26 +409,19 @@ static void set_balancing_enabled(bool enabled);
  */
 
 /**
- * @brief 현재 로봇 상태를 안전하게 읽기
+ * @brief 현재 로봇 상태 읽기 (제어 태스크 전용)
  * @return robot_state_t 현재 로봇 상태
  */
 static robot_state_t get_robot_state(void);
 
 /**
- * @brief 로봇 상태를 안전하게 변경
+ * @brief 로봇 상태 변경 (제어 태스크 전용)
  * @param new_state 새로운 로봇 상태
  * 
- * 상태 변경 시 로그를 출력하고 뮤텍스로 보호합니다.
+ * 상태 변경 시 로그를 출력합니다.
  */
 static void set_robot_state(robot_state_t new_state);
 
-/**
- * @brief 로봇 상태를 문자열로 변환
- * @param state 변환할 로봇 상태
- * @return const char* 상태를 나타내는 문자열
- */
-static const char* get_state_name(robot_state_t state);
-
 /**
  * @brief 상태 머신 업데이트 및 상태 전환 처리
  * 
@@ -276,15 +452,13 @@ static void state_machine_update(void);
 void app_main(void) {
     ESP_LOGI(TAG, "Balance Robot Starting...");
 
-    // Create mutexes for data protection
-    data_mutex = xSemaphoreCreateMutex();
-    state_mutex = xSemaphoreCreateMutex();
-    if (data_mutex == NULL || state_mutex == NULL) {
-        ESP_LOGE(TAG, "Failed to create mutexes!");
-        set_robot_state(ROBOT_STATE_ERROR);
-        esp_restart();
-    }
-    ESP_LOGI(TAG, "Mutexes created");
+    // Shared robot state is published lock-free by the control task
+    state_snapshot_init(&robot_state_snapshot, robot_state_buffer, sizeof(robot_state_snapshot_t));
+    state_snapshot_init(&gps_snapshot, gps_buffer, sizeof(gps_data_t));
+    command_watchdog_init(&command_watchdog, CONFIG_COMMAND_TIMEOUT_MS, CONFIG_COMMAND_DECAY_MS);
+#if CONFIG_TELEMETRY_ENABLED
+    telemetry_ring_init(&telemetry_ring, telemetry_storage, CONFIG_TELEMETRY_RING_SIZE);
+#endif
 
     // Initialize NVS
     esp_err_t ret = nvs_flash_init();
@@ -293,6 +467,10 @@ void app_main(void) {
         ret = nvs_flash_init();
     }
     ESP_ERROR_CHECK(ret);
+
+    // Tuned parameters replace the config.h defaults before anything reads them
+    param_registry_init(&param_registry);
+    load_saved_params();
     
     // Initialize robot components
     initialize_robot();
@@ -301,10 +479,19 @@ void app_main(void) {
     set_robot_state(ROBOT_STATE_IDLE);
     ESP_LOGI(TAG, "Robot initialized successfully!");
     
-    // Create tasks
-    xTaskCreate(sensor_task, "sensor_task", 4096, NULL, 5, &sensor_task_handle);
-    xTaskCreate(balance_task, "balance_task", 4096, NULL, 4, &balance_task_handle);
-    xTaskCreate(status_task, "status_task", 4096, NULL, 3, &status_task_handle);
+    // Create tasks: control pipeline owns APP_CPU, GPS/BLE/logging stay on PRO_CPU
+    xTaskCreatePinnedToCore(control_task, "control_task", CONFIG_CONTROL_TASK_STACK, NULL,
+                            CONFIG_CONTROL_TASK_PRIORITY, &control_task_handle, CONFIG_CONTROL_TASK_CORE);
+    xTaskCreatePinnedToCore(status_task, "status_task", CONFIG_STATUS_TASK_STACK, NULL,
+                            CONFIG_STATUS_TASK_PRIORITY, &status_task_handle, CONFIG_STATUS_TASK_CORE);
+    if (gps_sensor_is_initialized(&gps)) {
+        xTaskCreatePinnedToCore(gps_task, "gps_task", CONFIG_GPS_TASK_STACK, NULL,
+                                CONFIG_GPS_TASK_PRIORITY, &gps_task_handle, CONFIG_GPS_TASK_CORE);
+    }
+#if CONFIG_TELEMETRY_ENABLED
+    xTaskCreatePinnedToCore(telemetry_task, "telemetry_task", CONFIG_TELEMETRY_TASK_STACK, NULL,
+                            CONFIG_TELEMETRY_TASK_PRIORITY, &telemetry_task_handle, CONFIG_TELEMETRY_TASK_CORE);
+#endif
     
     ESP_LOGI(TAG, "Tasks created, starting main loop...");
     
@@ -332,29 +519,197 @@ void app_main(void) {
  * @return ESP_OK 성공, ESP_FAIL 실패
  */
 static esp_err_t init_imu_wrapper(void) {
-    return imu_sensor_init(&imu, CONFIG_MPU6050_I2C_PORT, CONFIG_MPU6050_SDA_PIN, CONFIG_MPU6050_SCL_PIN);
+    esp_err_t ret = imu_sensor_init(&imu, CONFIG_MPU6050_I2C_PORT, CONFIG_MPU6050_SDA_PIN, CONFIG_MPU6050_SCL_PIN);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = imu_sensor_configure_rate(&imu, IMU_SAMPLE_RATE_HZ);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+#if CONFIG_IMU_FIFO_MODE
+    // Sample faster than the loop and drain the FIFO in one burst per cycle
+    ret = imu_sensor_enable_fifo(&imu);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+#endif
+#if CONFIG_IMU_DRDY_MODE
+    // Pulse INT on every new sample; the control task wakes on it
+    ret = imu_sensor_enable_data_ready(&imu);
+#endif
+    return ret;
+}
+
+/**
+ * @brief 부팅 IMU 보정 구현
+ * 
+ * 저장된 오프셋을 적용한 상태에서 CONFIG_IMU_CALIB_DURATION_MS 동안의 정지 샘플을
+ * 평균하여 잔차를 구합니다. 도중에 움직이면 처음부터 다시 모으고,
+ * CONFIG_IMU_CALIB_TIMEOUT_MS 안에 끝나지 않으면 저장된 오프셋으로 시작합니다.
+ * 가속도 오프셋은 아직 보정된 적이 없고(모두 0) 보드가 수평일 때만 구합니다.
+ * 
+ * 결과가 저장값과 거의 같으면 발행하지 않아 부팅마다 플래시를 쓰지 않습니다.
+ * BLE보다 먼저 초기화되므로 이 시점의 레지스트리 작성자는 이 함수뿐입니다.
+ */
+static esp_err_t calibrate_imu_wrapper(void) {
+    const imu_calibration_config_t config = {
+        .target_samples = (uint32_t)IMU_SAMPLE_RATE_HZ * CONFIG_IMU_CALIB_DURATION_MS / 1000,
+        .gyro_motion_dps = CONFIG_IMU_CALIB_GYRO_MOTION_DPS,
+        .accel_motion_g = CONFIG_IMU_CALIB_ACCEL_MOTION_G,
+        .level_tolerance_g = CONFIG_IMU_CALIB_LEVEL_TOL_G,
+        .quiet_dps = CONFIG_IMU_CALIB_QUIET_DPS,
+        .quiet_hold_s = CONFIG_IMU_CALIB_QUIET_HOLD_S,
+        .track_tau_s = CONFIG_IMU_CALIB_TRACK_TAU_S,
+    };
+    imu_calibration_init(&imu_calibration, &config);
+    if (!imu_sensor_is_initialized(&imu)) {
+        return ESP_FAIL;
+    }
+
+    imu_offsets_t stored;
+    imu_offsets_from_params(&control_params, &stored);
+    imu_sensor_set_offsets(&imu, &stored);
+    bool accel_uncalibrated = stored.accel[0] == 0.0f && stored.accel[1] == 0.0f && stored.accel[2] == 0.0f;
+    imu_calibration_start(&imu_calibration, accel_uncalibrated);
+
+    int64_t start_us = control_scheduler_now_us();
+#if !CONFIG_IMU_FIFO_MODE
+    // Absolute wake-ups hold the nominal rate, so target_samples spans CONFIG_IMU_CALIB_DURATION_MS
+    // (the loop rate divides the tick rate, checked at the top of this file)
+    const TickType_t sample_ticks = (TickType_t)(configTICK_RATE_HZ / IMU_SAMPLE_RATE_HZ);
+    TickType_t last_wake = xTaskGetTickCount();
+#endif
+    bool done = false;
+    while (!done && control_scheduler_now_us() - start_us < (int64_t)CONFIG_IMU_CALIB_TIMEOUT_MS * 1000) {
+#if CONFIG_IMU_FIFO_MODE
+        static imu_sample_t batch[IMU_FIFO_MAX_BATCH];
+        size_t count = 0;
+        if (imu_sensor_read_fifo(&imu, batch, IMU_FIFO_MAX_BATCH, &count) != ESP_OK) {
+            return ESP_FAIL;
+        }
+        for (size_t i = 0; i < count && !done; i++) {
+            done = imu_calibration_add(&imu_calibration, &batch[i]) == IMU_CALIB_DONE;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+#else
+        if (imu_sensor_update(&imu) != ESP_OK) {
+            return ESP_FAIL;
+        }
+        const imu_sample_t sample = {
+            .accel_x = imu_sensor_get_accel_x(&imu), .accel_y = imu_sensor_get_accel_y(&imu),
+            .accel_z = imu_sensor_get_accel_z(&imu), .gyro_x = imu_sensor_get_gyro_x(&imu),
+            .gyro_y = imu_sensor_get_gyro_y(&imu), .gyro_z = imu_sensor_get_gyro_z(&imu),
+            .pitch = imu_sensor_get_pitch(&imu),
+        };
+        done = imu_calibration_add(&imu_calibration, &sample) == IMU_CALIB_DONE;
+        xTaskDelayUntil(&last_wake, sample_ticks);
+#endif
+    }
+
+    if (!done) {
+        ESP_LOGW(TAG, "IMU kept moving during calibration (%lu restarts), using saved offsets",
+                 (unsigned long)imu_calibration.restarts);
+        return ESP_OK;
+    }
+
+    imu_offsets_t offsets = stored;
+    bool accel_done = imu_calibration_apply(&imu_calibration, &offsets);
+    ESP_LOGI(TAG, "IMU calibrated in %lld ms: gyro offset %.3f %.3f %.3f deg/s%s",
+             (long long)((control_scheduler_now_us() - start_us) / 1000),
+             offsets.gyro[0], offsets.gyro[1], offsets.gyro[2],
+             accel_done ? ", accel offsets estimated" : "");
+
+    bool changed = accel_done;
+    for (int i = 0; i < 3; i++) {
+        changed = changed || fabsf(offsets.gyro[i] - stored.gyro[i]) > CONFIG_IMU_CALIB_SAVE_DELTA_DPS;
+    }
+    if (!changed) {
+        return ESP_OK;
+    }
+
+    const param_update_t updates[] = {
+        { PARAM_GYRO_OFFSET_X, offsets.gyro[0] },
+        { PARAM_GYRO_OFFSET_Y, offsets.gyro[1] },
+        { PARAM_GYRO_OFFSET_Z, offsets.gyro[2] },
+        { PARAM_ACCEL_OFFSET_X, offsets.accel[0] },
+        { PARAM_ACCEL_OFFSET_Y, offsets.accel[1] },
+        { PARAM_ACCEL_OFFSET_Z, offsets.accel[2] },
+    };
+    if (param_registry_set(&param_registry, updates, sizeof(updates) / sizeof(updates[0])) != PARAM_OK) {
+        ESP_LOGW(TAG, "IMU offsets out of range, sensor may be faulty; using saved offsets");
+        return ESP_OK;
+    }
+    param_registry_read(&param_registry, &control_params);
+    return ESP_OK;
+}
+
+/**
+ * @brief 파라미터 세트의 IMU 오프셋 구현
+ */
+static void imu_offsets_from_params(const robot_params_t* params, imu_offsets_t* offsets) {
+    offsets->gyro[0] = params->gyro_offset_x;
+    offsets->gyro[1] = params->gyro_offset_y;
+    offsets->gyro[2] = params->gyro_offset_z;
+    offsets->accel[0] = params->accel_offset_x;
+    offsets->accel[1] = params->accel_offset_y;
+    offsets->accel[2] = params->accel_offset_z;
+}
+
+/**
+ * @brief config.h의 바퀴 속도 추정기 설정 적용
+ * 
+ * @param encoder 엔코더 센서 구조체 포인터
+ */
+static void apply_encoder_velocity_config(encoder_sensor_t* encoder) {
+    const velocity_estimator_config_t config = {
+        .tracker = CONFIG_ENCODER_VEL_TRACKER ? VELOCITY_TRACKER_KALMAN : VELOCITY_TRACKER_ALPHA_BETA,
+        .alpha = CONFIG_ENCODER_VEL_ALPHA,
+        .beta = CONFIG_ENCODER_VEL_BETA,
+        .jerk_noise = CONFIG_ENCODER_VEL_JERK_NOISE,
+        .edge_jitter_us = CONFIG_ENCODER_EDGE_JITTER_US,
+        .min_span_s = CONFIG_ENCODER_MIN_SPAN_US / 1000000.0f,
+        .stop_timeout_s = CONFIG_ENCODER_STOP_TIMEOUT_MS / 1000.0f,
+    };
+    encoder_sensor_set_velocity_config(encoder, &config);
 }
 
 /**
  * @brief 좌측 엔코더 초기화 래퍼 함수
  * 
  * config.h에 정의된 설정값을 사용하여 좌측 바퀴 엔코더를 초기화하는 래퍼 함수입니다.
+ * CONFIG_ENCODER_PCNT_MODE이면 PCNT 하드웨어 카운터, 아니면 GPIO 인터럽트로 카운트합니다.
  * 
  * @return ESP_OK 성공, ESP_FAIL 실패
  */
 static esp_err_t init_left_encoder_wrapper(void) {
-    return encoder_sensor_init(&left_encoder, CONFIG_LEFT_ENC_A_PIN, CONFIG_LEFT_ENC_B_PIN, CONFIG_ENCODER_PPR, CONFIG_WHEEL_DIAMETER_CM);
+#if CONFIG_ENCODER_PCNT_MODE
+    esp_err_t ret = encoder_sensor_init_pcnt(&left_encoder, CONFIG_LEFT_ENC_A_PIN, CONFIG_LEFT_ENC_B_PIN, CONFIG_ENCODER_PPR,
+                                             CONFIG_WHEEL_DIAMETER_CM, CONFIG_ENCODER_GLITCH_NS);
+#else
+    esp_err_t ret = encoder_sensor_init(&left_encoder, CONFIG_LEFT_ENC_A_PIN, CONFIG_LEFT_ENC_B_PIN, CONFIG_ENCODER_PPR, CONFIG_WHEEL_DIAMETER_CM);
+#endif
+    apply_encoder_velocity_config(&left_encoder);
+    return ret;
 }
 
 /**
  * @brief 우측 엔코더 초기화 래퍼 함수
  * 
  * config.h에 정의된 설정값을 사용하여 우측 바퀴 엔코더를 초기화하는 래퍼 함수입니다.
+ * CONFIG_ENCODER_PCNT_MODE이면 PCNT 하드웨어 카운터, 아니면 GPIO 인터럽트로 카운트합니다.
  * 
  * @return ESP_OK 성공, ESP_FAIL 실패
  */
 static esp_err_t init_right_encoder_wrapper(void) {
-    return encoder_sensor_init(&right_encoder, CONFIG_RIGHT_ENC_A_PIN, CONFIG_RIGHT_ENC_B_PIN, CONFIG_ENCODER_PPR, CONFIG_WHEEL_DIAMETER_CM);
+#if CONFIG_ENCODER_PCNT_MODE
+    esp_err_t ret = encoder_sensor_init_pcnt(&right_encoder, CONFIG_RIGHT_ENC_A_PIN, CONFIG_RIGHT_ENC_B_PIN, CONFIG_ENCODER_PPR,
+                                             CONFIG_WHEEL_DIAMETER_CM, CONFIG_ENCODER_GLITCH_NS);
+#else
+    esp_err_t ret = encoder_sensor_init(&right_encoder, CONFIG_RIGHT_ENC_A_PIN, CONFIG_RIGHT_ENC_B_PIN, CONFIG_ENCODER_PPR, CONFIG_WHEEL_DIAMETER_CM);
+#endif
+    apply_encoder_velocity_config(&right_encoder);
+    return ret;
 }
 
 /**
@@ -376,7 +731,9 @@ static esp_err_t init_gps_wrapper(void) {
  * @return ESP_OK 성공, ESP_FAIL 실패
  */
 static esp_err_t init_ble_wrapper(void) {
-    return ble_controller_init(&ble_controller, CONFIG_BLE_DEVICE_NAME);
+    esp_err_t ret = ble_controller_init(&ble_controller, CONFIG_BLE_DEVICE_NAME);
+    ble_controller_set_param_registry(&ble_controller, &param_registry);
+    return ret;
 }
 
 /**
@@ -403,7 +760,7 @@ static esp_err_t init_servo_wrapper(void) {
  * - GPS 센서
  * - BLE 컨트롤러
  * - 서보 기립 시스템
- * - 칼만 필터
+ * - 자세 추정기
  * - 좌우 모터 제어기
  * - PID 제어기
  */
@@ -414,6 +771,7 @@ static void initialize_robot(void) {
     // Define component configurations
     component_info_t components[] = {
         {"IMU_Sensor", init_imu_wrapper, COMPONENT_CRITICAL, false, 0},
+        {"IMU_Calibration", calibrate_imu_wrapper, COMPONENT_OPTIONAL, false, 0},
         {"Left_Encoder", init_left_encoder_wrapper, COMPONENT_CRITICAL, false, 0},
         {"Right_Encoder", init_right_encoder_wrapper, COMPONENT_CRITICAL, false, 0},
         {"GPS_Sensor", init_gps_wrapper, COMPONENT_OPTIONAL, false, 0},
@@ -428,10 +786,10 @@ static void initialize_robot(void) {
         initialize_component_with_retry(&components[i]);
     }
     
-    // Initialize Kalman filter
-    kalman_filter_init(&kalman_pitch);
-    kalman_filter_set_angle(&kalman_pitch, 0.0f);
-    ESP_LOGI(TAG, "Kalman filter initialized");
+    // Initialize attitude estimator (aligns to the accelerometer on the first sample)
+    attitude_estimator_init(&attitude, (attitude_filter_type_t)CONFIG_ATTITUDE_FILTER);
+    ESP_LOGI(TAG, "Attitude estimator initialized (%s)",
+             attitude_estimator_type_name(attitude_estimator_get_type(&attitude)));
     
     // Initialize motors (these are always critical)
     esp_err_t ret = motor_control_init(&left_motor, CONFIG_LEFT_MOTOR_A_PIN, CONFIG_LEFT_MOTOR_B_PIN, CONFIG_LEFT_MOTOR_EN_PIN, CONFIG_LEFT_MOTOR_CHANNEL);
@@ -451,8 +809,19 @@ static void initialize_robot(void) {
     ESP_LOGI(TAG, "Right motor initialized");
     
     // Initialize PID controllers
-    pid_controller_init(&balance_pid, CONFIG_BALANCE_PID_KP, CONFIG_BALANCE_PID_KI, CONFIG_BALANCE_PID_KD);
-    pid_controller_set_output_limits(&balance_pid, CONFIG_PID_OUTPUT_MIN, CONFIG_PID_OUTPUT_MAX);
+    balance_pid_init(&balance_pid);
+    pid_controller_set_output_limits(&balance_pid.pitch_pid, CONFIG_PID_OUTPUT_MIN, CONFIG_PID_OUTPUT_MAX);
+
+    // Gains, filter parameters and thresholds come from the parameter registry
+    control_params_version = param_registry_read(&param_registry, &control_params);
+    apply_control_params(&control_params, NULL);
+    balance_pid_reset(&balance_pid);
+    ESP_LOGI(TAG, "Cascaded balance control: angle loop %d Hz, velocity loop %lu Hz",
+             CONFIG_CONTROL_LOOP_HZ, (unsigned long)(CONFIG_CONTROL_LOOP_HZ / control_params.velocity_divider));
+#if CONFIG_CONTROL_FIXED_POINT
+    balance_pid_q_load(&balance_pid_q, &balance_pid);
+    ESP_LOGI(TAG, "Fixed-point control path enabled (Q16.16 signals, Q2.30 dt/covariance)");
+#endif
     ESP_LOGI(TAG, "PID controllers initialized");
     
     // Log system health after initialization
@@ -460,112 +829,386 @@ static void initialize_robot(void) {
 }
 
 /**
- * @brief 센서 데이터 수집 태스크
+ * @brief 제어 파이프라인 태스크
  * @param pvParameters FreeRTOS 태스크 파라미터 (사용안함)
  * 
- * 50Hz 주기로 실행되며 다음 작업을 수행합니다:
- * - IMU 센서 데이터 읽기 및 칼만 필터링
- * - GPS 데이터 업데이트
+ * 센서 읽기부터 모터 출력까지를 하나의 태스크에서 고정 위상으로 실행합니다.
+ * vTaskDelay 기반의 상대 지연은 루프 본문 시간만큼 주기가 늘어나고
+ * 다른 태스크의 부하에 따라 흔들리므로, 절대 시각 웨이크업을 사용하고
+ * 실제 경과 시간을 측정하여 필터와 제어기에 전달합니다.
+ * 
+ * 이 태스크는 최고 우선순위(5)로 APP_CPU에 고정되어 실행되므로, PRO_CPU의
+ * BLE 스택, GPS UART 처리, 로깅이 제어 주기를 흔들지 않습니다.
+ * 루프 본문 실행 시간은 매 주기 측정되어 상태 태스크가 사이클 예산으로 보고합니다.
+ * 
+ * CONFIG_IMU_DRDY_MODE에서는 타이머 대신 MPU6050 데이터 레디 인터럽트로 깨어나므로
+ * 센서 샘플과 제어 주기의 위상이 고정되고, I2C 읽기는 항상 새 샘플을 가져옵니다.
+ * 이 경우 사이클 예산은 샘플 시각부터 측정되어 ISR→태스크 지연까지 포함합니다.
+ */
+static void control_task(void *pvParameters) {
+    ESP_LOGI(TAG, "Control task started (%d Hz, %d us period, core %d)",
+             CONFIG_CONTROL_LOOP_HZ, CONFIG_CONTROL_PERIOD_US, xPortGetCoreID());
+
+    control_scheduler_init(&control_scheduler,
+                           CONFIG_CONTROL_PERIOD_US,
+                           CONFIG_CONTROL_MAX_DT_MS * 1000);
+
+#if CONFIG_IMU_DRDY_MODE
+    // The ISR must notify this task, so it is registered from here
+    imu_drdy_init(&imu_drdy, CONFIG_MPU6050_INT_PIN, IMU_SAMPLE_RATE_HZ / CONFIG_CONTROL_LOOP_HZ);
+    imu_drdy_active = imu_sensor_is_initialized(&imu) && imu_drdy_start(&imu_drdy) == ESP_OK;
+    if (!imu_drdy_active) {
+        ESP_LOGW(TAG, "IMU data-ready unavailable, using timer-paced control loop");
+    }
+#endif
+
+    const odometry_config_t odometry_config = {
+        .wheel_base_cm = CONFIG_WHEEL_BASE_CM,
+        .cm_per_count = (float)M_PI * CONFIG_WHEEL_DIAMETER_CM / CONFIG_ENCODER_PPR,
+        .gyro_weight = CONFIG_ODOM_GYRO_WEIGHT,
+        .distance_noise = CONFIG_ODOM_DISTANCE_NOISE,
+        .heading_walk_deg = CONFIG_ODOM_HEADING_WALK_DEG,
+        .initial_heading_std_deg = CONFIG_ODOM_INITIAL_HEADING_STD_DEG,
+        .gps_gate = CONFIG_ODOM_GPS_GATE,
+        .gps_align_distance_cm = CONFIG_ODOM_GPS_ALIGN_DISTANCE_CM,
+    };
+    odometry_init(&odometry, &odometry_config);
+
+    while (1) {
+        float dt = control_wait_next_cycle();
+
+        control_update_params();
+        control_update_sensors(dt);
+        control_update_commands();
+        control_update_actuators(dt);
+        publish_robot_snapshot();
+#if CONFIG_TELEMETRY_ENABLED
+        publish_telemetry_sample();
+#endif
+
+        control_scheduler_end_cycle(&control_scheduler);
+    }
+}
+
+/**
+ * @brief 다음 제어 주기 대기 구현
+ * 
+ * 데이터 레디 ISR이 기록한 샘플 시각으로 dt를 계산하므로 I2C 전송 시간이나
+ * 태스크 웨이크업 지연이 dt에 섞이지 않습니다. 두 주기 동안 펄스가 없으면
+ * (INT 배선 불량, 센서 정지) 현재 시각으로 주기를 진행하여 상태 머신과
+ * 안전 정지 로직이 계속 실행되도록 합니다.
+ * 
+ * @return float 이번 주기의 측정된 시간 간격 (초)
+ */
+static float control_wait_next_cycle(void) {
+#if CONFIG_IMU_DRDY_MODE
+    if (imu_drdy_active) {
+        int64_t sample_us;
+        TickType_t timeout = pdMS_TO_TICKS((2 * CONFIG_CONTROL_PERIOD_US) / 1000) + 1;
+        if (!imu_drdy_wait(&imu_drdy, timeout, &sample_us)) {
+            sample_us = control_scheduler_now_us();
+        }
+        return control_scheduler_mark_cycle(&control_scheduler, sample_us);
+    }
+#endif
+    return control_scheduler_wait_next(&control_scheduler);
+}
+
+/**
+ * @brief 센서 단계 구현
+ * @param dt 이번 주기의 측정된 시간 간격 (초)
+ * 
+ * - IMU 센서 데이터 읽기 및 자세 추정
+ *   (FIFO 모드: 쌓인 샘플 전체를 센서 샘플 간격으로 순서대로 필터에 적용)
  * - 엔코더 속도 계산
  * - 로봇 전체 이동 속도 계산 (좌우 바퀴 평균)
- * 
- * 이 태스크는 높은 우선순위(5)로 실행되어 정확한 센서 데이터 수집을 보장합니다.
  */
-static void sensor_task(void *pvParameters) {
-    ESP_LOGI(TAG, "Sensor task started");
+static void control_update_sensors(float dt) {
+    control_state.timestamp_us = control_scheduler_now_us();
+
+#if CONFIG_IMU_FIFO_MODE
+    // Drain the FIFO and integrate every sample at the sensor's own rate
+    static imu_sample_t imu_batch[IMU_FIFO_MAX_BATCH];
+    size_t sample_count = 0;
+    esp_err_t ret = imu_sensor_read_fifo(&imu, imu_batch, IMU_FIFO_MAX_BATCH, &sample_count);
+    const attitude_t* att = NULL;
+    if (ret == ESP_OK && sample_count > 0) {
+        float sample_dt = imu_sensor_get_sample_period(&imu);
+        bool offsets_changed = false;
+        for (size_t i = 0; i < sample_count; i++) {
+            const imu_sample_t* s = &imu_batch[i];
+            att = attitude_estimator_update(&attitude, s->accel_x, s->accel_y, s->accel_z,
+                                            s->gyro_x, s->gyro_y, s->gyro_z, sample_dt);
+            offsets_changed |= track_imu_bias(s, sample_dt);
+        }
+        // New offsets take effect from the next batch
+        if (offsets_changed) {
+            imu_sensor_set_offsets(&imu, &imu_offsets);
+        }
+    }
+    (void)dt;
+#else
+    // Update IMU and fuse it using the measured cycle time
+    const attitude_t* att = NULL;
+    esp_err_t ret = imu_sensor_update(&imu);
+    if (ret == ESP_OK) {
+        att = attitude_estimator_update(&attitude,
+                                        imu_sensor_get_accel_x(&imu), imu_sensor_get_accel_y(&imu),
+                                        imu_sensor_get_accel_z(&imu), imu_sensor_get_gyro_x(&imu),
+                                        imu_sensor_get_gyro_y(&imu), imu_sensor_get_gyro_z(&imu), dt);
+        const imu_sample_t sample = {
+            .accel_x = imu_sensor_get_accel_x(&imu), .accel_y = imu_sensor_get_accel_y(&imu),
+            .accel_z = imu_sensor_get_accel_z(&imu), .gyro_x = imu_sensor_get_gyro_x(&imu),
+            .gyro_y = imu_sensor_get_gyro_y(&imu), .gyro_z = imu_sensor_get_gyro_z(&imu),
+            .pitch = imu_sensor_get_pitch(&imu),
+        };
+        if (track_imu_bias(&sample, dt)) {
+            imu_sensor_set_offsets(&imu, &imu_offsets);
+        }
+    }
+#endif
+    if (att != NULL) {
+        control_state.angle = att->pitch;
+        control_state.angle_rate = att->pitch_rate;
+        control_state.roll = att->roll;
+        control_state.yaw_rate = att->yaw_rate;
+#if CONFIG_CONTROL_FIXED_POINT
+        attitude_estimator_get_pitch_q(&attitude, &control_signals_q.angle, &control_signals_q.angle_rate);
+#endif
+    }
     
-    while (1) {
-        // Update IMU
-        esp_err_t ret = imu_sensor_update(&imu);
-        if (ret == ESP_OK) {
-            // Apply Kalman filter to pitch angle
-            float dt = 0.02f; // 50Hz update rate
-            set_filtered_angle(kalman_filter_get_angle(&kalman_pitch, 
-                                                   imu_sensor_get_pitch(&imu),
-                                                   imu_sensor_get_gyro_y(&imu), 
-                                                   dt));
+    // Update motor speeds
+    encoder_sensor_update_speed(&left_encoder);
+    encoder_sensor_update_speed(&right_encoder);
+    control_state.left_speed = encoder_sensor_get_speed(&left_encoder);
+    control_state.right_speed = encoder_sensor_get_speed(&right_encoder);
+    
+    // Calculate robot velocity (average of both wheels)
+    control_state.velocity = (control_state.left_speed + control_state.right_speed) / 2.0f;
+#if CONFIG_CONTROL_FIXED_POINT
+    control_signals_q.velocity = q_add(q16_from_float(control_state.left_speed),
+                                       q16_from_float(control_state.right_speed)) / 2;
+#endif
+
+    control_update_odometry(dt);
+}
+
+/**
+ * @brief 오도메트리 단계 구현
+ * @param dt 이번 주기의 측정된 시간 간격 (초)
+ * 
+ * 센서 단계에서 갱신한 엔코더 카운트와 요 각속도를 적분합니다. GPS 고정은
+ * GPS 태스크가 스냅샷으로 발행하며, 발행 번호가 바뀐 경우에만 한 번 융합합니다.
+ * 결과 자세는 로봇 상태 스냅샷에 실려 다른 태스크가 lock-free로 읽습니다.
+ */
+static void control_update_odometry(float dt) {
+    odometry_update(&odometry,
+                    encoder_sensor_get_position(&left_encoder),
+                    encoder_sensor_get_position(&right_encoder),
+                    control_state.yaw_rate, dt);
+
+#if CONFIG_ODOM_GPS_FUSION
+    gps_data_t fix;
+    uint32_t fix_count = state_snapshot_read(&gps_snapshot, &fix);
+    if (fix_count != gps_fused_count) {
+        gps_fused_count = fix_count;
+        if (fix.fix_valid) {
+            // Receivers that report an accuracy estimate (UBX) replace the fixed NMEA default
+            float std_cm = fix.accuracy > 0.0f ? fix.accuracy * 100.0f : CONFIG_ODOM_GPS_STD_CM;
+            odometry_fuse_gps(&odometry, fix.latitude, fix.longitude, std_cm);
         }
-        
-        // Update GPS
-        gps_sensor_update(&gps);
-        
-        // Update motor speeds
-        encoder_sensor_update_speed(&left_encoder);
-        encoder_sensor_update_speed(&right_encoder);
-        
-        // Calculate robot velocity (average of both wheels)
-        set_robot_velocity((encoder_sensor_get_speed(&left_encoder) + encoder_sensor_get_speed(&right_encoder)) / 2.0f);
-        
-        vTaskDelay(pdMS_TO_TICKS(20)); // 50Hz
     }
+#endif
+
+    control_state.x_cm = odometry.x_cm;
+    control_state.y_cm = odometry.y_cm;
+    control_state.heading = odometry_get_heading_deg(&odometry);
+    control_state.position_std_cm = odometry_get_position_std_cm(&odometry);
 }
 
 /**
- * @brief 밸런싱 제어 태스크
- * @param pvParameters FreeRTOS 태스크 파라미터 (사용안함)
+ * @brief 명령 단계 구현
+ * 
+ * BLE 콜백이 넣은 명령을 수신 순서대로 모두 꺼내 마지막 명령을 적용합니다.
+ * 큐는 명령을 통째로 복사해 넘기므로 제어 주기 도중 명령이 바뀌거나
+ * 찢어진 명령을 읽는 일이 없고, 오래된 명령은 큐에서 걸러집니다.
+ * 새 명령이 없으면 직전 명령을 유지하되, CONFIG_COMMAND_TIMEOUT_MS가 지나면
+ * 워치독이 이동 명령을 0까지 줄입니다.
+ */
+static void control_update_commands(void) {
+    int64_t now_us = control_scheduler_now_us();
+    remote_command_t cmd;
+    while (ble_controller_next_command(&ble_controller, now_us, &cmd)) {
+        received_command = cmd;
+        command_watchdog_feed(&command_watchdog, now_us);
+    }
+    command_watchdog_apply(&command_watchdog, now_us, &received_command, &control_command);
+}
+
+/**
+ * @brief 파라미터 단계 구현
+ * 
+ * BLE 콜백이 발행한 세트를 주기 시작 시 통째로 읽어 적용하므로, 한 주기 안에서
+ * 옛 값과 새 값이 섞이지 않고 묶음으로 보낸 게인은 같은 주기부터 함께 쓰입니다.
+ * 발행 번호가 같으면 스냅샷 읽기만 하고 끝납니다.
+ */
+static void control_update_params(void) {
+    robot_params_t params;
+    uint32_t version = param_registry_read(&param_registry, &params);
+    if (version == control_params_version) {
+        return;
+    }
+    apply_control_params(&params, &control_params);
+    control_params = params;
+    control_params_version = version;
+}
+
+/**
+ * @brief 파라미터 세트 적용 구현
+ * 
+ * 게인과 필터 파라미터만 바꾸고 적분/필터 상태는 유지하므로 밸런싱 중에도
+ * 출력이 튀지 않습니다.
+ */
+static void apply_control_params(const robot_params_t* params, const robot_params_t* previous) {
+    balance_pid_set_balance_tunings(&balance_pid, params->balance_kp, params->balance_ki, params->balance_kd);
+    balance_pid_set_velocity_tunings(&balance_pid, params->velocity_kp, params->velocity_ki, params->velocity_kd);
+    pid_controller_set_output_limits(&balance_pid.velocity_pid, -params->velocity_tilt_limit, params->velocity_tilt_limit);
+    balance_pid_set_max_tilt_angle(&balance_pid, params->fallen_angle);
+    balance_pid_set_angle_offset(&balance_pid, params->angle_target);
+    // Setting the divider restarts the velocity loop phase, so only do it on a real change
+    if (previous == NULL || previous->velocity_divider != params->velocity_divider) {
+        balance_pid_set_velocity_divider(&balance_pid, params->velocity_divider);
+    }
+#if CONFIG_CONTROL_FIXED_POINT
+    balance_pid_q_configure(&balance_pid_q, &balance_pid);
+    control_signals_q.max_speed = q16_from_float(params->max_speed_cms);
+#endif
+
+    attitude_estimator_set_mahony_gains(&attitude, params->mahony_kp, params->mahony_ki);
+    attitude_estimator_set_madgwick_beta(&attitude, params->madgwick_beta);
+    attitude_estimator_set_kalman_noise(&attitude, params->kalman_q_angle, params->kalman_q_bias, params->kalman_r_measure);
+    attitude_estimator_set_complementary_tau(&attitude, params->complementary_tau);
+    // Switching reseeds the new filter from the current attitude, so only do it on a real change
+    if (previous == NULL || previous->attitude_filter != params->attitude_filter) {
+        attitude_estimator_select(&attitude, (attitude_filter_type_t)params->attitude_filter);
+    }
+
+    // Offsets refined by online tracking are only replaced when the set itself changes them
+    imu_offsets_t offsets;
+    imu_offsets_from_params(params, &offsets);
+    imu_offsets_t before;
+    if (previous != NULL) {
+        imu_offsets_from_params(previous, &before);
+    }
+    if (previous == NULL || memcmp(&offsets, &before, sizeof(offsets)) != 0) {
+        imu_offsets = offsets;
+        imu_sensor_set_offsets(&imu, &imu_offsets);
+    }
+}
+
+/**
+ * @brief 자이로 바이어스 추적 구현
+ * 
+ * 로봇이 IDLE일 때만 추적합니다. 밸런싱 중에는 느린 회전이나 조종 입력이
+ * 바이어스로 오인될 수 있으므로 정지 대기 시간을 다시 셉니다.
+ * 추적한 값은 RAM에만 두고, 다음 부팅 보정이 다시 구합니다.
+ */
+static bool track_imu_bias(const imu_sample_t* sample, float dt) {
+    if (current_state != ROBOT_STATE_IDLE) {
+        imu_calibration_track_reset(&imu_calibration);
+        return false;
+    }
+    return imu_calibration_track(&imu_calibration, sample, dt, &imu_offsets);
+}
+
+/**
+ * @brief 제어 단계 구현
+ * @param dt 이번 주기의 측정된 시간 간격 (초)
  * 
- * 50Hz 주기로 실행되며 다음 작업을 수행합니다:
  * - 상태 머신 업데이트 및 상태 전환 처리
  * - 현재 상태에 따른 제어 로직 실행
- * - PID 제어 계산 (밸런싱 상태에서)
+ * - 캐스케이드 제어 계산 (밸런싱 상태에서: 속도 루프 → 각도 루프)
  * - 모터 제어 명령 적용
  * 
  * 상태별 동작:
  * - IDLE: 모터 정지, PID 리셋
- * - BALANCING: PID 제어 기반 밸런싱
+ * - BALANCING: 원격 방향/속도를 목표 속도로 하는 캐스케이드 밸런싱
  * - STANDING_UP: 모터 정지, 서보 동작
  * - FALLEN/ERROR: 비상 정지
  */
-static void balance_task(void *pvParameters) {
-    ESP_LOGI(TAG, "Balance task started");
+static void control_update_actuators(float dt) {
+    // Update state machine first
+    state_machine_update();
 
-    while (1) {
-        // Update state machine first
-        state_machine_update();
-
-        remote_command_t cmd = ble_controller_get_command(&ble_controller);
-        robot_state_t state = get_robot_state();
-
-        // Handle different robot states
-        switch (state) {
-        case ROBOT_STATE_IDLE:
-            // Stop motors and reset PID
-            motor_control_stop(&left_motor);
-            motor_control_stop(&right_motor);
-            pid_controller_reset(&balance_pid);
-            break;
-
-        case ROBOT_STATE_BALANCING:
-            // Set PID setpoint to maintain balance (0 degrees)
-            pid_controller_set_setpoint(&balance_pid, CONFIG_BALANCE_ANGLE_TARGET);
-
-            // Compute balance control (dt = 20ms = 0.02s for 50Hz update rate)
-            float dt = CONFIG_BALANCE_UPDATE_RATE / 1000.0f;
-            float motor_output = pid_controller_compute(&balance_pid, get_filtered_angle(), dt);
-
-            // Apply motor commands
-            update_motors(motor_output, cmd);
-            break;
-
-        case ROBOT_STATE_STANDING_UP:
-            // Motors stopped during standup
-            motor_control_stop(&left_motor);
-            motor_control_stop(&right_motor);
-            pid_controller_reset(&balance_pid);
-            break;
-
-        case ROBOT_STATE_FALLEN:
-        case ROBOT_STATE_ERROR:
-        default:
-            // Emergency stop
-            motor_control_stop(&left_motor);
-            motor_control_stop(&right_motor);
-            pid_controller_reset(&balance_pid);
-            break;
-        }
-        
-        vTaskDelay(pdMS_TO_TICKS(20)); // 50Hz control loop
+    remote_command_t cmd = control_command;
+    robot_state_t state = get_robot_state();
+    control_motor_command[0] = 0;
+    control_motor_command[1] = 0;
+
+    // Handle different robot states
+    switch (state) {
+    case ROBOT_STATE_IDLE:
+        // Stop motors and reset PID
+        motor_control_stop(&left_motor);
+        motor_control_stop(&right_motor);
+        reset_balance_controller();
+        break;
+
+    case ROBOT_STATE_BALANCING: {
+        // Remote direction/speed becomes the outer loop's velocity target,
+        // then velocity loop (sub-rate) → tilt target → angle loop with gyro rate as the D term
+#if CONFIG_CONTROL_FIXED_POINT
+        balance_pid_q_set_target_velocity(&balance_pid_q, command_target_velocity_q(cmd));
+        int32_t motor_output = q16_to_int(balance_pid_q_compute_balance(&balance_pid_q, control_signals_q.angle,
+                                                                        control_signals_q.angle_rate,
+                                                                        control_signals_q.velocity,
+                                                                        q30_from_float(dt)));
+#else
+        balance_pid_set_target_velocity(&balance_pid, command_target_velocity(cmd));
+        int32_t motor_output = (int32_t)balance_pid_compute_balance(&balance_pid, control_state.angle,
+                                                                    control_state.angle_rate, control_state.velocity, dt);
+#endif
+
+        // Apply motor commands
+        update_motors(motor_output, cmd);
+        break;
     }
+
+    case ROBOT_STATE_STANDING_UP:
+        // Motors stopped during standup
+        motor_control_stop(&left_motor);
+        motor_control_stop(&right_motor);
+        reset_balance_controller();
+        break;
+
+    case ROBOT_STATE_FALLEN:
+    case ROBOT_STATE_ERROR:
+    default:
+        // Emergency stop
+        motor_control_stop(&left_motor);
+        motor_control_stop(&right_motor);
+        reset_balance_controller();
+        break;
+    }
+}
+
+#if CONFIG_CONTROL_FIXED_POINT
+static q16_t command_target_velocity_q(remote_command_t cmd) {
+    // direction (-1..1) × speed (0..100) as a Q16.16 fraction of the maximum speed
+    q16_t fraction = (q16_t)(cmd.direction * cmd.speed * Q16_ONE / 100);
+    return q16_mul(fraction, control_signals_q.max_speed);
+}
+#else
+static float command_target_velocity(remote_command_t cmd) {
+    return (float)cmd.direction * (float)cmd.speed / 100.0f * control_params.max_speed_cms;
+}
+#endif
+
+static void reset_balance_controller(void) {
+    balance_pid_reset(&balance_pid);
+#if CONFIG_CONTROL_FIXED_POINT
+    balance_pid_q_reset(&balance_pid_q);
+#endif
 }
 
 /**
@@ -575,8 +1218,9 @@ static void balance_task(void *pvParameters) {
  * 1Hz 주기로 실행되며 다음 작업을 수행합니다:
  * - BLE 연결 시 구조화된 상태 데이터 전송
  * - 시리얼 콘솔에 디버그 정보 출력
- * - GPS 수신 상태 및 좌표 정보 로깅
+ * - GPS 수신 상태 및 좌표 정보 로깅 (GPS 태스크가 발행한 스냅샷)
  * - 서보 기립 시스템 상태 모니터링
+ * - 제어 주기 지터/오버런 통계 및 사이클 예산(최악 루프 시간 대비 주기) 로깅
  * 
  * 전송되는 상태 정보:
  * - 기울어짐 각도, 이동 속도, 배터리 전압
@@ -587,43 +1231,216 @@ static void status_task(void *pvParameters) {
     ESP_LOGI(TAG, "Status task started");
     
     while (1) {
-        // Send BLE status
+        robot_state_snapshot_t snapshot;
+        get_robot_snapshot(&snapshot);
+        gps_data_t gps_data;
+        state_snapshot_read(&gps_snapshot, &gps_data);
+
+        // Send BLE status (high-rate controller data goes through the telemetry stream)
         if (ble_controller_is_connected(&ble_controller)) {
-            char status[128];
-            snprintf(status, sizeof(status), "Angle:%.2f Vel:%.1f GPS:%s", 
-                    get_filtered_angle(), get_robot_velocity(), 
-                    gps_sensor_has_fix(&gps) ? "OK" : "NO");
-            
-            if (gps_sensor_has_fix(&gps)) {
-                char gps_info[64];
-                snprintf(gps_info, sizeof(gps_info), " Lat:%.6f Lon:%.6f", 
-                        gps_sensor_get_latitude(&gps), gps_sensor_get_longitude(&gps));
-                strncat(status, gps_info, sizeof(status) - strlen(status) - 1);
-            }
-            
-            // Send structured status data instead of string
-            float angle = get_filtered_angle();
-            float velocity = get_robot_velocity();
             float battery_voltage = 3.7f; // TODO: Read actual battery voltage
-            ble_controller_send_status(&ble_controller, angle, velocity, battery_voltage);
+            ble_controller_send_status(&ble_controller, snapshot.angle, snapshot.velocity, battery_voltage);
         }
         
         // Print debug info to serial
         ESP_LOGI(TAG, "Angle: %.2f | Velocity: %.2f | GPS: %s", 
-                get_filtered_angle(), get_robot_velocity(), 
-                gps_sensor_has_fix(&gps) ? "Valid" : "Invalid");
+                snapshot.angle, snapshot.velocity, 
+                gps_data.fix_valid ? "Valid" : "Invalid");
         
-        if (gps_sensor_has_fix(&gps)) {
+        if (gps_data.fix_valid) {
             ESP_LOGI(TAG, "GPS - Lat: %.6f | Lon: %.6f | Sats: %d", 
-                    gps_sensor_get_latitude(&gps), 
-                    gps_sensor_get_longitude(&gps),
-                    gps_sensor_get_satellites(&gps));
+                    gps_data.latitude, 
+                    gps_data.longitude,
+                    gps_data.satellites);
+        }
+        if (gps_data.has_velocity) {
+            ESP_LOGI(TAG, "GPS - Speed: %.2f m/s | Course: %.1f deg | Accuracy: %.1f m",
+                    gps_data.speed, gps_data.course, gps_data.accuracy);
         }
         
+        ESP_LOGI(TAG, "Pose: x %.1f cm | y %.1f cm | heading %.1f deg | std %.1f cm",
+                snapshot.x_cm, snapshot.y_cm, snapshot.heading, snapshot.position_std_cm);
+
         ESP_LOGI(TAG, "Standup: %s", servo_standup_is_standing_up(&servo_standup) ? "Active" : "Idle");
+
+        // Report the window the control task closed at our last request, then close the next one;
+        // every cycle lands in exactly one window, including those between this read and the request
+        control_scheduler_stats_t timing;
+        if (control_scheduler_get_window(&control_scheduler, &timing) > 0) {
+            ESP_LOGI(TAG, "Control loop: dt=%.2f ms | period %lu..%lu us | jitter %lu us | overruns %lu",
+                    control_scheduler_get_dt(&control_scheduler) * 1000.0f,
+                    (unsigned long)timing.min_period_us, (unsigned long)timing.max_period_us,
+                    (unsigned long)timing.max_jitter_us, (unsigned long)timing.overrun_count);
+
+            // Cycle budget: worst-case loop body time must stay under the period
+            uint32_t budget_pct = (uint32_t)(((uint64_t)timing.max_busy_us * 100) / CONFIG_CONTROL_PERIOD_US);
+            if (budget_pct >= CONFIG_CONTROL_BUDGET_WARN_PCT || timing.budget_overrun_count > 0) {
+                ESP_LOGW(TAG, "Cycle budget: worst %lu us / %d us (%lu%%) | mean %lu us | over budget %lu",
+                        (unsigned long)timing.max_busy_us, CONFIG_CONTROL_PERIOD_US, (unsigned long)budget_pct,
+                        (unsigned long)control_scheduler_mean_busy_us(&timing),
+                        (unsigned long)timing.budget_overrun_count);
+            } else {
+                ESP_LOGI(TAG, "Cycle budget: worst %lu us / %d us (%lu%%) | mean %lu us",
+                        (unsigned long)timing.max_busy_us, CONFIG_CONTROL_PERIOD_US, (unsigned long)budget_pct,
+                        (unsigned long)control_scheduler_mean_busy_us(&timing));
+            }
+        }
+        control_scheduler_reset_stats(&control_scheduler);
+
+        if (ble_controller_is_connected(&ble_controller)) {
+            const ble_link_info_t* link = ble_controller_get_link_info(&ble_controller);
+            ESP_LOGI(TAG, "BLE link: MTU %u | interval %.2f ms | latency %u | data length %u",
+                    link->mtu, ble_link_interval_us(link) / 1000.0f, link->latency, link->tx_data_length);
+        }
+
+        command_queue_t* commands = ble_controller_get_command_queue(&ble_controller);
+        ESP_LOGI(TAG, "Commands: accepted %lu | duplicate %lu | reordered %lu | stale %lu | overflow %lu | watchdog trips %lu",
+                (unsigned long)atomic_load(&commands->accepted), (unsigned long)atomic_load(&commands->duplicated),
+                (unsigned long)atomic_load(&commands->reordered), (unsigned long)atomic_load(&commands->stale),
+                (unsigned long)atomic_load(&commands->overflowed),
+                (unsigned long)atomic_load(&command_watchdog.expirations));
+        ESP_LOGI(TAG, "Command latency: p50 < %lu ms | p90 < %lu ms | p99 < %lu ms | max %lu ms",
+                (unsigned long)command_queue_latency_percentile(commands, 50),
+                (unsigned long)command_queue_latency_percentile(commands, 90),
+                (unsigned long)command_queue_latency_percentile(commands, 99),
+                (unsigned long)atomic_load(&commands->latency_max_ms));
+
+#if CONFIG_TELEMETRY_ENABLED
+        ESP_LOGI(TAG, "Telemetry: packets %lu | send failures %lu | ring drops %lu",
+                (unsigned long)atomic_load_explicit(&telemetry_packets_sent, memory_order_relaxed),
+                (unsigned long)atomic_load_explicit(&telemetry_send_failures, memory_order_relaxed),
+                (unsigned long)atomic_load_explicit(&telemetry_ring.dropped, memory_order_relaxed));
+#endif
+
+#if CONFIG_IMU_DRDY_MODE
+        if (imu_drdy_active) {
+            ESP_LOGI(TAG, "IMU data-ready: samples %lu | dropped cycles %lu | timeouts %lu",
+                    (unsigned long)imu_drdy.sample_count, (unsigned long)imu_drdy.dropped_cycles,
+                    (unsigned long)imu_drdy.timeout_count);
+        }
+#endif
+
+        if (gps_sensor_is_initialized(&gps)) {
+            ESP_LOGI(TAG, "GPS NMEA: sentences %lu | checksum errors %lu | overlong %lu | UART overflows %lu",
+                    (unsigned long)gps.parser.sentences, (unsigned long)gps.parser.checksum_errors,
+                    (unsigned long)gps.parser.overflows, (unsigned long)gps.rx_overflows);
+            ESP_LOGI(TAG, "GPS UBX: frames %lu | checksum errors %lu | source %s @ %d baud",
+                    (unsigned long)gps.ubx.frames, (unsigned long)gps.ubx.checksum_errors,
+                    gps_sensor_is_ubx(&gps) ? "NAV-PVT" : "NMEA", gps.baudrate);
+        }
+
+        save_params_if_changed();
         
-        vTaskDelay(pdMS_TO_TICKS(1000)); // 1Hz status updates
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_STATUS_UPDATE_RATE)); // 1Hz status updates
+    }
+}
+
+/**
+ * @brief GPS 수신 태스크 구현
+ * 
+ * 수신 이벤트가 없으면 블록되어 있으므로 CPU를 쓰지 않습니다. 파싱은 이 태스크만
+ * 하며, 다른 태스크는 GPS 구조체 대신 스냅샷을 읽습니다 (카운터 로깅 제외).
+ * CONFIG_GPS_UBX_MODE이면 시작 시 수신기를 UBX NAV-PVT로 설정하고,
+ * CONFIG_GPS_UBX_PROBE_MS 동안 아무 데이터도 없으면 원래 보드레이트로 돌아갑니다.
+ */
+static void gps_task(void *pvParameters) {
+    ESP_LOGI(TAG, "GPS task started");
+
+#if CONFIG_GPS_UBX_MODE
+    // Ask a u-blox receiver for binary fixes; anything else keeps talking NMEA
+    bool probing = gps_sensor_configure_ubx(&gps, CONFIG_GPS_UBX_BAUDRATE, CONFIG_GPS_UBX_RATE_HZ) == ESP_OK;
+    int64_t probe_end_us = control_scheduler_now_us() + CONFIG_GPS_UBX_PROBE_MS * 1000LL;
+#endif
+
+    while (1) {
+        if (gps_sensor_update(&gps, CONFIG_GPS_EVENT_WAIT_MS)) {
+            state_snapshot_publish(&gps_snapshot, &gps.data);
+        }
+#if CONFIG_GPS_UBX_MODE
+        if (probing && control_scheduler_now_us() >= probe_end_us) {
+            probing = false;
+            gps_sensor_confirm_baudrate(&gps);
+        }
+#endif
+    }
+}
+
+/**
+ * @brief 저장된 파라미터 복원 구현
+ * 
+ * robot_params_t는 뒤에만 필드를 추가하므로, 기본값 세트 위에 저장본 길이만큼
+ * 덮어쓰면 이전 펌웨어가 저장한 세트도 그대로 복원되고 새 필드는 기본값이 됩니다.
+ * 범위를 벗어난 값이 있으면 저장본을 무시하고 config.h 기본값으로 시작합니다.
+ */
+static void load_saved_params(void) {
+    params_saved_version = param_registry_read(&param_registry, &control_params);
+    params_seen_version = params_saved_version;
+
+    esp_err_t ret = param_store_open_partition(&param_store, PARAM_PARTITION_LABEL);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Parameter partition '%s' missing, tuning will not persist", PARAM_PARTITION_LABEL);
+        return;
+    }
+    param_store_ready = true;
+
+    robot_params_t saved = control_params;
+    uint16_t length = 0;
+    uint16_t version = 0;
+    ret = param_store_load(&param_store, &saved, sizeof(saved), &length, &version);
+    if (ret != ESP_OK) {
+        ESP_LOGI(TAG, "No saved parameters, using defaults");
+        return;
+    }
+    if (version != PARAM_SET_VERSION) {
+        ESP_LOGW(TAG, "Saved parameters are schema v%u (firmware v%u), missing fields use defaults",
+                 (unsigned)version, (unsigned)PARAM_SET_VERSION);
+    }
+    if (param_registry_import(&param_registry, &saved) != PARAM_OK) {
+        ESP_LOGW(TAG, "Saved parameters out of range, using defaults");
+        return;
+    }
+
+    params_saved_version = param_registry_read(&param_registry, &control_params);
+    params_seen_version = params_saved_version;
+    ESP_LOGI(TAG, "Restored saved parameters (generation %lu, %u bytes)",
+             (unsigned long)param_store.generation, (unsigned)length);
+}
+
+/**
+ * @brief 파라미터 저장 구현
+ * 
+ * 플래시 기록 중에는 두 코어의 캐시가 꺼져 제어 주기가 밀리므로, 조정이 끝나
+ * 한 상태 주기 동안 값이 그대로이고 로봇이 밸런싱 중이 아닐 때만 저장합니다.
+ * 슬라이더를 움직이는 동안 들어오는 변경마다 기록하지 않아 플래시 마모도 줄어듭니다.
+ */
+static void save_params_if_changed(void) {
+    if (!param_store_ready) {
+        return;
+    }
+
+    robot_params_t params;
+    uint32_t version = param_registry_read(&param_registry, &params);
+    if (version == params_saved_version) {
+        return;
+    }
+    if (version != params_seen_version) {
+        params_seen_version = version;
+        return;
+    }
+
+    robot_state_snapshot_t snapshot;
+    get_robot_snapshot(&snapshot);
+    if (snapshot.state == ROBOT_STATE_BALANCING) {
+        return;
+    }
+
+    esp_err_t ret = param_store_save(&param_store, &params, sizeof(params), PARAM_SET_VERSION);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to save parameters: %s", esp_err_to_name(ret));
+        return;
     }
+    params_saved_version = version;
+    ESP_LOGI(TAG, "Parameters saved (generation %lu)", (unsigned long)param_store.generation);
 }
 
 /**
@@ -640,24 +1457,103 @@ static void status_task(void *pvParameters) {
  * 3. 우측 모터 = PID 출력 + 조향 보정
  * 4. 모터 속도 제한 (-255 ~ 255)
  */
-static void update_motors(float motor_output, remote_command_t cmd) {
+static void update_motors(int32_t motor_output, remote_command_t cmd) {
     // Apply turn adjustment
-    float turn_adjustment = cmd.turn * 0.5f; // Scale turn command
+    int32_t turn_adjustment = cmd.turn / 2; // Scale turn command
     
-    float left_motor_speed = motor_output - turn_adjustment;
-    float right_motor_speed = motor_output + turn_adjustment;
+    int32_t left_motor_speed = motor_output - turn_adjustment;
+    int32_t right_motor_speed = motor_output + turn_adjustment;
     
     // Constrain motor speeds
-    if (left_motor_speed > 255.0f) left_motor_speed = 255.0f;
-    if (left_motor_speed < -255.0f) left_motor_speed = -255.0f;
-    if (right_motor_speed > 255.0f) right_motor_speed = 255.0f;
-    if (right_motor_speed < -255.0f) right_motor_speed = -255.0f;
+    if (left_motor_speed > 255) left_motor_speed = 255;
+    if (left_motor_speed < -255) left_motor_speed = -255;
+    if (right_motor_speed > 255) right_motor_speed = 255;
+    if (right_motor_speed < -255) right_motor_speed = -255;
     
     // Apply to motors
     motor_control_set_speed(&left_motor, (int)left_motor_speed);
     motor_control_set_speed(&right_motor, (int)right_motor_speed);
+    control_motor_command[0] = (int16_t)left_motor_speed;
+    control_motor_command[1] = (int16_t)right_motor_speed;
 }
 
+#if CONFIG_TELEMETRY_ENABLED
+/**
+ * @brief 텔레메트리 전송 태스크 구현
+ * 
+ * 한 번 깨어날 때마다 링이 빌 때까지 패킷을 만들어 보냅니다. 샘플은 패킷마다
+ * 키프레임으로 시작하므로 BLE 스택이 거부한 패킷은 재전송하지 않고 시퀀스만 소비합니다.
+ * 협상된 MTU가 샘플 하나도 담지 못하면 (기본 MTU 23) 스트림을 보내지 않습니다.
+ */
+static void telemetry_task(void *pvParameters) {
+    static telemetry_packer_t packer;
+    uint16_t seq = 0;
+    TickType_t last_wake = xTaskGetTickCount();
+
+    ESP_LOGI(TAG, "Telemetry task started (%d Hz samples, %d ms flush)",
+             CONFIG_TELEMETRY_SAMPLE_HZ, CONFIG_TELEMETRY_FLUSH_MS);
+
+    while (1) {
+        xTaskDelayUntil(&last_wake, pdMS_TO_TICKS(CONFIG_TELEMETRY_FLUSH_MS));
+
+        uint16_t capacity = (uint16_t)(ble_controller_get_mtu(&ble_controller) - BLE_ATT_NOTIFY_OVERHEAD);
+        if (!ble_controller_is_connected(&ble_controller) || capacity < TELEMETRY_MIN_FRAME_SIZE) {
+            telemetry_ring_discard(&telemetry_ring);
+            continue;
+        }
+
+        uint16_t length;
+        while ((length = telemetry_pack_from_ring(&packer, &telemetry_ring, capacity, seq)) > 0) {
+            if (ble_controller_send_telemetry(&ble_controller, packer.frame, length) == ESP_OK) {
+                atomic_fetch_add_explicit(&telemetry_packets_sent, 1, memory_order_relaxed);
+            } else {
+                atomic_fetch_add_explicit(&telemetry_send_failures, 1, memory_order_relaxed);
+            }
+            seq++;
+        }
+    }
+}
+
+/**
+ * @brief 텔레메트리 샘플 발행 구현
+ * 
+ * 각도 루프의 P/I/D 항은 이번 주기 계산이 끝난 제어기 상태에서 복원합니다
+ * (P = Kp·오차, I = Ki·적분, D = -Kd·각속도). 밸런싱 중이 아니면 0입니다.
+ */
+static void publish_telemetry_sample(void) {
+    static uint32_t decimation = 0;
+    if (++decimation < CONFIG_CONTROL_LOOP_HZ / CONFIG_TELEMETRY_SAMPLE_HZ) {
+        return;
+    }
+    decimation = 0;
+
+    telemetry_sample_t sample = {
+        .timestamp_us = (uint32_t)control_state.timestamp_us,
+        .angle = control_state.angle,
+        .angle_rate = control_state.angle_rate,
+        .motor_left = control_motor_command[0],
+        .motor_right = control_motor_command[1],
+        .encoder_left = encoder_sensor_get_position(&left_encoder),
+        .encoder_right = encoder_sensor_get_position(&right_encoder),
+        .x_cm = control_state.x_cm,
+        .y_cm = control_state.y_cm,
+        .heading = control_state.heading,
+    };
+    if (current_state == ROBOT_STATE_BALANCING) {
+#if CONFIG_CONTROL_FIXED_POINT
+        sample.pid_p = q16_to_float(q16_mul(balance_pid_q.pitch_pid.kp, balance_pid_q.pitch_pid.previous_error));
+        sample.pid_i = q16_to_float(q16_mul(balance_pid_q.pitch_pid.ki, balance_pid_q.pitch_pid.integral));
+#else
+        sample.pid_p = balance_pid.pitch_pid.kp * balance_pid.pitch_pid.previous_error;
+        sample.pid_i = balance_pid.pitch_pid.ki * balance_pid.pitch_pid.integral;
+#endif
+        sample.pid_d = -balance_pid.pitch_pid.kd * control_state.angle_rate;
+    }
+
+    telemetry_ring_push(&telemetry_ring, &sample);
+}
+#endif
+
 /**
  * @brief 원격 제어 명령 처리
  * 
@@ -666,237 +1562,112 @@ static void update_motors(float motor_output, remote_command_t cmd) {
  * - 밸런싱 활성화/비활성화: 밸런싱 제어 플래그 업데이트
  * 
  * 명령 처리 로직:
- * 1. BLE 컨트롤러에서 최신 명령 수신
+ * 1. 제어 태스크가 적용 중인 명령을 스냅샷에서 읽음 (명령 큐의 소비자는 제어 태스크 하나)
  * 2. 기립 명령 확인 및 서보 동작 요청
  * 3. 밸런싱 상태 업데이트
  * 4. 필요시 상태 정보 BLE 전송
  */
 static void handle_remote_commands(void) {
-    remote_command_t cmd = ble_controller_get_command(&ble_controller);
+    robot_state_snapshot_t snapshot;
+    get_robot_snapshot(&snapshot);
     
     // Handle standup command
-    if (cmd.standup && !servo_standup_is_standing_up(&servo_standup)) {
+    if (snapshot.standup_cmd && !servo_standup_is_standing_up(&servo_standup)) {
         servo_standup_request_standup(&servo_standup);
         // Send status with standup indication via system_status field
-        float angle = get_filtered_angle();
-        float velocity = get_robot_velocity(); 
         float battery_voltage = 3.7f; // TODO: Read actual battery voltage
-        ble_controller_send_status(&ble_controller, angle, velocity, battery_voltage);
+        ble_controller_send_status(&ble_controller, snapshot.angle, snapshot.velocity, battery_voltage);
     }
 
     // Update balancing state
-    set_balancing_enabled(cmd.balance);
-}
-
-/**
- * @brief 칼만 필터링된 각도 값을 안전하게 읽기
- * 
- * 뮤텍스를 사용하여 스레드 안전하게 현재 피치 각도를 읽습니다.
- * 
- * @return float 현재 피치 각도 (degree)
- */
-static float get_filtered_angle(void) {
-    float angle = 0.0f;
-    if (xSemaphoreTake(data_mutex, portMAX_DELAY) == pdTRUE) {
-        angle = filtered_angle;
-        xSemaphoreGive(data_mutex);
-    }
-    return angle;
+    set_balancing_enabled(snapshot.balance_cmd);
 }
 
 /**
- * @brief 칼만 필터링된 각도 값을 안전하게 설정
+ * @brief 최신 로봇 상태 스냅샷 읽기
  * 
- * 뮤텍스를 사용하여 스레드 안전하게 피치 각도를 업데이트합니다.
+ * 제어 태스크가 마지막으로 발행한 일관된 상태를 복사합니다.
+ * 뮤텍스를 사용하지 않으므로 어떤 우선순위의 태스크에서도 제어 태스크를 막지 않습니다.
  * 
- * @param angle 설정할 피치 각도 (degree)
+ * @param out 출력 스냅샷
  */
-static void set_filtered_angle(float angle) {
-    if (xSemaphoreTake(data_mutex, portMAX_DELAY) == pdTRUE) {
-        filtered_angle = angle;
-        xSemaphoreGive(data_mutex);
-    }
+static void get_robot_snapshot(robot_state_snapshot_t* out) {
+    state_snapshot_read(&robot_state_snapshot, out);
 }
 
 /**
- * @brief 로봇 이동 속도를 안전하게 읽기
- * 
- * 뮤텍스를 사용하여 스레드 안전하게 현재 이동 속도를 읽습니다.
+ * @brief 현재 주기의 로봇 상태를 스냅샷으로 발행
  * 
- * @return float 현재 이동 속도 (cm/s)
+ * 센서 및 제어 단계가 끝난 뒤 제어 주기마다 한 번 호출됩니다.
  */
-static float get_robot_velocity(void) {
-    float velocity = 0.0f;
-    if (xSemaphoreTake(data_mutex, portMAX_DELAY) == pdTRUE) {
-        velocity = robot_velocity;
-        xSemaphoreGive(data_mutex);
-    }
-    return velocity;
+static void publish_robot_snapshot(void) {
+    control_state.state = (uint8_t)current_state;
+    control_state.balance_cmd = control_command.balance;
+    control_state.standup_cmd = control_command.standup;
+    state_snapshot_publish(&robot_state_snapshot, &control_state);
 }
 
 /**
- * @brief 로봇 이동 속도를 안전하게 설정
- * 
- * 뮤텍스를 사용하여 스레드 안전하게 이동 속도를 업데이트합니다.
- * 
- * @param velocity 설정할 이동 속도 (cm/s)
- */
-static void set_robot_velocity(float velocity) {
-    if (xSemaphoreTake(data_mutex, portMAX_DELAY) == pdTRUE) {
-        robot_velocity = velocity;
-        xSemaphoreGive(data_mutex);
-    }
-}
-
-/**
- * @brief 밸런싱 활성화 상태를 안전하게 읽기
- * 
- * 뮤텍스를 사용하여 스레드 안전하게 밸런싱 활성화 상태를 읽습니다.
+ * @brief 밸런싱 활성화 상태 읽기
  * 
  * @return bool 밸런싱 활성화 여부 (true: 활성, false: 비활성)
  */
 static bool __attribute__((unused)) get_balancing_enabled(void) {
-    bool enabled = false;
-    if (xSemaphoreTake(data_mutex, portMAX_DELAY) == pdTRUE) {
-        enabled = balancing_enabled;
-        xSemaphoreGive(data_mutex);
-    }
-    return enabled;
+    return atomic_load(&balancing_enabled);
 }
 
 /**
- * @brief 밸런싱 활성화 상태를 안전하게 설정
- * 
- * 뮤텍스를 사용하여 스레드 안전하게 밸런싱 활성화 상태를 업데이트합니다.
+ * @brief 밸런싱 활성화 상태 설정
  * 
  * @param enabled 밸런싱 활성화 여부 (true: 활성, false: 비활성)
  */
 static void set_balancing_enabled(bool enabled) {
-    if (xSemaphoreTake(data_mutex, portMAX_DELAY) == pdTRUE) {
-        balancing_enabled = enabled;
-        xSemaphoreGive(data_mutex);
-    }
+    atomic_store(&balancing_enabled, enabled);
 }
 
 /**
- * @brief 현재 로봇 상태를 안전하게 읽기
+ * @brief 현재 로봇 상태 읽기
  * 
- * 뮤텍스를 사용하여 스레드 안전하게 현재 로봇 상태를 읽습니다.
+ * 상태는 제어 태스크(및 태스크 생성 전의 app_main)만 읽고 쓰므로 잠금이 필요 없습니다.
+ * 다른 태스크는 스냅샷의 state 필드를 사용합니다.
  * 
  * @return robot_state_t 현재 로봇 상태
  */
 static robot_state_t get_robot_state(void) {
-    robot_state_t state = ROBOT_STATE_ERROR;
-    if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
-        state = current_state;
-        xSemaphoreGive(state_mutex);
-    }
-    return state;
+    return current_state;
 }
 
 /**
- * @brief 로봇 상태를 안전하게 변경
+ * @brief 로봇 상태 변경
  * @param new_state 새로운 로봇 상태
  * 
- * 상태 변경 시 로그를 출력하고 뮤텍스로 보호합니다.
+ * 상태 변경 시 로그를 출력합니다.
  * 동일한 상태로의 변경은 로그를 출력하지 않습니다.
  */
 static void set_robot_state(robot_state_t new_state) {
-    if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
-        if (current_state != new_state) {
-            ESP_LOGI(TAG, "State change: %s -> %s",
-                    get_state_name(current_state), get_state_name(new_state));
-            current_state = new_state;
-        }
-        xSemaphoreGive(state_mutex);
-    }
-}
-
-/**
- * @brief 로봇 상태를 문자열로 변환
- * @param state 변환할 로봇 상태
- * @return const char* 상태를 나타내는 문자열
- * 
- * 로깅 및 디버깅 목적으로 상태 열거형을 읽기 쉬운 문자열로 변환합니다.
- */
-static const char* get_state_name(robot_state_t state) {
-    switch (state) {
-        case ROBOT_STATE_INIT: return "INIT";
-        case ROBOT_STATE_IDLE: return "IDLE";
-        case ROBOT_STATE_BALANCING: return "BALANCING";
-        case ROBOT_STATE_STANDING_UP: return "STANDING_UP";
-        case ROBOT_STATE_FALLEN: return "FALLEN";
-        case ROBOT_STATE_ERROR: return "ERROR";
-        default: return "UNKNOWN";
+    if (current_state != new_state) {
+        ESP_LOGI(TAG, "State change: %s -> %s",
+                robot_state_name(current_state), robot_state_name(new_state));
+        current_state = new_state;
     }
 }
 
 /**
  * @brief 상태 머신 업데이트 및 상태 전환 처리
  * 
- * 현재 센서 데이터와 원격 명령을 기반으로 상태 전환 조건을 확인하고
- * 필요시 상태를 변경합니다.
- * 
- * 상태 전환 조건:
- * - IDLE → BALANCING: 밸런싱 명령 수신 (기립 중이 아닐 때)
- * - IDLE → STANDING_UP: 기립 명령 수신
- * - BALANCING → IDLE: 밸런싱 명령 해제
- * - BALANCING → STANDING_UP: 기립 명령 수신
- * - any → FALLEN: 기울어짐 각도가 임계값 초과
- * - FALLEN → STANDING_UP: 기립 명령 수신 (회복 시도)
- * - STANDING_UP → IDLE: 기립 완료 또는 실패
+ * 현재 센서 데이터, 원격 명령, 서보 기립 상태를 모아
+ * robot_state_machine_next()로 다음 상태를 결정합니다.
+ * 전환 규칙은 robot_state_machine.h를 참고하세요.
  */
 static void state_machine_update(void) {
-    robot_state_t current = get_robot_state();
-    float angle = get_filtered_angle();
-    remote_command_t cmd = ble_controller_get_command(&ble_controller);
-
-    // State transitions based on conditions
-    switch (current) {
-    case ROBOT_STATE_IDLE:
-        if (cmd.balance && !servo_standup_is_standing_up(&servo_standup)) {
-            set_robot_state(ROBOT_STATE_BALANCING);
-        } else if (cmd.standup) {
-            set_robot_state(ROBOT_STATE_STANDING_UP);
-        }
-        // Check if fallen (angle too large)
-        if (fabsf(angle) > CONFIG_FALLEN_ANGLE_THRESHOLD) {
-            set_robot_state(ROBOT_STATE_FALLEN);
-        }
-        break;
-
-    case ROBOT_STATE_BALANCING:
-        if (!cmd.balance) {
-            set_robot_state(ROBOT_STATE_IDLE);
-        } else if (cmd.standup) {
-            set_robot_state(ROBOT_STATE_STANDING_UP);
-        } else if (fabsf(angle) > CONFIG_FALLEN_ANGLE_THRESHOLD) {
-            set_robot_state(ROBOT_STATE_FALLEN);
-        }
-        break;
-
-    case ROBOT_STATE_STANDING_UP:
-        if (servo_standup_is_complete(&servo_standup)) {
-            set_robot_state(ROBOT_STATE_IDLE);
-        } else if (!servo_standup_is_standing_up(&servo_standup)) {
-            // Standup failed or cancelled
-            set_robot_state(ROBOT_STATE_IDLE);
-        }
-        break;
-
-    case ROBOT_STATE_FALLEN:
-        // Can only recover through standup
-        if (cmd.standup) {
-            set_robot_state(ROBOT_STATE_STANDING_UP);
-        }
-        break;
-
-    case ROBOT_STATE_ERROR:
-        // Manual recovery required - could add auto-recovery logic here
-        break;
-
-    default:
-        set_robot_state(ROBOT_STATE_ERROR);
-        break;
-    }
+    remote_command_t cmd = control_command;
+    robot_state_inputs_t in = {
+        .angle = control_state.angle,
+        .fallen_angle = control_params.fallen_angle,
+        .balance_cmd = cmd.balance,
+        .standup_cmd = cmd.standup,
+        .standup_active = servo_standup_is_standing_up(&servo_standup),
+        .standup_complete = servo_standup_is_complete(&servo_standup),
+    };
+    set_robot_state(robot_state_machine_next(get_robot_state(), &in));
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 
 #include "ble_controller.h"
 #include "../system/protocol.h"
+#include "../config.h"
 #ifndef NATIVE_BUILD
 #include "esp_log.h"
 #include "esp_bt.h"
@@ -20,6 +21,7 @@
 #include "esp_bt_main.h"
 #include "esp_gatt_common_api.h"
 #include "esp_bt_device.h"
+#include "esp_timer.h"
 #endif
 #include <string.h>
 #include <stdio.h>
@@ -86,10 +88,40 @@ static esp_ble_adv_params_t adv_params = {
     .adv_filter_policy = ADV_FILTER_ALLOW_SCAN_ANY_CON_ANY,
 };
 
+static esp_err_t gap_update_conn_params(void* ctx, const ble_conn_params_t* params);
+static esp_err_t gap_set_data_length(void* ctx, uint16_t tx_octets);
+static esp_err_t gap_set_preferred_phy_2m(void* ctx);
+
+/// 링크 협상이 사용하는 ESP-IDF GAP 호출
+static const ble_gap_ops_t gap_ops = {
+    .update_conn_params = gap_update_conn_params,
+    .set_data_length = gap_set_data_length,
+    .set_preferred_phy_2m = gap_set_preferred_phy_2m,
+};
+
+/// 링크 협상 목표 (짧은 간격 → 완화된 간격 폴백)
+static const ble_link_config_t link_config = {
+    .preferred = {
+        .min_interval = CONFIG_BLE_CONN_INTERVAL_MIN,
+        .max_interval = CONFIG_BLE_CONN_INTERVAL_MAX,
+        .latency = 0,
+        .timeout = CONFIG_BLE_SUPERVISION_TIMEOUT,
+    },
+    .fallback = {
+        .min_interval = CONFIG_BLE_CONN_FALLBACK_MIN,
+        .max_interval = CONFIG_BLE_CONN_FALLBACK_MAX,
+        .latency = 0,
+        .timeout = CONFIG_BLE_SUPERVISION_TIMEOUT,
+    },
+    .data_length = CONFIG_BLE_DATA_LENGTH,
+    .prefer_2m_phy = CONFIG_BLE_PREFER_2M_PHY,
+};
+
 #ifndef NATIVE_BUILD
 // Forward declarations - 내부 콜백 및 헬퍼 함수들
 /// GATT 서버 이벤트 핸들러 선언
 static void gatts_event_handler(esp_gatts_cb_event_t event, esp_gatt_if_t gatts_if, esp_ble_gatts_cb_param_t *param);
+
 /// GAP 이벤트 핸들러 선언
 static void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param);
 /// GATT 서비스 생성 함수 선언
@@ -113,16 +145,17 @@ esp_err_t ble_controller_init(ble_controller_t* ble, const char* device_name) {
     
     // 구조체 초기화
     ble->device_connected = false;
-    ble->current_command.direction = 0;
-    ble->current_command.turn = 0;
-    ble->current_command.speed = 0;
-    ble->current_command.balance = true;
-    ble->current_command.standup = false;
+    command_queue_init(&ble->commands, CONFIG_COMMAND_MAX_AGE_MS);
     ble->gatts_if = ESP_GATT_IF_NONE;
     ble->conn_id = 0;
     ble->command_handle = 0;
     ble->status_handle = 0;
+    memset(ble->remote_bda, 0, sizeof(ble->remote_bda));
+    ble->params = NULL;
+    ble->tx_seq = 0;
+    ble_link_init(&ble->link, &link_config, &gap_ops, ble);
     memset(ble->last_command, 0, sizeof(ble->last_command));
+    protocol_stream_init(&ble->rx_stream);
 
 #ifndef NATIVE_BUILD
     esp_err_t ret;
@@ -190,8 +223,8 @@ esp_err_t ble_controller_init(ble_controller_t* ble, const char* device_name) {
         return ret;
     }
 
-    // Set MTU size
-    ret = esp_ble_gatt_set_local_mtu(512);
+    // Largest local MTU we accept; the client starts the exchange (ESP_GATTS_MTU_EVT)
+    ret = esp_ble_gatt_set_local_mtu(CONFIG_BLE_LOCAL_MTU);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Set MTU failed: %s", esp_err_to_name(ret));
         return ret;
@@ -215,15 +248,37 @@ void ble_controller_update(ble_controller_t* ble) {
 }
 
 /**
- * @brief 원격 제어 명령 가져오기 구현
+ * @brief 다음 원격 제어 명령 꺼내기 구현
  * 
- * 현재 저장된 원격 제어 명령을 반환합니다.
+ * @param ble BLE 컨트롤러 구조체 포인터
+ * @param now_us 현재 시각 (us)
+ * @param out 꺼낸 명령
+ * @return bool 꺼낸 명령이 있는지 여부
+ */
+bool ble_controller_next_command(ble_controller_t* ble, int64_t now_us, remote_command_t* out) {
+    command_entry_t entry;
+    if (!command_queue_pop(&ble->commands, now_us, &entry)) {
+        return false;
+    }
+    *out = entry.command;
+    return true;
+}
+
+/**
+ * @brief 명령 큐 통계 조회 구현
  * 
  * @param ble BLE 컨트롤러 구조체 포인터
- * @return remote_command_t 현재 명령
+ * @return command_queue_t* 명령 큐
+ */
+command_queue_t* ble_controller_get_command_queue(ble_controller_t* ble) {
+    return &ble->commands;
+}
+
+/**
+ * @brief 설정 명령 대상 레지스트리 연결 구현
  */
-remote_command_t ble_controller_get_command(const ble_controller_t* ble) {
-    return ble->current_command;
+void ble_controller_set_param_registry(ble_controller_t* ble, param_registry_t* params) {
+    ble->params = params;
 }
 
 /**
@@ -293,75 +348,314 @@ esp_err_t ble_controller_send_status(ble_controller_t* ble, float angle, float v
 }
 
 /**
- * @brief BLE 패킷 처리 구현
+ * @brief 텔레메트리 프레임 전송 구현
  * 
- * 수신된 BLE 데이터 패킷을 디코딩하고 검증한 후,
- * 메시지 타입에 따라 적절한 처리를 수행합니다.
+ * 확인 응답(indication)을 기다리지 않는 알림으로 보내 연결 이벤트마다 여러 패킷이
+ * 나갈 수 있게 합니다. 스택 버퍼가 가득 차 실패한 패킷은 재전송하지 않으며,
+ * 클라이언트는 패킷 시퀀스의 틈으로 유실을 감지합니다.
+ */
+esp_err_t ble_controller_send_telemetry(ble_controller_t* ble, const uint8_t* frame, uint16_t length) {
+    if (!ble->device_connected || length > ble->link.info.mtu - BLE_ATT_NOTIFY_OVERHEAD) {
+        return ESP_FAIL;
+    }
+
+#ifndef NATIVE_BUILD
+    esp_err_t ret = esp_ble_gatts_send_indicate(ble->gatts_if, ble->conn_id, ble->status_handle,
+                                                length, (uint8_t*)frame, false);
+    if (ret != ESP_OK) {
+        ESP_LOGD(TAG, "Telemetry notification dropped: %s", esp_err_to_name(ret));
+        return ret;
+    }
+#endif
+
+    return ESP_OK;
+}
+
+uint16_t ble_controller_get_mtu(const ble_controller_t* ble) {
+    return ble->link.info.mtu;
+}
+
+const ble_link_info_t* ble_controller_get_link_info(const ble_controller_t* ble) {
+    return &ble->link.info;
+}
+
+/**
+ * @brief 연결 파라미터 갱신 요청 (결과: ESP_GAP_BLE_UPDATE_CONN_PARAMS_EVT)
+ */
+static esp_err_t gap_update_conn_params(void* ctx, const ble_conn_params_t* params) {
+#ifndef NATIVE_BUILD
+    ble_controller_t* ble = (ble_controller_t*)ctx;
+    esp_ble_conn_update_params_t conn_params = {0};
+    memcpy(conn_params.bda, ble->remote_bda, sizeof(esp_bd_addr_t));
+    conn_params.min_int = params->min_interval;
+    conn_params.max_int = params->max_interval;
+    conn_params.latency = params->latency;
+    conn_params.timeout = params->timeout;
+    ESP_LOGI(TAG, "Requesting connection interval %.2f-%.2f ms",
+             params->min_interval * 1.25f, params->max_interval * 1.25f);
+    return esp_ble_gap_update_conn_params(&conn_params);
+#else
+    (void)ctx;
+    (void)params;
+    return ESP_OK;
+#endif
+}
+
+/**
+ * @brief LE 데이터 길이 확장 요청 (결과: ESP_GAP_BLE_SET_PKT_LENGTH_COMPLETE_EVT)
+ */
+static esp_err_t gap_set_data_length(void* ctx, uint16_t tx_octets) {
+#ifndef NATIVE_BUILD
+    ble_controller_t* ble = (ble_controller_t*)ctx;
+    return esp_ble_gap_set_pkt_data_len(ble->remote_bda, tx_octets);
+#else
+    (void)ctx;
+    (void)tx_octets;
+    return ESP_OK;
+#endif
+}
+
+/**
+ * @brief 2M PHY 선호 요청 (중앙 장치가 지원하지 않으면 1M 유지)
+ */
+static esp_err_t gap_set_preferred_phy_2m(void* ctx) {
+#ifndef NATIVE_BUILD
+    ble_controller_t* ble = (ble_controller_t*)ctx;
+    return esp_ble_gap_set_preferred_phy(ble->remote_bda, ESP_BLE_GAP_PHY_OPTIONS_NO_PREF,
+                                         ESP_BLE_GAP_PHY_2M_PREF_MASK, ESP_BLE_GAP_PHY_2M_PREF_MASK,
+                                         ESP_BLE_GAP_PHY_OPTIONS_NO_PREF);
+#else
+    (void)ctx;
+    return ESP_OK;
+#endif
+}
+
+/**
+ * @brief 응답 메시지를 상태 특성 알림으로 전송
+ */
+static esp_err_t send_message(ble_controller_t* ble, const protocol_message_t* msg) {
+    if (!ble->device_connected) {
+        return ESP_FAIL;
+    }
+
+    uint8_t buffer[PROTOCOL_FRAME_MAX_SIZE];
+    int encoded_len = encode_message(msg, buffer, sizeof(buffer));
+    if (encoded_len <= 0) {
+        ESP_LOGE(TAG, "Failed to encode response 0x%02X", msg->header.msg_type);
+        return ESP_FAIL;
+    }
+
+#ifndef NATIVE_BUILD
+    esp_err_t ret = esp_ble_gatts_send_indicate(ble->gatts_if, ble->conn_id, ble->status_handle,
+                                                encoded_len, buffer, false);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to send response: %s", esp_err_to_name(ret));
+        return ret;
+    }
+#endif
+    return ESP_OK;
+}
+
+/**
+ * @brief 오류 응답 전송
+ */
+static void send_error(ble_controller_t* ble, uint8_t error_code) {
+    protocol_message_t msg;
+    build_error_message(&msg, error_code, ble->tx_seq++);
+    send_message(ble, &msg);
+}
+
+/**
+ * @brief 설정 값 응답 전송
  * 
- * 지원하는 메시지 타입:
- * - MSG_TYPE_MOVE_CMD: 로봇 이동 명령
- * - MSG_TYPE_CONFIG_SET: 설정 변경 명령
+ * 발행된 파라미터 세트에서 값을 읽어 요청 순서대로 담고, 메시지 하나에
+ * 들어가지 않으면 나누어 보냅니다.
  * 
  * @param ble BLE 컨트롤러 구조체 포인터
- * @param data 수신된 데이터 버퍼
- * @param length 데이터 길이
- * @return esp_err_t 처리 결과
+ * @param ids 조회할 ID 목록 (NULL: 전체)
+ * @param count ID 수 (ids가 NULL이면 무시)
+ * @return esp_err_t 전송 결과
  */
-esp_err_t ble_controller_process_packet(ble_controller_t* ble, const uint8_t* data, size_t length) {
-    protocol_message_t msg;
-    
-    // 메시지 디코딩
-    int result = decode_message(data, (int)length, &msg);
-    if (result <= 0) {
-        ESP_LOGE(TAG, "Failed to decode message: %d", result);
+static esp_err_t send_config_values(ble_controller_t* ble, const uint8_t* ids, size_t count) {
+    if (ids == NULL) {
+        count = param_registry_count();
+    }
+
+    robot_params_t params;
+    param_registry_read(ble->params, &params);
+
+    config_payload_t entries[PROTOCOL_CONFIG_ENTRIES_MAX];
+    uint8_t n = 0;
+    for (size_t i = 0; i < count; i++) {
+        const param_def_t* def = (ids != NULL) ? param_registry_find(ids[i]) : param_registry_def(i);
+        entries[n].config_id = def->id;
+        entries[n].value = param_registry_value(&params, def);
+        n++;
+
+        if (n == PROTOCOL_CONFIG_ENTRIES_MAX || i + 1 == count) {
+            protocol_message_t msg;
+            build_config_response(&msg, entries, n, ble->tx_seq++);
+            esp_err_t ret = send_message(ble, &msg);
+            if (ret != ESP_OK) {
+                return ret;
+            }
+            n = 0;
+        }
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief CONFIG_SET 처리
+ * 
+ * 페이로드의 설정 항목을 모두 검증한 뒤 한꺼번에 레지스트리에 적용합니다.
+ * 제어 태스크는 다음 주기 시작 시 새 세트를 통째로 읽어 적용합니다.
+ * 성공하면 적용된 값을, 실패하면 오류 코드를 돌려줍니다.
+ */
+static esp_err_t handle_config_set(ble_controller_t* ble, const protocol_frame_t* frame) {
+    uint16_t len = protocol_frame_payload_len(frame);
+    if (len == 0 || len % sizeof(config_payload_t) != 0) {
+        ESP_LOGW(TAG, "Config set payload length %u is not a multiple of %u",
+                 (unsigned)len, (unsigned)sizeof(config_payload_t));
+        send_error(ble, PROTOCOL_ERR_CONFIG_LENGTH);
         return ESP_FAIL;
     }
-    
-    // 메시지 유효성 검증
-    if (!validate_message(&msg)) {
-        ESP_LOGE(TAG, "Message validation failed");
+
+    // Entries are packed and unaligned in the receive buffer
+    size_t count = len / sizeof(config_payload_t);
+    const uint8_t* payload = protocol_frame_payload(frame);
+    param_update_t updates[PROTOCOL_CONFIG_ENTRIES_MAX];
+    uint8_t ids[PROTOCOL_CONFIG_ENTRIES_MAX];
+    for (size_t i = 0; i < count; i++) {
+        config_payload_t entry;
+        memcpy(&entry, payload + i * sizeof(config_payload_t), sizeof(entry));
+        updates[i].id = entry.config_id;
+        updates[i].value = entry.value;
+        ids[i] = entry.config_id;
+    }
+
+    param_status_t status = param_registry_set(ble->params, updates, count);
+    if (status != PARAM_OK) {
+        ESP_LOGW(TAG, "Config set rejected (%d), nothing applied", (int)status);
+        send_error(ble, (status == PARAM_ERR_UNKNOWN_ID) ? PROTOCOL_ERR_CONFIG_ID : PROTOCOL_ERR_CONFIG_VALUE);
         return ESP_FAIL;
     }
-    
+
+    for (size_t i = 0; i < count; i++) {
+        ESP_LOGI(TAG, "Config %s = %g", param_registry_find(ids[i])->name, (double)updates[i].value);
+    }
+    return send_config_values(ble, ids, count);
+}
+
+/**
+ * @brief CONFIG_GET 처리 (페이로드가 비어 있으면 전체 조회)
+ */
+static esp_err_t handle_config_get(ble_controller_t* ble, const protocol_frame_t* frame) {
+    uint16_t count = protocol_frame_payload_len(frame);
+    const uint8_t* ids = protocol_frame_payload(frame);
+    for (uint16_t i = 0; i < count; i++) {
+        if (param_registry_find(ids[i]) == NULL) {
+            ESP_LOGW(TAG, "Config get for unknown id 0x%02X", ids[i]);
+            send_error(ble, PROTOCOL_ERR_CONFIG_ID);
+            return ESP_FAIL;
+        }
+    }
+    return send_config_values(ble, (count > 0) ? ids : NULL, count);
+}
+
+/**
+ * @brief 검증된 프레임 처리
+ * 
+ * 프레임 뷰의 타입별 접근자로 수신 버퍼를 직접 읽고, 이동 명령은 명령 큐에 넣습니다.
+ * 
+ * @param ble BLE 컨트롤러 구조체 포인터
+ * @param frame 검증된 프레임
+ * @return esp_err_t 처리 결과
+ */
+static esp_err_t handle_frame(ble_controller_t* ble, const protocol_frame_t* frame) {
     // 메시지 타입별 처리
-    switch (msg.header.msg_type) {
+    switch (protocol_frame_type(frame)) {
         case MSG_TYPE_MOVE_CMD: {
-            move_command_payload_t* cmd = &msg.payload.move_cmd;
+            const move_command_payload_t* cmd = protocol_frame_move_cmd(frame);
+            if (cmd == NULL) {
+                ESP_LOGW(TAG, "Move command payload too short: %u", (unsigned)protocol_frame_payload_len(frame));
+                return ESP_FAIL;
+            }
             
             // 안전 범위 제한 적용
-            ble->current_command.direction = (cmd->direction > 1) ? 1 : 
-                                           ((cmd->direction < -1) ? -1 : cmd->direction);
-            ble->current_command.turn = (cmd->turn > 100) ? 100 : 
-                                      ((cmd->turn < -100) ? -100 : cmd->turn);
-            ble->current_command.speed = (cmd->speed > 100) ? 100 : cmd->speed;
+            remote_command_t command = {
+                .direction = (cmd->direction > 1) ? 1 : ((cmd->direction < -1) ? -1 : cmd->direction),
+                .turn = (cmd->turn > 100) ? 100 : ((cmd->turn < -100) ? -100 : cmd->turn),
+                .speed = (cmd->speed > 100) ? 100 : cmd->speed,
+                // 제어 플래그 추출
+                .balance = (cmd->flags & CMD_FLAG_BALANCE) != 0,
+                .standup = (cmd->flags & CMD_FLAG_STANDUP) != 0,
+            };
             
-            // 제어 플래그 추출
-            ble->current_command.balance = (cmd->flags & CMD_FLAG_BALANCE) != 0;
-            ble->current_command.standup = (cmd->flags & CMD_FLAG_STANDUP) != 0;
+            // The control task picks it up in order; late or reordered commands never reach it
+            if (!command_queue_push(&ble->commands, &command, protocol_frame_seq(frame),
+                                    cmd->timestamp, esp_timer_get_time())) {
+                ESP_LOGW(TAG, "Move command dropped (seq %u, sent %lu ms)",
+                         protocol_frame_seq(frame), (unsigned long)cmd->timestamp);
+                return ESP_FAIL;
+            }
             
             ESP_LOGD(TAG, "Move command: dir=%d, turn=%d, speed=%d, balance=%s, standup=%s", 
-                     ble->current_command.direction, 
-                     ble->current_command.turn, 
-                     ble->current_command.speed,
-                     ble->current_command.balance ? "true" : "false",
-                     ble->current_command.standup ? "true" : "false");
+                     command.direction, 
+                     command.turn, 
+                     command.speed,
+                     command.balance ? "true" : "false",
+                     command.standup ? "true" : "false");
             break;
         }
         
-        case MSG_TYPE_CONFIG_SET: {
-            ESP_LOGI(TAG, "Config set command received");
-            // PID 설정 등 필요 시 처리
-            break;
-        }
+        case MSG_TYPE_CONFIG_SET:
+        case MSG_TYPE_CONFIG_GET:
+            if (ble->params == NULL) {
+                ESP_LOGW(TAG, "Config command 0x%02X before the parameter registry is attached",
+                         protocol_frame_type(frame));
+                return ESP_FAIL;
+            }
+            return (protocol_frame_type(frame) == MSG_TYPE_CONFIG_SET) ? handle_config_set(ble, frame)
+                                                                       : handle_config_get(ble, frame);
         
         default:
-            ESP_LOGW(TAG, "Unknown message type: 0x%02X", msg.header.msg_type);
+            ESP_LOGW(TAG, "Unknown message type: 0x%02X", protocol_frame_type(frame));
             return ESP_FAIL;
     }
     
     return ESP_OK;
 }
 
+/**
+ * @brief 스트림 파서 프레임 콜백
+ */
+static void on_stream_frame(const protocol_frame_t* frame, void* ctx) {
+    handle_frame((ble_controller_t*)ctx, frame);
+}
+
+/**
+ * @brief BLE 패킷 처리 구현
+ * 
+ * 완전한 프레임 하나를 수신 버퍼 위에서 바로 검증하고 처리합니다.
+ * protocol_message_t로의 복사는 없습니다.
+ * 
+ * @param ble BLE 컨트롤러 구조체 포인터
+ * @param data 수신된 데이터
+ * @param length 데이터 길이
+ * @return esp_err_t 처리 결과
+ */
+esp_err_t ble_controller_process_packet(ble_controller_t* ble, const uint8_t* data, size_t length) {
+    protocol_frame_t frame;
+    protocol_frame_status_t status = protocol_frame_view(data, length, &frame);
+    if (status != PROTOCOL_FRAME_OK) {
+        ESP_LOGE(TAG, "Failed to decode message: %d", (int)status);
+        return ESP_FAIL;
+    }
+    
+    return handle_frame(ble, &frame);
+}
+
 /**
  * @brief 레거시 명령 파싱 (호환성용)
  * 
@@ -433,6 +727,34 @@ static void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param
             ESP_LOGI(TAG, "Advertising stopped");
             break;
             
+        case ESP_GAP_BLE_UPDATE_CONN_PARAMS_EVT:
+            ESP_LOGI(TAG, "Connection params: status %d, interval %.2f ms, latency %d, timeout %d ms",
+                     param->update_conn_params.status, param->update_conn_params.conn_int * 1.25f,
+                     param->update_conn_params.latency, param->update_conn_params.timeout * 10);
+            if (ble_instance) {
+                ble_link_on_conn_params(&ble_instance->link,
+                                        param->update_conn_params.status == ESP_BT_STATUS_SUCCESS,
+                                        param->update_conn_params.conn_int,
+                                        param->update_conn_params.latency,
+                                        param->update_conn_params.timeout);
+                if (ble_instance->link.state == BLE_LINK_READY &&
+                    ble_instance->link.info.conn_interval > CONFIG_BLE_CONN_INTERVAL_MAX) {
+                    ESP_LOGW(TAG, "Central kept a slower connection interval (%.2f ms)",
+                             ble_instance->link.info.conn_interval * 1.25f);
+                }
+            }
+            break;
+            
+        case ESP_GAP_BLE_SET_PKT_LENGTH_COMPLETE_EVT:
+            ESP_LOGI(TAG, "Data length: status %d, tx %d, rx %d", param->pkt_data_length_cmpl.status,
+                     param->pkt_data_length_cmpl.params.tx_len, param->pkt_data_length_cmpl.params.rx_len);
+            if (ble_instance) {
+                ble_link_on_data_length(&ble_instance->link,
+                                        param->pkt_data_length_cmpl.status == ESP_BT_STATUS_SUCCESS,
+                                        param->pkt_data_length_cmpl.params.tx_len);
+            }
+            break;
+            
         default:
             ESP_LOGD(TAG, "GAP event: %d", event);
             break;
@@ -517,16 +839,13 @@ static void gatts_event_handler(esp_gatts_cb_event_t event, esp_gatt_if_t gatts_
             if (ble_instance) {
                 ble_instance->device_connected = true;
                 ble_instance->conn_id = param->connect.conn_id;
+                memcpy(ble_instance->remote_bda, param->connect.remote_bda, sizeof(esp_bd_addr_t));
+
+                // Ask for a short interval, DLE and 2M PHY; falls back if the central refuses
+                ble_link_on_connect(&ble_instance->link, param->connect.conn_params.interval,
+                                    param->connect.conn_params.latency,
+                                    param->connect.conn_params.timeout);
             }
-            
-            // Update connection parameters
-            esp_ble_conn_update_params_t conn_params = {0};
-            memcpy(conn_params.bda, param->connect.remote_bda, sizeof(esp_bd_addr_t));
-            conn_params.latency = 0;
-            conn_params.max_int = 0x20;    // max_int = 0x20*1.25ms = 40ms
-            conn_params.min_int = 0x10;    // min_int = 0x10*1.25ms = 20ms
-            conn_params.timeout = 400;     // timeout = 400*10ms = 4000ms
-            esp_ble_gap_update_conn_params(&conn_params);
             break;
             
         case ESP_GATTS_DISCONNECT_EVT:
@@ -534,23 +853,35 @@ static void gatts_event_handler(esp_gatts_cb_event_t event, esp_gatt_if_t gatts_
             if (ble_instance) {
                 ble_instance->device_connected = false;
                 ble_instance->conn_id = 0;
+                ble_link_on_disconnect(&ble_instance->link);
+                command_queue_resync(&ble_instance->commands);
             }
             
             // Restart advertising
             esp_ble_gap_start_advertising(&adv_params);
             break;
             
+        case ESP_GATTS_MTU_EVT:
+            ESP_LOGI(TAG, "MTU negotiated: %d", param->mtu.mtu);
+            if (ble_instance) {
+                ble_link_on_mtu(&ble_instance->link, param->mtu.mtu);
+            }
+            break;
+            
         case ESP_GATTS_WRITE_EVT:
             ESP_LOGI(TAG, "Write event, handle: %d, len: %d", param->write.handle, param->write.len);
             
             if (param->write.handle == command_char_handle && ble_instance) {
-                // Process received command
-                esp_err_t ret = ble_controller_process_packet(ble_instance, 
-                                                            param->write.value, 
-                                                            param->write.len);
-                if (ret != ESP_OK) {
-                    ESP_LOGW(TAG, "Failed to process command packet");
+                // Writes may carry a partial frame (MTU split) or several frames back to back
+                uint32_t checksum_errors = ble_instance->rx_stream.checksum_errors;
+                uint32_t frames = protocol_stream_feed(&ble_instance->rx_stream,
+                                                       param->write.value, param->write.len,
+                                                       on_stream_frame, ble_instance);
+                if (ble_instance->rx_stream.checksum_errors != checksum_errors) {
+                    ESP_LOGW(TAG, "Dropped command frame with bad checksum");
                 }
+                ESP_LOGD(TAG, "Command write: %u frame(s), %u byte(s) pending",
+                         (unsigned)frames, ble_instance->rx_stream.fill);
             }
             
             // Send response if needed
@@ -27,6 +27,10 @@ typedef int esp_err_t;
 #define ESP_FAIL -1
 #endif
 #include <stdbool.h>
+#include "../system/protocol_frame.h"
+#include "../system/command_queue.h"
+#include "../system/param_registry.h"
+#include "ble_link.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -41,19 +45,6 @@ extern "C" {
 #define BLE_COMMAND_CHAR_UUID   0xFF01       ///< 명령 특성 UUID
 #define BLE_STATUS_CHAR_UUID    0xFF02       ///< 상태 특성 UUID
 
-/**
- * @brief 원격 제어 명령 구조체
- * 
- * BLE를 통해 수신되는 모바일 앱의 제어 명령을 담는 구조체입니다.
- */
-typedef struct {
-    int direction;    ///< 방향 (0: 정지, 1: 전진, -1: 후진)
-    int turn;         ///< 회전 (-100~100, 좌측에서 우측)
-    int speed;        ///< 속도 (0~100)
-    bool balance;     ///< 밸런싱 활성화/비활성화
-    bool standup;     ///< 기립 명령
-} remote_command_t;
-
 /**
  * @brief BLE 컨트롤러 상태 구조체
  * 
@@ -61,14 +52,21 @@ typedef struct {
  */
 typedef struct {
     bool device_connected;           ///< 기기 연결 상태
-    remote_command_t current_command; ///< 현재 수신된 명령
+    command_queue_t commands;        ///< 수신 명령 큐 (BLE 콜백 → 제어 태스크)
     char last_command[64];           ///< 마지막 수신 명령 문자열
     uint16_t gatts_if;              ///< GATT 서버 인터페이스
     uint16_t conn_id;               ///< 연결 ID
     uint16_t command_handle;        ///< 명령 특성 핸들
     uint16_t status_handle;         ///< 상태 특성 핸들
+    protocol_stream_t rx_stream;    ///< 명령 특성 수신 스트림 (MTU 분할 프레임 재조립)
+    ble_link_t link;                ///< MTU/연결 간격/데이터 길이 협상 상태
+    uint8_t remote_bda[6];          ///< 연결된 중앙 장치 주소 (GAP 요청용)
+    param_registry_t* params;       ///< CONFIG_SET/GET 대상 파라미터 레지스트리 (NULL: 설정 명령 거부)
+    uint8_t tx_seq;                 ///< 응답 메시지 시퀀스 번호
 } ble_controller_t;
 
+#define BLE_ATT_NOTIFY_OVERHEAD 3            ///< 알림 PDU 헤더 (opcode + 핸들)
+
 /**
  * @brief BLE 컨트롤러 초기화
  * 
@@ -94,14 +92,40 @@ esp_err_t ble_controller_init(ble_controller_t* ble, const char* device_name);
 void ble_controller_update(ble_controller_t* ble);
 
 /**
- * @brief 원격 제어 명령 가져오기
+ * @brief 다음 원격 제어 명령 꺼내기
  * 
- * 현재 수신된 원격 제어 명령을 반환합니다.
+ * 수신 순서대로 명령을 하나 꺼냅니다. CONFIG_COMMAND_MAX_AGE_MS보다 오래된
+ * 명령은 건너뜁니다. 명령 큐의 유일한 소비자(제어 태스크)만 호출해야 합니다.
  * 
  * @param ble BLE 컨트롤러 구조체 포인터
- * @return remote_command_t 현재 명령
+ * @param now_us 현재 시각 (us)
+ * @param out 꺼낸 명령
+ * @return bool 꺼낸 명령이 있는지 여부
  */
-remote_command_t ble_controller_get_command(const ble_controller_t* ble);
+bool ble_controller_next_command(ble_controller_t* ble, int64_t now_us, remote_command_t* out);
+
+/**
+ * @brief 명령 큐 통계 조회
+ * 
+ * 수락/중복/역순/오래됨 카운터와 지연 히스토그램을 담은 큐를 반환합니다.
+ * 카운터는 원자적이므로 어느 태스크에서나 읽을 수 있습니다.
+ * 
+ * @param ble BLE 컨트롤러 구조체 포인터
+ * @return command_queue_t* 명령 큐
+ */
+command_queue_t* ble_controller_get_command_queue(ble_controller_t* ble);
+
+/**
+ * @brief 설정 명령 대상 레지스트리 연결
+ * 
+ * CONFIG_SET은 레지스트리에 묶음으로 적용되고, CONFIG_GET은 발행된 값을
+ * 상태 특성 알림(MSG_TYPE_CONFIG_RESP)으로 돌려줍니다.
+ * ble_controller_init() 이후에 호출해야 합니다.
+ * 
+ * @param ble BLE 컨트롤러 구조체 포인터
+ * @param params 파라미터 레지스트리 (BLE 콜백이 유일한 작성자가 됨)
+ */
+void ble_controller_set_param_registry(ble_controller_t* ble, param_registry_t* params);
 
 /**
  * @brief BLE 연결 상태 확인
@@ -130,10 +154,46 @@ bool ble_controller_is_connected(const ble_controller_t* ble);
  */
 esp_err_t ble_controller_send_status(ble_controller_t* ble, float angle, float velocity, float battery_voltage);
 
+/**
+ * @brief 텔레메트리 프레임 전송
+ * 
+ * 상태 특성으로 확인 응답 없는 알림을 보냅니다. 프레임은 한 번의 알림에
+ * 들어가야 하므로 길이는 ble_controller_get_mtu() - BLE_ATT_NOTIFY_OVERHEAD 이하여야 합니다.
+ * 
+ * @param ble BLE 컨트롤러 구조체 포인터
+ * @param frame 완성된 텔레메트리 프레임
+ * @param length 프레임 길이
+ * @return esp_err_t 전송 결과
+ * @retval ESP_OK 성공
+ * @retval ESP_FAIL 연결 없음 또는 MTU 초과
+ */
+esp_err_t ble_controller_send_telemetry(ble_controller_t* ble, const uint8_t* frame, uint16_t length);
+
+/**
+ * @brief 협상된 ATT MTU 조회
+ * 
+ * @param ble BLE 컨트롤러 구조체 포인터
+ * @return uint16_t ATT MTU (연결 전이나 협상 전에는 BLE_LINK_DEFAULT_MTU)
+ */
+uint16_t ble_controller_get_mtu(const ble_controller_t* ble);
+
+/**
+ * @brief 협상된 링크 파라미터 조회
+ * 
+ * 연결 간격, 슬레이브 지연, 데이터 길이 등 현재 링크에 실제로 적용된 값입니다.
+ * 중앙 장치가 요청을 거부하면 폴백 요청 후 받은 값이 그대로 보고됩니다.
+ * 
+ * @param ble BLE 컨트롤러 구조체 포인터
+ * @return const ble_link_info_t* 링크 값 (연결이 없으면 기본값)
+ */
+const ble_link_info_t* ble_controller_get_link_info(const ble_controller_t* ble);
+
 /**
  * @brief BLE 패킷 처리
  * 
  * 수신된 BLE 데이터 패킷을 파싱하여 명령으로 변환합니다.
+ * 패킷은 완전한 프레임 하나여야 하며, 복사 없이 수신 버퍼 위에서 검증/해석합니다.
+ * 분할되어 들어오는 쓰기는 rx_stream을 통해 처리됩니다.
  * 
  * @param ble BLE 컨트롤러 구조체 포인터
  * @param data 수신된 데이터
@@ -0,0 +1,119 @@
+/**
+ * @file ble_link.c
+ * @brief BLE 링크 파라미터 협상 구현
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "ble_link.h"
+#include <stddef.h>
+
+#define BLE_LINK_MAX_ATTEMPTS   2   ///< 연결 파라미터 요청 횟수 (선호값, 폴백)
+
+/**
+ * @brief 적용 값을 연결 전 기본값으로 초기화
+ */
+static void reset_info(ble_link_info_t* info) {
+    info->mtu = BLE_LINK_DEFAULT_MTU;
+    info->conn_interval = 0;
+    info->latency = 0;
+    info->timeout = 0;
+    info->tx_data_length = BLE_LINK_DEFAULT_DATA_LENGTH;
+}
+
+void ble_link_init(ble_link_t* link, const ble_link_config_t* config, const ble_gap_ops_t* ops, void* ctx) {
+    link->ops = ops;
+    link->ctx = ctx;
+    link->config = *config;
+    link->state = BLE_LINK_DISCONNECTED;
+    link->attempt = 0;
+    link->rejected = 0;
+    reset_info(&link->info);
+}
+
+/**
+ * @brief 마지막으로 보낸 연결 파라미터 요청
+ */
+static const ble_conn_params_t* last_request(const ble_link_t* link) {
+    return (link->attempt <= 1) ? &link->config.preferred : &link->config.fallback;
+}
+
+/**
+ * @brief 다음 연결 파라미터 요청 전송 (남은 요청이 없으면 협상 종료)
+ *
+ * 요청 호출 자체가 실패하면 완료 이벤트가 오지 않으므로 바로 다음 단계로 넘어갑니다.
+ */
+static void request_next(ble_link_t* link) {
+    while (link->attempt < BLE_LINK_MAX_ATTEMPTS) {
+        const ble_conn_params_t* params = (link->attempt == 0) ? &link->config.preferred
+                                                               : &link->config.fallback;
+        link->attempt++;
+        if (link->ops->update_conn_params(link->ctx, params) == ESP_OK) {
+            link->state = BLE_LINK_NEGOTIATING;
+            return;
+        }
+        link->rejected++;
+    }
+    link->state = BLE_LINK_READY;
+}
+
+void ble_link_on_connect(ble_link_t* link, uint16_t interval, uint16_t latency, uint16_t timeout) {
+    reset_info(&link->info);
+    link->info.conn_interval = interval;
+    link->info.latency = latency;
+    link->info.timeout = timeout;
+    link->attempt = 0;
+
+    // DLE and PHY complete independently; failures simply keep the defaults
+    if (link->config.data_length > BLE_LINK_DEFAULT_DATA_LENGTH && link->ops->set_data_length != NULL) {
+        link->ops->set_data_length(link->ctx, link->config.data_length);
+    }
+    if (link->config.prefer_2m_phy && link->ops->set_preferred_phy_2m != NULL) {
+        link->ops->set_preferred_phy_2m(link->ctx);
+    }
+
+    if (interval != 0 && interval <= link->config.preferred.max_interval) {
+        link->state = BLE_LINK_READY;
+        return;
+    }
+    request_next(link);
+}
+
+void ble_link_on_conn_params(ble_link_t* link, bool success, uint16_t interval, uint16_t latency, uint16_t timeout) {
+    if (link->state == BLE_LINK_DISCONNECTED) {
+        return;
+    }
+    if (success) {
+        link->info.conn_interval = interval;
+        link->info.latency = latency;
+        link->info.timeout = timeout;
+    }
+    if (link->state != BLE_LINK_NEGOTIATING) {
+        return;
+    }
+
+    if (success && interval <= last_request(link)->max_interval) {
+        link->state = BLE_LINK_READY;
+        return;
+    }
+    link->rejected++;
+    request_next(link);
+}
+
+void ble_link_on_mtu(ble_link_t* link, uint16_t mtu) {
+    link->info.mtu = mtu;
+}
+
+void ble_link_on_data_length(ble_link_t* link, bool success, uint16_t tx_octets) {
+    if (success) {
+        link->info.tx_data_length = tx_octets;
+    }
+}
+
+void ble_link_on_disconnect(ble_link_t* link) {
+    link->state = BLE_LINK_DISCONNECTED;
+    link->attempt = 0;
+    reset_info(&link->info);
+}
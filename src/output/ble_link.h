@@ -0,0 +1,190 @@
+/**
+ * @file ble_link.h
+ * @brief BLE 링크 파라미터(MTU, 연결 간격, 데이터 길이) 협상 인터페이스
+ *
+ * 연결 직후 짧은 연결 간격과 LE 데이터 길이 확장(DLE), 2M PHY를 요청하고,
+ * 중앙 장치(휴대폰)가 거부하거나 더 긴 간격을 주면 완화된 간격으로 한 번 더
+ * 요청한 뒤 받은 값을 그대로 사용합니다. 원격 명령은 연결 이벤트에서만 전달되므로
+ * 연결 간격이 조이스틱→바퀴 지연의 하한이 됩니다.
+ *
+ * ATT MTU 교환은 클라이언트만 시작할 수 있으므로 서버는 로컬 MTU를 크게 설정해 두고
+ * 클라이언트의 요청(ESP_GATTS_MTU_EVT)으로 협상 결과를 기록합니다.
+ *
+ * GAP 호출은 ble_gap_ops_t로 주입되므로 네이티브 테스트에서 모의 GAP 계층으로
+ * 협상 순서와 폴백을 검증할 수 있습니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef BLE_LINK_H
+#define BLE_LINK_H
+
+#ifndef NATIVE_BUILD
+#include "esp_err.h"
+#else
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#endif
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BLE_LINK_DEFAULT_MTU            23      ///< 협상 전 ATT MTU
+#define BLE_LINK_DEFAULT_DATA_LENGTH    27      ///< DLE 전 LL 송신 옥텟
+#define BLE_LINK_INTERVAL_UNIT_US       1250    ///< 연결 간격 단위 (us)
+
+/**
+ * @struct ble_conn_params_t
+ * @brief 연결 파라미터 요청 (BLE 규격 단위)
+ */
+typedef struct {
+    uint16_t min_interval;  ///< 최소 연결 간격 (1.25ms 단위)
+    uint16_t max_interval;  ///< 최대 연결 간격 (1.25ms 단위)
+    uint16_t latency;       ///< 슬레이브 지연 (연결 이벤트 수)
+    uint16_t timeout;       ///< 감독 타임아웃 (10ms 단위)
+} ble_conn_params_t;
+
+/**
+ * @struct ble_gap_ops_t
+ * @brief 링크 협상이 사용하는 GAP 호출 (타깃: ESP-IDF, 테스트: 모의 계층)
+ *
+ * 모든 호출은 비동기 요청이며 결과는 ble_link_on_*() 이벤트로 돌아옵니다.
+ */
+typedef struct {
+    esp_err_t (*update_conn_params)(void* ctx, const ble_conn_params_t* params); ///< 연결 파라미터 갱신 요청
+    esp_err_t (*set_data_length)(void* ctx, uint16_t tx_octets);                ///< LE 데이터 길이 확장 요청
+    esp_err_t (*set_preferred_phy_2m)(void* ctx);                               ///< 2M PHY 선호 요청 (NULL 가능)
+} ble_gap_ops_t;
+
+/**
+ * @struct ble_link_config_t
+ * @brief 협상 목표
+ */
+typedef struct {
+    ble_conn_params_t preferred;    ///< 첫 요청 (짧은 간격)
+    ble_conn_params_t fallback;     ///< 첫 요청이 거부되거나 간격이 길 때의 두 번째 요청
+    uint16_t data_length;           ///< 요청할 LL 송신 옥텟 (27~251, 27이면 요청 안 함)
+    bool prefer_2m_phy;             ///< 2M PHY 요청 여부
+} ble_link_config_t;
+
+/**
+ * @enum ble_link_state_t
+ * @brief 협상 진행 상태
+ */
+typedef enum {
+    BLE_LINK_DISCONNECTED = 0,      ///< 연결 없음
+    BLE_LINK_NEGOTIATING,           ///< 연결 파라미터 응답 대기 중
+    BLE_LINK_READY                  ///< 협상 종료 (목표 달성 또는 폴백 후 수용)
+} ble_link_state_t;
+
+/**
+ * @struct ble_link_info_t
+ * @brief 현재 링크에 실제로 적용된 값
+ */
+typedef struct {
+    uint16_t mtu;               ///< ATT MTU
+    uint16_t conn_interval;     ///< 연결 간격 (1.25ms 단위, 0: 모름)
+    uint16_t latency;           ///< 슬레이브 지연
+    uint16_t timeout;           ///< 감독 타임아웃 (10ms 단위)
+    uint16_t tx_data_length;    ///< LL 송신 옥텟
+} ble_link_info_t;
+
+/**
+ * @struct ble_link_t
+ * @brief 링크 협상 상태
+ */
+typedef struct {
+    const ble_gap_ops_t* ops;   ///< GAP 호출
+    void* ctx;                  ///< GAP 호출 컨텍스트
+    ble_link_config_t config;   ///< 협상 목표
+    ble_link_state_t state;     ///< 진행 상태
+    uint8_t attempt;            ///< 보낸 연결 파라미터 요청 수 (1: 선호값, 2: 폴백)
+    uint32_t rejected;          ///< 거부되거나 목표보다 긴 간격으로 끝난 요청 수 (누적)
+    ble_link_info_t info;       ///< 적용된 값
+} ble_link_t;
+
+/**
+ * @defgroup BLE_LINK_API BLE 링크 협상 API
+ * @brief GAP/GATT 이벤트를 받아 협상을 진행하는 함수들
+ * @{
+ */
+
+/**
+ * @brief 링크 협상 초기화
+ * @param link 협상 상태
+ * @param config 협상 목표
+ * @param ops GAP 호출
+ * @param ctx GAP 호출 컨텍스트
+ */
+void ble_link_init(ble_link_t* link, const ble_link_config_t* config, const ble_gap_ops_t* ops, void* ctx);
+
+/**
+ * @brief 연결 이벤트 처리: DLE/PHY와 연결 파라미터 요청 시작
+ *
+ * 연결 시점의 간격이 이미 목표 이내면 연결 파라미터는 요청하지 않습니다.
+ *
+ * @param link 협상 상태
+ * @param interval 연결 시점 간격 (1.25ms 단위)
+ * @param latency 연결 시점 슬레이브 지연
+ * @param timeout 연결 시점 감독 타임아웃 (10ms 단위)
+ */
+void ble_link_on_connect(ble_link_t* link, uint16_t interval, uint16_t latency, uint16_t timeout);
+
+/**
+ * @brief 연결 파라미터 갱신 완료 이벤트 처리
+ *
+ * 요청이 실패했거나 적용된 간격이 요청 최대값보다 길면 폴백 요청을 보내고,
+ * 폴백도 안 되면 적용된 값을 수용합니다. 협상이 끝난 뒤 중앙 장치가 바꾼 값은
+ * 기록만 합니다.
+ *
+ * @param link 협상 상태
+ * @param success 갱신 성공 여부
+ * @param interval 적용된 간격 (1.25ms 단위)
+ * @param latency 적용된 슬레이브 지연
+ * @param timeout 적용된 감독 타임아웃 (10ms 단위)
+ */
+void ble_link_on_conn_params(ble_link_t* link, bool success, uint16_t interval, uint16_t latency, uint16_t timeout);
+
+/**
+ * @brief ATT MTU 교환 이벤트 처리
+ * @param link 협상 상태
+ * @param mtu 협상된 MTU
+ */
+void ble_link_on_mtu(ble_link_t* link, uint16_t mtu);
+
+/**
+ * @brief 데이터 길이 설정 완료 이벤트 처리 (실패하면 기본값 유지)
+ * @param link 협상 상태
+ * @param success 성공 여부
+ * @param tx_octets 적용된 LL 송신 옥텟
+ */
+void ble_link_on_data_length(ble_link_t* link, bool success, uint16_t tx_octets);
+
+/**
+ * @brief 연결 해제 처리: 적용 값을 기본값으로 되돌림
+ * @param link 협상 상태
+ */
+void ble_link_on_disconnect(ble_link_t* link);
+
+/**
+ * @brief 연결 간격을 마이크로초로 변환
+ * @param info 링크 값
+ * @return uint32_t 연결 간격 (us, 0: 모름)
+ */
+static inline uint32_t ble_link_interval_us(const ble_link_info_t* info) {
+    return (uint32_t)info->conn_interval * BLE_LINK_INTERVAL_UNIT_US;
+}
+
+/** @} */ // BLE_LINK_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLE_LINK_H
@@ -0,0 +1,213 @@
+/**
+ * @file command_queue.c
+ * @brief 타임스탬프 원격 명령의 단일 생산자/단일 소비자 큐 구현
+ *
+ * 송신 시각과 시계 차이는 uint32 모듈러 값으로 다루고 부호 있는 차이로만
+ * 비교하므로 앱의 epoch ms 하위 32비트가 넘어가도 올바르게 동작합니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "command_queue.h"
+#include <stddef.h>
+
+#define COMMAND_QUEUE_MASK  (COMMAND_QUEUE_CAPACITY - 1u)
+
+_Static_assert((COMMAND_QUEUE_CAPACITY & COMMAND_QUEUE_MASK) == 0, "COMMAND_QUEUE_CAPACITY must be a power of two");
+
+/// 지연 히스토그램 구간 상한 (ms), 마지막 구간은 그 이상 전부
+static const uint32_t latency_limits_ms[COMMAND_LATENCY_BUCKETS - 1] = { 5, 10, 20, 50, 100, 200, 500 };
+
+/**
+ * @brief 모듈러 값의 부호 있는 차이 (a - b)
+ */
+static inline int32_t modular_diff(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b);
+}
+
+void command_queue_init(command_queue_t* queue, uint32_t max_age_ms) {
+    queue->max_age_ms = max_age_ms;
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->accepted, 0);
+    atomic_init(&queue->duplicated, 0);
+    atomic_init(&queue->reordered, 0);
+    atomic_init(&queue->overflowed, 0);
+    atomic_init(&queue->stale, 0);
+    for (int i = 0; i < COMMAND_LATENCY_BUCKETS; i++) {
+        atomic_init(&queue->latency_hist[i], 0);
+    }
+    atomic_init(&queue->latency_max_ms, 0);
+    command_queue_resync(queue);
+}
+
+void command_queue_resync(command_queue_t* queue) {
+    queue->seq_synced = false;
+    queue->last_seq = 0;
+    queue->synced = false;
+    queue->last_sent_ms = 0;
+    queue->offset_min = 0;
+    queue->offset_window_min = 0;
+    queue->window_start_us = 0;
+}
+
+/**
+ * @brief 송신 시계 기준을 현재 차이로 다시 설정
+ */
+static void clock_sync(command_queue_t* queue, uint32_t offset, int64_t now_us) {
+    queue->synced = true;
+    queue->offset_min = offset;
+    queue->offset_window_min = offset;
+    queue->window_start_us = now_us;
+}
+
+/**
+ * @brief 시계 차이 최소값 갱신
+ *
+ * 기준은 직전 구간과 현재 구간의 최소값이므로, 두 시계의 드리프트로 차이가
+ * 커지더라도 최대 두 구간 뒤에는 기준이 따라갑니다.
+ */
+static void clock_track(command_queue_t* queue, uint32_t offset, int64_t now_us) {
+    if (modular_diff(offset, queue->offset_window_min) < 0) {
+        queue->offset_window_min = offset;
+    }
+    if (modular_diff(offset, queue->offset_min) < 0) {
+        queue->offset_min = offset;
+    }
+    if (now_us - queue->window_start_us >= (int64_t)COMMAND_CLOCK_WINDOW_MS * 1000) {
+        queue->offset_min = queue->offset_window_min;
+        queue->offset_window_min = offset;
+        queue->window_start_us = now_us;
+    }
+}
+
+bool command_queue_push(command_queue_t* queue, const remote_command_t* command,
+                        uint8_t seq, uint32_t sent_ms, int64_t now_us) {
+    uint32_t transit_ms = 0;
+
+    if (queue->seq_synced) {
+        int8_t step = (int8_t)(uint8_t)(seq - queue->last_seq);
+        if (step == 0) {
+            atomic_fetch_add_explicit(&queue->duplicated, 1, memory_order_relaxed);
+            return false;
+        }
+        if (step < 0 && step > -COMMAND_SEQ_WINDOW) {
+            atomic_fetch_add_explicit(&queue->reordered, 1, memory_order_relaxed);
+            return false;
+        }
+    }
+
+    if (sent_ms != 0) {
+        uint32_t offset = (uint32_t)(now_us / 1000) - sent_ms;
+        if (!queue->synced) {
+            clock_sync(queue, offset, now_us);
+        } else if (modular_diff(offset, queue->offset_min) >= COMMAND_CLOCK_STEP_MS) {
+            // Sender clock stepped back, or the packet sat in the stack for seconds:
+            // either way this command cannot be trusted, but the next one can
+            clock_sync(queue, offset, now_us);
+            queue->last_sent_ms = sent_ms;
+            atomic_fetch_add_explicit(&queue->stale, 1, memory_order_relaxed);
+            return false;
+        } else if (modular_diff(sent_ms, queue->last_sent_ms) < 0) {
+            atomic_fetch_add_explicit(&queue->reordered, 1, memory_order_relaxed);
+            return false;
+        } else {
+            clock_track(queue, offset, now_us);
+        }
+        transit_ms = offset - queue->offset_min;
+    }
+
+    // A valid command advances the ordering state even if the ring is full,
+    // so a long consumer stall cannot make later numbers look old
+    queue->seq_synced = true;
+    queue->last_seq = seq;
+    if (sent_ms != 0) {
+        queue->last_sent_ms = sent_ms;
+    }
+
+    uint32_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    if (head - tail > COMMAND_QUEUE_MASK) {
+        atomic_fetch_add_explicit(&queue->overflowed, 1, memory_order_relaxed);
+        return false;
+    }
+
+    command_entry_t* slot = &queue->slots[head & COMMAND_QUEUE_MASK];
+    slot->command = *command;
+    slot->sent_ms = sent_ms;
+    slot->received_us = now_us;
+    slot->transit_ms = transit_ms;
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    atomic_fetch_add_explicit(&queue->accepted, 1, memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief 지연 하나를 히스토그램에 기록 (소비자 전용)
+ */
+static void record_latency(command_queue_t* queue, int64_t latency_ms) {
+    uint32_t ms = (latency_ms < 0) ? 0u : (latency_ms > UINT32_MAX) ? UINT32_MAX : (uint32_t)latency_ms;
+    int bucket = 0;
+    while (bucket < COMMAND_LATENCY_BUCKETS - 1 && ms >= latency_limits_ms[bucket]) {
+        bucket++;
+    }
+    atomic_fetch_add_explicit(&queue->latency_hist[bucket], 1, memory_order_relaxed);
+    if (ms > atomic_load_explicit(&queue->latency_max_ms, memory_order_relaxed)) {
+        atomic_store_explicit(&queue->latency_max_ms, ms, memory_order_relaxed);
+    }
+}
+
+bool command_queue_pop(command_queue_t* queue, int64_t now_us, command_entry_t* out) {
+    for (;;) {
+        uint32_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        uint32_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+
+        // Copy out before releasing the slot back to the producer
+        command_entry_t entry = queue->slots[tail & COMMAND_QUEUE_MASK];
+        atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+
+        int64_t queued_ms = (now_us - entry.received_us) / 1000;
+        int64_t latency_ms = queued_ms + (int64_t)entry.transit_ms;
+        record_latency(queue, latency_ms);
+        if (latency_ms > (int64_t)queue->max_age_ms) {
+            atomic_fetch_add_explicit(&queue->stale, 1, memory_order_relaxed);
+            continue;
+        }
+        if (out != NULL) {
+            *out = entry;
+        }
+        return true;
+    }
+}
+
+uint32_t command_latency_bucket_limit_ms(int bucket) {
+    return (bucket < COMMAND_LATENCY_BUCKETS - 1) ? latency_limits_ms[bucket] : UINT32_MAX;
+}
+
+uint32_t command_queue_latency_percentile(command_queue_t* queue, uint32_t percent) {
+    uint32_t counts[COMMAND_LATENCY_BUCKETS];
+    uint64_t total = 0;
+    for (int i = 0; i < COMMAND_LATENCY_BUCKETS; i++) {
+        counts[i] = atomic_load_explicit(&queue->latency_hist[i], memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // Smallest bucket whose cumulative count reaches the requested share
+    uint64_t target = (total * percent + 99) / 100;
+    uint64_t cumulative = 0;
+    for (int i = 0; i < COMMAND_LATENCY_BUCKETS; i++) {
+        cumulative += counts[i];
+        if (cumulative >= target) {
+            return command_latency_bucket_limit_ms(i);
+        }
+    }
+    return UINT32_MAX;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file command_queue.h
+ * @brief 타임스탬프 원격 명령의 단일 생산자/단일 소비자 큐 인터페이스
+ *
+ * BLE 콜백 스레드(생산자)가 수신한 이동 명령을 넣고, 제어 태스크(소비자)가
+ * 주기마다 순서대로 꺼냅니다. 명령은 슬롯 단위로 복사된 뒤 head가 공개되므로
+ * 소비자는 찢어진 구조체를 볼 수 없고, 어느 쪽도 대기하지 않습니다.
+ *
+ * 프레임 헤더의 시퀀스 번호는 중복/역순 명령을 거르는 데 사용됩니다. 앱은 모든
+ * 메시지 종류에 같은 카운터를 쓰므로 건너뛴 번호는 정상이며, 직전 번호에서
+ * COMMAND_SEQ_WINDOW 이내로 되돌아간 번호만 거부합니다.
+ *
+ * 명령의 timestamp(송신측 ms 시계)는 두 가지로 사용됩니다.
+ * - 순서: 직전에 받은 명령보다 오래된 명령은 넣지 않음 (재정렬/지연 도착)
+ * - 지연: 송신 시계와 로컬 시계의 차이 중 최소값을 기준으로 전송 지연을 추정하고,
+ *   전송 지연 + 큐 대기 시간이 최대 허용 나이를 넘으면 꺼낼 때 버림
+ *
+ * 두 시계는 동기화되어 있지 않으므로 기준 차이는 구간 최소값으로 추적하여
+ * 시계 드리프트를 따라가고, COMMAND_CLOCK_STEP_MS 이상의 도약은 송신측 시계
+ * 변경(또는 수 초간 스택에 머문 패킷)으로 보고 그 명령을 버린 뒤 다시 맞춥니다.
+ * timestamp가 0인 명령은 순서/지연 검사 없이 큐 대기 시간만 검사합니다.
+ *
+ * 꺼낸 명령마다 지연(전송 지연 + 큐 대기)을 히스토그램에 기록하므로
+ * 링크 상태를 백분위수로 확인할 수 있습니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef COMMAND_QUEUE_H
+#define COMMAND_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define COMMAND_QUEUE_CAPACITY      16      ///< 큐 슬롯 수 (2의 거듭제곱)
+#define COMMAND_CLOCK_WINDOW_MS     10000   ///< 시계 차이 최소값 추적 구간 (ms)
+#define COMMAND_CLOCK_STEP_MS       1000    ///< 송신 시계 도약으로 판단하는 차이 (ms)
+#define COMMAND_SEQ_WINDOW          64      ///< 중복/역순으로 거부하는 시퀀스 번호 범위
+#define COMMAND_LATENCY_BUCKETS     8       ///< 지연 히스토그램 구간 수 (마지막 구간은 상한 없음)
+
+/**
+ * @brief 원격 제어 명령 구조체
+ *
+ * BLE를 통해 수신되는 모바일 앱의 제어 명령을 담는 구조체입니다.
+ */
+typedef struct {
+    int direction;    ///< 방향 (0: 정지, 1: 전진, -1: 후진)
+    int turn;         ///< 회전 (-100~100, 좌측에서 우측)
+    int speed;        ///< 속도 (0~100)
+    bool balance;     ///< 밸런싱 활성화/비활성화
+    bool standup;     ///< 기립 명령
+} remote_command_t;
+
+/**
+ * @struct command_entry_t
+ * @brief 큐에 저장되는 명령과 시각 정보
+ */
+typedef struct {
+    remote_command_t command;   ///< 명령
+    uint32_t sent_ms;           ///< 송신측 타임스탬프 (ms, 0: 없음)
+    int64_t received_us;        ///< 로컬 수신 시각 (us)
+    uint32_t transit_ms;        ///< 추정 전송 지연 (ms, 송신측 시계 기준)
+} command_entry_t;
+
+/**
+ * @struct command_queue_t
+ * @brief 명령 큐 상태
+ *
+ * 생산자 전용 필드(seq_synced, last_seq, synced, last_sent_ms, offset_*, window_start_us)는 생산자 스레드만 씁니다.
+ * 통계 카운터는 어느 태스크에서나 읽을 수 있도록 원자적입니다.
+ */
+typedef struct {
+    command_entry_t slots[COMMAND_QUEUE_CAPACITY];  ///< 슬롯
+    atomic_uint_least32_t head;                     ///< 다음 기록 위치 (생산자가 증가)
+    atomic_uint_least32_t tail;                     ///< 다음 읽기 위치 (소비자가 증가)
+    uint32_t max_age_ms;                            ///< 최대 허용 나이 (전송 지연 + 큐 대기)
+
+    // Producer-only sequence and clock tracking
+    bool seq_synced;                                ///< 시퀀스 기준 확보 여부
+    uint8_t last_seq;                               ///< 마지막으로 넣은 명령의 시퀀스 번호
+    bool synced;                                    ///< 송신 시계 기준 확보 여부
+    uint32_t last_sent_ms;                          ///< 마지막으로 넣은 명령의 송신 시각
+    uint32_t offset_min;                            ///< 기준 시계 차이 (로컬 - 송신, ms, 모듈러)
+    uint32_t offset_window_min;                     ///< 현재 구간의 최소 시계 차이
+    int64_t window_start_us;                        ///< 현재 구간 시작 시각 (us)
+
+    atomic_uint_least32_t accepted;                 ///< 큐에 넣은 명령 수
+    atomic_uint_least32_t duplicated;               ///< 시퀀스 번호가 중복되어 버린 명령 수
+    atomic_uint_least32_t reordered;                ///< 순서가 뒤바뀌어 버린 명령 수 (시퀀스 또는 송신 시각)
+    atomic_uint_least32_t overflowed;               ///< 큐가 가득 차서 버린 명령 수
+    atomic_uint_least32_t stale;                    ///< 나이 초과로 버린 명령 수
+    atomic_uint_least32_t latency_hist[COMMAND_LATENCY_BUCKETS]; ///< 꺼낸 명령의 지연 분포 (소비자가 기록)
+    atomic_uint_least32_t latency_max_ms;           ///< 관측된 최대 지연 (ms)
+} command_queue_t;
+
+/**
+ * @defgroup COMMAND_QUEUE_API 명령 큐 API
+ * @brief 생산자(BLE 콜백)와 소비자(제어 태스크) 함수들
+ * @{
+ */
+
+/**
+ * @brief 명령 큐 초기화
+ * @param queue 명령 큐
+ * @param max_age_ms 최대 허용 나이 (ms)
+ */
+void command_queue_init(command_queue_t* queue, uint32_t max_age_ms);
+
+/**
+ * @brief 명령 추가 (생산자 전용, 블로킹 없음)
+ *
+ * 중복되거나 역순인 시퀀스 번호, 직전 명령보다 오래된 송신 시각의 명령과
+ * 큐가 가득 찬 경우의 명령은 버립니다.
+ *
+ * @param queue 명령 큐
+ * @param command 수신한 명령
+ * @param seq 프레임 헤더의 시퀀스 번호
+ * @param sent_ms 송신측 타임스탬프 (move_command_payload_t.timestamp, 0: 없음)
+ * @param now_us 로컬 수신 시각 (us)
+ * @return bool 큐에 넣었는지 여부
+ */
+bool command_queue_push(command_queue_t* queue, const remote_command_t* command,
+                        uint8_t seq, uint32_t sent_ms, int64_t now_us);
+
+/**
+ * @brief 다음 유효 명령 꺼내기 (소비자 전용, 블로킹 없음)
+ *
+ * 나이가 최대 허용 나이를 넘은 명령은 건너뛰며 stale로 집계합니다.
+ * 건너뛴 명령을 포함해 꺼낸 모든 명령의 지연이 히스토그램에 기록됩니다.
+ *
+ * @param queue 명령 큐
+ * @param now_us 현재 시각 (us)
+ * @param out 꺼낸 명령 (NULL 가능)
+ * @return bool 꺼낸 명령이 있는지 여부 (false: 비었거나 모두 오래됨)
+ */
+bool command_queue_pop(command_queue_t* queue, int64_t now_us, command_entry_t* out);
+
+/**
+ * @brief 송신 시계 기준 초기화 (생산자 전용, 연결 해제 시)
+ *
+ * 다음 연결의 첫 명령이 시퀀스 번호와 송신 시계의 새 기준이 됩니다. 큐에 남은 명령은 소비자가 나이로 걸러냅니다.
+ *
+ * @param queue 명령 큐
+ */
+void command_queue_resync(command_queue_t* queue);
+
+/**
+ * @brief 지연 히스토그램 구간의 상한
+ * @param bucket 구간 번호 (0 ~ COMMAND_LATENCY_BUCKETS - 1)
+ * @return uint32_t 구간 상한 (ms, 이 값 미만이 해당 구간). 마지막 구간은 UINT32_MAX
+ */
+uint32_t command_latency_bucket_limit_ms(int bucket);
+
+/**
+ * @brief 지연 백분위수 (구간 상한 기준)
+ *
+ * 히스토그램은 어느 태스크에서나 읽을 수 있으며 소비자가 기록하는 중에도
+ * 대략적인 값을 얻습니다.
+ *
+ * @param queue 명령 큐
+ * @param percent 백분위 (1~100)
+ * @return uint32_t 해당 백분위가 속한 구간의 상한 (ms, 기록이 없으면 0)
+ */
+uint32_t command_queue_latency_percentile(command_queue_t* queue, uint32_t percent);
+
+/** @} */ // COMMAND_QUEUE_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMMAND_QUEUE_H
@@ -0,0 +1,61 @@
+/**
+ * @file command_watchdog.c
+ * @brief 원격 명령 워치독 구현
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "command_watchdog.h"
+
+void command_watchdog_init(command_watchdog_t* wd, uint32_t timeout_ms, uint32_t decay_ms) {
+    wd->timeout_us = (int64_t)timeout_ms * 1000;
+    wd->decay_us = (int64_t)decay_ms * 1000;
+    wd->last_fresh_us = 0;
+    wd->fed = false;
+    wd->expired = true;
+    atomic_init(&wd->expirations, 0);
+}
+
+void command_watchdog_feed(command_watchdog_t* wd, int64_t now_us) {
+    wd->last_fresh_us = now_us;
+    wd->fed = true;
+    wd->expired = false;
+}
+
+float command_watchdog_gain(command_watchdog_t* wd, int64_t now_us) {
+    if (!wd->fed) {
+        return 0.0f;
+    }
+
+    int64_t overdue_us = now_us - wd->last_fresh_us - wd->timeout_us;
+    if (overdue_us <= 0) {
+        return 1.0f;
+    }
+    if (!wd->expired) {
+        wd->expired = true;
+        atomic_fetch_add_explicit(&wd->expirations, 1, memory_order_relaxed);
+    }
+    if (overdue_us >= wd->decay_us) {
+        return 0.0f;
+    }
+    return 1.0f - (float)overdue_us / (float)wd->decay_us;
+}
+
+void command_watchdog_apply(command_watchdog_t* wd, int64_t now_us,
+                            const remote_command_t* in, remote_command_t* out) {
+    float gain = command_watchdog_gain(wd, now_us);
+    *out = *in;
+    if (gain >= 1.0f) {
+        return;
+    }
+
+    // Truncate toward zero so the ramp never overshoots the received command
+    out->speed = (int)((float)in->speed * gain);
+    out->turn = (int)((float)in->turn * gain);
+    if (gain <= 0.0f) {
+        out->direction = 0;
+        out->standup = false;
+    }
+}
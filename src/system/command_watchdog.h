@@ -0,0 +1,97 @@
+/**
+ * @file command_watchdog.h
+ * @brief 원격 명령 워치독 인터페이스
+ *
+ * BLE 링크가 멈추면 마지막 이동 명령이 계속 모터를 구동하지 않도록, 마지막으로
+ * 유효한 명령을 받은 뒤 timeout이 지나면 이동 명령(속도, 회전)을 decay 동안
+ * 선형으로 0까지 줄입니다. 갑자기 0으로 떨어뜨리면 속도 루프의 목표가 계단처럼
+ * 바뀌어 로봇이 크게 기울어지므로 감속 구간을 둡니다.
+ *
+ * 밸런싱 플래그는 유지합니다(워치독이 밸런싱을 끄면 로봇이 넘어짐).
+ * 기립 플래그는 만료 시 해제하여 오래된 기립 요청이 다시 실행되지 않게 합니다.
+ *
+ * 앱은 이동 중인 동안 명령을 주기적으로 다시 보내 워치독을 유지합니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef COMMAND_WATCHDOG_H
+#define COMMAND_WATCHDOG_H
+
+#include "command_queue.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct command_watchdog_t
+ * @brief 워치독 상태 (제어 태스크 전용, 만료 횟수만 다른 태스크에서 읽음)
+ */
+typedef struct {
+    int64_t timeout_us;                 ///< 마지막 명령 후 감속 시작까지 시간 (us)
+    int64_t decay_us;                   ///< 감속 구간 길이 (us, 0: 즉시 정지)
+    int64_t last_fresh_us;              ///< 마지막 유효 명령 시각 (us)
+    bool fed;                           ///< 명령을 한 번이라도 받았는지 여부
+    bool expired;                       ///< 현재 timeout을 넘긴 상태인지 여부
+    atomic_uint_least32_t expirations;  ///< 유효 → 만료 전환 횟수
+} command_watchdog_t;
+
+/**
+ * @defgroup COMMAND_WATCHDOG_API 명령 워치독 API
+ * @brief 명령 신선도에 따른 이동 명령 감쇠 함수들
+ * @{
+ */
+
+/**
+ * @brief 워치독 초기화 (명령을 받기 전에는 만료 상태)
+ * @param wd 워치독
+ * @param timeout_ms 감속 시작까지 시간 (ms)
+ * @param decay_ms 감속 구간 길이 (ms)
+ */
+void command_watchdog_init(command_watchdog_t* wd, uint32_t timeout_ms, uint32_t decay_ms);
+
+/**
+ * @brief 유효한 명령 수신 기록
+ * @param wd 워치독
+ * @param now_us 현재 시각 (us)
+ */
+void command_watchdog_feed(command_watchdog_t* wd, int64_t now_us);
+
+/**
+ * @brief 이동 명령 배율 계산
+ *
+ * timeout 이내 1.0, 감속 구간에서 1.0 → 0.0 선형 감소, 그 뒤 0.0입니다.
+ * 유효 → 만료 전환을 여기서 집계합니다.
+ *
+ * @param wd 워치독
+ * @param now_us 현재 시각 (us)
+ * @return float 이동 명령 배율 (0.0 ~ 1.0)
+ */
+float command_watchdog_gain(command_watchdog_t* wd, int64_t now_us);
+
+/**
+ * @brief 받은 명령에 워치독 적용
+ *
+ * 속도와 회전에 배율을 곱하고, 배율이 0이면 방향을 정지로, 기립 플래그를 해제합니다.
+ *
+ * @param wd 워치독
+ * @param now_us 현재 시각 (us)
+ * @param in 마지막으로 받은 명령
+ * @param out 적용할 명령
+ */
+void command_watchdog_apply(command_watchdog_t* wd, int64_t now_us,
+                            const remote_command_t* in, remote_command_t* out);
+
+/** @} */ // COMMAND_WATCHDOG_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMMAND_WATCHDOG_H
@@ -0,0 +1,224 @@
+/**
+ * @file control_scheduler.c
+ * @brief 고정 주기 제어 루프 스케줄러 구현
+ *
+ * 타깃에서는 xTaskDelayUntil로 틱 정렬된 절대 웨이크업을 만들고
+ * esp_timer로 실제 주기를 마이크로초 단위로 측정합니다.
+ * 네이티브 빌드에서는 가상 시계를 사용하여 결정적으로 테스트할 수 있습니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "control_scheduler.h"
+#include <string.h>
+#ifndef NATIVE_BUILD
+#include "freertos/task.h"
+#include "esp_timer.h"
+#endif
+
+#ifdef NATIVE_BUILD
+static int64_t fake_now_us = 0;            ///< 가상 시계 (us)
+static uint32_t fake_wakeup_latency_us = 0; ///< 주입된 웨이크업 지연 (us)
+#endif
+
+/**
+ * @brief 통계 구조체를 측정 전 상태로 초기화
+ * @param stats 통계 구조체 포인터
+ */
+static void reset_stats(control_scheduler_stats_t* stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->min_period_us = UINT32_MAX;
+}
+
+/**
+ * @brief 통계 사본을 다른 태스크에 공개
+ * @param sched 스케줄러 구조체 포인터
+ */
+static void publish_stats(control_scheduler_t* sched) {
+    state_snapshot_publish(&sched->stats_snapshot, &sched->stats);
+}
+
+/**
+ * @brief 요청이 있으면 현재 구간을 닫아 공개하고 새 구간 시작
+ * @param sched 스케줄러 구조체 포인터
+ */
+static void close_window_if_requested(control_scheduler_t* sched) {
+    if (atomic_exchange(&sched->reset_pending, false)) {
+        state_snapshot_publish(&sched->window_snapshot, &sched->stats);
+        reset_stats(&sched->stats);
+    }
+}
+
+/**
+ * @brief 스케줄러 초기화 구현
+ *
+ * 현재 시각을 위상 기준점으로 설정합니다. 첫 주기의 dt는 공칭 주기로 간주합니다.
+ */
+void control_scheduler_init(control_scheduler_t* sched, uint32_t period_us, uint32_t max_dt_us) {
+    sched->period_us = period_us;
+    sched->max_dt_us = (max_dt_us > period_us) ? max_dt_us : period_us;
+    sched->last_cycle_us = -1;
+    sched->dt = period_us / 1000000.0f;
+    reset_stats(&sched->stats);
+    state_snapshot_init(&sched->stats_snapshot, sched->stats_buffer, sizeof(sched->stats));
+    state_snapshot_init(&sched->window_snapshot, sched->window_buffer, sizeof(sched->stats));
+    publish_stats(sched);
+    atomic_store(&sched->reset_pending, false);
+
+#ifndef NATIVE_BUILD
+    sched->period_ticks = (TickType_t)(((uint64_t)period_us * configTICK_RATE_HZ) / 1000000ULL);
+    if (sched->period_ticks == 0) {
+        sched->period_ticks = 1;
+    }
+    sched->last_wake_tick = xTaskGetTickCount();
+#else
+    sched->next_deadline_us = fake_now_us + period_us;
+#endif
+}
+
+/**
+ * @brief 다음 주기 대기 구현
+ *
+ * 상대 지연(vTaskDelay)과 달리 본문 실행 시간이 주기에 더해지지 않습니다.
+ * 마감을 놓친 경우 xTaskDelayUntil은 밀린 주기를 연속 실행하려 하므로
+ * 기준점을 현재 틱으로 옮겨 버스트를 막습니다.
+ * 놓친 마감은 닫기 요청을 처리한 뒤에 세므로 새 구간에 들어갑니다.
+ */
+float control_scheduler_wait_next(control_scheduler_t* sched) {
+    bool overrun = false;
+#ifndef NATIVE_BUILD
+    if (xTaskDelayUntil(&sched->last_wake_tick, sched->period_ticks) == pdFALSE) {
+        sched->last_wake_tick = xTaskGetTickCount();
+        overrun = true;
+    }
+#else
+    if (fake_now_us > sched->next_deadline_us) {
+        sched->next_deadline_us = fake_now_us;
+        overrun = true;
+    } else {
+        fake_now_us = sched->next_deadline_us;
+    }
+    fake_now_us += fake_wakeup_latency_us;
+    sched->next_deadline_us += sched->period_us;
+#endif
+    close_window_if_requested(sched);
+    if (overrun) {
+        sched->stats.overrun_count++;
+    }
+    return control_scheduler_mark_cycle(sched, control_scheduler_now_us());
+}
+
+/**
+ * @brief 주기 기록 및 dt 계산 구현
+ *
+ * 측정 주기를 통계에 반영한 뒤 (0, max_dt] 범위로 제한한 dt를 반환합니다.
+ * 대기 중 집계된 오버런도 여기서 함께 공개됩니다.
+ */
+float control_scheduler_mark_cycle(control_scheduler_t* sched, int64_t now_us) {
+    close_window_if_requested(sched);
+
+    if (sched->last_cycle_us < 0) {
+        sched->last_cycle_us = now_us;
+        sched->dt = sched->period_us / 1000000.0f;
+        publish_stats(sched);
+        return sched->dt;
+    }
+
+    int64_t elapsed = now_us - sched->last_cycle_us;
+    sched->last_cycle_us = now_us;
+
+    if (elapsed <= 0) {
+        // 시계 역행 또는 동일 시각: 직전 dt 유지
+        publish_stats(sched);
+        return sched->dt;
+    }
+
+    uint32_t period = (elapsed > UINT32_MAX) ? UINT32_MAX : (uint32_t)elapsed;
+    uint32_t jitter = (period > sched->period_us) ? (period - sched->period_us)
+                                                  : (sched->period_us - period);
+
+    control_scheduler_stats_t* stats = &sched->stats;
+    stats->cycle_count++;
+    if (period < stats->min_period_us) stats->min_period_us = period;
+    if (period > stats->max_period_us) stats->max_period_us = period;
+    if (jitter > stats->max_jitter_us) stats->max_jitter_us = jitter;
+
+    if (period > sched->max_dt_us) {
+        period = sched->max_dt_us;
+    }
+    sched->dt = period / 1000000.0f;
+    publish_stats(sched);
+    return sched->dt;
+}
+
+/**
+ * @brief 본문 종료 기록 구현
+ *
+ * 아직 주기가 시작되지 않았다면 아무것도 기록하지 않습니다.
+ */
+uint32_t control_scheduler_end_cycle(control_scheduler_t* sched) {
+    if (sched->last_cycle_us < 0) {
+        return 0;
+    }
+
+    int64_t elapsed = control_scheduler_now_us() - sched->last_cycle_us;
+    if (elapsed < 0) {
+        elapsed = 0;
+    }
+    uint32_t busy = (elapsed > UINT32_MAX) ? UINT32_MAX : (uint32_t)elapsed;
+
+    control_scheduler_stats_t* stats = &sched->stats;
+    stats->busy_count++;
+    stats->total_busy_us += busy;
+    if (busy > stats->max_busy_us) stats->max_busy_us = busy;
+    if (busy > sched->period_us) stats->budget_overrun_count++;
+    publish_stats(sched);
+    return busy;
+}
+
+uint32_t control_scheduler_mean_busy_us(const control_scheduler_stats_t* stats) {
+    if (stats->busy_count == 0) {
+        return 0;
+    }
+    return (uint32_t)(stats->total_busy_us / stats->busy_count);
+}
+
+float control_scheduler_get_dt(const control_scheduler_t* sched) {
+    return sched->dt;
+}
+
+void control_scheduler_get_stats(control_scheduler_t* sched, control_scheduler_stats_t* stats) {
+    state_snapshot_read(&sched->stats_snapshot, stats);
+}
+
+uint32_t control_scheduler_get_window(control_scheduler_t* sched, control_scheduler_stats_t* stats) {
+    return state_snapshot_read(&sched->window_snapshot, stats);
+}
+
+void control_scheduler_reset_stats(control_scheduler_t* sched) {
+    atomic_store(&sched->reset_pending, true);
+}
+
+int64_t control_scheduler_now_us(void) {
+#ifndef NATIVE_BUILD
+    return esp_timer_get_time();
+#else
+    return fake_now_us;
+#endif
+}
+
+#ifdef NATIVE_BUILD
+void control_scheduler_fake_clock_set(int64_t now_us) {
+    fake_now_us = now_us;
+}
+
+void control_scheduler_fake_clock_advance(int64_t delta_us) {
+    fake_now_us += delta_us;
+}
+
+void control_scheduler_fake_set_wakeup_latency(uint32_t latency_us) {
+    fake_wakeup_latency_us = latency_us;
+}
+#endif
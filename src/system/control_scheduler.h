@@ -0,0 +1,212 @@
+/**
+ * @file control_scheduler.h
+ * @brief 고정 주기 제어 루프 스케줄러 인터페이스
+ *
+ * 절대 시각 기반(vTaskDelayUntil) 웨이크업으로 제어 파이프라인을
+ * 고정 위상으로 실행하고, 매 주기 실제 경과 시간(dt)을 측정합니다.
+ * 측정된 dt는 칼만 필터와 PID 제어기에 그대로 전달됩니다.
+ *
+ * 주요 기능:
+ * - 루프 본문 실행 시간과 무관한 드리프트 없는 주기 유지
+ * - 마이크로초 단위 dt 측정 및 이상값 제한
+ * - 주기 지터/오버런 통계 수집 (다른 코어의 태스크에 seqlock으로 공개)
+ * - 루프 본문 실행 시간(사이클 예산) 측정
+ * - 네이티브 빌드용 가상 시계 (테스트용)
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef CONTROL_SCHEDULER_H
+#define CONTROL_SCHEDULER_H
+
+#ifndef NATIVE_BUILD
+#include "freertos/FreeRTOS.h"
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "state_snapshot.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct control_scheduler_stats_t
+ * @brief 제어 주기 타이밍 통계
+ *
+ * 실제 측정된 주기와 공칭 주기의 차이(지터)를 추적합니다.
+ */
+typedef struct {
+    uint32_t cycle_count;     ///< 측정된 주기 수
+    uint32_t min_period_us;   ///< 최소 측정 주기 (us)
+    uint32_t max_period_us;   ///< 최대 측정 주기 (us)
+    uint32_t max_jitter_us;   ///< 공칭 주기 대비 최대 편차 (us)
+    uint32_t overrun_count;   ///< 마감 시각을 넘겨 재동기화한 횟수
+    uint32_t busy_count;      ///< 본문 실행 시간이 측정된 주기 수
+    uint32_t max_busy_us;     ///< 최악 본문 실행 시간 (us)
+    uint64_t total_busy_us;   ///< 본문 실행 시간 합계 (us, 평균 계산용)
+    uint32_t budget_overrun_count; ///< 본문 실행 시간이 공칭 주기를 넘은 횟수
+} control_scheduler_stats_t;
+
+/**
+ * @struct control_scheduler_t
+ * @brief 고정 주기 스케줄러 상태 구조체
+ */
+typedef struct {
+    uint32_t period_us;               ///< 공칭 주기 (us)
+    uint32_t max_dt_us;               ///< dt 상한 (us, 스톨 후 필터 발산 방지)
+    int64_t last_cycle_us;            ///< 이전 주기 시작 시각 (us, 음수: 아직 없음)
+    float dt;                         ///< 마지막으로 측정된 dt (초)
+    control_scheduler_stats_t stats;  ///< 타이밍 통계 (제어 태스크 전용)
+    state_snapshot_t stats_snapshot;  ///< 다른 태스크에 공개되는 통계 사본
+    uint8_t stats_buffer[STATE_SNAPSHOT_BUFFER_SIZE(sizeof(control_scheduler_stats_t))]; ///< 사본 저장 공간
+    state_snapshot_t window_snapshot; ///< 마지막으로 닫힌 통계 구간
+    uint8_t window_buffer[STATE_SNAPSHOT_BUFFER_SIZE(sizeof(control_scheduler_stats_t))]; ///< 닫힌 구간 저장 공간
+    atomic_bool reset_pending;        ///< 다른 태스크가 요청한 구간 닫기 (다음 주기 시작에 적용)
+#ifndef NATIVE_BUILD
+    TickType_t last_wake_tick;        ///< 마지막 웨이크업 틱 (vTaskDelayUntil 기준점)
+    TickType_t period_ticks;          ///< 주기 (틱)
+#else
+    int64_t next_deadline_us;         ///< 다음 웨이크업 절대 시각 (가상 시계)
+#endif
+} control_scheduler_t;
+
+/**
+ * @defgroup CONTROL_SCHEDULER_API 제어 스케줄러 API
+ * @brief 고정 주기 제어 루프 함수들
+ * @{
+ */
+
+/**
+ * @brief 스케줄러 초기화
+ *
+ * 현재 시각을 위상 기준점으로 잡고 통계를 초기화합니다.
+ * 제어 태스크 안에서 루프 진입 직전에 호출해야 합니다.
+ *
+ * @param sched 스케줄러 구조체 포인터
+ * @param period_us 공칭 주기 (us, FreeRTOS 틱의 정수배 권장)
+ * @param max_dt_us dt 상한 (us)
+ */
+void control_scheduler_init(control_scheduler_t* sched, uint32_t period_us, uint32_t max_dt_us);
+
+/**
+ * @brief 다음 주기까지 대기 후 실제 dt 반환
+ *
+ * 이전 웨이크업 시각 + 주기의 절대 시각까지 블로킹합니다.
+ * 본문이 주기를 넘겨 마감을 놓치면 누적 버스트 없이 현재 시각으로 재동기화합니다.
+ *
+ * @param sched 스케줄러 구조체 포인터
+ * @return float 측정된 dt (초), 첫 주기는 공칭 주기
+ */
+float control_scheduler_wait_next(control_scheduler_t* sched);
+
+/**
+ * @brief 주기 시작 시각을 기록하고 dt 계산
+ *
+ * control_scheduler_wait_next()가 내부적으로 호출하며,
+ * 외부 이벤트(데이터 레디 등)로 깨어나는 루프에서 직접 사용할 수도 있습니다.
+ *
+ * @param sched 스케줄러 구조체 포인터
+ * @param now_us 주기 시작 시각 (us)
+ * @return float 제한이 적용된 dt (초)
+ */
+float control_scheduler_mark_cycle(control_scheduler_t* sched, int64_t now_us);
+
+/**
+ * @brief 루프 본문 종료 시각을 기록하여 사이클 예산 통계 갱신
+ *
+ * 주기 시작(웨이크업) 이후 본문이 사용한 시간을 측정합니다.
+ * 최악값이 공칭 주기보다 작아야 제어 주기가 유지됩니다.
+ *
+ * @param sched 스케줄러 구조체 포인터
+ * @return uint32_t 이번 주기의 본문 실행 시간 (us)
+ */
+uint32_t control_scheduler_end_cycle(control_scheduler_t* sched);
+
+/**
+ * @brief 평균 본문 실행 시간 계산
+ * @param stats 타이밍 통계
+ * @return uint32_t 평균 본문 실행 시간 (us), 측정값이 없으면 0
+ */
+uint32_t control_scheduler_mean_busy_us(const control_scheduler_stats_t* stats);
+
+/**
+ * @brief 마지막으로 측정된 dt 반환
+ * @param sched 스케줄러 구조체 포인터
+ * @return float dt (초)
+ */
+float control_scheduler_get_dt(const control_scheduler_t* sched);
+
+/**
+ * @brief 타이밍 통계 복사
+ *
+ * 제어 태스크가 주기 시작과 본문 종료 때 발행한 최신 통계를 읽습니다.
+ * 다른 코어의 태스크에서 호출해도 필드가 서로 다른 주기에서 섞이지 않습니다.
+ *
+ * @param sched 스케줄러 구조체 포인터
+ * @param stats 출력 통계 구조체
+ */
+void control_scheduler_get_stats(control_scheduler_t* sched, control_scheduler_stats_t* stats);
+
+/**
+ * @brief 마지막으로 닫힌 통계 구간 복사
+ *
+ * control_scheduler_reset_stats() 요청으로 제어 태스크가 닫은 구간입니다.
+ * 구간은 주기 경계에서 닫히므로 모든 주기가 정확히 한 구간에 들어갑니다.
+ *
+ * @param sched 스케줄러 구조체 포인터
+ * @param stats 출력 통계 구조체
+ * @return uint32_t 지금까지 닫힌 구간 수 (0: 아직 없음, stats는 0으로 채워짐)
+ */
+uint32_t control_scheduler_get_window(control_scheduler_t* sched, control_scheduler_stats_t* stats);
+
+/**
+ * @brief 타이밍 통계 구간 닫기 요청
+ *
+ * 위상 기준점은 유지하고 통계만 다시 수집합니다.
+ * 제어 태스크가 다른 코어에서 통계를 갱신하는 중일 수 있으므로
+ * 요청만 남기고, 다음 주기 시작 시 제어 태스크가 그때까지의 통계를
+ * 닫힌 구간으로 공개한 뒤 초기화합니다. 읽기와 초기화 사이의 주기를 잃지 않도록
+ * 주기적인 보고는 control_scheduler_get_window()로 읽어야 합니다.
+ *
+ * @param sched 스케줄러 구조체 포인터
+ */
+void control_scheduler_reset_stats(control_scheduler_t* sched);
+
+/**
+ * @brief 단조 증가 시각 읽기
+ * @return int64_t 부팅 이후 시각 (us), 네이티브 빌드에서는 가상 시계
+ */
+int64_t control_scheduler_now_us(void);
+
+#ifdef NATIVE_BUILD
+/**
+ * @brief 가상 시계 설정 (네이티브 테스트용)
+ * @param now_us 설정할 시각 (us)
+ */
+void control_scheduler_fake_clock_set(int64_t now_us);
+
+/**
+ * @brief 가상 시계 진행 (네이티브 테스트용, 루프 본문 실행 시간 모사)
+ * @param delta_us 진행할 시간 (us)
+ */
+void control_scheduler_fake_clock_advance(int64_t delta_us);
+
+/**
+ * @brief 웨이크업 지연 주입 (네이티브 테스트용, 스케줄링 지연 모사)
+ * @param latency_us 마감 시각 이후 실제로 깨어나기까지의 지연 (us)
+ */
+void control_scheduler_fake_set_wakeup_latency(uint32_t latency_us);
+#endif
+
+/** @} */ // CONTROL_SCHEDULER_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CONTROL_SCHEDULER_H
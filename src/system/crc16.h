@@ -0,0 +1,79 @@
+/**
+ * @file crc16.h
+ * @brief CRC16 (다항식 0xA001, 반사형) 계산 인터페이스
+ *
+ * 프로토콜 체크섬용 CRC16을 세 가지 방식으로 제공합니다.
+ * - 비트 단위: 바이트당 8회 시프트, 테이블 없음 (기준 구현)
+ * - 테이블: 256항목 테이블로 바이트당 1회 조회 (512바이트 flash)
+ * - 4바이트 슬라이싱: 테이블 4개로 4바이트당 4회 조회 (2KB flash)
+ *
+ * 세 구현은 모든 입력에 대해 같은 값을 반환하며, crc16_update()는
+ * CONFIG_PROTOCOL_CRC_IMPL로 빌드 시 선택된 구현을 사용합니다.
+ * 테이블은 const로 flash(rodata)에 배치되고, 사용하지 않는 테이블은 링커가 제거합니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef CRC16_H
+#define CRC16_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CRC16_INIT              0xFFFF  ///< 프로토콜 CRC 초기값
+
+#define CRC16_IMPL_BITWISE      0       ///< 비트 단위 구현
+#define CRC16_IMPL_TABLE        1       ///< 256항목 테이블 구현
+#define CRC16_IMPL_SLICE4       2       ///< 4바이트 슬라이싱 구현
+
+/**
+ * @brief 비트 단위 CRC16 갱신 (기준 구현)
+ * @param crc 현재 CRC 값 (처음에는 CRC16_INIT)
+ * @param data 데이터
+ * @param length 데이터 길이
+ * @return uint16_t 갱신된 CRC 값
+ */
+uint16_t crc16_update_bitwise(uint16_t crc, const uint8_t* data, size_t length);
+
+/**
+ * @brief 테이블 기반 CRC16 갱신
+ * @param crc 현재 CRC 값
+ * @param data 데이터
+ * @param length 데이터 길이
+ * @return uint16_t 갱신된 CRC 값
+ */
+uint16_t crc16_update_table(uint16_t crc, const uint8_t* data, size_t length);
+
+/**
+ * @brief 4바이트 슬라이싱 CRC16 갱신
+ *
+ * 4바이트 단위로 처리하고 남은 0~3바이트는 테이블 방식으로 처리합니다.
+ * 정렬되지 않은 버퍼도 바이트 단위로 읽으므로 안전합니다.
+ *
+ * @param crc 현재 CRC 값
+ * @param data 데이터
+ * @param length 데이터 길이
+ * @return uint16_t 갱신된 CRC 값
+ */
+uint16_t crc16_update_slice4(uint16_t crc, const uint8_t* data, size_t length);
+
+/**
+ * @brief 빌드 설정(CONFIG_PROTOCOL_CRC_IMPL)으로 선택된 구현으로 CRC16 갱신
+ * @param crc 현재 CRC 값
+ * @param data 데이터
+ * @param length 데이터 길이
+ * @return uint16_t 갱신된 CRC 값
+ */
+uint16_t crc16_update(uint16_t crc, const uint8_t* data, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CRC16_H
@@ -0,0 +1,160 @@
+/**
+ * @file param_registry.c
+ * @brief 실행 중 조정 가능한 파라미터 레지스트리 구현
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "param_registry.h"
+#include "../config.h"
+#include "../logic/attitude_estimator.h"
+#include <string.h>
+#include <math.h>
+
+#define PARAM_FLOAT(id_, field, min_, max_, def_) \
+    { (id_), PARAM_TYPE_FLOAT, #field, (uint16_t)offsetof(robot_params_t, field), (min_), (max_), (def_) }
+#define PARAM_UINT32(id_, field, min_, max_, def_) \
+    { (id_), PARAM_TYPE_UINT32, #field, (uint16_t)offsetof(robot_params_t, field), (min_), (max_), (def_) }
+
+// The fixed-point Kalman holds noise, covariance and gain in Q2.30 (range ±2, 1 LSB ≈ 1e-9)
+#define PARAM_KALMAN_Q_MIN      1e-4f ///< 프로세스 노이즈 하한 (Q·dt가 1ms에서 100 LSB 이상)
+#define PARAM_KALMAN_Q_MAX      0.5f  ///< 프로세스 노이즈 상한 (P 원소가 Q2.30 범위 안에 머묾)
+#define PARAM_KALMAN_R_MIN      1e-3f ///< 측정 노이즈 하한 (바이어스 게인 |K1| < 2)
+#define PARAM_KALMAN_R_MAX      1.0f  ///< 측정 노이즈 상한 (혁신 분산 S = P00 + R < 2)
+
+/// 파라미터 표 (ID, 필드, 허용 범위, 기본값)
+static const param_def_t param_defs[] = {
+    PARAM_FLOAT(PARAM_BALANCE_KP, balance_kp, 0.0f, 500.0f, CONFIG_BALANCE_PID_KP),
+    PARAM_FLOAT(PARAM_BALANCE_KI, balance_ki, 0.0f, 100.0f, CONFIG_BALANCE_PID_KI),
+    PARAM_FLOAT(PARAM_BALANCE_KD, balance_kd, 0.0f, 50.0f, CONFIG_BALANCE_PID_KD),
+    PARAM_FLOAT(PARAM_VELOCITY_KP, velocity_kp, 0.0f, 5.0f, CONFIG_VELOCITY_PID_KP),
+    PARAM_FLOAT(PARAM_VELOCITY_KI, velocity_ki, 0.0f, 5.0f, CONFIG_VELOCITY_PID_KI),
+    PARAM_FLOAT(PARAM_VELOCITY_KD, velocity_kd, 0.0f, 5.0f, CONFIG_VELOCITY_PID_KD),
+    PARAM_FLOAT(PARAM_VELOCITY_TILT_LIMIT, velocity_tilt_limit, 0.0f, 30.0f, CONFIG_VELOCITY_TILT_LIMIT),
+    PARAM_FLOAT(PARAM_MAX_SPEED_CMS, max_speed_cms, 0.0f, 100.0f, CONFIG_BALANCE_MAX_SPEED_CMS),
+    PARAM_UINT32(PARAM_VELOCITY_DIVIDER, velocity_divider, 1.0f, 50.0f, CONFIG_VELOCITY_LOOP_DIVIDER),
+    PARAM_FLOAT(PARAM_KALMAN_Q_ANGLE, kalman_q_angle, PARAM_KALMAN_Q_MIN, PARAM_KALMAN_Q_MAX, CONFIG_KALMAN_Q_ANGLE),
+    PARAM_FLOAT(PARAM_KALMAN_Q_BIAS, kalman_q_bias, PARAM_KALMAN_Q_MIN, PARAM_KALMAN_Q_MAX, CONFIG_KALMAN_Q_BIAS),
+    PARAM_FLOAT(PARAM_KALMAN_R_MEASURE, kalman_r_measure, PARAM_KALMAN_R_MIN, PARAM_KALMAN_R_MAX, CONFIG_KALMAN_R_MEASURE),
+    PARAM_FLOAT(PARAM_MAHONY_KP, mahony_kp, 0.0f, 20.0f, CONFIG_MAHONY_KP),
+    PARAM_FLOAT(PARAM_MAHONY_KI, mahony_ki, 0.0f, 5.0f, CONFIG_MAHONY_KI),
+    PARAM_FLOAT(PARAM_MADGWICK_BETA, madgwick_beta, 0.0f, 2.0f, CONFIG_MADGWICK_BETA),
+    PARAM_FLOAT(PARAM_COMPLEMENTARY_TAU, complementary_tau, 0.01f, 10.0f, CONFIG_COMPLEMENTARY_TAU_S),
+    PARAM_UINT32(PARAM_ATTITUDE_FILTER, attitude_filter, 0.0f, (float)(ATTITUDE_FILTER_COUNT - 1), CONFIG_ATTITUDE_FILTER),
+    PARAM_FLOAT(PARAM_FALLEN_ANGLE, fallen_angle, 10.0f, 80.0f, CONFIG_FALLEN_ANGLE_THRESHOLD),
+    PARAM_FLOAT(PARAM_ANGLE_TARGET, angle_target, -15.0f, 15.0f, CONFIG_BALANCE_ANGLE_TARGET),
+    PARAM_FLOAT(PARAM_GYRO_OFFSET_X, gyro_offset_x, -20.0f, 20.0f, 0.0f),
+    PARAM_FLOAT(PARAM_GYRO_OFFSET_Y, gyro_offset_y, -20.0f, 20.0f, 0.0f),
+    PARAM_FLOAT(PARAM_GYRO_OFFSET_Z, gyro_offset_z, -20.0f, 20.0f, 0.0f),
+    PARAM_FLOAT(PARAM_ACCEL_OFFSET_X, accel_offset_x, -0.25f, 0.25f, 0.0f),
+    PARAM_FLOAT(PARAM_ACCEL_OFFSET_Y, accel_offset_y, -0.25f, 0.25f, 0.0f),
+    PARAM_FLOAT(PARAM_ACCEL_OFFSET_Z, accel_offset_z, -0.25f, 0.25f, 0.0f),
+};
+
+#define PARAM_COUNT (sizeof(param_defs) / sizeof(param_defs[0]))
+
+/**
+ * @brief 값이 파라미터 정의에 맞는지 확인
+ */
+static bool param_value_valid(const param_def_t* def, float value) {
+    // NaN fails both comparisons
+    if (!(value >= def->min && value <= def->max)) {
+        return false;
+    }
+    if (def->type == PARAM_TYPE_UINT32 && value != floorf(value)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 세트의 필드에 값 기록 (검증된 값만)
+ */
+static void param_store_value(robot_params_t* params, const param_def_t* def, float value) {
+    uint8_t* field = (uint8_t*)params + def->offset;
+    if (def->type == PARAM_TYPE_UINT32) {
+        uint32_t v = (uint32_t)value;
+        memcpy(field, &v, sizeof(v));
+    } else {
+        memcpy(field, &value, sizeof(value));
+    }
+}
+
+void param_registry_init(param_registry_t* reg) {
+    memset(&reg->current, 0, sizeof(reg->current));
+    for (size_t i = 0; i < PARAM_COUNT; i++) {
+        param_store_value(&reg->current, &param_defs[i], param_defs[i].default_value);
+    }
+    state_snapshot_init(&reg->snapshot, reg->buffer, sizeof(robot_params_t));
+    state_snapshot_publish(&reg->snapshot, &reg->current);
+}
+
+size_t param_registry_count(void) {
+    return PARAM_COUNT;
+}
+
+const param_def_t* param_registry_def(size_t index) {
+    return (index < PARAM_COUNT) ? &param_defs[index] : NULL;
+}
+
+const param_def_t* param_registry_find(uint8_t id) {
+    for (size_t i = 0; i < PARAM_COUNT; i++) {
+        if (param_defs[i].id == id) {
+            return &param_defs[i];
+        }
+    }
+    return NULL;
+}
+
+float param_registry_value(const robot_params_t* params, const param_def_t* def) {
+    const uint8_t* field = (const uint8_t*)params + def->offset;
+    if (def->type == PARAM_TYPE_UINT32) {
+        uint32_t v;
+        memcpy(&v, field, sizeof(v));
+        return (float)v;
+    }
+    float v;
+    memcpy(&v, field, sizeof(v));
+    return v;
+}
+
+param_status_t param_registry_set(param_registry_t* reg, const param_update_t* updates, size_t count) {
+    if (count == 0) {
+        return PARAM_ERR_EMPTY;
+    }
+
+    // Validate everything before touching the published set
+    robot_params_t next = reg->current;
+    for (size_t i = 0; i < count; i++) {
+        const param_def_t* def = param_registry_find(updates[i].id);
+        if (def == NULL) {
+            return PARAM_ERR_UNKNOWN_ID;
+        }
+        if (!param_value_valid(def, updates[i].value)) {
+            return PARAM_ERR_INVALID_VALUE;
+        }
+        param_store_value(&next, def, updates[i].value);
+    }
+
+    reg->current = next;
+    state_snapshot_publish(&reg->snapshot, &reg->current);
+    return PARAM_OK;
+}
+
+param_status_t param_registry_import(param_registry_t* reg, const robot_params_t* params) {
+    for (size_t i = 0; i < PARAM_COUNT; i++) {
+        if (!param_value_valid(&param_defs[i], param_registry_value(params, &param_defs[i]))) {
+            return PARAM_ERR_INVALID_VALUE;
+        }
+    }
+
+    reg->current = *params;
+    state_snapshot_publish(&reg->snapshot, &reg->current);
+    return PARAM_OK;
+}
+
+uint32_t param_registry_read(param_registry_t* reg, robot_params_t* out) {
+    return state_snapshot_read(&reg->snapshot, out);
+}
@@ -0,0 +1,232 @@
+/**
+ * @file param_registry.h
+ * @brief 실행 중 조정 가능한 파라미터 레지스트리 인터페이스
+ *
+ * PID 게인, 자세 필터 노이즈/게인, 속도 루프 분주비, 상태 임계값, IMU 오프셋을
+ * ID, 타입, 허용 범위와 함께 표로 정의하고 robot_params_t 한 벌로 관리합니다.
+ * 각 항목은 robot_params_t 안의 필드 위치를 가리키므로, 표 하나로
+ * 검증/조회/변경을 모두 처리합니다.
+ *
+ * 변경은 묶음 단위로 적용됩니다. 묶음의 항목 하나라도 잘못되면 아무것도 바뀌지
+ * 않고, 유효하면 새 파라미터 세트 전체를 lock-free 스냅샷으로 발행합니다.
+ * 제어 태스크는 주기 시작 시 새 발행이 있는지 확인하고 한 번에 적용하므로,
+ * 한 제어 주기 안에서 옛 게인과 새 게인이 섞이지 않습니다.
+ *
+ * @note 변경(발행)은 한 태스크에서만 해야 합니다 (부팅 시 초기화 후에는 BLE 콜백).
+ *       조회는 어느 태스크에서나 가능합니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef PARAM_REGISTRY_H
+#define PARAM_REGISTRY_H
+
+#include "state_snapshot.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 파라미터 ID (프로토콜 config_id와 동일)
+ */
+typedef enum {
+    PARAM_BALANCE_KP            = 0x01, ///< 각도 루프 비례 게인
+    PARAM_BALANCE_KI            = 0x02, ///< 각도 루프 적분 게인
+    PARAM_BALANCE_KD            = 0x03, ///< 각도 루프 미분 게인
+    PARAM_VELOCITY_KP           = 0x04, ///< 속도 루프 비례 게인
+    PARAM_VELOCITY_KI           = 0x05, ///< 속도 루프 적분 게인
+    PARAM_VELOCITY_KD           = 0x06, ///< 속도 루프 미분 게인
+    PARAM_VELOCITY_TILT_LIMIT   = 0x07, ///< 속도 루프 최대 목표 기울기 (degree)
+    PARAM_MAX_SPEED_CMS         = 0x08, ///< 원격 속도 100%일 때 목표 속도 (cm/s)
+    PARAM_VELOCITY_DIVIDER      = 0x09, ///< 속도 루프 분주비 (정수)
+    PARAM_KALMAN_Q_ANGLE        = 0x10, ///< 칼만 각도 프로세스 노이즈
+    PARAM_KALMAN_Q_BIAS         = 0x11, ///< 칼만 바이어스 프로세스 노이즈
+    PARAM_KALMAN_R_MEASURE      = 0x12, ///< 칼만 측정 노이즈
+    PARAM_MAHONY_KP             = 0x13, ///< Mahony 비례 게인
+    PARAM_MAHONY_KI             = 0x14, ///< Mahony 적분 게인
+    PARAM_MADGWICK_BETA         = 0x15, ///< Madgwick 보정 게인
+    PARAM_COMPLEMENTARY_TAU     = 0x16, ///< 상보 필터 시정수 (s)
+    PARAM_ATTITUDE_FILTER       = 0x17, ///< 자세 추정 필터 (attitude_filter_type_t, 정수)
+    PARAM_FALLEN_ANGLE          = 0x20, ///< 넘어짐 판정 각도 (degree)
+    PARAM_ANGLE_TARGET          = 0x21, ///< 밸런스 목표 각도 (degree)
+    PARAM_GYRO_OFFSET_X         = 0x30, ///< X축 자이로 오프셋 (deg/s)
+    PARAM_GYRO_OFFSET_Y         = 0x31, ///< Y축 자이로 오프셋 (deg/s)
+    PARAM_GYRO_OFFSET_Z         = 0x32, ///< Z축 자이로 오프셋 (deg/s)
+    PARAM_ACCEL_OFFSET_X        = 0x33, ///< X축 가속도 오프셋 (g)
+    PARAM_ACCEL_OFFSET_Y        = 0x34, ///< Y축 가속도 오프셋 (g)
+    PARAM_ACCEL_OFFSET_Z        = 0x35, ///< Z축 가속도 오프셋 (g)
+} param_id_t;
+
+/**
+ * @brief 파라미터 값 타입 (전송은 모두 float)
+ */
+typedef enum {
+    PARAM_TYPE_FLOAT = 0,   ///< float
+    PARAM_TYPE_UINT32,      ///< 정수 (float로 전송, 소수부가 있으면 거부)
+} param_type_t;
+
+/**
+ * @brief 파라미터 변경 결과
+ */
+typedef enum {
+    PARAM_OK = 0,               ///< 적용됨
+    PARAM_ERR_UNKNOWN_ID,       ///< 정의되지 않은 ID
+    PARAM_ERR_INVALID_VALUE,    ///< 범위 밖, NaN, 정수 파라미터의 소수 값
+    PARAM_ERR_EMPTY,            ///< 변경 항목 없음
+} param_status_t;
+
+#define PARAM_SET_VERSION   3   ///< robot_params_t 스키마 버전 (필드를 추가할 때마다 증가)
+
+/**
+ * @struct robot_params_t
+ * @brief 실행 중 조정 가능한 파라미터 전체 세트
+ *
+ * 세트는 그대로 플래시 블롭으로 저장되므로 새 필드는 맨 뒤에만 추가하고,
+ * 기존 필드의 순서, 타입, 의미는 바꾸지 않습니다.
+ */
+typedef struct {
+    float balance_kp;           ///< 각도 루프 비례 게인
+    float balance_ki;           ///< 각도 루프 적분 게인
+    float balance_kd;           ///< 각도 루프 미분 게인
+    float velocity_kp;          ///< 속도 루프 비례 게인
+    float velocity_ki;          ///< 속도 루프 적분 게인
+    float velocity_kd;          ///< 속도 루프 미분 게인
+    float velocity_tilt_limit;  ///< 속도 루프 최대 목표 기울기 (degree)
+    float max_speed_cms;        ///< 원격 속도 100%일 때 목표 속도 (cm/s)
+    uint32_t velocity_divider;  ///< 속도 루프 분주비
+    float kalman_q_angle;       ///< 칼만 각도 프로세스 노이즈
+    float kalman_q_bias;        ///< 칼만 바이어스 프로세스 노이즈
+    float kalman_r_measure;     ///< 칼만 측정 노이즈
+    float mahony_kp;            ///< Mahony 비례 게인
+    float mahony_ki;            ///< Mahony 적분 게인
+    float madgwick_beta;        ///< Madgwick 보정 게인
+    float complementary_tau;    ///< 상보 필터 시정수 (s)
+    float fallen_angle;         ///< 넘어짐 판정 각도 (degree)
+    float angle_target;         ///< 밸런스 목표 각도 (degree)
+    float gyro_offset_x;        ///< X축 자이로 오프셋 (deg/s, 부팅 보정 결과)
+    float gyro_offset_y;        ///< Y축 자이로 오프셋 (deg/s)
+    float gyro_offset_z;        ///< Z축 자이로 오프셋 (deg/s)
+    float accel_offset_x;       ///< X축 가속도 오프셋 (g, 0이면 미보정)
+    float accel_offset_y;       ///< Y축 가속도 오프셋 (g)
+    float accel_offset_z;       ///< Z축 가속도 오프셋 (g)
+    uint32_t attitude_filter;   ///< 자세 추정 필터 (attitude_filter_type_t)
+} robot_params_t;
+
+/**
+ * @struct param_def_t
+ * @brief 파라미터 정의 (레지스트리 표의 한 항목)
+ */
+typedef struct {
+    uint8_t id;             ///< 파라미터 ID (param_id_t)
+    param_type_t type;      ///< 값 타입
+    const char* name;       ///< 로그용 이름
+    uint16_t offset;        ///< robot_params_t 안의 필드 위치
+    float min;              ///< 허용 최솟값
+    float max;              ///< 허용 최댓값
+    float default_value;    ///< 기본값 (config.h)
+} param_def_t;
+
+/**
+ * @struct param_update_t
+ * @brief 변경 요청 항목 하나
+ */
+typedef struct {
+    uint8_t id;             ///< 파라미터 ID
+    float value;            ///< 새 값
+} param_update_t;
+
+/**
+ * @struct param_registry_t
+ * @brief 파라미터 레지스트리 상태
+ */
+typedef struct {
+    robot_params_t current;     ///< 마지막으로 발행한 세트 (작성자 전용 작업 사본)
+    state_snapshot_t snapshot;  ///< 발행된 세트 (lock-free)
+    uint8_t buffer[STATE_SNAPSHOT_BUFFER_SIZE(sizeof(robot_params_t))]; ///< 스냅샷 슬롯 저장 공간
+} param_registry_t;
+
+/**
+ * @defgroup PARAM_REGISTRY_API 파라미터 레지스트리 API
+ * @brief 파라미터 정의 조회, 묶음 변경, 스냅샷 읽기 함수들
+ * @{
+ */
+
+/**
+ * @brief 레지스트리 초기화 (기본값 세트를 발행)
+ * @param reg 레지스트리
+ */
+void param_registry_init(param_registry_t* reg);
+
+/**
+ * @brief 정의된 파라미터 수
+ * @return size_t 파라미터 수
+ */
+size_t param_registry_count(void);
+
+/**
+ * @brief 순서로 파라미터 정의 조회
+ * @param index 0 ~ param_registry_count() - 1
+ * @return const param_def_t* 정의 (범위 밖이면 NULL)
+ */
+const param_def_t* param_registry_def(size_t index);
+
+/**
+ * @brief ID로 파라미터 정의 조회
+ * @param id 파라미터 ID
+ * @return const param_def_t* 정의 (없으면 NULL)
+ */
+const param_def_t* param_registry_find(uint8_t id);
+
+/**
+ * @brief 세트에서 파라미터 값 읽기 (float로 변환)
+ * @param params 파라미터 세트
+ * @param def 파라미터 정의
+ * @return float 값
+ */
+float param_registry_value(const robot_params_t* params, const param_def_t* def);
+
+/**
+ * @brief 파라미터 묶음 변경 (작성자 전용)
+ *
+ * 모든 항목을 검증한 뒤에만 적용하고 새 세트를 한 번 발행합니다.
+ * 같은 ID가 여러 번 나오면 마지막 값이 적용됩니다.
+ *
+ * @param reg 레지스트리
+ * @param updates 변경 항목
+ * @param count 항목 수
+ * @return param_status_t 결과 (PARAM_OK가 아니면 아무것도 바뀌지 않음)
+ */
+param_status_t param_registry_set(param_registry_t* reg, const param_update_t* updates, size_t count);
+
+/**
+ * @brief 저장된 세트 전체로 교체 (작성자 전용, 부팅 시 복원용)
+ *
+ * 모든 필드가 허용 범위 안에 있을 때만 적용합니다.
+ *
+ * @param reg 레지스트리
+ * @param params 새 세트
+ * @return param_status_t 결과 (PARAM_OK가 아니면 아무것도 바뀌지 않음)
+ */
+param_status_t param_registry_import(param_registry_t* reg, const robot_params_t* params);
+
+/**
+ * @brief 발행된 세트 읽기 (어느 태스크에서나)
+ * @param reg 레지스트리
+ * @param out 출력 세트
+ * @return uint32_t 발행 횟수 (변경 감지용)
+ */
+uint32_t param_registry_read(param_registry_t* reg, robot_params_t* out);
+
+/** @} */ // PARAM_REGISTRY_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PARAM_REGISTRY_H
@@ -0,0 +1,179 @@
+/**
+ * @file param_store.c
+ * @brief 버전/CRC 보호 파라미터 블롭의 A/B 슬롯 플래시 저장소 구현
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "param_store.h"
+#include "crc16.h"
+#include <stdbool.h>
+#include <string.h>
+
+#ifndef NATIVE_BUILD
+#include "esp_partition.h"
+#endif
+
+#define PARAM_STORE_HEADER_SIZE     sizeof(param_store_header_t)
+#define PARAM_STORE_CRC_OFFSET      offsetof(param_store_header_t, crc)
+
+_Static_assert(sizeof(param_store_header_t) == 16, "param_store_header_t must stay 16 bytes");
+
+/**
+ * @brief 헤더(crc 앞부분)와 페이로드의 CRC16
+ */
+static uint16_t blob_crc(const param_store_header_t* header, const void* payload) {
+    uint16_t crc = crc16_update(CRC16_INIT, (const uint8_t*)header, PARAM_STORE_CRC_OFFSET);
+    return crc16_update(crc, (const uint8_t*)payload, header->length);
+}
+
+/**
+ * @brief 슬롯 시작 위치
+ */
+static inline uint32_t slot_offset(const param_store_t* store, int slot) {
+    return (uint32_t)slot * store->slot_size;
+}
+
+void param_store_init(param_store_t* store, const param_flash_ops_t* ops, void* ctx, uint32_t slot_size) {
+    store->ops = ops;
+    store->ctx = ctx;
+    store->slot_size = slot_size;
+    store->active_slot = -1;
+    store->generation = 0;
+}
+
+/**
+ * @brief 슬롯 하나를 읽어 검증 (헤더와 페이로드를 한 번에 읽음)
+ * @return bool 유효한 블롭이면 true
+ */
+static bool read_slot(param_store_t* store, int slot, uint8_t* image, uint16_t capacity,
+                      param_store_header_t* header) {
+    // Payloads never exceed the maximum, so one read always covers the whole blob
+    if (store->ops->read(store->ctx, slot_offset(store, slot), image,
+                         PARAM_STORE_HEADER_SIZE + PARAM_STORE_MAX_PAYLOAD) != ESP_OK) {
+        return false;
+    }
+    memcpy(header, image, sizeof(*header));
+    if (header->magic != PARAM_STORE_MAGIC ||
+        header->length > PARAM_STORE_MAX_PAYLOAD || header->length > capacity) {
+        return false;
+    }
+    return header->crc == blob_crc(header, image + PARAM_STORE_HEADER_SIZE);
+}
+
+esp_err_t param_store_load(param_store_t* store, void* data, uint16_t capacity,
+                           uint16_t* length, uint16_t* version) {
+    uint8_t image[PARAM_STORE_SLOTS][PARAM_STORE_HEADER_SIZE + PARAM_STORE_MAX_PAYLOAD];
+    param_store_header_t headers[PARAM_STORE_SLOTS];
+    int best = -1;
+
+    for (int slot = 0; slot < PARAM_STORE_SLOTS; slot++) {
+        if (!read_slot(store, slot, image[slot], capacity, &headers[slot])) {
+            continue;
+        }
+        // Generations compare modularly so the counter may wrap
+        if (best < 0 || (int32_t)(headers[slot].generation - headers[best].generation) > 0) {
+            best = slot;
+        }
+    }
+
+    store->active_slot = best;
+    if (best < 0) {
+        store->generation = 0;
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    store->generation = headers[best].generation;
+    memcpy(data, image[best] + PARAM_STORE_HEADER_SIZE, headers[best].length);
+    *length = headers[best].length;
+    *version = headers[best].version;
+    return ESP_OK;
+}
+
+esp_err_t param_store_save(param_store_t* store, const void* data, uint16_t length, uint16_t version) {
+    if (length > PARAM_STORE_MAX_PAYLOAD ||
+        store->slot_size < PARAM_STORE_HEADER_SIZE + PARAM_STORE_MAX_PAYLOAD) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint8_t image[PARAM_STORE_HEADER_SIZE + PARAM_STORE_MAX_PAYLOAD];
+    param_store_header_t header = {
+        .magic = PARAM_STORE_MAGIC,
+        .version = version,
+        .length = length,
+        .generation = store->generation + 1,
+        .crc = 0,
+        .reserved = 0xFFFF,
+    };
+    header.crc = blob_crc(&header, data);
+    memcpy(image, &header, sizeof(header));
+    memcpy(image + PARAM_STORE_HEADER_SIZE, data, length);
+    size_t size = PARAM_STORE_HEADER_SIZE + length;
+
+    // Never touch the newest valid slot: it is the fallback until this write is verified
+    int target = (store->active_slot == 0) ? 1 : 0;
+    uint32_t offset = slot_offset(store, target);
+
+    esp_err_t err = store->ops->erase(store->ctx, offset, store->slot_size);
+    if (err == ESP_OK) {
+        err = store->ops->write(store->ctx, offset, image, size);
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    uint8_t verify[PARAM_STORE_HEADER_SIZE + PARAM_STORE_MAX_PAYLOAD];
+    err = store->ops->read(store->ctx, offset, verify, size);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (memcmp(verify, image, size) != 0) {
+        return ESP_FAIL;
+    }
+
+    store->active_slot = target;
+    store->generation = header.generation;
+    return ESP_OK;
+}
+
+#ifndef NATIVE_BUILD
+static esp_err_t partition_read(void* ctx, uint32_t offset, void* data, size_t length) {
+    return esp_partition_read((const esp_partition_t*)ctx, offset, data, length);
+}
+
+static esp_err_t partition_write(void* ctx, uint32_t offset, const void* data, size_t length) {
+    return esp_partition_write((const esp_partition_t*)ctx, offset, data, length);
+}
+
+static esp_err_t partition_erase(void* ctx, uint32_t offset, size_t length) {
+    return esp_partition_erase_range((const esp_partition_t*)ctx, offset, length);
+}
+
+static const param_flash_ops_t partition_ops = {
+    .read = partition_read,
+    .write = partition_write,
+    .erase = partition_erase,
+};
+
+esp_err_t param_store_open_partition(param_store_t* store, const char* label) {
+    const esp_partition_t* part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                           ESP_PARTITION_SUBTYPE_ANY, label);
+    if (part == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    // One erase sector per slot keeps each save to a single sector erase
+    uint32_t slot_size = part->erase_size;
+    while (slot_size < PARAM_STORE_HEADER_SIZE + PARAM_STORE_MAX_PAYLOAD) {
+        slot_size += part->erase_size;
+    }
+    if ((uint32_t)PARAM_STORE_SLOTS * slot_size > part->size) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    param_store_init(store, &partition_ops, (void*)part, slot_size);
+    return ESP_OK;
+}
+#endif
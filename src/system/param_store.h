@@ -0,0 +1,155 @@
+/**
+ * @file param_store.h
+ * @brief 버전/CRC 보호 파라미터 블롭의 A/B 슬롯 플래시 저장소 인터페이스
+ *
+ * 전용 데이터 파티션(partitions.csv의 "params")을 두 슬롯으로 나누어, 저장할
+ * 때마다 최신 슬롯이 아닌 쪽을 지우고 새 블롭을 기록합니다. 기록 도중 전원이
+ * 꺼지면 그 슬롯은 CRC 검사에 실패하고 다른 슬롯의 직전 블롭이 그대로 남으므로,
+ * 어느 순간에 전원이 끊겨도 유효한 파라미터 한 벌이 보장됩니다.
+ *
+ * 슬롯 형식: [헤더 16바이트][페이로드]
+ * - magic: 지워진 섹터(0xFF)나 다른 데이터와 구분
+ * - version: 페이로드 스키마 버전 (호출자 정의)
+ * - length: 페이로드 길이
+ * - generation: 기록할 때마다 1씩 증가, 두 슬롯이 모두 유효하면 큰 쪽이 최신
+ * - crc: 헤더(crc 필드 제외)와 페이로드의 CRC16
+ *
+ * 부팅 시에는 슬롯마다 헤더와 페이로드를 한 번의 읽기로 가져오며, NVS처럼
+ * 키 검색이나 페이지 스캔이 없으므로 제어 태스크 시작 전에 바로 끝납니다.
+ *
+ * 플래시 접근은 param_flash_ops_t로 주입되므로 네이티브 테스트에서 RAM 기반
+ * 모의 플래시로 전원 차단과 손상을 재현할 수 있습니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef PARAM_STORE_H
+#define PARAM_STORE_H
+
+#ifndef NATIVE_BUILD
+#include "esp_err.h"
+#else
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#ifndef ESP_ERR_INVALID_SIZE
+#define ESP_ERR_INVALID_SIZE 0x104
+#endif
+#ifndef ESP_ERR_NOT_FOUND
+#define ESP_ERR_NOT_FOUND 0x105
+#endif
+#endif
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PARAM_STORE_MAGIC           0x53504242u ///< 슬롯 헤더 식별자 ("BBPS")
+#define PARAM_STORE_SLOTS           2           ///< 슬롯 수 (A/B)
+#define PARAM_STORE_MAX_PAYLOAD     240         ///< 최대 페이로드 크기 (바이트)
+
+/**
+ * @struct param_store_header_t
+ * @brief 슬롯 헤더 (16바이트, 리틀 엔디안 그대로 기록)
+ */
+typedef struct {
+    uint32_t magic;         ///< PARAM_STORE_MAGIC
+    uint16_t version;       ///< 페이로드 스키마 버전
+    uint16_t length;        ///< 페이로드 길이 (바이트)
+    uint32_t generation;    ///< 기록 번호 (클수록 최신)
+    uint16_t crc;           ///< 헤더(crc, reserved 제외)와 페이로드의 CRC16
+    uint16_t reserved;      ///< 예약 (0xFFFF)
+} param_store_header_t;
+
+/**
+ * @struct param_flash_ops_t
+ * @brief 저장소가 사용하는 플래시 호출 (타깃: esp_partition, 테스트: RAM 모의 플래시)
+ *
+ * offset은 저장 영역 시작 기준입니다. 쓰기는 지워진(0xFF) 영역에만 합니다.
+ */
+typedef struct {
+    esp_err_t (*read)(void* ctx, uint32_t offset, void* data, size_t length);         ///< 읽기
+    esp_err_t (*write)(void* ctx, uint32_t offset, const void* data, size_t length);  ///< 쓰기
+    esp_err_t (*erase)(void* ctx, uint32_t offset, size_t length);                    ///< 섹터 단위 지우기
+} param_flash_ops_t;
+
+/**
+ * @struct param_store_t
+ * @brief 저장소 상태
+ */
+typedef struct {
+    const param_flash_ops_t* ops;   ///< 플래시 호출
+    void* ctx;                      ///< 플래시 호출 컨텍스트
+    uint32_t slot_size;             ///< 슬롯 크기 (지우기 단위의 배수)
+    int active_slot;                ///< 최신 유효 슬롯 (-1: 없음)
+    uint32_t generation;            ///< 최신 유효 슬롯의 기록 번호
+} param_store_t;
+
+/**
+ * @defgroup PARAM_STORE_API 파라미터 저장소 API
+ * @brief A/B 슬롯 블롭 읽기/쓰기 함수들
+ * @{
+ */
+
+/**
+ * @brief 저장소 초기화 (플래시는 읽지 않음)
+ * @param store 저장소
+ * @param ops 플래시 호출
+ * @param ctx 플래시 호출 컨텍스트
+ * @param slot_size 슬롯 크기 (지우기 단위의 배수, 헤더 + 최대 페이로드 이상)
+ */
+void param_store_init(param_store_t* store, const param_flash_ops_t* ops, void* ctx, uint32_t slot_size);
+
+/**
+ * @brief 최신 유효 블롭 읽기
+ *
+ * 두 슬롯을 검사하여 magic, 길이, CRC가 맞는 슬롯 중 기록 번호가 큰 쪽을
+ * 돌려줍니다. 다음 저장은 다른 슬롯에 기록됩니다.
+ *
+ * @param store 저장소
+ * @param data 페이로드 출력 버퍼
+ * @param capacity 출력 버퍼 크기 (이보다 긴 페이로드는 무효로 봄)
+ * @param length 읽은 페이로드 길이
+ * @param version 읽은 페이로드의 스키마 버전
+ * @return esp_err_t ESP_OK, 유효한 슬롯이 없으면 ESP_ERR_NOT_FOUND
+ */
+esp_err_t param_store_load(param_store_t* store, void* data, uint16_t capacity,
+                           uint16_t* length, uint16_t* version);
+
+/**
+ * @brief 블롭 저장
+ *
+ * 최신 슬롯이 아닌 쪽을 지우고 기록한 뒤 다시 읽어 확인합니다. 확인까지
+ * 끝나야 새 슬롯이 최신이 되며, 실패하면 기존 블롭이 그대로 유지됩니다.
+ *
+ * @note 플래시 기록 중에는 캐시가 꺼져 두 코어가 잠시 멈춥니다.
+ *
+ * @param store 저장소
+ * @param data 페이로드
+ * @param length 페이로드 길이 (최대 PARAM_STORE_MAX_PAYLOAD)
+ * @param version 페이로드 스키마 버전
+ * @return esp_err_t 저장 결과
+ */
+esp_err_t param_store_save(param_store_t* store, const void* data, uint16_t length, uint16_t version);
+
+#ifndef NATIVE_BUILD
+/**
+ * @brief 데이터 파티션을 저장 영역으로 사용하도록 초기화
+ * @param store 저장소
+ * @param label 파티션 이름 (partitions.csv)
+ * @return esp_err_t 파티션이 없거나 두 슬롯이 들어가지 않으면 ESP_ERR_NOT_FOUND
+ */
+esp_err_t param_store_open_partition(param_store_t* store, const char* label);
+#endif
+
+/** @} */ // PARAM_STORE_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PARAM_STORE_H
@@ -11,35 +11,23 @@
  */
 
 #include "protocol.h"
+#include "protocol_frame.h"
+#include "crc16.h"
 #include <string.h>
 
-#define PROTOCOL_START_MARKER 0xAA  ///< 프로토콜 시작 마커
-
 /**
  * @brief CRC16 체크섬 계산 구현
  * 
  * 데이터 무결성 확인을 위한 CRC16 체크섬을 계산합니다.
- * 표준 CRC16-ANSI 알고리즘을 사용합니다.
+ * 표준 CRC16-ANSI 알고리즘(다항식 0xA001, 초기값 0xFFFF)을 사용하며,
+ * 계산 방식(비트 단위/테이블/4바이트 슬라이싱)은 CONFIG_PROTOCOL_CRC_IMPL로 선택합니다.
  * 
  * @param data 체크섬을 계산할 데이터
  * @param length 데이터 길이
  * @return uint16_t CRC16 체크섬
  */
 uint16_t calculate_checksum(const uint8_t* data, uint16_t length) {
-    uint16_t crc = 0xFFFF;  // CRC 초기값
-    
-    for (uint16_t i = 0; i < length; i++) {
-        crc ^= data[i];
-        for (uint8_t j = 0; j < 8; j++) {
-            if (crc & 0x0001) {
-                crc = (crc >> 1) ^ 0xA001;  // CRC16 다항식
-            } else {
-                crc = crc >> 1;
-            }
-        }
-    }
-    
-    return crc;
+    return crc16_update(CRC16_INIT, data, length);
 }
 
 /**
@@ -63,9 +51,9 @@ bool validate_message(const protocol_message_t* msg) {
     // 페이로드 길이 확인
     if (msg->header.payload_len > MAX_PAYLOAD_SIZE) return false;
     
-    // 체크섬 계산 및 검증
-    uint16_t calc_checksum = calculate_checksum((const uint8_t*)&msg->header + 6, 
-                                              sizeof(protocol_header_t) - 6 + msg->header.payload_len);
+    // 체크섬 계산 및 검증 (체크섬 필드를 제외한 헤더 6바이트 + 페이로드)
+    uint16_t calc_checksum = protocol_frame_checksum((const uint8_t*)&msg->header,
+                                                     msg->payload.raw_data, msg->header.payload_len);
     
     return (calc_checksum == msg->header.checksum);
 }
@@ -103,10 +91,10 @@ int encode_message(const protocol_message_t* msg, uint8_t* buffer, int buffer_si
  * 헤더 유효성, 페이로드 길이, 체크섬을 모두 검증합니다.
  * 
  * 디코딩 과정:
- * 1. 헤더 복사 및 기본 유효성 확인
- * 2. 시작 마커와 페이로드 길이 검증
- * 3. 페이로드 복사 (존재하는 경우)
- * 4. 전체 메시지 유효성 및 체크섬 검증
+ * 1. protocol_frame_view()로 버퍼 위에서 헤더/길이/체크섬 검증
+ * 2. 유효한 경우에만 헤더와 페이로드를 구조체로 복사
+ * 
+ * 복사가 필요 없는 수신 경로는 protocol_frame_view()를 직접 사용합니다.
  * 
  * @param buffer 디코딩할 바이너리 데이터
  * @param buffer_len 버퍼 길이
@@ -114,28 +102,13 @@ int encode_message(const protocol_message_t* msg, uint8_t* buffer, int buffer_si
  * @return 디코딩된 바이트 수 (음수: 오류)
  */
 int decode_message(const uint8_t* buffer, int buffer_len, protocol_message_t* msg) {
-    if (buffer == NULL || msg == NULL) return -1;
-    if (buffer_len < sizeof(protocol_header_t)) return -1;
-    
-    // Copy header
-    memcpy(&msg->header, buffer, sizeof(protocol_header_t));
+    if (buffer == NULL || msg == NULL || buffer_len <= 0) return -1;
     
-    // Validate basic header
-    if (msg->header.start_marker != PROTOCOL_START_MARKER) return -1;
-    if (msg->header.payload_len > MAX_PAYLOAD_SIZE) return -1;
-    
-    int total_size = sizeof(protocol_header_t) + msg->header.payload_len;
-    if (buffer_len < total_size) return -1;
+    protocol_frame_t frame;
+    if (protocol_frame_view(buffer, (size_t)buffer_len, &frame) != PROTOCOL_FRAME_OK) return -1;
     
-    // Copy payload if present
-    if (msg->header.payload_len > 0) {
-        memcpy(&msg->payload, buffer + sizeof(protocol_header_t), msg->header.payload_len);
-    }
-    
-    // Validate complete message
-    if (!validate_message(msg)) return -1;
-    
-    return total_size;
+    memcpy(msg, frame.data, frame.length);
+    return frame.length;
 }
 
 /**
@@ -175,8 +148,8 @@ void build_move_command(protocol_message_t* msg, int8_t direction, int8_t turn,
     msg->payload.move_cmd.timestamp = 0; // Would be filled with actual timestamp
     
     // Calculate checksum
-    msg->header.checksum = calculate_checksum((const uint8_t*)&msg->header + 6,
-                                            sizeof(protocol_header_t) - 6 + msg->header.payload_len);
+    msg->header.checksum = protocol_frame_checksum((const uint8_t*)&msg->header,
+                                                   msg->payload.raw_data, msg->header.payload_len);
 }
 
 /**
@@ -219,8 +192,8 @@ void build_status_response(protocol_message_t* msg, float angle, float velocity,
     msg->payload.status_resp.error_flags = 0;
     
     // Calculate checksum
-    msg->header.checksum = calculate_checksum((const uint8_t*)&msg->header + 6,
-                                            sizeof(protocol_header_t) - 6 + msg->header.payload_len);
+    msg->header.checksum = protocol_frame_checksum((const uint8_t*)&msg->header,
+                                                   msg->payload.raw_data, msg->header.payload_len);
 }
 
 /**
@@ -253,6 +226,36 @@ void build_error_message(protocol_message_t* msg, uint8_t error_code, uint8_t se
     msg->payload.raw_data[0] = error_code;
     
     // Calculate checksum
-    msg->header.checksum = calculate_checksum((const uint8_t*)&msg->header + 6,
-                                            sizeof(protocol_header_t) - 6 + msg->header.payload_len);
-}
\ No newline at end of file
+    msg->header.checksum = protocol_frame_checksum((const uint8_t*)&msg->header,
+                                                   msg->payload.raw_data, msg->header.payload_len);
+}
+/**
+ * @brief 설정 값 응답 메시지 생성
+ * 
+ * 설정 항목을 순서대로 페이로드에 이어 붙입니다.
+ * 메시지 하나에 담을 수 없는 항목은 잘리므로 호출자가 나누어 보냅니다.
+ * 
+ * @param msg 출력 메시지 구조체
+ * @param entries 설정 항목 배열
+ * @param count 항목 수
+ * @param seq_num 메시지 시퀀스 번호
+ */
+void build_config_response(protocol_message_t* msg, const config_payload_t* entries,
+                           uint8_t count, uint8_t seq_num) {
+    if (msg == NULL || entries == NULL) return;
+    if (count > PROTOCOL_CONFIG_ENTRIES_MAX) count = PROTOCOL_CONFIG_ENTRIES_MAX;
+    
+    // Build header
+    msg->header.start_marker = PROTOCOL_START_MARKER;
+    msg->header.version = PROTOCOL_VERSION;
+    msg->header.msg_type = MSG_TYPE_CONFIG_RESP;
+    msg->header.seq_num = seq_num;
+    msg->header.payload_len = (uint16_t)(count * sizeof(config_payload_t));
+    
+    // Build payload
+    memcpy(msg->payload.raw_data, entries, msg->header.payload_len);
+    
+    // Calculate checksum
+    msg->header.checksum = protocol_frame_checksum((const uint8_t*)&msg->header,
+                                                   msg->payload.raw_data, msg->header.payload_len);
+}
@@ -22,6 +22,7 @@ extern "C" {
 
 // Protocol version
 #define PROTOCOL_VERSION 0x01    ///< 프로토콜 버전
+#define PROTOCOL_START_MARKER 0xAA  ///< 프로토콜 시작 마커
 
 // Message types
 #define MSG_TYPE_MOVE_CMD       0x01  ///< 이동 명령
@@ -29,6 +30,8 @@ extern "C" {
 #define MSG_TYPE_STATUS_RESP    0x03  ///< 상태 응답
 #define MSG_TYPE_CONFIG_SET     0x04  ///< 설정 변경
 #define MSG_TYPE_CONFIG_GET     0x05  ///< 설정 조회
+#define MSG_TYPE_TELEMETRY      0x06  ///< 텔레메트리 샘플 묶음 (로봇 → 클라이언트)
+#define MSG_TYPE_CONFIG_RESP    0x07  ///< 설정 값 응답 (로봇 → 클라이언트, CONFIG_SET/GET 응답)
 #define MSG_TYPE_ERROR          0xFF  ///< 오류 메시지
 
 // Command flags
@@ -36,8 +39,14 @@ extern "C" {
 #define CMD_FLAG_STANDUP        0x02  ///< 기립 명령
 #define CMD_FLAG_EMERGENCY      0x04  ///< 비상 정지
 
+// Error codes (MSG_TYPE_ERROR payload)
+#define PROTOCOL_ERR_CONFIG_LENGTH  0x10  ///< 설정 페이로드 길이가 항목 크기의 배수가 아님
+#define PROTOCOL_ERR_CONFIG_ID      0x11  ///< 정의되지 않은 설정 ID
+#define PROTOCOL_ERR_CONFIG_VALUE   0x12  ///< 설정 값이 허용 범위 밖
+
 // Maximum payload size
 #define MAX_PAYLOAD_SIZE        64    ///< 최대 페이로드 크기 (바이트)
+#define PROTOCOL_CONFIG_ENTRIES_MAX (MAX_PAYLOAD_SIZE / sizeof(config_payload_t)) ///< 메시지 하나에 담을 수 있는 설정 항목 수
 
 /**
  * @brief 프로토콜 헤더 구조체 (고정 8바이트)
@@ -51,7 +60,7 @@ typedef struct __attribute__((packed)) {
     uint8_t msg_type;          ///< 메시지 타입
     uint8_t seq_num;           ///< 시퀀스 번호
     uint16_t payload_len;      ///< 페이로드 길이
-    uint16_t checksum;         ///< CRC16 체크섬
+    uint16_t checksum;         ///< CRC16 체크섬 (체크섬 필드를 제외한 헤더 + 페이로드)
 } protocol_header_t;
 
 /**
@@ -87,6 +96,9 @@ typedef struct __attribute__((packed)) {
  * @brief 설정 페이로드
  * 
  * 로봇 설정 변경/조회를 위한 구조체입니다.
+ * CONFIG_SET과 CONFIG_RESP 페이로드는 이 항목을 1개 이상 이어 붙인 것이며,
+ * CONFIG_SET 한 메시지의 항목들은 한꺼번에 적용(또는 전부 거부)됩니다.
+ * CONFIG_GET 페이로드는 조회할 config_id 목록(각 1바이트)이며 비어 있으면 전체를 조회합니다.
  */
 typedef struct __attribute__((packed)) {
     uint8_t config_id;        ///< 설정 매개변수 ID
@@ -195,6 +207,19 @@ void build_status_response(protocol_message_t* msg, float angle, float velocity,
  */
 void build_error_message(protocol_message_t* msg, uint8_t error_code, uint8_t seq_num);
 
+/**
+ * @brief 설정 값 응답 메시지 생성
+ * 
+ * CONFIG_SET/CONFIG_GET에 대한 응답으로 설정 항목 목록을 담습니다.
+ * 
+ * @param msg 출력 메시지
+ * @param entries 설정 항목 배열
+ * @param count 항목 수 (최대 PROTOCOL_CONFIG_ENTRIES_MAX, 초과분은 잘림)
+ * @param seq_num 시퀀스 번호
+ */
+void build_config_response(protocol_message_t* msg, const config_payload_t* entries,
+                           uint8_t count, uint8_t seq_num);
+
 #ifdef __cplusplus
 }
 #endif
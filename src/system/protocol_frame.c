@@ -0,0 +1,186 @@
+/**
+ * @file protocol_frame.c
+ * @brief 무복사(zero-copy) 프레임 뷰와 스트리밍 프레임 파서 구현
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "protocol_frame.h"
+#include "crc16.h"
+#include <string.h>
+
+uint16_t protocol_frame_checksum(const uint8_t* header, const uint8_t* payload, uint16_t payload_len) {
+    uint16_t crc = crc16_update(CRC16_INIT, header, PROTOCOL_CHECKSUM_OFFSET);
+    return crc16_update(crc, payload, payload_len);
+}
+
+protocol_frame_status_t protocol_frame_view(const uint8_t* data, size_t length, protocol_frame_t* frame) {
+    if (length < 1) return PROTOCOL_FRAME_INCOMPLETE;
+    if (data[0] != PROTOCOL_START_MARKER) return PROTOCOL_FRAME_BAD_MARKER;
+    if (length < 2) return PROTOCOL_FRAME_INCOMPLETE;
+    if (data[1] != PROTOCOL_VERSION) return PROTOCOL_FRAME_BAD_VERSION;
+    if (length < 6) return PROTOCOL_FRAME_INCOMPLETE;
+
+    // Little-endian on the wire regardless of host order
+    uint16_t payload_len = (uint16_t)(data[4] | (data[5] << 8));
+    if (payload_len > MAX_PAYLOAD_SIZE) return PROTOCOL_FRAME_BAD_LENGTH;
+    uint16_t total = (uint16_t)(PROTOCOL_HEADER_SIZE + payload_len);
+    if (length < total) return PROTOCOL_FRAME_INCOMPLETE;
+
+    uint16_t stored = (uint16_t)(data[PROTOCOL_CHECKSUM_OFFSET] | (data[PROTOCOL_CHECKSUM_OFFSET + 1] << 8));
+    if (protocol_frame_checksum(data, data + PROTOCOL_HEADER_SIZE, payload_len) != stored) {
+        return PROTOCOL_FRAME_BAD_CHECKSUM;
+    }
+
+    frame->data = data;
+    frame->length = total;
+    return PROTOCOL_FRAME_OK;
+}
+
+const move_command_payload_t* protocol_frame_move_cmd(const protocol_frame_t* frame) {
+    if (protocol_frame_type(frame) != MSG_TYPE_MOVE_CMD ||
+        protocol_frame_payload_len(frame) < sizeof(move_command_payload_t)) {
+        return NULL;
+    }
+    return (const move_command_payload_t*)protocol_frame_payload(frame);
+}
+
+const status_response_payload_t* protocol_frame_status_resp(const protocol_frame_t* frame) {
+    if (protocol_frame_type(frame) != MSG_TYPE_STATUS_RESP ||
+        protocol_frame_payload_len(frame) < sizeof(status_response_payload_t)) {
+        return NULL;
+    }
+    return (const status_response_payload_t*)protocol_frame_payload(frame);
+}
+
+const config_payload_t* protocol_frame_config(const protocol_frame_t* frame) {
+    uint8_t type = protocol_frame_type(frame);
+    if ((type != MSG_TYPE_CONFIG_SET && type != MSG_TYPE_CONFIG_GET) ||
+        protocol_frame_payload_len(frame) < sizeof(config_payload_t)) {
+        return NULL;
+    }
+    return (const config_payload_t*)protocol_frame_payload(frame);
+}
+
+void protocol_stream_init(protocol_stream_t* stream) {
+    memset(stream, 0, sizeof(*stream));
+}
+
+/**
+ * @brief 오류 통계 갱신
+ */
+static void count_error(protocol_stream_t* stream, protocol_frame_status_t status) {
+    if (status == PROTOCOL_FRAME_BAD_CHECKSUM) {
+        stream->checksum_errors++;
+    } else if (status != PROTOCOL_FRAME_BAD_MARKER) {
+        stream->header_errors++;
+    }
+}
+
+/**
+ * @brief 조립 버퍼 앞의 n바이트 제거
+ */
+static void buffer_consume(protocol_stream_t* stream, uint16_t n) {
+    stream->fill = (uint16_t)(stream->fill - n);
+    if (stream->fill > 0) {
+        memmove(stream->buf, stream->buf + n, stream->fill);
+    }
+}
+
+/**
+ * @brief 조립 버퍼에서 가능한 프레임을 모두 처리
+ *
+ * 오류가 나면 첫 바이트를 버리고 버퍼 안의 다음 시작 마커로 이동합니다.
+ * 반환 시 버퍼는 비었거나 미완성 프레임 하나만 남습니다.
+ *
+ * @return uint32_t 전달한 프레임 수
+ */
+static uint32_t drain_buffer(protocol_stream_t* stream, protocol_frame_handler_t handler, void* ctx) {
+    uint32_t delivered = 0;
+    while (stream->fill > 0) {
+        protocol_frame_t frame;
+        protocol_frame_status_t status = protocol_frame_view(stream->buf, stream->fill, &frame);
+        if (status == PROTOCOL_FRAME_INCOMPLETE) {
+            break;
+        }
+        if (status == PROTOCOL_FRAME_OK) {
+            stream->frames++;
+            stream->reassembled++;
+            delivered++;
+            handler(&frame, ctx);
+            buffer_consume(stream, frame.length);
+            continue;
+        }
+        count_error(stream, status);
+        const uint8_t* next = (const uint8_t*)memchr(stream->buf + 1, PROTOCOL_START_MARKER, stream->fill - 1u);
+        uint16_t skip = (next != NULL) ? (uint16_t)(next - stream->buf) : stream->fill;
+        stream->discarded_bytes += skip;
+        buffer_consume(stream, skip);
+    }
+    return delivered;
+}
+
+/**
+ * @brief 조립 버퍼의 프레임을 완성하는 데 필요한 바이트 수
+ *
+ * 헤더 전까지는 헤더 크기까지만 받아, 잘못된 길이 필드로 다음 프레임을 삼키지 않게 합니다.
+ */
+static uint16_t bytes_needed(const protocol_stream_t* stream) {
+    if (stream->fill < PROTOCOL_HEADER_SIZE) {
+        return (uint16_t)(PROTOCOL_HEADER_SIZE - stream->fill);
+    }
+    uint16_t payload_len = (uint16_t)(stream->buf[4] | (stream->buf[5] << 8));
+    return (uint16_t)(PROTOCOL_HEADER_SIZE + payload_len - stream->fill);
+}
+
+uint32_t protocol_stream_feed(protocol_stream_t* stream, const uint8_t* data, size_t length,
+                              protocol_frame_handler_t handler, void* ctx) {
+    uint32_t delivered = 0;
+
+    while (length > 0) {
+        if (stream->fill > 0) {
+            // Finish the frame that straddles the previous chunk
+            uint16_t need = bytes_needed(stream);
+            uint16_t n = (length < need) ? (uint16_t)length : need;
+            memcpy(stream->buf + stream->fill, data, n);
+            stream->fill = (uint16_t)(stream->fill + n);
+            data += n;
+            length -= n;
+            delivered += drain_buffer(stream, handler, ctx);
+            continue;
+        }
+
+        // Fast path: frames fully inside this chunk are validated and delivered in place
+        const uint8_t* marker = (const uint8_t*)memchr(data, PROTOCOL_START_MARKER, length);
+        if (marker == NULL) {
+            stream->discarded_bytes += (uint32_t)length;
+            break;
+        }
+        stream->discarded_bytes += (uint32_t)(marker - data);
+        length -= (size_t)(marker - data);
+        data = marker;
+
+        protocol_frame_t frame;
+        protocol_frame_status_t status = protocol_frame_view(data, length, &frame);
+        if (status == PROTOCOL_FRAME_OK) {
+            stream->frames++;
+            delivered++;
+            handler(&frame, ctx);
+            data += frame.length;
+            length -= frame.length;
+        } else if (status == PROTOCOL_FRAME_INCOMPLETE) {
+            // Tail is shorter than one frame, so it always fits
+            memcpy(stream->buf, data, length);
+            stream->fill = (uint16_t)length;
+            break;
+        } else {
+            count_error(stream, status);
+            stream->discarded_bytes++;
+            data++;
+            length--;
+        }
+    }
+    return delivered;
+}
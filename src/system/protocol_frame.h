@@ -0,0 +1,173 @@
+/**
+ * @file protocol_frame.h
+ * @brief 무복사(zero-copy) 프레임 뷰와 스트리밍 프레임 파서 인터페이스
+ *
+ * 수신 바이트를 protocol_message_t로 복사하지 않고 그 자리에서 검증한 뒤,
+ * 헤더/페이로드를 타입별 포인터로 바로 읽을 수 있는 뷰를 제공합니다.
+ * 프로토콜 구조체는 모두 packed(정렬 1)이므로 임의 주소의 버퍼를 가리켜도 안전합니다.
+ *
+ * 스트리밍 파서는 BLE MTU 분할이나 UART처럼 프레임이 여러 조각으로 나뉘어 들어오는
+ * 경우를 처리합니다. 한 조각 안에 온전히 들어 있는 프레임은 입력 버퍼 위에서 바로
+ * 전달하고, 조각 경계에 걸친 프레임만 최대 PROTOCOL_FRAME_MAX_SIZE 바이트를 내부 버퍼에
+ * 모읍니다. 잘못된 바이트는 다음 시작 마커(0xAA)까지 버리고 재동기화합니다.
+ *
+ * 체크섬은 체크섬 필드를 제외한 헤더 6바이트와 페이로드의 CRC16입니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef PROTOCOL_FRAME_H
+#define PROTOCOL_FRAME_H
+
+#include "protocol.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PROTOCOL_HEADER_SIZE        ((uint16_t)sizeof(protocol_header_t))       ///< 헤더 크기 (8바이트)
+#define PROTOCOL_CHECKSUM_OFFSET    6                                           ///< 헤더 내 체크섬 위치
+#define PROTOCOL_FRAME_MAX_SIZE     (PROTOCOL_HEADER_SIZE + MAX_PAYLOAD_SIZE)   ///< 최대 프레임 크기
+
+/**
+ * @enum protocol_frame_status_t
+ * @brief 프레임 검증 결과
+ */
+typedef enum {
+    PROTOCOL_FRAME_OK = 0,          ///< 유효한 프레임
+    PROTOCOL_FRAME_INCOMPLETE,      ///< 지금까지는 유효하나 바이트가 부족함
+    PROTOCOL_FRAME_BAD_MARKER,      ///< 시작 마커 불일치
+    PROTOCOL_FRAME_BAD_VERSION,     ///< 프로토콜 버전 불일치
+    PROTOCOL_FRAME_BAD_LENGTH,      ///< 페이로드 길이가 MAX_PAYLOAD_SIZE 초과
+    PROTOCOL_FRAME_BAD_CHECKSUM     ///< 체크섬 불일치
+} protocol_frame_status_t;
+
+/**
+ * @struct protocol_frame_t
+ * @brief 검증된 프레임에 대한 읽기 전용 뷰 (데이터를 소유하지 않음)
+ */
+typedef struct {
+    const uint8_t* data;    ///< 프레임 시작 (시작 마커)
+    uint16_t length;        ///< 헤더 + 페이로드 길이
+} protocol_frame_t;
+
+/**
+ * @brief 프레임 수신 콜백
+ *
+ * 뷰는 콜백이 반환될 때까지만 유효합니다. 보관하려면 필요한 필드만 복사해야 합니다.
+ *
+ * @param frame 검증된 프레임
+ * @param ctx 사용자 컨텍스트
+ */
+typedef void (*protocol_frame_handler_t)(const protocol_frame_t* frame, void* ctx);
+
+/**
+ * @struct protocol_stream_t
+ * @brief 스트리밍 파서 상태
+ */
+typedef struct {
+    uint8_t buf[PROTOCOL_FRAME_MAX_SIZE];   ///< 조각 경계에 걸친 프레임 조립 버퍼
+    uint16_t fill;                          ///< 조립 버퍼에 쌓인 바이트 수
+    uint32_t frames;                        ///< 전달한 프레임 수
+    uint32_t reassembled;                   ///< 그중 조립 버퍼를 거친 프레임 수
+    uint32_t discarded_bytes;               ///< 재동기화로 버린 바이트 수
+    uint32_t header_errors;                 ///< 버전/길이 오류 수
+    uint32_t checksum_errors;               ///< 체크섬 오류 수
+} protocol_stream_t;
+
+/**
+ * @brief 프레임 체크섬 계산 (헤더 첫 6바이트 + 페이로드, 복사 없음)
+ * @param header 헤더 시작 (8바이트 중 앞 6바이트 사용)
+ * @param payload 페이로드 시작
+ * @param payload_len 페이로드 길이
+ * @return uint16_t CRC16 체크섬
+ */
+uint16_t protocol_frame_checksum(const uint8_t* header, const uint8_t* payload, uint16_t payload_len);
+
+/**
+ * @brief 버퍼 앞에서 프레임 하나를 그 자리에서 검증
+ *
+ * 버퍼가 프레임보다 길면 나머지는 무시합니다 (frame->length만큼이 프레임).
+ * 헤더 오류는 해당 필드가 도착하는 즉시 보고하므로, 스트림에서 잘못된 길이 때문에
+ * 최대 프레임 크기만큼 기다리는 일이 없습니다.
+ *
+ * @param data 입력 버퍼 (시작 마커 위치)
+ * @param length 입력 버퍼 길이
+ * @param frame 유효할 때 채워지는 뷰
+ * @return protocol_frame_status_t 검증 결과
+ */
+protocol_frame_status_t protocol_frame_view(const uint8_t* data, size_t length, protocol_frame_t* frame);
+
+/**
+ * @brief 메시지 타입
+ */
+static inline uint8_t protocol_frame_type(const protocol_frame_t* frame) {
+    return frame->data[2];
+}
+
+/**
+ * @brief 시퀀스 번호
+ */
+static inline uint8_t protocol_frame_seq(const protocol_frame_t* frame) {
+    return frame->data[3];
+}
+
+/**
+ * @brief 페이로드 길이
+ */
+static inline uint16_t protocol_frame_payload_len(const protocol_frame_t* frame) {
+    return (uint16_t)(frame->length - PROTOCOL_HEADER_SIZE);
+}
+
+/**
+ * @brief 페이로드 시작 포인터
+ */
+static inline const uint8_t* protocol_frame_payload(const protocol_frame_t* frame) {
+    return frame->data + PROTOCOL_HEADER_SIZE;
+}
+
+/**
+ * @brief 이동 명령 페이로드 (타입이 다르거나 짧으면 NULL)
+ */
+const move_command_payload_t* protocol_frame_move_cmd(const protocol_frame_t* frame);
+
+/**
+ * @brief 상태 응답 페이로드 (타입이 다르거나 짧으면 NULL)
+ */
+const status_response_payload_t* protocol_frame_status_resp(const protocol_frame_t* frame);
+
+/**
+ * @brief 설정 페이로드 (CONFIG_SET/CONFIG_GET이 아니거나 짧으면 NULL)
+ */
+const config_payload_t* protocol_frame_config(const protocol_frame_t* frame);
+
+/**
+ * @brief 스트리밍 파서 초기화
+ * @param stream 파서 상태
+ */
+void protocol_stream_init(protocol_stream_t* stream);
+
+/**
+ * @brief 수신 조각 하나를 파서에 입력
+ *
+ * 조각 안에서 완성되는 프레임마다 handler를 호출합니다. 조각 크기는 제한이 없으며,
+ * 프레임이 다음 조각으로 이어지면 다음 호출에서 완성됩니다.
+ *
+ * @param stream 파서 상태
+ * @param data 수신 데이터
+ * @param length 수신 데이터 길이
+ * @param handler 프레임 콜백
+ * @param ctx 콜백 컨텍스트
+ * @return uint32_t 이번 호출에서 전달한 프레임 수
+ */
+uint32_t protocol_stream_feed(protocol_stream_t* stream, const uint8_t* data, size_t length,
+                              protocol_frame_handler_t handler, void* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROTOCOL_FRAME_H
@@ -0,0 +1,77 @@
+/**
+ * @file robot_state_machine.c
+ * @brief 로봇 상태 머신 구현 파일
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "robot_state_machine.h"
+#include <math.h>
+
+robot_state_t robot_state_machine_next(robot_state_t current, const robot_state_inputs_t* in) {
+    robot_state_t next = current;
+    bool fallen = fabsf(in->angle) > in->fallen_angle;
+
+    switch (current) {
+    case ROBOT_STATE_IDLE:
+        if (in->balance_cmd && !in->standup_active) {
+            next = ROBOT_STATE_BALANCING;
+        } else if (in->standup_cmd) {
+            next = ROBOT_STATE_STANDING_UP;
+        }
+        // Check if fallen (angle too large)
+        if (fallen) {
+            next = ROBOT_STATE_FALLEN;
+        }
+        break;
+
+    case ROBOT_STATE_BALANCING:
+        if (!in->balance_cmd) {
+            next = ROBOT_STATE_IDLE;
+        } else if (in->standup_cmd) {
+            next = ROBOT_STATE_STANDING_UP;
+        } else if (fallen) {
+            next = ROBOT_STATE_FALLEN;
+        }
+        break;
+
+    case ROBOT_STATE_STANDING_UP:
+        if (in->standup_complete) {
+            next = ROBOT_STATE_IDLE;
+        } else if (!in->standup_active) {
+            // Standup failed or cancelled
+            next = ROBOT_STATE_IDLE;
+        }
+        break;
+
+    case ROBOT_STATE_FALLEN:
+        // Can only recover through standup
+        if (in->standup_cmd) {
+            next = ROBOT_STATE_STANDING_UP;
+        }
+        break;
+
+    case ROBOT_STATE_ERROR:
+        // Manual recovery required - could add auto-recovery logic here
+        break;
+
+    default:
+        next = ROBOT_STATE_ERROR;
+        break;
+    }
+    return next;
+}
+
+const char* robot_state_name(robot_state_t state) {
+    switch (state) {
+        case ROBOT_STATE_INIT: return "INIT";
+        case ROBOT_STATE_IDLE: return "IDLE";
+        case ROBOT_STATE_BALANCING: return "BALANCING";
+        case ROBOT_STATE_STANDING_UP: return "STANDING_UP";
+        case ROBOT_STATE_FALLEN: return "FALLEN";
+        case ROBOT_STATE_ERROR: return "ERROR";
+        default: return "UNKNOWN";
+    }
+}
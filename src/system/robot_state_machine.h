@@ -0,0 +1,82 @@
+/**
+ * @file robot_state_machine.h
+ * @brief 로봇 상태 머신 헤더 파일
+ *
+ * 로봇 동작 상태와 상태 전환 규칙을 정의합니다.
+ * 전환 함수는 입력만으로 다음 상태를 결정하는 순수 함수이므로
+ * 펌웨어(main.c)와 호스트 시뮬레이터가 같은 규칙을 사용합니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef ROBOT_STATE_MACHINE_H
+#define ROBOT_STATE_MACHINE_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @enum robot_state_t
+ * @brief 로봇 상태 머신 정의
+ * 
+ * 로봇의 현재 동작 상태를 나타내는 열거형입니다.
+ * 각 상태는 로봇의 특정 동작 모드를 의미합니다.
+ */
+typedef enum {
+    ROBOT_STATE_INIT,        ///< 초기화 상태
+    ROBOT_STATE_IDLE,        ///< 대기 상태 (모터 정지)
+    ROBOT_STATE_BALANCING,   ///< 밸런싱 제어 상태
+    ROBOT_STATE_STANDING_UP, ///< 기립 보조 동작 상태
+    ROBOT_STATE_FALLEN,      ///< 넘어진 상태
+    ROBOT_STATE_ERROR        ///< 오류 상태
+} robot_state_t;
+
+/**
+ * @struct robot_state_inputs_t
+ * @brief 상태 전환 판단에 쓰이는 입력
+ */
+typedef struct {
+    float angle;             ///< 현재 피치 각도 (degree)
+    float fallen_angle;      ///< 넘어짐 판정 각도 (degree)
+    bool balance_cmd;        ///< 원격 밸런싱 명령
+    bool standup_cmd;        ///< 원격 기립 명령
+    bool standup_active;     ///< 서보 기립 동작 중 여부
+    bool standup_complete;   ///< 서보 기립 완료 여부
+} robot_state_inputs_t;
+
+/**
+ * @brief 다음 로봇 상태 계산
+ * 
+ * 상태 전환 조건:
+ * - IDLE → BALANCING: 밸런싱 명령 수신 (기립 중이 아닐 때)
+ * - IDLE → STANDING_UP: 기립 명령 수신
+ * - BALANCING → IDLE: 밸런싱 명령 해제
+ * - BALANCING → STANDING_UP: 기립 명령 수신
+ * - IDLE/BALANCING → FALLEN: 기울어짐 각도가 임계값 초과
+ * - FALLEN → STANDING_UP: 기립 명령 수신 (회복 시도)
+ * - STANDING_UP → IDLE: 기립 완료 또는 실패
+ * - 알 수 없는 상태 → ERROR
+ * 
+ * @param current 현재 상태
+ * @param in 전환 판단 입력
+ * @return robot_state_t 다음 상태 (전환이 없으면 current)
+ */
+robot_state_t robot_state_machine_next(robot_state_t current, const robot_state_inputs_t* in);
+
+/**
+ * @brief 로봇 상태를 문자열로 변환
+ * @param state 변환할 로봇 상태
+ * @return const char* 상태를 나타내는 문자열
+ */
+const char* robot_state_name(robot_state_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ROBOT_STATE_MACHINE_H
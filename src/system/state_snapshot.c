@@ -0,0 +1,73 @@
+/**
+ * @file state_snapshot.c
+ * @brief 단일 작성자 lock-free 상태 스냅샷 구현
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "state_snapshot.h"
+#include <string.h>
+
+void state_snapshot_init(state_snapshot_t* snap, void* buffer, size_t size) {
+    memset(buffer, 0, STATE_SNAPSHOT_BUFFER_SIZE(size));
+    snap->slot[0] = (uint8_t*)buffer;
+    snap->slot[1] = (uint8_t*)buffer + size;
+    snap->size = size;
+    atomic_init(&snap->seq[0], 0);
+    atomic_init(&snap->seq[1], 0);
+    atomic_init(&snap->latest, 0);
+}
+
+/**
+ * @brief 발행 구현
+ *
+ * 독자가 보고 있을 가능성이 낮은 비활성 슬롯에 기록한 뒤 latest를 넘깁니다.
+ * 시퀀스를 홀수로 만든 뒤의 release 펜스가 페이로드 기록보다 먼저
+ * 홀수 시퀀스가 보이도록 보장합니다.
+ */
+void state_snapshot_publish(state_snapshot_t* snap, const void* data) {
+    uint32_t latest = atomic_load_explicit(&snap->latest, memory_order_relaxed);
+    uint32_t idx = (latest & 1u) ^ 1u;
+    uint32_t seq = atomic_load_explicit(&snap->seq[idx], memory_order_relaxed);
+
+    atomic_store_explicit(&snap->seq[idx], seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    memcpy(snap->slot[idx], data, snap->size);
+
+    atomic_store_explicit(&snap->seq[idx], seq + 2, memory_order_release);
+    atomic_store_explicit(&snap->latest, (((latest >> 1) + 1u) << 1) | idx,
+                          memory_order_release);
+}
+
+/**
+ * @brief 읽기 구현
+ *
+ * 복사 전후의 시퀀스가 같고 짝수이면 복사 도중 기록이 없었음이 보장됩니다.
+ * 발행 k는 슬롯 (k & 1)에 기록되므로 발행 횟수 n이 가리키는 슬롯의 시퀀스는
+ * n + (n & 1)입니다. latest를 읽은 뒤 작성자가 같은 슬롯을 다시 채웠다면
+ * 시퀀스가 이 값과 달라지므로 재시도합니다. 그렇지 않으면 latest보다 새로운
+ * 페이로드를 돌려준 뒤 다음 읽기에서 더 오래된 페이로드를 돌려줄 수 있습니다.
+ */
+uint32_t state_snapshot_read(state_snapshot_t* snap, void* out) {
+    for (;;) {
+        uint32_t latest = atomic_load_explicit(&snap->latest, memory_order_acquire);
+        uint32_t idx = latest & 1u;
+        uint32_t count = latest >> 1;
+        uint32_t seq_begin = atomic_load_explicit(&snap->seq[idx], memory_order_acquire);
+        // The publish count wraps at 2^31, the slot sequence at 2^32
+        if (((seq_begin - (count + idx)) & 0x7FFFFFFFu) != 0) {
+            continue;
+        }
+
+        memcpy(out, snap->slot[idx], snap->size);
+
+        atomic_thread_fence(memory_order_acquire);
+        uint32_t seq_end = atomic_load_explicit(&snap->seq[idx], memory_order_relaxed);
+        if (seq_begin == seq_end) {
+            return latest >> 1;
+        }
+    }
+}
@@ -0,0 +1,122 @@
+/**
+ * @file state_snapshot.h
+ * @brief 단일 작성자 lock-free 상태 스냅샷 인터페이스
+ *
+ * 제어 태스크가 주기마다 한 번 발행하는 로봇 상태를 여러 소비자 태스크가
+ * 뮤텍스 없이 읽을 수 있도록 하는 이중 버퍼 seqlock입니다.
+ * 작성자는 절대 대기하지 않으므로 낮은 우선순위 태스크가 제어 경로를
+ * 막는 우선순위 역전이 발생하지 않습니다.
+ *
+ * 동작 원리:
+ * - 슬롯 2개를 번갈아 기록하고, 기록이 끝난 슬롯 번호를 latest로 공개
+ * - 슬롯마다 시퀀스 번호를 두어 기록 중(홀수)이거나 읽는 동안 바뀐 경우 재시도
+ * - 작성자가 다른 슬롯에 쓰는 동안에는 독자가 재시도하지 않음
+ *
+ * @note 작성자는 하나여야 합니다. 독자 수에는 제한이 없습니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef STATE_SNAPSHOT_H
+#define STATE_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 페이로드 크기에 필요한 버퍼 크기 (슬롯 2개)
+ * @param size 페이로드 크기 (바이트)
+ */
+#define STATE_SNAPSHOT_BUFFER_SIZE(size) (2 * (size))
+
+/**
+ * @struct state_snapshot_t
+ * @brief 이중 버퍼 seqlock 상태
+ *
+ * 페이로드 저장 공간은 호출자가 제공하므로 임의의 구조체에 재사용할 수 있습니다.
+ */
+typedef struct {
+    atomic_uint_least32_t seq[2];   ///< 슬롯별 시퀀스 (홀수: 기록 중)
+    atomic_uint_least32_t latest;   ///< (발행 횟수 << 1) | 최신 슬롯 번호
+    uint8_t* slot[2];               ///< 슬롯 저장 공간
+    size_t size;                    ///< 페이로드 크기 (바이트)
+} state_snapshot_t;
+
+/**
+ * @struct robot_state_snapshot_t
+ * @brief 제어 주기마다 발행되는 로봇 상태
+ *
+ * 모든 필드는 같은 제어 주기에서 측정된 값으로, 서로 일관성이 보장됩니다.
+ */
+typedef struct {
+    int64_t timestamp_us;   ///< 발행 시각 (us)
+    float angle;            ///< 추정된 피치 각도 (degree)
+    float angle_rate;       ///< 바이어스 보정된 피치 각속도 (deg/s)
+    float roll;             ///< 추정된 롤 각도 (degree)
+    float yaw_rate;         ///< 요 각속도 (deg/s)
+    float velocity;         ///< 로봇 이동 속도, 좌우 평균 (cm/s)
+    float left_speed;       ///< 좌측 바퀴 속도 (cm/s)
+    float right_speed;      ///< 우측 바퀴 속도 (cm/s)
+    float x_cm;             ///< 오도메트리 x 위치 (cm, GPS 융합 시 동쪽)
+    float y_cm;             ///< 오도메트리 y 위치 (cm, GPS 융합 시 북쪽)
+    float heading;          ///< 오도메트리 헤딩 (degree, x축에서 반시계)
+    float position_std_cm;  ///< 오도메트리 위치 불확실성 (cm, 1 sigma)
+    uint8_t state;          ///< 로봇 상태 (robot_state_t 값)
+    bool balance_cmd;       ///< 제어 태스크가 적용 중인 원격 밸런싱 명령
+    bool standup_cmd;       ///< 제어 태스크가 적용 중인 원격 기립 명령
+} robot_state_snapshot_t;
+
+/**
+ * @defgroup STATE_SNAPSHOT_API 상태 스냅샷 API
+ * @brief 단일 작성자/다중 독자 스냅샷 함수들
+ * @{
+ */
+
+/**
+ * @brief 스냅샷 초기화
+ *
+ * 버퍼를 0으로 채웁니다. 발행 전에 읽으면 0으로 채워진 페이로드를 얻습니다.
+ *
+ * @param snap 스냅샷 구조체 포인터
+ * @param buffer STATE_SNAPSHOT_BUFFER_SIZE(size) 바이트 이상의 저장 공간
+ * @param size 페이로드 크기 (바이트)
+ */
+void state_snapshot_init(state_snapshot_t* snap, void* buffer, size_t size);
+
+/**
+ * @brief 새 페이로드 발행 (작성자 전용)
+ *
+ * 블로킹하지 않으며 독자 수와 무관하게 일정 시간에 완료됩니다.
+ *
+ * @param snap 스냅샷 구조체 포인터
+ * @param data 발행할 페이로드 (size 바이트)
+ */
+void state_snapshot_publish(state_snapshot_t* snap, const void* data);
+
+/**
+ * @brief 최신 페이로드 읽기
+ *
+ * 찢어지지 않은(한 번의 발행에서 나온) 페이로드를 out에 복사합니다.
+ * 읽는 도중 작성자가 같은 슬롯을 다시 쓰기 시작한 경우에만 재시도합니다.
+ *
+ * @param snap 스냅샷 구조체 포인터
+ * @param out 출력 버퍼 (size 바이트)
+ * @return uint32_t 읽은 시점의 발행 횟수 (0: 아직 발행되지 않음)
+ */
+uint32_t state_snapshot_read(state_snapshot_t* snap, void* out);
+
+/** @} */ // STATE_SNAPSHOT_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STATE_SNAPSHOT_H
@@ -0,0 +1,266 @@
+/**
+ * @file telemetry.c
+ * @brief 고속 바이너리 텔레메트리 스트림 구현
+ *
+ * 차분은 모두 uint32 모듈러 연산으로 계산하므로 엔코더 카운트가 넘어가도
+ * 인코딩/디코딩이 정확히 대칭입니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#include "telemetry.h"
+#include <string.h>
+
+#define TELEMETRY_QUANT_LIMIT   1.0e9f  ///< 양자화 값 상한 (NaN/발산 값이 int32를 넘지 않게)
+
+void telemetry_ring_init(telemetry_ring_t* ring, telemetry_sample_t* storage, uint32_t capacity) {
+    ring->samples = storage;
+    ring->mask = capacity - 1u;
+    ring->produced = 0;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->dropped, 0);
+}
+
+bool telemetry_ring_push(telemetry_ring_t* ring, const telemetry_sample_t* sample) {
+    uint32_t index = ring->produced++;
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    if (head - tail > ring->mask) {
+        atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+        return false;
+    }
+
+    telemetry_sample_t* slot = &ring->samples[head & ring->mask];
+    *slot = *sample;
+    slot->index = index;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return true;
+}
+
+const telemetry_sample_t* telemetry_ring_peek(telemetry_ring_t* ring) {
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    if (head == tail) {
+        return NULL;
+    }
+    return &ring->samples[tail & ring->mask];
+}
+
+void telemetry_ring_consume(telemetry_ring_t* ring) {
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
+
+void telemetry_ring_discard(telemetry_ring_t* ring) {
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    atomic_store_explicit(&ring->tail, head, memory_order_release);
+}
+
+/**
+ * @brief 실수 값을 배율로 양자화 (반올림, 범위 제한)
+ */
+static uint32_t quantize(float value, float scale) {
+    float scaled = value * scale;
+    if (!(scaled == scaled)) return 0u;
+    if (scaled > TELEMETRY_QUANT_LIMIT) scaled = TELEMETRY_QUANT_LIMIT;
+    if (scaled < -TELEMETRY_QUANT_LIMIT) scaled = -TELEMETRY_QUANT_LIMIT;
+    return (uint32_t)(int32_t)(scaled + ((scaled >= 0.0f) ? 0.5f : -0.5f));
+}
+
+/**
+ * @brief 샘플을 필드 순서대로 양자화
+ */
+static void quantize_sample(const telemetry_sample_t* s, uint32_t q[TELEMETRY_FIELD_COUNT]) {
+    q[0] = s->timestamp_us;
+    q[1] = quantize(s->angle, TELEMETRY_ANGLE_SCALE);
+    q[2] = quantize(s->angle_rate, TELEMETRY_RATE_SCALE);
+    q[3] = quantize(s->pid_p, TELEMETRY_PID_SCALE);
+    q[4] = quantize(s->pid_i, TELEMETRY_PID_SCALE);
+    q[5] = quantize(s->pid_d, TELEMETRY_PID_SCALE);
+    q[6] = (uint32_t)(int32_t)s->motor_left;
+    q[7] = (uint32_t)(int32_t)s->motor_right;
+    q[8] = (uint32_t)s->encoder_left;
+    q[9] = (uint32_t)s->encoder_right;
+    q[10] = quantize(s->x_cm, TELEMETRY_POSITION_SCALE);
+    q[11] = quantize(s->y_cm, TELEMETRY_POSITION_SCALE);
+    q[12] = quantize(s->heading, TELEMETRY_ANGLE_SCALE);
+}
+
+/**
+ * @brief 양자화 값을 샘플 필드로 복원
+ */
+static void dequantize_sample(const uint32_t q[TELEMETRY_FIELD_COUNT], telemetry_sample_t* s) {
+    s->timestamp_us = q[0];
+    s->angle = (float)(int32_t)q[1] / TELEMETRY_ANGLE_SCALE;
+    s->angle_rate = (float)(int32_t)q[2] / TELEMETRY_RATE_SCALE;
+    s->pid_p = (float)(int32_t)q[3] / TELEMETRY_PID_SCALE;
+    s->pid_i = (float)(int32_t)q[4] / TELEMETRY_PID_SCALE;
+    s->pid_d = (float)(int32_t)q[5] / TELEMETRY_PID_SCALE;
+    s->motor_left = (int16_t)(int32_t)q[6];
+    s->motor_right = (int16_t)(int32_t)q[7];
+    s->encoder_left = (int32_t)q[8];
+    s->encoder_right = (int32_t)q[9];
+    s->x_cm = (float)(int32_t)q[10] / TELEMETRY_POSITION_SCALE;
+    s->y_cm = (float)(int32_t)q[11] / TELEMETRY_POSITION_SCALE;
+    s->heading = (float)(int32_t)q[12] / TELEMETRY_ANGLE_SCALE;
+}
+
+static size_t put_varint(uint8_t* out, uint32_t value) {
+    size_t n = 0;
+    while (value >= 0x80u) {
+        out[n++] = (uint8_t)(value | 0x80u);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+/**
+ * @brief varint 하나 읽기
+ * @return size_t 읽은 바이트 수 (0: 버퍼 끝 또는 5바이트 초과)
+ */
+static size_t get_varint(const uint8_t* in, size_t avail, uint32_t* value) {
+    uint32_t v = 0;
+    for (size_t n = 0; n < avail && n < 5; n++) {
+        v |= (uint32_t)(in[n] & 0x7Fu) << (7 * n);
+        if ((in[n] & 0x80u) == 0) {
+            *value = v;
+            return n + 1;
+        }
+    }
+    return 0;
+}
+
+static inline uint32_t zigzag_encode(uint32_t d) {
+    return (d << 1) ^ (0u - (d >> 31));
+}
+
+static inline uint32_t zigzag_decode(uint32_t z) {
+    return (z >> 1) ^ (0u - (z & 1u));
+}
+
+void telemetry_packer_begin(telemetry_packer_t* packer, uint16_t capacity, uint16_t seq, uint32_t first_index) {
+    packer->capacity = (capacity > TELEMETRY_MAX_FRAME_SIZE) ? TELEMETRY_MAX_FRAME_SIZE : capacity;
+    packer->length = PROTOCOL_HEADER_SIZE + TELEMETRY_PACKET_HEADER_SIZE;
+    packer->seq = seq;
+    packer->first_index = first_index;
+    packer->count = 0;
+    // Deltas against zero make the first sample a keyframe
+    memset(packer->prev, 0, sizeof(packer->prev));
+}
+
+bool telemetry_packer_add(telemetry_packer_t* packer, const telemetry_sample_t* sample) {
+    if (packer->count == UINT8_MAX) return false;
+    if (packer->count > 0 && sample->index != packer->first_index + packer->count) return false;
+
+    uint32_t q[TELEMETRY_FIELD_COUNT];
+    quantize_sample(sample, q);
+
+    uint8_t encoded[TELEMETRY_SAMPLE_MAX_SIZE];
+    size_t n = put_varint(encoded, q[0] - packer->prev[0]);
+    for (int i = 1; i < TELEMETRY_FIELD_COUNT; i++) {
+        n += put_varint(encoded + n, zigzag_encode(q[i] - packer->prev[i]));
+    }
+    if (packer->length + n > packer->capacity) return false;
+
+    memcpy(packer->frame + packer->length, encoded, n);
+    packer->length = (uint16_t)(packer->length + n);
+    memcpy(packer->prev, q, sizeof(q));
+    packer->count++;
+    return true;
+}
+
+uint16_t telemetry_packer_finish(telemetry_packer_t* packer) {
+    if (packer->count == 0) return 0;
+
+    uint8_t* f = packer->frame;
+    uint16_t payload_len = (uint16_t)(packer->length - PROTOCOL_HEADER_SIZE);
+    f[0] = PROTOCOL_START_MARKER;
+    f[1] = PROTOCOL_VERSION;
+    f[2] = MSG_TYPE_TELEMETRY;
+    f[3] = (uint8_t)packer->seq;
+    f[4] = (uint8_t)payload_len;
+    f[5] = (uint8_t)(payload_len >> 8);
+
+    uint8_t* p = f + PROTOCOL_HEADER_SIZE;
+    p[0] = (uint8_t)packer->seq;
+    p[1] = (uint8_t)(packer->seq >> 8);
+    p[2] = (uint8_t)packer->first_index;
+    p[3] = (uint8_t)(packer->first_index >> 8);
+    p[4] = (uint8_t)(packer->first_index >> 16);
+    p[5] = (uint8_t)(packer->first_index >> 24);
+    p[6] = packer->count;
+
+    uint16_t crc = protocol_frame_checksum(f, p, payload_len);
+    f[PROTOCOL_CHECKSUM_OFFSET] = (uint8_t)crc;
+    f[PROTOCOL_CHECKSUM_OFFSET + 1] = (uint8_t)(crc >> 8);
+    return packer->length;
+}
+
+uint16_t telemetry_pack_from_ring(telemetry_packer_t* packer, telemetry_ring_t* ring,
+                                  uint16_t capacity, uint16_t seq) {
+    const telemetry_sample_t* sample = telemetry_ring_peek(ring);
+    if (sample == NULL) return 0;
+
+    telemetry_packer_begin(packer, capacity, seq, sample->index);
+    while (sample != NULL && telemetry_packer_add(packer, sample)) {
+        telemetry_ring_consume(ring);
+        sample = telemetry_ring_peek(ring);
+    }
+    return telemetry_packer_finish(packer);
+}
+
+int telemetry_decode(const uint8_t* frame, size_t length, telemetry_packet_info_t* info,
+                     telemetry_sample_t* samples, size_t max_samples) {
+    if (length < PROTOCOL_HEADER_SIZE + TELEMETRY_PACKET_HEADER_SIZE) return -1;
+    if (frame[0] != PROTOCOL_START_MARKER || frame[1] != PROTOCOL_VERSION ||
+        frame[2] != MSG_TYPE_TELEMETRY) {
+        return -1;
+    }
+
+    uint16_t payload_len = (uint16_t)(frame[4] | (frame[5] << 8));
+    if (payload_len < TELEMETRY_PACKET_HEADER_SIZE || length < PROTOCOL_HEADER_SIZE + (size_t)payload_len) {
+        return -1;
+    }
+    const uint8_t* p = frame + PROTOCOL_HEADER_SIZE;
+    uint16_t stored = (uint16_t)(frame[PROTOCOL_CHECKSUM_OFFSET] | (frame[PROTOCOL_CHECKSUM_OFFSET + 1] << 8));
+    if (protocol_frame_checksum(frame, p, payload_len) != stored) return -1;
+
+    info->seq = (uint16_t)(p[0] | (p[1] << 8));
+    info->first_index = (uint32_t)p[2] | ((uint32_t)p[3] << 8) | ((uint32_t)p[4] << 16) | ((uint32_t)p[5] << 24);
+    info->count = p[6];
+    if (info->count > max_samples) return -1;
+
+    size_t pos = TELEMETRY_PACKET_HEADER_SIZE;
+    uint32_t q[TELEMETRY_FIELD_COUNT] = {0};
+    for (uint8_t s = 0; s < info->count; s++) {
+        for (int i = 0; i < TELEMETRY_FIELD_COUNT; i++) {
+            uint32_t v;
+            size_t n = get_varint(p + pos, payload_len - pos, &v);
+            if (n == 0) return -1;
+            pos += n;
+            q[i] += (i == 0) ? v : zigzag_decode(v);
+        }
+        dequantize_sample(q, &samples[s]);
+        samples[s].index = info->first_index + s;
+    }
+    return (pos == payload_len) ? (int)info->count : -1;
+}
+
+void telemetry_rx_init(telemetry_rx_t* rx) {
+    memset(rx, 0, sizeof(*rx));
+}
+
+void telemetry_rx_track(telemetry_rx_t* rx, const telemetry_packet_info_t* info) {
+    if (rx->synced) {
+        rx->lost_packets += (uint16_t)(info->seq - rx->next_seq);
+        rx->lost_samples += info->first_index - rx->next_index;
+    }
+    rx->synced = true;
+    rx->packets++;
+    rx->next_seq = (uint16_t)(info->seq + 1u);
+    rx->next_index = info->first_index + info->count;
+}
@@ -0,0 +1,249 @@
+/**
+ * @file telemetry.h
+ * @brief 고속 바이너리 텔레메트리 스트림 인터페이스
+ *
+ * 제어 태스크가 만든 샘플(각도, 각속도, PID 항, 모터 명령, 엔코더 카운트, 자세)을
+ * lock-free 링 버퍼로 넘기고, 텔레메트리 태스크가 BLE 알림 하나에 여러 샘플을
+ * 협상된 MTU까지 묶어 전송합니다.
+ *
+ * 패킷 형식 (프로토콜 헤더 8바이트 + 페이로드, 리틀 엔디언):
+ * - 헤더: 시작 마커, 버전, MSG_TYPE_TELEMETRY, 패킷 시퀀스 하위 8비트, 길이, CRC16
+ * - 페이로드 [0..1]: 패킷 시퀀스 (uint16, 패킷마다 1 증가)
+ * - 페이로드 [2..5]: 첫 샘플 번호 (uint32, 샘플마다 1 증가)
+ * - 페이로드 [6]: 샘플 수
+ * - 샘플: 필드 13개를 고정소수점으로 양자화한 뒤 직전 샘플과의 차이를
+ *   zigzag varint로 기록 (첫 샘플은 0과의 차이 = 절대값, 즉 키프레임)
+ *
+ * 패킷마다 키프레임으로 시작하므로 패킷이 유실되어도 다음 패킷은 독립적으로
+ * 복원됩니다. 클라이언트는 패킷 시퀀스의 틈으로 전송 유실을, 샘플 번호의 틈으로
+ * 링 버퍼 오버플로를 포함한 전체 샘플 유실을 감지합니다.
+ *
+ * @note 텔레메트리 프레임은 로봇→클라이언트 전용이며 페이로드가 MAX_PAYLOAD_SIZE보다
+ *       클 수 있으므로 protocol_frame_view()가 아닌 telemetry_decode()로 해석합니다.
+ *
+ * @author BalanceBot Team
+ * @date 2025-10-16
+ * @version 1.0
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "protocol_frame.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TELEMETRY_FIELD_COUNT       13      ///< 샘플당 필드 수
+#define TELEMETRY_PACKET_HEADER_SIZE 7      ///< 패킷 시퀀스 + 첫 샘플 번호 + 샘플 수
+#define TELEMETRY_SAMPLE_MAX_SIZE   (TELEMETRY_FIELD_COUNT * 5) ///< 인코딩된 샘플 최대 크기 (varint 5바이트 × 필드 수)
+#define TELEMETRY_MIN_FRAME_SIZE    (PROTOCOL_HEADER_SIZE + TELEMETRY_PACKET_HEADER_SIZE + TELEMETRY_SAMPLE_MAX_SIZE) ///< 샘플 하나를 항상 담을 수 있는 최소 프레임
+#define TELEMETRY_MAX_FRAME_SIZE    244     ///< 최대 프레임 크기 (LE 데이터 길이 251 - L2CAP 4 - ATT 3)
+
+#define TELEMETRY_ANGLE_SCALE       100.0f  ///< 각도 양자화 배율 (0.01 degree)
+#define TELEMETRY_RATE_SCALE        10.0f   ///< 각속도 양자화 배율 (0.1 deg/s)
+#define TELEMETRY_PID_SCALE         100.0f  ///< PID 항 양자화 배율 (모터 출력 0.01 단위)
+#define TELEMETRY_POSITION_SCALE    10.0f   ///< 위치 양자화 배율 (1 mm)
+
+/**
+ * @struct telemetry_sample_t
+ * @brief 제어 주기 하나의 텔레메트리 샘플
+ */
+typedef struct {
+    uint32_t index;         ///< 샘플 번호 (링 버퍼가 부여, 디코더는 첫 샘플 번호부터 채움)
+    uint32_t timestamp_us;  ///< 샘플 시각 (us, 하위 32비트)
+    float angle;            ///< 피치 각도 (degree)
+    float angle_rate;       ///< 피치 각속도 (deg/s)
+    float pid_p;            ///< 각도 루프 P항
+    float pid_i;            ///< 각도 루프 I항
+    float pid_d;            ///< 각도 루프 D항 (측정 각속도 기반)
+    int16_t motor_left;     ///< 좌측 모터 명령 (-255 ~ 255)
+    int16_t motor_right;    ///< 우측 모터 명령 (-255 ~ 255)
+    int32_t encoder_left;   ///< 좌측 엔코더 누적 카운트
+    int32_t encoder_right;  ///< 우측 엔코더 누적 카운트
+    float x_cm;             ///< 오도메트리 x 위치 (cm)
+    float y_cm;             ///< 오도메트리 y 위치 (cm)
+    float heading;          ///< 오도메트리 헤딩 (degree)
+} telemetry_sample_t;
+
+/**
+ * @struct telemetry_ring_t
+ * @brief 단일 생산자/단일 소비자 샘플 링 버퍼
+ *
+ * 생산자(제어 태스크)는 가득 차면 샘플을 버리고 절대 대기하지 않습니다.
+ * 버린 샘플도 번호를 소비하므로 클라이언트가 틈으로 감지할 수 있습니다.
+ */
+typedef struct {
+    telemetry_sample_t* samples;    ///< 샘플 저장 공간 (호출자 제공)
+    uint32_t mask;                  ///< 용량 - 1 (용량은 2의 거듭제곱)
+    atomic_uint_least32_t head;     ///< 다음 기록 위치 (생산자가 증가)
+    atomic_uint_least32_t tail;     ///< 다음 읽기 위치 (소비자가 증가)
+    uint32_t produced;              ///< 부여한 샘플 번호 수 (생산자 전용)
+    atomic_uint_least32_t dropped;  ///< 링이 가득 차서 버린 샘플 수
+} telemetry_ring_t;
+
+/**
+ * @struct telemetry_packer_t
+ * @brief 텔레메트리 프레임 조립 상태
+ */
+typedef struct {
+    uint8_t frame[TELEMETRY_MAX_FRAME_SIZE];    ///< 프레임 버퍼 (헤더 포함)
+    uint16_t length;                            ///< 현재 프레임 길이
+    uint16_t capacity;                          ///< 이번 프레임 최대 길이
+    uint16_t seq;                               ///< 패킷 시퀀스
+    uint32_t first_index;                       ///< 첫 샘플 번호
+    uint8_t count;                              ///< 담은 샘플 수
+    uint32_t prev[TELEMETRY_FIELD_COUNT];       ///< 직전 샘플의 양자화 값 (차분 기준)
+} telemetry_packer_t;
+
+/**
+ * @struct telemetry_packet_info_t
+ * @brief 디코딩된 패킷 헤더
+ */
+typedef struct {
+    uint16_t seq;           ///< 패킷 시퀀스
+    uint32_t first_index;   ///< 첫 샘플 번호
+    uint8_t count;          ///< 샘플 수
+} telemetry_packet_info_t;
+
+/**
+ * @struct telemetry_rx_t
+ * @brief 수신측 유실 추적 상태
+ */
+typedef struct {
+    bool synced;            ///< 첫 패킷 수신 여부
+    uint16_t next_seq;      ///< 기대하는 다음 패킷 시퀀스
+    uint32_t next_index;    ///< 기대하는 다음 샘플 번호
+    uint32_t packets;       ///< 수신한 패킷 수
+    uint32_t lost_packets;  ///< 시퀀스 틈으로 감지한 유실 패킷 수
+    uint32_t lost_samples;  ///< 샘플 번호 틈으로 감지한 유실 샘플 수 (오버플로 포함)
+} telemetry_rx_t;
+
+/**
+ * @defgroup TELEMETRY_API 텔레메트리 API
+ * @brief 샘플 링 버퍼, 패킷 조립/해석, 유실 추적 함수들
+ * @{
+ */
+
+/**
+ * @brief 링 버퍼 초기화
+ * @param ring 링 버퍼
+ * @param storage 샘플 저장 공간
+ * @param capacity 저장 공간의 샘플 수 (2의 거듭제곱)
+ */
+void telemetry_ring_init(telemetry_ring_t* ring, telemetry_sample_t* storage, uint32_t capacity);
+
+/**
+ * @brief 샘플 추가 (생산자 전용, 블로킹 없음)
+ *
+ * 샘플 번호는 여기서 부여되며 sample->index는 무시됩니다.
+ *
+ * @param ring 링 버퍼
+ * @param sample 추가할 샘플
+ * @return bool 저장 여부 (false: 가득 차서 버림)
+ */
+bool telemetry_ring_push(telemetry_ring_t* ring, const telemetry_sample_t* sample);
+
+/**
+ * @brief 가장 오래된 샘플 보기 (소비자 전용, 복사 없음)
+ * @param ring 링 버퍼
+ * @return const telemetry_sample_t* 샘플 (비었으면 NULL). telemetry_ring_consume() 전까지 유효
+ */
+const telemetry_sample_t* telemetry_ring_peek(telemetry_ring_t* ring);
+
+/**
+ * @brief peek한 샘플 하나 제거 (소비자 전용)
+ * @param ring 링 버퍼
+ */
+void telemetry_ring_consume(telemetry_ring_t* ring);
+
+/**
+ * @brief 쌓인 샘플 모두 버리기 (소비자 전용, 구독자가 없을 때 사용)
+ * @param ring 링 버퍼
+ */
+void telemetry_ring_discard(telemetry_ring_t* ring);
+
+/**
+ * @brief 새 패킷 시작
+ * @param packer 조립 상태
+ * @param capacity 프레임 최대 길이 (ATT MTU - 3, TELEMETRY_MAX_FRAME_SIZE로 제한)
+ * @param seq 패킷 시퀀스
+ * @param first_index 첫 샘플 번호
+ */
+void telemetry_packer_begin(telemetry_packer_t* packer, uint16_t capacity, uint16_t seq, uint32_t first_index);
+
+/**
+ * @brief 샘플 하나를 패킷에 추가
+ *
+ * 번호가 이어지지 않는 샘플(오버플로로 중간이 빠진 경우)은 다음 패킷이
+ * 새 첫 샘플 번호로 시작하도록 거부합니다.
+ *
+ * @param packer 조립 상태
+ * @param sample 추가할 샘플
+ * @return bool 추가 여부 (false: 공간 부족, 샘플 수 한도, 번호 불연속)
+ */
+bool telemetry_packer_add(telemetry_packer_t* packer, const telemetry_sample_t* sample);
+
+/**
+ * @brief 헤더와 체크섬을 채워 패킷 완성
+ * @param packer 조립 상태
+ * @return uint16_t 프레임 길이 (샘플이 없으면 0). 프레임은 packer->frame
+ */
+uint16_t telemetry_packer_finish(telemetry_packer_t* packer);
+
+/**
+ * @brief 링 버퍼의 샘플로 패킷 하나를 조립
+ *
+ * 용량이 허락하는 만큼 연속된 샘플을 꺼내 담습니다.
+ * capacity는 TELEMETRY_MIN_FRAME_SIZE 이상이어야 진행이 보장됩니다.
+ *
+ * @param packer 조립 상태
+ * @param ring 링 버퍼 (소비자 측)
+ * @param capacity 프레임 최대 길이
+ * @param seq 패킷 시퀀스
+ * @return uint16_t 프레임 길이 (보낼 샘플이 없으면 0)
+ */
+uint16_t telemetry_pack_from_ring(telemetry_packer_t* packer, telemetry_ring_t* ring,
+                                  uint16_t capacity, uint16_t seq);
+
+/**
+ * @brief 텔레메트리 프레임 해석
+ *
+ * 헤더, 체크섬, varint 경계를 검증하고 샘플을 복원합니다.
+ * 복원된 값은 양자화 배율만큼의 오차를 가집니다.
+ *
+ * @param frame 프레임 (시작 마커부터)
+ * @param length 프레임 길이
+ * @param info 패킷 헤더 출력
+ * @param samples 샘플 출력 배열
+ * @param max_samples 출력 배열 크기
+ * @return int 복원한 샘플 수 (음수: 잘못된 프레임 또는 배열 부족)
+ */
+int telemetry_decode(const uint8_t* frame, size_t length, telemetry_packet_info_t* info,
+                     telemetry_sample_t* samples, size_t max_samples);
+
+/**
+ * @brief 수신측 유실 추적 초기화
+ * @param rx 추적 상태
+ */
+void telemetry_rx_init(telemetry_rx_t* rx);
+
+/**
+ * @brief 수신한 패킷으로 유실 통계 갱신
+ * @param rx 추적 상태
+ * @param info 수신한 패킷 헤더
+ */
+void telemetry_rx_track(telemetry_rx_t* rx, const telemetry_packet_info_t* info);
+
+/** @} */ // TELEMETRY_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TELEMETRY_H
@@ -2,12 +2,42 @@
 #include <stdbool.h>
 #include <math.h>
 #include <string.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
 
 // Include protocol header for communication tests
 #ifndef NATIVE_BUILD
 #define NATIVE_BUILD  // Ensure we get the mock definitions
 #endif
 #include "../src/system/protocol.h"
+#include "../src/system/control_scheduler.h"
+#include "../src/system/state_snapshot.h"
+#include "../src/system/robot_state_machine.h"
+#include "../src/system/crc16.h"
+#include "../src/system/protocol_frame.h"
+#include "../src/system/telemetry.h"
+#include "../src/system/command_queue.h"
+#include "../src/system/command_watchdog.h"
+#include "../src/system/param_registry.h"
+#include "../src/system/param_store.h"
+#include "../src/output/ble_link.h"
+#include "../src/input/imu_sensor.h"
+#include "../src/input/imu_calibration.h"
+#include "../src/input/imu_drdy.h"
+#include "../src/input/encoder_sensor.h"
+#include "../src/input/nmea_parser.h"
+#include "../src/input/ubx_parser.h"
+#include "../src/input/gps_sensor.h"
+#include "../src/bsw/i2c_driver.h"
+#include "../src/logic/kalman_filter.h"
+#include "../src/logic/attitude_estimator.h"
+#include "../src/logic/control_fixed.h"
+#include "../src/logic/velocity_estimator.h"
+#include "../src/logic/odometry.h"
+// Driver headers above already provide the native gpio_num_t
+#define GPIO_NUM_T_DEFINED
+#include "../src/config.h"
 
 // ============================================================================
 // Mock Protocol Implementation for Testing
@@ -85,8 +115,8 @@ void build_move_command(protocol_message_t* msg, int8_t direction, int8_t turn,
     msg->payload.move_cmd.flags = flags;
     msg->payload.move_cmd.timestamp = 0;
     
-    msg->header.checksum = calculate_checksum((const uint8_t*)&msg->header + 6,
-                                            sizeof(protocol_header_t) - 6 + msg->header.payload_len);
+    msg->header.checksum = protocol_frame_checksum((const uint8_t*)&msg->header,
+                                                   msg->payload.raw_data, msg->header.payload_len);
 }
 
 void build_status_response(protocol_message_t* msg, float angle, float velocity,
@@ -108,8 +138,8 @@ void build_status_response(protocol_message_t* msg, float angle, float velocity,
     msg->payload.status_resp.battery_level = 100;
     msg->payload.status_resp.error_flags = 0;
     
-    msg->header.checksum = calculate_checksum((const uint8_t*)&msg->header + 6,
-                                            sizeof(protocol_header_t) - 6 + msg->header.payload_len);
+    msg->header.checksum = protocol_frame_checksum((const uint8_t*)&msg->header,
+                                                   msg->payload.raw_data, msg->header.payload_len);
 }
 
 void build_error_message(protocol_message_t* msg, uint8_t error_code, uint8_t seq_num) {
@@ -123,8 +153,8 @@ void build_error_message(protocol_message_t* msg, uint8_t error_code, uint8_t se
     
     msg->payload.raw_data[0] = error_code;
     
-    msg->header.checksum = calculate_checksum((const uint8_t*)&msg->header + 6,
-                                            sizeof(protocol_header_t) - 6 + msg->header.payload_len);
+    msg->header.checksum = protocol_frame_checksum((const uint8_t*)&msg->header,
+                                                   msg->payload.raw_data, msg->header.payload_len);
 }
 
 // ============================================================================
@@ -343,6 +373,86 @@ void mock_ble_disconnect(mock_ble_controller_t* ble) {
     ble->device_connected = false;
 }
 
+// ============================================================================
+// Mock I2C Bus: replays a recorded MPU6050 FIFO stream
+// ============================================================================
+
+#define FAKE_MPU_WHO_AM_I    0x75
+#define FAKE_MPU_USER_CTRL   0x6A
+#define FAKE_MPU_FIFO_COUNTH 0x72
+#define FAKE_MPU_FIFO_R_W    0x74
+#define FAKE_FIFO_STREAM_MAX 4096
+
+static uint8_t fake_fifo_stream[FAKE_FIFO_STREAM_MAX]; // recorded FIFO bytes in arrival order
+static size_t fake_fifo_written;                       // bytes the sensor has produced so far
+static size_t fake_fifo_read;                          // bytes drained by the driver
+static uint16_t fake_fifo_count_override;              // non-zero: report this FIFO_COUNT instead
+static uint32_t fake_i2c_read_transactions;
+static uint32_t fake_fifo_resets;
+static uint32_t fake_i2c_latency_us;                   // fake clock time consumed per read transaction
+
+// Fake MPU6050 on the driver's native bus hook
+static esp_err_t fake_mpu_bus(uint8_t device_addr, uint8_t reg_addr, uint8_t* data, size_t len, bool is_read) {
+    (void)device_addr;
+    if (!is_read) {
+        if (reg_addr == FAKE_MPU_USER_CTRL && (data[0] & 0x04)) {
+            fake_fifo_resets++;
+            fake_fifo_read = fake_fifo_written; // drop everything queued
+            fake_fifo_count_override = 0;
+        }
+        return ESP_OK;
+    }
+
+    fake_i2c_read_transactions++;
+    control_scheduler_fake_clock_advance(fake_i2c_latency_us);
+    if (reg_addr == FAKE_MPU_WHO_AM_I) {
+        data[0] = 0x68;
+    } else if (reg_addr == FAKE_MPU_FIFO_COUNTH) {
+        size_t queued = fake_fifo_count_override ? fake_fifo_count_override
+                                                 : fake_fifo_written - fake_fifo_read;
+        data[0] = (uint8_t)(queued >> 8);
+        data[1] = (uint8_t)(queued & 0xFF);
+    } else if (reg_addr == FAKE_MPU_FIFO_R_W) {
+        if (fake_fifo_read + len > fake_fifo_written) return ESP_FAIL; // FIFO underrun
+        memcpy(data, &fake_fifo_stream[fake_fifo_read], len);
+        fake_fifo_read += len;
+    } else {
+        memset(data, 0, len);
+    }
+    return ESP_OK;
+}
+
+static void fake_fifo_reset_stream(void) {
+    fake_fifo_written = 0;
+    fake_fifo_read = 0;
+    fake_fifo_count_override = 0;
+    fake_i2c_read_transactions = 0;
+    fake_fifo_resets = 0;
+    fake_i2c_latency_us = 0;
+}
+
+static void put_be16(uint8_t* p, int16_t v) {
+    p[0] = (uint8_t)((uint16_t)v >> 8);
+    p[1] = (uint8_t)((uint16_t)v & 0xFF);
+}
+
+// Append one 12-byte frame (accel XYZ, gyro XYZ, big endian) as the sensor would
+static void fake_fifo_push_frame(int16_t ax, int16_t ay, int16_t az, int16_t gx, int16_t gy, int16_t gz) {
+    uint8_t* f = &fake_fifo_stream[fake_fifo_written];
+    put_be16(f + 0, ax); put_be16(f + 2, ay); put_be16(f + 4, az);
+    put_be16(f + 6, gx); put_be16(f + 8, gy); put_be16(f + 10, gz);
+    fake_fifo_written += IMU_FIFO_FRAME_SIZE;
+}
+
+static void setup_fifo_imu(imu_sensor_t* imu, uint16_t rate_hz) {
+    fake_fifo_reset_stream();
+    i2c_driver_fake_set_bus(fake_mpu_bus);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_init(imu, 0, 0, 0));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_configure_rate(imu, rate_hz));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_enable_fifo(imu));
+    fake_i2c_read_transactions = 0;
+}
+
 // ============================================================================
 // Unity Test Setup
 // ============================================================================
@@ -482,6 +592,930 @@ void test_protocol_error_message_handling(void) {
     TEST_ASSERT_EQUAL_UINT8(0x42, decoded_msg.payload.raw_data[0]);
 }
 
+// ============================================================================
+// CRC16 Implementation Tests
+// ============================================================================
+
+typedef uint16_t (*crc16_fn_t)(uint16_t crc, const uint8_t* data, size_t length);
+
+void test_crc16_implementations_match_reference(void) {
+    const crc16_fn_t impls[] = {crc16_update_bitwise, crc16_update_table, crc16_update_slice4, crc16_update};
+    const uint8_t check[] = "123456789";
+    static uint8_t buf[300 + 4];
+    uint32_t rng = 12345u;
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        rng = rng * 1664525u + 1013904223u;
+        buf[i] = (uint8_t)(rng >> 24);
+    }
+
+    for (size_t f = 0; f < sizeof(impls) / sizeof(impls[0]); f++) {
+        // CRC-16/MODBUS check value
+        TEST_ASSERT_EQUAL_HEX16(0x4B37, impls[f](CRC16_INIT, check, 9));
+        TEST_ASSERT_EQUAL_HEX16(CRC16_INIT, impls[f](CRC16_INIT, buf, 0));
+
+        // Every length and alignment against the original protocol loop
+        for (uint16_t len = 0; len <= 300; len++) {
+            for (size_t offset = 0; offset < 4; offset++) {
+                TEST_ASSERT_EQUAL_HEX16(calculate_checksum(buf + offset, len),
+                                        impls[f](CRC16_INIT, buf + offset, len));
+            }
+        }
+
+        // Incremental updates give the same result as one pass
+        uint16_t crc = CRC16_INIT;
+        crc = impls[f](crc, buf, 7);
+        crc = impls[f](crc, buf + 7, 50);
+        crc = impls[f](crc, buf + 57, 243);
+        TEST_ASSERT_EQUAL_HEX16(calculate_checksum(buf, 300), crc);
+    }
+}
+
+static double crc16_bench_ns_per_byte(crc16_fn_t fn, const uint8_t* data, size_t len, int reps) {
+    volatile uint16_t sink = 0;
+    clock_t start = clock();
+    for (int r = 0; r < reps; r++) {
+        sink ^= fn(CRC16_INIT, data, len);
+    }
+    (void)sink;
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ((double)reps * len);
+}
+
+void test_crc16_benchmark(void) {
+    static uint8_t buf[sizeof(protocol_message_t)];
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t)(i * 37u + 11u);
+    }
+    const int reps = 20000;
+    double ns_bit = crc16_bench_ns_per_byte(crc16_update_bitwise, buf, sizeof(buf), reps);
+    double ns_table = crc16_bench_ns_per_byte(crc16_update_table, buf, sizeof(buf), reps);
+    double ns_slice = crc16_bench_ns_per_byte(crc16_update_slice4, buf, sizeof(buf), reps);
+
+    // Host numbers only show relative cost; the table variants must not lose to the bit loop
+    printf("CRC16 over a %u-byte frame (host): bitwise %.2f ns/B, table %.2f ns/B (%.1fx), "
+           "slice-by-4 %.2f ns/B (%.1fx)\n", (unsigned)sizeof(buf), ns_bit,
+           ns_table, ns_bit / ns_table, ns_slice, ns_bit / ns_slice);
+    TEST_ASSERT_TRUE(ns_table < ns_bit);
+    TEST_ASSERT_TRUE(ns_slice < ns_bit);
+}
+
+// ============================================================================
+// Zero-Copy Frame View and Stream Parser Tests
+// ============================================================================
+
+/**
+ * @brief 스트림 테스트용 수신 기록
+ */
+typedef struct {
+    uint8_t seq[256];
+    uint32_t count;
+    const uint8_t* lo;  // input range used to tell in-place views from reassembled ones
+    const uint8_t* hi;
+    uint32_t in_place;
+} frame_log_t;
+
+static void log_frame(const protocol_frame_t* frame, void* ctx) {
+    frame_log_t* log = (frame_log_t*)ctx;
+    if (log->count < sizeof(log->seq)) {
+        log->seq[log->count] = protocol_frame_seq(frame);
+    }
+    log->count++;
+    if (frame->data >= log->lo && frame->data < log->hi) {
+        log->in_place++;
+    }
+}
+
+/**
+ * @brief 이동 명령과 상태 응답을 번갈아 이어 붙인 스트림 생성 (프레임 사이에 잡음 삽입 가능)
+ */
+static size_t build_frame_stream(uint8_t* out, size_t cap, int frames, bool noise, uint32_t* rng) {
+    size_t pos = 0;
+    for (int i = 0; i < frames; i++) {
+        protocol_message_t msg;
+        if (i % 2 == 0) {
+            build_move_command(&msg, 1, (int8_t)(i % 100), 50, CMD_FLAG_BALANCE, (uint8_t)i);
+        } else {
+            build_status_response(&msg, (float)i, 1.0f, 2, (uint8_t)i);
+        }
+        if (noise) {
+            *rng = *rng * 1664525u + 1013904223u;
+            int junk = (int)((*rng >> 24) % 5);
+            for (int j = 0; j < junk && pos < cap; j++) {
+                out[pos++] = (j == 0) ? PROTOCOL_START_MARKER : (uint8_t)(0x10 + j);  // false marker
+            }
+        }
+        int n = encode_message(&msg, out + pos, (int)(cap - pos));
+        TEST_ASSERT_TRUE(n > 0);
+        pos += (size_t)n;
+    }
+    return pos;
+}
+
+void test_protocol_frame_view_zero_copy(void) {
+    protocol_message_t msg;
+    uint8_t buffer[PROTOCOL_FRAME_MAX_SIZE + 4];
+    build_move_command(&msg, -1, 30, 80, CMD_FLAG_BALANCE | CMD_FLAG_STANDUP, 7);
+    int len = encode_message(&msg, buffer + 1, sizeof(buffer) - 1);  // odd address on purpose
+
+    protocol_frame_t frame;
+    TEST_ASSERT_EQUAL_INT(PROTOCOL_FRAME_OK, protocol_frame_view(buffer + 1, (size_t)len, &frame));
+    TEST_ASSERT_TRUE(frame.data == buffer + 1);
+    TEST_ASSERT_EQUAL_INT(len, frame.length);
+    TEST_ASSERT_EQUAL_UINT8(MSG_TYPE_MOVE_CMD, protocol_frame_type(&frame));
+    TEST_ASSERT_EQUAL_UINT8(7, protocol_frame_seq(&frame));
+
+    // Typed accessor points into the receive buffer
+    const move_command_payload_t* cmd = protocol_frame_move_cmd(&frame);
+    TEST_ASSERT_TRUE((const uint8_t*)cmd == buffer + 1 + PROTOCOL_HEADER_SIZE);
+    TEST_ASSERT_EQUAL_INT8(-1, cmd->direction);
+    TEST_ASSERT_EQUAL_INT8(30, cmd->turn);
+    TEST_ASSERT_EQUAL_UINT8(80, cmd->speed);
+    TEST_ASSERT_NULL(protocol_frame_status_resp(&frame));
+    TEST_ASSERT_NULL(protocol_frame_config(&frame));
+
+    // Every truncation is reported as incomplete, never as an error
+    for (int n = 0; n < len; n++) {
+        TEST_ASSERT_EQUAL_INT(PROTOCOL_FRAME_INCOMPLETE, protocol_frame_view(buffer + 1, (size_t)n, &frame));
+    }
+
+    buffer[1 + PROTOCOL_HEADER_SIZE + 2] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(PROTOCOL_FRAME_BAD_CHECKSUM, protocol_frame_view(buffer + 1, (size_t)len, &frame));
+    buffer[1 + PROTOCOL_HEADER_SIZE + 2] ^= 0x01;
+    buffer[2] = 0x02;
+    TEST_ASSERT_EQUAL_INT(PROTOCOL_FRAME_BAD_VERSION, protocol_frame_view(buffer + 1, 2, &frame));
+    buffer[2] = PROTOCOL_VERSION;
+    buffer[5] = MAX_PAYLOAD_SIZE + 1;
+    TEST_ASSERT_EQUAL_INT(PROTOCOL_FRAME_BAD_LENGTH, protocol_frame_view(buffer + 1, 6, &frame));
+    buffer[1] = 0x55;
+    TEST_ASSERT_EQUAL_INT(PROTOCOL_FRAME_BAD_MARKER, protocol_frame_view(buffer + 1, (size_t)len, &frame));
+}
+
+void test_protocol_stream_reassembles_and_resyncs(void) {
+    static uint8_t stream_bytes[4096];
+    uint32_t rng = 99u;
+    const int frames = 120;
+    size_t total = build_frame_stream(stream_bytes, sizeof(stream_bytes), frames, true, &rng);
+
+    // Corrupt one frame's payload: it must be dropped and the next frame recovered
+    protocol_frame_t frame;
+    size_t victim = 0;
+    for (size_t i = 0; i < total; i++) {
+        if (protocol_frame_view(stream_bytes + i, total - i, &frame) == PROTOCOL_FRAME_OK &&
+            protocol_frame_seq(&frame) == 50) {
+            victim = i;
+            break;
+        }
+    }
+    TEST_ASSERT_TRUE(victim > 0);
+    stream_bytes[victim + PROTOCOL_HEADER_SIZE] ^= 0x40;
+
+    // Chunk sizes from 1 byte up to larger than a frame (BLE MTU splits, UART reads)
+    const size_t chunk_sizes[] = {1, 3, 7, 20, 23, 64, 100, 4096};
+    for (size_t c = 0; c < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); c++) {
+        protocol_stream_t stream;
+        protocol_stream_init(&stream);
+        frame_log_t log = {.count = 0, .lo = stream_bytes, .hi = stream_bytes + total, .in_place = 0};
+        for (size_t pos = 0; pos < total; pos += chunk_sizes[c]) {
+            size_t n = (total - pos < chunk_sizes[c]) ? total - pos : chunk_sizes[c];
+            protocol_stream_feed(&stream, stream_bytes + pos, n, log_frame, &log);
+        }
+        TEST_ASSERT_EQUAL_UINT32(frames - 1, log.count);
+        TEST_ASSERT_EQUAL_UINT32(1, stream.checksum_errors);
+        TEST_ASSERT_EQUAL_UINT32(log.count, stream.frames);
+        TEST_ASSERT_EQUAL_UINT32(log.count - stream.reassembled, log.in_place);
+        for (uint32_t i = 0, expect = 0; i < log.count; i++, expect++) {
+            if (expect == 50) expect++;
+            TEST_ASSERT_EQUAL_UINT8((uint8_t)expect, log.seq[i]);
+        }
+        if (chunk_sizes[c] == 4096) {
+            TEST_ASSERT_EQUAL_UINT32(0, stream.reassembled);
+        }
+    }
+}
+
+void test_protocol_stream_fuzz_and_benchmark(void) {
+    // Fuzz: random bytes with a high density of start markers must never crash or overflow
+    static uint8_t junk[1 << 16];
+    uint32_t rng = 7u;
+    for (size_t i = 0; i < sizeof(junk); i++) {
+        rng = rng * 1664525u + 1013904223u;
+        uint8_t b = (uint8_t)(rng >> 24);
+        junk[i] = (b < 40) ? PROTOCOL_START_MARKER : ((b < 60) ? PROTOCOL_VERSION : b);
+    }
+    protocol_stream_t stream;
+    protocol_stream_init(&stream);
+    frame_log_t log = {.count = 0, .lo = junk, .hi = junk + sizeof(junk), .in_place = 0};
+    for (size_t pos = 0; pos < sizeof(junk); pos += 17) {
+        size_t n = (sizeof(junk) - pos < 17) ? sizeof(junk) - pos : 17;
+        protocol_stream_feed(&stream, junk + pos, n, log_frame, &log);
+        TEST_ASSERT_TRUE(stream.fill < PROTOCOL_FRAME_MAX_SIZE);
+    }
+    TEST_ASSERT_TRUE(stream.discarded_bytes > sizeof(junk) / 2);
+
+    // Valid frames still get through after the garbage
+    static uint8_t frames_bytes[1 << 16];
+    size_t total = build_frame_stream(frames_bytes, sizeof(frames_bytes), 1000, false, &rng);
+    log = (frame_log_t){.count = 0, .lo = frames_bytes, .hi = frames_bytes + total, .in_place = 0};
+    protocol_stream_feed(&stream, frames_bytes, total, log_frame, &log);
+    TEST_ASSERT_TRUE(log.count >= 999);
+
+    // Throughput: whole-buffer feed (all in place) vs 20-byte BLE writes (some reassembled)
+    const int reps = 50;
+    size_t chunks[2] = {total, 20};
+    double fps[2];
+    uint32_t copied[2];
+    for (int k = 0; k < 2; k++) {
+        log = (frame_log_t){.count = 0, .lo = frames_bytes, .hi = frames_bytes + total, .in_place = 0};
+        protocol_stream_init(&stream);
+        clock_t start = clock();
+        for (int r = 0; r < reps; r++) {
+            for (size_t pos = 0; pos < total; pos += chunks[k]) {
+                size_t n = (total - pos < chunks[k]) ? total - pos : chunks[k];
+                protocol_stream_feed(&stream, frames_bytes + pos, n, log_frame, &log);
+            }
+        }
+        double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+        TEST_ASSERT_EQUAL_UINT32(1000u * reps, log.count);
+        fps[k] = (secs > 0.0) ? log.count / secs : 0.0;
+        copied[k] = stream.reassembled;
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, copied[0]);
+    printf("Frame parser (host): %.0f frames/s in place (0 copies), %.0f frames/s over 20-byte writes "
+           "(%u of %u frames reassembled)\n", fps[0], fps[1], (unsigned)copied[1], 1000u * reps);
+}
+
+// ============================================================================
+// Telemetry Stream Tests
+// ============================================================================
+
+/**
+ * @brief 제어 주기 하나를 흉내 낸 텔레메트리 샘플 (10ms 간격)
+ */
+static telemetry_sample_t make_telemetry_sample(int i) {
+    float t = (float)i * 0.01f;
+    telemetry_sample_t s = {
+        .timestamp_us = 4294000000u + (uint32_t)i * 10000u,  // wraps mid-run
+        .angle = 3.0f * sinf(t * 6.0f),
+        .angle_rate = 110.0f * cosf(t * 6.0f),
+        .pid_p = -45.0f * sinf(t * 6.0f),
+        .pid_i = 0.5f + 0.01f * (float)i,
+        .pid_d = -0.8f * 110.0f * cosf(t * 6.0f),
+        .motor_left = (int16_t)(200.0f * sinf(t * 6.0f)),
+        .motor_right = (int16_t)(-200.0f * sinf(t * 6.0f)),
+        .encoder_left = (int32_t)((uint32_t)INT32_MAX - 500u + (uint32_t)i * 7u), // wraps mid-run
+        .encoder_right = -i * 7,
+        .x_cm = 0.35f * (float)i,
+        .y_cm = -120.0f + 40.0f * sinf(t),
+        .heading = 179.0f * sinf(t * 0.5f),
+    };
+    return s;
+}
+
+void test_telemetry_round_trip_and_mtu_packing(void) {
+    static telemetry_sample_t storage[256];
+    static telemetry_packer_t packer;
+    telemetry_ring_t ring;
+    telemetry_ring_init(&ring, storage, 256);
+
+    const int n = 200;
+    for (int i = 0; i < n; i++) {
+        telemetry_sample_t s = make_telemetry_sample(i);
+        TEST_ASSERT_TRUE(telemetry_ring_push(&ring, &s));
+    }
+
+    // MTU 185 (typical phone) → 182-byte notifications
+    const uint16_t capacity = 185 - 3;
+    telemetry_rx_t rx;
+    telemetry_rx_init(&rx);
+    telemetry_sample_t decoded[UINT8_MAX];
+    uint32_t bytes = 0, packets = 0;
+    int next = 0;
+    uint16_t length;
+    while ((length = telemetry_pack_from_ring(&packer, &ring, capacity, (uint16_t)packets)) > 0) {
+        TEST_ASSERT_TRUE(length <= capacity);
+        telemetry_packet_info_t info;
+        int count = telemetry_decode(packer.frame, length, &info, decoded, UINT8_MAX);
+        TEST_ASSERT_TRUE(count > 0);
+        telemetry_rx_track(&rx, &info);
+
+        for (int k = 0; k < count; k++, next++) {
+            telemetry_sample_t want = make_telemetry_sample(next);
+            TEST_ASSERT_EQUAL_UINT32((uint32_t)next, decoded[k].index);
+            TEST_ASSERT_EQUAL_UINT32(want.timestamp_us, decoded[k].timestamp_us);
+            TEST_ASSERT_FLOAT_WITHIN(0.5f / TELEMETRY_ANGLE_SCALE + 1e-4f, want.angle, decoded[k].angle);
+            TEST_ASSERT_FLOAT_WITHIN(0.5f / TELEMETRY_RATE_SCALE + 1e-3f, want.angle_rate, decoded[k].angle_rate);
+            TEST_ASSERT_FLOAT_WITHIN(0.5f / TELEMETRY_PID_SCALE + 1e-3f, want.pid_p, decoded[k].pid_p);
+            TEST_ASSERT_FLOAT_WITHIN(0.5f / TELEMETRY_PID_SCALE + 1e-3f, want.pid_i, decoded[k].pid_i);
+            TEST_ASSERT_FLOAT_WITHIN(0.5f / TELEMETRY_PID_SCALE + 1e-3f, want.pid_d, decoded[k].pid_d);
+            TEST_ASSERT_EQUAL_INT16(want.motor_left, decoded[k].motor_left);
+            TEST_ASSERT_EQUAL_INT16(want.motor_right, decoded[k].motor_right);
+            TEST_ASSERT_EQUAL_INT32(want.encoder_left, decoded[k].encoder_left);
+            TEST_ASSERT_EQUAL_INT32(want.encoder_right, decoded[k].encoder_right);
+            TEST_ASSERT_FLOAT_WITHIN(0.5f / TELEMETRY_POSITION_SCALE + 1e-3f, want.x_cm, decoded[k].x_cm);
+            TEST_ASSERT_FLOAT_WITHIN(0.5f / TELEMETRY_POSITION_SCALE + 1e-3f, want.y_cm, decoded[k].y_cm);
+            TEST_ASSERT_FLOAT_WITHIN(0.5f / TELEMETRY_ANGLE_SCALE + 1e-3f, want.heading, decoded[k].heading);
+        }
+        bytes += length;
+        packets++;
+    }
+    TEST_ASSERT_EQUAL_INT(n, next);
+    TEST_ASSERT_EQUAL_UINT32(0, rx.lost_packets);
+    TEST_ASSERT_EQUAL_UINT32(0, rx.lost_samples);
+
+    // Delta/varint packing: many samples per notification, far below the raw struct size
+    float per_packet = (float)n / (float)packets;
+    float per_sample = (float)bytes / (float)n;
+    TEST_ASSERT_TRUE(per_packet >= 8.0f);
+    TEST_ASSERT_TRUE(per_sample < 0.5f * (float)(sizeof(telemetry_sample_t) - sizeof(uint32_t)));
+    printf("Telemetry: %.1f samples/notification at MTU 185, %.1f bytes/sample on air (raw %u)\n",
+           per_packet, per_sample, (unsigned)(sizeof(telemetry_sample_t) - sizeof(uint32_t)));
+
+    // The default MTU (23) cannot carry a sample, so the task must not try
+    TEST_ASSERT_TRUE(23 - 3 < TELEMETRY_MIN_FRAME_SIZE);
+    TEST_ASSERT_TRUE(TELEMETRY_MIN_FRAME_SIZE <= TELEMETRY_MAX_FRAME_SIZE);
+}
+
+void test_telemetry_drop_detection(void) {
+    static telemetry_sample_t storage[8];
+    static telemetry_packer_t packer;
+    telemetry_ring_t ring;
+    telemetry_ring_init(&ring, storage, 8);
+    telemetry_rx_t rx;
+    telemetry_rx_init(&rx);
+    telemetry_sample_t decoded[UINT8_MAX];
+    telemetry_packet_info_t info;
+    uint16_t seq = 0, length;
+
+    // Ring overflow: samples 8..11 are dropped by the producer but consume indices
+    for (int i = 0; i < 12; i++) {
+        telemetry_sample_t s = make_telemetry_sample(i);
+        telemetry_ring_push(&ring, &s);
+    }
+    TEST_ASSERT_EQUAL_UINT32(4, atomic_load(&ring.dropped));
+    length = telemetry_pack_from_ring(&packer, &ring, TELEMETRY_MAX_FRAME_SIZE, seq++);
+    TEST_ASSERT_EQUAL_INT(8, telemetry_decode(packer.frame, length, &info, decoded, UINT8_MAX));
+    telemetry_rx_track(&rx, &info);
+
+    for (int i = 12; i < 16; i++) {
+        telemetry_sample_t s = make_telemetry_sample(i);
+        telemetry_ring_push(&ring, &s);
+    }
+    length = telemetry_pack_from_ring(&packer, &ring, TELEMETRY_MAX_FRAME_SIZE, seq++);
+    TEST_ASSERT_EQUAL_INT(4, telemetry_decode(packer.frame, length, &info, decoded, UINT8_MAX));
+    TEST_ASSERT_EQUAL_UINT32(12, info.first_index);
+    telemetry_rx_track(&rx, &info);
+    TEST_ASSERT_EQUAL_UINT32(0, rx.lost_packets);
+    TEST_ASSERT_EQUAL_UINT32(4, rx.lost_samples);
+
+    // Link loss: one packet never arrives; the next one still decodes on its own keyframe
+    for (int i = 16; i < 24; i++) {
+        telemetry_sample_t s = make_telemetry_sample(i);
+        telemetry_ring_push(&ring, &s);
+    }
+    length = telemetry_pack_from_ring(&packer, &ring, TELEMETRY_MIN_FRAME_SIZE + 20, seq++);
+    TEST_ASSERT_TRUE(length > 0);
+    TEST_ASSERT_TRUE(telemetry_ring_peek(&ring) != NULL);
+    length = telemetry_pack_from_ring(&packer, &ring, TELEMETRY_MAX_FRAME_SIZE, seq++);
+    int count = telemetry_decode(packer.frame, length, &info, decoded, UINT8_MAX);
+    TEST_ASSERT_TRUE(count > 0);
+    TEST_ASSERT_EQUAL_UINT32(23, decoded[count - 1].index);
+    telemetry_rx_track(&rx, &info);
+    TEST_ASSERT_EQUAL_UINT32(1, rx.lost_packets);
+    TEST_ASSERT_EQUAL_UINT32(4 + (8 - (uint32_t)count), rx.lost_samples);
+    TEST_ASSERT_NULL(telemetry_ring_peek(&ring));
+
+    // Corruption and truncation are rejected rather than decoded as garbage
+    packer.frame[length - 1] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(-1, telemetry_decode(packer.frame, length, &info, decoded, UINT8_MAX));
+    packer.frame[length - 1] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(-1, telemetry_decode(packer.frame, length - 1, &info, decoded, UINT8_MAX));
+    TEST_ASSERT_EQUAL_INT(-1, telemetry_decode(packer.frame, length, &info, decoded, 1));
+}
+
+static atomic_bool telemetry_producer_done;  ///< 생산자 스레드 종료 플래그
+
+/**
+ * @brief 생산자 스레드: 제어 태스크처럼 대기 없이 샘플을 밀어 넣음
+ */
+static void* telemetry_producer(void* arg) {
+    telemetry_ring_t* ring = (telemetry_ring_t*)arg;
+    for (int i = 0; i < 200000; i++) {
+        telemetry_sample_t s = make_telemetry_sample(i);
+        s.encoder_right = i;  // payload check: must match the assigned index
+        telemetry_ring_push(ring, &s);
+    }
+    atomic_store(&telemetry_producer_done, true);
+    return NULL;
+}
+
+void test_telemetry_ring_concurrent_producer_consumer(void) {
+    static telemetry_sample_t storage[64];
+    static telemetry_packer_t packer;
+    telemetry_ring_t ring;
+    telemetry_ring_init(&ring, storage, 64);
+    telemetry_rx_t rx;
+    telemetry_rx_init(&rx);
+    static telemetry_sample_t decoded[UINT8_MAX];
+
+    atomic_store(&telemetry_producer_done, false);
+    pthread_t producer;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL, telemetry_producer, &ring));
+
+    uint32_t received = 0;
+    uint16_t seq = 0;
+    bool done = false;
+    while (!done) {
+        done = atomic_load(&telemetry_producer_done);  // checked before draining so the tail is collected
+        uint16_t length;
+        while ((length = telemetry_pack_from_ring(&packer, &ring, TELEMETRY_MAX_FRAME_SIZE, seq)) > 0) {
+            seq++;
+            telemetry_packet_info_t info;
+            int count = telemetry_decode(packer.frame, length, &info, decoded, UINT8_MAX);
+            TEST_ASSERT_TRUE(count > 0);
+            for (int k = 0; k < count; k++) {
+                TEST_ASSERT_EQUAL_INT32((int32_t)decoded[k].index, decoded[k].encoder_right);
+            }
+            telemetry_rx_track(&rx, &info);
+            received += (uint32_t)count;
+        }
+    }
+    pthread_join(producer, NULL);
+    while (telemetry_ring_peek(&ring) != NULL) {
+        uint16_t length = telemetry_pack_from_ring(&packer, &ring, TELEMETRY_MAX_FRAME_SIZE, seq++);
+        telemetry_packet_info_t info;
+        int count = telemetry_decode(packer.frame, length, &info, decoded, UINT8_MAX);
+        telemetry_rx_track(&rx, &info);
+        received += (uint32_t)count;
+    }
+
+    // Every index is either delivered or accounted for as an overflow drop the client can see
+    // (drops after the last delivered sample only show up once the next packet arrives)
+    uint32_t dropped = atomic_load(&ring.dropped);
+    TEST_ASSERT_EQUAL_UINT32(200000u, received + dropped);
+    TEST_ASSERT_EQUAL_UINT32(dropped, rx.lost_samples + (200000u - rx.next_index));
+    TEST_ASSERT_EQUAL_UINT32(0, rx.lost_packets);
+}
+
+static remote_command_t make_remote_command(uint32_t n) {
+    remote_command_t cmd = {
+        .direction = (int)(n % 3) - 1,
+        .turn = (int)(n % 201) - 100,
+        .speed = (int)(n % 101),
+        .balance = (n & 1u) != 0,
+        .standup = (n & 2u) != 0,
+    };
+    return cmd;
+}
+
+void test_command_queue_orders_and_drops_stale(void) {
+    static command_queue_t queue;
+    command_queue_init(&queue, 200);
+    command_entry_t entry;
+    const int64_t t0 = 5000000;          // local clock (us)
+    const uint32_t phone = 1700000000u;  // sender clock (ms), unrelated to ours
+
+    TEST_ASSERT_FALSE(command_queue_pop(&queue, t0, &entry));
+
+    // First command defines the clock offset; later ones arrive in order
+    remote_command_t a = make_remote_command(1), b = make_remote_command(2), c = make_remote_command(3);
+    TEST_ASSERT_TRUE(command_queue_push(&queue, &a, 1, phone, t0));
+    TEST_ASSERT_TRUE(command_queue_push(&queue, &b, 2, phone + 20, t0 + 20000));
+    // Overtaken by b in the stack: older than what was already accepted
+    TEST_ASSERT_FALSE(command_queue_push(&queue, &c, 3, phone + 10, t0 + 21000));
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&queue.reordered));
+
+    TEST_ASSERT_TRUE(command_queue_pop(&queue, t0 + 22000, &entry));
+    TEST_ASSERT_EQUAL_INT(a.turn, entry.command.turn);
+    TEST_ASSERT_EQUAL_UINT32(phone, entry.sent_ms);
+    TEST_ASSERT_TRUE(command_queue_pop(&queue, t0 + 22000, &entry));
+    TEST_ASSERT_EQUAL_INT(b.turn, entry.command.turn);
+    TEST_ASSERT_EQUAL_UINT32(0, entry.transit_ms);
+    TEST_ASSERT_FALSE(command_queue_pop(&queue, t0 + 22000, &entry));
+
+    // Sent 40 ms after b but delivered 210 ms later: 170 ms in transit, then 60 ms
+    // waiting in the queue exceeds the 200 ms budget and it is never applied
+    TEST_ASSERT_TRUE(command_queue_push(&queue, &c, 4, phone + 60, t0 + 230000));
+    TEST_ASSERT_FALSE(command_queue_pop(&queue, t0 + 290000, &entry));
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&queue.stale));
+    // The same transit with a prompt consumer is still accepted
+    TEST_ASSERT_TRUE(command_queue_push(&queue, &a, 5, phone + 90, t0 + 240000));
+    TEST_ASSERT_TRUE(command_queue_pop(&queue, t0 + 241000, &entry));
+    TEST_ASSERT_EQUAL_UINT32(150, entry.transit_ms);
+
+    // Sender clock stepped back 1 h: one command is dropped, then the queue re-locks
+    TEST_ASSERT_FALSE(command_queue_push(&queue, &a, 6, phone - 3600000u, t0 + 300000));
+    TEST_ASSERT_TRUE(command_queue_push(&queue, &b, 7, phone - 3600000u + 10, t0 + 310000));
+    TEST_ASSERT_TRUE(command_queue_pop(&queue, t0 + 311000, &entry));
+    TEST_ASSERT_EQUAL_UINT32(0, entry.transit_ms);
+
+    // Unstamped commands skip the clock checks but still age out in the queue
+    TEST_ASSERT_TRUE(command_queue_push(&queue, &c, 8, 0, t0 + 400000));
+    TEST_ASSERT_FALSE(command_queue_pop(&queue, t0 + 700000, &entry));
+
+    // A stalled consumer makes the producer drop instead of overwrite
+    for (uint32_t i = 0; i < COMMAND_QUEUE_CAPACITY + 3; i++) {
+        remote_command_t cmd = make_remote_command(i);
+        command_queue_push(&queue, &cmd, (uint8_t)(9 + i), 0, t0 + 800000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, atomic_load(&queue.overflowed));
+    for (uint32_t i = 0; i < COMMAND_QUEUE_CAPACITY; i++) {
+        TEST_ASSERT_TRUE(command_queue_pop(&queue, t0 + 800000, &entry));
+        TEST_ASSERT_EQUAL_INT(make_remote_command(i).turn, entry.command.turn);
+    }
+    TEST_ASSERT_FALSE(command_queue_pop(&queue, t0 + 800000, &entry));
+}
+
+void test_command_queue_sequence_filter_and_latency_histogram(void) {
+    static command_queue_t queue;
+    command_queue_init(&queue, 200);
+    command_entry_t entry;
+    remote_command_t cmd = make_remote_command(7);
+
+    // Unstamped commands exercise the sequence filter alone
+    TEST_ASSERT_TRUE(command_queue_push(&queue, &cmd, 250, 0, 0));
+    TEST_ASSERT_FALSE(command_queue_push(&queue, &cmd, 250, 0, 1000));   // retransmitted write
+    TEST_ASSERT_TRUE(command_queue_push(&queue, &cmd, 3, 0, 2000));      // wraps 255 → 0, skips config frames
+    TEST_ASSERT_FALSE(command_queue_push(&queue, &cmd, 254, 0, 3000));   // late arrival from before the wrap
+    TEST_ASSERT_TRUE(command_queue_push(&queue, &cmd, 100, 0, 4000));    // gap from lost frames
+    TEST_ASSERT_TRUE(command_queue_push(&queue, &cmd, 20, 0, 5000));     // beyond the window = long gap, not a reorder
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&queue.duplicated));
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&queue.reordered));
+    TEST_ASSERT_EQUAL_UINT32(4, atomic_load(&queue.accepted));
+
+    // A new connection starts a new numbering
+    command_queue_resync(&queue);
+    TEST_ASSERT_TRUE(command_queue_push(&queue, &cmd, 19, 0, 6000));
+    while (command_queue_pop(&queue, 6000, NULL)) {}
+
+    // Latency = queue wait here: 3, 3, 3, 3, 3, 3, 3, 3, 30, 300 ms
+    command_queue_init(&queue, 200);
+    uint32_t waits_ms[10] = { 3, 3, 3, 3, 3, 3, 3, 3, 30, 300 };
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_TRUE(command_queue_push(&queue, &cmd, (uint8_t)(i + 1), 0, 0));
+        bool fresh = command_queue_pop(&queue, (int64_t)waits_ms[i] * 1000, &entry);
+        TEST_ASSERT_EQUAL(waits_ms[i] <= 200, fresh);
+    }
+    TEST_ASSERT_EQUAL_UINT32(8, atomic_load(&queue.latency_hist[0]));    // < 5 ms
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&queue.latency_hist[3]));    // 20..50 ms
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&queue.latency_hist[6]));    // 200..500 ms, also counted stale
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&queue.stale));
+    TEST_ASSERT_EQUAL_UINT32(300, atomic_load(&queue.latency_max_ms));
+    TEST_ASSERT_EQUAL_UINT32(5, command_queue_latency_percentile(&queue, 50));
+    TEST_ASSERT_EQUAL_UINT32(50, command_queue_latency_percentile(&queue, 90));
+    TEST_ASSERT_EQUAL_UINT32(500, command_queue_latency_percentile(&queue, 99));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, command_latency_bucket_limit_ms(COMMAND_LATENCY_BUCKETS - 1));
+}
+
+void test_command_watchdog_decays_stalled_motion(void) {
+    command_watchdog_t wd;
+    command_watchdog_init(&wd, 300, 500);
+    remote_command_t in = { .direction = 1, .turn = -80, .speed = 100, .balance = true, .standup = true };
+    remote_command_t out;
+
+    // Nothing received yet: no motion, balancing request still honoured
+    command_watchdog_apply(&wd, 0, &in, &out);
+    TEST_ASSERT_EQUAL_INT(0, out.speed);
+    TEST_ASSERT_EQUAL_INT(0, out.direction);
+    TEST_ASSERT_TRUE(out.balance);
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&wd.expirations));
+
+    // Fresh command passes through untouched until the timeout
+    command_watchdog_feed(&wd, 1000000);
+    command_watchdog_apply(&wd, 1300000, &in, &out);
+    TEST_ASSERT_EQUAL_INT(100, out.speed);
+    TEST_ASSERT_EQUAL_INT(-80, out.turn);
+    TEST_ASSERT_TRUE(out.standup);
+
+    // Link stalls: motion ramps down linearly instead of stepping to zero
+    command_watchdog_apply(&wd, 1550000, &in, &out);
+    TEST_ASSERT_EQUAL_INT(50, out.speed);
+    TEST_ASSERT_EQUAL_INT(-40, out.turn);
+    TEST_ASSERT_EQUAL_INT(1, out.direction);
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&wd.expirations));
+    int previous = out.speed;
+    for (int64_t t = 1560000; t <= 1800000; t += 2000) {
+        command_watchdog_apply(&wd, t, &in, &out);
+        TEST_ASSERT_TRUE(out.speed <= previous);
+        previous = out.speed;
+    }
+    TEST_ASSERT_EQUAL_INT(0, out.speed);
+    TEST_ASSERT_EQUAL_INT(0, out.turn);
+    TEST_ASSERT_EQUAL_INT(0, out.direction);
+    TEST_ASSERT_FALSE(out.standup);
+    TEST_ASSERT_TRUE(out.balance);
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&wd.expirations));  // one trip per stall
+
+    // Link recovers: the next command is applied at full strength at once
+    command_watchdog_feed(&wd, 5000000);
+    command_watchdog_apply(&wd, 5000000, &in, &out);
+    TEST_ASSERT_EQUAL_INT(100, out.speed);
+
+    // Zero decay means an immediate stop at the timeout
+    command_watchdog_init(&wd, 300, 0);
+    command_watchdog_feed(&wd, 0);
+    command_watchdog_apply(&wd, 300001, &in, &out);
+    TEST_ASSERT_EQUAL_INT(0, out.speed);
+}
+
+#define COMMAND_STRESS_COUNT 500000u    ///< 스트레스 테스트 명령 수
+
+/**
+ * @brief 생산자 스레드: BLE 콜백처럼 대기 없이 명령을 넣음
+ */
+static void* command_producer(void* arg) {
+    command_queue_t* queue = (command_queue_t*)arg;
+    for (uint32_t n = 1; n <= COMMAND_STRESS_COUNT; n++) {
+        remote_command_t cmd = make_remote_command(n);
+        command_queue_push(queue, &cmd, (uint8_t)n, n, (int64_t)n * 1000);
+    }
+    return NULL;
+}
+
+void test_command_queue_concurrent_producer_consumer(void) {
+    static command_queue_t queue;
+    command_queue_init(&queue, UINT32_MAX);
+
+    pthread_t producer;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL, command_producer, &queue));
+
+    // The control task's view: strictly increasing, never torn, never stale here
+    uint32_t consumed = 0, last = 0, torn = 0, out_of_order = 0;
+    command_entry_t entry;
+    while (last < COMMAND_STRESS_COUNT) {
+        if (!command_queue_pop(&queue, 0, &entry)) {
+            if (atomic_load(&queue.accepted) == consumed &&
+                atomic_load(&queue.accepted) + atomic_load(&queue.overflowed) == COMMAND_STRESS_COUNT) {
+                break;  // producer finished and the last command overflowed
+            }
+            continue;
+        }
+        remote_command_t expected = make_remote_command(entry.sent_ms);
+        if (expected.direction != entry.command.direction || expected.turn != entry.command.turn ||
+            expected.speed != entry.command.speed || expected.balance != entry.command.balance ||
+            expected.standup != entry.command.standup || entry.received_us != (int64_t)entry.sent_ms * 1000) {
+            torn++;
+        }
+        if (entry.sent_ms <= last) {
+            out_of_order++;
+        }
+        last = entry.sent_ms;
+        consumed++;
+    }
+    pthread_join(producer, NULL);
+    while (command_queue_pop(&queue, 0, &entry)) {
+        consumed++;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(0, out_of_order);
+    TEST_ASSERT_EQUAL_UINT32(atomic_load(&queue.accepted), consumed);
+    TEST_ASSERT_EQUAL_UINT32(COMMAND_STRESS_COUNT, consumed + atomic_load(&queue.overflowed));
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&queue.reordered));
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&queue.stale));
+}
+
+// ============================================================================
+// Parameter Registry Tests
+// ============================================================================
+
+static float read_param(param_registry_t* reg, uint8_t id) {
+    robot_params_t params;
+    param_registry_read(reg, &params);
+    return param_registry_value(&params, param_registry_find(id));
+}
+
+void test_param_registry_batch_is_all_or_nothing(void) {
+    param_registry_t reg;
+    param_registry_init(&reg);
+    robot_params_t params;
+    uint32_t version = param_registry_read(&reg, &params);
+    TEST_ASSERT_EQUAL_UINT32(1, version);
+    TEST_ASSERT_EQUAL_FLOAT(param_registry_find(PARAM_BALANCE_KP)->default_value, params.balance_kp);
+    TEST_ASSERT_EQUAL_FLOAT(param_registry_find(PARAM_VELOCITY_DIVIDER)->default_value, (float)params.velocity_divider);
+
+    // A valid batch lands as one new published set
+    param_update_t pid[] = { { PARAM_BALANCE_KP, 60.0f }, { PARAM_BALANCE_KI, 1.0f }, { PARAM_BALANCE_KD, 3.0f } };
+    TEST_ASSERT_EQUAL_INT(PARAM_OK, param_registry_set(&reg, pid, 3));
+    TEST_ASSERT_EQUAL_UINT32(version + 1, param_registry_read(&reg, &params));
+    TEST_ASSERT_EQUAL_FLOAT(60.0f, params.balance_kp);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, params.balance_ki);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, params.balance_kd);
+    version++;
+
+    // One bad entry rejects the whole batch and publishes nothing
+    param_update_t unknown[] = { { PARAM_BALANCE_KP, 70.0f }, { 0x7F, 1.0f } };
+    TEST_ASSERT_EQUAL_INT(PARAM_ERR_UNKNOWN_ID, param_registry_set(&reg, unknown, 2));
+    param_update_t out_of_range[] = { { PARAM_BALANCE_KP, 70.0f }, { PARAM_FALLEN_ANGLE, 120.0f } };
+    TEST_ASSERT_EQUAL_INT(PARAM_ERR_INVALID_VALUE, param_registry_set(&reg, out_of_range, 2));
+    param_update_t not_a_number[] = { { PARAM_KALMAN_Q_ANGLE, NAN } };
+    TEST_ASSERT_EQUAL_INT(PARAM_ERR_INVALID_VALUE, param_registry_set(&reg, not_a_number, 1));
+    param_update_t fractional[] = { { PARAM_VELOCITY_DIVIDER, 2.5f } };
+    TEST_ASSERT_EQUAL_INT(PARAM_ERR_INVALID_VALUE, param_registry_set(&reg, fractional, 1));
+    TEST_ASSERT_EQUAL_INT(PARAM_ERR_EMPTY, param_registry_set(&reg, NULL, 0));
+    TEST_ASSERT_EQUAL_UINT32(version, param_registry_read(&reg, &params));
+    TEST_ASSERT_EQUAL_FLOAT(60.0f, params.balance_kp);
+
+    // Integer parameters are stored as integers; a repeated id keeps the last value
+    param_update_t divider[] = { { PARAM_VELOCITY_DIVIDER, 4.0f }, { PARAM_VELOCITY_DIVIDER, 5.0f } };
+    TEST_ASSERT_EQUAL_INT(PARAM_OK, param_registry_set(&reg, divider, 2));
+    param_registry_read(&reg, &params);
+    TEST_ASSERT_EQUAL_UINT32(5, params.velocity_divider);
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, read_param(&reg, PARAM_VELOCITY_DIVIDER));
+}
+
+void test_param_registry_table_and_import(void) {
+    // Every entry has a unique id, a field inside the set and an in-range default
+    for (size_t i = 0; i < param_registry_count(); i++) {
+        const param_def_t* def = param_registry_def(i);
+        TEST_ASSERT_EQUAL_PTR(def, param_registry_find(def->id));
+        TEST_ASSERT_TRUE(def->offset + sizeof(float) <= sizeof(robot_params_t));
+        TEST_ASSERT_TRUE(def->default_value >= def->min && def->default_value <= def->max);
+    }
+    TEST_ASSERT_NULL(param_registry_def(param_registry_count()));
+
+    param_registry_t reg;
+    param_registry_init(&reg);
+    robot_params_t saved;
+    param_registry_read(&reg, &saved);
+
+    // A saved set with any field out of range is refused as a whole
+    saved.madgwick_beta = 0.2f;
+    saved.fallen_angle = 200.0f;
+    TEST_ASSERT_EQUAL_INT(PARAM_ERR_INVALID_VALUE, param_registry_import(&reg, &saved));
+    TEST_ASSERT_EQUAL_FLOAT(param_registry_find(PARAM_MADGWICK_BETA)->default_value, read_param(&reg, PARAM_MADGWICK_BETA));
+
+    saved.fallen_angle = 40.0f;
+    TEST_ASSERT_EQUAL_INT(PARAM_OK, param_registry_import(&reg, &saved));
+    TEST_ASSERT_EQUAL_FLOAT(0.2f, read_param(&reg, PARAM_MADGWICK_BETA));
+    TEST_ASSERT_EQUAL_FLOAT(40.0f, read_param(&reg, PARAM_FALLEN_ANGLE));
+}
+
+// ============================================================================
+// Parameter Store Tests
+// ============================================================================
+
+#define FAKE_FLASH_SECTOR 512
+
+// RAM flash with NOR semantics: erase sets 0xFF, programming can only clear bits
+typedef struct {
+    uint8_t mem[PARAM_STORE_SLOTS * FAKE_FLASH_SECTOR];
+    int write_budget;   // bytes programmed before power is lost (-1: unlimited)
+    int reads;
+} fake_flash_t;
+
+static esp_err_t fake_flash_read(void* ctx, uint32_t offset, void* data, size_t length) {
+    fake_flash_t* flash = (fake_flash_t*)ctx;
+    TEST_ASSERT_TRUE(offset + length <= sizeof(flash->mem));
+    memcpy(data, flash->mem + offset, length);
+    flash->reads++;
+    return ESP_OK;
+}
+
+static esp_err_t fake_flash_write(void* ctx, uint32_t offset, const void* data, size_t length) {
+    fake_flash_t* flash = (fake_flash_t*)ctx;
+    TEST_ASSERT_TRUE(offset + length <= sizeof(flash->mem));
+    for (size_t i = 0; i < length; i++) {
+        if (flash->write_budget == 0) {
+            return ESP_FAIL;
+        }
+        if (flash->write_budget > 0) {
+            flash->write_budget--;
+        }
+        flash->mem[offset + i] &= ((const uint8_t*)data)[i];
+    }
+    return ESP_OK;
+}
+
+static esp_err_t fake_flash_erase(void* ctx, uint32_t offset, size_t length) {
+    fake_flash_t* flash = (fake_flash_t*)ctx;
+    TEST_ASSERT_EQUAL_UINT32(0, offset % FAKE_FLASH_SECTOR);
+    TEST_ASSERT_EQUAL_UINT32(0, length % FAKE_FLASH_SECTOR);
+    TEST_ASSERT_TRUE(offset + length <= sizeof(flash->mem));
+    memset(flash->mem + offset, 0xFF, length);
+    return ESP_OK;
+}
+
+static const param_flash_ops_t fake_flash_ops = {
+    .read = fake_flash_read,
+    .write = fake_flash_write,
+    .erase = fake_flash_erase,
+};
+
+static void fake_flash_init(fake_flash_t* flash) {
+    memset(flash->mem, 0xFF, sizeof(flash->mem));
+    flash->write_budget = -1;
+    flash->reads = 0;
+}
+
+// Simulates a reboot: a fresh store instance over the same flash contents
+static esp_err_t reload_params(fake_flash_t* flash, robot_params_t* out, uint16_t* version) {
+    param_store_t store;
+    uint16_t length = 0;
+    param_store_init(&store, &fake_flash_ops, flash, FAKE_FLASH_SECTOR);
+    esp_err_t err = param_store_load(&store, out, sizeof(*out), &length, version);
+    if (err == ESP_OK) {
+        TEST_ASSERT_EQUAL_UINT16(sizeof(*out), length);
+    }
+    return err;
+}
+
+void test_param_store_alternates_slots_and_picks_newest(void) {
+    static fake_flash_t flash;
+    fake_flash_init(&flash);
+    param_store_t store;
+    param_store_init(&store, &fake_flash_ops, &flash, FAKE_FLASH_SECTOR);
+
+    // Blank flash holds nothing, and booting costs one read per slot
+    robot_params_t params;
+    uint16_t length = 0, version = 0;
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NOT_FOUND, param_store_load(&store, &params, sizeof(params), &length, &version));
+    TEST_ASSERT_EQUAL_INT(PARAM_STORE_SLOTS, flash.reads);
+
+    param_registry_t reg;
+    param_registry_init(&reg);
+    param_registry_read(&reg, &params);
+
+    // Saves alternate between the slots, each bumping the generation
+    for (int i = 1; i <= 3; i++) {
+        params.balance_kp = 10.0f * i;
+        TEST_ASSERT_EQUAL_INT(ESP_OK, param_store_save(&store, &params, sizeof(params), PARAM_SET_VERSION));
+        TEST_ASSERT_EQUAL_INT((i - 1) % 2, store.active_slot);
+        TEST_ASSERT_EQUAL_UINT32(i, store.generation);
+    }
+
+    // The newest generation wins even though the other slot is also valid
+    robot_params_t loaded;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, reload_params(&flash, &loaded, &version));
+    TEST_ASSERT_EQUAL_UINT16(PARAM_SET_VERSION, version);
+    TEST_ASSERT_EQUAL_FLOAT(30.0f, loaded.balance_kp);
+    TEST_ASSERT_EQUAL_INT(PARAM_OK, param_registry_import(&reg, &loaded));
+
+    // After a reload the next save goes to the older slot, not over the newest one
+    param_store_init(&store, &fake_flash_ops, &flash, FAKE_FLASH_SECTOR);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, param_store_load(&store, &loaded, sizeof(loaded), &length, &version));
+    TEST_ASSERT_EQUAL_INT(0, store.active_slot);
+    params.balance_kp = 40.0f;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, param_store_save(&store, &params, sizeof(params), PARAM_SET_VERSION));
+    TEST_ASSERT_EQUAL_INT(1, store.active_slot);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, reload_params(&flash, &loaded, &version));
+    TEST_ASSERT_EQUAL_FLOAT(40.0f, loaded.balance_kp);
+
+    // Oversized payloads are refused before anything is erased
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_SIZE, param_store_save(&store, flash.mem, PARAM_STORE_MAX_PAYLOAD + 1, 1));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, reload_params(&flash, &loaded, &version));
+    TEST_ASSERT_EQUAL_FLOAT(40.0f, loaded.balance_kp);
+}
+
+void test_param_store_survives_power_loss_and_corruption(void) {
+    static fake_flash_t flash;
+    fake_flash_init(&flash);
+    param_store_t store;
+    param_store_init(&store, &fake_flash_ops, &flash, FAKE_FLASH_SECTOR);
+
+    param_registry_t reg;
+    param_registry_init(&reg);
+    robot_params_t params, loaded;
+    uint16_t version = 0;
+    param_registry_read(&reg, &params);
+    params.balance_kp = 11.0f;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, param_store_save(&store, &params, sizeof(params), PARAM_SET_VERSION));
+
+    // Power lost at every point of the next save: the previous set always survives
+    size_t blob_size = sizeof(param_store_header_t) + sizeof(params);
+    params.balance_kp = 22.0f;
+    for (size_t cut = 0; cut < blob_size; cut++) {
+        flash.write_budget = (int)cut;
+        TEST_ASSERT_TRUE(param_store_save(&store, &params, sizeof(params), PARAM_SET_VERSION) != ESP_OK);
+        TEST_ASSERT_EQUAL_INT(ESP_OK, reload_params(&flash, &loaded, &version));
+        TEST_ASSERT_EQUAL_FLOAT(11.0f, loaded.balance_kp);
+    }
+    TEST_ASSERT_EQUAL_INT(0, store.active_slot);
+    flash.write_budget = -1;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, param_store_save(&store, &params, sizeof(params), PARAM_SET_VERSION));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, reload_params(&flash, &loaded, &version));
+    TEST_ASSERT_EQUAL_FLOAT(22.0f, loaded.balance_kp);
+
+    // A flipped bit in the newest slot fails its CRC and the older slot takes over
+    flash.mem[FAKE_FLASH_SECTOR + sizeof(param_store_header_t) + 2] ^= 0x10;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, reload_params(&flash, &loaded, &version));
+    TEST_ASSERT_EQUAL_FLOAT(11.0f, loaded.balance_kp);
+
+    // A corrupted header is rejected the same way; with both slots bad nothing loads
+    flash.mem[0] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NOT_FOUND, reload_params(&flash, &loaded, &version));
+
+    // Generations compare modularly across the 32-bit wrap
+    fake_flash_init(&flash);
+    param_store_init(&store, &fake_flash_ops, &flash, FAKE_FLASH_SECTOR);
+    store.generation = UINT32_MAX - 1;
+    params.balance_kp = 33.0f;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, param_store_save(&store, &params, sizeof(params), PARAM_SET_VERSION));
+    params.balance_kp = 44.0f;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, param_store_save(&store, &params, sizeof(params), PARAM_SET_VERSION));
+    TEST_ASSERT_EQUAL_UINT32(0, store.generation);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, reload_params(&flash, &loaded, &version));
+    TEST_ASSERT_EQUAL_FLOAT(44.0f, loaded.balance_kp);
+}
+
 // ============================================================================
 // REAL BLE Controller Logic Tests
 // ============================================================================
@@ -561,6 +1595,135 @@ void test_ble_oversized_command_handling(void) {
     TEST_ASSERT_FALSE(result); // Should reject oversized commands
 }
 
+/**
+ * @brief 모의 GAP 계층: 요청을 기록하고 미리 정한 결과를 반환
+ */
+typedef struct {
+    ble_conn_params_t requests[4];  ///< 받은 연결 파라미터 요청
+    int request_count;              ///< 연결 파라미터 요청 수
+    uint16_t data_length;           ///< 요청된 데이터 길이 (0: 요청 없음)
+    int phy_requests;               ///< 2M PHY 요청 수
+    esp_err_t update_result;        ///< 연결 파라미터 요청 호출 반환값
+} mock_gap_t;
+
+static esp_err_t mock_gap_update_conn_params(void* ctx, const ble_conn_params_t* params) {
+    mock_gap_t* gap = (mock_gap_t*)ctx;
+    if (gap->request_count < 4) gap->requests[gap->request_count] = *params;
+    gap->request_count++;
+    return gap->update_result;
+}
+
+static esp_err_t mock_gap_set_data_length(void* ctx, uint16_t tx_octets) {
+    ((mock_gap_t*)ctx)->data_length = tx_octets;
+    return ESP_OK;
+}
+
+static esp_err_t mock_gap_set_preferred_phy_2m(void* ctx) {
+    ((mock_gap_t*)ctx)->phy_requests++;
+    return ESP_OK;
+}
+
+static const ble_gap_ops_t mock_gap_ops = {
+    .update_conn_params = mock_gap_update_conn_params,
+    .set_data_length = mock_gap_set_data_length,
+    .set_preferred_phy_2m = mock_gap_set_preferred_phy_2m,
+};
+
+/// 7.5~15ms 요청, 거부 시 15~30ms 폴백 (config.h 기본값과 동일)
+static const ble_link_config_t mock_link_config = {
+    .preferred = {.min_interval = 6, .max_interval = 12, .latency = 0, .timeout = 400},
+    .fallback = {.min_interval = 12, .max_interval = 24, .latency = 0, .timeout = 400},
+    .data_length = 251,
+    .prefer_2m_phy = true,
+};
+
+void test_ble_link_negotiates_fast_interval_and_mtu(void) {
+    mock_gap_t gap = {.update_result = ESP_OK};
+    ble_link_t link;
+    ble_link_init(&link, &mock_link_config, &mock_gap_ops, &gap);
+    TEST_ASSERT_EQUAL_UINT16(BLE_LINK_DEFAULT_MTU, link.info.mtu);
+
+    // Phone connects at its default 45 ms interval
+    ble_link_on_connect(&link, 36, 0, 500);
+    TEST_ASSERT_EQUAL_INT(BLE_LINK_NEGOTIATING, link.state);
+    TEST_ASSERT_EQUAL_INT(1, gap.request_count);
+    TEST_ASSERT_EQUAL_UINT16(6, gap.requests[0].min_interval);
+    TEST_ASSERT_EQUAL_UINT16(12, gap.requests[0].max_interval);
+    TEST_ASSERT_EQUAL_UINT16(251, gap.data_length);
+    TEST_ASSERT_EQUAL_INT(1, gap.phy_requests);
+    TEST_ASSERT_EQUAL_UINT16(36, link.info.conn_interval);
+
+    // Client-initiated MTU exchange and controller DLE complete in any order
+    ble_link_on_mtu(&link, 247);
+    ble_link_on_data_length(&link, true, 251);
+    ble_link_on_conn_params(&link, true, 12, 0, 400);
+    TEST_ASSERT_EQUAL_INT(BLE_LINK_READY, link.state);
+    TEST_ASSERT_EQUAL_UINT16(247, link.info.mtu);
+    TEST_ASSERT_EQUAL_UINT16(251, link.info.tx_data_length);
+    TEST_ASSERT_EQUAL_UINT32(15000, ble_link_interval_us(&link.info));
+    TEST_ASSERT_EQUAL_UINT32(0, link.rejected);
+
+    // Later central-initiated updates are recorded but not fought
+    ble_link_on_conn_params(&link, true, 24, 0, 400);
+    TEST_ASSERT_EQUAL_INT(1, gap.request_count);
+    TEST_ASSERT_EQUAL_UINT16(24, link.info.conn_interval);
+
+    // Disconnect restores the defaults; a fast reconnect needs no request at all
+    ble_link_on_disconnect(&link);
+    TEST_ASSERT_EQUAL_INT(BLE_LINK_DISCONNECTED, link.state);
+    TEST_ASSERT_EQUAL_UINT16(BLE_LINK_DEFAULT_MTU, link.info.mtu);
+    TEST_ASSERT_EQUAL_UINT16(BLE_LINK_DEFAULT_DATA_LENGTH, link.info.tx_data_length);
+    ble_link_on_conn_params(&link, true, 6, 0, 400);  // stale event after disconnect
+    TEST_ASSERT_EQUAL_UINT16(0, link.info.conn_interval);
+    ble_link_on_connect(&link, 12, 0, 400);
+    TEST_ASSERT_EQUAL_INT(BLE_LINK_READY, link.state);
+    TEST_ASSERT_EQUAL_INT(1, gap.request_count);
+}
+
+void test_ble_link_falls_back_when_rejected(void) {
+    mock_gap_t gap = {.update_result = ESP_OK};
+    ble_link_t link;
+    ble_link_init(&link, &mock_link_config, &mock_gap_ops, &gap);
+
+    // Central rejects 7.5-15 ms → relaxed 15-30 ms request → accepted at 30 ms
+    ble_link_on_connect(&link, 36, 0, 500);
+    ble_link_on_conn_params(&link, false, 0, 0, 0);
+    TEST_ASSERT_EQUAL_INT(BLE_LINK_NEGOTIATING, link.state);
+    TEST_ASSERT_EQUAL_INT(2, gap.request_count);
+    TEST_ASSERT_EQUAL_UINT16(12, gap.requests[1].min_interval);
+    TEST_ASSERT_EQUAL_UINT16(24, gap.requests[1].max_interval);
+    TEST_ASSERT_EQUAL_UINT16(36, link.info.conn_interval);  // failed update keeps the old value
+    ble_link_on_conn_params(&link, true, 24, 0, 400);
+    TEST_ASSERT_EQUAL_INT(BLE_LINK_READY, link.state);
+    TEST_ASSERT_EQUAL_UINT16(24, link.info.conn_interval);
+    TEST_ASSERT_EQUAL_UINT32(1, link.rejected);
+
+    // Central "accepts" but picks a slower interval twice → settle on what it gave, no loop
+    ble_link_on_disconnect(&link);
+    gap.request_count = 0;
+    ble_link_on_connect(&link, 36, 0, 500);
+    ble_link_on_conn_params(&link, true, 24, 0, 400);   // above the 15 ms target
+    TEST_ASSERT_EQUAL_INT(2, gap.request_count);
+    ble_link_on_conn_params(&link, true, 36, 0, 400);   // above the 30 ms fallback too
+    TEST_ASSERT_EQUAL_INT(BLE_LINK_READY, link.state);
+    TEST_ASSERT_EQUAL_INT(2, gap.request_count);
+    TEST_ASSERT_EQUAL_UINT16(36, link.info.conn_interval);
+    TEST_ASSERT_EQUAL_UINT32(3, link.rejected);
+
+    // GAP call itself fails (e.g. controller busy) → both attempts consumed immediately
+    ble_link_on_disconnect(&link);
+    gap.request_count = 0;
+    gap.update_result = ESP_FAIL;
+    ble_link_on_connect(&link, 36, 0, 500);
+    TEST_ASSERT_EQUAL_INT(BLE_LINK_READY, link.state);
+    TEST_ASSERT_EQUAL_INT(2, gap.request_count);
+    TEST_ASSERT_EQUAL_UINT16(36, link.info.conn_interval);
+
+    // DLE refused: default 27-octet PDUs stay in effect
+    ble_link_on_data_length(&link, false, 251);
+    TEST_ASSERT_EQUAL_UINT16(BLE_LINK_DEFAULT_DATA_LENGTH, link.info.tx_data_length);
+}
+
 // ============================================================================
 // REAL Communication Integration Tests
 // ============================================================================
@@ -1178,25 +2341,2045 @@ void test_message_buffer_overflow_protection(void) {
     }
 }
 
-int main(void) {
-    UNITY_BEGIN();
-    
-    // PID Controller Core Logic Tests
-    RUN_TEST(test_pid_proportional_response_accuracy);
-    RUN_TEST(test_pid_integral_windup_protection);
-    RUN_TEST(test_pid_derivative_response);
-    RUN_TEST(test_pid_combined_response);
-    
-    // Kalman Filter Core Logic Tests  
-    RUN_TEST(test_kalman_noise_reduction_effectiveness);
-    RUN_TEST(test_kalman_tracking_performance);
-    
-    // Balance Control Core Logic Tests
-    RUN_TEST(test_balance_safety_fallen_robot);
-    RUN_TEST(test_balance_corrective_action);
-    RUN_TEST(test_balance_velocity_control_integration);
-    
-    // System Integration Logic Tests
+// ============================================================================
+// REAL Control Scheduler Timing Tests
+// ============================================================================
+
+void test_control_scheduler_absolute_wakeup_no_drift(void) {
+    control_scheduler_t sched;
+    control_scheduler_fake_clock_set(0);
+    control_scheduler_fake_set_wakeup_latency(0);
+    control_scheduler_init(&sched, 20000, 100000);
+
+    // Loop body execution time varies from 1 ms to 15 ms
+    for (int cycle = 0; cycle < 500; cycle++) {
+        float dt = control_scheduler_wait_next(&sched);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.02f, dt);
+        control_scheduler_fake_clock_advance(1000 + (cycle * 7919) % 14000);
+    }
+
+    // Wakeups stay phase-locked: no accumulated drift after 500 cycles
+    control_scheduler_wait_next(&sched);
+    TEST_ASSERT_EQUAL_INT64(501LL * 20000LL, control_scheduler_now_us());
+
+    control_scheduler_stats_t stats;
+    control_scheduler_get_stats(&sched, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.max_jitter_us);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.overrun_count);
+}
+
+void test_control_scheduler_bounded_jitter(void) {
+    control_scheduler_t sched;
+    control_scheduler_fake_clock_set(0);
+    control_scheduler_init(&sched, 20000, 100000);
+
+    // Inject up to 800 us of wakeup latency (e.g. BLE/status task preemption)
+    for (int cycle = 0; cycle < 1000; cycle++) {
+        control_scheduler_fake_set_wakeup_latency((uint32_t)((cycle * 2654435761u) % 801u));
+        float dt = control_scheduler_wait_next(&sched);
+        TEST_ASSERT_TRUE(dt >= 0.0192f && dt <= 0.0208f);
+        control_scheduler_fake_clock_advance(5000);
+    }
+    control_scheduler_fake_set_wakeup_latency(0);
+
+    control_scheduler_stats_t stats;
+    control_scheduler_get_stats(&sched, &stats);
+    TEST_ASSERT_TRUE(stats.max_jitter_us <= 800);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.overrun_count);
+
+    // Latency does not accumulate into the phase (last wakeup + latency + body)
+    TEST_ASSERT_TRUE(control_scheduler_now_us() <= 1000LL * 20000LL + 800 + 5000);
+}
+
+void test_control_scheduler_overrun_resync(void) {
+    control_scheduler_t sched;
+    control_scheduler_fake_clock_set(0);
+    control_scheduler_fake_set_wakeup_latency(0);
+    control_scheduler_init(&sched, 20000, 100000);
+
+    control_scheduler_wait_next(&sched);
+    control_scheduler_fake_clock_advance(250000); // stalled cycle (250 ms)
+
+    // Measured dt is clamped so the filter does not integrate a huge step
+    float dt = control_scheduler_wait_next(&sched);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.1f, dt);
+
+    // Next cycle resumes at the nominal period without a catch-up burst
+    dt = control_scheduler_wait_next(&sched);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.02f, dt);
+
+    control_scheduler_stats_t stats;
+    control_scheduler_get_stats(&sched, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.overrun_count);
+    TEST_ASSERT_EQUAL_UINT32(250000, stats.max_period_us);
+}
+
+void test_control_scheduler_cycle_budget_1khz(void) {
+    control_scheduler_t sched;
+    control_scheduler_fake_clock_set(0);
+    control_scheduler_fake_set_wakeup_latency(0);
+    control_scheduler_init(&sched, 1000, 100000);
+
+    // Fused sensor+control body takes 300..700 us at 1 kHz
+    for (int cycle = 0; cycle < 1000; cycle++) {
+        float dt = control_scheduler_wait_next(&sched);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.001f, dt);
+        control_scheduler_fake_clock_advance(300 + (cycle * 37) % 401);
+        control_scheduler_end_cycle(&sched);
+    }
+
+    control_scheduler_stats_t stats;
+    control_scheduler_get_stats(&sched, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1000, stats.busy_count);
+    TEST_ASSERT_EQUAL_UINT32(700, stats.max_busy_us);
+    TEST_ASSERT_TRUE(control_scheduler_mean_busy_us(&stats) >= 300);
+    TEST_ASSERT_TRUE(control_scheduler_mean_busy_us(&stats) <= 700);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.budget_overrun_count);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.overrun_count);
+}
+
+void test_control_scheduler_budget_overrun_and_deferred_reset(void) {
+    control_scheduler_t sched;
+    control_scheduler_fake_clock_set(0);
+    control_scheduler_fake_set_wakeup_latency(0);
+    control_scheduler_init(&sched, 2000, 100000);
+
+    control_scheduler_wait_next(&sched);
+    control_scheduler_fake_clock_advance(2500); // body exceeds the 500 Hz period
+    TEST_ASSERT_EQUAL_UINT32(2500, control_scheduler_end_cycle(&sched));
+
+    control_scheduler_stats_t stats;
+    control_scheduler_get_stats(&sched, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.budget_overrun_count);
+    TEST_ASSERT_EQUAL_UINT32(2500, stats.max_busy_us);
+
+    // Reset requested from another task is applied at the next cycle start
+    control_scheduler_reset_stats(&sched);
+    control_scheduler_get_stats(&sched, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.budget_overrun_count);
+
+    control_scheduler_wait_next(&sched);
+    control_scheduler_fake_clock_advance(400);
+    control_scheduler_end_cycle(&sched);
+    control_scheduler_get_stats(&sched, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.budget_overrun_count);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.busy_count);
+    TEST_ASSERT_EQUAL_UINT32(400, stats.max_busy_us);
+
+    // The closed window keeps what the reader had not seen yet
+    control_scheduler_stats_t window;
+    TEST_ASSERT_EQUAL_UINT32(1, control_scheduler_get_window(&sched, &window));
+    TEST_ASSERT_EQUAL_UINT32(1, window.budget_overrun_count);
+    TEST_ASSERT_EQUAL_UINT32(2500, window.max_busy_us);
+}
+
+void test_control_scheduler_window_keeps_overrun_at_reset(void) {
+    control_scheduler_t sched;
+    control_scheduler_fake_clock_set(0);
+    control_scheduler_fake_set_wakeup_latency(0);
+    control_scheduler_init(&sched, 2000, 100000);
+    control_scheduler_stats_t window;
+    TEST_ASSERT_EQUAL_UINT32(0, control_scheduler_get_window(&sched, &window));
+
+    for (int cycle = 0; cycle < 10; cycle++) {
+        control_scheduler_wait_next(&sched);
+        control_scheduler_fake_clock_advance(500);
+        control_scheduler_end_cycle(&sched);
+    }
+
+    // The status task reads, then requests the close; a 3 ms body slips in between and
+    // the next wake-up misses its deadline in the very cycle that applies the close
+    control_scheduler_reset_stats(&sched);
+    control_scheduler_fake_clock_advance(3000);
+    control_scheduler_end_cycle(&sched);
+    control_scheduler_wait_next(&sched);
+    control_scheduler_fake_clock_advance(500);
+    control_scheduler_end_cycle(&sched);
+
+    TEST_ASSERT_EQUAL_UINT32(1, control_scheduler_get_window(&sched, &window));
+    TEST_ASSERT_EQUAL_UINT32(11, window.busy_count);
+    TEST_ASSERT_EQUAL_UINT32(3500, window.max_busy_us);
+    TEST_ASSERT_EQUAL_UINT32(1, window.budget_overrun_count);
+    TEST_ASSERT_EQUAL_UINT32(0, window.overrun_count);
+
+    control_scheduler_stats_t stats;
+    control_scheduler_get_stats(&sched, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.overrun_count);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.busy_count);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.budget_overrun_count);
+
+    // Windows close back to back: every cycle is reported exactly once
+    control_scheduler_reset_stats(&sched);
+    control_scheduler_wait_next(&sched);
+    TEST_ASSERT_EQUAL_UINT32(2, control_scheduler_get_window(&sched, &window));
+    TEST_ASSERT_EQUAL_UINT32(1, window.overrun_count);
+    TEST_ASSERT_EQUAL_UINT32(1, window.busy_count);
+}
+
+#define SCHED_STRESS_CYCLES 200000
+
+static control_scheduler_t sched_stress;
+static volatile int sched_writer_done;
+
+static void* sched_writer_thread(void* arg) {
+    (void)arg;
+    // Control task: every cycle is 1000 us with a 300 us body
+    for (int64_t n = 1; n <= SCHED_STRESS_CYCLES; n++) {
+        control_scheduler_mark_cycle(&sched_stress, n * 1000);
+        control_scheduler_fake_clock_set(n * 1000 + 300);
+        control_scheduler_end_cycle(&sched_stress);
+    }
+    __atomic_store_n(&sched_writer_done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void* sched_reader_thread(void* arg) {
+    uint32_t* inconsistent = (uint32_t*)arg;
+    uint32_t last_cycles = 0;
+    // Status task on the other core
+    while (!__atomic_load_n(&sched_writer_done, __ATOMIC_ACQUIRE)) {
+        control_scheduler_stats_t stats;
+        control_scheduler_get_stats(&sched_stress, &stats);
+        bool ok = stats.total_busy_us == (uint64_t)stats.busy_count * 300 &&
+                  stats.busy_count - stats.cycle_count <= 1 &&
+                  stats.cycle_count >= last_cycles &&
+                  (stats.cycle_count == 0 || stats.max_period_us == 1000);
+        if (!ok) {
+            (*inconsistent)++;
+        }
+        last_cycles = stats.cycle_count;
+    }
+    return NULL;
+}
+
+void test_control_scheduler_stats_read_from_other_task(void) {
+    control_scheduler_fake_clock_set(0);
+    control_scheduler_init(&sched_stress, 1000, 100000);
+    sched_writer_done = 0;
+
+    uint32_t inconsistent = 0;
+    pthread_t writer, reader;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&reader, NULL, sched_reader_thread, &inconsistent));
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&writer, NULL, sched_writer_thread, NULL));
+    pthread_join(writer, NULL);
+    pthread_join(reader, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, inconsistent);
+
+    control_scheduler_stats_t stats;
+    control_scheduler_get_stats(&sched_stress, &stats);
+    TEST_ASSERT_EQUAL_UINT32(SCHED_STRESS_CYCLES - 1, stats.cycle_count);
+    TEST_ASSERT_EQUAL_UINT32(SCHED_STRESS_CYCLES, stats.busy_count);
+}
+
+// ============================================================================
+// REAL State Snapshot Tests
+// ============================================================================
+
+#define SNAPSHOT_STRESS_PUBLISHES 200000
+#define SNAPSHOT_STRESS_READERS   3
+
+// Robot state followed by a wide tail so a copy spans many cache lines and
+// a missing retry would actually be observed under contention
+typedef struct {
+    robot_state_snapshot_t state;
+    uint32_t tail[256];
+} stress_payload_t;
+
+static state_snapshot_t stress_snapshot;
+static uint8_t stress_buffer[STATE_SNAPSHOT_BUFFER_SIZE(sizeof(stress_payload_t))];
+static volatile int stress_writer_done;
+
+typedef struct {
+    uint32_t reads;
+    uint32_t torn;
+    uint32_t non_monotonic;
+} snapshot_reader_result_t;
+
+// Every field is derived from the same counter so a mixed copy is detectable
+static void fill_stress_snapshot(robot_state_snapshot_t* snap, uint32_t n) {
+    uint32_t k = n & 0xFFFFF; // exact in float
+    snap->timestamp_us = (int64_t)n;
+    snap->angle = (float)k;
+    snap->angle_rate = -(float)k;
+    snap->velocity = (float)k * 0.5f;
+    snap->left_speed = (float)k + 1.0f;
+    snap->right_speed = (float)k + 2.0f;
+    snap->state = (uint8_t)(n & 0xFF);
+}
+
+static bool stress_snapshot_consistent(const robot_state_snapshot_t* snap) {
+    robot_state_snapshot_t expected;
+    fill_stress_snapshot(&expected, (uint32_t)snap->timestamp_us);
+    return snap->angle == expected.angle && snap->angle_rate == expected.angle_rate &&
+           snap->velocity == expected.velocity && snap->left_speed == expected.left_speed &&
+           snap->right_speed == expected.right_speed && snap->state == expected.state;
+}
+
+static void* snapshot_writer_thread(void* arg) {
+    (void)arg;
+    static stress_payload_t payload;
+    memset(&payload, 0, sizeof(payload));
+    for (uint32_t n = 1; n <= SNAPSHOT_STRESS_PUBLISHES; n++) {
+        fill_stress_snapshot(&payload.state, n);
+        for (int i = 0; i < 256; i++) {
+            payload.tail[i] = n;
+        }
+        state_snapshot_publish(&stress_snapshot, &payload);
+    }
+    __atomic_store_n(&stress_writer_done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void* snapshot_reader_thread(void* arg) {
+    snapshot_reader_result_t* result = (snapshot_reader_result_t*)arg;
+    int64_t last_timestamp = 0;
+    int done = 0;
+    while (!done) {
+        done = __atomic_load_n(&stress_writer_done, __ATOMIC_ACQUIRE);
+        stress_payload_t payload;
+        if (state_snapshot_read(&stress_snapshot, &payload) == 0) {
+            continue; // nothing published yet
+        }
+        result->reads++;
+        bool consistent = stress_snapshot_consistent(&payload.state);
+        for (int i = 0; i < 256 && consistent; i++) {
+            consistent = (payload.tail[i] == (uint32_t)payload.state.timestamp_us);
+        }
+        if (!consistent) {
+            result->torn++;
+        }
+        if (payload.state.timestamp_us < last_timestamp) {
+            result->non_monotonic++;
+        }
+        last_timestamp = payload.state.timestamp_us;
+    }
+    return NULL;
+}
+
+void test_state_snapshot_read_before_publish(void) {
+    state_snapshot_t snap;
+    uint8_t buffer[STATE_SNAPSHOT_BUFFER_SIZE(sizeof(robot_state_snapshot_t))];
+    state_snapshot_init(&snap, buffer, sizeof(robot_state_snapshot_t));
+
+    robot_state_snapshot_t out;
+    memset(&out, 0x5A, sizeof(out));
+    TEST_ASSERT_EQUAL_UINT32(0, state_snapshot_read(&snap, &out));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, out.angle);
+    TEST_ASSERT_EQUAL_INT64(0, out.timestamp_us);
+}
+
+void test_state_snapshot_returns_latest(void) {
+    state_snapshot_t snap;
+    uint8_t buffer[STATE_SNAPSHOT_BUFFER_SIZE(sizeof(robot_state_snapshot_t))];
+    state_snapshot_init(&snap, buffer, sizeof(robot_state_snapshot_t));
+
+    robot_state_snapshot_t in, out;
+    for (uint32_t n = 1; n <= 5; n++) {
+        fill_stress_snapshot(&in, n);
+        state_snapshot_publish(&snap, &in);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(5, state_snapshot_read(&snap, &out));
+    TEST_ASSERT_EQUAL_INT64(5, out.timestamp_us);
+    TEST_ASSERT_TRUE(stress_snapshot_consistent(&out));
+}
+
+void test_state_snapshot_inflight_write_does_not_block_reader(void) {
+    state_snapshot_t snap;
+    uint8_t buffer[STATE_SNAPSHOT_BUFFER_SIZE(sizeof(robot_state_snapshot_t))];
+    state_snapshot_init(&snap, buffer, sizeof(robot_state_snapshot_t));
+
+    robot_state_snapshot_t in, out;
+    fill_stress_snapshot(&in, 7);
+    state_snapshot_publish(&snap, &in);
+
+    // Writer preempted half way through the next publish: inactive slot is
+    // marked busy and partially overwritten
+    uint32_t busy = (atomic_load(&snap.latest) & 1u) ^ 1u;
+    atomic_store(&snap.seq[busy], atomic_load(&snap.seq[busy]) + 1);
+    memset(snap.slot[busy], 0xFF, sizeof(robot_state_snapshot_t) / 2);
+
+    TEST_ASSERT_EQUAL_UINT32(1, state_snapshot_read(&snap, &out));
+    TEST_ASSERT_EQUAL_INT64(7, out.timestamp_us);
+    TEST_ASSERT_TRUE(stress_snapshot_consistent(&out));
+}
+
+void test_state_snapshot_concurrent_no_torn_reads(void) {
+    state_snapshot_init(&stress_snapshot, stress_buffer, sizeof(stress_payload_t));
+    stress_writer_done = 0;
+
+    pthread_t writer;
+    pthread_t readers[SNAPSHOT_STRESS_READERS];
+    snapshot_reader_result_t results[SNAPSHOT_STRESS_READERS];
+    memset(results, 0, sizeof(results));
+
+    for (int i = 0; i < SNAPSHOT_STRESS_READERS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&readers[i], NULL, snapshot_reader_thread, &results[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&writer, NULL, snapshot_writer_thread, NULL));
+
+    pthread_join(writer, NULL);
+    for (int i = 0; i < SNAPSHOT_STRESS_READERS; i++) {
+        pthread_join(readers[i], NULL);
+        TEST_ASSERT_TRUE(results[i].reads > 0);
+        TEST_ASSERT_EQUAL_UINT32(0, results[i].torn);
+        TEST_ASSERT_EQUAL_UINT32(0, results[i].non_monotonic);
+    }
+
+    stress_payload_t last;
+    TEST_ASSERT_EQUAL_UINT32(SNAPSHOT_STRESS_PUBLISHES, state_snapshot_read(&stress_snapshot, &last));
+    TEST_ASSERT_EQUAL_INT64(SNAPSHOT_STRESS_PUBLISHES, last.state.timestamp_us);
+}
+
+// ============================================================================
+// REAL IMU FIFO Tests (against the replayed FIFO stream)
+// ============================================================================
+
+void test_imu_fifo_burst_reads_all_queued_samples(void) {
+    imu_sensor_t imu;
+    setup_fifo_imu(&imu, 1000);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9f, 0.001f, imu_sensor_get_sample_period(&imu));
+
+    // 10 samples queued since the last cycle: level, gyro Y ramps 0..9 LSB*131
+    for (int i = 0; i < 10; i++) {
+        fake_fifo_push_frame(0, 0, 16384, 0, (int16_t)(i * 131), -262);
+    }
+
+    imu_sample_t batch[IMU_FIFO_MAX_BATCH];
+    size_t count = 0;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_read_fifo(&imu, batch, IMU_FIFO_MAX_BATCH, &count));
+    TEST_ASSERT_EQUAL_UINT32(10, count);
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, (float)i, batch[i].gyro_y);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, -2.0f, batch[i].gyro_z);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1.0f, batch[i].accel_z);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.0f, batch[i].pitch);
+    }
+
+    // One count read + one burst, regardless of how many samples were queued
+    TEST_ASSERT_EQUAL_UINT32(2, fake_i2c_read_transactions);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 9.0f, imu_sensor_get_gyro_y(&imu));
+
+    // Drained: the next cycle sees an empty FIFO and issues no burst
+    TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_read_fifo(&imu, batch, IMU_FIFO_MAX_BATCH, &count));
+    TEST_ASSERT_EQUAL_UINT32(0, count);
+    TEST_ASSERT_EQUAL_UINT32(3, fake_i2c_read_transactions);
+}
+
+void test_imu_fifo_partial_frame_and_batch_limit(void) {
+    imu_sensor_t imu;
+    setup_fifo_imu(&imu, 1000);
+
+    for (int i = 0; i < 5; i++) {
+        fake_fifo_push_frame(0, 0, 16384, 0, (int16_t)(i * 131), 0);
+    }
+    // Sensor is mid-way through writing a sixth frame
+    fake_fifo_written += 6;
+
+    imu_sample_t batch[3];
+    size_t count = 0;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_read_fifo(&imu, batch, 3, &count));
+    TEST_ASSERT_EQUAL_UINT32(3, count);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 2.0f, batch[2].gyro_y);
+
+    // Remaining complete frames come out next, the partial frame stays queued
+    TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_read_fifo(&imu, batch, 3, &count));
+    TEST_ASSERT_EQUAL_UINT32(2, count);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 3.0f, batch[0].gyro_y);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 4.0f, batch[1].gyro_y);
+    TEST_ASSERT_EQUAL_UINT32(6, fake_fifo_written - fake_fifo_read);
+}
+
+void test_imu_fifo_overflow_resets(void) {
+    imu_sensor_t imu;
+    setup_fifo_imu(&imu, 1000);
+    uint32_t resets_before = fake_fifo_resets;
+
+    fake_fifo_count_override = 1024; // FIFO full: samples were dropped
+
+    imu_sample_t batch[IMU_FIFO_MAX_BATCH];
+    size_t count = 99;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_read_fifo(&imu, batch, IMU_FIFO_MAX_BATCH, &count));
+    TEST_ASSERT_EQUAL_UINT32(0, count);
+    TEST_ASSERT_EQUAL_UINT32(1, imu.fifo_overflow_count);
+    TEST_ASSERT_EQUAL_UINT32(resets_before + 1, fake_fifo_resets);
+
+    // Stream resumes aligned after the reset
+    fake_fifo_push_frame(0, 0, 16384, 0, 655, 0);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_read_fifo(&imu, batch, IMU_FIFO_MAX_BATCH, &count));
+    TEST_ASSERT_EQUAL_UINT32(1, count);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 5.0f, batch[0].gyro_y);
+}
+
+void test_imu_fifo_batch_integrates_at_native_rate(void) {
+    imu_sensor_t imu;
+    setup_fifo_imu(&imu, 1000);
+
+    kalman_filter_t kf;
+    kalman_filter_init(&kf);
+    kalman_filter_set_angle(&kf, 0.0f);
+
+    // Recorded motion: tilt at 20 deg/s for 0.5 s (1 kHz samples), accel agrees
+    imu_sample_t batch[IMU_FIFO_MAX_BATCH];
+    float true_angle = 0.0f;
+    for (int cycle = 0; cycle < 250; cycle++) {          // 500 Hz control loop
+        for (int k = 0; k < 2; k++) {                    // 2 samples per cycle
+            true_angle += 20.0f * 0.001f;
+            float rad = true_angle * 3.14159265f / 180.0f;
+            fake_fifo_push_frame((int16_t)(-sinf(rad) * 16384.0f), 0,
+                                 (int16_t)(cosf(rad) * 16384.0f), 0, 20 * 131, 0);
+        }
+        if (fake_fifo_written + 64 > FAKE_FIFO_STREAM_MAX) {
+            // Recycle the recording buffer once drained
+            TEST_ASSERT_EQUAL_UINT32(fake_fifo_written - 24, fake_fifo_read);
+            memmove(fake_fifo_stream, &fake_fifo_stream[fake_fifo_read], 24);
+            fake_fifo_written = 24;
+            fake_fifo_read = 0;
+        }
+
+        size_t count = 0;
+        TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_read_fifo(&imu, batch, IMU_FIFO_MAX_BATCH, &count));
+        TEST_ASSERT_EQUAL_UINT32(2, count);
+        for (size_t i = 0; i < count; i++) {
+            kalman_filter_get_angle(&kf, batch[i].pitch, batch[i].gyro_y,
+                                    imu_sensor_get_sample_period(&imu));
+        }
+    }
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 10.0f, true_angle);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, true_angle, kf.angle);
+    // Two bus transactions per control cycle, not one per sample
+    TEST_ASSERT_EQUAL_UINT32(500, fake_i2c_read_transactions);
+}
+
+// ============================================================================
+// IMU Calibration Tests
+// ============================================================================
+
+static const imu_calibration_config_t test_calib_config = {
+    .target_samples = 50,
+    .gyro_motion_dps = 2.0f,
+    .accel_motion_g = 0.05f,
+    .level_tolerance_g = 0.02f,
+    .quiet_dps = 0.5f,
+    .quiet_hold_s = 1.0f,
+    .track_tau_s = 10.0f,
+};
+
+// Feed every queued FIFO frame to the boot calibration, returning the last status
+static imu_calib_status_t feed_calibration(imu_sensor_t* imu, imu_calibration_t* cal) {
+    imu_sample_t batch[IMU_FIFO_MAX_BATCH];
+    size_t count = 0;
+    imu_calib_status_t status = IMU_CALIB_COLLECTING;
+    do {
+        TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_read_fifo(imu, batch, IMU_FIFO_MAX_BATCH, &count));
+        for (size_t i = 0; i < count && status != IMU_CALIB_DONE; i++) {
+            status = imu_calibration_add(cal, &batch[i]);
+        }
+    } while (count > 0 && status != IMU_CALIB_DONE);
+    return status;
+}
+
+void test_imu_calibration_boot_offsets_and_motion_restart(void) {
+    imu_sensor_t imu;
+    setup_fifo_imu(&imu, 1000);
+    imu_calibration_t cal;
+    imu_calibration_init(&cal, &test_calib_config);
+    imu_calibration_start(&cal, true);
+
+    // Level board with biases: gyro (1.5, -0.8, 2.0) deg/s, accel (0.01, -0.005, 1.02) g
+    for (int i = 0; i < 20; i++) {
+        fake_fifo_push_frame(164, -82, 16712, 197, -105, 262);
+    }
+    // Someone bumps the robot: collection starts over from that sample
+    fake_fifo_push_frame(164, -82, 16712, 197, 1310, 262);
+    TEST_ASSERT_EQUAL_INT(IMU_CALIB_RESTARTED, feed_calibration(&imu, &cal));
+    TEST_ASSERT_EQUAL_UINT32(1, cal.restarts);
+    TEST_ASSERT_EQUAL_UINT32(1, cal.count);
+    fake_fifo_push_frame(164, -82, 16712, 197, -105, 262);
+    TEST_ASSERT_EQUAL_INT(IMU_CALIB_RESTARTED, feed_calibration(&imu, &cal));
+    TEST_ASSERT_EQUAL_UINT32(2, cal.restarts);
+
+    for (int i = 0; i < 60; i++) {
+        fake_fifo_push_frame(164, -82, 16712, 197, -105, 262);
+    }
+    TEST_ASSERT_EQUAL_INT(IMU_CALIB_DONE, feed_calibration(&imu, &cal));
+
+    imu_offsets_t offsets = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+    TEST_ASSERT_TRUE(imu_calibration_apply(&cal, &offsets));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 1.5f, offsets.gyro[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.8f, offsets.gyro[1]);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 2.0f, offsets.gyro[2]);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.01f, offsets.accel[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -0.005f, offsets.accel[1]);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.02f, offsets.accel[2]);
+
+    // The sensor subtracts the offsets right after scaling, pitch included
+    imu_sensor_set_offsets(&imu, &offsets);
+    fake_fifo_reset_stream();
+    fake_fifo_push_frame(164, -82, 16712, 197, -105, 262);
+    imu_sample_t sample;
+    size_t count = 0;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_read_fifo(&imu, &sample, 1, &count));
+    TEST_ASSERT_EQUAL_UINT32(1, count);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, sample.gyro_y);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, sample.accel_z);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 0.0f, sample.pitch);
+
+    // Resting tilted on a stand: gyro residuals still count, the accel stays untouched
+    imu_calibration_start(&cal, true);
+    for (int i = 0; i < 50; i++) {
+        fake_fifo_push_frame(164 + 1638, -82, 16712, 197 + 131, -105, 262);
+    }
+    TEST_ASSERT_EQUAL_INT(IMU_CALIB_DONE, feed_calibration(&imu, &cal));
+    imu_offsets_t tilted = offsets;
+    TEST_ASSERT_FALSE(imu_calibration_apply(&cal, &tilted));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 2.5f, tilted.gyro[0]);
+    TEST_ASSERT_EQUAL_FLOAT(offsets.accel[0], tilted.accel[0]);
+    TEST_ASSERT_EQUAL_FLOAT(offsets.accel[2], tilted.accel[2]);
+}
+
+void test_imu_calibration_tracks_bias_only_when_quiet(void) {
+    imu_calibration_t cal;
+    imu_calibration_init(&cal, &test_calib_config);
+    imu_offsets_t offsets = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+    const float dt = 0.01f;
+    const float true_bias = 0.2f;
+    imu_sample_t sample = { .accel_x = 0.0f, .accel_y = 0.0f, .accel_z = 1.0f };
+
+    // Nothing moves until the robot has been still for the hold time
+    for (int i = 0; i < 100; i++) {
+        sample.gyro_y = true_bias - offsets.gyro[1];
+        TEST_ASSERT_FALSE(imu_calibration_track(&cal, &sample, dt, &offsets));
+    }
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, offsets.gyro[1]);
+
+    // Then the residual decays with the tracking time constant (about 3 tau here)
+    for (int i = 0; i < 3000; i++) {
+        sample.gyro_y = true_bias - offsets.gyro[1];
+        imu_calibration_track(&cal, &sample, dt, &offsets);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, true_bias, offsets.gyro[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, offsets.gyro[0]);
+
+    // A real rotation or a jolt restarts the hold, so motion is never learned as bias
+    float learned = offsets.gyro[1];
+    sample.gyro_y = 5.0f;
+    TEST_ASSERT_FALSE(imu_calibration_track(&cal, &sample, dt, &offsets));
+    sample.gyro_y = 0.0f;
+    sample.accel_z = 1.2f;
+    TEST_ASSERT_FALSE(imu_calibration_track(&cal, &sample, dt, &offsets));
+    sample.accel_z = 1.0f;
+    for (int i = 0; i < 99; i++) {
+        sample.gyro_y = 0.3f;
+        TEST_ASSERT_FALSE(imu_calibration_track(&cal, &sample, dt, &offsets));
+    }
+    TEST_ASSERT_EQUAL_FLOAT(learned, offsets.gyro[1]);
+}
+
+// ============================================================================
+// Encoder Tests (against a fake pulse counter)
+// ============================================================================
+
+#define FAKE_PCNT_LIMIT 100
+
+typedef struct {
+    int count;
+    int limit;
+    int clears;
+    bool fail_reads;
+} fake_pcnt_t;
+
+static esp_err_t fake_pcnt_get_count(void* ctx, int* count) {
+    fake_pcnt_t* pcnt = (fake_pcnt_t*)ctx;
+    if (pcnt->fail_reads) {
+        return ESP_FAIL;
+    }
+    *count = pcnt->count;
+    return ESP_OK;
+}
+
+static esp_err_t fake_pcnt_clear_count(void* ctx) {
+    fake_pcnt_t* pcnt = (fake_pcnt_t*)ctx;
+    pcnt->count = 0;
+    pcnt->clears++;
+    return ESP_OK;
+}
+
+static const encoder_counter_ops_t fake_pcnt_ops = {
+    .get_count = fake_pcnt_get_count,
+    .clear_count = fake_pcnt_clear_count,
+};
+
+// Step one quadrature edge at a time, clearing at the limit like the PCNT unit
+static void fake_pcnt_step(fake_pcnt_t* pcnt, int edges) {
+    int dir = (edges > 0) ? 1 : -1;
+    for (int i = 0; i != edges; i += dir) {
+        pcnt->count += dir;
+        if (pcnt->count >= pcnt->limit || pcnt->count <= -pcnt->limit) {
+            pcnt->count = 0;
+        }
+    }
+}
+
+void test_encoder_counter_accumulates_across_wraps(void) {
+    fake_pcnt_t pcnt = { .count = 37, .limit = FAKE_PCNT_LIMIT };
+    encoder_sensor_t encoder;
+    TEST_ASSERT_EQUAL(ESP_OK, encoder_sensor_init_counter(&encoder, &fake_pcnt_ops, &pcnt, FAKE_PCNT_LIMIT, 360, 6.5f));
+    TEST_ASSERT_EQUAL(0, pcnt.count);
+    TEST_ASSERT_EQUAL(0, encoder_sensor_get_position(&encoder));
+
+    // Forward through several wraps, polled every 30 edges (below limit / 2)
+    for (int i = 0; i < 24; i++) {
+        fake_pcnt_step(&pcnt, 30);
+        TEST_ASSERT_EQUAL(ESP_OK, encoder_sensor_update_speed(&encoder));
+    }
+    TEST_ASSERT_EQUAL(720, encoder_sensor_get_position(&encoder));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 2.0f * 3.14159265f * 6.5f, encoder_sensor_get_distance(&encoder));
+
+    // Backward past zero and through the negative limit
+    for (int i = 0; i < 40; i++) {
+        fake_pcnt_step(&pcnt, -45);
+        TEST_ASSERT_EQUAL(ESP_OK, encoder_sensor_update_speed(&encoder));
+    }
+    TEST_ASSERT_EQUAL(720 - 1800, encoder_sensor_get_position(&encoder));
+
+    // Position only advances when polled
+    fake_pcnt_step(&pcnt, 10);
+    TEST_ASSERT_EQUAL(720 - 1800, encoder_sensor_get_position(&encoder));
+    TEST_ASSERT_EQUAL(ESP_OK, encoder_sensor_update_speed(&encoder));
+    TEST_ASSERT_EQUAL(720 - 1790, encoder_sensor_get_position(&encoder));
+}
+
+void test_encoder_counter_reset_and_read_failure(void) {
+    fake_pcnt_t pcnt = { .limit = FAKE_PCNT_LIMIT };
+    encoder_sensor_t encoder;
+    encoder_sensor_init_counter(&encoder, &fake_pcnt_ops, &pcnt, FAKE_PCNT_LIMIT, 360, 6.5f);
+
+    fake_pcnt_step(&pcnt, 42);
+    encoder_sensor_update_speed(&encoder);
+    TEST_ASSERT_EQUAL(42, encoder_sensor_get_position(&encoder));
+
+    // Reset clears the hardware too, so the next poll starts from zero
+    encoder_sensor_reset(&encoder);
+    TEST_ASSERT_EQUAL(2, pcnt.clears);
+    TEST_ASSERT_EQUAL(0, encoder_sensor_get_position(&encoder));
+    fake_pcnt_step(&pcnt, -7);
+    encoder_sensor_update_speed(&encoder);
+    TEST_ASSERT_EQUAL(-7, encoder_sensor_get_position(&encoder));
+
+    // A failed read keeps the last position and picks up the motion on the next poll
+    pcnt.fail_reads = true;
+    fake_pcnt_step(&pcnt, 20);
+    TEST_ASSERT_TRUE(encoder_sensor_update_speed(&encoder) != ESP_OK);
+    TEST_ASSERT_EQUAL(-7, encoder_sensor_get_position(&encoder));
+    pcnt.fail_reads = false;
+    encoder_sensor_update_speed(&encoder);
+    TEST_ASSERT_EQUAL(13, encoder_sensor_get_position(&encoder));
+}
+
+// Wheel position in counts as a function of time, sampled finely to place edges exactly
+typedef float (*wheel_motion_fn)(float t);
+
+static float wheel_slow_constant(float t) { return 50.0f * t; }             // one edge every 20 ms
+static float wheel_ramp(float t) { return 0.5f * 2000.0f * t * t; }         // 2000 counts/s^2 from rest
+
+typedef struct {
+    int32_t count;
+    int64_t edge_us;
+    float max_velocity;
+} wheel_trace_t;
+
+// Advance a simulated wheel in 10 us steps, stamping edges like the ISR, and poll every poll_us
+static void run_wheel_trace(velocity_estimator_t* est, wheel_motion_fn motion, wheel_trace_t* trace,
+                            int64_t from_us, int64_t to_us, int64_t poll_us) {
+    for (int64_t t = from_us + 10; t <= to_us; t += 10) {
+        int32_t position = (int32_t)floorf(motion((float)t * 1e-6f));
+        if (position != trace->count) {
+            trace->count = position;
+            trace->edge_us = t;
+        }
+        if (t % poll_us == 0) {
+            float v = velocity_estimator_update(est, trace->count, trace->edge_us, t);
+            if (v > trace->max_velocity) {
+                trace->max_velocity = v;
+            }
+        }
+    }
+}
+
+void test_velocity_estimator_low_speed_from_edge_period(void) {
+    velocity_estimator_config_t config;
+    velocity_estimator_default_config(&config);
+    velocity_estimator_t est;
+    velocity_estimator_init(&est, &config);
+
+    // 50 counts/s polled at 500 Hz: a count-difference estimate would read 0 or 500 counts/s
+    wheel_trace_t trace = {0};
+    run_wheel_trace(&est, wheel_slow_constant, &trace, 0, 500000, 2000);
+    trace.max_velocity = 0.0f;
+    run_wheel_trace(&est, wheel_slow_constant, &trace, 500000, 1500000, 2000);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 50.0f, velocity_estimator_get_velocity(&est));
+    TEST_ASSERT_TRUE(trace.max_velocity < 55.0f);
+
+    // The wheel stops: no further edges, so the estimate decays under the 1/elapsed bound to zero
+    int64_t stop_us = trace.edge_us;
+    float previous = velocity_estimator_get_velocity(&est);
+    for (int64_t t = 1500000 + 2000; t <= stop_us + 300000; t += 2000) {
+        float v = velocity_estimator_update(&est, trace.count, trace.edge_us, t);
+        float since_s = (float)(t - stop_us) * 1e-6f;
+        if (since_s > 0.025f) {
+            TEST_ASSERT_TRUE(v <= 1.0f / since_s + 1.0f);
+        }
+        TEST_ASSERT_TRUE(v <= previous + 0.5f);
+        previous = v;
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 0.0f, velocity_estimator_get_velocity(&est));
+}
+
+void test_velocity_estimator_tracks_acceleration(void) {
+    const velocity_tracker_t trackers[] = { VELOCITY_TRACKER_KALMAN, VELOCITY_TRACKER_ALPHA_BETA };
+    for (size_t i = 0; i < sizeof(trackers) / sizeof(trackers[0]); i++) {
+        velocity_estimator_config_t config;
+        velocity_estimator_default_config(&config);
+        config.tracker = trackers[i];
+        velocity_estimator_t est;
+        velocity_estimator_init(&est, &config);
+
+        wheel_trace_t trace = {0};
+        run_wheel_trace(&est, wheel_ramp, &trace, 0, 500000, 2000);
+        // True speed at 0.5 s is 1000 counts/s and acceleration 2000 counts/s^2
+        TEST_ASSERT_FLOAT_WITHIN(30.0f, 1000.0f, velocity_estimator_get_velocity(&est));
+        TEST_ASSERT_FLOAT_WITHIN(400.0f, 2000.0f, velocity_estimator_get_accel(&est));
+    }
+}
+
+void test_encoder_speed_in_cm_per_second(void) {
+    fake_pcnt_t pcnt = { .limit = FAKE_PCNT_LIMIT };
+    encoder_sensor_t encoder;
+    encoder_sensor_init_counter(&encoder, &fake_pcnt_ops, &pcnt, FAKE_PCNT_LIMIT, 360, 6.5f);
+    // Counter edges are only known to the poll period, so widen the span like CONFIG_ENCODER_PCNT_MODE does
+    velocity_estimator_config_t config;
+    velocity_estimator_default_config(&config);
+    config.edge_jitter_us = 2000.0f * 0.29f;
+    config.min_span_s = 0.004f;
+    encoder_sensor_set_velocity_config(&encoder, &config);
+
+    // One revolution per second, polled at 500 Hz with the count appearing at poll time
+    int64_t t = 0;
+    float speed_sum = 0.0f;
+    float accel_sum = 0.0f;
+    for (int i = 1; i <= 1000; i++) {
+        t += 2000;
+        int32_t target = (int32_t)(360LL * t / 1000000);
+        fake_pcnt_step(&pcnt, target - encoder_sensor_get_position(&encoder));
+        TEST_ASSERT_EQUAL(ESP_OK, encoder_sensor_update_speed_at(&encoder, t));
+        if (i > 500) {
+            speed_sum += encoder_sensor_get_speed(&encoder);
+            accel_sum += encoder_sensor_get_accel(&encoder);
+        }
+    }
+    // Wheel speed in cm/s: one circumference per second, no leftover scale factor
+    TEST_ASSERT_FLOAT_WITHIN(0.3f, 3.14159265f * 6.5f, speed_sum / 500.0f);
+    TEST_ASSERT_FLOAT_WITHIN(5.0f, 0.0f, accel_sum / 500.0f);
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 3.14159265f * 6.5f, encoder_sensor_get_speed(&encoder));
+
+    encoder_sensor_reset(&encoder);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, encoder_sensor_get_speed(&encoder));
+}
+
+// ============================================================================
+// Odometry Tests
+// ============================================================================
+
+static odometry_config_t make_odometry_config(float gyro_weight) {
+    odometry_config_t config = {
+        .wheel_base_cm = 17.0f,
+        .cm_per_count = 0.1f,
+        .gyro_weight = gyro_weight,
+        .distance_noise = 0.04f,
+        .heading_walk_deg = 0.5f,
+        .initial_heading_std_deg = 20.0f,
+        .gps_gate = 13.8f,
+        .gps_align_distance_cm = 1000.0f,
+    };
+    return config;
+}
+
+// Drive both wheels at constant speeds for a while at 500 Hz, feeding rounded counts
+static void drive_odometry(odometry_t* odo, double wheel_cm[2], float left_cms, float right_cms,
+                           float yaw_rate_dps, float seconds) {
+    const float dt = 0.002f;
+    int steps = (int)lroundf(seconds / dt);
+    for (int i = 0; i < steps; i++) {
+        wheel_cm[0] += left_cms * dt;
+        wheel_cm[1] += right_cms * dt;
+        odometry_update(odo, (int32_t)lround(wheel_cm[0] / odo->config.cm_per_count),
+                        (int32_t)lround(wheel_cm[1] / odo->config.cm_per_count), yaw_rate_dps, dt);
+    }
+}
+
+void test_odometry_integrates_square_path(void) {
+    odometry_config_t config = make_odometry_config(0.9f);
+    odometry_t odo;
+    odometry_init(&odo, &config);
+    double wheel_cm[2] = { 0.0, 0.0 };
+    odometry_update(&odo, 0, 0, 0.0f, 0.0f);
+
+    // 1 m sides, turning 90 degrees in place (counter-clockwise) at each corner
+    float turn_cms = 45.0f * 3.14159265f / 180.0f * 17.0f / 2.0f;
+    for (int side = 0; side < 4; side++) {
+        drive_odometry(&odo, wheel_cm, 20.0f, 20.0f, 0.0f, 5.0f);
+        if (side == 0) {
+            TEST_ASSERT_FLOAT_WITHIN(0.5f, 100.0f, odo.x_cm);
+            TEST_ASSERT_FLOAT_WITHIN(0.5f, 0.0f, odo.y_cm);
+        }
+        drive_odometry(&odo, wheel_cm, -turn_cms, turn_cms, 45.0f, 2.0f);
+        if (side == 0) {
+            TEST_ASSERT_FLOAT_WITHIN(0.5f, 90.0f, odometry_get_heading_deg(&odo));
+        }
+    }
+
+    // Back at the start, facing the same way, with uncertainty grown along the way
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 0.0f, odo.x_cm);
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 0.0f, odo.y_cm);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 0.0f, odometry_get_heading_deg(&odo));
+    TEST_ASSERT_TRUE(odometry_get_position_std_cm(&odo) > 1.0f);
+
+    odometry_reset(&odo, 10.0f, -5.0f, 180.0f);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, odo.x_cm);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 180.0f, fabsf(odometry_get_heading_deg(&odo)));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, odometry_get_position_std_cm(&odo));
+}
+
+void test_odometry_gyro_covers_wheel_slip(void) {
+    // The right wheel spins 20% more than the ground it covers while the gyro sees no rotation
+    odometry_config_t config = make_odometry_config(0.9f);
+    odometry_t blended;
+    odometry_init(&blended, &config);
+    config.gyro_weight = 0.0f;
+    odometry_t wheels_only;
+    odometry_init(&wheels_only, &config);
+
+    double blended_cm[2] = { 0.0, 0.0 };
+    double wheels_cm[2] = { 0.0, 0.0 };
+    drive_odometry(&blended, blended_cm, 20.0f, 24.0f, 0.0f, 5.0f);
+    drive_odometry(&wheels_only, wheels_cm, 20.0f, 24.0f, 0.0f, 5.0f);
+
+    // Wheels alone would turn 20 cm / 17 cm = 67 degrees; the gyro keeps it to a tenth of that
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 67.4f, odometry_get_heading_deg(&wheels_only));
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 6.74f, odometry_get_heading_deg(&blended));
+    TEST_ASSERT_TRUE(fabsf(blended.y_cm) < 10.0f);
+}
+
+// Latitude/longitude of a point east_cm/north_cm away from the given reference
+static void odometry_test_latlon(double lat0, double lon0, double east_cm, double north_cm,
+                                 double* lat, double* lon) {
+    const double radius_cm = 637100000.0;
+    const double deg = 180.0 / 3.14159265358979;
+    *lat = lat0 + north_cm / radius_cm * deg;
+    *lon = lon0 + east_cm / (radius_cm * cos(lat0 / deg)) * deg;
+}
+
+void test_odometry_gps_fusion_corrects_heading_and_gates_outliers(void) {
+    odometry_config_t config = make_odometry_config(0.9f);
+    odometry_t odo;
+    odometry_init(&odo, &config);
+    double wheel_cm[2] = { 0.0, 0.0 };
+    odometry_update(&odo, 0, 0, 0.0f, 0.0f);
+
+    // The robot really heads 30 degrees left of where odometry starts, driving at 50 cm/s.
+    // Fixes wait for 10 m of straight travel to align the heading, then exact 1 Hz fixes
+    // keep pulling the position and, through the correlation, the heading.
+    const double lat0 = 37.5665;
+    const double lon0 = 126.9780;
+    const double true_heading = 30.0 * 3.14159265358979 / 180.0;
+    double lat;
+    double lon;
+    TEST_ASSERT_TRUE(odometry_fuse_gps(&odo, lat0, lon0, 300.0f));
+    for (int second = 1; second <= 60; second++) {
+        drive_odometry(&odo, wheel_cm, 50.0f, 50.0f, 0.0f, 1.0f);
+        double d = 50.0 * second;
+        odometry_test_latlon(lat0, lon0, d * cos(true_heading), d * sin(true_heading), &lat, &lon);
+        TEST_ASSERT_EQUAL(second > 20, odometry_fuse_gps(&odo, lat, lon, 300.0f));
+        TEST_ASSERT_EQUAL(second > 20, odo.heading_aligned);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(3.0f, 30.0f, odometry_get_heading_deg(&odo));
+    TEST_ASSERT_FLOAT_WITHIN(150.0f, 3000.0f * cos(true_heading), odo.x_cm);
+    TEST_ASSERT_FLOAT_WITHIN(150.0f, 3000.0f * sin(true_heading), odo.y_cm);
+    TEST_ASSERT_TRUE(odometry_get_position_std_cm(&odo) < 300.0f);
+    TEST_ASSERT_EQUAL_UINT32(41, odo.gps_accepted);
+
+    // A multipath jump of 100 m is gated out and leaves the estimate alone
+    float x = odo.x_cm;
+    float y = odo.y_cm;
+    odometry_test_latlon(lat0, lon0, 3000.0 * cos(true_heading), 3000.0 * sin(true_heading) + 10000.0, &lat, &lon);
+    TEST_ASSERT_FALSE(odometry_fuse_gps(&odo, lat, lon, 300.0f));
+    TEST_ASSERT_EQUAL_FLOAT(x, odo.x_cm);
+    TEST_ASSERT_EQUAL_FLOAT(y, odo.y_cm);
+    TEST_ASSERT_EQUAL_UINT32(1, odo.gps_rejected);
+}
+
+void test_odometry_gps_aligns_large_heading_offset(void) {
+    odometry_config_t config = make_odometry_config(0.9f);
+    odometry_t odo;
+    odometry_init(&odo, &config);
+    double wheel_cm[2] = { 0.0, 0.0 };
+    odometry_update(&odo, 0, 0, 0.0f, 0.0f);
+
+    // Odometry starts at heading 0 while the robot really faces 150 degrees, far outside
+    // the initial 20 degree uncertainty the position update could linearize
+    const double lat0 = 37.5665;
+    const double lon0 = 126.9780;
+    const double deg = 3.14159265358979 / 180.0;
+    double lat;
+    double lon;
+    TEST_ASSERT_TRUE(odometry_fuse_gps(&odo, lat0, lon0, 300.0f));
+
+    // 3 m straight, then a 90 degree turn in place: too short to align
+    double east = 0.0;
+    double north = 0.0;
+    for (int second = 1; second <= 6; second++) {
+        drive_odometry(&odo, wheel_cm, 50.0f, 50.0f, 0.0f, 1.0f);
+        east += 50.0 * cos(150.0 * deg);
+        north += 50.0 * sin(150.0 * deg);
+        odometry_test_latlon(lat0, lon0, east, north, &lat, &lon);
+        TEST_ASSERT_FALSE(odometry_fuse_gps(&odo, lat, lon, 300.0f));
+    }
+    float turn_cms = 45.0f * 3.14159265f / 180.0f * 17.0f / 2.0f;
+    drive_odometry(&odo, wheel_cm, -turn_cms, turn_cms, 45.0f, 2.0f);
+
+    // The bent path restarts the alignment from the first fix after the turn
+    double origin_east = 0.0;
+    double origin_north = 0.0;
+    for (int second = 1; second <= 40; second++) {
+        drive_odometry(&odo, wheel_cm, 50.0f, 50.0f, 0.0f, 1.0f);
+        east += 50.0 * cos(240.0 * deg);
+        north += 50.0 * sin(240.0 * deg);
+        odometry_test_latlon(lat0, lon0, east, north, &lat, &lon);
+        bool fused = odometry_fuse_gps(&odo, lat, lon, 300.0f);
+        if (second == 1) {
+            origin_east = east;
+            origin_north = north;
+        }
+        TEST_ASSERT_EQUAL(second > 21, fused);
+    }
+    TEST_ASSERT_TRUE(odo.heading_aligned);
+    TEST_ASSERT_FLOAT_WITHIN(3.0f, -120.0f, odometry_get_heading_deg(&odo));
+    TEST_ASSERT_FLOAT_WITHIN(150.0f, east - origin_east, odo.x_cm - odo.origin_x_cm);
+    TEST_ASSERT_FLOAT_WITHIN(150.0f, north - origin_north, odo.y_cm - odo.origin_y_cm);
+    TEST_ASSERT_EQUAL_UINT32(0, odo.gps_rejected);
+
+    // Reset forgets the alignment along with the origin
+    odometry_reset(&odo, 0.0f, 0.0f, 0.0f);
+    TEST_ASSERT_FALSE(odo.heading_aligned);
+}
+
+// ============================================================================
+// NMEA Parser Tests
+// ============================================================================
+
+// Wrap a sentence body as "$body*HH\r\n" with its checksum
+static size_t nmea_test_sentence(char* out, size_t size, const char* body) {
+    uint8_t checksum = 0;
+    for (const char* c = body; *c != '\0'; c++) {
+        checksum ^= (uint8_t)*c;
+    }
+    return (size_t)snprintf(out, size, "$%s*%02X\r\n", body, checksum);
+}
+
+// Feed bytes one at a time, returning the last sentence decoded and how many were
+static nmea_sentence_t nmea_test_feed(nmea_parser_t* parser, const char* text, size_t length, int* count) {
+    nmea_sentence_t last = NMEA_SENTENCE_NONE;
+    for (size_t i = 0; i < length; i++) {
+        nmea_sentence_t sentence = nmea_parser_feed(parser, (uint8_t)text[i]);
+        if (sentence != NMEA_SENTENCE_NONE) {
+            last = sentence;
+            (*count)++;
+        }
+    }
+    return last;
+}
+
+void test_nmea_parser_decodes_gga_and_rmc_in_pieces(void) {
+    nmea_parser_t parser;
+    nmea_parser_init(&parser);
+    int count = 0;
+
+    // Reference GGA arriving in two UART chunks after line noise
+    const char* gga = "\x07\xff$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+    size_t split = 30;
+    TEST_ASSERT_EQUAL(NMEA_SENTENCE_NONE, nmea_test_feed(&parser, gga, split, &count));
+    TEST_ASSERT_EQUAL(NMEA_SENTENCE_GGA, nmea_test_feed(&parser, gga + split, strlen(gga) - split, &count));
+    TEST_ASSERT_EQUAL(1, count);
+    const nmea_data_t* data = nmea_parser_data(&parser);
+    TEST_ASSERT_EQUAL_MEMORY("GP", data->talker, 2);
+    TEST_ASSERT_TRUE(data->has_position);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 48.0 + 7.038 / 60.0, data->latitude);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 11.0 + 31.0 / 60.0, data->longitude);
+    TEST_ASSERT_EQUAL(1, data->quality);
+    TEST_ASSERT_EQUAL(8, data->satellites);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 545.4f, data->altitude);
+
+    // Southern/western hemispheres and the RMC status
+    char line[96];
+    size_t length = nmea_test_sentence(line, sizeof(line),
+                                       "GPRMC,081836,A,3751.65012,S,14507.36,W,000.0,360.0,130998,011.3,E");
+    TEST_ASSERT_EQUAL(NMEA_SENTENCE_RMC, nmea_test_feed(&parser, line, length, &count));
+    data = nmea_parser_data(&parser);
+    TEST_ASSERT_TRUE(data->status_valid);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, -(37.0 + 51.65012 / 60.0), data->latitude);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, -(145.0 + 7.36 / 60.0), data->longitude);
+
+    // No fix yet: empty position fields and quality 0
+    length = nmea_test_sentence(line, sizeof(line), "GPGGA,000001,,,,,0,00,99.99,,,,,,");
+    TEST_ASSERT_EQUAL(NMEA_SENTENCE_GGA, nmea_test_feed(&parser, line, length, &count));
+    TEST_ASSERT_FALSE(nmea_parser_data(&parser)->has_position);
+    TEST_ASSERT_EQUAL(0, nmea_parser_data(&parser)->quality);
+    TEST_ASSERT_EQUAL_UINT32(3, parser.sentences);
+    TEST_ASSERT_EQUAL_UINT32(0, parser.checksum_errors);
+}
+
+void test_nmea_parser_rejects_corruption_and_resyncs(void) {
+    nmea_parser_t parser;
+    nmea_parser_init(&parser);
+    int count = 0;
+    char line[96];
+    char stream[512];
+    size_t fill = 0;
+
+    // One flipped digit, a sentence with no checksum, an overlong line and a truncated sentence
+    size_t length = nmea_test_sentence(line, sizeof(line), "GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,");
+    line[20] ^= 0x01;
+    memcpy(stream + fill, line, length);
+    fill += length;
+    fill += (size_t)snprintf(stream + fill, sizeof(stream) - fill, "$GPRMC,123519,A,4807.038,N\r\n");
+    stream[fill++] = '$';
+    for (int i = 0; i < 100; i++) {
+        stream[fill++] = 'G';
+    }
+    fill += (size_t)snprintf(stream + fill, sizeof(stream) - fill, "$GPGGA,1235");
+    // A sentence we do not decode is skipped without counting as an error
+    fill += nmea_test_sentence(stream + fill, sizeof(stream) - fill, "GPGSV,3,1,11,03,03,111,00,04,15,270,00");
+    fill += nmea_test_sentence(stream + fill, sizeof(stream) - fill, "GPGGA,123520,4807.040,N,01131.000,E,1,09,0.9,545.0,M,46.9,M,,");
+
+    TEST_ASSERT_EQUAL(NMEA_SENTENCE_GGA, nmea_test_feed(&parser, stream, fill, &count));
+    TEST_ASSERT_EQUAL(1, count);
+    TEST_ASSERT_EQUAL(9, nmea_parser_data(&parser)->satellites);
+    TEST_ASSERT_EQUAL_UINT32(2, parser.checksum_errors);
+    TEST_ASSERT_EQUAL_UINT32(1, parser.overflows);
+    TEST_ASSERT_EQUAL_UINT32(1, parser.sentences);
+}
+
+// ============================================================================
+// UBX Parser and GPS Source Selection Tests
+// ============================================================================
+
+// NAV-PVT frame for a fix at the given position (1e-7 degree) moving north-east
+static size_t ubx_test_nav_pvt(uint8_t* out, size_t size, int32_t lat, int32_t lon, bool fix) {
+    ubx_nav_pvt_t pvt;
+    memset(&pvt, 0, sizeof(pvt));
+    pvt.fix_type = fix ? 3 : 0;
+    pvt.flags = fix ? UBX_NAV_PVT_FIX_OK : 0;
+    pvt.num_sv = 14;
+    pvt.lat = lat;
+    pvt.lon = lon;
+    pvt.h_msl = 38250;
+    pvt.h_acc = 1800;
+    pvt.g_speed = 1414;
+    pvt.head_mot = 4500000;
+    return ubx_build_frame(out, size, UBX_CLASS_NAV, UBX_ID_NAV_PVT, (const uint8_t*)&pvt, sizeof(pvt));
+}
+
+void test_ubx_parser_decodes_nav_pvt_in_mixed_stream(void) {
+    uint8_t stream[512];
+    size_t fill = 0;
+    // Stray sync bytes, an NMEA sentence, a corrupted frame, an oversized frame, then a good NAV-PVT
+    stream[fill++] = UBX_SYNC_1;
+    stream[fill++] = 0x00;
+    fill += nmea_test_sentence((char*)stream + fill, sizeof(stream) - fill, "GNGGA,000001,,,,,0,00,99.99,,,,,,");
+    size_t bad = fill;
+    fill += ubx_test_nav_pvt(stream + fill, sizeof(stream) - fill, 375665000, 1269780000, true);
+    stream[bad + 30] ^= 0x40;
+    uint8_t big[UBX_MAX_PAYLOAD + 20] = { 0 };
+    fill += ubx_build_frame(stream + fill, sizeof(stream) - fill, 0x0A, 0x09, big, sizeof(big));
+    fill += ubx_test_nav_pvt(stream + fill, sizeof(stream) - fill, 375665000, 1269780000, true);
+
+    ubx_parser_t parser;
+    ubx_parser_init(&parser);
+    const ubx_nav_pvt_t* pvt = NULL;
+    int frames = 0;
+    for (size_t i = 0; i < fill; i++) {
+        const ubx_frame_t* frame = ubx_parser_feed(&parser, stream[i]);
+        if (frame != NULL) {
+            frames++;
+            pvt = ubx_frame_nav_pvt(frame);
+        }
+    }
+    TEST_ASSERT_EQUAL(1, frames);
+    TEST_ASSERT_NOT_NULL(pvt);
+    // The view points into the parser's own buffer: nothing was copied out
+    TEST_ASSERT_TRUE((const uint8_t*)pvt == parser.buf);
+    TEST_ASSERT_EQUAL_INT32(375665000, pvt->lat);
+    TEST_ASSERT_EQUAL_INT32(1269780000, pvt->lon);
+    TEST_ASSERT_EQUAL_INT32(1414, pvt->g_speed);
+    TEST_ASSERT_EQUAL_INT32(4500000, pvt->head_mot);
+    TEST_ASSERT_EQUAL(14, pvt->num_sv);
+    TEST_ASSERT_EQUAL_UINT32(1, parser.checksum_errors);
+    TEST_ASSERT_EQUAL_UINT32(1, parser.oversized);
+
+    // Known-good reference frame: UBX-CFG-RATE poll from the u-blox protocol spec
+    uint8_t poll[8];
+    TEST_ASSERT_EQUAL(8, ubx_build_frame(poll, sizeof(poll), UBX_CLASS_CFG, UBX_ID_CFG_RATE, NULL, 0));
+    TEST_ASSERT_EQUAL_HEX8(0x0E, poll[6]);
+    TEST_ASSERT_EQUAL_HEX8(0x30, poll[7]);
+    TEST_ASSERT_EQUAL(0, ubx_build_frame(poll, 7, UBX_CLASS_CFG, UBX_ID_CFG_RATE, NULL, 0));
+}
+
+void test_gps_prefers_nav_pvt_and_falls_back_to_nmea(void) {
+    gps_sensor_t gps;
+    TEST_ASSERT_EQUAL(ESP_OK, gps_sensor_init(&gps, 2, 17, 18, 9600));
+    char line[96];
+    uint8_t frame[128];
+
+    // Multi-GNSS receivers use the $GN talker
+    size_t length = nmea_test_sentence(line, sizeof(line), "GNGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,");
+    TEST_ASSERT_TRUE(gps_sensor_feed(&gps, (const uint8_t*)line, length));
+    TEST_ASSERT_TRUE(gps_sensor_has_fix(&gps));
+    TEST_ASSERT_FALSE(gps_sensor_is_ubx(&gps));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 48.0 + 7.038 / 60.0, gps_sensor_get_latitude(&gps));
+    TEST_ASSERT_FALSE(gps.data.has_velocity);
+
+    // NAV-PVT takes over and brings velocity and an accuracy estimate
+    size_t size = ubx_test_nav_pvt(frame, sizeof(frame), 375665000, 1269780000, true);
+    TEST_ASSERT_TRUE(gps_sensor_feed(&gps, frame, size));
+    TEST_ASSERT_TRUE(gps_sensor_is_ubx(&gps));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 37.5665, gps_sensor_get_latitude(&gps));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 126.978, gps_sensor_get_longitude(&gps));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 38.25f, gps_sensor_get_altitude(&gps));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 1.8f, gps.data.accuracy);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 1.414f, gps.data.speed);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 45.0f, gps.data.course);
+    TEST_ASSERT_TRUE(gps.data.has_velocity);
+
+    // NMEA keeps arriving alongside but is ignored until NAV-PVT goes quiet
+    for (int i = 1; i < GPS_NMEA_FALLBACK_GGA; i++) {
+        TEST_ASSERT_FALSE(gps_sensor_feed(&gps, (const uint8_t*)line, length));
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9, 37.5665, gps_sensor_get_latitude(&gps));
+    }
+    TEST_ASSERT_TRUE(gps_sensor_feed(&gps, (const uint8_t*)line, length));
+    TEST_ASSERT_FALSE(gps_sensor_is_ubx(&gps));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 48.0 + 7.038 / 60.0, gps_sensor_get_latitude(&gps));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, gps.data.accuracy);
+
+    // A NAV-PVT without gnssFixOK drops the fix
+    size = ubx_test_nav_pvt(frame, sizeof(frame), 0, 0, false);
+    TEST_ASSERT_TRUE(gps_sensor_feed(&gps, frame, size));
+    TEST_ASSERT_FALSE(gps_sensor_has_fix(&gps));
+
+    // Nothing decoded after switching to the UBX baud rate: go back to the original one
+    TEST_ASSERT_EQUAL(ESP_OK, gps_sensor_configure_ubx(&gps, 115200, 10));
+    TEST_ASSERT_EQUAL(115200, gps.baudrate);
+    TEST_ASSERT_FALSE(gps_sensor_confirm_baudrate(&gps));
+    TEST_ASSERT_EQUAL(9600, gps.baudrate);
+    TEST_ASSERT_EQUAL(ESP_OK, gps_sensor_configure_ubx(&gps, 115200, 10));
+    TEST_ASSERT_TRUE(gps_sensor_feed(&gps, frame, size));
+    TEST_ASSERT_TRUE(gps_sensor_confirm_baudrate(&gps));
+    TEST_ASSERT_EQUAL(115200, gps.baudrate);
+}
+
+// ============================================================================
+// I2C Transaction Tests
+// ============================================================================
+
+static i2c_reg_write_t recorded_writes[16];
+static size_t recorded_write_count;
+
+static esp_err_t recording_bus(uint8_t device_addr, uint8_t reg_addr, uint8_t* data, size_t len, bool is_read) {
+    if (!is_read && recorded_write_count < 16) {
+        recorded_writes[recorded_write_count].reg_addr = reg_addr;
+        recorded_writes[recorded_write_count].value = data[0];
+        recorded_write_count++;
+    }
+    return fake_mpu_bus(device_addr, reg_addr, data, len, is_read);
+}
+
+void test_i2c_batch_write_preserves_order(void) {
+    fake_fifo_reset_stream();
+    recorded_write_count = 0;
+    i2c_driver_fake_set_bus(recording_bus);
+    i2c_driver_reset_stats();
+
+    const i2c_reg_write_t seq[] = { { 0x6B, 0x00 }, { 0x1B, 0x08 }, { 0x1C, 0x10 } };
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_write_registers(0, 0x68, seq, 3));
+    TEST_ASSERT_EQUAL_UINT32(3, recorded_write_count);
+    for (size_t i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_HEX8(seq[i].reg_addr, recorded_writes[i].reg_addr);
+        TEST_ASSERT_EQUAL_HEX8(seq[i].value, recorded_writes[i].value);
+    }
+
+    // Oversized or empty batches are rejected before touching the bus
+    i2c_reg_write_t too_many[I2C_BATCH_MAX_WRITES + 1] = { { 0 } };
+    TEST_ASSERT_EQUAL_INT(ESP_FAIL, i2c_write_registers(0, 0x68, too_many, I2C_BATCH_MAX_WRITES + 1));
+    TEST_ASSERT_EQUAL_INT(ESP_FAIL, i2c_write_registers(0, 0x68, seq, 0));
+    TEST_ASSERT_EQUAL_UINT32(3, recorded_write_count);
+
+    i2c_driver_stats_t stats;
+    i2c_driver_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.batch_count);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.dynamic_link_count);
+    i2c_driver_fake_set_bus(NULL);
+}
+
+void test_i2c_control_cycle_zero_allocations(void) {
+    imu_sensor_t imu;
+    setup_fifo_imu(&imu, 1000);
+    i2c_driver_reset_stats();
+
+    // 1000 control cycles at 500 Hz: FIFO drain, direct register read, one overflow
+    imu_sample_t batch[IMU_FIFO_MAX_BATCH];
+    for (int cycle = 0; cycle < 1000; cycle++) {
+        fake_fifo_written = fake_fifo_read = 0;
+        fake_fifo_push_frame(0, 0, 16384, 0, 131, 0);
+        fake_fifo_push_frame(0, 0, 16384, 0, 131, 0);
+        if (cycle == 500) {
+            fake_fifo_count_override = 1024;
+        }
+        size_t count = 0;
+        TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_read_fifo(&imu, batch, IMU_FIFO_MAX_BATCH, &count));
+        TEST_ASSERT_EQUAL_UINT32(cycle == 500 ? 0 : 2, count);
+        TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_update(&imu));
+    }
+
+    i2c_driver_stats_t stats;
+    i2c_driver_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.dynamic_link_count);
+    // count + data + direct read per cycle; the overflow cycle resets instead of reading
+    TEST_ASSERT_EQUAL_UINT32(999 * 3 + 3, stats.transaction_count);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.error_count);
+    TEST_ASSERT_EQUAL_UINT32(1, imu.fifo_overflow_count);
+
+    // The single-shot register API still allocates a link per call
+    uint8_t who_am_i = 0;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_read_register(0, 0x68, FAKE_MPU_WHO_AM_I, &who_am_i, 1));
+    i2c_driver_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.dynamic_link_count);
+    i2c_driver_fake_set_bus(NULL);
+}
+
+// ============================================================================
+// Attitude Estimator Tests
+// ============================================================================
+
+#define ATT_TRACE_RATE_HZ   1000
+#define ATT_TRACE_SAMPLES   (10 * ATT_TRACE_RATE_HZ)
+#define ATT_SETTLE_SAMPLES  (1 * ATT_TRACE_RATE_HZ)
+#define ATT_RMS_BUDGET_DEG  2.0f   // pitch accuracy budget with wheel acceleration leaking into the accelerometer
+
+typedef struct {
+    float ax, ay, az, gx, gy, gz;
+    float pitch, roll;
+} att_trace_sample_t;
+
+static att_trace_sample_t att_trace[ATT_TRACE_SAMPLES];
+
+static uint32_t att_rng_state;
+
+// Roughly Gaussian noise (sum of four uniforms), deterministic across runs
+static float att_noise(float sigma) {
+    float sum = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        att_rng_state = att_rng_state * 1664525u + 1013904223u;
+        sum += (float)(att_rng_state >> 8) / 16777216.0f - 0.5f;
+    }
+    return sum * sigma * 1.732f;
+}
+
+// Recorded-style balancing trace: wobble plus slow lean, gyro bias and noise,
+// wheel acceleration leaking into the accelerometer
+static void build_attitude_trace(void) {
+    const float d2r = 3.14159265f / 180.0f;
+    const float two_pi = 2.0f * 3.14159265f;
+    att_rng_state = 12345u;
+    for (int i = 0; i < ATT_TRACE_SAMPLES; i++) {
+        float t = (float)i / ATT_TRACE_RATE_HZ;
+        float pitch = 3.0f * sinf(two_pi * 1.3f * t) + 8.0f * sinf(two_pi * 0.2f * t);
+        float pitch_dot = 3.0f * two_pi * 1.3f * cosf(two_pi * 1.3f * t)
+                        + 8.0f * two_pi * 0.2f * cosf(two_pi * 0.2f * t);
+        float roll = 2.0f * sinf(two_pi * 0.5f * t);
+        float roll_dot = 2.0f * two_pi * 0.5f * cosf(two_pi * 0.5f * t);
+
+        float sp = sinf(pitch * d2r), cp = cosf(pitch * d2r);
+        float sr = sinf(roll * d2r), cr = cosf(roll * d2r);
+        float wheel_accel = 0.05f * sinf(two_pi * 1.3f * t);
+
+        att_trace_sample_t* s = &att_trace[i];
+        s->pitch = pitch;
+        s->roll = roll;
+        s->ax = -sp + wheel_accel + att_noise(0.02f);
+        s->ay = sr * cp + att_noise(0.02f);
+        s->az = cr * cp + att_noise(0.02f);
+        s->gx = roll_dot - 0.8f + att_noise(0.3f);
+        s->gy = pitch_dot * cr + 1.5f + att_noise(0.3f);
+        s->gz = -pitch_dot * sr + 0.5f + att_noise(0.3f);
+    }
+}
+
+static float run_attitude_trace(attitude_estimator_t* est, float* max_err) {
+    double sq_sum = 0.0;
+    *max_err = 0.0f;
+    for (int i = 0; i < ATT_TRACE_SAMPLES; i++) {
+        const att_trace_sample_t* s = &att_trace[i];
+        const attitude_t* att = attitude_estimator_update(est, s->ax, s->ay, s->az,
+                                                          s->gx, s->gy, s->gz,
+                                                          1.0f / ATT_TRACE_RATE_HZ);
+        if (i >= ATT_SETTLE_SAMPLES) {
+            float err = fabsf(att->pitch - s->pitch);
+            sq_sum += (double)err * err;
+            if (err > *max_err) *max_err = err;
+        }
+    }
+    return (float)sqrt(sq_sum / (ATT_TRACE_SAMPLES - ATT_SETTLE_SAMPLES));
+}
+
+void test_attitude_estimator_aligns_to_accelerometer(void) {
+    for (int type = 0; type < ATTITUDE_FILTER_COUNT; type++) {
+        attitude_estimator_t est;
+        attitude_estimator_init(&est, (attitude_filter_type_t)type);
+        // Level in roll, tilted 20 degrees in pitch, robot at rest
+        float rad = 20.0f * 3.14159265f / 180.0f;
+        const attitude_t* att = NULL;
+        for (int i = 0; i < 100; i++) {
+            att = attitude_estimator_update(&est, -sinf(rad), 0.0f, cosf(rad), 0.0f, 0.0f, 0.0f, 0.001f);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(0.2f, 20.0f, att->pitch);
+        TEST_ASSERT_FLOAT_WITHIN(0.2f, 0.0f, att->roll);
+    }
+}
+
+void test_attitude_estimator_runtime_switch_is_bumpless(void) {
+    build_attitude_trace();
+    attitude_estimator_t est;
+    attitude_estimator_init(&est, ATTITUDE_FILTER_KALMAN);
+
+    const attitude_t* att = NULL;
+    float prev_pitch = 0.0f;
+    for (int i = 0; i < 4 * ATT_TRACE_RATE_HZ; i++) {
+        if (i % ATT_TRACE_RATE_HZ == 0 && i > 0) {
+            // Cycle through every filter once per second
+            TEST_ASSERT_TRUE(attitude_estimator_select(&est, (attitude_filter_type_t)(i / ATT_TRACE_RATE_HZ)));
+        }
+        const att_trace_sample_t* s = &att_trace[i];
+        att = attitude_estimator_update(&est, s->ax, s->ay, s->az, s->gx, s->gy, s->gz, 0.001f);
+        if (i > 0) {
+            // No jump at the switch beyond what the motion itself produces in 1 ms
+            TEST_ASSERT_FLOAT_WITHIN(0.2f, prev_pitch, att->pitch);
+        }
+        prev_pitch = att->pitch;
+    }
+    TEST_ASSERT_EQUAL_INT(ATTITUDE_FILTER_COMPLEMENTARY, attitude_estimator_get_type(&est));
+    TEST_ASSERT_FALSE(attitude_estimator_select(&est, ATTITUDE_FILTER_COUNT));
+}
+
+void test_attitude_estimator_switch_via_param_registry(void) {
+    param_registry_t reg;
+    param_registry_init(&reg);
+    robot_params_t params;
+    param_registry_read(&reg, &params);
+    TEST_ASSERT_EQUAL_UINT32(CONFIG_ATTITUDE_FILTER, params.attitude_filter);
+
+    attitude_estimator_t est;
+    attitude_estimator_init(&est, (attitude_filter_type_t)params.attitude_filter);
+    attitude_estimator_update(&est, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.002f);
+
+    // CONFIG_SET from the app: the control task applies the new set like apply_control_params()
+    param_update_t madgwick[] = { { PARAM_ATTITUDE_FILTER, (float)ATTITUDE_FILTER_MADGWICK } };
+    TEST_ASSERT_EQUAL_INT(PARAM_OK, param_registry_set(&reg, madgwick, 1));
+    robot_params_t previous = params;
+    param_registry_read(&reg, &params);
+    TEST_ASSERT_TRUE(params.attitude_filter != previous.attitude_filter);
+    TEST_ASSERT_TRUE(attitude_estimator_select(&est, (attitude_filter_type_t)params.attitude_filter));
+    attitude_estimator_update(&est, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.002f);
+    TEST_ASSERT_EQUAL_INT(ATTITUDE_FILTER_MADGWICK, attitude_estimator_get_type(&est));
+
+    // Only existing filters are accepted, and only as whole numbers
+    param_update_t unknown[] = { { PARAM_ATTITUDE_FILTER, (float)ATTITUDE_FILTER_COUNT } };
+    TEST_ASSERT_EQUAL_INT(PARAM_ERR_INVALID_VALUE, param_registry_set(&reg, unknown, 1));
+    param_update_t fractional[] = { { PARAM_ATTITUDE_FILTER, 1.5f } };
+    TEST_ASSERT_EQUAL_INT(PARAM_ERR_INVALID_VALUE, param_registry_set(&reg, fractional, 1));
+    param_update_t last[] = { { PARAM_ATTITUDE_FILTER, (float)(ATTITUDE_FILTER_COUNT - 1) } };
+    TEST_ASSERT_EQUAL_INT(PARAM_OK, param_registry_set(&reg, last, 1));
+}
+
+void test_attitude_estimator_setters_apply(void) {
+    attitude_estimator_t est;
+    attitude_estimator_init(&est, ATTITUDE_FILTER_KALMAN);
+    attitude_estimator_set_mahony_gains(&est, 2.0f, 0.1f);
+    attitude_estimator_set_madgwick_beta(&est, 0.2f);
+    attitude_estimator_set_complementary_tau(&est, 0.8f);
+    attitude_estimator_set_kalman_noise(&est, 0.002f, 0.004f, 0.05f);
+
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, est.mahony_kp);
+    TEST_ASSERT_EQUAL_FLOAT(0.1f, est.mahony_ki);
+    TEST_ASSERT_EQUAL_FLOAT(0.2f, est.madgwick_beta);
+    TEST_ASSERT_EQUAL_FLOAT(0.8f, est.comp_tau);
+    TEST_ASSERT_EQUAL_FLOAT(0.002f, est.kalman_pitch.Q_angle);
+    TEST_ASSERT_EQUAL_FLOAT(0.004f, est.kalman_roll.Q_bias);
+    TEST_ASSERT_EQUAL_FLOAT(0.05f, est.kalman_roll.R_measure);
+    TEST_ASSERT_EQUAL_INT32(q30_from_float(0.05f), est.kalman_q_pitch.R_measure);
+}
+
+// Pitch after 200 ms of a 20 degree accelerometer step with a still gyro
+static float attitude_step_response(attitude_estimator_t* est) {
+    float rad = 20.0f * 3.14159265f / 180.0f;
+    const attitude_t* att = NULL;
+    attitude_estimator_update(est, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.001f);
+    for (int i = 0; i < 200; i++) {
+        att = attitude_estimator_update(est, -sinf(rad), 0.0f, cosf(rad), 0.0f, 0.0f, 0.0f, 0.001f);
+    }
+    return att->pitch;
+}
+
+void test_attitude_estimator_tuning_changes_filter_response(void) {
+    // Each setter must change how fast its own filter follows the accelerometer
+    attitude_estimator_t slow, fast;
+
+    attitude_estimator_init(&slow, ATTITUDE_FILTER_MAHONY);
+    attitude_estimator_init(&fast, ATTITUDE_FILTER_MAHONY);
+    attitude_estimator_set_mahony_gains(&slow, 0.5f, 0.0f);
+    attitude_estimator_set_mahony_gains(&fast, 5.0f, 0.0f);
+    float mahony_slow = attitude_step_response(&slow);
+    float mahony_fast = attitude_step_response(&fast);
+    TEST_ASSERT_TRUE(mahony_fast > mahony_slow + 2.0f);
+
+    attitude_estimator_init(&slow, ATTITUDE_FILTER_MADGWICK);
+    attitude_estimator_init(&fast, ATTITUDE_FILTER_MADGWICK);
+    attitude_estimator_set_madgwick_beta(&slow, 0.02f);
+    attitude_estimator_set_madgwick_beta(&fast, 0.5f);
+    float madgwick_slow = attitude_step_response(&slow);
+    float madgwick_fast = attitude_step_response(&fast);
+    TEST_ASSERT_TRUE(madgwick_fast > madgwick_slow + 2.0f);
+
+    attitude_estimator_init(&slow, ATTITUDE_FILTER_COMPLEMENTARY);
+    attitude_estimator_init(&fast, ATTITUDE_FILTER_COMPLEMENTARY);
+    attitude_estimator_set_complementary_tau(&slow, 2.0f);
+    attitude_estimator_set_complementary_tau(&fast, 0.05f);
+    float comp_slow = attitude_step_response(&slow);
+    float comp_fast = attitude_step_response(&fast);
+    TEST_ASSERT_TRUE(comp_fast > comp_slow + 2.0f);
+    // tau = 2 s: 1 - exp(-0.2 / 2) of the step after 200 ms
+    TEST_ASSERT_FLOAT_WITHIN(0.3f, 20.0f * (1.0f - expf(-0.1f)), comp_slow);
+}
+
+void test_attitude_estimator_benchmark_1khz_trace(void) {
+    build_attitude_trace();
+
+    printf("\nAttitude filters on a %d s, %d Hz trace (pitch error after %d s settle)\n",
+           ATT_TRACE_SAMPLES / ATT_TRACE_RATE_HZ, ATT_TRACE_RATE_HZ, ATT_SETTLE_SAMPLES / ATT_TRACE_RATE_HZ);
+    printf("  %-14s %10s %10s %10s\n", "filter", "ns/update", "rms deg", "max deg");
+    for (int type = 0; type < ATTITUDE_FILTER_COUNT; type++) {
+        attitude_estimator_t est;
+        float max_err;
+        attitude_estimator_init(&est, (attitude_filter_type_t)type);
+        float rms = run_attitude_trace(&est, &max_err);
+
+        const int reps = 20;
+        clock_t start = clock();
+        for (int r = 0; r < reps; r++) {
+            attitude_estimator_init(&est, (attitude_filter_type_t)type);
+            float unused;
+            run_attitude_trace(&est, &unused);
+        }
+        double ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ((double)reps * ATT_TRACE_SAMPLES);
+
+        printf("  %-14s %10.1f %10.3f %10.3f\n", attitude_estimator_type_name((attitude_filter_type_t)type),
+               ns, rms, max_err);
+        TEST_ASSERT_TRUE(rms < ATT_RMS_BUDGET_DEG);
+    }
+}
+
+// ============================================================================
+// Robot State Machine Tests
+// ============================================================================
+
+void test_robot_state_machine_transitions(void) {
+    robot_state_inputs_t in = {
+        .angle = 0.0f, .fallen_angle = 45.0f,
+        .balance_cmd = false, .standup_cmd = false,
+        .standup_active = false, .standup_complete = false,
+    };
+    TEST_ASSERT_EQUAL_INT(ROBOT_STATE_IDLE, robot_state_machine_next(ROBOT_STATE_IDLE, &in));
+
+    in.balance_cmd = true;
+    TEST_ASSERT_EQUAL_INT(ROBOT_STATE_BALANCING, robot_state_machine_next(ROBOT_STATE_IDLE, &in));
+    in.standup_active = true;
+    TEST_ASSERT_EQUAL_INT(ROBOT_STATE_IDLE, robot_state_machine_next(ROBOT_STATE_IDLE, &in));
+    in.standup_active = false;
+
+    in.angle = -50.0f;
+    TEST_ASSERT_EQUAL_INT(ROBOT_STATE_FALLEN, robot_state_machine_next(ROBOT_STATE_BALANCING, &in));
+    TEST_ASSERT_EQUAL_INT(ROBOT_STATE_FALLEN, robot_state_machine_next(ROBOT_STATE_IDLE, &in));
+    TEST_ASSERT_EQUAL_INT(ROBOT_STATE_FALLEN, robot_state_machine_next(ROBOT_STATE_FALLEN, &in));
+
+    in.standup_cmd = true;
+    TEST_ASSERT_EQUAL_INT(ROBOT_STATE_STANDING_UP, robot_state_machine_next(ROBOT_STATE_FALLEN, &in));
+    in.standup_active = true;
+    TEST_ASSERT_EQUAL_INT(ROBOT_STATE_STANDING_UP, robot_state_machine_next(ROBOT_STATE_STANDING_UP, &in));
+    in.standup_complete = true;
+    TEST_ASSERT_EQUAL_INT(ROBOT_STATE_IDLE, robot_state_machine_next(ROBOT_STATE_STANDING_UP, &in));
+
+    in.angle = 0.0f;
+    in.balance_cmd = false;
+    TEST_ASSERT_EQUAL_INT(ROBOT_STATE_IDLE, robot_state_machine_next(ROBOT_STATE_BALANCING, &in));
+    TEST_ASSERT_EQUAL_INT(ROBOT_STATE_ERROR, robot_state_machine_next(ROBOT_STATE_ERROR, &in));
+    TEST_ASSERT_EQUAL_INT(ROBOT_STATE_ERROR, robot_state_machine_next((robot_state_t)42, &in));
+    TEST_ASSERT_EQUAL_STRING("BALANCING", robot_state_name(ROBOT_STATE_BALANCING));
+}
+
+// ============================================================================
+// Cascaded Balance Controller Tests
+// ============================================================================
+
+void test_balance_cascade_velocity_loop_runs_at_subrate(void) {
+    balance_pid_t bp;
+    balance_pid_init(&bp);
+    balance_pid_set_velocity_tunings(&bp, 0.0f, 1.0f, 0.0f);
+    balance_pid_set_velocity_divider(&bp, 5);
+    balance_pid_set_target_velocity(&bp, 10.0f);
+
+    float prev = balance_pid_update_tilt_target(&bp, 0.0f, 0.002f);
+    int changes = 0;
+    for (int i = 1; i < 20; i++) {
+        float tilt = balance_pid_update_tilt_target(&bp, 0.0f, 0.002f);
+        if (tilt != prev) {
+            changes++;
+            TEST_ASSERT_EQUAL_INT(0, i % 5);
+        }
+        prev = tilt;
+    }
+    TEST_ASSERT_EQUAL_INT(3, changes);
+    // Each outer step integrates over the five inner periods it skipped
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 3 * 5 * 0.002f * 10.0f, bp.velocity_pid.integral);
+
+    balance_pid_reset(&bp);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, bp.tilt_target);
+    TEST_ASSERT_EQUAL_UINT32(0, bp.velocity_counter);
+}
+
+void test_balance_cascade_gyro_rate_is_d_term(void) {
+    balance_pid_t bp;
+    balance_pid_init(&bp);
+    balance_pid_set_balance_tunings(&bp, 50.0f, 0.0f, 2.0f);
+    balance_pid_set_velocity_tunings(&bp, 0.0f, 0.0f, 0.0f);
+
+    // Angle noise alone must only pass through Kp, never a differentiated spike
+    float angles[] = {1.0f, 1.3f, 0.8f, 1.2f, 0.9f};
+    for (int i = 0; i < 5; i++) {
+        float out = balance_pid_compute_balance(&bp, angles[i], 4.0f, 0.0f, 0.002f);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, -50.0f * angles[i] - 2.0f * 4.0f, out);
+    }
+
+    // Setpoint step moves the output by Kp * step only (no derivative kick)
+    pid_controller_set_setpoint(&bp.pitch_pid, 0.0f);
+    float before = pid_controller_compute_rate(&bp.pitch_pid, 1.0f, 0.0f, 0.002f);
+    pid_controller_set_setpoint(&bp.pitch_pid, 2.0f);
+    float after = pid_controller_compute_rate(&bp.pitch_pid, 1.0f, 0.0f, 0.002f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 100.0f, after - before);
+
+    // Fallen robot: motors off
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, balance_pid_compute_balance(&bp, 60.0f, 0.0f, 0.0f, 0.002f));
+}
+
+void test_balance_cascade_holds_position_on_slope(void) {
+    // Shipped outer loop configuration, as control_task applies it
+    balance_pid_t bp;
+    balance_pid_init(&bp);
+    balance_pid_set_velocity_tunings(&bp, CONFIG_VELOCITY_PID_KP, CONFIG_VELOCITY_PID_KI, CONFIG_VELOCITY_PID_KD);
+    pid_controller_set_output_limits(&bp.velocity_pid, -CONFIG_VELOCITY_TILT_LIMIT, CONFIG_VELOCITY_TILT_LIMIT);
+    balance_pid_set_velocity_divider(&bp, CONFIG_VELOCITY_LOOP_DIVIDER);
+    balance_pid_set_target_velocity(&bp, 0.0f);
+
+    // Chassis acceleration follows the actual lean (g*tan per degree), which lags the target
+    // through the angle loop; a 5 degree slope needs about 2.6 degrees of standing lean
+    const float dt = 1.0f / CONFIG_CONTROL_LOOP_HZ;
+    const float accel_per_deg = 17.1f, slope_accel = -44.0f, angle_tau = 0.1f;
+    float lean = 0.0f, velocity = 0.0f, position = 0.0f, max_drift = 0.0f;
+    for (int i = 0; i < 60 * CONFIG_CONTROL_LOOP_HZ; i++) {
+        float tilt = balance_pid_update_tilt_target(&bp, velocity, dt);
+        lean += (tilt - lean) * dt / angle_tau;
+        velocity += (accel_per_deg * lean + slope_accel) * dt;
+        position += velocity * dt;
+        if (fabsf(position) > max_drift) {
+            max_drift = fabsf(position);
+        }
+    }
+    // Integral action holds the lean the slope needs: the robot stops within a bounded distance
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, velocity);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, -slope_accel / accel_per_deg, bp.tilt_target);
+    TEST_ASSERT_TRUE(max_drift < 150.0f);
+    // Needed lean is reached through the integral term, well inside the tilt limit
+    TEST_ASSERT_TRUE(bp.velocity_pid.ki * fabsf(bp.velocity_pid.integral) < CONFIG_VELOCITY_TILT_LIMIT);
+}
+
+// ============================================================================
+// Fixed-Point Control Path Tests
+// ============================================================================
+
+#define FIXED_PID_MAX_ERR       0.5f    // motor command units out of +/-255
+#define FIXED_KALMAN_MAX_ERR    0.01f   // degrees
+
+void test_fixed_point_saturates_and_rounds(void) {
+    TEST_ASSERT_EQUAL_INT32(Q16_ONE + Q16_ONE / 2, q16_from_float(1.5f));
+    TEST_ASSERT_EQUAL_INT32(-Q16_ONE / 4, q16_from_float(-0.25f));
+    TEST_ASSERT_EQUAL_INT32(Q_MAX, q16_from_float(1e6f));
+    TEST_ASSERT_EQUAL_INT32(Q_MIN, q16_from_float(-1e6f));
+    TEST_ASSERT_EQUAL_INT32(Q_MAX, q_add(Q_MAX, Q16_ONE));
+    TEST_ASSERT_EQUAL_INT32(Q_MIN, q_sub(Q_MIN, Q16_ONE));
+    TEST_ASSERT_EQUAL_INT32(Q_MAX, q16_mul(q16_from_float(30000.0f), q16_from_float(2.0f)));
+    TEST_ASSERT_EQUAL_INT32(Q_MAX, q16_div_q30(Q16_ONE, 0));
+    TEST_ASSERT_EQUAL_INT32(-3, q16_to_int(q16_from_float(-3.9f)));  // truncates like (int)
+    TEST_ASSERT_EQUAL_INT32(3, q16_to_int(q16_from_float(3.9f)));
+
+    // 1 ms sample interval must survive the trip through Q2.30
+    TEST_ASSERT_FLOAT_WITHIN(1e-8f, 0.001f, q30_to_float(q30_from_float(0.001f)));
+    // rate * dt: 100 deg/s for 1 ms
+    float step = q16_to_float(q30_mul_q16(q30_from_float(0.001f), q16_from_float(100.0f)));
+    TEST_ASSERT_FLOAT_WITHIN(2e-5f, 0.1f, step);
+    // derivative: 0.01 deg change over 1 ms
+    float derivative = q16_to_float(q16_div_q30(q16_from_float(0.01f), q30_from_float(0.001f)));
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 10.0f, derivative);
+}
+
+void test_fixed_point_pid_matches_float(void) {
+    build_attitude_trace();
+    pid_controller_t pid;
+    pid_controller_init(&pid, 50.0f, 0.5f, 2.0f);
+    pid_controller_set_output_limits(&pid, -255.0f, 255.0f);
+    pid_controller_set_setpoint(&pid, 0.0f);
+    pid_controller_q_t pid_q;
+    pid_controller_q_load(&pid_q, &pid);
+
+    float max_err = 0.0f;
+    int saturated = 0;
+    for (int i = 0; i < ATT_TRACE_SAMPLES; i++) {
+        float out = pid_controller_compute(&pid, att_trace[i].pitch, 0.001f);
+        float out_q = q16_to_float(pid_controller_q_compute(&pid_q, q16_from_float(att_trace[i].pitch),
+                                                            q30_from_float(0.001f)));
+        float err = fabsf(out - out_q);
+        if (err > max_err) max_err = err;
+        if (fabsf(out) >= 255.0f) saturated++;
+    }
+    printf("\nFixed vs float PID: max |diff| %.4f over %d samples (%d saturated)\n",
+           max_err, ATT_TRACE_SAMPLES, saturated);
+    TEST_ASSERT_TRUE(max_err < FIXED_PID_MAX_ERR);
+    // Trace must exercise both the linear region and the output clamp
+    TEST_ASSERT_TRUE(saturated > 0 && saturated < ATT_TRACE_SAMPLES);
+
+    // Reset keeps the two in step as well
+    pid_controller_reset(&pid);
+    pid_controller_q_reset(&pid_q);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, pid_controller_compute(&pid, 5.0f, 0.001f));
+    TEST_ASSERT_EQUAL_INT32(0, pid_controller_q_compute(&pid_q, q16_from_float(5.0f), q30_from_float(0.001f)));
+}
+
+void test_fixed_point_kalman_matches_float(void) {
+    build_attitude_trace();
+    kalman_filter_t kf;
+    kalman_filter_init(&kf);
+    kalman_filter_q_t kf_q;
+    kalman_filter_q_load(&kf_q, &kf);
+
+    float max_err = 0.0f;
+    for (int i = 0; i < ATT_TRACE_SAMPLES; i++) {
+        const att_trace_sample_t* s = &att_trace[i];
+        float acc_pitch = atan2f(-s->ax, sqrtf(s->ay * s->ay + s->az * s->az)) * 180.0f / 3.14159265f;
+        float angle = kalman_filter_get_angle(&kf, acc_pitch, s->gy, 0.001f);
+        float angle_q = q16_to_float(kalman_filter_q_get_angle(&kf_q, q16_from_float(acc_pitch),
+                                                               q16_from_float(s->gy), q30_from_float(0.001f)));
+        float err = fabsf(angle - angle_q);
+        if (err > max_err) max_err = err;
+    }
+    printf("Fixed vs float Kalman: max |diff| %.5f deg, bias %.3f vs %.3f deg/s\n",
+           max_err, kf.bias, q16_to_float(kf_q.bias));
+    TEST_ASSERT_TRUE(max_err < FIXED_KALMAN_MAX_ERR);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, kf.bias, q16_to_float(kf_q.bias));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, kf.P[0][0], q30_to_float(kf_q.P[0][0]));
+}
+
+void test_fixed_point_kalman_tracks_float_across_param_range(void) {
+    build_attitude_trace();
+    const param_def_t* q_angle = param_registry_find(PARAM_KALMAN_Q_ANGLE);
+    const param_def_t* q_bias = param_registry_find(PARAM_KALMAN_Q_BIAS);
+    const param_def_t* r_measure = param_registry_find(PARAM_KALMAN_R_MEASURE);
+
+    // Every corner of the accepted noise box must stay inside Q2.30 and track the float filter
+    for (int corner = 0; corner < 8; corner++) {
+        kalman_filter_t kf;
+        kalman_filter_init(&kf);
+        kalman_filter_set_qangle(&kf, (corner & 1) ? q_angle->max : q_angle->min);
+        kalman_filter_set_qbias(&kf, (corner & 2) ? q_bias->max : q_bias->min);
+        kalman_filter_set_rmeasure(&kf, (corner & 4) ? r_measure->max : r_measure->min);
+        kalman_filter_q_t kf_q;
+        kalman_filter_q_load(&kf_q, &kf);
+
+        float max_err = 0.0f;
+        for (int i = 0; i < ATT_TRACE_SAMPLES; i++) {
+            const att_trace_sample_t* s = &att_trace[i];
+            float acc_pitch = atan2f(-s->ax, sqrtf(s->ay * s->ay + s->az * s->az)) * 180.0f / 3.14159265f;
+            float angle = kalman_filter_get_angle(&kf, acc_pitch, s->gy, 0.001f);
+            float angle_q = q16_to_float(kalman_filter_q_get_angle(&kf_q, q16_from_float(acc_pitch),
+                                                                   q16_from_float(s->gy), q30_from_float(0.001f)));
+            float err = fabsf(angle - angle_q);
+            if (err > max_err) max_err = err;
+        }
+        TEST_ASSERT_TRUE(q30_to_float(kf_q.S) < 1.99f);
+        TEST_ASSERT_TRUE(fabsf(kf.K[1]) < 1.99f);
+        TEST_ASSERT_TRUE(max_err < FIXED_KALMAN_MAX_ERR);
+    }
+
+    // Values the Q2.30 filter cannot hold are refused up front
+    param_registry_t reg;
+    param_registry_init(&reg);
+    param_update_t too_noisy[] = { { PARAM_KALMAN_R_MEASURE, 2.5f } };
+    TEST_ASSERT_EQUAL_INT(PARAM_ERR_INVALID_VALUE, param_registry_set(&reg, too_noisy, 1));
+    param_update_t too_fine[] = { { PARAM_KALMAN_Q_BIAS, 1e-6f } };
+    TEST_ASSERT_EQUAL_INT(PARAM_ERR_INVALID_VALUE, param_registry_set(&reg, too_fine, 1));
+}
+
+void test_fixed_point_accel_angles_match_float(void) {
+    // atan2 over the full circle at several accelerometer magnitudes
+    const float magnitudes[] = { 0.05f, 1.0f, 3.5f };
+    float max_err = 0.0f;
+    for (size_t m = 0; m < sizeof(magnitudes) / sizeof(magnitudes[0]); m++) {
+        for (float deg = -179.5f; deg < 180.0f; deg += 0.7f) {
+            float y = magnitudes[m] * sinf(deg * 3.14159265f / 180.0f);
+            float x = magnitudes[m] * cosf(deg * 3.14159265f / 180.0f);
+            q16_t yq = q16_from_float(y), xq = q16_from_float(x);
+            float expected = atan2f(q16_to_float(yq), q16_to_float(xq)) * 180.0f / 3.14159265f;
+            float err = fabsf(expected - q16_to_float(q16_atan2_deg(yq, xq)));
+            if (err > max_err) max_err = err;
+            TEST_ASSERT_FLOAT_WITHIN(1e-4f, hypotf(q16_to_float(yq), q16_to_float(xq)),
+                                     q16_to_float(q16_hypot(yq, xq)));
+        }
+    }
+    printf("Fixed vs float atan2: max |diff| %.5f deg\n", max_err);
+    TEST_ASSERT_TRUE(max_err < 0.002f);
+    TEST_ASSERT_EQUAL_INT32(0, q16_atan2_deg(0, 0));
+    TEST_ASSERT_EQUAL_INT32(180 * Q16_ONE, q16_atan2_deg(0, -Q16_ONE));
+    TEST_ASSERT_EQUAL_INT32(-90 * Q16_ONE, q16_atan2_deg(-Q16_ONE, 0));
+
+    // Filter 4 now derives the accelerometer angles in Q16 and still tracks the float Kalman
+    build_attitude_trace();
+    attitude_estimator_t est_f, est_q;
+    attitude_estimator_init(&est_f, ATTITUDE_FILTER_KALMAN);
+    attitude_estimator_init(&est_q, ATTITUDE_FILTER_KALMAN_FIXED);
+    max_err = 0.0f;
+    for (int i = 0; i < ATT_TRACE_SAMPLES; i++) {
+        const att_trace_sample_t* s = &att_trace[i];
+        const attitude_t* a = attitude_estimator_update(&est_f, s->ax, s->ay, s->az, s->gx, s->gy, s->gz, 0.001f);
+        attitude_estimator_update(&est_q, s->ax, s->ay, s->az, s->gx, s->gy, s->gz, 0.001f);
+        q16_t pitch_q, rate_q;
+        attitude_estimator_get_pitch_q(&est_q, &pitch_q, &rate_q);
+        TEST_ASSERT_EQUAL_INT32(est_q.kalman_q_pitch.angle, pitch_q);
+        float err = fabsf(a->pitch - q16_to_float(pitch_q));
+        if (err > max_err) max_err = err;
+    }
+    TEST_ASSERT_TRUE(max_err < FIXED_KALMAN_MAX_ERR);
+}
+
+void test_fixed_point_balance_matches_float(void) {
+    build_attitude_trace();
+    balance_pid_t bp;
+    balance_pid_init(&bp);
+    balance_pid_set_balance_tunings(&bp, 50.0f, 0.5f, 2.0f);
+    balance_pid_set_velocity_tunings(&bp, 0.5f, 0.05f, 0.0f);
+    pid_controller_set_output_limits(&bp.velocity_pid, -8.0f, 8.0f);
+    balance_pid_set_velocity_divider(&bp, 10);
+    balance_pid_set_max_tilt_angle(&bp, 30.0f);
+    balance_pid_set_angle_offset(&bp, 1.0f);
+    balance_pid_reset(&bp);
+    balance_pid_q_t bq;
+    balance_pid_q_load(&bq, &bp);
+    balance_pid_set_target_velocity(&bp, 15.0f);
+    balance_pid_q_set_target_velocity(&bq, q16_from_float(15.0f));
+
+    float max_err = 0.0f, max_tilt_err = 0.0f;
+    for (int i = 0; i < ATT_TRACE_SAMPLES; i++) {
+        const att_trace_sample_t* s = &att_trace[i];
+        float velocity = 20.0f * sinf((float)i * 0.003f);
+        float out = balance_pid_compute_balance(&bp, s->pitch, s->gy, velocity, 0.001f);
+        float out_q = q16_to_float(balance_pid_q_compute_balance(&bq, q16_from_float(s->pitch), q16_from_float(s->gy),
+                                                                 q16_from_float(velocity), q30_from_float(0.001f)));
+        if (fabsf(out - out_q) > max_err) max_err = fabsf(out - out_q);
+        if (fabsf(bp.tilt_target - q16_to_float(bq.tilt_target)) > max_tilt_err) {
+            max_tilt_err = fabsf(bp.tilt_target - q16_to_float(bq.tilt_target));
+        }
+        TEST_ASSERT_EQUAL_UINT32(bp.velocity_counter, bq.velocity_counter);
+    }
+    printf("Fixed vs float cascade: max |diff| %.4f output, %.5f deg tilt target\n", max_err, max_tilt_err);
+    TEST_ASSERT_TRUE(max_err < FIXED_PID_MAX_ERR);
+    TEST_ASSERT_TRUE(max_tilt_err < FIXED_KALMAN_MAX_ERR);
+    // The velocity loop ran with its integral limits widened to output / Ki
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, bp.velocity_pid.integral_max, q16_to_float(bq.velocity_pid.integral_max));
+
+    // Past the maximum tilt both cut the motors without touching the loops
+    uint32_t counter = bq.velocity_counter;
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, balance_pid_compute_balance(&bp, -31.0f, 0.0f, 0.0f, 0.001f));
+    TEST_ASSERT_EQUAL_INT32(0, balance_pid_q_compute_balance(&bq, q16_from_float(-31.0f), 0, 0, q30_from_float(0.001f)));
+    TEST_ASSERT_EQUAL_INT32(0, balance_pid_q_compute_balance(&bq, q16_from_float(31.0f), 0, 0, q30_from_float(0.001f)));
+    TEST_ASSERT_EQUAL_UINT32(counter, bq.velocity_counter);
+
+    balance_pid_q_reset(&bq);
+    TEST_ASSERT_EQUAL_INT32(q16_from_float(1.0f), bq.tilt_target);
+    TEST_ASSERT_EQUAL_UINT32(0, bq.velocity_counter);
+}
+
+void test_fixed_point_kernel_benchmark(void) {
+    build_attitude_trace();
+    static q16_t angle_q[ATT_TRACE_SAMPLES], rate_q[ATT_TRACE_SAMPLES];
+    for (int i = 0; i < ATT_TRACE_SAMPLES; i++) {
+        angle_q[i] = q16_from_float(att_trace[i].pitch);
+        rate_q[i] = q16_from_float(att_trace[i].gy);
+    }
+    const q30_t dt_q = q30_from_float(0.001f);
+    const int reps = 20;
+    volatile float sink_f = 0.0f;
+    volatile q16_t sink_q = 0;
+
+    kalman_filter_t kf;
+    pid_controller_t pid;
+    clock_t start = clock();
+    for (int r = 0; r < reps; r++) {
+        kalman_filter_init(&kf);
+        pid_controller_init(&pid, 50.0f, 0.5f, 2.0f);
+        pid_controller_set_output_limits(&pid, -255.0f, 255.0f);
+        for (int i = 0; i < ATT_TRACE_SAMPLES; i++) {
+            float a = kalman_filter_get_angle(&kf, att_trace[i].pitch, att_trace[i].gy, 0.001f);
+            sink_f = pid_controller_compute(&pid, a, 0.001f);
+        }
+    }
+    double ns_float = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ((double)reps * ATT_TRACE_SAMPLES);
+
+    kalman_filter_q_t kf_q;
+    pid_controller_q_t pid_q;
+    start = clock();
+    for (int r = 0; r < reps; r++) {
+        kalman_filter_init(&kf);
+        kalman_filter_q_load(&kf_q, &kf);
+        pid_controller_init(&pid, 50.0f, 0.5f, 2.0f);
+        pid_controller_set_output_limits(&pid, -255.0f, 255.0f);
+        pid_controller_q_load(&pid_q, &pid);
+        for (int i = 0; i < ATT_TRACE_SAMPLES; i++) {
+            q16_t a = kalman_filter_q_get_angle(&kf_q, angle_q[i], rate_q[i], dt_q);
+            sink_q = pid_controller_q_compute(&pid_q, a, dt_q);
+        }
+    }
+    double ns_fixed = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ((double)reps * ATT_TRACE_SAMPLES);
+    (void)sink_f;
+    (void)sink_q;
+
+    // Host numbers only show relative cost; cycle counts on target come from the status task budget report
+    printf("Kalman + PID per cycle (host): float %.1f ns, fixed %.1f ns\n", ns_float, ns_fixed);
+    TEST_ASSERT_TRUE(ns_float > 0.0 || ns_fixed > 0.0);
+}
+
+// ============================================================================
+// IMU Data-Ready Trigger Tests
+// ============================================================================
+
+void test_imu_drdy_decimates_and_stamps_cycles(void) {
+    imu_drdy_t drdy;
+    imu_drdy_init(&drdy, 11, 2);
+
+    int64_t stamp = -1;
+    TEST_ASSERT_EQUAL_UINT32(0, imu_drdy_consume(&drdy, &stamp));
+    TEST_ASSERT_FALSE(imu_drdy_on_sample(&drdy, 1000));
+    TEST_ASSERT_EQUAL_UINT32(0, imu_drdy_consume(&drdy, &stamp));
+    TEST_ASSERT_TRUE(imu_drdy_on_sample(&drdy, 2000));
+    TEST_ASSERT_EQUAL_UINT32(1, imu_drdy_consume(&drdy, &stamp));
+    TEST_ASSERT_EQUAL_INT64(2000, stamp);
+    TEST_ASSERT_EQUAL_UINT32(0, imu_drdy_consume(&drdy, &stamp));
+
+    // Task stalled for three cycles: newest stamp wins, the rest are counted
+    for (int64_t t = 3000; t <= 8000; t += 1000) {
+        imu_drdy_on_sample(&drdy, t);
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, imu_drdy_consume(&drdy, &stamp));
+    TEST_ASSERT_EQUAL_INT64(8000, stamp);
+    TEST_ASSERT_EQUAL_UINT32(2, drdy.dropped_cycles);
+    TEST_ASSERT_EQUAL_UINT32(8, drdy.sample_count);
+}
+
+void test_imu_drdy_pipeline_dt_independent_of_bus_latency(void) {
+    imu_sensor_t imu;
+    setup_fifo_imu(&imu, 1000);
+    imu_drdy_t drdy;
+    imu_drdy_init(&drdy, 11, 2);
+    control_scheduler_t sched;
+    control_scheduler_fake_clock_set(0);
+    control_scheduler_init(&sched, 2000, 10000);
+
+    imu_sample_t batch[IMU_FIFO_MAX_BATCH];
+    int64_t sample_time = 0;
+    for (int cycle = 0; cycle < 200; cycle++) {
+        // Sensor produces two samples; the ISR fires on each INT pulse
+        bool wake = false;
+        for (int k = 0; k < 2; k++) {
+            sample_time += 1000;
+            fake_fifo_push_frame(0, 0, 16384, 0, 131, 0);
+            control_scheduler_fake_clock_set(sample_time);
+            wake = imu_drdy_on_sample(&drdy, control_scheduler_now_us());
+        }
+        TEST_ASSERT_TRUE(wake);
+        if (fake_fifo_written + 64 > FAKE_FIFO_STREAM_MAX) {
+            fake_fifo_written = fake_fifo_read = 0;
+            fake_fifo_push_frame(0, 0, 16384, 0, 131, 0);
+            fake_fifo_push_frame(0, 0, 16384, 0, 131, 0);
+        }
+
+        // Task wakeup and bus timing vary from cycle to cycle
+        control_scheduler_fake_clock_advance(20 + (cycle * 97) % 150);
+        fake_i2c_latency_us = 50 + (cycle * 31) % 300;
+
+        int64_t stamp;
+        TEST_ASSERT_EQUAL_UINT32(1, imu_drdy_consume(&drdy, &stamp));
+        float dt = control_scheduler_mark_cycle(&sched, stamp);
+        TEST_ASSERT_EQUAL_FLOAT(0.002f, dt);
+
+        size_t count = 0;
+        TEST_ASSERT_EQUAL_INT(ESP_OK, imu_sensor_read_fifo(&imu, batch, IMU_FIFO_MAX_BATCH, &count));
+        TEST_ASSERT_EQUAL_UINT32(2, count);
+        control_scheduler_end_cycle(&sched);
+    }
+
+    control_scheduler_stats_t stats;
+    control_scheduler_get_stats(&sched, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.max_jitter_us);
+    TEST_ASSERT_EQUAL_UINT32(0, drdy.dropped_cycles);
+    TEST_ASSERT_EQUAL_UINT32(0, imu.fifo_overflow_count);
+    // Busy time counts from the sample instant: wakeup + two bus transactions
+    TEST_ASSERT_TRUE(stats.max_busy_us <= 170 + 2 * 350);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    
+    // PID Controller Core Logic Tests
+    RUN_TEST(test_pid_proportional_response_accuracy);
+    RUN_TEST(test_pid_integral_windup_protection);
+    RUN_TEST(test_pid_derivative_response);
+    RUN_TEST(test_pid_combined_response);
+    
+    // Kalman Filter Core Logic Tests  
+    RUN_TEST(test_kalman_noise_reduction_effectiveness);
+    RUN_TEST(test_kalman_tracking_performance);
+    
+    // Balance Control Core Logic Tests
+    RUN_TEST(test_balance_safety_fallen_robot);
+    RUN_TEST(test_balance_corrective_action);
+    RUN_TEST(test_balance_velocity_control_integration);
+    
+    // System Integration Logic Tests
     RUN_TEST(test_complete_balance_loop_simulation);
     RUN_TEST(test_error_recovery_scenarios);
     
@@ -1208,6 +4391,34 @@ int main(void) {
     RUN_TEST(test_protocol_invalid_message_handling);
     RUN_TEST(test_protocol_error_message_handling);
     RUN_TEST(test_protocol_sequence_number_tracking);
+
+    // CRC16 implementation tests
+    RUN_TEST(test_crc16_implementations_match_reference);
+    RUN_TEST(test_crc16_benchmark);
+
+    // Zero-copy frame view and stream parser tests
+    RUN_TEST(test_protocol_frame_view_zero_copy);
+    RUN_TEST(test_protocol_stream_reassembles_and_resyncs);
+    RUN_TEST(test_protocol_stream_fuzz_and_benchmark);
+
+    // Telemetry stream tests
+    RUN_TEST(test_telemetry_round_trip_and_mtu_packing);
+    RUN_TEST(test_telemetry_drop_detection);
+    RUN_TEST(test_telemetry_ring_concurrent_producer_consumer);
+
+    // Remote command queue tests
+    RUN_TEST(test_command_queue_orders_and_drops_stale);
+    RUN_TEST(test_command_queue_sequence_filter_and_latency_histogram);
+    RUN_TEST(test_command_watchdog_decays_stalled_motion);
+    RUN_TEST(test_command_queue_concurrent_producer_consumer);
+
+    // Parameter registry tests
+    RUN_TEST(test_param_registry_batch_is_all_or_nothing);
+    RUN_TEST(test_param_registry_table_and_import);
+
+    // Parameter store tests
+    RUN_TEST(test_param_store_alternates_slots_and_picks_newest);
+    RUN_TEST(test_param_store_survives_power_loss_and_corruption);
     
     // BLE Controller Tests
     RUN_TEST(test_ble_connection_state_management);
@@ -1215,6 +4426,8 @@ int main(void) {
     RUN_TEST(test_ble_command_processing_when_disconnected);
     RUN_TEST(test_ble_status_transmission);
     RUN_TEST(test_ble_oversized_command_handling);
+    RUN_TEST(test_ble_link_negotiates_fast_interval_and_mtu);
+    RUN_TEST(test_ble_link_falls_back_when_rejected);
     
     // Communication Integration Tests
     RUN_TEST(test_complete_communication_flow);
@@ -1223,6 +4436,85 @@ int main(void) {
     // Advanced Performance and Reliability Tests (simplified versions)
     RUN_TEST(test_control_loop_timing_constraints);
     RUN_TEST(test_low_battery_behavior);
+    
+    // Control Scheduler Timing Tests
+    RUN_TEST(test_control_scheduler_absolute_wakeup_no_drift);
+    RUN_TEST(test_control_scheduler_bounded_jitter);
+    RUN_TEST(test_control_scheduler_overrun_resync);
+    RUN_TEST(test_control_scheduler_cycle_budget_1khz);
+    RUN_TEST(test_control_scheduler_budget_overrun_and_deferred_reset);
+    RUN_TEST(test_control_scheduler_window_keeps_overrun_at_reset);
+    RUN_TEST(test_control_scheduler_stats_read_from_other_task);
+
+    // State Snapshot Tests
+    RUN_TEST(test_state_snapshot_read_before_publish);
+    RUN_TEST(test_state_snapshot_returns_latest);
+    RUN_TEST(test_state_snapshot_inflight_write_does_not_block_reader);
+    RUN_TEST(test_state_snapshot_concurrent_no_torn_reads);
+
+    // IMU FIFO Tests
+    RUN_TEST(test_imu_fifo_burst_reads_all_queued_samples);
+    RUN_TEST(test_imu_fifo_partial_frame_and_batch_limit);
+    RUN_TEST(test_imu_fifo_overflow_resets);
+    RUN_TEST(test_imu_fifo_batch_integrates_at_native_rate);
+
+    // IMU Calibration Tests
+    RUN_TEST(test_imu_calibration_boot_offsets_and_motion_restart);
+    RUN_TEST(test_imu_calibration_tracks_bias_only_when_quiet);
+
+    // Encoder Tests
+    RUN_TEST(test_encoder_counter_accumulates_across_wraps);
+    RUN_TEST(test_encoder_counter_reset_and_read_failure);
+    RUN_TEST(test_velocity_estimator_low_speed_from_edge_period);
+    RUN_TEST(test_velocity_estimator_tracks_acceleration);
+    RUN_TEST(test_encoder_speed_in_cm_per_second);
+
+    // Odometry Tests
+    RUN_TEST(test_odometry_integrates_square_path);
+    RUN_TEST(test_odometry_gyro_covers_wheel_slip);
+    RUN_TEST(test_odometry_gps_fusion_corrects_heading_and_gates_outliers);
+    RUN_TEST(test_odometry_gps_aligns_large_heading_offset);
+
+    // NMEA Parser Tests
+    RUN_TEST(test_nmea_parser_decodes_gga_and_rmc_in_pieces);
+    RUN_TEST(test_nmea_parser_rejects_corruption_and_resyncs);
+
+    // UBX Parser and GPS Source Selection Tests
+    RUN_TEST(test_ubx_parser_decodes_nav_pvt_in_mixed_stream);
+    RUN_TEST(test_gps_prefers_nav_pvt_and_falls_back_to_nmea);
+
+    // I2C Transaction Tests
+    RUN_TEST(test_i2c_batch_write_preserves_order);
+    RUN_TEST(test_i2c_control_cycle_zero_allocations);
+
+    // Attitude Estimator Tests
+    RUN_TEST(test_attitude_estimator_aligns_to_accelerometer);
+    RUN_TEST(test_attitude_estimator_runtime_switch_is_bumpless);
+    RUN_TEST(test_attitude_estimator_switch_via_param_registry);
+    RUN_TEST(test_attitude_estimator_setters_apply);
+    RUN_TEST(test_attitude_estimator_tuning_changes_filter_response);
+    RUN_TEST(test_attitude_estimator_benchmark_1khz_trace);
+
+    // Robot state machine tests
+    RUN_TEST(test_robot_state_machine_transitions);
+
+    // Cascaded balance controller tests
+    RUN_TEST(test_balance_cascade_velocity_loop_runs_at_subrate);
+    RUN_TEST(test_balance_cascade_gyro_rate_is_d_term);
+    RUN_TEST(test_balance_cascade_holds_position_on_slope);
+
+    // Fixed-point control path tests
+    RUN_TEST(test_fixed_point_saturates_and_rounds);
+    RUN_TEST(test_fixed_point_pid_matches_float);
+    RUN_TEST(test_fixed_point_kalman_matches_float);
+    RUN_TEST(test_fixed_point_kalman_tracks_float_across_param_range);
+    RUN_TEST(test_fixed_point_accel_angles_match_float);
+    RUN_TEST(test_fixed_point_balance_matches_float);
+    RUN_TEST(test_fixed_point_kernel_benchmark);
+
+    // IMU Data-Ready Trigger Tests
+    RUN_TEST(test_imu_drdy_decimates_and_stamps_cycles);
+    RUN_TEST(test_imu_drdy_pipeline_dt_independent_of_bus_latency);
     // RUN_TEST(test_sensor_failure_recovery);  // Temporarily disabled
     // RUN_TEST(test_message_buffer_overflow_protection);  // Temporarily disabled
     